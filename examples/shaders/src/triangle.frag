@@ -0,0 +1,9 @@
+#version 460
+
+layout (location = 0) in  vec4 frag_color;
+
+layout (location = 0) out vec4 frag_output;
+
+void main() {
+  frag_output = frag_color;
+}
@@ -0,0 +1,22 @@
+#version 460
+//no vertex buffers, the triangle is generated from the vertex index
+
+//output to fragment shader
+layout (location = 0) out vec4 frag_color;
+
+vec2 positions[3] = vec2[3](
+	vec2( 0.0f,-0.5f),
+	vec2( 0.5f, 0.5f),
+	vec2(-0.5f, 0.5f)
+);
+
+vec4 colors[3] = vec4[3](
+	vec4(1.0f, 0.0f, 0.0f, 1.0f),
+	vec4(0.0f, 1.0f, 0.0f, 1.0f),
+	vec4(0.0f, 0.0f, 1.0f, 1.0f)
+);
+
+void main() {
+  frag_color  = colors[gl_VertexIndex];
+  gl_Position = vec4(positions[gl_VertexIndex], 0.0f, 1.0f);
+}
@@ -26,30 +26,82 @@ endif()
 
 
 add_executable(shvulkan-compute-power-numbers ${SH_VULKAN_ROOT_DIR}/examples/src/compute/power-numbers.c)
+add_executable(shvulkan-recording-benchmark   ${SH_VULKAN_ROOT_DIR}/examples/src/compute/recording-benchmark.c)
+add_executable(shvulkan-multi-device          ${SH_VULKAN_ROOT_DIR}/examples/src/compute/multi-device.c)
+add_executable(shvulkan-compute-scheduler     ${SH_VULKAN_ROOT_DIR}/examples/src/compute/compute-scheduler.c)
 add_executable(shvulkan-clear-color           ${SH_VULKAN_ROOT_DIR}/examples/src/graphics/clear-color.c)
+add_executable(shvulkan-clear-color-dynamic-rendering ${SH_VULKAN_ROOT_DIR}/examples/src/graphics/clear-color-dynamic-rendering.c)
 add_executable(shvulkan-scene                 ${SH_VULKAN_ROOT_DIR}/examples/src/graphics/scene.c)
 #add_executable(shvulkan-headless              ${SH_VULKAN_ROOT_DIR}/examples/src/graphics/headless.c)
 add_executable(shvulkan-headless-scene        ${SH_VULKAN_ROOT_DIR}/examples/src/graphics/headless-scene.c)
+add_executable(shvulkan-batch-render          ${SH_VULKAN_ROOT_DIR}/examples/src/graphics/batch-render.c)
 
 target_link_libraries(shvulkan-compute-power-numbers PUBLIC shvulkan)
+target_link_libraries(shvulkan-recording-benchmark   PUBLIC shvulkan)
+target_link_libraries(shvulkan-multi-device          PUBLIC shvulkan)
+target_link_libraries(shvulkan-compute-scheduler     PUBLIC shvulkan)
 #target_link_libraries(shvulkan-headless              PUBLIC shvulkan vvo)
 target_link_libraries(shvulkan-headless-scene        PUBLIC shvulkan vvo)
+target_link_libraries(shvulkan-batch-render          PUBLIC shvulkan)
 
 if (WIN32)
 target_link_libraries(shvulkan-clear-color PUBLIC shvulkan glfw)
+target_link_libraries(shvulkan-clear-color-dynamic-rendering PUBLIC shvulkan glfw)
 target_link_libraries(shvulkan-scene       PUBLIC shvulkan glfw)
 elseif (UNIX)
 target_link_libraries(shvulkan-clear-color    PUBLIC shvulkan glfw X11 m)
+target_link_libraries(shvulkan-clear-color-dynamic-rendering PUBLIC shvulkan glfw X11 m)
 target_link_libraries(shvulkan-scene          PUBLIC shvulkan glfw X11 m)
 target_link_libraries(shvulkan-headless-scene PUBLIC m)
+target_link_libraries(shvulkan-batch-render   PUBLIC m)
+target_link_libraries(shvulkan-multi-device   PUBLIC m)
+target_link_libraries(shvulkan-compute-scheduler PUBLIC m)
 endif(WIN32)
 
+#shaders without a checked in binary, compiled to examples/shaders/bin where the examples read them
+set(SH_VULKAN_EXAMPLES_SHADERS pack.comp triangle.vert triangle.frag)
+#storage image format qualifiers mip.comp is compiled for, one binary each
+set(SH_VULKAN_EXAMPLES_MIP_FORMATS rgba8 rgba16f rgba32f)
+
+find_program(SH_VULKAN_GLSLC glslc HINTS $ENV{VULKAN_SDK}/bin $ENV{VULKAN_SDK}/Bin)
+if (SH_VULKAN_GLSLC)
+set(SH_VULKAN_EXAMPLES_SHADER_BINARIES)
+foreach(shader ${SH_VULKAN_EXAMPLES_SHADERS})
+add_custom_command(
+    OUTPUT  ${SH_VULKAN_ROOT_DIR}/examples/shaders/bin/${shader}.spv
+    COMMAND ${SH_VULKAN_GLSLC} ${SH_VULKAN_ROOT_DIR}/examples/shaders/src/${shader} -o ${SH_VULKAN_ROOT_DIR}/examples/shaders/bin/${shader}.spv
+    DEPENDS ${SH_VULKAN_ROOT_DIR}/examples/shaders/src/${shader}
+    COMMENT "compiling ${shader}"
+)
+list(APPEND SH_VULKAN_EXAMPLES_SHADER_BINARIES ${SH_VULKAN_ROOT_DIR}/examples/shaders/bin/${shader}.spv)
+endforeach()
+foreach(format ${SH_VULKAN_EXAMPLES_MIP_FORMATS})
+add_custom_command(
+    OUTPUT  ${SH_VULKAN_ROOT_DIR}/examples/shaders/bin/mip.${format}.comp.spv
+    COMMAND ${SH_VULKAN_GLSLC} -DMIP_IMAGE_FORMAT=${format} ${SH_VULKAN_ROOT_DIR}/examples/shaders/src/mip.comp -o ${SH_VULKAN_ROOT_DIR}/examples/shaders/bin/mip.${format}.comp.spv
+    DEPENDS ${SH_VULKAN_ROOT_DIR}/examples/shaders/src/mip.comp
+    COMMENT "compiling mip.comp for ${format} storage images"
+)
+list(APPEND SH_VULKAN_EXAMPLES_SHADER_BINARIES ${SH_VULKAN_ROOT_DIR}/examples/shaders/bin/mip.${format}.comp.spv)
+endforeach()
+add_custom_target(shvulkan-examples-shaders ALL DEPENDS ${SH_VULKAN_EXAMPLES_SHADER_BINARIES})
+add_dependencies(shvulkan-headless-scene shvulkan-examples-shaders)
+add_dependencies(shvulkan-clear-color-dynamic-rendering shvulkan-examples-shaders)
+else()
+message(WARNING "shvulkan cmake warning: glslc not found, ${SH_VULKAN_EXAMPLES_SHADERS} and mip.comp must be compiled to examples/shaders/bin manually")
+endif(SH_VULKAN_GLSLC)
+
 set_target_properties(
     shvulkan-compute-power-numbers 
+    shvulkan-recording-benchmark
+    shvulkan-multi-device
+    shvulkan-compute-scheduler
     shvulkan-clear-color 
+    shvulkan-clear-color-dynamic-rendering
     shvulkan-scene
     #shvulkan-headless
     shvulkan-headless-scene
+    shvulkan-batch-render
 
     PROPERTIES
     RUNTIME_OUTPUT_DIRECTORY      ${SH_VULKAN_BINARIES_DIR}
@@ -0,0 +1,496 @@
+#ifdef __cplusplus
+extern "C" {
+#endif//__cplusplus
+
+#include <shvulkan/shVulkan.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+
+
+void setupPipeline(
+	VkDevice          device,
+	VkBuffer          buffer,
+	ShVkPipelinePool* p_pipeline_pool
+);
+
+char* readBinary(const char* path, uint32_t* p_size);
+
+
+
+//
+//THE BUFFER IS SPLIT IN JOB_COUNT CHUNKS, EVERY CHUNK IS SQUARED BY ONE JOB OF THE FIRST ROUND
+//AND SQUARED AGAIN BY ONE JOB OF THE SECOND ROUND, WHICH WAITS FOR THE FIRST ONE, POSSIBLY ON ANOTHER QUEUE
+//
+#define JOB_COUNT         8
+#define CHUNK_INPUT_COUNT 256
+#define INPUT_COUNT       (JOB_COUNT * CHUNK_INPUT_COUNT)
+float inputs [INPUT_COUNT] = { 0 };
+float outputs[INPUT_COUNT] = { 0 };
+
+float factor = 1.0f;
+
+//
+//NUMBER OF INVOCATIONS OR THREADS must be equal to the invocations defined in the compute shader as layout(local_size_x...y...z)in
+//
+#define INVOCATION_X_COUNT 64
+
+//
+//CHUNK_INPUT_COUNT * 4 is a multiple of 256, the largest minStorageBufferOffsetAlignment
+//
+#define CHUNK_SIZE    (sizeof(float) * CHUNK_INPUT_COUNT)
+#define FACTOR_OFFSET (CHUNK_SIZE * JOB_COUNT)
+#define BUFFER_SIZE   (FACTOR_OFFSET + sizeof(factor))
+
+#define MAX_QUEUE_COUNT 4
+
+
+
+int main(void) {
+
+	VkInstance       instance                   = VK_NULL_HANDLE;
+	VkDevice         device                     = VK_NULL_HANDLE;
+	VkPhysicalDevice physical_device            = VK_NULL_HANDLE;
+	uint32_t         compute_queue_family_index = 0;
+
+	shCreateInstance(
+		"vulkan app",//application_name,
+		"vulkan engine",//engine_name,
+		1,//enable_validation_layers,
+		0,//extension_count,
+		NULL,//pp_extension_names,
+		VK_MAKE_API_VERSION(1, 3, 0, 0),//api_version,
+		&instance//p_instance
+	);
+
+	shSelectPhysicalDevice(
+		instance,//instance
+		VK_NULL_HANDLE,//surface
+		VK_QUEUE_COMPUTE_BIT,//requirements
+		&physical_device,//p_physical_device
+		NULL,//p_physical_device_properties
+		NULL,//p_physical_device_features
+		NULL//p_physical_device_memory_properties
+	);
+
+	uint32_t                compute_queue_family_indices[SH_MAX_STACK_QUEUE_FAMILY_COUNT] = { 0 };
+	VkQueueFamilyProperties queue_families_properties   [SH_MAX_STACK_QUEUE_FAMILY_COUNT] = { 0 };
+
+	shGetPhysicalDeviceQueueFamilies(
+		physical_device,//physical_device
+		VK_NULL_HANDLE,//surface
+		NULL,//p_queue_family_count
+		NULL,//p_graphics_queue_family_count
+		NULL,//p_surface_queue_family_count
+		NULL,//p_compute_queue_family_count
+		NULL,//p_transfer_queue_family_count
+		NULL,//p_graphics_queue_family_indices
+		NULL,//p_surface_queue_family_indices
+		compute_queue_family_indices,//p_compute_queue_family_indices
+		NULL,//p_transfer_queue_family_indices
+		queue_families_properties//p_queue_families_properties
+	);
+
+	compute_queue_family_index = compute_queue_family_indices[0];
+
+	//
+	//AS MANY QUEUES AS THE FAMILY EXPOSES, UP TO MAX_QUEUE_COUNT
+	//
+	uint32_t queue_count = queue_families_properties[compute_queue_family_index].queueCount;
+	queue_count = queue_count > MAX_QUEUE_COUNT ? MAX_QUEUE_COUNT : queue_count;
+
+	float compute_queue_priorities[MAX_QUEUE_COUNT] = { 1.0f, 1.0f, 1.0f, 1.0f };
+
+	VkDeviceQueueCreateInfo compute_queue_info = { 0 };
+
+	shQueryForDeviceQueueInfo(
+		compute_queue_family_index,//queue_family_index
+		queue_count,//queue_count
+		compute_queue_priorities,//p_queue_priorities
+		0,//protected
+		&compute_queue_info//p_device_queue_info
+	);
+
+	//
+	//JOBS ARE TRACKED WITH TIMELINE SEMAPHORES
+	//
+	ShVkDeviceFeatures required_device_features = { 0 };
+	ShVkDeviceFeatures enabled_device_features  = { 0 };
+
+	shInitDeviceFeatures(VK_API_VERSION_1_3, &required_device_features);
+	required_device_features.vulkan12.timelineSemaphore = VK_TRUE;
+
+	shVkError(
+		shNegotiateDeviceFeatures(
+			physical_device,//physical_device
+			VK_MAKE_API_VERSION(1, 3, 0, 0),//instance_api_version
+			&required_device_features,//p_required
+			VK_NULL_HANDLE,//p_wanted
+			&enabled_device_features//p_enabled
+		) == 0,
+		"device does not support timeline semaphores",
+		return -1
+	);
+
+	shSetLogicalDevice(
+		physical_device,//physical_device
+		&device,//p_device
+		0,//extension_count
+		NULL,//pp_extension_names
+		1,//device_queue_count
+		&compute_queue_info,//p_device_queue_infos
+		&enabled_device_features.features//p_next
+	);
+
+	ShVkComputeScheduler* p_scheduler = shAllocateComputeScheduler();
+
+	shVkError(
+		p_scheduler == NULL,
+		"invalid compute scheduler memory",
+		return -1
+	);
+
+	shCreateComputeScheduler(
+		device,//device
+		compute_queue_family_index,//queue_family_index
+		queue_count,//queue_count
+		SH_COMPUTE_SCHEDULE_LEAST_LOADED,//policy
+		p_scheduler//p_scheduler
+	);
+
+	printf("Scheduling %u jobs on %u queues\n", JOB_COUNT * 2, queue_count);
+
+	//
+	//HOST VISIBLE INPUT/OUTPUT BUFFER
+	//
+	VkBuffer       buffer = VK_NULL_HANDLE;
+	VkDeviceMemory memory = VK_NULL_HANDLE;
+
+	shCreateBuffer(
+		device,//device
+		BUFFER_SIZE,//size
+		VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,//usage
+		VK_SHARING_MODE_EXCLUSIVE,//sharing_mode
+		&buffer//p_buffer
+	);
+
+	shAllocateBufferMemory(
+		device,//device
+		physical_device,//physical_device
+		buffer,//buffer
+		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,//property_flags
+		&memory//p_memory
+	);
+
+	shBindBufferMemory(
+		device,//device
+		buffer,//buffer
+		0,//offset
+		memory//buffer_memory
+	);
+
+	for (uint32_t i = 0; i < INPUT_COUNT; i++) {
+		inputs[i] = (float)(i % 16);
+	}
+
+	shWriteMemory(
+		device,//device
+		memory,//memory
+		0,//offset
+		sizeof(inputs),//data_size
+		inputs//p_data
+	);
+
+	shWriteMemory(
+		device,//device
+		memory,//memory
+		FACTOR_OFFSET,//offset
+		sizeof(factor),//data_size
+		&factor//p_data
+	);
+
+	ShVkPipelinePool* p_pipeline_pool = shAllocatePipelinePool();
+
+	shVkError(
+		p_pipeline_pool == NULL,
+		"invalid pipeline pool memory",
+		return -1
+	);
+
+	ShVkPipeline* p_pipeline = &p_pipeline_pool->pipelines[0];
+
+	setupPipeline(
+		device,//device
+		buffer,//buffer
+		p_pipeline_pool//p_pipeline_pool
+	);
+
+	ShVkComputeJob jobs[2][JOB_COUNT] = { 0 };
+
+	for (uint32_t round_idx = 0; round_idx < 2; round_idx++) {
+		for (uint32_t job_idx = 0; job_idx < JOB_COUNT; job_idx++) {
+			ShVkComputeJob* p_job = &jobs[round_idx][job_idx];
+
+			//
+			//PICKS THE LEAST LOADED QUEUE AND RECYCLES ONE OF ITS COMMAND BUFFERS
+			//
+			shComputeSchedulerBeginJob(
+				device,//device
+				p_scheduler,//p_scheduler
+				p_job//p_job
+			);
+
+			shBindPipeline(p_job->cmd_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, p_pipeline);
+
+			//
+			//CHUNK OF THE JOB AS SET 0, FACTOR AS SET 1
+			//
+			shPipelineBindDescriptorSetUnits(
+				p_job->cmd_buffer,//cmd_buffer
+				0,//first_descriptor_set
+				job_idx,//first_descriptor_set_unit_idx
+				1,//descriptor_set_unit_count
+				VK_PIPELINE_BIND_POINT_COMPUTE,//bind_point
+				0,//dynamic_descriptors_count
+				NULL,//p_dynamic_offsets
+				p_pipeline_pool,//p_pipeline_pool
+				p_pipeline//p_pipeline
+			);
+
+			shPipelineBindDescriptorSetUnits(
+				p_job->cmd_buffer,//cmd_buffer
+				1,//first_descriptor_set
+				JOB_COUNT,//first_descriptor_set_unit_idx
+				1,//descriptor_set_unit_count
+				VK_PIPELINE_BIND_POINT_COMPUTE,//bind_point
+				0,//dynamic_descriptors_count
+				NULL,//p_dynamic_offsets
+				p_pipeline_pool,//p_pipeline_pool
+				p_pipeline//p_pipeline
+			);
+
+			shCmdDispatch(
+				p_job->cmd_buffer,//cmd_buffer
+				CHUNK_INPUT_COUNT / INVOCATION_X_COUNT,//group_count_x
+				1,//group_count_y
+				1//group_count_z
+			);
+
+			//
+			//THE LAST ROUND MAKES ITS WRITES VISIBLE TO THE HOST
+			//
+			if (round_idx == 1) {
+				shSetBufferMemoryBarrier(
+					device,//device
+					p_job->cmd_buffer,//cmd_buffer
+					buffer,//buffer
+					VK_ACCESS_SHADER_WRITE_BIT,//access_before_barrier
+					VK_ACCESS_HOST_READ_BIT,//access_after_barrier
+					compute_queue_family_index,//performing_queue_family_index_before_barrier
+					compute_queue_family_index,//performing_queue_family_index_after_barrier
+					VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,//pipeline_stage_before_barrier
+					VK_PIPELINE_STAGE_HOST_BIT//pipeline_stage_after_barrier
+				);
+			}
+
+			//
+			//THE SECOND ROUND WAITS FOR THE JOB WHICH SQUARED THE SAME CHUNK
+			//
+			shComputeSchedulerSubmitJob(
+				p_scheduler,//p_scheduler
+				p_job,//p_job
+				round_idx,//dependency_count
+				round_idx ? &jobs[0][job_idx] : NULL//p_dependencies
+			);
+
+			printf("\tround %u, job %u: queue %u, timeline value %llu\n",
+				round_idx, job_idx, p_job->queue_idx, (unsigned long long)p_job->timeline_value
+			);
+		}
+	}
+
+	shComputeSchedulerWaitIdle(device, p_scheduler);
+
+	shReadMemory(
+		device,//device
+		memory,//memory
+		0,//offset
+		sizeof(outputs),//data_size
+		NULL,//pp_map_data
+		outputs//p_dst_data
+	);
+
+	uint32_t error_count = 0;
+	for (uint32_t i = 0; i < INPUT_COUNT; i++) {
+		float expected = inputs[i] * inputs[i] * inputs[i] * inputs[i] * factor * factor * factor;
+		if (fabsf(outputs[i] - expected) > expected * 1e-4f) {
+			error_count++;
+		}
+	}
+	printf("%u wrong outputs out of %u\n", error_count, INPUT_COUNT);
+
+	//
+	//DESTROY PIPELINE AND BUFFER
+	//
+	shPipelinePoolDestroyDescriptorPools(device, 0, 1, p_pipeline_pool);
+	shPipelinePoolDestroyDescriptorSetLayouts(device, 0, 1, p_pipeline_pool);
+
+	shPipelineDestroyShaderModules(device, 0, 1, p_pipeline);
+	shPipelineDestroyLayout       (device, p_pipeline);
+	shDestroyPipeline             (device, p_pipeline->pipeline);
+
+	shFreePipelinePool(p_pipeline_pool);
+
+	shClearBufferMemory(device, buffer, memory);
+
+	//
+	//END VULKAN
+	//
+	shDestroyComputeScheduler(device, p_scheduler);
+	shFreeComputeScheduler(p_scheduler);
+
+	shDestroyDevice(device);
+	shDestroyInstance(instance);
+
+	return 0;
+}
+
+void setupPipeline(
+	VkDevice          device,
+	VkBuffer          buffer,
+	ShVkPipelinePool* p_pipeline_pool
+) {
+	//
+	//ONE DESCRIPTOR PER CHUNK, THEN THE FACTOR
+	//
+	for (uint32_t job_idx = 0; job_idx < JOB_COUNT; job_idx++) {
+		shPipelinePoolSetDescriptorBufferInfos(
+			job_idx,//first_descriptor
+			1,//descriptor_count
+			buffer,//buffer
+			CHUNK_SIZE * job_idx,//buffer_offset
+			CHUNK_SIZE,//buffer_size
+			p_pipeline_pool//p_pipeline_pool
+		);
+	}
+
+	shPipelinePoolSetDescriptorBufferInfos(
+		JOB_COUNT,//first_descriptor
+		1,//descriptor_count
+		buffer,//buffer
+		FACTOR_OFFSET,//buffer_offset
+		sizeof(factor),//buffer_size
+		p_pipeline_pool//p_pipeline_pool
+	);
+
+	shPipelinePoolCreateDescriptorSetLayoutBinding(
+		0,//binding
+		VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,//descriptor_type
+		1,//descriptor_set_count
+		VK_SHADER_STAGE_COMPUTE_BIT,//shader_stage
+		p_pipeline_pool//p_pipeline_pool
+	);
+
+	shPipelinePoolCreateDescriptorSetLayout(
+		device,//device
+		0,//first_binding_idx
+		1,//binding_count
+		0,//set_layout_idx
+		0,//flags
+		p_pipeline_pool//p_pipeline_pool
+	);
+
+	shPipelinePoolCopyDescriptorSetLayout(
+		0,//src_set_layout_idx
+		0,//first_dst_set_layout_idx
+		JOB_COUNT + 1,//dst_set_layout_count
+		p_pipeline_pool//p_pipeline_pool
+	);//same descriptor set layout for all descriptor sets
+
+	shPipelinePoolCreateDescriptorPool(
+		device,//device
+		0,//pool_idx
+		VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,//descriptor_type
+		JOB_COUNT + 1,//descriptor_count
+		p_pipeline_pool//p_pipeline_pool
+	);
+
+	shPipelinePoolAllocateDescriptorSetUnits(
+		device,//device
+		0,//binding
+		0,//pool_idx
+		VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,//descriptor_type
+		0,//first_descriptor_set_unit
+		JOB_COUNT + 1,//descriptor_set_unit_count
+		p_pipeline_pool//p_pipeline_pool
+	);
+
+	shPipelinePoolUpdateDescriptorSetUnits(
+		device,//device
+		0,//first_descriptor_set_unit
+		JOB_COUNT + 1,//descriptor_set_unit_count
+		p_pipeline_pool//p_pipeline_pool
+	);
+
+	ShVkPipeline* p_pipeline = &p_pipeline_pool->pipelines[0];
+
+	uint32_t shader_size = 0;
+	char* shader_code = readBinary(
+		"../../examples/shaders/bin/power.comp.spv",
+		&shader_size
+	);
+
+	shPipelineCreateShaderModule(
+		device,//device
+		shader_size,//size
+		shader_code,//code
+		p_pipeline//p_pipeline
+	);
+
+	free(shader_code);
+
+	shPipelineCreateShaderStage(
+		VK_SHADER_STAGE_COMPUTE_BIT,//shader_stage
+		p_pipeline//p_pipeline
+	);
+
+	shPipelineCreateLayout(
+		device,//device
+		0,//first_descriptor_set_layout
+		2,//descriptor_set_layout_count
+		p_pipeline_pool,//p_pipeline_pool
+		p_pipeline//p_pipeline
+	);
+
+	shSetupComputePipeline(device, p_pipeline);
+}
+
+#ifdef _MSC_VER
+#pragma warning (disable: 4996)
+#endif//_MSC_VER
+#include <stdlib.h>
+char* readBinary(const char* path, uint32_t* p_size) {
+	FILE* stream = fopen(path, "rb");
+	if (stream == NULL) {
+		return NULL;
+	}
+	fseek(stream, 0, SEEK_END);
+	uint32_t code_size = ftell(stream);
+	fseek(stream, 0, SEEK_SET);
+	char* code = (char*)calloc(1, code_size);
+	if (code == NULL) {
+		fclose(stream);
+		return NULL;
+	}
+	fread(code, code_size, 1, stream);
+	*p_size = code_size;
+	fclose(stream);
+	return code;
+}
+
+#ifdef __cplusplus
+}
+#endif//__cplusplus
@@ -0,0 +1,419 @@
+#ifdef __cplusplus
+extern "C" {
+#endif//__cplusplus
+
+#include <shvulkan/shVulkan.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+
+
+void setupPipeline(
+	VkDevice          device,
+	VkBuffer          buffer,
+	ShVkPipelinePool* p_pipeline_pool
+);
+
+char* readBinary(const char* path, uint32_t* p_size);
+
+
+
+//
+//THE WORKLOAD IS SPLIT ACROSS ALL THE DEVICES EXPOSING A COMPUTE QUEUE.
+//TO TRY IT WITHOUT SEVERAL GPUS, LIST THE SAME LAVAPIPE ICD MORE THAN ONCE, E.G.
+//	VK_ICD_FILENAMES=lvp_icd.x86_64.json:lvp_icd.x86_64.json
+//OR COMBINE LAVAPIPE WITH A HARDWARE DRIVER
+//
+#define INPUT_COUNT 65536
+float inputs [INPUT_COUNT] = { 0 };
+float outputs[INPUT_COUNT] = { 0 };
+
+float factor = 1.0f;
+
+//
+//NUMBER OF INVOCATIONS OR THREADS must be equal to the invocations defined in the compute shader as layout(local_size_x...y...z)in
+//
+#define INVOCATION_X_COUNT 64
+
+//
+//EVERY DEVICE OWNS A BUFFER LARGE ENOUGH FOR ANY PARTITION, THE FACTOR IS STORED AFTER THE VALUES
+//(INPUT_COUNT * 4 is a multiple of 256, the largest minStorageBufferOffsetAlignment)
+//
+#define VALUES_OFFSET 0
+#define VALUES_SIZE   (sizeof(float) * INPUT_COUNT)
+#define FACTOR_OFFSET VALUES_SIZE
+#define BUFFER_SIZE   (VALUES_SIZE + sizeof(factor))
+
+#define ITERATION_COUNT 4
+
+
+
+int main(void) {
+
+	VkInstance instance = VK_NULL_HANDLE;
+
+	shCreateInstance(
+		"vulkan app",//application_name,
+		"vulkan engine",//engine_name,
+		1,//enable_validation_layers,
+		0,//extension_count,
+		NULL,//pp_extension_names,
+		VK_MAKE_API_VERSION(1, 3, 0, 0),//api_version,
+		&instance//p_instance
+	);
+
+	ShVkMultiDevice* p_multi_device = shAllocateMultiDevice();
+
+	shVkError(
+		p_multi_device == NULL,
+		"invalid multi device memory",
+		return -1
+	);
+
+	shVkError(
+		shCreateMultiDevice(
+			instance,//instance
+			NULL,//p_benchmark_cache
+			0,//extension_count
+			NULL,//pp_extension_names
+			p_multi_device//p_multi_device
+		) == 0,
+		"failed creating multi device",
+		return -1
+	);
+
+	printf("Devices: %u\n", p_multi_device->device_count);
+
+	//
+	//ONE HOST VISIBLE BUFFER PER DEVICE
+	//
+	VkBuffer       buffers [SH_MAX_MULTI_DEVICE_COUNT] = { 0 };
+	VkDeviceMemory memories[SH_MAX_MULTI_DEVICE_COUNT] = { 0 };
+
+	shVkError(
+		shMultiDeviceCreateBuffers(
+			BUFFER_SIZE,//size
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,//usage
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,//memory_property_flags
+			buffers,//p_buffers
+			memories,//p_memories
+			p_multi_device//p_multi_device
+		) == 0,
+		"failed creating multi device buffers",
+		return -1
+	);
+
+	//
+	//ONE PIPELINE POOL PER DEVICE, EVERY DEVICE OWNS ITS HANDLES
+	//
+	ShVkPipelinePool* pipeline_pools[SH_MAX_MULTI_DEVICE_COUNT] = { 0 };
+
+	for (uint32_t device_idx = 0; device_idx < p_multi_device->device_count; device_idx++) {
+		VkDevice device = p_multi_device->devices[device_idx];
+
+		pipeline_pools[device_idx] = shAllocatePipelinePool();
+
+		shVkError(
+			pipeline_pools[device_idx] == NULL,
+			"invalid pipeline pool memory",
+			return -1
+		);
+
+		setupPipeline(
+			device,//device
+			buffers[device_idx],//buffer
+			pipeline_pools[device_idx]//p_pipeline_pool
+		);
+
+		shWriteMemory(
+			device,//device
+			memories[device_idx],//memory
+			FACTOR_OFFSET,//offset
+			sizeof(factor),//data_size
+			&factor//p_data
+		);
+	}
+
+	for (uint32_t iteration_idx = 0; iteration_idx < ITERATION_COUNT; iteration_idx++) {
+
+		//
+		//INPUTS FOR SHADER
+		//
+		for (uint32_t i = 0; i < INPUT_COUNT; i++) {
+			inputs[i] = (float)(i % 1024);
+		}
+
+		//
+		//SPLIT THE ELEMENTS, SHARES ARE MULTIPLES OF THE WORKGROUP SIZE
+		//
+		shMultiDevicePartitionWork(
+			INPUT_COUNT,//work_unit_count
+			INVOCATION_X_COUNT,//work_unit_alignment
+			p_multi_device//p_multi_device
+		);
+
+		//
+		//EVERY DEVICE RECEIVES ITS SHARE AT THE BEGINNING OF ITS BUFFER
+		//
+		shMultiDeviceScatter(
+			sizeof(float),//work_unit_size
+			inputs,//p_src
+			memories,//p_dst_memories
+			VALUES_OFFSET,//dst_offset
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,//memory_property_flags
+			p_multi_device//p_multi_device
+		);
+
+		shMultiDeviceBeginCommandBuffers(p_multi_device);
+
+		for (uint32_t device_idx = 0; device_idx < p_multi_device->device_count; device_idx++) {
+			VkDevice          device          = p_multi_device->devices[device_idx];
+			VkCommandBuffer   cmd_buffer      = p_multi_device->cmd_buffers[device_idx];
+			uint32_t          queue_family    = p_multi_device->queue_family_indices[device_idx];
+			uint32_t          work_unit_count = p_multi_device->work_unit_counts[device_idx];
+			ShVkPipelinePool* p_pipeline_pool = pipeline_pools[device_idx];
+			ShVkPipeline*     p_pipeline      = &p_pipeline_pool->pipelines[0];
+
+			if (work_unit_count == 0) {
+				continue;
+			}
+
+			shBindPipeline(cmd_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, p_pipeline);
+
+			shPipelineBindDescriptorSetUnits(
+				cmd_buffer,//cmd_buffer
+				0,//first_descriptor_set
+				0,//first_descriptor_set_unit_idx
+				2,//descriptor_set_unit_count
+				VK_PIPELINE_BIND_POINT_COMPUTE,//bind_point
+				0,//dynamic_descriptors_count
+				NULL,//p_dynamic_offsets
+				p_pipeline_pool,//p_pipeline_pool
+				p_pipeline//p_pipeline
+			);
+
+			shCmdDispatch(
+				cmd_buffer,//cmd_buffer
+				work_unit_count / INVOCATION_X_COUNT,//group_count_x
+				1,//group_count_y
+				1//group_count_z
+			);
+
+			//
+			//SHADER WRITES MUST BE VISIBLE TO THE HOST BEFORE GATHERING
+			//
+			shSetBufferMemoryBarrier(
+				device,//device
+				cmd_buffer,//cmd_buffer
+				buffers[device_idx],//buffer
+				VK_ACCESS_SHADER_WRITE_BIT,//access_before_barrier
+				VK_ACCESS_HOST_READ_BIT,//access_after_barrier
+				queue_family,//performing_queue_family_index_before_barrier
+				queue_family,//performing_queue_family_index_after_barrier
+				VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,//pipeline_stage_before_barrier
+				VK_PIPELINE_STAGE_HOST_BIT//pipeline_stage_after_barrier
+			);
+		}
+
+		shMultiDeviceEndCommandBuffers(p_multi_device);
+
+		//
+		//RUNS ALL DEVICES CONCURRENTLY AND MEASURES THEM, THE NEXT PARTITION FOLLOWS THE OBSERVED SPEED
+		//
+		shMultiDeviceSubmit(p_multi_device);
+
+		shMultiDeviceGather(
+			sizeof(float),//work_unit_size
+			memories,//p_src_memories
+			VALUES_OFFSET,//src_offset
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,//memory_property_flags
+			outputs,//p_dst
+			p_multi_device//p_multi_device
+		);
+
+		uint32_t error_count = 0;
+		for (uint32_t i = 0; i < INPUT_COUNT; i++) {
+			float expected = inputs[i] * inputs[i] * factor;
+			if (fabsf(outputs[i] - expected) > expected * 1e-4f) {
+				error_count++;
+			}
+		}
+
+		printf("\nIteration %u:\n", iteration_idx);
+		for (uint32_t device_idx = 0; device_idx < p_multi_device->device_count; device_idx++) {
+			printf(
+				"\tdevice %u: first element %u, %u elements, throughput %f\n",
+				device_idx,
+				p_multi_device->first_work_units[device_idx],
+				p_multi_device->work_unit_counts[device_idx],
+				p_multi_device->throughputs[device_idx]
+			);
+		}
+		printf("\t%u wrong outputs out of %u\n", error_count, INPUT_COUNT);
+	}
+
+	//
+	//DESTROY PIPELINES AND BUFFERS
+	//
+	for (uint32_t device_idx = 0; device_idx < p_multi_device->device_count; device_idx++) {
+		VkDevice          device          = p_multi_device->devices[device_idx];
+		ShVkPipelinePool* p_pipeline_pool = pipeline_pools[device_idx];
+		ShVkPipeline*     p_pipeline      = &p_pipeline_pool->pipelines[0];
+
+		shPipelinePoolDestroyDescriptorPools(device, 0, 1, p_pipeline_pool);
+		shPipelinePoolDestroyDescriptorSetLayouts(device, 0, 1, p_pipeline_pool);
+
+		shPipelineDestroyShaderModules(device, 0, 1, p_pipeline);
+		shPipelineDestroyLayout       (device, p_pipeline);
+		shDestroyPipeline             (device, p_pipeline->pipeline);
+
+		shFreePipelinePool(p_pipeline_pool);
+	}
+
+	shMultiDeviceDestroyBuffers(buffers, memories, p_multi_device);
+
+	//
+	//END VULKAN
+	//
+	shDestroyMultiDevice(p_multi_device);
+	shFreeMultiDevice(p_multi_device);
+
+	shDestroyInstance(instance);
+
+	return 0;
+}
+
+void setupPipeline(
+	VkDevice          device,
+	VkBuffer          buffer,
+	ShVkPipelinePool* p_pipeline_pool
+) {
+	shPipelinePoolSetDescriptorBufferInfos(
+		0,//first_descriptor
+		1,//descriptor_count
+		buffer,//buffer
+		VALUES_OFFSET,//buffer_offset
+		VALUES_SIZE,//buffer_size
+		p_pipeline_pool//p_pipeline_pool
+	);
+
+	shPipelinePoolSetDescriptorBufferInfos(
+		1,//first_descriptor
+		1,//descriptor_count
+		buffer,//buffer
+		FACTOR_OFFSET,//buffer_offset
+		sizeof(factor),//buffer_size
+		p_pipeline_pool//p_pipeline_pool
+	);
+
+	shPipelinePoolCreateDescriptorSetLayoutBinding(
+		0,//binding
+		VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,//descriptor_type
+		1,//descriptor_set_count
+		VK_SHADER_STAGE_COMPUTE_BIT,//shader_stage
+		p_pipeline_pool//p_pipeline_pool
+	);
+
+	shPipelinePoolCreateDescriptorSetLayout(
+		device,//device
+		0,//first_binding_idx
+		1,//binding_count
+		0,//set_layout_idx
+		0,//flags
+		p_pipeline_pool//p_pipeline_pool
+	);
+
+	shPipelinePoolCopyDescriptorSetLayout(
+		0,//src_set_layout_idx
+		0,//first_dst_set_layout_idx
+		2,//dst_set_layout_count
+		p_pipeline_pool//p_pipeline_pool
+	);
+
+	shPipelinePoolCreateDescriptorPool(
+		device,//device
+		0,//pool_idx
+		VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,//descriptor_type
+		2,//descriptor_count
+		p_pipeline_pool//p_pipeline_pool
+	);
+
+	shPipelinePoolAllocateDescriptorSetUnits(
+		device,//device
+		0,//binding
+		0,//pool_idx
+		VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,//descriptor_type
+		0,//first_descriptor_set_unit
+		2,//descriptor_set_unit_count
+		p_pipeline_pool//p_pipeline_pool
+	);
+
+	shPipelinePoolUpdateDescriptorSetUnits(
+		device,//device
+		0,//first_descriptor_set_unit
+		2,//descriptor_set_unit_count
+		p_pipeline_pool//p_pipeline_pool
+	);
+
+	ShVkPipeline* p_pipeline = &p_pipeline_pool->pipelines[0];
+
+	uint32_t shader_size = 0;
+	char* shader_code = readBinary(
+		"../../examples/shaders/bin/power.comp.spv",
+		&shader_size
+	);
+
+	shPipelineCreateShaderModule(
+		device,//device
+		shader_size,//size
+		shader_code,//code
+		p_pipeline//p_pipeline
+	);
+
+	free(shader_code);
+
+	shPipelineCreateShaderStage(
+		VK_SHADER_STAGE_COMPUTE_BIT,//shader_stage
+		p_pipeline//p_pipeline
+	);
+
+	shPipelineCreateLayout(
+		device,//device
+		0,//first_descriptor_set_layout
+		2,//descriptor_set_layout_count
+		p_pipeline_pool,//p_pipeline_pool
+		p_pipeline//p_pipeline
+	);
+
+	shSetupComputePipeline(device, p_pipeline);
+}
+
+#ifdef _MSC_VER
+#pragma warning (disable: 4996)
+#endif//_MSC_VER
+#include <stdlib.h>
+char* readBinary(const char* path, uint32_t* p_size) {
+	FILE* stream = fopen(path, "rb");
+	if (stream == NULL) {
+		return NULL;
+	}
+	fseek(stream, 0, SEEK_END);
+	uint32_t code_size = ftell(stream);
+	fseek(stream, 0, SEEK_SET);
+	char* code = (char*)calloc(1, code_size);
+	if (code == NULL) {
+		fclose(stream);
+		return NULL;
+	}
+	fread(code, code_size, 1, stream);
+	*p_size = code_size;
+	fclose(stream);
+	return code;
+}
+
+#ifdef __cplusplus
+}
+#endif//__cplusplus
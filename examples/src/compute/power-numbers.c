@@ -133,7 +133,8 @@ int main(void) {
 		0,//extension_count
 		NULL,//pp_extension_names
 		1,//device_queue_count
-		&compute_queue_info//p_device_queue_infos
+		&compute_queue_info,//p_device_queue_infos
+		VK_NULL_HANDLE//p_next
 	);
 
 	shGetDeviceQueues(
@@ -589,6 +590,7 @@ void setupPipeline(
 		0,//first_binding_idx
 		1,//binding_count
 		0,//set_layout_idx
+		0,//flags
 		p_pipeline_pool//p_pipeline_pool
 	);
 
@@ -0,0 +1,409 @@
+#ifdef __cplusplus
+extern "C" {
+#endif//__cplusplus
+
+#include <shvulkan/shVulkan.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+
+
+void setupPipeline(
+	VkDevice          device,
+	VkBuffer          buffer,
+	ShVkPipelinePool* p_pipeline_pool
+);
+
+double recordCommands(
+	VkCommandBuffer   cmd_buffer,
+	VkBuffer          buffer,
+	ShVkPipelinePool* p_pipeline_pool
+);
+
+char* readBinary(const char* path, uint32_t* p_size);
+
+
+
+//
+//EACH ITERATION RECORDS A PIPELINE BIND, A DESCRIPTOR SET BIND, A DISPATCH AND A BUFFER COPY
+//
+#define ITERATION_COUNT 100000
+#define ROUND_COUNT     8
+
+#define BUFFER_SIZE     256
+
+
+
+int main(void) {
+
+	VkInstance       instance                   = VK_NULL_HANDLE;
+	VkDevice         device                     = VK_NULL_HANDLE;
+	VkPhysicalDevice physical_device            = VK_NULL_HANDLE;
+
+	uint32_t         compute_queue_family_index = 0;
+
+	VkCommandPool    cmd_pool                   = VK_NULL_HANDLE;
+	VkCommandBuffer  cmd_buffer                 = VK_NULL_HANDLE;
+
+	shCreateInstance(
+		"vulkan app",//application_name,
+		"vulkan engine",//engine_name,
+		0,//enable_validation_layers,
+		0,//extension_count,
+		NULL,//pp_extension_names,
+		VK_MAKE_API_VERSION(1, 3, 0, 0),//api_version,
+		&instance//p_instance
+	);
+
+	shSelectPhysicalDevice(
+		instance,//instance
+		VK_NULL_HANDLE,//surface
+		VK_QUEUE_COMPUTE_BIT,//requirements
+		&physical_device,//p_physical_device
+		NULL,//p_physical_device_properties
+		NULL,//p_physical_device_features
+		NULL//p_physical_device_memory_properties
+	);
+
+	uint32_t compute_queue_family_indices[SH_MAX_STACK_QUEUE_COUNT] = { 0 };
+
+	shGetPhysicalDeviceQueueFamilies(
+		physical_device,//physical_device
+		VK_NULL_HANDLE,//surface
+		NULL,//p_queue_family_count
+		NULL,//p_graphics_queue_family_count
+		NULL,//p_surface_queue_family_count
+		NULL,//p_compute_queue_family_count
+		NULL,//p_transfer_queue_family_count
+		NULL,//p_graphics_queue_family_indices
+		NULL,//p_surface_queue_family_indices
+		compute_queue_family_indices,//p_compute_queue_family_indices
+		NULL,//p_transfer_queue_family_indices
+		NULL//p_queue_families_properties
+	);
+
+	compute_queue_family_index = compute_queue_family_indices[0];
+
+	VkDeviceQueueCreateInfo compute_queue_info     = { 0 };
+	float                   compute_queue_priority = 1.0f;
+
+	shQueryForDeviceQueueInfo(
+		compute_queue_family_index,//queue_family_index
+		1,//queue_count
+		&compute_queue_priority,//p_queue_priorities
+		0,//protected
+		&compute_queue_info//p_device_queue_info
+	);
+
+	shSetLogicalDevice(
+		physical_device,//physical_device
+		&device,//p_device
+		0,//extension_count
+		NULL,//pp_extension_names
+		1,//device_queue_count
+		&compute_queue_info,//p_device_queue_infos
+		VK_NULL_HANDLE//p_next
+	);
+
+	shCreateCommandPool(
+		device,//device
+		compute_queue_family_index,//queue_family_index
+		&cmd_pool//p_cmd_pool
+	);
+
+	shAllocateCommandBuffers(
+		device,//device
+		cmd_pool,//cmd_pool
+		1,//cmd_buffer_count
+		&cmd_buffer//p_cmd_buffer
+	);
+
+	VkBuffer       buffer = VK_NULL_HANDLE;
+	VkDeviceMemory memory = VK_NULL_HANDLE;
+
+	shCreateBuffer(
+		device,//device
+		BUFFER_SIZE,//size
+		VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,//usage
+		VK_SHARING_MODE_EXCLUSIVE,//sharing_mode
+		&buffer//p_buffer
+	);
+
+	shAllocateBufferMemory(
+		device,//device
+		physical_device,//physical_device
+		buffer,//buffer
+		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,//property_flags
+		&memory//p_memory
+	);
+
+	shBindBufferMemory(
+		device,//device
+		buffer,//buffer
+		0,//offset
+		memory//buffer_memory
+	);
+
+	ShVkPipelinePool* p_pipeline_pool = shAllocatePipelinePool();
+
+	shVkError(
+		p_pipeline_pool == NULL,
+		"invalid pipeline pool memory",
+		return -1
+	);
+
+	setupPipeline(
+		device,//device
+		buffer,//buffer
+		p_pipeline_pool//p_pipeline_pool
+	);
+
+	//
+	//COMPARE BUILDS CONFIGURED WITH SH_VULKAN_VALIDATION=PRINT, ASSERT AND NONE
+	//(the validation define is public, the inline command wrappers check like shvulkan)
+	//
+#if defined(SH_VULKAN_VALIDATION_NONE)
+	printf("validation: NONE\n");
+#elif defined(SH_VULKAN_VALIDATION_ASSERT)
+	printf("validation: ASSERT\n");
+#else
+	printf("validation: PRINT\n");
+#endif//SH_VULKAN_VALIDATION_NONE
+
+	//
+	//RECORD WITH THE LOADER EXPORTS, NO TABLE IS REGISTERED FOR THE DEVICE YET
+	//
+	double loader_ns = recordCommands(cmd_buffer, buffer, p_pipeline_pool);
+	printf("loader dispatch: %.2f ns per iteration\n", loader_ns);
+
+#ifdef SH_VULKAN_DEVICE_DISPATCH
+	//
+	//RECORD WITH THE DEVICE DISPATCH TABLE, RESOLVED ONCE BY shBeginCommandBuffer
+	//
+	ShVkDeviceDispatchTable dispatch_table = { 0 };
+	shLoadDeviceDispatchTable(device, &dispatch_table);
+
+	double device_ns = recordCommands(cmd_buffer, buffer, p_pipeline_pool);
+	printf("device dispatch: %.2f ns per iteration\n", device_ns);
+
+	shUnloadDeviceDispatchTable(device);
+#else
+	printf("build shvulkan with SH_VULKAN_DEVICE_DISPATCH to compare with the device dispatch table\n");
+#endif//SH_VULKAN_DEVICE_DISPATCH
+
+	//
+	//RELEASE RESOURCES
+	//
+	ShVkPipeline* p_pipeline = &p_pipeline_pool->pipelines[0];
+
+	shPipelinePoolDestroyDescriptorPools(device, 0, 1, p_pipeline_pool);
+	shPipelinePoolDestroyDescriptorSetLayouts(device, 0, 1, p_pipeline_pool);
+
+	shPipelineDestroyShaderModules(device, 0, 1, p_pipeline);
+	shPipelineDestroyLayout       (device, p_pipeline);
+	shDestroyPipeline             (device, p_pipeline->pipeline);
+
+	shFreePipelinePool(p_pipeline_pool);
+
+	shClearBufferMemory(device, buffer, memory);
+
+	shDestroyCommandBuffers(device, cmd_pool, 1, &cmd_buffer);
+	shDestroyCommandPool(device, cmd_pool);
+
+	shDestroyDevice(device);
+	shDestroyInstance(instance);
+
+	return 0;
+}
+
+double recordCommands(
+	VkCommandBuffer   cmd_buffer,
+	VkBuffer          buffer,
+	ShVkPipelinePool* p_pipeline_pool
+) {
+	ShVkPipeline* p_pipeline = &p_pipeline_pool->pipelines[0];
+
+	double best_ns = 0.0;
+
+	//
+	//KEEP THE FASTEST ROUND, THE FIRST ONES WARM UP THE COMMAND POOL
+	//
+	for (uint32_t round_idx = 0; round_idx < ROUND_COUNT; round_idx++) {
+		shResetCommandBuffer(cmd_buffer);
+		shBeginCommandBuffer(cmd_buffer);
+
+		clock_t start = clock();
+
+		for (uint32_t iteration_idx = 0; iteration_idx < ITERATION_COUNT; iteration_idx++) {
+			shBindPipeline(cmd_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, p_pipeline);
+
+			shPipelineBindDescriptorSetUnits(
+				cmd_buffer,//cmd_buffer
+				0,//first_descriptor_set
+				0,//first_descriptor_set_unit_idx
+				2,//descriptor_set_unit_count
+				VK_PIPELINE_BIND_POINT_COMPUTE,//bind_point
+				0,//dynamic_descriptors_count
+				NULL,//p_dynamic_offsets
+				p_pipeline_pool,//p_pipeline_pool
+				p_pipeline//p_pipeline
+			);
+
+			shCmdDispatch(cmd_buffer, 1, 1, 1);
+
+			shCopyBuffer(
+				cmd_buffer,//transfer_cmd_buffer
+				buffer,//src_buffer
+				0,//src_offset
+				BUFFER_SIZE / 2,//dst_offset
+				BUFFER_SIZE / 2,//size
+				buffer//dst_buffer
+			);
+		}
+
+		clock_t end = clock();
+
+		shEndCommandBuffer(cmd_buffer);
+
+		double ns = (double)(end - start) * 1e9 / (double)CLOCKS_PER_SEC / (double)ITERATION_COUNT;
+		if (round_idx == 0 || ns < best_ns) {
+			best_ns = ns;
+		}
+	}
+
+	return best_ns;
+}
+
+void setupPipeline(
+	VkDevice          device,
+	VkBuffer          buffer,
+	ShVkPipelinePool* p_pipeline_pool
+) {
+	shPipelinePoolSetDescriptorBufferInfos(
+		0,//first_descriptor
+		1,//descriptor_count
+		buffer,//buffer
+		0,//buffer_offset
+		BUFFER_SIZE / 2,//buffer_size
+		p_pipeline_pool//p_pipeline_pool
+	);
+
+	shPipelinePoolSetDescriptorBufferInfos(
+		1,//first_descriptor
+		1,//descriptor_count
+		buffer,//buffer
+		BUFFER_SIZE / 2,//buffer_offset
+		BUFFER_SIZE / 2,//buffer_size
+		p_pipeline_pool//p_pipeline_pool
+	);
+
+	shPipelinePoolCreateDescriptorSetLayoutBinding(
+		0,//binding
+		VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,//descriptor_type
+		1,//descriptor_set_count
+		VK_SHADER_STAGE_COMPUTE_BIT,//shader_stage
+		p_pipeline_pool//p_pipeline_pool
+	);
+
+	shPipelinePoolCreateDescriptorSetLayout(
+		device,//device
+		0,//first_binding_idx
+		1,//binding_count
+		0,//set_layout_idx
+		0,//flags
+		p_pipeline_pool//p_pipeline_pool
+	);
+
+	shPipelinePoolCopyDescriptorSetLayout(
+		0,//src_set_layout_idx
+		0,//first_dst_set_layout_idx
+		2,//dst_set_layout_count
+		p_pipeline_pool//p_pipeline_pool
+	);
+
+	shPipelinePoolCreateDescriptorPool(
+		device,//device
+		0,//pool_idx
+		VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,//descriptor_type
+		2,//descriptor_count
+		p_pipeline_pool//p_pipeline_pool
+	);
+
+	shPipelinePoolAllocateDescriptorSetUnits(
+		device,//device
+		0,//binding
+		0,//pool_idx
+		VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,//descriptor_type
+		0,//first_descriptor_set_unit
+		2,//descriptor_set_unit_count
+		p_pipeline_pool//p_pipeline_pool
+	);
+
+	shPipelinePoolUpdateDescriptorSetUnits(
+		device,//device
+		0,//first_descriptor_set_unit
+		2,//descriptor_set_unit_count
+		p_pipeline_pool//p_pipeline_pool
+	);
+
+	ShVkPipeline* p_pipeline = &p_pipeline_pool->pipelines[0];
+
+	uint32_t shader_size = 0;
+	char* shader_code = readBinary(
+		"../../examples/shaders/bin/power.comp.spv",
+		&shader_size
+	);
+
+	shPipelineCreateShaderModule(
+		device,//device
+		shader_size,//size
+		shader_code,//code
+		p_pipeline//p_pipeline
+	);
+
+	free(shader_code);
+
+	shPipelineCreateShaderStage(
+		VK_SHADER_STAGE_COMPUTE_BIT,//shader_stage
+		p_pipeline//p_pipeline
+	);
+
+	shPipelineCreateLayout(
+		device,//device
+		0,//first_descriptor_set_layout
+		2,//descriptor_set_layout_count
+		p_pipeline_pool,//p_pipeline_pool
+		p_pipeline//p_pipeline
+	);
+
+	shSetupComputePipeline(device, p_pipeline);
+}
+
+#ifdef _MSC_VER
+#pragma warning (disable: 4996)
+#endif//_MSC_VER
+char* readBinary(const char* path, uint32_t* p_size) {
+	FILE* stream = fopen(path, "rb");
+	if (stream == NULL) {
+		return NULL;
+	}
+	fseek(stream, 0, SEEK_END);
+	uint32_t code_size = ftell(stream);
+	fseek(stream, 0, SEEK_SET);
+	char* code = (char*)calloc(1, code_size);
+	if (code == NULL) {
+		fclose(stream);
+		return NULL;
+	}
+	fread(code, code_size, 1, stream);
+	*p_size = code_size;
+	fclose(stream);
+	return code;
+}
+
+#ifdef __cplusplus
+}
+#endif//__cplusplus
@@ -0,0 +1,1029 @@
+#ifdef __cplusplus
+extern "C" {
+#endif//__cplusplus
+
+
+
+#include <shvulkan/shVulkan.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define WIDTH  800
+#define HEIGHT 600
+
+#define DEFAULT_FRAME_COUNT 240
+#define DEFAULT_OUTPUT_PATH "frames.ppm"
+
+#define RENDER_TARGET_COUNT            2
+#define READBACK_SLOT_COUNT            3
+#define RENDERPASS_ATTACHMENT_COUNT    2
+#define SUBPASS_COLOR_ATTACHMENT_COUNT 1
+
+#define COLOR_FORMAT     VK_FORMAT_R8G8B8A8_UNORM
+#define COLOR_TEXEL_SIZE 4
+
+#define QUAD_VERTEX_COUNT     20
+#define TRIANGLE_VERTEX_COUNT 15
+#define QUAD_INDEX_COUNT      6
+
+#define PER_VERTEX_BINDING    0
+#define PER_INSTANCE_BINDING  1
+
+float quad[QUAD_VERTEX_COUNT] = {
+		-0.5f,-0.5f, 0.0f,  0.0f, 0.0f,
+		 0.5f,-0.5f, 0.0f,  0.0f, 0.0f,
+		 0.5f, 0.5f, 0.0f,  0.0f, 0.0f,
+		-0.5f, 0.5f, 0.0f,  0.0f, 0.0f,
+};
+
+float triangle[TRIANGLE_VERTEX_COUNT] = {
+		-1.0f, 1.0f, 0.0f,  0.0f, 0.0f,
+		 0.0f, 0.0f, 0.0f,  0.0f, 0.0f,
+		 1.0f, 1.0f, 0.0f,  0.0f, 0.0f
+};
+
+float models[48] = {
+	0.2f, 0.0f, 0.0f, 0.0f,//model 0
+	0.0f, 1.3f, 0.0f, 0.0f,
+	0.0f, 0.0f, 1.0f, 0.0f,
+   -0.4f,-0.2f, 0.3f, 1.0f,
+
+	0.2f, 0.0f, 0.0f, 0.0f,//model 1
+	0.0f, 1.3f, 0.0f, 0.0f,
+	0.0f, 0.0f, 1.0f, 0.0f,
+	0.4f,-0.2f, 0.2f, 1.0f,
+
+	0.7f, 0.0f, 0.0f, 0.0f,//model 2
+	0.0f, 0.5f, 0.0f, 0.0f,
+	0.0f, 0.0f, 1.0f, 0.0f,
+	0.0f, 0.3f, 0.1f, 1.0f
+};
+
+uint32_t indices[QUAD_INDEX_COUNT] = {
+	0, 1, 2,
+	2, 3, 0
+};
+
+float light[8] = {
+	0.0f,  2.0f, 0.0f, 1.0f, //position
+	0.0f, 0.45f, 0.9f, 1.0f	 //color
+};
+
+float projection_view[32] = {
+	1.0f, 0.0f, 0.0f, 0.0f,
+	0.0f, 1.0f, 0.0f, 0.0f,
+	0.0f, 0.0f, 1.0f, 0.0f,
+	0.0f, 0.0f, 0.0f, 1.0f,
+
+	1.0f, 0.0f, 0.0f, 0.0f,
+	0.0f, 1.0f, 0.0f, 0.0f,
+	0.0f, 0.0f, 1.0f, 0.0f,
+	0.0f, 0.0f, 0.0f, 1.0f
+};
+
+#define DESCRIPTOR_SET_COUNT        1
+#define INFO_DESCRIPTOR_SET_IDX     0
+#define OPTIONAL_DESCRIPTOR_SET_IDX 1
+
+void writeMemory(
+	VkDevice         device,
+	VkPhysicalDevice physical_device,
+	VkCommandBuffer  cmd_buffer,
+	VkFence          fence,
+	VkQueue          transfer_queue,
+	VkBuffer*        p_staging_buffer,
+	VkDeviceMemory*  p_staging_memory,
+	VkBuffer*        p_vertex_buffer,
+	VkDeviceMemory*  p_vertex_memory,
+	VkBuffer*        p_instance_buffer,
+	VkDeviceMemory*  p_instance_memory,
+	VkBuffer*        p_index_buffer,
+	VkDeviceMemory*  p_index_memory,
+	VkBuffer*        p_descriptors_buffer,
+	VkDeviceMemory*  p_descriptors_memory
+);
+
+void releaseMemory(
+	VkDevice       device,
+	VkBuffer       staging_buffer,
+	VkDeviceMemory staging_memory,
+	VkBuffer       vertex_buffer,
+	VkDeviceMemory vertex_memory,
+	VkBuffer       instance_buffer,
+	VkDeviceMemory instance_memory,
+	VkBuffer       index_buffer,
+	VkDeviceMemory index_memory,
+	VkBuffer       descriptors_buffer,
+	VkDeviceMemory descriptors_memory
+);
+
+void createPipelinesDataPool(
+	VkDevice          device,
+	VkBuffer          descriptors_buffer,
+	uint32_t          swapchain_image_count,
+	ShVkPipelinePool* p_pipeline_pool
+);
+
+void createPipeline(
+	VkDevice          device,
+	VkRenderPass      renderpass,
+	uint32_t          width,
+	uint32_t          height,
+	uint32_t          sample_count,
+	uint32_t          swapchain_image_count,
+	ShVkPipelinePool* p_pipeline_pool
+);
+
+uint8_t collectFrames(
+	VkDevice            device,
+	uint8_t             wait,
+	ShVkReadbackEngine* p_engine,
+	ShVkFrameWriter*    p_writer,
+	uint64_t*           p_readback_wait_ns
+);
+
+char* readBinary(
+	const char* path,
+	uint32_t* p_size
+);
+
+int main(int argc, char** argv) {
+
+	uint32_t            frame_count = DEFAULT_FRAME_COUNT;
+	const char*         output_path = DEFAULT_OUTPUT_PATH;
+	ShVkFrameFileFormat file_format = SH_FRAME_FILE_FORMAT_PPM;
+
+	if (argc > 1) {
+		frame_count = (uint32_t)strtoul(argv[1], NULL, 10);
+	}
+	if (argc > 2) {
+		output_path = argv[2];
+	}
+	if (argc > 3 && strcmp(argv[3], "raw") == 0) {
+		file_format = SH_FRAME_FILE_FORMAT_RAW;
+	}
+	if (frame_count == 0) {
+		printf("usage: shvulkan-batch-render [frame_count] [output_path] [raw|ppm]\n");
+		return -1;
+	}
+
+	VkInstance                       instance                                         = VK_NULL_HANDLE;
+
+	VkPhysicalDevice                 physical_device                                  = VK_NULL_HANDLE;
+	VkPhysicalDeviceProperties       physical_device_properties                       = { 0 };
+	VkPhysicalDeviceFeatures         physical_device_features                         = { 0 };
+	VkPhysicalDeviceMemoryProperties physical_device_memory_properties                = { 0 };
+
+	uint32_t                         graphics_queue_family_index                      = 0;
+
+	VkDevice                         device                                           = VK_NULL_HANDLE;
+
+	VkQueue                          graphics_queue                                   = VK_NULL_HANDLE;
+
+	VkCommandPool                    graphics_cmd_pool                                = VK_NULL_HANDLE;
+
+	VkCommandBuffer                  graphics_cmd_buffers[RENDER_TARGET_COUNT]        = { VK_NULL_HANDLE };
+
+	VkFence                          graphics_cmd_fences[RENDER_TARGET_COUNT]         = { VK_NULL_HANDLE };
+
+	uint32_t                         sample_count                                     = 1;//copied to the host as it is
+
+	VkAttachmentDescription          color_attachment                                 = { 0 };
+	VkAttachmentReference            color_attachment_reference                       = { 0 };
+	VkAttachmentDescription          depth_attachment                                 = { 0 };
+	VkAttachmentReference            depth_attachment_reference                       = { 0 };
+	VkSubpassDescription             subpass                                          = { 0 };
+
+	VkRenderPass                     renderpass                                       = VK_NULL_HANDLE;
+
+	VkImage                          depth_images[RENDER_TARGET_COUNT]                = { VK_NULL_HANDLE };
+	VkDeviceMemory                   depth_images_memory[RENDER_TARGET_COUNT]         = { VK_NULL_HANDLE };
+	VkImageView                      depth_image_views[RENDER_TARGET_COUNT]           = { VK_NULL_HANDLE };
+	VkImage                          color_images[RENDER_TARGET_COUNT]                = { VK_NULL_HANDLE };
+	VkDeviceMemory                   color_images_memory[RENDER_TARGET_COUNT]         = { VK_NULL_HANDLE };
+	VkImageView                      color_image_views[RENDER_TARGET_COUNT]           = { VK_NULL_HANDLE };
+
+	VkFramebuffer                    framebuffers[RENDER_TARGET_COUNT]                = { VK_NULL_HANDLE };
+
+	shCreateInstance(
+		"vulkan app", //application_name
+		"vulkan engine",//engine_name
+		0,//enable_validation_layers, off when measuring throughput
+		0, //extension_count
+		NULL,//pp_extension_names
+		VK_MAKE_API_VERSION(1, 3, 0, 0),//api_version
+		&instance//p_instance
+	);
+
+	shSelectPhysicalDevice(
+		instance,//instance,
+		NULL,//surface,
+		VK_QUEUE_GRAPHICS_BIT |
+		VK_QUEUE_TRANSFER_BIT,//requirements,
+		&physical_device,//p_physical_device,
+		&physical_device_properties,//p_physical_device_properties,
+		&physical_device_features,//p_physical_device_features,
+		&physical_device_memory_properties//p_physical_device_memory_properties
+	);
+
+	uint32_t graphics_queue_families_indices[SH_MAX_STACK_QUEUE_FAMILY_COUNT] = { 0 };
+	shGetPhysicalDeviceQueueFamilies(
+		physical_device,//physical_device
+		NULL,//surface
+		VK_NULL_HANDLE,//p_queue_family_count
+		VK_NULL_HANDLE,//p_graphics_queue_family_count
+		VK_NULL_HANDLE,//p_surface_queue_family_count
+		VK_NULL_HANDLE,//p_compute_queue_family_count
+		VK_NULL_HANDLE,//p_transfer_queue_family_count
+		graphics_queue_families_indices,//p_graphics_queue_family_indices
+		NULL,//p_surface_queue_family_indices
+		VK_NULL_HANDLE,//p_compute_queue_family_indices
+		VK_NULL_HANDLE,//p_transfer_queue_family_indices
+		VK_NULL_HANDLE//p_queue_families_properties
+	);
+	graphics_queue_family_index = graphics_queue_families_indices[0];
+
+	float default_queue_priority = 1.0f;
+	VkDeviceQueueCreateInfo graphics_device_queue_info = { 0 };
+	shQueryForDeviceQueueInfo(
+		graphics_queue_family_index,//queue_family_index
+		1,//queue_count
+		&default_queue_priority,//p_queue_priorities
+		0,//protected
+		&graphics_device_queue_info//p_device_queue_info
+	);
+
+	shSetLogicalDevice(
+		physical_device,//physical_device
+		&device,//p_device
+		0,//extension_count
+		NULL,//pp_extension_names
+		1,//device_queue_count
+		&graphics_device_queue_info,//p_device_queue_infos
+		VK_NULL_HANDLE//p_next
+	);
+
+	shGetDeviceQueues(
+		device,//device
+		1,//queue_count
+		&graphics_queue_family_index,//p_queue_family_indices
+		&graphics_queue//p_queues
+	);
+
+	shCreateCommandPool(
+		device,//device
+		graphics_queue_family_index,//queue_family_index
+		&graphics_cmd_pool//p_cmd_pool
+	);
+
+	shAllocateCommandBuffers(
+		device,//device
+		graphics_cmd_pool,//cmd_pool
+		RENDER_TARGET_COUNT,//cmd_buffer_count
+		graphics_cmd_buffers//p_cmd_buffer
+	);
+
+	shCreateFences(
+		device,//device
+		RENDER_TARGET_COUNT,//fence_count
+		1,//signaled
+		graphics_cmd_fences//p_fences
+	);
+
+	shCreateRenderpassAttachment(
+		COLOR_FORMAT,//format
+		sample_count,//sample_count
+		VK_ATTACHMENT_LOAD_OP_CLEAR,//load_treatment
+		VK_ATTACHMENT_STORE_OP_STORE,//store_treatment
+		VK_ATTACHMENT_LOAD_OP_DONT_CARE,//stencil_load_treatment
+		VK_ATTACHMENT_STORE_OP_DONT_CARE,//stencil_store_treatment
+		VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,//initial_layout, set by the barrier at the beginning of each frame
+		VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,//final_layout, the readback engine restores it after the copy
+		&color_attachment//p_attachment_description
+	);
+	shCreateRenderpassAttachmentReference(
+		0,//attachment_idx
+		VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,//layout
+		&color_attachment_reference//p_attachment_reference
+	);
+
+	shCreateRenderpassAttachment(
+		VK_FORMAT_D32_SFLOAT,//format
+		sample_count,//sample_count
+		VK_ATTACHMENT_LOAD_OP_CLEAR,//load_treatment
+		VK_ATTACHMENT_STORE_OP_DONT_CARE,//store_treatment
+		VK_ATTACHMENT_LOAD_OP_DONT_CARE,//stencil_load_treatment
+		VK_ATTACHMENT_STORE_OP_DONT_CARE,//stencil_store_treatment
+		VK_IMAGE_LAYOUT_UNDEFINED,//initial_layout
+		VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,//final_layout
+		&depth_attachment//p_attachment_description
+	);
+	shCreateRenderpassAttachmentReference(
+		1,//attachment_idx
+		VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,//layout
+		&depth_attachment_reference//p_attachment_reference
+	);
+
+	shCreateSubpass(
+		VK_PIPELINE_BIND_POINT_GRAPHICS,//bind_point
+		0,//input_attachment_count
+		VK_NULL_HANDLE,//p_input_attachments_reference
+		SUBPASS_COLOR_ATTACHMENT_COUNT,//color_attachment_count
+		&color_attachment_reference,//p_color_attachments_reference
+		&depth_attachment_reference,//p_depth_stencil_attachment_reference
+		VK_NULL_HANDLE,//p_resolve_attachment_reference
+		0,//preserve_attachment_count
+		VK_NULL_HANDLE,//p_preserve_attachments
+		&subpass//p_subpass
+	);
+
+	VkAttachmentDescription attachment_descriptions[RENDERPASS_ATTACHMENT_COUNT] = {
+		color_attachment, depth_attachment
+	};
+	shCreateRenderpass(
+		device,//device
+		RENDERPASS_ATTACHMENT_COUNT,//attachment_count
+		attachment_descriptions,//p_attachments_descriptions
+		1,//subpass_count
+		&subpass,//p_subpasses
+		&renderpass//p_renderpass
+	);
+
+	//one color and depth image per frame in flight
+	for (uint32_t i = 0; i < RENDER_TARGET_COUNT; i++) {
+		shCreateImage(
+			device,//device
+			VK_IMAGE_TYPE_2D,//type
+			WIDTH,//x
+			HEIGHT,//y
+			1,//z
+			VK_FORMAT_D32_SFLOAT,//format
+			1,//mip_levels
+			sample_count,//sample_count
+			VK_IMAGE_TILING_OPTIMAL,//image_tiling
+			VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT,//usage
+			VK_SHARING_MODE_EXCLUSIVE,//sharing_mode
+			&depth_images[i]//p_image
+		);
+		shAllocateImageMemory(
+			device, physical_device, depth_images[i],
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &depth_images_memory[i]
+		);
+		shBindImageMemory(
+			device, depth_images[i], 0, depth_images_memory[i]
+		);
+		shCreateImageView(
+			device, depth_images[i], VK_IMAGE_VIEW_TYPE_2D,
+			VK_IMAGE_ASPECT_DEPTH_BIT, 1,
+			VK_FORMAT_D32_SFLOAT, &depth_image_views[i]
+		);
+
+		shCreateImage(
+			device, VK_IMAGE_TYPE_2D, WIDTH, HEIGHT, 1,
+			COLOR_FORMAT, 1, sample_count,
+			VK_IMAGE_TILING_OPTIMAL,
+			VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT, VK_SHARING_MODE_EXCLUSIVE,
+			&color_images[i]
+		);
+		shAllocateImageMemory(
+			device, physical_device, color_images[i],
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &color_images_memory[i]
+		);
+		shBindImageMemory(
+			device, color_images[i], 0, color_images_memory[i]
+		);
+		shCreateImageView(
+			device, color_images[i], VK_IMAGE_VIEW_TYPE_2D,
+			VK_IMAGE_ASPECT_COLOR_BIT, 1, COLOR_FORMAT,
+			&color_image_views[i]
+		);
+
+		VkImageView image_views[RENDERPASS_ATTACHMENT_COUNT] = {
+			color_image_views[i], depth_image_views[i]
+		};
+		shCreateFramebuffer(
+			device,//device
+			renderpass,//renderpass
+			RENDERPASS_ATTACHMENT_COUNT,//image_view_count
+			image_views,//p_image_views
+			WIDTH,//x
+			HEIGHT,//y
+			1,//z
+			&framebuffers[i]//p_framebuffer
+		);
+	}
+
+	VkBuffer       staging_buffer     = VK_NULL_HANDLE;
+	VkDeviceMemory staging_memory     = VK_NULL_HANDLE;
+
+	VkBuffer       vertex_buffer      = VK_NULL_HANDLE;
+	VkBuffer       instance_buffer    = VK_NULL_HANDLE;
+	VkBuffer       index_buffer       = VK_NULL_HANDLE;
+	VkBuffer       descriptors_buffer = VK_NULL_HANDLE;
+
+	VkDeviceMemory vertex_memory      = VK_NULL_HANDLE;
+	VkDeviceMemory instance_memory    = VK_NULL_HANDLE;
+	VkDeviceMemory index_memory       = VK_NULL_HANDLE;
+	VkDeviceMemory descriptors_memory = VK_NULL_HANDLE;
+
+	writeMemory(
+		device,
+		physical_device,
+		graphics_cmd_buffers[0],//any graphics command buffer
+		graphics_cmd_fences[0],
+		graphics_queue,
+		&staging_buffer,
+		&staging_memory,
+		&vertex_buffer,
+		&vertex_memory,
+		&instance_buffer,
+		&instance_memory,
+		&index_buffer,
+		&index_memory,
+		&descriptors_buffer,
+		&descriptors_memory
+	);
+
+	ShVkPipelinePool* p_pipeline_pool =  shAllocatePipelinePool();
+
+	shVkError(
+		p_pipeline_pool == VK_NULL_HANDLE,
+		"invalid pipeline pool memory",
+		return -1
+	);
+
+	ShVkPipeline* p_pipeline = &p_pipeline_pool->pipelines[0];
+
+	//the scene buffers are never written while rendering, a single descriptor set is shared by all frames
+	createPipelinesDataPool(
+		device,
+		descriptors_buffer,
+		1,
+		p_pipeline_pool
+	);
+
+	createPipeline(
+		device, renderpass,
+		WIDTH, HEIGHT, sample_count,
+		1,
+		p_pipeline_pool
+	);
+
+	ShVkReadbackEngine* p_readback_engine = shAllocateReadbackEngine();
+	ShVkFrameWriter*    p_frame_writer    = shAllocateFrameWriter();
+
+	shVkError(
+		p_readback_engine == VK_NULL_HANDLE || p_frame_writer == VK_NULL_HANDLE,
+		"invalid batch render memory",
+		return -1
+	);
+
+	shCreateReadbackEngine(
+		device,//device
+		physical_device,//physical_device
+		graphics_queue_family_index,//queue_family_index
+		READBACK_SLOT_COUNT,//slot_count
+		WIDTH,//width
+		HEIGHT,//height
+		COLOR_TEXEL_SIZE,//texel_size
+		VK_IMAGE_ASPECT_COLOR_BIT,//image_aspect
+		p_readback_engine//p_engine
+	);
+
+	if (shOpenFrameWriter(
+		output_path,//path
+		file_format,//format
+		WIDTH,//width
+		HEIGHT,//height
+		COLOR_TEXEL_SIZE,//texel_size
+		0,//bgra
+		p_frame_writer//p_writer
+	) == 0) {
+		return -1;
+	}
+
+	uint64_t record_ns        = 0;
+	uint64_t render_wait_ns   = 0;
+	uint64_t readback_wait_ns = 0;
+	uint64_t start_ns         = shGetTimeNs();
+
+	for (uint32_t frame_idx = 0; frame_idx < frame_count; frame_idx++) {
+
+		//a readback slot must be free before the frame is submitted
+		while (p_readback_engine->submitted_count - p_readback_engine->released_count >= READBACK_SLOT_COUNT) {
+			collectFrames(device, 1, p_readback_engine, p_frame_writer, &readback_wait_ns);
+		}
+
+		uint32_t target_idx = frame_idx % RENDER_TARGET_COUNT;
+
+		uint64_t stage_start_ns = shGetTimeNs();
+		shWaitForFences(
+			device,//device
+			1,//fence_count
+			&graphics_cmd_fences[target_idx],//p_fences
+			1,//wait_for_all
+			UINT64_MAX//timeout_ns
+		);
+		shResetFences(
+			device,//device
+			1,//fence_count
+			&graphics_cmd_fences[target_idx]//p_fences
+		);
+		render_wait_ns += shGetTimeNs() - stage_start_ns;
+
+		stage_start_ns = shGetTimeNs();
+
+		VkCommandBuffer cmd_buffer = graphics_cmd_buffers[target_idx];
+
+		shBeginCommandBuffer(cmd_buffer);
+
+		//previous contents are discarded, waits for the readback copy of the previous frame on this target
+		shSetImageMemoryBarrier(
+			device, cmd_buffer, color_images[target_idx], VK_IMAGE_ASPECT_COLOR_BIT,
+			VK_ACCESS_TRANSFER_READ_BIT, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+			VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+			VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED,
+			VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT
+		);
+
+		VkClearValue clear_values[2] = { 0 };
+		float* p_colors = clear_values[0].color.float32;
+		p_colors[0] = 0.1f;
+		p_colors[1] = 0.1f;
+		p_colors[2] = 0.1f;
+		p_colors[3] = 1.0f;
+
+		clear_values[1].depthStencil.depth = 1.0f;
+
+		shBeginRenderpass(
+			cmd_buffer,//graphics_cmd_buffer
+			renderpass,//renderpass
+			0,//render_offset_x
+			0,//render_offset_y
+			WIDTH,//render_size_x
+			HEIGHT,//render_size_y
+			2,//only attachments with VK_ATTACHMENT_LOAD_OP_CLEAR
+			clear_values,//p_clear_values
+			framebuffers[target_idx]//framebuffer
+		);
+
+		VkDeviceSize vertex_offsets[2] = { 0, 0 };
+		VkBuffer     vertex_buffers[2] = { vertex_buffer, instance_buffer };
+		shBindVertexBuffers(cmd_buffer, 0, 2, vertex_buffers, vertex_offsets);
+
+		shBindIndexBuffer(cmd_buffer, 0, index_buffer);
+
+		shBindPipeline(cmd_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, p_pipeline);
+
+		//the scene parameter is the camera position, recorded with the frame
+		projection_view[28] = 0.3f * (float)sin((double)frame_idx / 20.0);
+		projection_view[29] = 0.1f * (float)cos((double)frame_idx / 30.0);
+		shPipelinePushConstants(cmd_buffer, projection_view, p_pipeline);
+
+		shPipelineBindDescriptorSetUnits(
+			cmd_buffer,                                 //cmd_buffer
+			INFO_DESCRIPTOR_SET_IDX,                    //first_descriptor_set
+			0,                                          //first_descriptor_set_unit_idx
+			DESCRIPTOR_SET_COUNT,                       //descriptor_set_unit_count
+			VK_PIPELINE_BIND_POINT_GRAPHICS,            //bind_point
+			0,                                          //dynamic_descriptors_count
+			VK_NULL_HANDLE,                             //p_dynamic_offsets
+			p_pipeline_pool,                            //p_pipeline_pool
+			p_pipeline                                  //p_pipeline
+		);
+
+		shDrawIndexed(cmd_buffer, QUAD_INDEX_COUNT, 2, 0, 0, 0);
+
+		shDraw(cmd_buffer, 3, 4, 1, 2);
+
+		shEndRenderpass(cmd_buffer);
+
+		shEndCommandBuffer(cmd_buffer);
+
+		shQueueSubmit(
+			1,//cmd_buffer_count
+			&cmd_buffer,//p_cmd_buffers
+			graphics_queue,//queue
+			graphics_cmd_fences[target_idx],//fence
+			0,//semaphores_to_wait_for_count
+			VK_NULL_HANDLE,//p_semaphores_to_wait_for
+			VK_PIPELINE_STAGE_ALL_GRAPHICS_BIT,//wait_stage
+			0,//signal_semaphore_count
+			VK_NULL_HANDLE//p_signal_semaphores
+		);
+
+		//same queue, submission order and the engine barrier keep the copy after the render pass
+		shReadbackEngineSubmit(
+			device,//device
+			graphics_queue,//queue
+			color_images[target_idx],//image
+			VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,//image_layout
+			VK_NULL_HANDLE,//wait_semaphore
+			frame_idx,//frame_id
+			p_readback_engine//p_engine
+		);
+		record_ns += shGetTimeNs() - stage_start_ns;
+
+		collectFrames(device, 0, p_readback_engine, p_frame_writer, &readback_wait_ns);
+	}
+
+	while (p_readback_engine->acquired_count < p_readback_engine->submitted_count) {
+		collectFrames(device, 1, p_readback_engine, p_frame_writer, &readback_wait_ns);
+	}
+
+	uint8_t written = shCloseFrameWriter(p_frame_writer);
+
+	uint64_t total_ns = shGetTimeNs() - start_ns;
+	double   total_s  = (double)total_ns / 1.0e9;
+
+	printf("batch render: %u frames %ux%u to %s (%s)\n",
+		frame_count, WIDTH, HEIGHT, output_path,
+		file_format == SH_FRAME_FILE_FORMAT_RAW ? "raw" : "ppm"
+	);
+	printf("total:         %.3f s, %.2f fps, %.2f MB/s\n",
+		total_s, (double)frame_count / total_s,
+		(double)p_frame_writer->written_bytes / (1024.0 * 1024.0) / total_s
+	);
+	printf("record/submit: %.3f ms/frame\n", (double)record_ns        / 1.0e6 / (double)frame_count);
+	printf("render wait:   %.3f ms/frame\n", (double)render_wait_ns   / 1.0e6 / (double)frame_count);
+	printf("readback wait: %.3f ms/frame\n", (double)readback_wait_ns / 1.0e6 / (double)frame_count);
+	printf("file write:    %.3f ms/frame (writer thread)\n", (double)p_frame_writer->write_time_ns / 1.0e6 / (double)frame_count);
+	if (written == 0) {
+		printf("batch render: not every frame was written\n");
+	}
+
+	shWaitDeviceIdle(device);
+
+	shDestroyReadbackEngine(device, p_readback_engine);
+	shFreeReadbackEngine(p_readback_engine);
+	shFreeFrameWriter(p_frame_writer);
+
+	shPipelinePoolDestroyDescriptorPools(device, 0, 1, p_pipeline_pool);
+	shPipelinePoolDestroyDescriptorSetLayouts(device, 0, 1, p_pipeline_pool);
+
+	shPipelineDestroyShaderModules(device, 0, 2, p_pipeline);
+	shPipelineDestroyLayout(device, p_pipeline);
+	shDestroyPipeline(device, p_pipeline->pipeline);
+
+	shClearPipeline(p_pipeline);
+
+	shFreePipelinePool(p_pipeline_pool);
+
+	shDestroyFences(device, RENDER_TARGET_COUNT, graphics_cmd_fences);
+
+	shDestroyCommandBuffers(device, graphics_cmd_pool, RENDER_TARGET_COUNT, graphics_cmd_buffers);
+
+	shDestroyCommandPool(device, graphics_cmd_pool);
+
+	releaseMemory(
+		device,
+		staging_buffer, staging_memory,
+		vertex_buffer, vertex_memory,
+		instance_buffer, instance_memory,
+		index_buffer, index_memory,
+		descriptors_buffer, descriptors_memory
+	);
+
+	for (uint32_t i = 0; i < RENDER_TARGET_COUNT; i++) {
+		shClearImageMemory(device, depth_images[i], depth_images_memory[i]);
+		shClearImageMemory(device, color_images[i], color_images_memory[i]);
+	}
+	shDestroyImageViews(device, RENDER_TARGET_COUNT, depth_image_views);
+	shDestroyImageViews(device, RENDER_TARGET_COUNT, color_image_views);
+
+	shDestroyRenderpass(device, renderpass);
+
+	shDestroyFramebuffers(device, RENDER_TARGET_COUNT, framebuffers);
+
+	shDestroyDevice(device);
+
+	shDestroyInstance(instance);
+
+	return written ? 0 : -1;
+}
+
+uint8_t collectFrames(
+	VkDevice            device,
+	uint8_t             wait,
+	ShVkReadbackEngine* p_engine,
+	ShVkFrameWriter*    p_writer,
+	uint64_t*           p_readback_wait_ns
+) {
+	//hand completed copies to the writer thread, the mapped slot memory is written without copies
+	uint8_t ready = 1;
+	while (ready && p_engine->acquired_count < p_engine->submitted_count) {
+		void*    p_data     = VK_NULL_HANDLE;
+		uint64_t wait_start = shGetTimeNs();
+		ready = 0;
+		shReadbackEngineAcquire(
+			device,//device
+			wait ? UINT64_MAX : 0,//timeout_ns
+			p_engine,//p_engine
+			&ready,//p_ready
+			&p_data,//pp_data
+			VK_NULL_HANDLE//p_frame_id
+		);
+		(*p_readback_wait_ns) += shGetTimeNs() - wait_start;
+		if (ready) {
+			shFrameWriterPush(p_data, p_writer);
+			wait = 0;//a single frame is enough to make progress
+		}
+	}
+
+	//slots are released in order once their frames reached the file
+	uint64_t written_count = 0;
+	shFrameWriterGetWrittenCount(
+		wait ? UINT64_MAX : 0,//timeout_ns
+		p_engine->released_count + 1,//min_written_count
+		p_writer,//p_writer
+		&written_count//p_written_count
+	);
+	while (p_engine->released_count < written_count) {
+		shReadbackEngineRelease(p_engine);
+	}
+
+	return 1;
+}
+
+void writeMemory(
+	VkDevice         device,
+	VkPhysicalDevice physical_device,
+	VkCommandBuffer  cmd_buffer,
+	VkFence          fence,
+	VkQueue          transfer_queue,
+	VkBuffer*        p_staging_buffer,
+	VkDeviceMemory*  p_staging_memory,
+	VkBuffer*        p_vertex_buffer,
+	VkDeviceMemory*  p_vertex_memory,
+	VkBuffer*        p_instance_buffer,
+	VkDeviceMemory*  p_instance_memory,
+	VkBuffer*        p_index_buffer,
+	VkDeviceMemory*  p_index_memory,
+	VkBuffer*        p_descriptors_buffer,
+	VkDeviceMemory*  p_descriptors_memory
+) {
+	//
+	//USEFUL VARIABLES
+	//
+	uint32_t quad_vertices_offset     = 0;
+	uint32_t triangle_vertices_offset = quad_vertices_offset     + sizeof(quad);
+	uint32_t instance_models_offset   = triangle_vertices_offset + sizeof(triangle);
+	uint32_t quad_indices_offset      = instance_models_offset   + sizeof(models);
+	uint32_t light_offset             = quad_indices_offset      + sizeof(indices);
+
+	uint32_t staging_size = light_offset + sizeof(light);
+
+	//
+	//WRITE ALL DATA TO STAGING BUFFER
+	//
+	shCreateBuffer(
+		device,//device
+		staging_size,//size
+		VK_BUFFER_USAGE_TRANSFER_SRC_BIT,//usage
+		VK_SHARING_MODE_EXCLUSIVE,//sharing_mode
+		p_staging_buffer//p_buffer
+	);
+	shAllocateBufferMemory(
+		device,//device
+		physical_device,//physical_device
+		*p_staging_buffer,//buffer
+		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,//property_flags
+		p_staging_memory//p_memory
+	);
+	shWriteMemory(device, *p_staging_memory, quad_vertices_offset,     sizeof(quad),     quad);
+	shWriteMemory(device, *p_staging_memory, triangle_vertices_offset, sizeof(triangle), triangle);
+	shWriteMemory(device, *p_staging_memory, instance_models_offset,   sizeof(models),   models);
+	shWriteMemory(device, *p_staging_memory, quad_indices_offset,      sizeof(indices),  indices);
+	shWriteMemory(device, *p_staging_memory, light_offset,             sizeof(light),    light);
+
+	shBindBufferMemory(device, *p_staging_buffer, 0, *p_staging_memory);
+
+	//
+	//SETUP DEVICE LOCAL DESTINATION BUFFERS
+	//
+	shCreateBuffer(device, sizeof(quad) + sizeof(triangle), VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_SHARING_MODE_EXCLUSIVE, p_vertex_buffer);
+	shAllocateBufferMemory(device, physical_device, *p_vertex_buffer, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, p_vertex_memory);
+	shBindBufferMemory(device, *p_vertex_buffer, 0, *p_vertex_memory);
+
+	shCreateBuffer(device, sizeof(models), VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_SHARING_MODE_EXCLUSIVE, p_instance_buffer);
+	shAllocateBufferMemory(device, physical_device, *p_instance_buffer, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, p_instance_memory);
+	shBindBufferMemory(device, *p_instance_buffer, 0, *p_instance_memory);
+
+	shCreateBuffer(device, sizeof(indices), VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_SHARING_MODE_EXCLUSIVE, p_index_buffer);
+	shAllocateBufferMemory(device, physical_device, *p_index_buffer, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, p_index_memory);
+	shBindBufferMemory(device, *p_index_buffer, 0, *p_index_memory);
+
+	shCreateBuffer(device, sizeof(light), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_SHARING_MODE_EXCLUSIVE, p_descriptors_buffer);
+	shAllocateBufferMemory(device, physical_device, *p_descriptors_buffer, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, p_descriptors_memory);
+	shBindBufferMemory(device, *p_descriptors_buffer, 0, *p_descriptors_memory);
+
+	//
+	//COPY STAGING BUFFER TO DEVICE LOCAL MEMORY
+	//
+	shResetFences(device, 1, &fence);//to signaled
+	shBeginCommandBuffer(cmd_buffer);
+	shCopyBuffer(cmd_buffer, *p_staging_buffer, quad_vertices_offset,   0, sizeof(quad) + sizeof(triangle), *p_vertex_buffer);
+	shCopyBuffer(cmd_buffer, *p_staging_buffer, instance_models_offset, 0, sizeof(models),                  *p_instance_buffer);
+	shCopyBuffer(cmd_buffer, *p_staging_buffer, quad_indices_offset,    0, sizeof(indices),                 *p_index_buffer);
+	shCopyBuffer(cmd_buffer, *p_staging_buffer, light_offset,           0, sizeof(light),                   *p_descriptors_buffer);
+	shEndCommandBuffer(cmd_buffer);
+
+	shQueueSubmit(1, &cmd_buffer, transfer_queue, fence, 0, VK_NULL_HANDLE, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, VK_NULL_HANDLE);
+	shWaitForFences(device, 1, &fence, 1, UINT64_MAX);
+
+	return;
+}
+
+void releaseMemory(
+	VkDevice       device,
+	VkBuffer       staging_buffer,
+	VkDeviceMemory staging_memory,
+	VkBuffer       vertex_buffer,
+	VkDeviceMemory vertex_memory,
+	VkBuffer       instance_buffer,
+	VkDeviceMemory instance_memory,
+	VkBuffer       index_buffer,
+	VkDeviceMemory index_memory,
+	VkBuffer       descriptors_buffer,
+	VkDeviceMemory descriptors_memory
+) {
+	shWaitDeviceIdle(device);
+	shClearBufferMemory(device, staging_buffer, staging_memory);
+	shClearBufferMemory(device, vertex_buffer, vertex_memory);
+	shClearBufferMemory(device, instance_buffer, instance_memory);
+	shClearBufferMemory(device, index_buffer, index_memory);
+	shClearBufferMemory(device, descriptors_buffer, descriptors_memory);
+	return;
+}
+
+void createPipelinesDataPool(
+	VkDevice          device,
+	VkBuffer          descriptors_buffer,
+	uint32_t          swapchain_image_count,
+	ShVkPipelinePool* p_pipeline_pool
+) {
+	shPipelinePoolCreateDescriptorSetLayoutBinding(
+		0,                                 //binding
+		VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, //descriptor_type
+		1,                                 //descriptor_set_count
+		VK_SHADER_STAGE_FRAGMENT_BIT,      //shader_stage
+		p_pipeline_pool                    //p_pipeline_pool
+	);
+
+	for (uint32_t i = 0; i < DESCRIPTOR_SET_COUNT * swapchain_image_count; i += DESCRIPTOR_SET_COUNT) {
+		shPipelinePoolSetDescriptorBufferInfos(
+			i + INFO_DESCRIPTOR_SET_IDX, //first_descriptor
+			1,                           //descriptor_count
+			descriptors_buffer,          //buffer
+			0,                           //buffer_offset
+			sizeof(light),               //buffer_size
+			p_pipeline_pool              //p_pipeline_pool
+		);
+	}
+
+	shPipelinePoolCreateDescriptorSetLayout(
+		device,         //device
+		0,              //first_binding_idx
+		1,              //binding_count
+		0,              //set_layout_idx
+		0,              //flags
+		p_pipeline_pool //p_pipeline_pool
+	);
+
+	shPipelinePoolCopyDescriptorSetLayout(
+		0,                                            //src_set_layout_idx
+		0,                                            //first_dst_set_layout_idx
+		DESCRIPTOR_SET_COUNT * swapchain_image_count, //dst_set_layout_count
+		p_pipeline_pool                               //p_pipeline_pool
+	);
+
+	shPipelinePoolCreateDescriptorPool(
+		device,                                       //device
+		0,                                            //pool_idx
+		VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,            //descriptor_type
+		DESCRIPTOR_SET_COUNT * swapchain_image_count, //decriptor_count
+		p_pipeline_pool                               //p_pipeline_pool
+	);
+
+	shPipelinePoolAllocateDescriptorSetUnits(
+		device,                                       //device,
+		0,                                            //binding,
+		0,                                            //pool_idx,
+		VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,            //descriptor_type,
+		0,                                            //first_descriptor_set_unit,
+		DESCRIPTOR_SET_COUNT * swapchain_image_count, //descriptor_set_unit_count,
+		p_pipeline_pool                               //p_pipeline
+	);
+
+	shPipelinePoolUpdateDescriptorSetUnits(
+		device, 0, DESCRIPTOR_SET_COUNT * swapchain_image_count, p_pipeline_pool
+	);
+
+	return;
+}
+
+void createPipeline(
+	VkDevice          device,
+	VkRenderPass      renderpass,
+	uint32_t          width,
+	uint32_t          height,
+	uint32_t          sample_count,
+	uint32_t          swapchain_image_count,
+	ShVkPipelinePool* p_pipeline_pool
+) {
+	ShVkPipeline* p_pipeline = &p_pipeline_pool->pipelines[0];
+
+	uint32_t attribute_0_offset = 0;
+	uint32_t attribute_0_size   = 12;
+	uint32_t attribute_1_offset = attribute_0_offset + attribute_0_size;
+	uint32_t attribute_1_size   = 8;
+
+	shPipelineSetVertexBinding(PER_VERTEX_BINDING, attribute_0_size + attribute_1_size, VK_VERTEX_INPUT_RATE_VERTEX, p_pipeline);
+	shPipelineSetVertexAttribute(0, PER_VERTEX_BINDING, VK_FORMAT_R32G32B32_SFLOAT, attribute_0_offset, p_pipeline);
+	shPipelineSetVertexAttribute(1, PER_VERTEX_BINDING, VK_FORMAT_R32G32_SFLOAT,    attribute_1_offset, p_pipeline);
+
+	shPipelineSetVertexBinding(PER_INSTANCE_BINDING, 64, VK_VERTEX_INPUT_RATE_INSTANCE, p_pipeline);
+	shPipelineSetVertexAttribute(2, PER_INSTANCE_BINDING, VK_FORMAT_R32G32B32A32_SFLOAT, 0,  p_pipeline);
+	shPipelineSetVertexAttribute(3, PER_INSTANCE_BINDING, VK_FORMAT_R32G32B32A32_SFLOAT, 16, p_pipeline);
+	shPipelineSetVertexAttribute(4, PER_INSTANCE_BINDING, VK_FORMAT_R32G32B32A32_SFLOAT, 32, p_pipeline);
+	shPipelineSetVertexAttribute(5, PER_INSTANCE_BINDING, VK_FORMAT_R32G32B32A32_SFLOAT, 48, p_pipeline);
+
+	shPipelineSetVertexInputState(p_pipeline);
+
+	shPipelineCreateInputAssembly(VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST, SH_FALSE, p_pipeline);
+
+	shPipelineCreateRasterizer(VK_POLYGON_MODE_FILL, SH_FALSE, p_pipeline);
+
+	shPipelineSetMultisampleState(sample_count, 0.0f, p_pipeline);
+
+	shPipelineSetViewport(
+		0, 0,
+		width, height,
+		0, 0,
+		width, height,
+		p_pipeline
+	);
+
+	shPipelineColorBlendSettings(SH_FALSE, SH_TRUE, SUBPASS_COLOR_ATTACHMENT_COUNT, p_pipeline);
+
+	uint32_t shader_size = 0;
+	char* shader_code = readBinary(
+		"../../examples/shaders/bin/mesh.vert.spv",
+		&shader_size
+	);
+	shPipelineCreateShaderModule(device, shader_size, shader_code, p_pipeline);
+	free(shader_code);
+	shPipelineCreateShaderStage(VK_SHADER_STAGE_VERTEX_BIT, p_pipeline);
+
+	shader_code = readBinary(
+		"../../examples/shaders/bin/mesh.frag.spv",
+		&shader_size
+	);
+	shPipelineCreateShaderModule(device, shader_size, shader_code, p_pipeline);
+	free(shader_code);
+	shPipelineCreateShaderStage(VK_SHADER_STAGE_FRAGMENT_BIT, p_pipeline);
+
+	shPipelineSetPushConstants(VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(projection_view), p_pipeline);
+
+	shPipelineCreateLayout(
+		device,
+		0,
+		DESCRIPTOR_SET_COUNT * swapchain_image_count,
+		p_pipeline_pool,
+		p_pipeline
+	);
+
+	shSetupGraphicsPipeline(device, renderpass, p_pipeline);
+
+	return;
+}
+
+#ifdef _MSC_VER
+#pragma warning (disable: 4996)
+#endif//_MSC_VER
+
+char* readBinary(const char* path, uint32_t* p_size) {
+	FILE* stream = fopen(path, "rb");
+	if (stream == VK_NULL_HANDLE) {
+		return VK_NULL_HANDLE;
+	}
+	fseek(stream, 0, SEEK_END);
+	uint32_t code_size = ftell(stream);
+	fseek(stream, 0, SEEK_SET);
+	char* code = (char*)calloc(1, code_size);
+	if (code == VK_NULL_HANDLE) {
+		fclose(stream);
+		return VK_NULL_HANDLE;
+	}
+	fread(code, code_size, 1, stream);
+	*p_size = code_size;
+	fclose(stream);
+	return code;
+}
+
+#ifdef __cplusplus
+}
+#endif//__cplusplus
@@ -0,0 +1,763 @@
+#ifdef __cplusplus
+extern "C" {
+#endif//__cplusplus
+
+#include <shvulkan/shVulkan.h>
+
+#define GLFW_INCLUDE_NONE
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#define SWAPCHAIN_IMAGE_COUNT       3
+#define MAX_SWAPCHAIN_IMAGE_COUNT   6
+
+
+
+
+void resizeWindow(
+	uint32_t                  width,
+	uint32_t                  height,
+	VkInstance                instance,
+	GLFWwindow*               window,
+	VkSurfaceKHR*             p_surface,
+	VkSurfaceCapabilitiesKHR* p_surface_capabilities,
+	VkPhysicalDevice          physical_device,
+	VkDevice                  device,
+	uint32_t                  graphics_queue_family_index,
+	VkSwapchainKHR*           p_swapchain,
+	VkFormat*                 p_swapchain_image_format,
+	VkSharingMode             swapchain_image_sharing_mode,
+	uint32_t*                 p_swapchain_image_count,
+	VkImageView*              p_swapchain_image_views,
+	VkImage*                  p_swapchain_images
+);
+
+void setupTrianglePipeline(
+	VkDevice          device,
+	VkFormat          color_format,
+	uint32_t          width,
+	uint32_t          height,
+	ShVkPipelinePool* p_pipeline_pool,
+	ShVkPipeline*     p_pipeline
+);
+
+char* readBinary(
+	const char* path, 
+	uint32_t* p_size
+);
+
+
+
+int main(void) {
+
+	int r = glfwInit();
+
+	shVkError(
+		r < 1,
+		"failed initializing glfw",
+		return 0
+	);
+
+	r = glfwVulkanSupported();
+
+	shVkError(
+		r == GLFW_FALSE,
+		"glfw does not support vulkan",
+		return 0;
+	);
+
+	glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+	glfwWindowHint(GLFW_RESIZABLE,  GLFW_TRUE);
+
+	GLFWmonitor* monitor    = (GLFWmonitor*)glfwGetPrimaryMonitor();
+	GLFWvidmode* video_mode = (GLFWvidmode*)glfwGetVideoMode(monitor); 	
+	
+	
+	int width  = (int)((float)video_mode->width  / 1.5f);
+	int height = (int)((float)video_mode->height / 1.5f);
+	
+	uint32_t     instance_extension_count = 0;
+	GLFWwindow*  window                   = glfwCreateWindow(width, height, "vulkan clear color", NULL, NULL);
+	const char** pp_instance_extensions   = glfwGetRequiredInstanceExtensions(&instance_extension_count);
+
+#ifdef _WIN32
+	glfwSetWindowSizeLimits(window, 400, 300, GLFW_DONT_CARE, GLFW_DONT_CARE);
+#else
+	glfwSetWindowSizeLimits(window, width, height, width, height);//X11 is so problematic
+#endif//_WIN32
+
+	VkInstance                       instance                                         = VK_NULL_HANDLE;
+											                                          
+	VkSurfaceKHR                     surface                                          = VK_NULL_HANDLE;
+	VkSurfaceCapabilitiesKHR         surface_capabilities                             = { 0 };
+																	                  
+	VkPhysicalDevice                 physical_device                                  = VK_NULL_HANDLE;
+	VkPhysicalDeviceProperties       physical_device_properties                       = { 0 };
+	VkPhysicalDeviceFeatures         physical_device_features                         = { 0 };
+	VkPhysicalDeviceMemoryProperties physical_device_memory_properties                = { 0 };
+																	                  
+	uint32_t                         graphics_queue_family_index                      = 0;
+	uint32_t                         present_queue_family_index                       = 0;
+																	                  
+	ShVkDeviceFeatures               required_device_features                         = { 0 };
+	ShVkDeviceFeatures               enabled_device_features                          = { 0 };
+
+	VkDevice                         device                                           = VK_NULL_HANDLE;
+	uint32_t                         device_extension_count                           = 0;
+															                          
+	VkQueue                          graphics_queue                                   = VK_NULL_HANDLE;
+	VkQueue                          present_queue                                    = VK_NULL_HANDLE;
+					           						                                      
+	VkCommandPool                    graphics_cmd_pool                                = VK_NULL_HANDLE;
+	VkCommandPool                    present_cmd_pool                                 = VK_NULL_HANDLE;
+															                      
+	VkCommandBuffer                  graphics_cmd_buffers[MAX_SWAPCHAIN_IMAGE_COUNT]  = { VK_NULL_HANDLE };
+	VkCommandBuffer                  present_cmd_buffer                               = VK_NULL_HANDLE;
+						
+	VkFence                          graphics_cmd_fences[MAX_SWAPCHAIN_IMAGE_COUNT]   = { VK_NULL_HANDLE };
+
+	VkSemaphore                      current_image_acquired_semaphore                              = VK_NULL_HANDLE;
+	VkSemaphore                      image_acquired_semaphores[MAX_SWAPCHAIN_IMAGE_COUNT]          = { VK_NULL_HANDLE };
+	VkSemaphore                      graphics_queue_finished_semaphores[MAX_SWAPCHAIN_IMAGE_COUNT] = { VK_NULL_HANDLE };
+																				      
+	VkSwapchainKHR                   swapchain                                        = VK_NULL_HANDLE;
+	VkFormat                         swapchain_image_format                           = 0;
+	uint32_t                         swapchain_image_count                            = 0;
+																	                  
+	VkImage                          swapchain_images[MAX_SWAPCHAIN_IMAGE_COUNT]      = { VK_NULL_HANDLE };
+	VkImageView                      swapchain_image_views[MAX_SWAPCHAIN_IMAGE_COUNT] = { VK_NULL_HANDLE };
+
+	shCreateInstance(
+		"vulkan app",//application_name,
+		"vulkan engine",//engine_name, 
+		1,//enable_validation_layers,
+		instance_extension_count,//extension_count,
+		pp_instance_extensions,//pp_extension_names,
+		VK_MAKE_API_VERSION(1, 3, 0, 0),//api_version,
+		&instance//p_instance
+	);
+
+	glfwCreateWindowSurface(
+		instance,
+		window,
+		VK_NULL_HANDLE,
+		&surface
+	);
+
+	shSelectPhysicalDevice(
+		instance,//instance,
+		surface,//surface,
+		VK_QUEUE_GRAPHICS_BIT |
+		VK_QUEUE_COMPUTE_BIT |
+		VK_QUEUE_TRANSFER_BIT,//requirements,
+		&physical_device,//p_physical_device,
+		&physical_device_properties,//p_physical_device_properties,
+		&physical_device_features,//p_physical_device_features,
+		&physical_device_memory_properties//p_physical_device_memory_properties
+	);
+
+	uint32_t graphics_queue_families_indices[SH_MAX_STACK_QUEUE_FAMILY_COUNT] = { 0 };
+	uint32_t present_queue_families_indices [SH_MAX_STACK_QUEUE_FAMILY_COUNT] = { 0 };
+	shGetPhysicalDeviceQueueFamilies(
+		physical_device,//physical_device
+		surface,//surface
+		VK_NULL_HANDLE,//p_queue_family_count
+		VK_NULL_HANDLE,//p_graphics_queue_family_count
+		VK_NULL_HANDLE,//p_surface_queue_family_count
+		VK_NULL_HANDLE,//p_compute_queue_family_count
+		VK_NULL_HANDLE,//p_transfer_queue_family_count
+		graphics_queue_families_indices,//p_graphics_queue_family_indices
+		present_queue_families_indices,//p_surface_queue_family_indices
+		VK_NULL_HANDLE,//p_compute_queue_family_indices
+		VK_NULL_HANDLE,//p_transfer_queue_family_indices
+		VK_NULL_HANDLE//p_queue_families_properties
+	);
+	graphics_queue_family_index = graphics_queue_families_indices[0];
+	present_queue_family_index  = present_queue_families_indices [0];
+
+	shGetPhysicalDeviceSurfaceCapabilities(
+		physical_device,//physical_device
+		surface,//surface
+		&surface_capabilities//p_surface_capabilities
+	);
+
+	float default_queue_priority = 1.0f;
+	VkDeviceQueueCreateInfo graphics_device_queue_info = { 0 };
+	shQueryForDeviceQueueInfo(
+		graphics_queue_family_index,//queue_family_index
+		1,//queue_count
+		&default_queue_priority,//p_queue_priorities
+		SH_FALSE,//protected
+		&graphics_device_queue_info//p_device_queue_info
+	);
+
+	VkDeviceQueueCreateInfo present_device_queue_info = { 0 };
+	shQueryForDeviceQueueInfo(
+		present_queue_family_index,//queue_family_index
+		1,//queue_count
+		&default_queue_priority,//p_queue_priorities
+		SH_FALSE,//protected
+		&present_device_queue_info//p_device_queue_info
+	);
+
+	VkDeviceQueueCreateInfo device_queue_infos[2] = {
+		graphics_device_queue_info,
+		present_device_queue_info
+	};
+	char* device_extensions[2]  = { VK_KHR_SWAPCHAIN_EXTENSION_NAME };
+	uint32_t device_queue_count = (graphics_queue_family_index == present_queue_family_index) ? 1 : 2;
+
+	//no render pass and framebuffer objects, the swapchain image views are rendered to directly
+	shInitDeviceFeatures(VK_API_VERSION_1_3, &required_device_features);
+	required_device_features.vulkan13.dynamicRendering = VK_TRUE;
+
+	r = shNegotiateDeviceFeatures(
+		physical_device,//physical_device
+		VK_MAKE_API_VERSION(1, 3, 0, 0),//instance_api_version
+		&required_device_features,//p_required
+		VK_NULL_HANDLE,//p_wanted
+		&enabled_device_features//p_enabled
+	);
+
+	shVkError(
+		r == 0,
+		"device does not support dynamic rendering",
+		return -1
+	);
+
+	shSetLogicalDevice(
+		physical_device,//physical_device
+		&device,//p_device
+		1,//extension_count
+		device_extensions,//pp_extension_names
+		device_queue_count,//device_queue_count
+		device_queue_infos,//p_device_queue_infos
+		&enabled_device_features.features//p_next
+	);
+
+	shGetDeviceQueues(
+		device,//device
+		1,//queue_count
+		&graphics_queue_family_index,//p_queue_family_indices
+		&graphics_queue//p_queues
+	);
+
+	shGetDeviceQueues(
+		device,//device
+		1,//queue_count
+		&present_queue_family_index,//p_queue_family_indices
+		&present_queue//p_queues
+	);
+
+	VkSharingMode swapchain_image_sharing_mode = VK_SHARING_MODE_EXCLUSIVE;
+	if (graphics_queue_family_index != present_queue_family_index) {
+		swapchain_image_sharing_mode = VK_SHARING_MODE_CONCURRENT;
+	}
+	shCreateSwapchain(
+		device,//device
+		physical_device,//physical_device
+		surface,//surface
+		VK_FORMAT_R8G8B8_UNORM,//image_format
+		&swapchain_image_format,//p_image_format
+		SWAPCHAIN_IMAGE_COUNT,//swapchain_image_count
+		swapchain_image_sharing_mode,//image_sharing_mode
+		SH_PRESENT_POLICY_LOW_LATENCY,//present_policy
+		VK_NULL_HANDLE,//old_swapchain
+		&swapchain_image_count,//p_swapchain_image_count
+		&swapchain//p_swapchain
+	);
+
+	shCreateCommandPool(
+		device,//device
+		graphics_queue_family_index,//queue_family_index
+		&graphics_cmd_pool//p_cmd_pool
+	);
+
+	shAllocateCommandBuffers(
+		device,//device
+		graphics_cmd_pool,//cmd_pool
+		swapchain_image_count,//cmd_buffer_count
+		graphics_cmd_buffers//p_cmd_buffer
+	);
+
+	if (graphics_queue_family_index != present_queue_family_index) {
+		shCreateCommandPool(
+			device,//device
+			present_queue_family_index,//queue_family_index
+			&present_cmd_pool//p_cmd_pool
+		);
+	}
+	else {
+		present_cmd_pool   = graphics_cmd_pool;
+	}
+	shAllocateCommandBuffers(
+		device,//device
+		present_cmd_pool,//cmd_pool
+		1,//cmd_buffer_count
+		&present_cmd_buffer//p_cmd_buffer
+	);
+
+	shCreateFences(
+		device,//device
+		swapchain_image_count,//fence_count
+		1,//signaled
+		graphics_cmd_fences//p_fences
+	);
+
+	shGetSwapchainImages(
+		device,//device
+		swapchain,//swapchain
+		&swapchain_image_count,//p_swapchain_image_count
+		swapchain_images//p_swapchain_images
+	);
+
+	for (uint32_t i = 0; i < swapchain_image_count; i++) {
+		shCreateImageView(
+			device,//device
+			swapchain_images[i],//image
+			VK_IMAGE_VIEW_TYPE_2D,//view_type
+			VK_IMAGE_ASPECT_COLOR_BIT,//image_aspect
+			1,//mip_levels
+			swapchain_image_format,//format
+			&swapchain_image_views[i]//p_image_view
+		);
+	}
+
+	shCreateSemaphores(
+		device,//device
+		swapchain_image_count,//semaphore_count
+		graphics_queue_finished_semaphores//p_semaphores
+	);
+
+	ShVkPipelinePool* p_pipeline_pool = shAllocatePipelinePool();
+
+	shVkError(
+		p_pipeline_pool == VK_NULL_HANDLE,
+		"invalid pipeline pool memory",
+		return -1
+	);
+
+	//built against the swapchain format only, no render pass needed
+	ShVkPipeline* p_pipeline = &p_pipeline_pool->pipelines[0];
+	setupTrianglePipeline(
+		device,//device
+		swapchain_image_format,//color_format
+		surface_capabilities.currentExtent.width,//width
+		surface_capabilities.currentExtent.height,//height
+		p_pipeline_pool,//p_pipeline_pool
+		p_pipeline//p_pipeline
+	);
+
+	uint32_t swapchain_image_idx  = 0;
+	uint8_t  swapchain_suboptimal = 0;
+
+
+	while (!glfwWindowShouldClose(window)) {
+		glfwPollEvents();
+
+		int _width = 0;
+		int _height = 0;
+		glfwGetWindowSize(window, &_width, &_height);
+
+		if (_width != 0 && _height != 0) {//otherwise it's minimized
+			if (_width != width || _height != height) {//window is resized
+
+				width = _width;
+				height = _height;
+
+				resizeWindow(
+					width, height, instance, window, &surface, &surface_capabilities, physical_device,
+					device, graphics_queue_family_index, &swapchain, &swapchain_image_format,
+					swapchain_image_sharing_mode, &swapchain_image_count, swapchain_image_views,
+					swapchain_images
+				);
+
+				//dynamic viewport, the pipeline is not rebuilt
+				shPipelineSetViewport(
+					0, 0,
+					surface_capabilities.currentExtent.width, surface_capabilities.currentExtent.height,
+					0, 0,
+					surface_capabilities.currentExtent.width, surface_capabilities.currentExtent.height,
+					p_pipeline
+				);
+
+				swapchain_image_idx = 0;
+			}
+
+			if (swapchain_suboptimal) {
+				resizeWindow(
+					width, height, instance, window, &surface, &surface_capabilities, physical_device,
+					device, graphics_queue_family_index, &swapchain, &swapchain_image_format,
+					swapchain_image_sharing_mode, &swapchain_image_count, swapchain_image_views,
+					swapchain_images
+				);
+
+				//dynamic viewport, the pipeline is not rebuilt
+				shPipelineSetViewport(
+					0, 0,
+					surface_capabilities.currentExtent.width, surface_capabilities.currentExtent.height,
+					0, 0,
+					surface_capabilities.currentExtent.width, surface_capabilities.currentExtent.height,
+					p_pipeline
+				);
+			}
+
+
+			shCreateSemaphores(
+				device,//device
+				1,//semaphore_count
+				&current_image_acquired_semaphore//p_semaphores
+			);
+
+			shAcquireSwapchainImage(
+				device,//device
+				swapchain,//swapchain
+				UINT64_MAX,//timeout_ns
+				current_image_acquired_semaphore,//acquired_signal_semaphore
+				VK_NULL_HANDLE,//acquired_signal_fence
+				&swapchain_image_idx,//p_swapchain_image_index
+				&swapchain_suboptimal//p_swapchain_suboptimal
+			);
+
+			image_acquired_semaphores[swapchain_image_idx] = current_image_acquired_semaphore;
+			
+			shWaitForFences(
+				device,//device
+				1,//fence_count
+				&graphics_cmd_fences[swapchain_image_idx],//p_fences
+				1,//wait_for_all
+				UINT64_MAX//timeout_ns
+			);
+
+
+			shResetFences(
+				device,//device
+				1,//fence_count
+				&graphics_cmd_fences[swapchain_image_idx]//p_fences
+			);
+
+			shBeginCommandBuffer(graphics_cmd_buffers[swapchain_image_idx]);
+
+			VkClearValue clear_value = { 0 };
+			float* p_colors = clear_value.color.float32;
+			p_colors[0] = (float)sin(glfwGetTime());
+			p_colors[1] = (float)cos(glfwGetTime());
+			p_colors[2] = (float)tan(glfwGetTime());
+			p_colors[3] = 1.0f;
+
+			//layout transitions done by the render pass before
+			shSetImageMemoryBarrier(
+				device,//device
+				graphics_cmd_buffers[swapchain_image_idx],//cmd_buffer
+				swapchain_images[swapchain_image_idx],//image
+				VK_IMAGE_ASPECT_COLOR_BIT,//image_aspect_mask
+				0,//access_before_barrier
+				VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,//access_after_barrier
+				VK_IMAGE_LAYOUT_UNDEFINED,//image_layout_before_barrier
+				VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,//image_layout_after_barrier
+				VK_QUEUE_FAMILY_IGNORED,//performing_queue_family_index_before_barrier
+				VK_QUEUE_FAMILY_IGNORED,//performing_queue_family_index_after_barrier
+				VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,//pipeline_stage_before_barrier
+				VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT//pipeline_stage_after_barrier
+			);
+
+			VkRenderingAttachmentInfo swapchain_attachment = { 0 };
+			shSetRenderingAttachment(
+				swapchain_image_views[swapchain_image_idx],//image_view
+				VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,//image_layout
+				VK_RESOLVE_MODE_NONE,//resolve_mode
+				VK_NULL_HANDLE,//resolve_image_view
+				VK_IMAGE_LAYOUT_UNDEFINED,//resolve_image_layout
+				VK_ATTACHMENT_LOAD_OP_CLEAR,//load_op
+				VK_ATTACHMENT_STORE_OP_STORE,//store_op
+				&clear_value,//p_clear_value
+				&swapchain_attachment//p_attachment
+			);
+
+			shBeginRendering(
+				device,//device
+				graphics_cmd_buffers[swapchain_image_idx],//graphics_cmd_buffer
+				0,//render_offset_x
+				0,//render_offset_y
+				surface_capabilities.currentExtent.width,//render_size_x
+				surface_capabilities.currentExtent.height,//render_size_y
+				1,//layer_count
+				1,//color_attachment_count
+				&swapchain_attachment,//p_color_attachments
+				VK_NULL_HANDLE,//p_depth_attachment
+				VK_NULL_HANDLE//p_stencil_attachment
+			);
+
+			shBindPipeline(
+				graphics_cmd_buffers[swapchain_image_idx],//cmd_buffer
+				VK_PIPELINE_BIND_POINT_GRAPHICS,//bind_point
+				p_pipeline//p_pipeline
+			);
+
+			shCmdSetPipelineViewport(
+				graphics_cmd_buffers[swapchain_image_idx],//cmd_buffer
+				p_pipeline//p_pipeline
+			);
+
+			shDraw(
+				graphics_cmd_buffers[swapchain_image_idx],//graphics_cmd_buffer
+				3,//vertex_count
+				0,//first_vertex
+				1,//instance_count
+				0//first_instance
+			);
+
+			shEndRendering(
+				device,//device
+				graphics_cmd_buffers[swapchain_image_idx]//graphics_cmd_buffer
+			);
+
+			shSetImageMemoryBarrier(
+				device,//device
+				graphics_cmd_buffers[swapchain_image_idx],//cmd_buffer
+				swapchain_images[swapchain_image_idx],//image
+				VK_IMAGE_ASPECT_COLOR_BIT,//image_aspect_mask
+				VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,//access_before_barrier
+				0,//access_after_barrier
+				VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,//image_layout_before_barrier
+				VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,//image_layout_after_barrier
+				VK_QUEUE_FAMILY_IGNORED,//performing_queue_family_index_before_barrier
+				VK_QUEUE_FAMILY_IGNORED,//performing_queue_family_index_after_barrier
+				VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,//pipeline_stage_before_barrier
+				VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT//pipeline_stage_after_barrier
+			);
+
+			shEndCommandBuffer(graphics_cmd_buffers[swapchain_image_idx]);
+
+			shQueueSubmit(
+				1,//cmd_buffer_count
+				&graphics_cmd_buffers[swapchain_image_idx],//p_cmd_buffers
+				graphics_queue,//queue
+				graphics_cmd_fences[swapchain_image_idx],//fence
+				1,//semaphores_to_wait_for_count
+				&image_acquired_semaphores[swapchain_image_idx],//p_semaphores_to_wait_for
+				VK_PIPELINE_STAGE_ALL_GRAPHICS_BIT,//wait_stage
+				1,//signal_semaphore_count
+				&graphics_queue_finished_semaphores[swapchain_image_idx]//p_signal_semaphores
+			);
+
+			shQueuePresentSwapchainImage(
+				present_queue,//present_queue
+				1,//semaphores_to_wait_for_count
+				&graphics_queue_finished_semaphores[swapchain_image_idx],//p_semaphores_to_wait_for
+				swapchain,//swapchain
+				swapchain_image_idx//swapchain_image_idx
+			);
+
+			shDestroySemaphores(device, 1, &current_image_acquired_semaphore);
+		}
+	}
+
+	shWaitDeviceIdle(device);
+
+	shPipelineDestroyShaderModules(device, 0, 2, p_pipeline);
+	shPipelineDestroyLayout(device, p_pipeline);
+	shDestroyPipeline(device, p_pipeline->pipeline);
+
+	shClearPipeline(p_pipeline);
+
+	shFreePipelinePool(p_pipeline_pool);
+
+	shDestroySemaphores(device, swapchain_image_count, graphics_queue_finished_semaphores);
+
+	shDestroyFences(device, swapchain_image_count, graphics_cmd_fences);
+
+	shDestroyCommandBuffers(device, graphics_cmd_pool, swapchain_image_count, graphics_cmd_buffers);
+
+	shDestroyCommandBuffers(device, present_cmd_pool, 1, &present_cmd_buffer);
+
+	shDestroyCommandPool(device, graphics_cmd_pool);
+	if (graphics_queue_family_index != present_queue_family_index) {
+		shDestroyCommandPool(device, present_cmd_pool);
+	}
+
+	shDestroyImageViews(device, swapchain_image_count, swapchain_image_views);
+
+	shDestroySwapchain(device, swapchain);
+
+	shDestroyDevice(device);
+
+	shDestroySurface(instance, surface);
+
+	shDestroyInstance(instance);
+
+	return 0;
+}
+
+void resizeWindow(
+	uint32_t                  width,
+	uint32_t                  height,
+	VkInstance                instance,
+	GLFWwindow*               window,
+	VkSurfaceKHR*             p_surface,
+	VkSurfaceCapabilitiesKHR* p_surface_capabilities,
+	VkPhysicalDevice          physical_device,
+	VkDevice                  device,
+	uint32_t                  graphics_queue_family_index,
+	VkSwapchainKHR*           p_swapchain,
+	VkFormat*                 p_swapchain_image_format,
+	VkSharingMode             swapchain_image_sharing_mode,
+	uint32_t*                 p_swapchain_image_count,
+	VkImageView*              p_swapchain_image_views,
+	VkImage*                  p_swapchain_images
+) {
+	shWaitDeviceIdle(device);
+
+	shDestroyImageViews(device, *p_swapchain_image_count, p_swapchain_image_views);
+	shDestroySwapchain(device, *p_swapchain);
+	shDestroySurface(instance, *p_surface);
+
+	glfwCreateWindowSurface(instance, window, VK_NULL_HANDLE, p_surface);
+	shGetPhysicalDeviceSurfaceSupport(physical_device, graphics_queue_family_index, *p_surface, NULL);//graphics support already checked
+	shGetPhysicalDeviceSurfaceCapabilities(physical_device, *p_surface, p_surface_capabilities);
+	shCreateSwapchain(
+		device,
+		physical_device,
+		*p_surface,
+		(*p_swapchain_image_format),
+		p_swapchain_image_format,
+		*p_swapchain_image_count,
+		swapchain_image_sharing_mode,
+		SH_PRESENT_POLICY_LOW_LATENCY,
+		VK_NULL_HANDLE,
+		p_swapchain_image_count,
+		p_swapchain
+	);
+	shGetSwapchainImages(device, *p_swapchain, p_swapchain_image_count, p_swapchain_images);
+	for (uint32_t i = 0; i < (*p_swapchain_image_count); i++) {
+		shCreateImageView(device, p_swapchain_images[i], VK_IMAGE_VIEW_TYPE_2D, VK_IMAGE_ASPECT_COLOR_BIT, 1, *p_swapchain_image_format, &p_swapchain_image_views[i]);
+	}
+}
+
+void setupTrianglePipeline(
+	VkDevice          device,
+	VkFormat          color_format,
+	uint32_t          width,
+	uint32_t          height,
+	ShVkPipelinePool* p_pipeline_pool,
+	ShVkPipeline*     p_pipeline
+) {
+	//vertices are generated in the vertex shader
+	shPipelineSetVertexInputState(p_pipeline);
+
+	shPipelineCreateInputAssembly(
+		VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST,
+		SH_FALSE,
+		p_pipeline
+	);
+
+	shPipelineCreateRasterizer(
+		VK_POLYGON_MODE_FILL,
+		SH_FALSE,
+		p_pipeline
+	);
+
+	shPipelineSetMultisampleState(
+		VK_SAMPLE_COUNT_1_BIT,
+		0.0f,
+		p_pipeline
+	);
+
+	shPipelineSetViewport(
+		0, 0,
+		width, height,
+		0, 0,
+		width, height,
+		p_pipeline
+	);
+
+	shPipelineColorBlendSettings(SH_FALSE, SH_FALSE, 1, p_pipeline);
+
+	uint32_t shader_size = 0;
+	char* shader_code = readBinary(
+		"../../examples/shaders/bin/triangle.vert.spv",
+		&shader_size
+	);
+
+	shPipelineCreateShaderModule(
+		device,
+		shader_size,
+		shader_code,
+		p_pipeline
+	);
+
+	free(shader_code);
+
+	shPipelineCreateShaderStage(
+		VK_SHADER_STAGE_VERTEX_BIT,
+		p_pipeline
+	);
+
+	shader_code = readBinary(
+		"../../examples/shaders/bin/triangle.frag.spv",
+		&shader_size
+	);
+
+	shPipelineCreateShaderModule(
+		device,
+		shader_size,
+		shader_code,
+		p_pipeline
+	);
+
+	free(shader_code);
+
+	shPipelineCreateShaderStage(
+		VK_SHADER_STAGE_FRAGMENT_BIT,
+		p_pipeline
+	);
+
+	shPipelineCreateLayout(
+		device,
+		0,
+		0,
+		p_pipeline_pool,
+		p_pipeline
+	);
+
+	shSetupGraphicsPipelineRendering(
+		device,//device
+		1,//color_attachment_count
+		&color_format,//p_color_attachment_formats
+		VK_FORMAT_UNDEFINED,//depth_attachment_format
+		VK_FORMAT_UNDEFINED,//stencil_attachment_format
+		1,//dynamic_viewport
+		p_pipeline//p_pipeline
+	);
+}
+
+#ifdef _MSC_VER
+#pragma warning (disable: 4996)
+#endif//_MSC_VER
+
+char* readBinary(const char* path, uint32_t* p_size) {
+	FILE* stream = fopen(path, "rb");
+	if (stream == VK_NULL_HANDLE) {
+		return VK_NULL_HANDLE;
+	}
+	fseek(stream, 0, SEEK_END);
+	uint32_t code_size = ftell(stream);
+	fseek(stream, 0, SEEK_SET);
+	char* code = (char*)calloc(1, code_size);
+	if (code == VK_NULL_HANDLE) {
+		fclose(stream);
+		return VK_NULL_HANDLE;
+	}
+	fread(code, code_size, 1, stream);
+	*p_size = code_size;
+	fclose(stream);
+	return code;
+}
+
+#ifdef __cplusplus
+}
+#endif//__cplusplus
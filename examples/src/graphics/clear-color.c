@@ -211,7 +211,8 @@ int main(void) {
 		1,//extension_count
 		device_extensions,//pp_extension_names
 		device_queue_count,//device_queue_count
-		device_queue_infos//p_device_queue_infos
+		device_queue_infos,//p_device_queue_infos
+		VK_NULL_HANDLE//p_next
 	);
 
 	shGetDeviceQueues(
@@ -240,7 +241,8 @@ int main(void) {
 		&swapchain_image_format,//p_image_format
 		SWAPCHAIN_IMAGE_COUNT,//swapchain_image_count
 		swapchain_image_sharing_mode,//image_sharing_mode
-		SH_FALSE,//vsync
+		SH_PRESENT_POLICY_LOW_LATENCY,//present_policy
+		VK_NULL_HANDLE,//old_swapchain
 		&swapchain_image_count,//p_swapchain_image_count
 		&swapchain//p_swapchain
 	);
@@ -557,7 +559,8 @@ void resizeWindow(
 		p_swapchain_image_format,
 		*p_swapchain_image_count,
 		swapchain_image_sharing_mode,
-		SH_FALSE,
+		SH_PRESENT_POLICY_LOW_LATENCY,
+		VK_NULL_HANDLE,
 		p_swapchain_image_count,
 		p_swapchain
 	);
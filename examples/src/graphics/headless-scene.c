@@ -22,6 +22,24 @@ extern "C" {
 #define PER_VERTEX_BINDING    0
 #define PER_INSTANCE_BINDING  1
 
+//SH_PACK_FORMAT_NONE streams the image through VVO, other formats pack it on the GPU and write it to PACK_OUTPUT_PATH
+#define PACK_FORMAT      SH_PACK_FORMAT_NONE
+#define PACK_FRAME_COUNT 300
+#define PACK_OUTPUT_PATH "headless-scene.packed"
+#define PACK_SLOT_COUNT  3//frames packed while the CPU writes older ones
+
+//RGBA8 and RGB565 packed frames only write the tiles which changed since the previous frame:
+//uint32_t rect_count, rect_count ShVkTileRect structures, then the texels of each rect with tightly packed rows
+#define PACK_TILE_DELTA  1
+#define PACK_TILE_SIZE   SH_DEFAULT_TILE_SIZE
+
+//With SH_PACK_FORMAT_NONE, 1 reads the frames back through a ShVkReadbackEngine and writes them to RAW_OUTPUT_PATH
+//instead of streaming them through VVO: the copy of a frame overlaps the rendering of the next ones
+#define RAW_READBACK            0
+#define RAW_READBACK_SLOT_COUNT 3
+#define RAW_FRAME_COUNT         300
+#define RAW_OUTPUT_PATH         "headless-scene.raw"
+
 float quad[QUAD_VERTEX_COUNT] = {
 		-0.5f,-0.5f, 0.0f,  0.0f, 0.0f,
 		 0.5f,-0.5f, 0.0f,  0.0f, 0.0f,
@@ -127,6 +145,32 @@ void createPipeline(
 	ShVkPipelinePool* p_pipeline_pool
 );
 
+void createPackPipeline(
+	VkDevice          device,
+	uint32_t          slot_count,
+	VkBuffer*         p_texel_buffers,
+	VkDeviceSize      texel_buffer_size,
+	VkBuffer*         p_packed_buffers,
+	VkDeviceSize      packed_buffer_size,
+	ShVkPipelinePool* p_pipeline_pool
+);
+
+uint64_t writePackedFrame(
+	const void*      p_packed_data,
+	VkDeviceSize     packed_buffer_size,
+	ShVkTileTracker* p_tile_tracker,
+	void*            p_dirty_texels,
+	FILE*            stream
+);
+
+uint32_t writeReadbackFrames(
+	VkDevice            device,
+	uint64_t            timeout_ns,
+	uint32_t            max_frame_count,
+	ShVkReadbackEngine* p_engine,
+	FILE*               stream
+);
+
 char* readBinary(
 	const char* path, 
 	uint32_t* p_size
@@ -239,7 +283,8 @@ int main(void) {
 		0,//extension_count
 		NULL,//pp_extension_names
 		1,//device_queue_count
-		device_queue_infos//p_device_queue_infos
+		device_queue_infos,//p_device_queue_infos
+		VK_NULL_HANDLE//p_next
 	);
 
 	shGetDeviceQueues(
@@ -483,18 +528,140 @@ int main(void) {
 		p_pipeline_pool
 	);
 
+	//
+	//OPTIONAL GPU PACKING, THE HOST ONLY READS THE PACKED BYTES
+	//
+	ShVkPackFormat    pack_format          = PACK_FORMAT;
+	VkDeviceSize      texel_buffer_size    = (VkDeviceSize)width * (VkDeviceSize)height * 4;
+	VkDeviceSize      packed_buffer_size   = 0;
+	VkBuffer          texel_buffers   [PACK_SLOT_COUNT] = { VK_NULL_HANDLE };
+	VkDeviceMemory    texel_memories  [PACK_SLOT_COUNT] = { VK_NULL_HANDLE };
+	VkBuffer          packed_buffers  [PACK_SLOT_COUNT] = { VK_NULL_HANDLE };
+	VkDeviceMemory    packed_memories [PACK_SLOT_COUNT] = { VK_NULL_HANDLE };
+	void*             p_packed_data   [PACK_SLOT_COUNT] = { VK_NULL_HANDLE };
+	VkCommandBuffer   pack_cmd_buffers[PACK_SLOT_COUNT] = { VK_NULL_HANDLE };
+	VkFence           pack_fences     [PACK_SLOT_COUNT] = { VK_NULL_HANDLE };
+	ShVkPipelinePool* p_pack_pipeline_pool = VK_NULL_HANDLE;
+	FILE*             pack_stream          = VK_NULL_HANDLE;
+	uint32_t          pack_submitted_count = 0;
+	uint32_t          packed_frame_count   = 0;//written frames
+	uint8_t           pack_swizzle_rb      =
+		vvo.src_image_format == VK_FORMAT_B8G8R8A8_UNORM || vvo.src_image_format == VK_FORMAT_B8G8R8A8_SRGB;
+
+	ShVkTileTracker   tile_tracker         = { 0 };
+	void*             p_dirty_texels       = VK_NULL_HANDLE;
+	uint8_t           pack_tile_delta      =
+		PACK_TILE_DELTA && (pack_format == SH_PACK_FORMAT_RGBA8 || pack_format == SH_PACK_FORMAT_RGB565);
+	uint64_t          written_size         = 0;
+
+	//
+	//OPTIONAL RAW READBACK, THE HOST READS THE UNPACKED FRAMES FROM THE ENGINE SLOTS
+	//
+	uint8_t            raw_readback        = pack_format == SH_PACK_FORMAT_NONE && RAW_READBACK;
+	uint8_t            stream_vvo          = pack_format == SH_PACK_FORMAT_NONE && !RAW_READBACK;
+	ShVkReadbackEngine readback_engine     = { 0 };
+	FILE*              raw_stream          = VK_NULL_HANDLE;
+	uint32_t           raw_submitted_count = 0;
+	uint32_t           raw_written_count   = 0;
+
+	if (raw_readback) {
+		shVkError(
+			shCreateReadbackEngine(
+				device,//device
+				physical_device,//physical_device
+				graphics_queue_family_index,//queue_family_index
+				RAW_READBACK_SLOT_COUNT,//slot_count
+				width,//width
+				height,//height
+				4,//texel_size
+				VK_IMAGE_ASPECT_COLOR_BIT,//image_aspect
+				&readback_engine//p_engine
+			) == 0,
+			"failed creating readback engine",
+			return -1
+		);
+
+		raw_stream = fopen(RAW_OUTPUT_PATH, "wb");
+		shVkError(raw_stream == VK_NULL_HANDLE, "failed opening raw output file", return -1);
+
+		printf("Writing %u raw frames of %llu bytes to %s\n",
+			RAW_FRAME_COUNT, (unsigned long long)readback_engine.slot_size, RAW_OUTPUT_PATH
+		);
+	}
+
+	if (pack_format != SH_PACK_FORMAT_NONE) {
+		shVkError(
+			shGetPackedImageSize(pack_format, width, height, &packed_buffer_size) == 0,
+			"invalid pack format for the image size",
+			return -1
+		);
+
+		//each slot has its own buffers, the pack of a frame never waits for the CPU to read the previous one
+		for (uint32_t slot_idx = 0; slot_idx < PACK_SLOT_COUNT; slot_idx++) {
+			shCreateBuffer(device, (uint32_t)texel_buffer_size, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_SHARING_MODE_EXCLUSIVE, &texel_buffers[slot_idx]);
+			shAllocateBufferMemory(device, physical_device, texel_buffers[slot_idx], VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &texel_memories[slot_idx]);
+			shBindBufferMemory(device, texel_buffers[slot_idx], 0, texel_memories[slot_idx]);
+
+			shCreateBuffer(device, (uint32_t)packed_buffer_size, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_SHARING_MODE_EXCLUSIVE, &packed_buffers[slot_idx]);
+			shAllocateBufferMemory(device, physical_device, packed_buffers[slot_idx], VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &packed_memories[slot_idx]);
+			shBindBufferMemory(device, packed_buffers[slot_idx], 0, packed_memories[slot_idx]);
+			shReadMemory(device, packed_memories[slot_idx], 0, packed_buffer_size, &p_packed_data[slot_idx], VK_NULL_HANDLE);//stays mapped
+		}
+
+		shAllocateCommandBuffers(device, graphics_cmd_pool, PACK_SLOT_COUNT, pack_cmd_buffers);
+		shCreateFences(device, PACK_SLOT_COUNT, 0, pack_fences);
+
+		p_pack_pipeline_pool = shAllocatePipelinePool();
+		shVkError(p_pack_pipeline_pool == VK_NULL_HANDLE, "invalid pack pipeline pool memory", return -1);
+
+		createPackPipeline(
+			device,
+			PACK_SLOT_COUNT,
+			texel_buffers, texel_buffer_size,
+			packed_buffers, packed_buffer_size,
+			p_pack_pipeline_pool
+		);
+
+		pack_stream = fopen(PACK_OUTPUT_PATH, "wb");
+		shVkError(pack_stream == VK_NULL_HANDLE, "failed opening pack output file", return -1);
+
+		if (pack_tile_delta) {
+			shCreateTileTracker(
+				width,//width
+				height,//height
+				pack_format == SH_PACK_FORMAT_RGBA8 ? 4 : 2,//texel_size
+				PACK_TILE_SIZE,//tile_size
+				&tile_tracker//p_tracker
+			);
+			p_dirty_texels = malloc((size_t)packed_buffer_size);
+			shVkError(p_dirty_texels == VK_NULL_HANDLE, "invalid dirty texels memory", return -1);
+		}
+
+		printf("Writing %u packed frames of %llu bytes to %s\n",
+			PACK_FRAME_COUNT, (unsigned long long)packed_buffer_size, PACK_OUTPUT_PATH
+		);
+	}
+
 	uint32_t swapchain_image_idx  = 0;//always will be if headless
 
 	char* uri = "127.0.0.1:8002";
 
-	vvoSetupServer(&vvo, uri);
+	if (stream_vvo) {
+		vvoSetupServer(&vvo, uri);
 
-	printf("Hosting stream server at %s\n", uri);
-	printf("For a single image capture, go to %s/static-image\n", uri);
-	printf("For a stream of multiple frames, go to %s/vvoStream\n", uri);
+		printf("Hosting stream server at %s\n", uri);
+		printf("For a single image capture, go to %s/static-image\n", uri);
+		printf("For a stream of multiple frames, go to %s/vvoStream\n", uri);
+	}
 
-	while (1) {
-		vvoPollEvents(&vvo);
+	while (
+		stream_vvo ||
+		(raw_readback && raw_submitted_count < RAW_FRAME_COUNT) ||
+		(pack_format != SH_PACK_FORMAT_NONE && pack_submitted_count < PACK_FRAME_COUNT)
+		) {
+		if (stream_vvo) {
+			vvoPollEvents(&vvo);
+		}
 
 		int _width = 0;
 		int _height = 0;
@@ -517,7 +684,10 @@ int main(void) {
 
 		shBeginCommandBuffer(cmd_buffer);
 		
-		triangle[6] = (float)sin((double)(vvo.image_submissions_count) / 2.0f);//(float)sin(glfwGetTime());;
+		uint64_t frame_count =
+			stream_vvo   ? vvo.image_submissions_count :
+			raw_readback ? raw_submitted_count : pack_submitted_count;
+		triangle[6] = (float)sin((double)(frame_count) / 2.0f);//(float)sin(glfwGetTime());;
 		shWriteMemory(
 			device,
 			staging_memory,
@@ -614,6 +784,77 @@ int main(void) {
 		}
 		
 
+		//Copy to the next readback slot after the render pass, the CPU writes older slots meanwhile
+		if (raw_readback) {
+			if (readback_engine.submitted_count - readback_engine.released_count == readback_engine.slot_count) {
+				raw_written_count += writeReadbackFrames(device, UINT64_MAX, 1, &readback_engine, raw_stream);
+			}
+
+			shReadbackEngineSubmit(
+				device,//device
+				graphics_queue,//queue
+				vvo.src_images[swapchain_image_idx],//image
+				vvo.color_attachment.finalLayout,//image_layout
+				current_graphics_queue_finished_semaphore,//wait_semaphore
+				raw_submitted_count,//frame_id
+				&readback_engine//p_engine
+			);
+			raw_submitted_count++;
+
+			raw_written_count += writeReadbackFrames(device, 0, RAW_READBACK_SLOT_COUNT, &readback_engine, raw_stream);
+			continue;
+		}
+
+		//Pack on the GPU to the next slot after the render pass on the same queue, the CPU writes older slots meanwhile
+		if (pack_format != SH_PACK_FORMAT_NONE) {
+			uint32_t slot_idx = pack_submitted_count % PACK_SLOT_COUNT;
+
+			if (pack_submitted_count - packed_frame_count == PACK_SLOT_COUNT) {//the slot holds the oldest unwritten frame
+				shWaitForFences(device, 1, &pack_fences[slot_idx], 1, UINT64_MAX);
+				written_size += writePackedFrame(
+					p_packed_data[slot_idx], packed_buffer_size,
+					pack_tile_delta ? &tile_tracker : VK_NULL_HANDLE, p_dirty_texels,
+					pack_stream
+				);
+				packed_frame_count++;
+			}
+			shResetFences(device, 1, &pack_fences[slot_idx]);
+
+			VkCommandBuffer pack_cmd_buffer = pack_cmd_buffers[slot_idx];
+
+			shBeginCommandBuffer(pack_cmd_buffer);
+			shCmdPackImage(
+				device,//device
+				pack_cmd_buffer,//cmd_buffer
+				vvo.src_images[swapchain_image_idx],//image
+				vvo.color_attachment.finalLayout,//image_layout
+				width,//width
+				height,//height
+				pack_swizzle_rb,//swizzle_rb
+				pack_format,//format
+				texel_buffers[slot_idx],//texel_buffer
+				packed_buffers[slot_idx],//packed_buffer
+				slot_idx * 2,//first_descriptor_set_unit_idx
+				p_pack_pipeline_pool,//p_pipeline_pool
+				&p_pack_pipeline_pool->pipelines[0]//p_pipeline
+			);
+			shEndCommandBuffer(pack_cmd_buffer);
+
+			shQueueSubmit(
+				1,//cmd_buffer_count
+				&pack_cmd_buffer,//p_cmd_buffers
+				graphics_queue,//queue
+				pack_fences[slot_idx],//fence
+				1,//semaphores_to_wait_for_count
+				&current_graphics_queue_finished_semaphore,//p_semaphores_to_wait_for
+				VK_PIPELINE_STAGE_TRANSFER_BIT,//wait_stage
+				0,//signal_semaphore_count
+				VK_NULL_HANDLE//p_signal_semaphores
+			);
+			pack_submitted_count++;
+			continue;
+		}
+
 		//Get image for streaming
 		shWaitForFences(device, 1, &graphics_cmd_fences[swapchain_image_idx], 1, UINT64_MAX);
 
@@ -650,6 +891,54 @@ int main(void) {
 	vvoRelease(&vvo);
 
 	shWaitDeviceIdle(device);
+
+	if (raw_readback) {
+		raw_written_count += writeReadbackFrames(device, UINT64_MAX, RAW_READBACK_SLOT_COUNT, &readback_engine, raw_stream);
+		fclose(raw_stream);
+
+		printf("Wrote %u raw frames\n", raw_written_count);
+
+		shDestroyReadbackEngine(device, &readback_engine);
+	}
+
+	if (pack_format != SH_PACK_FORMAT_NONE) {
+		while (packed_frame_count < pack_submitted_count) {
+			written_size += writePackedFrame(
+				p_packed_data[packed_frame_count % PACK_SLOT_COUNT], packed_buffer_size,
+				pack_tile_delta ? &tile_tracker : VK_NULL_HANDLE, p_dirty_texels,
+				pack_stream
+			);
+			packed_frame_count++;
+		}
+		fclose(pack_stream);
+
+		printf("Wrote %llu bytes, %.1f%% of the full frames\n",
+			(unsigned long long)written_size,
+			100.0 * (double)written_size / ((double)packed_buffer_size * (double)packed_frame_count)
+		);
+
+		if (pack_tile_delta) {
+			shDestroyTileTracker(&tile_tracker);
+			free(p_dirty_texels);
+		}
+
+		shPipelinePoolDestroyDescriptorPools(device, 0, 1, p_pack_pipeline_pool);
+		shPipelinePoolDestroyDescriptorSetLayouts(device, 0, 1, p_pack_pipeline_pool);
+		shPipelineDestroyShaderModules(device, 0, 1, &p_pack_pipeline_pool->pipelines[0]);
+		shPipelineDestroyLayout(device, &p_pack_pipeline_pool->pipelines[0]);
+		shDestroyPipeline(device, p_pack_pipeline_pool->pipelines[0].pipeline);
+		shClearPipeline(&p_pack_pipeline_pool->pipelines[0]);
+		shFreePipelinePool(p_pack_pipeline_pool);
+
+		for (uint32_t slot_idx = 0; slot_idx < PACK_SLOT_COUNT; slot_idx++) {
+			shUnmapMemory(device, packed_memories[slot_idx]);
+			shClearBufferMemory(device, packed_buffers[slot_idx], packed_memories[slot_idx]);
+			shClearBufferMemory(device, texel_buffers[slot_idx], texel_memories[slot_idx]);
+		}
+
+		shDestroyFences(device, PACK_SLOT_COUNT, pack_fences);
+		shDestroyCommandBuffers(device, graphics_cmd_pool, PACK_SLOT_COUNT, pack_cmd_buffers);
+	}
 	
 	shPipelinePoolDestroyDescriptorPools(device, 0, 1, p_pipeline_pool);
 	shPipelinePoolDestroyDescriptorSetLayouts(device, 0, 1, p_pipeline_pool);
@@ -862,6 +1151,7 @@ void createPipelinesDataPool(
 		0,              //first_binding_idx
 		1,              //binding_count
 		0,              //set_layout_idx
+		0,              //flags
 		p_pipeline_pool //p_pipeline_pool
 	);
 	
@@ -1074,6 +1364,164 @@ void createPipeline(
 	return;
 }
 
+void createPackPipeline(
+	VkDevice          device,
+	uint32_t          slot_count,
+	VkBuffer*         p_texel_buffers,
+	VkDeviceSize      texel_buffer_size,
+	VkBuffer*         p_packed_buffers,
+	VkDeviceSize      packed_buffer_size,
+	ShVkPipelinePool* p_pipeline_pool
+) {
+	ShVkPipeline* p_pipeline = &p_pipeline_pool->pipelines[0];
+
+	for (uint32_t slot_idx = 0; slot_idx < slot_count; slot_idx++) {//texels and packed output of each slot
+		shPipelinePoolSetDescriptorBufferInfos(
+			slot_idx * 2,//first_descriptor
+			1,//descriptor_count
+			p_texel_buffers[slot_idx],//buffer
+			0,//buffer_offset
+			(uint32_t)texel_buffer_size,//buffer_size
+			p_pipeline_pool//p_pipeline_pool
+		);
+
+		shPipelinePoolSetDescriptorBufferInfos(
+			slot_idx * 2 + 1,//first_descriptor
+			1,//descriptor_count
+			p_packed_buffers[slot_idx],//buffer
+			0,//buffer_offset
+			(uint32_t)packed_buffer_size,//buffer_size
+			p_pipeline_pool//p_pipeline_pool
+		);
+	}
+
+	shPipelinePoolCreateDescriptorSetLayoutBinding(
+		0,//binding
+		VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,//descriptor_type
+		1,//descriptor_set_count
+		VK_SHADER_STAGE_COMPUTE_BIT,//shader_stage
+		p_pipeline_pool//p_pipeline_pool
+	);
+
+	shPipelinePoolCreateDescriptorSetLayout(
+		device,//device
+		0,//first_binding_idx
+		1,//binding_count
+		0,//set_layout_idx
+		0,//flags
+		p_pipeline_pool//p_pipeline_pool
+	);
+
+	shPipelinePoolCopyDescriptorSetLayout(
+		0,//src_set_layout_idx
+		0,//first_dst_set_layout_idx
+		slot_count * 2,//dst_set_layout_count
+		p_pipeline_pool//p_pipeline_pool
+	);//same descriptor set layout for source texels and packed output
+
+	shPipelinePoolCreateDescriptorPool(
+		device,//device
+		0,//pool_idx
+		VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,//descriptor_type
+		slot_count * 2,//descriptor_count
+		p_pipeline_pool//p_pipeline_pool
+	);
+
+	shPipelinePoolAllocateDescriptorSetUnits(
+		device,//device
+		0,//binding
+		0,//pool_idx
+		VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,//descriptor_type
+		0,//first_descriptor_set_unit
+		slot_count * 2,//descriptor_set_unit_count
+		p_pipeline_pool//p_pipeline_pool
+	);
+
+	shPipelinePoolUpdateDescriptorSetUnits(
+		device,//device
+		0,//first_descriptor_set_unit
+		slot_count * 2,//descriptor_set_unit_count
+		p_pipeline_pool//p_pipeline_pool
+	);
+
+	uint32_t shader_size = 0;
+	char* shader_code = readBinary(
+		"../../examples/shaders/bin/pack.comp.spv",
+		&shader_size
+	);
+
+	shPipelineCreateShaderModule(device, shader_size, shader_code, p_pipeline);
+	free(shader_code);
+	shPipelineCreateShaderStage(VK_SHADER_STAGE_COMPUTE_BIT, p_pipeline);
+
+	shPipelineSetPushConstants(
+		VK_SHADER_STAGE_COMPUTE_BIT,//shader_stage
+		0,//offset
+		sizeof(ShVkPackPushConstants),//size
+		p_pipeline//p_pipeline
+	);
+
+	shPipelineCreateLayout(
+		device,//device
+		0,//first_descriptor_set_layout
+		2,//descriptor_set_layout_count
+		p_pipeline_pool,//p_pipeline_pool
+		p_pipeline//p_pipeline
+	);
+
+	shSetupComputePipeline(device, p_pipeline);
+
+	return;
+}
+
+uint64_t writePackedFrame(
+	const void*      p_packed_data,
+	VkDeviceSize     packed_buffer_size,
+	ShVkTileTracker* p_tile_tracker,
+	void*            p_dirty_texels,
+	FILE*            stream
+) {
+	if (p_tile_tracker == VK_NULL_HANDLE) {
+		fwrite(p_packed_data, 1, (size_t)packed_buffer_size, stream);
+		return packed_buffer_size;
+	}
+
+	shTileTrackerUpdate(p_packed_data, 0, 0, p_tile_tracker);
+	shTileTrackerGatherDirtyTexels(p_packed_data, 0, p_dirty_texels, p_tile_tracker);
+
+	fwrite(&p_tile_tracker->dirty_rect_count, sizeof(uint32_t), 1, stream);
+	fwrite(p_tile_tracker->p_dirty_rects, sizeof(ShVkTileRect), p_tile_tracker->dirty_rect_count, stream);
+	fwrite(p_dirty_texels, 1, (size_t)p_tile_tracker->dirty_size, stream);
+
+	return sizeof(uint32_t) + sizeof(ShVkTileRect) * p_tile_tracker->dirty_rect_count + p_tile_tracker->dirty_size;
+}
+
+uint32_t writeReadbackFrames(
+	VkDevice            device,
+	uint64_t            timeout_ns,
+	uint32_t            max_frame_count,
+	ShVkReadbackEngine* p_engine,
+	FILE*               stream
+) {
+	uint32_t written_count = 0;
+
+	while (written_count < max_frame_count) {
+		uint8_t ready  = 0;
+		void*   p_data = VK_NULL_HANDLE;
+
+		shReadbackEngineAcquire(device, timeout_ns, p_engine, &ready, &p_data, VK_NULL_HANDLE);
+		if (!ready) {
+			break;
+		}
+
+		fwrite(p_data, 1, (size_t)p_engine->slot_size, stream);
+		shReadbackEngineRelease(p_engine);
+		written_count++;
+	}
+
+	return written_count;
+}
+
 #ifdef _MSC_VER
 #pragma warning (disable: 4996)
 #endif//_MSC_VER
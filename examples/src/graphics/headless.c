@@ -110,7 +110,8 @@ int main(void) {
 		0,//extension_count
 		NULL,//pp_extension_names
 		device_queue_count,//device_queue_count
-		device_queue_infos//p_device_queue_infos
+		device_queue_infos,//p_device_queue_infos
+		VK_NULL_HANDLE//p_next
 	);
 
 	shGetDeviceQueues(
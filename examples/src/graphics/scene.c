@@ -77,7 +77,6 @@ float projection_view[32] = {
 
 #define DESCRIPTOR_SET_COUNT        1
 #define INFO_DESCRIPTOR_SET_IDX     0
-#define OPTIONAL_DESCRIPTOR_SET_IDX 1
 
 void writeMemory(
 	VkDevice         device,
@@ -92,9 +91,7 @@ void writeMemory(
 	VkBuffer*        p_instance_buffer,
 	VkDeviceMemory*  p_instance_memory,
 	VkBuffer*        p_index_buffer,
-	VkDeviceMemory*  p_index_memory,
-	VkBuffer*        p_descriptors_buffer,
-	VkDeviceMemory*  p_descriptors_memory
+	VkDeviceMemory*  p_index_memory
 );
 
 void releaseMemory(
@@ -106,15 +103,12 @@ void releaseMemory(
 	VkBuffer       instance_buffer,
 	VkDeviceMemory instance_memory,
 	VkBuffer       index_buffer,
-	VkDeviceMemory index_memory,
-	VkBuffer       descriptors_buffer,
-	VkDeviceMemory descriptors_memory
+	VkDeviceMemory index_memory
 );
 
 void createPipelinesDataPool(
 	VkDevice          device,
-	VkBuffer          descriptors_buffer,
-	uint32_t          swapchain_image_count,
+	VkBuffer          uniform_buffer,
 	ShVkPipelinePool* p_pipeline_pool
 );
 
@@ -124,37 +118,42 @@ void createPipeline(
 	uint32_t          width,
 	uint32_t          height,
 	uint32_t          sample_count,
-	uint32_t          swapchain_image_count,
 	ShVkPipelinePool* p_pipeline_pool
 );
 
 void resizeWindow(
-	uint32_t                  width,
-	uint32_t                  height,
-	VkInstance                instance,
-	GLFWwindow*               window,
-	VkSurfaceKHR*             p_surface,
-	VkSurfaceCapabilitiesKHR* p_surface_capabilities,
-	VkPhysicalDevice          physical_device,
-	VkDevice                  device,
-	uint32_t                  graphics_queue_family_index,
-	uint32_t                  sample_count,
-	VkSwapchainKHR*           p_swapchain,
-	VkFormat*                 p_swapchain_image_format,
-	VkSharingMode             swapchain_image_sharing_mode,
-	uint32_t*                 p_swapchain_image_count,
-	VkImageView*              p_swapchain_image_views,
-	VkImage*                  p_swapchain_images,
-	VkImage*                  input_color_image,
-	VkDeviceMemory*           input_color_image_memory,
-	VkImageView*              p_input_color_image_view,
-	VkImage*                  p_depth_image,
-	VkDeviceMemory*           p_depth_image_memory,
-	VkImageView*              p_depth_image_view,
-	VkRenderPass*             p_renderpass,
-	VkAttachmentDescription*  p_attachment_descriptions,
-	VkSubpassDescription*     p_subpass,
-	VkFramebuffer*            p_framebuffers
+	uint32_t                     width,
+	uint32_t                     height,
+	VkSurfaceKHR                 surface,
+	VkSurfaceCapabilitiesKHR*    p_surface_capabilities,
+	VkPhysicalDevice             physical_device,
+	VkDevice                     device,
+	uint32_t                     sample_count,
+	ShVkReleaseQueue*            p_release_queue,
+	VkSwapchainKHR*              p_swapchain,
+	VkFormat*                    p_swapchain_image_format,
+	VkSharingMode                swapchain_image_sharing_mode,
+	uint32_t*                    p_swapchain_image_count,
+	VkImageView*                 p_swapchain_image_views,
+	VkImage*                     p_swapchain_images,
+	ShVkTransientAttachmentPool* p_attachment_pool,
+	uint32_t*                    p_input_color_attachment_idx,
+	uint32_t*                    p_depth_attachment_idx,
+	VkRenderPass*                p_renderpass,
+	VkAttachmentDescription*     p_attachment_descriptions,
+	VkSubpassDescription*        p_subpass,
+	VkFramebuffer*               p_framebuffers
+);
+
+void acquireAttachments(
+	uint32_t                     width,
+	uint32_t                     height,
+	uint32_t                     sample_count,
+	VkFormat                     color_format,
+	ShVkReleaseQueue*            p_release_queue,
+	ShVkTransientAttachmentPool* p_attachment_pool,
+	uint32_t*                    p_input_color_attachment_idx,
+	uint32_t*                    p_depth_attachment_idx
 );
 
 char* readBinary(
@@ -226,6 +225,8 @@ int main(void) {
 	VkCommandBuffer                  present_cmd_buffer                               = VK_NULL_HANDLE;
 															                      
 	VkFence                          graphics_cmd_fences[MAX_SWAPCHAIN_IMAGE_COUNT]   = { VK_NULL_HANDLE };
+	uint32_t                         graphics_cmd_fence_count                         = 0;
+	uint64_t                         graphics_submissions[MAX_SWAPCHAIN_IMAGE_COUNT]  = { 0 };
 															                      
 	VkSemaphore                      current_image_acquired_semaphore                 = VK_NULL_HANDLE;
 	VkSemaphore                      image_acquired_semaphores[SWAPCHAIN_IMAGE_COUNT] = { VK_NULL_HANDLE };
@@ -249,15 +250,14 @@ int main(void) {
 
 	VkImage                          swapchain_images[MAX_SWAPCHAIN_IMAGE_COUNT]      = { VK_NULL_HANDLE };
 	VkImageView                      swapchain_image_views[MAX_SWAPCHAIN_IMAGE_COUNT] = { VK_NULL_HANDLE };
-	VkImage                          depth_image = VK_NULL_HANDLE;
-	VkDeviceMemory                   depth_image_memory                               = VK_NULL_HANDLE;
-	VkImageView                      depth_image_view                                 = VK_NULL_HANDLE;
-	VkImage                          input_color_image                                = VK_NULL_HANDLE;
-	VkDeviceMemory                   input_color_image_memory                         = VK_NULL_HANDLE;
-	VkImageView                      input_color_image_view                           = VK_NULL_HANDLE;
+	ShVkTransientAttachmentPool*     p_attachment_pool                                = shAllocateTransientAttachmentPool();
+	uint32_t                         depth_attachment_idx                             = 0;
+	uint32_t                         input_color_attachment_idx                       = 0;
     
 	VkFramebuffer                    framebuffers[MAX_SWAPCHAIN_IMAGE_COUNT]          = { VK_NULL_HANDLE };
 
+	ShVkReleaseQueue*                p_release_queue                                  = shAllocateReleaseQueue();
+
 	shCreateInstance(
 		//application_name, engine_name, enable_validation_layers,
 		"vulkan app", "vulkan engine", 1,
@@ -335,7 +335,8 @@ int main(void) {
 		1,//extension_count
 		device_extensions,//pp_extension_names
 		device_queue_count,//device_queue_count
-		device_queue_infos//p_device_queue_infos
+		device_queue_infos,//p_device_queue_infos
+		VK_NULL_HANDLE//p_next
 	);
 
 	shGetDeviceQueues(
@@ -364,7 +365,8 @@ int main(void) {
 		&swapchain_image_format,//p_image_format
 		SWAPCHAIN_IMAGE_COUNT,//swapchain_image_count
 		swapchain_image_sharing_mode,//image_sharing_mode
-		SH_FALSE,//vsync
+		SH_PRESENT_POLICY_LOW_LATENCY,//present_policy
+		VK_NULL_HANDLE,//old_swapchain
 		&swapchain_image_count,
 		&swapchain//p_swapchain
 	);//need p_swapchain_image_count
@@ -405,6 +407,8 @@ int main(void) {
 		1,//signaled
 		graphics_cmd_fences//p_fences
 	);
+	//the swapchain may return a different image count once recreated, the fences are not
+	graphics_cmd_fence_count = swapchain_image_count;
 
 	shGetSwapchainImages(
 		device,//device
@@ -434,7 +438,7 @@ int main(void) {
 		swapchain_image_format,//format
 		sample_count,//sample_count
 		VK_ATTACHMENT_LOAD_OP_CLEAR,//load_treatment
-		VK_ATTACHMENT_STORE_OP_STORE,//store_treatment
+		VK_ATTACHMENT_STORE_OP_DONT_CARE,//store_treatment, resolved in the subpass
 		VK_ATTACHMENT_LOAD_OP_DONT_CARE,//stencil_load_treatment
 		VK_ATTACHMENT_STORE_OP_DONT_CARE,//stencil_store_treatment
 		VK_IMAGE_LAYOUT_UNDEFINED,//initial_layout
@@ -451,7 +455,7 @@ int main(void) {
 		VK_FORMAT_D32_SFLOAT,
 		sample_count,
 		VK_ATTACHMENT_LOAD_OP_CLEAR,
-		VK_ATTACHMENT_STORE_OP_STORE,
+		VK_ATTACHMENT_STORE_OP_DONT_CARE,
 		VK_ATTACHMENT_LOAD_OP_DONT_CARE,
 		VK_ATTACHMENT_STORE_OP_DONT_CARE,
 		VK_IMAGE_LAYOUT_UNDEFINED,
@@ -506,54 +510,29 @@ int main(void) {
 		&renderpass//p_renderpass
 	);
 	
-	shCreateImage(
-		device,
-		VK_IMAGE_TYPE_2D,
-		width, height, 1,
-		VK_FORMAT_D32_SFLOAT,
-		1, sample_count,
-		VK_IMAGE_TILING_OPTIMAL,
-		VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT,
-		VK_SHARING_MODE_EXCLUSIVE,
-		&depth_image
-	);
-	shAllocateImageMemory(
-		device, physical_device, depth_image,
-		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-		&depth_image_memory
-	);
-	shBindImageMemory(
-		device, depth_image, 0, depth_image_memory
-	);
-	shCreateImageView(
-		device, depth_image, VK_IMAGE_VIEW_TYPE_2D,
-		VK_IMAGE_ASPECT_DEPTH_BIT, 1,
-		VK_FORMAT_D32_SFLOAT, &depth_image_view
-	);
-
-	shCreateImage(
-		device, VK_IMAGE_TYPE_2D, width, height, 1,
-		swapchain_image_format, 1, sample_count,
-		VK_IMAGE_TILING_OPTIMAL,
-		VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT, VK_SHARING_MODE_EXCLUSIVE,
-		&input_color_image
-	);
-	shAllocateImageMemory(
-		device, physical_device, input_color_image,
-		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &input_color_image_memory
-	);
-	shBindImageMemory(
-		device, input_color_image, 0, input_color_image_memory
+	//multisample color and depth only live inside the render pass
+	shVkError(
+		p_attachment_pool == VK_NULL_HANDLE,
+		"invalid transient attachment pool memory",
+		return -1
 	);
-	shCreateImageView(
-		device, input_color_image, VK_IMAGE_VIEW_TYPE_2D,
-		VK_IMAGE_ASPECT_COLOR_BIT, 1, swapchain_image_format,
-		&input_color_image_view
+	shCreateTransientAttachmentPool(device, physical_device, p_attachment_pool);
+	acquireAttachments(
+		width,//width
+		height,//height
+		sample_count,//sample_count
+		swapchain_image_format,//color_format
+		VK_NULL_HANDLE,//p_release_queue
+		p_attachment_pool,//p_attachment_pool
+		&input_color_attachment_idx,//p_input_color_attachment_idx
+		&depth_attachment_idx//p_depth_attachment_idx
 	);
 
 	for (uint32_t i = 0; i < swapchain_image_count; i++) {
 		VkImageView image_views[RENDERPASS_ATTACHMENT_COUNT] = {
-			input_color_image_view, depth_image_view, swapchain_image_views[i]
+			p_attachment_pool->attachments[input_color_attachment_idx].image_view,
+			p_attachment_pool->attachments[depth_attachment_idx].image_view,
+			swapchain_image_views[i]
 		};
 		shCreateFramebuffer(
 			device,//device
@@ -579,12 +558,10 @@ int main(void) {
 	VkBuffer       vertex_buffer      = VK_NULL_HANDLE;
 	VkBuffer       instance_buffer    = VK_NULL_HANDLE;
 	VkBuffer       index_buffer       = VK_NULL_HANDLE;
-	VkBuffer       descriptors_buffer = VK_NULL_HANDLE;
 
 	VkDeviceMemory vertex_memory      = VK_NULL_HANDLE;
 	VkDeviceMemory instance_memory    = VK_NULL_HANDLE;
 	VkDeviceMemory index_memory       = VK_NULL_HANDLE;
-	VkDeviceMemory descriptors_memory = VK_NULL_HANDLE;
 
 	writeMemory(
 		device,
@@ -599,9 +576,25 @@ int main(void) {
 		&instance_buffer,
 		&instance_memory,
 		&index_buffer,
-		&index_memory,
-		&descriptors_buffer,
-		&descriptors_memory
+		&index_memory
+	);
+
+	//one region per frame in flight, the light is rewritten every frame through a single dynamic descriptor
+	ShVkUniformArena uniform_arena = { 0 };
+
+	r = shCreateUniformArena(
+		device,//device
+		physical_device,//physical_device
+		MAX_SWAPCHAIN_IMAGE_COUNT,//frame_count
+		sizeof(light),//frame_size
+		VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,//usage
+		&uniform_arena//p_arena
+	);
+
+	shVkError(
+		r == 0,
+		"failed creating uniform arena",
+		return -1
 	);
 
 	ShVkPipelinePool* p_pipeline_pool =  shAllocatePipelinePool();
@@ -616,15 +609,13 @@ int main(void) {
 
 	createPipelinesDataPool(
 		device,
-		descriptors_buffer,
-		swapchain_image_count,
+		uniform_arena.buffer,
 		p_pipeline_pool
 	);
 
 	createPipeline(
 		device, renderpass, 
 		width, height, sample_count,
-		swapchain_image_count,
 		p_pipeline_pool
 	);
 
@@ -645,16 +636,20 @@ int main(void) {
 				height = _height;
 
 				resizeWindow(
-					width, height, instance, window, &surface, &surface_capabilities, physical_device,
-					device, graphics_queue_family_index, sample_count, &swapchain, &swapchain_image_format,
+					width, height, surface, &surface_capabilities, physical_device,
+					device, sample_count, p_release_queue, &swapchain, &swapchain_image_format,
 					swapchain_image_sharing_mode, &swapchain_image_count, swapchain_image_views, swapchain_images,
-					&input_color_image, &input_color_image_memory, &input_color_image_view, &depth_image, &depth_image_memory,
-					&depth_image_view, &renderpass, attachment_descriptions, &subpass, framebuffers
+					p_attachment_pool, &input_color_attachment_idx, &depth_attachment_idx,
+					&renderpass, attachment_descriptions, &subpass, framebuffers
 				);
 
 				swapchain_image_idx = 0;
 
-				shDestroyPipeline (device, p_pipeline->pipeline);
+				shDeferRelease(
+					SH_RELEASE_TYPE_PIPELINE,//type
+					(ShVkReleaseHandle) { .pipeline = p_pipeline->pipeline },//handle
+					p_release_queue//p_release_queue
+				);
 				shPipelineSetViewport(0, 0,width, height, 0, 0,width, height, p_pipeline);
 				shSetupGraphicsPipeline(device, renderpass, p_pipeline);
 			
@@ -662,11 +657,11 @@ int main(void) {
 
 			if (swapchain_suboptimal) {
 				resizeWindow(
-					width, height, instance, window, &surface, &surface_capabilities, physical_device,
-					device, graphics_queue_family_index, sample_count, &swapchain, &swapchain_image_format,
+					width, height, surface, &surface_capabilities, physical_device,
+					device, sample_count, p_release_queue, &swapchain, &swapchain_image_format,
 					swapchain_image_sharing_mode, &swapchain_image_count, swapchain_image_views, swapchain_images,
-					&input_color_image, &input_color_image_memory, &input_color_image_view, &depth_image, &depth_image_memory,
-					&depth_image_view, &renderpass, attachment_descriptions, &subpass, framebuffers
+					p_attachment_pool, &input_color_attachment_idx, &depth_attachment_idx,
+					&renderpass, attachment_descriptions, &subpass, framebuffers
 				);
 				swapchain_suboptimal = 0;
 			}
@@ -703,8 +698,26 @@ int main(void) {
 				&graphics_cmd_fences[swapchain_image_idx]//p_fences
 			);
 
+			//the submissions before the one of this fence have completed too
+			shCollectReleases(
+				device,//device
+				graphics_submissions[swapchain_image_idx],//completed_submission_value
+				p_release_queue//p_release_queue
+			);
+
 			VkCommandBuffer cmd_buffer = graphics_cmd_buffers[swapchain_image_idx];
 
+			//the fence of this image has signaled, so has the last frame reading its arena region
+			shUniformArenaBeginFrame(swapchain_image_idx, &uniform_arena);
+
+			uint32_t light_dynamic_offset = 0;
+			shUniformArenaPush(
+				sizeof(light),//size
+				light,//p_data
+				&light_dynamic_offset,//p_dynamic_offset
+				&uniform_arena//p_arena
+			);
+
 			shBeginCommandBuffer(cmd_buffer);
 			
 			triangle[6] = (float)sin(glfwGetTime());;
@@ -756,15 +769,15 @@ int main(void) {
 			shPipelinePushConstants(cmd_buffer, projection_view, p_pipeline);
 
 			shPipelineBindDescriptorSetUnits(
-				cmd_buffer,                                 //cmd_buffer
-				INFO_DESCRIPTOR_SET_IDX,                    //first_descriptor_set
-				DESCRIPTOR_SET_COUNT * swapchain_image_idx, //first_descriptor_set_unit_idx
-				DESCRIPTOR_SET_COUNT,                       //descriptor_set_unit_count
-				VK_PIPELINE_BIND_POINT_GRAPHICS,            //bind_point
-				0,                                          //dynamic_descriptors_count
-				VK_NULL_HANDLE,                             //p_dynamic_offsets
-				p_pipeline_pool,                            //p_pipeline_pool
-				p_pipeline                                  //p_pipeline
+				cmd_buffer,                      //cmd_buffer
+				INFO_DESCRIPTOR_SET_IDX,         //first_descriptor_set
+				0,                               //first_descriptor_set_unit_idx
+				DESCRIPTOR_SET_COUNT,            //descriptor_set_unit_count
+				VK_PIPELINE_BIND_POINT_GRAPHICS, //bind_point
+				1,                               //dynamic_descriptors_count
+				&light_dynamic_offset,           //p_dynamic_offsets
+				p_pipeline_pool,                 //p_pipeline_pool
+				p_pipeline                       //p_pipeline
 			);
 
 			shDrawIndexed(cmd_buffer, QUAD_INDEX_COUNT, 2, 0, 0, 0);
@@ -775,6 +788,11 @@ int main(void) {
 
 			shEndCommandBuffer(cmd_buffer);
 
+			shReleaseQueueSubmit(
+				p_release_queue,//p_release_queue
+				&graphics_submissions[swapchain_image_idx]//p_submission_value
+			);
+
 			shQueueSubmit(
 				1,//cmd_buffer_count
 				&cmd_buffer,//p_cmd_buffers
@@ -804,6 +822,9 @@ int main(void) {
 	}
 
 	shWaitDeviceIdle(device);
+
+	shCollectReleases(device, UINT64_MAX, p_release_queue);
+	shFreeReleaseQueue(p_release_queue);
 	
 	shPipelinePoolDestroyDescriptorPools(device, 0, 1, p_pipeline_pool);
 	shPipelinePoolDestroyDescriptorSetLayouts(device, 0, 1, p_pipeline_pool);
@@ -819,7 +840,7 @@ int main(void) {
 
 	shDestroySemaphores(device, 1, &current_graphics_queue_finished_semaphore);
 
-	shDestroyFences(device, swapchain_image_count, graphics_cmd_fences);
+	shDestroyFences(device, graphics_cmd_fence_count, graphics_cmd_fences);
 
 	shDestroyCommandBuffers(device, graphics_cmd_pool, swapchain_image_count, graphics_cmd_buffers);
 
@@ -835,14 +856,13 @@ int main(void) {
 		staging_buffer, staging_memory, 
 		vertex_buffer, vertex_memory,
 		instance_buffer, instance_memory,
-		index_buffer, index_memory,
-		descriptors_buffer, descriptors_memory
+		index_buffer, index_memory
 	);
 
-	shClearImageMemory(device, depth_image, depth_image_memory);
-	shClearImageMemory(device, input_color_image, input_color_image_memory);
-	shDestroyImageViews(device, 1, &depth_image_view);
-	shDestroyImageViews(device, 1, &input_color_image_view);
+	shDestroyUniformArena(device, &uniform_arena);
+
+	shDestroyTransientAttachmentPool(p_attachment_pool);
+	shFreeTransientAttachmentPool(p_attachment_pool);
 
 	shDestroyRenderpass(device, renderpass);
 
@@ -874,9 +894,7 @@ void writeMemory(
 	VkBuffer*        p_instance_buffer,
 	VkDeviceMemory*  p_instance_memory,
 	VkBuffer*        p_index_buffer,
-	VkDeviceMemory*  p_index_memory,
-	VkBuffer*        p_descriptors_buffer,
-	VkDeviceMemory*  p_descriptors_memory
+	VkDeviceMemory*  p_index_memory
 ) {	
 	//
 	//USEFUL VARIABLES
@@ -885,9 +903,8 @@ void writeMemory(
 	uint32_t triangle_vertices_offset = quad_vertices_offset     + sizeof(quad);
 	uint32_t instance_models_offset   = triangle_vertices_offset + sizeof(triangle);
 	uint32_t quad_indices_offset      = instance_models_offset   + sizeof(models);
-	uint32_t light_offset             = quad_indices_offset      + sizeof(indices);
 
-	uint32_t staging_size = light_offset + sizeof(light);
+	uint32_t staging_size = quad_indices_offset + sizeof(indices);
 
 	//
 	//WRITE ALL DATA TO STAGING BUFFER
@@ -910,7 +927,6 @@ void writeMemory(
 	shWriteMemory(device, *p_staging_memory, triangle_vertices_offset, sizeof(triangle), triangle);
 	shWriteMemory(device, *p_staging_memory, instance_models_offset,   sizeof(models),   models);
 	shWriteMemory(device, *p_staging_memory, quad_indices_offset,      sizeof(indices),  indices);
-	shWriteMemory(device, *p_staging_memory, light_offset,             sizeof(light),    light);
 
 	shBindBufferMemory(device, *p_staging_buffer, 0, *p_staging_memory);
 
@@ -929,10 +945,6 @@ void writeMemory(
 	shAllocateBufferMemory(device, physical_device, *p_index_buffer, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, p_index_memory);
 	shBindBufferMemory(device, *p_index_buffer, 0, *p_index_memory);
 
-	shCreateBuffer(device, sizeof(light), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_SHARING_MODE_EXCLUSIVE, p_descriptors_buffer);
-	shAllocateBufferMemory(device, physical_device, *p_descriptors_buffer, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, p_descriptors_memory);
-	shBindBufferMemory(device, *p_descriptors_buffer, 0, *p_descriptors_memory);
-
 	//
 	//COPY STAGING BUFFER TO DEVICE LOCAL MEMORY
 	//
@@ -941,7 +953,6 @@ void writeMemory(
 	shCopyBuffer(cmd_buffer, *p_staging_buffer, quad_vertices_offset,   0, sizeof(quad) + sizeof(triangle), *p_vertex_buffer);
 	shCopyBuffer(cmd_buffer, *p_staging_buffer, instance_models_offset, 0, sizeof(models),                  *p_instance_buffer);
 	shCopyBuffer(cmd_buffer, *p_staging_buffer, quad_indices_offset,    0, sizeof(indices),                 *p_index_buffer);
-	shCopyBuffer(cmd_buffer, *p_staging_buffer, light_offset,           0, sizeof(light),                   *p_descriptors_buffer);
 	shEndCommandBuffer(cmd_buffer);
 
 	shQueueSubmit(1, &cmd_buffer, transfer_queue, fence, 0, VK_NULL_HANDLE, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, VK_NULL_HANDLE);
@@ -959,110 +970,73 @@ void releaseMemory(
 	VkBuffer       instance_buffer,
 	VkDeviceMemory instance_memory,
 	VkBuffer       index_buffer,
-	VkDeviceMemory index_memory,
-	VkBuffer       descriptors_buffer,
-	VkDeviceMemory descriptors_memory
+	VkDeviceMemory index_memory
 ) {
 	shWaitDeviceIdle(device);
 	shClearBufferMemory(device, staging_buffer, staging_memory);
 	shClearBufferMemory(device, vertex_buffer, vertex_memory);
 	shClearBufferMemory(device, instance_buffer, instance_memory);
 	shClearBufferMemory(device, index_buffer, index_memory);
-	shClearBufferMemory(device, descriptors_buffer, descriptors_memory);
 	return;
 }
 
 void createPipelinesDataPool(
 	VkDevice          device,
-	VkBuffer          descriptors_buffer,
-	uint32_t          swapchain_image_count,
+	VkBuffer          uniform_buffer,
 	ShVkPipelinePool* p_pipeline_pool
 ) {
-	//SAME BINDING FOR ALL
+	//ONE DYNAMIC DESCRIPTOR FOR ALL FRAMES
 	//
 	//
 	shPipelinePoolCreateDescriptorSetLayoutBinding(
-		0,                                 //binding
-		VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, //descriptor_type
-		1,                                 //descriptor_set_count
-		VK_SHADER_STAGE_FRAGMENT_BIT,      //shader_stage
-		p_pipeline_pool                    //p_pipeline_pool
+		0,                                         //binding
+		VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, //descriptor_type
+		1,                                         //descriptor_set_count
+		VK_SHADER_STAGE_FRAGMENT_BIT,              //shader_stage
+		p_pipeline_pool                            //p_pipeline_pool
 	);
-	
-
-
-	for (uint32_t i = 0; i < DESCRIPTOR_SET_COUNT * swapchain_image_count; i += DESCRIPTOR_SET_COUNT) {
-		//INFO
-		//
-		//
-		shPipelinePoolSetDescriptorBufferInfos(
-			i + INFO_DESCRIPTOR_SET_IDX, //first_descriptor
-			1,                           //descriptor_count
-			descriptors_buffer,          //buffer
-			0,                           //buffer_offset
-			sizeof(light),               //buffer_size
-			p_pipeline_pool              //p_pipeline_pool
-		);
 
-#if DESCRIPTOR_SET_COUNT == 2
-		//OPTIONAL
-		//
-		//
-		shPipelinePoolSetDescriptorBufferInfos(
-			i + OPTIONAL_DESCRIPTOR_SET_IDX, //first_descriptor
-			1,                               //descriptor_count
-			descriptors_buffer,              //buffer
-			0,                               //buffer_offset
-			sizeof(light) / 2,               //buffer_size
-			p_pipeline_pool                  //p_pipeline_pool
-		);
-#endif
-	}
-
-	//SAME DESCRIPTOR SET LAYOUT FOR ALL
-	//
+	//INFO
+	//the range covers one light, the frame region is selected by the dynamic offset
 	//
+	shPipelinePoolSetDescriptorBufferInfos(
+		INFO_DESCRIPTOR_SET_IDX, //first_descriptor
+		1,                       //descriptor_count
+		uniform_buffer,          //buffer
+		0,                       //buffer_offset
+		sizeof(light),           //buffer_size
+		p_pipeline_pool          //p_pipeline_pool
+	);
+
 	shPipelinePoolCreateDescriptorSetLayout(
 		device,         //device
 		0,              //first_binding_idx
 		1,              //binding_count
 		0,              //set_layout_idx
+		0,              //flags
 		p_pipeline_pool //p_pipeline_pool
 	);
-	
-	shPipelinePoolCopyDescriptorSetLayout(
-		0,                                            //src_set_layout_idx
-		0,                                            //first_dst_set_layout_idx
-		DESCRIPTOR_SET_COUNT * swapchain_image_count, //dst_set_layout_count
-		p_pipeline_pool                               //p_pipeline_pool
-	);
 
-	//SAME DESCRIPTOR POOL FOR ALL
-	//
-	//
 	shPipelinePoolCreateDescriptorPool(
-		device,                                       //device
-		0,                                            //pool_idx
-		VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,            //descriptor_type
-		DESCRIPTOR_SET_COUNT * swapchain_image_count, //decriptor_count
-		p_pipeline_pool                               //p_pipeline_pool
+		device,                                    //device
+		0,                                         //pool_idx
+		VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, //descriptor_type
+		DESCRIPTOR_SET_COUNT,                      //decriptor_count
+		p_pipeline_pool                            //p_pipeline_pool
 	);
 
 	shPipelinePoolAllocateDescriptorSetUnits(
-		device,                                       //device,
-		0,                                            //binding,
-		0,                                            //pool_idx,
-		VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,            //descriptor_type,
-		0,                                            //first_descriptor_set_unit,
-		DESCRIPTOR_SET_COUNT * swapchain_image_count, //descriptor_set_unit_count,
-		p_pipeline_pool                               //p_pipeline
+		device,                                    //device,
+		0,                                         //binding,
+		0,                                         //pool_idx,
+		VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, //descriptor_type,
+		0,                                         //first_descriptor_set_unit,
+		DESCRIPTOR_SET_COUNT,                      //descriptor_set_unit_count,
+		p_pipeline_pool                            //p_pipeline
 	);
 
-	//UPDATE ALL
-	//
-	//
 	shPipelinePoolUpdateDescriptorSetUnits(
-		device, 0, DESCRIPTOR_SET_COUNT * swapchain_image_count, p_pipeline_pool
+		device, 0, DESCRIPTOR_SET_COUNT, p_pipeline_pool
 	);
 
 	return;
@@ -1074,7 +1048,6 @@ void createPipeline(
 	uint32_t          width,
 	uint32_t          height,
 	uint32_t          sample_count,
-	uint32_t          swapchain_image_count,
 	ShVkPipelinePool* p_pipeline_pool
 ) {
 	ShVkPipeline* p_pipeline = &p_pipeline_pool->pipelines[0];
@@ -1225,7 +1198,7 @@ void createPipeline(
 	shPipelineCreateLayout(
 		device,
 		0,
-		DESCRIPTOR_SET_COUNT * swapchain_image_count,
+		DESCRIPTOR_SET_COUNT,
 		p_pipeline_pool,
 		p_pipeline
 	);
@@ -1240,120 +1213,66 @@ void createPipeline(
 }
 
 void resizeWindow(
-	uint32_t                  width,
-	uint32_t                  height,
-	VkInstance                instance,
-	GLFWwindow*               window,
-	VkSurfaceKHR*             p_surface,
-	VkSurfaceCapabilitiesKHR* p_surface_capabilities,
-	VkPhysicalDevice          physical_device,
-	VkDevice                  device,
-	uint32_t                  graphics_queue_family_index,
-	uint32_t                  sample_count,
-	VkSwapchainKHR*           p_swapchain,
-	VkFormat*                 p_swapchain_image_format,
-	VkSharingMode             swapchain_image_sharing_mode,
-	uint32_t*                 p_swapchain_image_count,
-	VkImageView*              p_swapchain_image_views,
-	VkImage*                  p_swapchain_images,
-	VkImage*                  p_input_color_image,
-	VkDeviceMemory*           p_input_color_image_memory,
-	VkImageView*              p_input_color_image_view,
-	VkImage*                  p_depth_image,
-	VkDeviceMemory*           p_depth_image_memory,
-	VkImageView*              p_depth_image_view,
-	VkRenderPass*             p_renderpass,
-	VkAttachmentDescription*  p_attachment_descriptions,
-	VkSubpassDescription*     p_subpass,
-	VkFramebuffer*            p_framebuffers
+	uint32_t                     width,
+	uint32_t                     height,
+	VkSurfaceKHR                 surface,
+	VkSurfaceCapabilitiesKHR*    p_surface_capabilities,
+	VkPhysicalDevice             physical_device,
+	VkDevice                     device,
+	uint32_t                     sample_count,
+	ShVkReleaseQueue*            p_release_queue,
+	VkSwapchainKHR*              p_swapchain,
+	VkFormat*                    p_swapchain_image_format,
+	VkSharingMode                swapchain_image_sharing_mode,
+	uint32_t*                    p_swapchain_image_count,
+	VkImageView*                 p_swapchain_image_views,
+	VkImage*                     p_swapchain_images,
+	ShVkTransientAttachmentPool* p_attachment_pool,
+	uint32_t*                    p_input_color_attachment_idx,
+	uint32_t*                    p_depth_attachment_idx,
+	VkRenderPass*                p_renderpass,
+	VkAttachmentDescription*     p_attachment_descriptions,
+	VkSubpassDescription*        p_subpass,
+	VkFramebuffer*               p_framebuffers
 ) {
-	shWaitDeviceIdle(device);
-
-	shDestroyRenderpass(device, *p_renderpass);
-	shDestroyFramebuffers(device, *p_swapchain_image_count, p_framebuffers);
-	shDestroyImageViews(device, *p_swapchain_image_count, p_swapchain_image_views);
-	shDestroySwapchain(device, *p_swapchain);
-	shDestroySurface(instance, *p_surface);
+	//frames in flight may still use these, they are destroyed once the next submission has completed
+	for (uint32_t i = 0; i < (*p_swapchain_image_count); i++) {
+		shDeferRelease(SH_RELEASE_TYPE_FRAMEBUFFER, (ShVkReleaseHandle) { .framebuffer = p_framebuffers[i] }, p_release_queue);
+	}
 
-	shClearImageMemory(device, *p_depth_image, *p_depth_image_memory);
-	shClearImageMemory(device, *p_input_color_image, *p_input_color_image_memory);
-	shDestroyImageViews(device, 1, p_depth_image_view);
-	shDestroyImageViews(device, 1, p_input_color_image_view);
+	shGetPhysicalDeviceSurfaceCapabilities(physical_device, surface, p_surface_capabilities);
 
-	glfwCreateWindowSurface(instance, window, VK_NULL_HANDLE, p_surface);
-	shGetPhysicalDeviceSurfaceSupport(physical_device, graphics_queue_family_index, *p_surface, NULL);
-	shGetPhysicalDeviceSurfaceCapabilities(physical_device, *p_surface, p_surface_capabilities);
-	shCreateSwapchain(
-		device, physical_device, *p_surface,
-		*p_swapchain_image_format,
-		p_swapchain_image_format,
-		SWAPCHAIN_IMAGE_COUNT,
+	uint8_t format_changed = 0;
+	shRecreateSwapchain(
+		device, physical_device, surface,
 		swapchain_image_sharing_mode,
-		SH_FALSE,
-		p_swapchain_image_count,
-		p_swapchain
+		SH_PRESENT_POLICY_LOW_LATENCY,
+		SWAPCHAIN_IMAGE_COUNT,
+		p_release_queue,
+		p_swapchain, p_swapchain_image_format,
+		p_swapchain_image_count, p_swapchain_images, p_swapchain_image_views,
+		&format_changed
 	);
-	shGetSwapchainImages(device, *p_swapchain, p_swapchain_image_count, p_swapchain_images);
-	for (uint32_t i = 0; i < (*p_swapchain_image_count); i++) {
-		shCreateImageView(
-			device, p_swapchain_images[i],
-			VK_IMAGE_VIEW_TYPE_2D, VK_IMAGE_ASPECT_COLOR_BIT,
-			1, *p_swapchain_image_format,
-			&p_swapchain_image_views[i]
-		);
-	}
 
-	shCreateImage(
-		device, VK_IMAGE_TYPE_2D,
-		width, height, 1,
-		VK_FORMAT_D32_SFLOAT,
-		1, sample_count,
-		VK_IMAGE_TILING_OPTIMAL,
-		VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT,
-		VK_SHARING_MODE_EXCLUSIVE, p_depth_image
-	);
-	shAllocateImageMemory(
-		device, physical_device, *p_depth_image,
-		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-		p_depth_image_memory
-	);
-	shBindImageMemory(
-		device, *p_depth_image, 0, *p_depth_image_memory
-	);
-	shCreateImageView(
-		device, *p_depth_image, VK_IMAGE_VIEW_TYPE_2D,
-		VK_IMAGE_ASPECT_DEPTH_BIT, 1,
-		VK_FORMAT_D32_SFLOAT, p_depth_image_view
-	);
-
-	shCreateImage(
-		device, VK_IMAGE_TYPE_2D,
-		width, height, 1,
-		*p_swapchain_image_format,
-		1, sample_count,
-		VK_IMAGE_TILING_OPTIMAL,
-		VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT,
-		VK_SHARING_MODE_EXCLUSIVE,
-		p_input_color_image
-	);
-	shAllocateImageMemory(
-		device, physical_device, *p_input_color_image,
-		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-		p_input_color_image_memory
-	);
-	shBindImageMemory(
-		device, *p_input_color_image, 0, *p_input_color_image_memory
-	);
-	shCreateImageView(
-		device, *p_input_color_image, VK_IMAGE_VIEW_TYPE_2D,
-		VK_IMAGE_ASPECT_COLOR_BIT, 1, *p_swapchain_image_format,
-		p_input_color_image_view
-	);
-
-	shCreateRenderpass(device, RENDERPASS_ATTACHMENT_COUNT, p_attachment_descriptions, 1, p_subpass, p_renderpass);
+	//attachments of the same size class are kept, the others are released once the frames in flight complete
+	acquireAttachments(
+		width, height, sample_count, *p_swapchain_image_format,
+		p_release_queue,
+		p_attachment_pool, p_input_color_attachment_idx, p_depth_attachment_idx
+	);
+
+	//the render pass only depends on the attachment formats
+	if (format_changed) {
+		shDeferRelease(SH_RELEASE_TYPE_RENDERPASS, (ShVkReleaseHandle) { .renderpass = *p_renderpass }, p_release_queue);
+		p_attachment_descriptions[0].format = *p_swapchain_image_format;
+		p_attachment_descriptions[2].format = *p_swapchain_image_format;
+		shCreateRenderpass(device, RENDERPASS_ATTACHMENT_COUNT, p_attachment_descriptions, 1, p_subpass, p_renderpass);
+	}
 	for (uint32_t i = 0; i < (*p_swapchain_image_count); i++) {
 		VkImageView image_views[RENDERPASS_ATTACHMENT_COUNT] = {
-			*p_input_color_image_view, *p_depth_image_view, p_swapchain_image_views[i]
+			p_attachment_pool->attachments[*p_input_color_attachment_idx].image_view,
+			p_attachment_pool->attachments[*p_depth_attachment_idx].image_view,
+			p_swapchain_image_views[i]
 		};
 		shCreateFramebuffer(device, *p_renderpass, RENDERPASS_ATTACHMENT_COUNT, image_views, width, height, 1, &p_framebuffers[i]);
 	}
@@ -1361,6 +1280,46 @@ void resizeWindow(
 	return;
 }
 
+void acquireAttachments(
+	uint32_t                     width,
+	uint32_t                     height,
+	uint32_t                     sample_count,
+	VkFormat                     color_format,
+	ShVkReleaseQueue*            p_release_queue,
+	ShVkTransientAttachmentPool* p_attachment_pool,
+	uint32_t*                    p_input_color_attachment_idx,
+	uint32_t*                    p_depth_attachment_idx
+) {
+	shTransientAttachmentPoolBegin(p_attachment_pool);
+
+	shTransientAttachmentPoolAcquire(
+		color_format,//format
+		width,//width
+		height,//height
+		(VkSampleCountFlagBits)sample_count,//sample_count
+		VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT,//usage
+		VK_IMAGE_ASPECT_COLOR_BIT,//aspect_mask
+		0,//first_pass
+		0,//last_pass
+		p_attachment_pool,//p_pool
+		p_input_color_attachment_idx//p_attachment_idx
+	);
+	shTransientAttachmentPoolAcquire(
+		VK_FORMAT_D32_SFLOAT,//format
+		width,//width
+		height,//height
+		(VkSampleCountFlagBits)sample_count,//sample_count
+		VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT,//usage
+		VK_IMAGE_ASPECT_DEPTH_BIT,//aspect_mask
+		0,//first_pass
+		0,//last_pass
+		p_attachment_pool,//p_pool
+		p_depth_attachment_idx//p_attachment_idx
+	);
+
+	shTransientAttachmentPoolCommit(p_release_queue, p_attachment_pool);
+}
+
 #ifdef _MSC_VER
 #pragma warning (disable: 4996)
 #endif//_MSC_VER
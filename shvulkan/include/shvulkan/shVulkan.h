@@ -19,6 +19,8 @@ extern "C" {
 #include <vulkan/vulkan.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
 
 
 
@@ -40,6 +42,16 @@ extern "C" {
 
 
 
+#ifndef SH_INLINE
+#ifdef _MSC_VER
+#define SH_INLINE static __inline
+#else
+#define SH_INLINE static inline
+#endif//_MSC_VER
+#endif//SH_INLINE
+
+
+
 #ifndef VK_MAKE_API_VERSION
 #define VK_MAKE_API_VERSION(variant, major, minor, patch)\
     ((((uint32_t)(variant)) << 29U) | (((uint32_t)(major)) << 22U) | (((uint32_t)(minor)) << 12U) | ((uint32_t)(patch)))
@@ -50,38 +62,71 @@ extern "C" {
 /**
  * @brief Error-checking macro for Vulkan conditions.
  * 
- * This macro checks a given condition. If the condition evaluates to true, it prints an error message
- * and executes a failure expression (like returning from a function or exiting).
+ * This macro checks a given condition. If the condition evaluates to true, it reports an error message
+ * with shReportError and executes a failure expression (like returning from a function or exiting).
  * 
  * @param condition The condition to check (non-zero for an error).
- * @param error_msg A message to be printed if the condition is true.
+ * @param error_msg A literal message to be reported if the condition is true.
  * @param failure_expression The expression to execute when the condition is true (e.g., return or exit).
  * 
  * @note This macro does not return any value but executes the failure_expression if the condition is met.
+ * 
+ * @note Runtime failures, such as the results of nested calls, are always checked. Argument checks use shVkArgError.
  */
 #define shVkError(condition, error_msg, failure_expression)\
 	if ((int)(condition)) {\
-		printf("shvulkan error: %s\n", (const char*)(error_msg));\
+		shReportError(VK_ERROR_UNKNOWN, __func__, (const char*)(error_msg));\
+		failure_expression;\
+	}
+
+/**
+ * @brief Error-checking macro for function arguments.
+ * 
+ * Same as shVkError, for conditions which only validate the arguments of the calling function and have no side
+ * effects. Building with SH_VULKAN_VALIDATION_ASSERT turns the check into an assertion, still followed by
+ * failure_expression when assertions are disabled. SH_VULKAN_VALIDATION_NONE removes the check. The cmake target
+ * exports the define, so the inline functions of this header validate like the ones in shVulkan.c.
+ * 
+ * @param condition The argument condition to check (non-zero for an error), must not call functions.
+ * @param error_msg A literal message to be reported if the condition is true.
+ * @param failure_expression The expression to execute when the condition is true (e.g., return or exit).
+ */
+#if defined(SH_VULKAN_VALIDATION_NONE)
+#define shVkArgError(condition, error_msg, failure_expression)\
+	((void)0)
+#elif defined(SH_VULKAN_VALIDATION_ASSERT)
+#define shVkArgError(condition, error_msg, failure_expression)\
+	if ((int)(condition)) {\
+		assert(0 && (error_msg));\
 		failure_expression;\
 	}
+#else
+#define shVkArgError(condition, error_msg, failure_expression)\
+	shVkError(condition, error_msg, failure_expression)
+#endif//SH_VULKAN_VALIDATION_NONE
 
 /**
  * @brief Error-checking macro for Vulkan VkResult.
  * 
  * This macro checks the result of a Vulkan API call. If the result is not VK_SUCCESS, 
- * it prints an error message along with the translated Vulkan error code and executes 
+ * it reports an error message along with the Vulkan error code and executes 
  * a failure expression (like returning from a function or exiting).
  * 
- * @param result The VkResult from a Vulkan function (VK_SUCCESS or an error code).
- * @param error_msg A message to be printed if the result is not VK_SUCCESS.
+ * @param result The VkResult from a Vulkan function (VK_SUCCESS or an error code), evaluated once.
+ * @param error_msg A literal message to be reported if the result is not VK_SUCCESS.
  * @param failure_expression The expression to execute when the result is an error (e.g., return or exit).
  * 
- * @note This macro calls `shTranslateVkResult()` to convert the VkResult enum into a string representation.
+ * @note The VkResult is kept in the last error record, see shGetLastError.
+ * 
+ * @note Vulkan call results are runtime errors rather than argument validation, they are always checked.
  */
 #define shVkResultError(result, error_msg, failure_expression)\
-	if ((VkResult)(result) != VK_SUCCESS) {\
-		printf("shvulkan error: %s, %s\n", error_msg, shTranslateVkResult((VkResult)(result)));\
-		failure_expression;\
+	{\
+		VkResult sh_vk_result = (VkResult)(result);\
+		if (sh_vk_result != VK_SUCCESS) {\
+			shReportError(sh_vk_result, __func__, (const char*)(error_msg));\
+			failure_expression;\
+		}\
 	}
 
 /**
@@ -103,6 +148,334 @@ extern const char* shTranslateVkResult(
 );
 
 
+
+#define SH_ERROR_RING_SIZE 256 //must be a power of two
+
+/**
+ * @brief Error reported by shVkError, shVkResultError or shReportError.
+ * 
+ * Strings are not copied: function is `__func__` and message is expected to be a literal.
+ */
+typedef struct ShVkErrorRecord {
+	VkResult    result;   ///< Failed Vulkan result, `VK_ERROR_UNKNOWN` for invalid arguments and library checks.
+	const char* function; ///< Name of the function reporting the error.
+	const char* message;  ///< Error message.
+} ShVkErrorRecord;
+
+/**
+ * @brief Where reported errors are written, after the thread local record and the callback.
+ */
+typedef enum ShVkErrorOutput {
+	SH_ERROR_OUTPUT_PRINT = 0, ///< Printed to stdout right away, the default.
+	SH_ERROR_OUTPUT_RING  = 1, ///< Pushed to a lock free ring buffer, read later with shDrainErrors or shPrintErrors.
+	SH_ERROR_OUTPUT_NONE  = 2  ///< Only kept in the thread local record and passed to the callback.
+} ShVkErrorOutput;
+
+/**
+ * @brief User function called on the reporting thread for every error.
+ */
+typedef void (*ShVkErrorCallback)(const ShVkErrorRecord* p_record, void* p_user_data);
+
+/**
+ * @brief Reports an error.
+ * 
+ * Stores the error in the last error record of the calling thread, calls the error callback when one is set,
+ * then writes the error to the selected output. Safe to call from several threads at once.
+ * 
+ * @param result Failed Vulkan result.
+ * @param function Name of the reporting function.
+ * @param message Error message.
+ */
+extern void shReportError(
+	VkResult    result,
+	const char* function,
+	const char* message
+);
+
+/**
+ * @brief Retrieves the last error reported on the calling thread.
+ * 
+ * @param[out] p_record Valid destination pointer to the error record, zeroed when no error was reported.
+ * 
+ * @return 1 if an error was reported since the last call to shClearLastError, 0 otherwise.
+ */
+extern uint8_t shGetLastError(
+	ShVkErrorRecord* p_record
+);
+
+/**
+ * @brief Clears the last error record of the calling thread.
+ */
+extern void shClearLastError(
+	void
+);
+
+/**
+ * @brief Sets the error callback and the error output.
+ * 
+ * Meant to be called once at startup, before other threads report errors.
+ * 
+ * @param callback Function called for every error, can be `VK_NULL_HANDLE`.
+ * @param p_user_data Pointer passed to the callback.
+ * @param output Where errors are written after the callback.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shSetErrorHandling(
+	ShVkErrorCallback callback,
+	void*             p_user_data,
+	ShVkErrorOutput   output
+);
+
+/**
+ * @brief Pops errors from the ring buffer.
+ * 
+ * Must be called from a single thread at a time. Errors reported while the ring is full are dropped and counted.
+ * 
+ * @param max_record_count Capacity of p_records.
+ * @param[out] p_records Valid destination pointer to an array of error records.
+ * @param[out] p_record_count Valid destination pointer to the number of records written.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shDrainErrors(
+	uint32_t         max_record_count,
+	ShVkErrorRecord* p_records,
+	uint32_t*        p_record_count
+);
+
+/**
+ * @brief Pops every error from the ring buffer and prints it to stdout.
+ * 
+ * Same threading rules as shDrainErrors.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shPrintErrors(
+	void
+);
+
+/**
+ * @brief Retrieves error counters, for monitoring.
+ * 
+ * @param[out] p_error_count Optional destination pointer to the number of errors reported since startup.
+ * @param[out] p_dropped_count Optional destination pointer to the number of errors dropped by a full ring buffer.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shGetErrorStats(
+	uint64_t* p_error_count,
+	uint64_t* p_dropped_count
+);
+
+
+
+/**
+ * @brief Device level Vulkan functions called by the library.
+ * 
+ * Used to declare the members of ShVkDeviceDispatchTable and to load them, SH_VK_DEVICE_FUNCTION receives each
+ * function name.
+ */
+#define SH_VK_DEVICE_DISPATCH_FUNCTIONS(SH_VK_DEVICE_FUNCTION) \
+	SH_VK_DEVICE_FUNCTION(vkAcquireNextImageKHR)                  \
+	SH_VK_DEVICE_FUNCTION(vkAllocateCommandBuffers)               \
+	SH_VK_DEVICE_FUNCTION(vkAllocateDescriptorSets)               \
+	SH_VK_DEVICE_FUNCTION(vkAllocateMemory)                       \
+	SH_VK_DEVICE_FUNCTION(vkBeginCommandBuffer)                   \
+	SH_VK_DEVICE_FUNCTION(vkBindBufferMemory)                     \
+	SH_VK_DEVICE_FUNCTION(vkBindImageMemory)                      \
+	SH_VK_DEVICE_FUNCTION(vkCmdBeginRenderPass)                   \
+	SH_VK_DEVICE_FUNCTION(vkCmdBindDescriptorSets)                \
+	SH_VK_DEVICE_FUNCTION(vkCmdBindIndexBuffer)                   \
+	SH_VK_DEVICE_FUNCTION(vkCmdBindPipeline)                      \
+	SH_VK_DEVICE_FUNCTION(vkCmdBindVertexBuffers)                 \
+	SH_VK_DEVICE_FUNCTION(vkCmdBlitImage)                         \
+	SH_VK_DEVICE_FUNCTION(vkCmdCopyBuffer)                        \
+	SH_VK_DEVICE_FUNCTION(vkCmdCopyBufferToImage)                 \
+	SH_VK_DEVICE_FUNCTION(vkCmdCopyImage)                         \
+	SH_VK_DEVICE_FUNCTION(vkCmdCopyImageToBuffer)                 \
+	SH_VK_DEVICE_FUNCTION(vkCmdDispatch)                          \
+	SH_VK_DEVICE_FUNCTION(vkCmdDraw)                              \
+	SH_VK_DEVICE_FUNCTION(vkCmdDrawIndexed)                       \
+	SH_VK_DEVICE_FUNCTION(vkCmdEndRenderPass)                     \
+	SH_VK_DEVICE_FUNCTION(vkCmdFillBuffer)                        \
+	SH_VK_DEVICE_FUNCTION(vkCmdPipelineBarrier)                   \
+	SH_VK_DEVICE_FUNCTION(vkCmdPushConstants)                     \
+	SH_VK_DEVICE_FUNCTION(vkCmdResetQueryPool)                    \
+	SH_VK_DEVICE_FUNCTION(vkCmdSetScissor)                        \
+	SH_VK_DEVICE_FUNCTION(vkCmdSetViewport)                       \
+	SH_VK_DEVICE_FUNCTION(vkCmdWriteTimestamp)                    \
+	SH_VK_DEVICE_FUNCTION(vkCreateBuffer)                         \
+	SH_VK_DEVICE_FUNCTION(vkCreateCommandPool)                    \
+	SH_VK_DEVICE_FUNCTION(vkCreateComputePipelines)               \
+	SH_VK_DEVICE_FUNCTION(vkCreateDescriptorPool)                 \
+	SH_VK_DEVICE_FUNCTION(vkCreateDescriptorSetLayout)            \
+	SH_VK_DEVICE_FUNCTION(vkCreateDescriptorUpdateTemplate)       \
+	SH_VK_DEVICE_FUNCTION(vkCreateFence)                          \
+	SH_VK_DEVICE_FUNCTION(vkCreateFramebuffer)                    \
+	SH_VK_DEVICE_FUNCTION(vkCreateGraphicsPipelines)              \
+	SH_VK_DEVICE_FUNCTION(vkCreateImage)                          \
+	SH_VK_DEVICE_FUNCTION(vkCreateImageView)                      \
+	SH_VK_DEVICE_FUNCTION(vkCreatePipelineLayout)                 \
+	SH_VK_DEVICE_FUNCTION(vkCreateQueryPool)                      \
+	SH_VK_DEVICE_FUNCTION(vkCreateRenderPass)                     \
+	SH_VK_DEVICE_FUNCTION(vkCreateSampler)                        \
+	SH_VK_DEVICE_FUNCTION(vkCreateSemaphore)                      \
+	SH_VK_DEVICE_FUNCTION(vkCreateShaderModule)                   \
+	SH_VK_DEVICE_FUNCTION(vkCreateSwapchainKHR)                   \
+	SH_VK_DEVICE_FUNCTION(vkDestroyBuffer)                        \
+	SH_VK_DEVICE_FUNCTION(vkDestroyCommandPool)                   \
+	SH_VK_DEVICE_FUNCTION(vkDestroyDescriptorPool)                \
+	SH_VK_DEVICE_FUNCTION(vkDestroyDescriptorSetLayout)           \
+	SH_VK_DEVICE_FUNCTION(vkDestroyDescriptorUpdateTemplate)      \
+	SH_VK_DEVICE_FUNCTION(vkDestroyDevice)                        \
+	SH_VK_DEVICE_FUNCTION(vkDestroyFence)                         \
+	SH_VK_DEVICE_FUNCTION(vkDestroyFramebuffer)                   \
+	SH_VK_DEVICE_FUNCTION(vkDestroyImage)                         \
+	SH_VK_DEVICE_FUNCTION(vkDestroyImageView)                     \
+	SH_VK_DEVICE_FUNCTION(vkDestroyPipeline)                      \
+	SH_VK_DEVICE_FUNCTION(vkDestroyPipelineLayout)                \
+	SH_VK_DEVICE_FUNCTION(vkDestroyQueryPool)                     \
+	SH_VK_DEVICE_FUNCTION(vkDestroyRenderPass)                    \
+	SH_VK_DEVICE_FUNCTION(vkDestroySampler)                       \
+	SH_VK_DEVICE_FUNCTION(vkDestroySemaphore)                     \
+	SH_VK_DEVICE_FUNCTION(vkDestroyShaderModule)                  \
+	SH_VK_DEVICE_FUNCTION(vkDestroySwapchainKHR)                  \
+	SH_VK_DEVICE_FUNCTION(vkDeviceWaitIdle)                       \
+	SH_VK_DEVICE_FUNCTION(vkEndCommandBuffer)                     \
+	SH_VK_DEVICE_FUNCTION(vkFlushMappedMemoryRanges)              \
+	SH_VK_DEVICE_FUNCTION(vkFreeCommandBuffers)                   \
+	SH_VK_DEVICE_FUNCTION(vkFreeDescriptorSets)                   \
+	SH_VK_DEVICE_FUNCTION(vkFreeMemory)                           \
+	SH_VK_DEVICE_FUNCTION(vkGetBufferMemoryRequirements)          \
+	SH_VK_DEVICE_FUNCTION(vkGetDeviceQueue)                       \
+	SH_VK_DEVICE_FUNCTION(vkGetFenceStatus)                       \
+	SH_VK_DEVICE_FUNCTION(vkGetImageMemoryRequirements)           \
+	SH_VK_DEVICE_FUNCTION(vkGetImageSubresourceLayout)            \
+	SH_VK_DEVICE_FUNCTION(vkGetQueryPoolResults)                  \
+	SH_VK_DEVICE_FUNCTION(vkGetSemaphoreCounterValue)             \
+	SH_VK_DEVICE_FUNCTION(vkGetSwapchainImagesKHR)                \
+	SH_VK_DEVICE_FUNCTION(vkInvalidateMappedMemoryRanges)         \
+	SH_VK_DEVICE_FUNCTION(vkMapMemory)                            \
+	SH_VK_DEVICE_FUNCTION(vkQueuePresentKHR)                      \
+	SH_VK_DEVICE_FUNCTION(vkQueueSubmit)                          \
+	SH_VK_DEVICE_FUNCTION(vkQueueWaitIdle)                        \
+	SH_VK_DEVICE_FUNCTION(vkResetCommandBuffer)                   \
+	SH_VK_DEVICE_FUNCTION(vkResetFences)                          \
+	SH_VK_DEVICE_FUNCTION(vkUnmapMemory)                          \
+	SH_VK_DEVICE_FUNCTION(vkUpdateDescriptorSets)                 \
+	SH_VK_DEVICE_FUNCTION(vkUpdateDescriptorSetWithTemplate)      \
+	SH_VK_DEVICE_FUNCTION(vkWaitForFences)                        \
+	SH_VK_DEVICE_FUNCTION(vkWaitSemaphores)
+
+#define SH_VK_DEVICE_DISPATCH_TABLE_MEMBER(function_name) PFN_##function_name function_name;
+
+#define SH_MAX_DEVICE_DISPATCH_TABLE_COUNT 16
+
+/**
+ * @brief Device level function pointers, loaded with vkGetDeviceProcAddr.
+ * 
+ * When shvulkan is built with SH_VULKAN_DEVICE_DISPATCH, every sh* function calls device level Vulkan functions
+ * through the table of the device owning its device, queue or command buffer argument, instead of the loader exports,
+ * skipping the loader trampoline. Tables are registered per device by shLoadDeviceDispatchTable, objects of devices
+ * without a table go through the loader exports, so several devices (ShVkMultiDevice) can be used at the same time.
+ * Commands recorded between shBeginCommandBuffer and shEndCommandBuffer use the table resolved once by
+ * shBeginCommandBuffer, other calls find it with a hash lookup.
+ * Without SH_VULKAN_DEVICE_DISPATCH the tables can still be loaded, but sh* functions ignore them.
+ * 
+ * The dynamic rendering functions are not loader exports before Vulkan 1.3, they are only loaded by
+ * shLoadDeviceDispatchTable and are `VK_NULL_HANDLE` in tables of devices without dynamic rendering.
+ */
+typedef struct ShVkDeviceDispatchTable {
+	SH_VK_DEVICE_DISPATCH_FUNCTIONS(SH_VK_DEVICE_DISPATCH_TABLE_MEMBER)
+	PFN_vkCmdBeginRendering vkCmdBeginRendering; ///< vkCmdBeginRendering or vkCmdBeginRenderingKHR, `VK_NULL_HANDLE` if unsupported.
+	PFN_vkCmdEndRendering   vkCmdEndRendering;   ///< vkCmdEndRendering or vkCmdEndRenderingKHR, `VK_NULL_HANDLE` if unsupported.
+} ShVkDeviceDispatchTable;
+
+/**
+ * @brief Loads the device level functions of a device and registers the table for that device.
+ * 
+ * Functions the device does not expose (e.g. swapchain functions without VK_KHR_swapchain) keep the loader export.
+ * On devices older than Vulkan 1.3, vkCmdBeginRendering and vkCmdEndRendering are loaded from their
+ * VK_KHR_dynamic_rendering aliases, and stay `VK_NULL_HANDLE` if neither is exposed. The table must stay valid until
+ * shUnloadDeviceDispatchTable or shDestroyDevice.
+ * 
+ * Loading is a setup step and is not synchronized: call it right after creating the device, before other threads
+ * use the device or any other device, and never while command buffers are being recorded.
+ * 
+ * @param device Valid Vulkan device.
+ * @param[out] p_dispatch_table Valid pointer to the ShVkDeviceDispatchTable structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shLoadDeviceDispatchTable(
+	VkDevice                 device,
+	ShVkDeviceDispatchTable* p_dispatch_table
+);
+
+/**
+ * @brief Unregisters the dispatch table of a device, its objects go back to the loader exports.
+ * 
+ * Called by shDestroyDevice. Call it before destroying a device with vkDestroyDevice. Like loading, unloading is a
+ * teardown step that must not overlap with sh* calls from other threads.
+ * 
+ * @param device Valid Vulkan device.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shUnloadDeviceDispatchTable(
+	VkDevice device
+);
+
+/**
+ * @brief Retrieves the dispatch table of the device owning a dispatchable handle.
+ * 
+ * Devices, queues and command buffers of a device share the dispatch key the loader interface requires in the first
+ * word of every dispatchable object, so any of them resolves the device table. The command buffer being recorded by
+ * the calling thread resolves without a lookup.
+ * 
+ * @param dispatchable_handle Valid VkDevice, VkQueue or VkCommandBuffer, `VK_NULL_HANDLE` selects the loader table.
+ * 
+ * @return Pointer to the registered table, or to the loader table when the device has none.
+ */
+extern ShVkDeviceDispatchTable* shGetDeviceDispatchTable(
+	const void* dispatchable_handle
+);
+
+/**
+ * @brief Names a device level function as called by the library, dispatched on its device, queue or command buffer.
+ * 
+ * Used by the inline command wrappers of this header, so they dispatch like the functions in shVulkan.c.
+ */
+#ifdef SH_VULKAN_DEVICE_DISPATCH
+
+#ifdef _MSC_VER
+#define SH_VK_THREAD_LOCAL __declspec(thread)
+#else
+#define SH_VK_THREAD_LOCAL __thread
+#endif//_MSC_VER
+
+/**
+ * @brief Command buffer recorded by the calling thread and the table of its device.
+ * 
+ * Set by shBeginCommandBuffer and reset by shEndCommandBuffer, so that the recorded commands reach the table without
+ * looking it up.
+ */
+typedef struct ShVkRecordingDispatch {
+	VkCommandBuffer          cmd_buffer;       ///< Command buffer being recorded, `VK_NULL_HANDLE` outside of recording.
+	ShVkDeviceDispatchTable* p_dispatch_table; ///< Dispatch table of the device owning cmd_buffer.
+} ShVkRecordingDispatch;
+
+extern SH_VK_THREAD_LOCAL ShVkRecordingDispatch sh_vk_recording_dispatch;
+
+#define SH_VK_DEVICE_CALL(function_name, dispatchable_handle)\
+	(((const void*)(dispatchable_handle) == (const void*)sh_vk_recording_dispatch.cmd_buffer) ?\
+		sh_vk_recording_dispatch.p_dispatch_table : shGetDeviceDispatchTable(dispatchable_handle))->function_name
+#else
+#define SH_VK_DEVICE_CALL(function_name, dispatchable_handle) function_name
+#endif//SH_VULKAN_DEVICE_DISPATCH
+
+
 #define SH_MAX_STACK_VALIDATION_LAYER_COUNT 32
 
 #define SH_MAX_STACK_QUEUE_FAMILY_COUNT          32
@@ -216,6 +589,7 @@ extern uint8_t shGetQueueFamilySurfaceSupport(
  * 
  * This function selects a Vulkan physical device based on specified requirements such as queue support, 
  * surface capabilities, and required device features. Then it retrieves vital information about the GPU.
+ * The selected device is the best one ranked by shRankPhysicalDevices, without benchmarks.
  * 
  * @param instance Valid Vulkan instance.
  * @param surface Valid surface if presentation support is required, otherwise it can be set as `VK_NULL_HANDLE`.
@@ -237,6 +611,82 @@ extern uint8_t shSelectPhysicalDevice(
 	VkPhysicalDeviceMemoryProperties* p_physical_device_memory_properties
 );
 
+/**
+ * @brief Computes the static score of a physical device.
+ * 
+ * The score orders devices by type first (discrete, integrated, virtual, cpu), then by the size of their
+ * device local heaps, then by the number of dedicated compute-only and transfer-only queue families.
+ * 
+ * @param physical_device Valid Vulkan physical device.
+ * @param p_score Valid destination pointer to the score, higher is better.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shScorePhysicalDevice(
+	VkPhysicalDevice physical_device,
+	uint64_t*        p_score
+);
+
+
+
+#define SH_PHYSICAL_DEVICE_BENCHMARK_BUFFER_SIZE     (32 * 1024 * 1024)
+#define SH_PHYSICAL_DEVICE_BENCHMARK_ITERATION_COUNT 8
+
+/**
+ * @brief Results of physical device benchmarks, keyed on the device UUID.
+ * 
+ * The structure holds no pointers, so it can be written to disk and reloaded to skip the benchmarks on later runs.
+ */
+typedef struct ShVkPhysicalDeviceBenchmarkCache {
+	uint32_t device_count;                                                    ///< Number of benchmarked devices.
+	uint8_t  device_uuids   [SH_MAX_STACK_PHYSICAL_DEVICE_COUNT][VK_UUID_SIZE]; ///< deviceUUID of each benchmarked device.
+	float    copy_bandwidths[SH_MAX_STACK_PHYSICAL_DEVICE_COUNT];               ///< Measured device local copy bandwidth, in GB/s.
+} ShVkPhysicalDeviceBenchmarkCache;
+
+/**
+ * @brief Measures the device local copy bandwidth of a physical device.
+ * 
+ * This function creates a temporary logical device, times SH_PHYSICAL_DEVICE_BENCHMARK_ITERATION_COUNT copies of
+ * SH_PHYSICAL_DEVICE_BENCHMARK_BUFFER_SIZE bytes with timestamp queries, then releases everything. Results already
+ * present in the cache for the same device UUID are returned without running the benchmark.
+ * 
+ * @param physical_device Valid Vulkan physical device.
+ * @param p_benchmark_cache Valid pointer to the ShVkPhysicalDeviceBenchmarkCache structure.
+ * @param p_copy_bandwidth Valid destination pointer to the copy bandwidth, in GB/s.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shBenchmarkPhysicalDevice(
+	VkPhysicalDevice                  physical_device,
+	ShVkPhysicalDeviceBenchmarkCache* p_benchmark_cache,
+	float*                            p_copy_bandwidth
+);
+
+/**
+ * @brief Lists the suitable physical devices from best to worst.
+ * 
+ * This function keeps the devices satisfying the queue requirements (and presentation support when surface is valid)
+ * and sorts them by shScorePhysicalDevice. When p_benchmark_cache is valid, devices are sorted by their measured
+ * copy bandwidth instead, the static score being used to break ties.
+ * 
+ * @param instance Valid Vulkan instance.
+ * @param surface Valid surface if presentation support is required, otherwise it can be set as `VK_NULL_HANDLE`.
+ * @param requirements Queue family requirements (VkQueueFlags).
+ * @param p_benchmark_cache Optional pointer to the ShVkPhysicalDeviceBenchmarkCache structure, enables benchmark mode.
+ * @param p_physical_device_count Valid destination pointer to the number of suitable physical devices.
+ * @param p_physical_devices Valid destination pointer to an array of SH_MAX_STACK_PHYSICAL_DEVICE_COUNT physical devices.
+ * 
+ * @return 1 if at least a suitable device is found, 0 otherwise.
+ */
+extern uint8_t shRankPhysicalDevices(
+	VkInstance                        instance,
+	VkSurfaceKHR                      surface,
+	VkQueueFlags                      requirements,
+	ShVkPhysicalDeviceBenchmarkCache* p_benchmark_cache,
+	uint32_t*                         p_physical_device_count,
+	VkPhysicalDevice*                 p_physical_devices
+);
+
 /**
  * @brief Queries if a queue family supports presenting to a surface.
  * 
@@ -303,12 +753,17 @@ extern uint8_t shQueryForDeviceQueueInfo(
  * This function creates a Vulkan logical device with specified extensions, queue creation info, and 
  * other configurations.
  * 
+ * The device is registered until shDestroyDevice, with its dynamic rendering functions resolved once for
+ * shBeginRendering and shEndRendering. Like shLoadDeviceDispatchTable, creating and destroying devices must not
+ * overlap with sh* calls from other threads.
+ * 
  * @param physical_device Valid Vulkan physical device.
  * @param p_device Valid destination pointer to the newly created VkDevice.
  * @param extension_count Number of Vulkan extensions to enable.
  * @param pp_extension_names Valid pointer to extension names to enable.
  * @param device_queue_count Number of device queues to create.
  * @param p_device_queue_infos Valid pointer to an array of VkDeviceQueueCreateInfo structures.
+ * @param p_next Optional structure chain appended to VkDeviceCreateInfo (e.g. VkPhysicalDeviceVulkan12Features), can be `VK_NULL_HANDLE`.
  * 
  * @return 1 if the logical device is created successfully, 0 otherwise.
  */
@@ -318,13 +773,88 @@ extern uint8_t shSetLogicalDevice(
 	uint32_t                 extension_count,
 	char**                   pp_extension_names,
 	uint32_t                 device_queue_count,
-	VkDeviceQueueCreateInfo* p_device_queue_infos
+	VkDeviceQueueCreateInfo* p_device_queue_infos,
+	void*                    p_next
+);
+
+/**
+ * @brief Device features, chained as VkPhysicalDeviceFeatures2 -> Vulkan11 -> Vulkan12 -> Vulkan13.
+ * 
+ * Used for the required, wanted and enabled sets of shNegotiateDeviceFeatures. Set fields to VK_TRUE after
+ * shInitDeviceFeatures. The chain points inside the structure, so it must not be copied or moved once initialized.
+ * 
+ * Performance relevant fields: features.features.shaderInt64, vulkan11.storageBuffer16BitAccess,
+ * vulkan12.storageBuffer8BitAccess, vulkan12.shaderInt8, vulkan12.shaderFloat16, vulkan12.timelineSemaphore,
+ * vulkan12.bufferDeviceAddress, vulkan12.descriptorIndexing, vulkan13.synchronization2, vulkan13.dynamicRendering.
+ */
+typedef struct ShVkDeviceFeatures {
+	uint32_t                         api_version; ///< Effective api version, structures above it are left out of the chain.
+	VkPhysicalDeviceFeatures2        features;    ///< Vulkan 1.0 features, head of the chain.
+	VkPhysicalDeviceVulkan11Features vulkan11;    ///< Vulkan 1.1 features.
+	VkPhysicalDeviceVulkan12Features vulkan12;    ///< Vulkan 1.2 features.
+	VkPhysicalDeviceVulkan13Features vulkan13;    ///< Vulkan 1.3 features.
+} ShVkDeviceFeatures;
+
+/**
+ * @brief Zeroes a ShVkDeviceFeatures structure and links its chain.
+ * 
+ * @param api_version Effective api version (the lower of the instance and device api versions), or VK_API_VERSION_1_3 for request sets.
+ * @param[out] p_features Valid pointer to the ShVkDeviceFeatures structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shInitDeviceFeatures(
+	uint32_t            api_version,
+	ShVkDeviceFeatures* p_features
+);
+
+/**
+ * @brief Queries the features supported by a physical device with vkGetPhysicalDeviceFeatures2.
+ * 
+ * Structures are chained up to the lower of the instance and device api versions, a device api version above the
+ * instance one does not make newer structures usable. Instances below 1.1 only query the Vulkan 1.0 features.
+ * 
+ * @param physical_device Valid Vulkan physical device.
+ * @param instance_api_version Api version the instance was created with (the api_version of shCreateInstance).
+ * @param[out] p_features Valid pointer to the ShVkDeviceFeatures structure, initialized by this function.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shGetPhysicalDeviceFeatures(
+	VkPhysicalDevice    physical_device,
+	uint32_t            instance_api_version,
+	ShVkDeviceFeatures* p_features
+);
+
+/**
+ * @brief Computes the features to enable on a logical device.
+ * 
+ * Supported features are queried once. Enabled features are the required ones plus the wanted ones which are
+ * supported. Pass `&p_enabled->features` as the p_next parameter of shSetLogicalDevice, then keep p_enabled
+ * around so other subsystems can check which fast paths are available.
+ * 
+ * @param physical_device Valid Vulkan physical device.
+ * @param instance_api_version Api version the instance was created with, see shGetPhysicalDeviceFeatures.
+ * @param p_required Optional pointer to features which must be supported, can be `VK_NULL_HANDLE`.
+ * @param p_wanted Optional pointer to features enabled only when supported, can be `VK_NULL_HANDLE`.
+ * @param[out] p_enabled Valid pointer to the ShVkDeviceFeatures structure, initialized by this function.
+ * 
+ * @return 1 if successful, 0 otherwise or if a required feature is not supported.
+ */
+extern uint8_t shNegotiateDeviceFeatures(
+	VkPhysicalDevice    physical_device,
+	uint32_t            instance_api_version,
+	ShVkDeviceFeatures* p_required,
+	ShVkDeviceFeatures* p_wanted,
+	ShVkDeviceFeatures* p_enabled
 );
 
 /**
  * @brief Retrieves the Vulkan queues from a device.
  * 
  * This function retrieves the Vulkan queues from a logical device based on specified queue family indices.
+ * A family index repeated in the array retrieves the next queue of that family, the family must have been
+ * created with enough queues.
  * 
  * @param device Valid Vulkan device.
  * @param queue_count Number of queues to retrieve.
@@ -340,6 +870,65 @@ extern uint8_t shGetDeviceQueues(
 	VkQueue*  p_queues
 );
 
+typedef enum ShVkQueueRole {
+	SH_QUEUE_ROLE_GRAPHICS = 0,
+	SH_QUEUE_ROLE_COMPUTE  = 1,
+	SH_QUEUE_ROLE_TRANSFER = 2,
+	SH_QUEUE_ROLE_COUNT    = 3
+} ShVkQueueRole;
+
+/**
+ * @brief Queue families and queues chosen for graphics, async compute and transfer work.
+ * 
+ * Roles are indexed with ShVkQueueRole. Roles which could not get a queue of their own share the queue of another
+ * role, in which case the queue family indices and queue indices are equal. device_queue_infos point to
+ * queue_priorities, so the structure must not be moved between shQueryQueueTopology and shSetLogicalDevice.
+ */
+typedef struct ShVkQueueTopology {
+	uint32_t                queue_family_indices   [SH_QUEUE_ROLE_COUNT];                      ///< Queue family of each role, `VK_QUEUE_FAMILY_IGNORED` if unsupported.
+	uint32_t                queue_indices          [SH_QUEUE_ROLE_COUNT];                      ///< Index of the queue inside its family.
+	uint8_t                 dedicated              [SH_QUEUE_ROLE_COUNT];                      ///< 1 when compute has no graphics support, or transfer has neither graphics nor compute.
+	VkQueue                 queues                 [SH_QUEUE_ROLE_COUNT];                      ///< Queues, retrieved by shGetQueueTopologyQueues.
+	uint32_t                device_queue_info_count;                                           ///< Number of queue create infos to pass to shSetLogicalDevice.
+	VkDeviceQueueCreateInfo device_queue_infos     [SH_QUEUE_ROLE_COUNT];                      ///< Queue create infos to pass to shSetLogicalDevice.
+	float                   queue_priorities       [SH_QUEUE_ROLE_COUNT][SH_QUEUE_ROLE_COUNT]; ///< Priorities referenced by device_queue_infos.
+} ShVkQueueTopology;
+
+/**
+ * @brief Selects the queue families for graphics, async compute and transfer work.
+ * 
+ * Compute prefers a family without graphics support, transfer prefers a family supporting neither graphics nor
+ * compute (a DMA engine). A role without a dedicated family gets a separate queue in a shared family when the
+ * family exposes enough queues, otherwise it shares the queue of the previous role. The graphics family must
+ * support presentation when surface is valid.
+ * 
+ * @param physical_device Valid Vulkan physical device.
+ * @param surface Valid surface if presentation support is required, otherwise it can be set as `VK_NULL_HANDLE`.
+ * @param p_queue_priorities Valid pointer to SH_QUEUE_ROLE_COUNT priorities, indexed with ShVkQueueRole.
+ * @param[out] p_topology Valid pointer to the ShVkQueueTopology structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shQueryQueueTopology(
+	VkPhysicalDevice   physical_device,
+	VkSurfaceKHR       surface,
+	float*             p_queue_priorities,
+	ShVkQueueTopology* p_topology
+);
+
+/**
+ * @brief Retrieves the queues of a queue topology.
+ * 
+ * @param device Valid Vulkan device created with the device_queue_infos of p_topology.
+ * @param[in,out] p_topology Valid pointer to the ShVkQueueTopology structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shGetQueueTopologyQueues(
+	VkDevice           device,
+	ShVkQueueTopology* p_topology
+);
+
 //TODO
 extern uint8_t shCheckSupportedDeviceColorFormat(
 	VkPhysicalDevice physical_device,
@@ -376,19 +965,54 @@ extern uint8_t shFindSupportedDeviceColorFormats(
 	uint32_t*               p_channels_types
 );
 
+/**
+ * @brief Present mode selection policy.
+ * 
+ * Values 0 and 1 match the former vsync flag of shCreateSwapchain.
+ */
+typedef enum ShVkPresentPolicy {
+	SH_PRESENT_POLICY_LOW_LATENCY        = 0, ///< `VK_PRESENT_MODE_MAILBOX_KHR`, then `VK_PRESENT_MODE_IMMEDIATE_KHR`, then `VK_PRESENT_MODE_FIFO_KHR`.
+	SH_PRESENT_POLICY_POWER_SAVING       = 1, ///< `VK_PRESENT_MODE_FIFO_KHR`, frame rate capped to the refresh rate.
+	SH_PRESENT_POLICY_TEAR_FREE_UNCAPPED = 2  ///< `VK_PRESENT_MODE_MAILBOX_KHR`, then `VK_PRESENT_MODE_FIFO_KHR`, never tears.
+} ShVkPresentPolicy;
+
+/**
+ * @brief Selects a surface present mode according to a policy.
+ * 
+ * `VK_PRESENT_MODE_FIFO_KHR` is the fallback of every policy, since it is always supported.
+ * 
+ * @param physical_device Valid Vulkan physical device.
+ * @param surface Valid Vulkan surface.
+ * @param present_policy Present mode selection policy.
+ * @param p_present_mode Valid destination pointer to the selected present mode.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shSelectPresentMode(
+	VkPhysicalDevice  physical_device,
+	VkSurfaceKHR      surface,
+	ShVkPresentPolicy present_policy,
+	VkPresentModeKHR* p_present_mode
+);
+
 /**
  * @brief Creates a Vulkan swapchain.
  * 
  * This function sets up a Vulkan swapchain with the specified surface, image format, and other parameters.
  * 
+ * When swapchain_image_count is 0 the image count is chosen for the selected present mode: one image more than
+ * the surface minimum (at least 3) with `VK_PRESENT_MODE_MAILBOX_KHR`, so that a frame can always be rendered
+ * while another is queued, and the surface minimum (at least 2) otherwise, which keeps the FIFO queue short.
+ * 
  * @param device Valid Vulkan device.
  * @param physical_device Valid Vulkan physical device.
  * @param surface Valid Vulkan surface.
  * @param image_format Format of the images in the swapchain.
  * @param p_image_format Valid destination pointer to the format of the swapchain images.
- * @param swapchain_image_count Number of images in the swapchain.
+ * @param swapchain_image_count Number of images in the swapchain, 0 to choose it from the present mode.
  * @param image_sharing_mode Sharing mode for the swapchain images.
- * @param vsync Flag to enable (1) or disable (0) V-Sync.
+ * @param present_policy Present mode selection policy, see shSelectPresentMode.
+ * @param old_swapchain Swapchain being replaced, can be `VK_NULL_HANDLE`. It is retired but not destroyed, see shRecreateSwapchain.
  * @param p_swapchain_image_count Valid destination pointer to the number of swapchain images.
  * @param p_swapchain Valid destination pointer to the newly created VkSwapchainKHR.
  * 
@@ -404,7 +1028,8 @@ extern uint8_t shCreateSwapchain(
 	VkFormat*                p_image_format,
 	uint32_t                 swapchain_image_count,
 	VkSharingMode            image_sharing_mode,
-	uint8_t                  vsync,
+	ShVkPresentPolicy        present_policy,
+	VkSwapchainKHR           old_swapchain,
 	uint32_t*                p_swapchain_image_count,
 	VkSwapchainKHR*          p_swapchain
 );
@@ -475,6 +1100,38 @@ extern uint8_t shCreateImageView(
 	VkImageView*          p_image_view
 );
 
+/**
+ * @brief Creates a Vulkan image view of a range of mip levels and array layers.
+ * 
+ * Use VK_IMAGE_VIEW_TYPE_2D_ARRAY to bind a texture array once, VK_IMAGE_VIEW_TYPE_CUBE with 6 layers
+ * or VK_IMAGE_VIEW_TYPE_CUBE_ARRAY with a multiple of 6 layers for images created cube compatible.
+ * 
+ * @param device Valid Vulkan device.
+ * @param image Valid Vulkan image.
+ * @param view_type Type of the image view.
+ * @param image_aspect Aspect flags of the image (e.g., color, depth).
+ * @param base_mip_level First mip level of the view.
+ * @param mip_levels Number of mip levels of the view.
+ * @param base_array_layer First array layer of the view.
+ * @param layer_count Number of array layers of the view.
+ * @param format Format of the image.
+ * @param p_image_view Valid destination pointer to the newly created VkImageView.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shCreateLayeredImageView(
+	VkDevice              device,
+	VkImage               image,
+	VkImageViewType       view_type,
+	VkImageAspectFlags    image_aspect,
+	uint32_t              base_mip_level,
+	uint32_t              mip_levels,
+	uint32_t              base_array_layer,
+	uint32_t              layer_count,
+	VkFormat              format,
+	VkImageView*          p_image_view
+);
+
 /**
  * @brief Creates image views for swapchain images.
  * 
@@ -862,12 +1519,21 @@ extern uint8_t shEndCommandBuffer(
  * 
  * @return 1 if successful, 0 otherwise.
  */
-extern uint8_t shCmdDispatch(
+SH_INLINE uint8_t shCmdDispatch(
 	VkCommandBuffer cmd_buffer,
 	uint32_t        group_count_x,
 	uint32_t        group_count_y,
 	uint32_t        group_count_z
-);
+) {
+	shVkArgError(cmd_buffer    == VK_NULL_HANDLE, "invalid command buffer memory", return 0);
+	shVkArgError(group_count_x == 0,    "invalid x group count",         return 0);
+	shVkArgError(group_count_y == 0,    "invalid y group count",         return 0);
+	shVkArgError(group_count_z == 0,    "invalid z group count",         return 0);
+
+	SH_VK_DEVICE_CALL(vkCmdDispatch, cmd_buffer)(cmd_buffer, group_count_x, group_count_y, group_count_z);
+
+	return 1;
+}
 
 /**
  * @brief Submits command buffers to a Vulkan queue.
@@ -948,24 +1614,58 @@ extern uint8_t shCreateSemaphores(
 );
 
 /**
- * @brief Destroys Vulkan fences.
+ * @brief Creates a Vulkan timeline semaphore.
  * 
- * This function destroys a specified number of Vulkan fences.
+ * The device must have been created with the vulkan12.timelineSemaphore feature enabled, see shNegotiateDeviceFeatures.
  * 
  * @param device Valid Vulkan device.
- * @param fence_count Number of fences to destroy.
- * @param p_fences Valid pointer to an array of Vulkan fences to destroy.
+ * @param initial_value Initial counter value.
+ * @param p_semaphore Valid destination pointer to the newly created Vulkan semaphore.
  * 
  * @return 1 if successful, 0 otherwise.
  */
-extern uint8_t shDestroyFences(
-	VkDevice device,
-	uint32_t fence_count,
-	VkFence* p_fences
+extern uint8_t shCreateTimelineSemaphore(
+	VkDevice     device,
+	uint64_t     initial_value,
+	VkSemaphore* p_semaphore
 );
 
 /**
- * @brief Destroys Vulkan semaphores.
+ * @brief Waits for a timeline semaphore to reach a value.
+ * 
+ * @param device Valid Vulkan device.
+ * @param semaphore Valid Vulkan timeline semaphore.
+ * @param value Counter value to wait for.
+ * @param timeout_ns Timeout in nanoseconds.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shWaitTimelineSemaphore(
+	VkDevice    device,
+	VkSemaphore semaphore,
+	uint64_t    value,
+	uint64_t    timeout_ns
+);
+
+/**
+ * @brief Destroys Vulkan fences.
+ * 
+ * This function destroys a specified number of Vulkan fences.
+ * 
+ * @param device Valid Vulkan device.
+ * @param fence_count Number of fences to destroy.
+ * @param p_fences Valid pointer to an array of Vulkan fences to destroy.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shDestroyFences(
+	VkDevice device,
+	uint32_t fence_count,
+	VkFence* p_fences
+);
+
+/**
+ * @brief Destroys Vulkan semaphores.
  * 
  * This function destroys a specified number of Vulkan semaphores.
  * 
@@ -1139,13 +1839,25 @@ extern uint8_t shEndRenderpass(
  * 
  * @return 1 if successful, 0 otherwise.
  */
-extern uint8_t shDraw(
+SH_INLINE uint8_t shDraw(
 	VkCommandBuffer graphics_cmd_buffer,
 	uint32_t        vertex_count,
 	uint32_t        first_vertex,
 	uint32_t        instance_count,
 	uint32_t        first_instance
-);
+) {
+	shVkArgError(graphics_cmd_buffer == VK_NULL_HANDLE, "invalid command buffer memory", return 0);
+
+	SH_VK_DEVICE_CALL(vkCmdDraw, graphics_cmd_buffer)(
+		graphics_cmd_buffer,
+		vertex_count,
+		instance_count,
+		first_vertex,
+		first_instance
+	);
+
+	return 1;
+}
 
 /**
  * @brief Records an indexed draw command into a Vulkan command buffer.
@@ -1161,14 +1873,27 @@ extern uint8_t shDraw(
  * 
  * @return 1 if successful, 0 otherwise.
  */
-extern uint8_t shDrawIndexed(
+SH_INLINE uint8_t shDrawIndexed(
 	VkCommandBuffer graphics_cmd_buffer,
 	uint32_t        index_count,
 	uint32_t        instance_count,
 	uint32_t        first_index,
 	int32_t         vertex_offset,
 	uint32_t        first_instance
-);
+) {
+	shVkArgError(graphics_cmd_buffer == VK_NULL_HANDLE, "invalid command buffer memory", return 0);
+
+	SH_VK_DEVICE_CALL(vkCmdDrawIndexed, graphics_cmd_buffer)(
+		graphics_cmd_buffer, 
+		index_count,
+		instance_count,
+		first_index,
+		vertex_offset,
+		first_instance
+	);
+
+	return 1;
+}
 
 /**
  * @brief Presents an image from a Vulkan swapchain to the screen.
@@ -1294,14 +2019,35 @@ extern uint8_t shAllocateBufferMemory(
  * 
  * @return 1 if successful, 0 otherwise.
  */
-extern uint8_t shCopyBuffer(
+SH_INLINE uint8_t shCopyBuffer(
 	VkCommandBuffer transfer_cmd_buffer,
 	VkBuffer        src_buffer,
 	uint32_t        src_offset,
 	uint32_t        dst_offset,
 	uint64_t        size,
 	VkBuffer        dst_buffer
-);
+) {
+	shVkArgError(transfer_cmd_buffer == VK_NULL_HANDLE, "invalid command buffer",     return 0);
+	shVkArgError(src_buffer          == VK_NULL_HANDLE, "invalid source buffer",      return 0);
+	shVkArgError(size                == 0,              "invalid copy size",          return 0);
+	shVkArgError(dst_buffer          == VK_NULL_HANDLE, "invalid destination buffer", return 0);
+
+	VkBufferCopy region = {
+		.srcOffset = src_offset,
+		.dstOffset = dst_offset,
+		.size      = size
+	};
+
+	SH_VK_DEVICE_CALL(vkCmdCopyBuffer, transfer_cmd_buffer)(
+		transfer_cmd_buffer, 
+		src_buffer, 
+		dst_buffer, 
+		1, 
+		&region
+	);
+
+	return 1;
+}
 
 #define SH_MAX_STACK_BUFFER_REGION_COUNT 256
 
@@ -1341,6 +2087,188 @@ uint8_t shCopyImage(
 	VkImage            dst_image
 );
 
+/**
+ * @brief Copies regions between two images.
+ * 
+ * @param transfer_cmd_buffer Valid Vulkan command buffer for the copy operation.
+ * @param src_image Valid Vulkan source image.
+ * @param src_image_layout Layout of the source image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL or VK_IMAGE_LAYOUT_GENERAL.
+ * @param region_count Number of regions to copy.
+ * @param p_regions Valid pointer to an array of region_count VkImageCopy structures.
+ * @param dst_image_layout Layout of the destination image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL or VK_IMAGE_LAYOUT_GENERAL.
+ * @param dst_image Valid Vulkan destination image.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shCopyImageRegions(
+	VkCommandBuffer    transfer_cmd_buffer,
+	VkImage            src_image,
+	VkImageLayout      src_image_layout,
+	uint32_t           region_count,
+	const VkImageCopy* p_regions,
+	VkImageLayout      dst_image_layout,
+	VkImage            dst_image
+);
+
+/**
+ * @brief Copies a range of mip levels and array layers between two images of the same size, one region per mip level.
+ * 
+ * The source must be in VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL and the destination in VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL.
+ * 
+ * @param transfer_cmd_buffer Valid Vulkan command buffer for the copy operation.
+ * @param width Width of mip level 0.
+ * @param height Height of mip level 0.
+ * @param depth Depth of mip level 0, 1 for 2D images.
+ * @param subresource_range Aspect mask, mip levels and array layers to copy, VK_REMAINING_* values are not accepted.
+ * @param src_image Valid Vulkan source image.
+ * @param dst_image Valid Vulkan destination image.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shCopyImageSubresourceRange(
+	VkCommandBuffer         transfer_cmd_buffer,
+	uint32_t                width,
+	uint32_t                height,
+	uint32_t                depth,
+	VkImageSubresourceRange subresource_range,
+	VkImage                 src_image,
+	VkImage                 dst_image
+);
+
+/**
+ * @brief Copies buffer data to regions of an image.
+ * 
+ * Each region selects a mip level, a range of array layers, an image offset and extent, and the buffer offset, row length and image height of its texels.
+ * 
+ * @param transfer_cmd_buffer Valid Vulkan command buffer for the copy operation.
+ * @param src_buffer Valid Vulkan source buffer.
+ * @param region_count Number of regions to copy.
+ * @param p_regions Valid pointer to an array of region_count VkBufferImageCopy structures.
+ * @param dst_image_layout Layout of the destination image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL or VK_IMAGE_LAYOUT_GENERAL.
+ * @param dst_image Valid Vulkan destination image.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shCopyBufferToImage(
+	VkCommandBuffer          transfer_cmd_buffer,
+	VkBuffer                 src_buffer,
+	uint32_t                 region_count,
+	const VkBufferImageCopy* p_regions,
+	VkImageLayout            dst_image_layout,
+	VkImage                  dst_image
+);
+
+/**
+ * @brief Copies regions of an image to buffer memory.
+ * 
+ * @param transfer_cmd_buffer Valid Vulkan command buffer for the copy operation.
+ * @param src_image Valid Vulkan source image.
+ * @param src_image_layout Layout of the source image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL or VK_IMAGE_LAYOUT_GENERAL.
+ * @param region_count Number of regions to copy.
+ * @param p_regions Valid pointer to an array of region_count VkBufferImageCopy structures.
+ * @param dst_buffer Valid Vulkan destination buffer.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shCopyImageToBuffer(
+	VkCommandBuffer          transfer_cmd_buffer,
+	VkImage                  src_image,
+	VkImageLayout            src_image_layout,
+	uint32_t                 region_count,
+	const VkBufferImageCopy* p_regions,
+	VkBuffer                 dst_buffer
+);
+
+#define SH_MAX_TEXTURE_UPLOAD_COUNT 256
+
+/**
+ * @brief Texels uploaded by shCmdUploadTextures to a region of one mip level of an image.
+ * 
+ * Zero initialized optional fields upload tightly packed texels to a whole mip level. The size read from p_texels is
+ * derived from the region extent, the layer count and the buffer layout, see shGetTextureUploadStagingSize.
+ */
+typedef struct ShVkTextureUpload {
+	VkImage            image;               ///< Destination image.
+	VkImageAspectFlags aspect_mask;         ///< Uploaded aspect, usually VK_IMAGE_ASPECT_COLOR_BIT.
+	uint32_t           mip_level;           ///< Destination mip level.
+	uint32_t           base_array_layer;    ///< First destination array layer.
+	uint32_t           layer_count;         ///< Number of destination array layers, the texels of each layer follow the previous one.
+	VkOffset3D         image_offset;        ///< Offset of the region in the mip level.
+	uint32_t           width;               ///< Width of the region.
+	uint32_t           height;              ///< Height of the region.
+	uint32_t           depth;               ///< Depth of the region, 1 for 2D images.
+	VkExtent3D         level_extent;        ///< Extent of the mip level, all zero when the region covers the whole level.
+	VkImageLayout      current_layout;      ///< Layout of the subresources before the upload, used when the region does not cover the whole level.
+	uint32_t           buffer_row_length;   ///< Texels per row in p_texels, 0 when rows are tightly packed.
+	uint32_t           buffer_image_height; ///< Rows per depth slice or layer in p_texels, 0 when tightly packed.
+	uint32_t           block_width;         ///< Width of a compressed texel block, 0 for uncompressed formats.
+	uint32_t           block_height;        ///< Height of a compressed texel block, 0 for uncompressed formats.
+	uint32_t           texel_size;          ///< Size in bytes of a texel, or of a block for compressed formats.
+	const void*        p_texels;            ///< Valid pointer to the texels.
+} ShVkTextureUpload;
+
+/**
+ * @brief Retrieves the staging buffer size of a batch of texture uploads and the offset of each upload.
+ * 
+ * The size of an upload covers the texels read by vkCmdCopyBufferToImage: every row of every depth slice and layer,
+ * laid out with buffer_row_length and buffer_image_height, up to the last texel of the region.
+ * Offsets are aligned to the texel size and to 4 bytes, as required by vkCmdCopyBufferToImage.
+ * 
+ * @param upload_count Number of uploads.
+ * @param p_uploads Valid pointer to an array of upload_count ShVkTextureUpload structures.
+ * @param[out] p_offsets Optional pointer to an array of upload_count offsets.
+ * @param[out] p_sizes Optional pointer to an array of upload_count sizes, read from the texels of each upload.
+ * @param[out] p_staging_size Valid pointer to the staging buffer size.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shGetTextureUploadStagingSize(
+	uint32_t                 upload_count,
+	const ShVkTextureUpload* p_uploads,
+	VkDeviceSize*            p_offsets,
+	VkDeviceSize*            p_sizes,
+	VkDeviceSize*            p_staging_size
+);
+
+/**
+ * @brief Packs a batch of textures into a single staging buffer and records their upload.
+ * 
+ * Every upload is validated before the staging buffer is created. The texels are written to one host visible allocation,
+ * which is mapped once. Only the uploaded mip levels and array layers are transitioned to
+ * VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, so other subresources keep their layout and content. Subresources entirely
+ * overwritten by a region are transitioned from VK_IMAGE_LAYOUT_UNDEFINED, the others from their current_layout,
+ * after every previous write, so the texels outside of the regions are kept. Uploads are grouped by
+ * image and recorded as one copy per image with multiple regions, then the uploaded subresources are transitioned to
+ * dst_image_layout. All barriers of a stage are recorded with a single vkCmdPipelineBarrier call.
+ * The staging buffer must be released with shClearBufferMemory once the command buffer has completed execution,
+ * it is destroyed by the function itself when it fails.
+ * 
+ * @param device Valid Vulkan device.
+ * @param physical_device Valid Vulkan physical device.
+ * @param transfer_cmd_buffer Valid Vulkan command buffer in the recording state.
+ * @param upload_count Number of uploads, at most SH_MAX_TEXTURE_UPLOAD_COUNT.
+ * @param p_uploads Valid pointer to an array of upload_count ShVkTextureUpload structures.
+ * @param dst_image_layout Layout of the images after the upload, e.g. VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL.
+ * @param dst_access_mask Access of the first use of the images after the upload.
+ * @param dst_stage Pipeline stage of the first use of the images after the upload.
+ * @param[out] p_staging_buffer Valid pointer to the created staging buffer, left untouched on failure.
+ * @param[out] p_staging_memory Valid pointer to the staging buffer memory, left untouched on failure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shCmdUploadTextures(
+	VkDevice                 device,
+	VkPhysicalDevice         physical_device,
+	VkCommandBuffer          transfer_cmd_buffer,
+	uint32_t                 upload_count,
+	const ShVkTextureUpload* p_uploads,
+	VkImageLayout            dst_image_layout,
+	VkAccessFlags            dst_access_mask,
+	VkPipelineStageFlags     dst_stage,
+	VkBuffer*                p_staging_buffer,
+	VkDeviceMemory*          p_staging_memory
+);
+
 /**
  * @brief Binds a Vulkan buffer to a specified memory offset.
  * 
@@ -1428,6 +2356,105 @@ extern uint8_t shClearBufferMemory(
 	VkDeviceMemory memory
 );
 
+
+
+#define SH_MAX_UNIFORM_ARENA_FRAME_COUNT 8
+
+/**
+ * @brief Host visible buffer suballocated every frame for dynamic uniform or storage buffer descriptors.
+ * 
+ * The buffer is split in frame_count regions of frame_size bytes. Each call to shUniformArenaPush copies a structure
+ * to the current frame region and returns its dynamic offset, to be passed to shPipelineBindDescriptorSetUnits.
+ * A single VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC descriptor pointing at the arena buffer serves all draws and frames.
+ */
+typedef struct ShVkUniformArena {
+	VkBuffer       buffer;        ///< Arena buffer, frame_count * frame_size bytes.
+	VkDeviceMemory memory;        ///< Host visible and coherent memory bound to the buffer.
+	uint8_t*       p_mapped_data; ///< Persistently mapped pointer to the arena memory.
+	uint32_t       alignment;     ///< Minimum dynamic offset alignment reported by the device.
+	uint32_t       max_range;     ///< maxUniformBufferRange (or maxStorageBufferRange), largest structure a push accepts.
+	uint32_t       frame_count;   ///< Number of frame regions.
+	uint32_t       frame_size;    ///< Size of each frame region, rounded up to alignment.
+	uint32_t       frame_idx;     ///< Index of the frame region currently written.
+	uint32_t       frame_offset;  ///< Write head inside the current frame region.
+} ShVkUniformArena;
+
+/**
+ * @brief Creates a dynamic uniform arena.
+ * 
+ * This function creates and persistently maps a host visible buffer divided in frame regions, aligned to
+ * minUniformBufferOffsetAlignment (or minStorageBufferOffsetAlignment for storage buffers). The whole arena must fit
+ * in the 32 bit range of dynamic offsets. On failure nothing is left allocated.
+ * 
+ * @param device Valid Vulkan device.
+ * @param physical_device Valid Vulkan physical device.
+ * @param frame_count Number of frame regions, usually the number of frames in flight.
+ * @param frame_size Bytes available to each frame region.
+ * @param usage Either VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT or VK_BUFFER_USAGE_STORAGE_BUFFER_BIT.
+ * @param p_arena Valid destination pointer to the ShVkUniformArena structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shCreateUniformArena(
+	VkDevice           device,
+	VkPhysicalDevice   physical_device,
+	uint32_t           frame_count,
+	uint32_t           frame_size,
+	VkBufferUsageFlags usage,
+	ShVkUniformArena*  p_arena
+);
+
+/**
+ * @brief Starts writing a frame region of the arena.
+ * 
+ * This function resets the write head of the given frame region. The caller must ensure the GPU is done with the
+ * commands that read from that region, e.g. by waiting for the frame fence.
+ * 
+ * @param frame_idx Index of the frame region to write.
+ * @param p_arena Valid pointer to the ShVkUniformArena structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shUniformArenaBeginFrame(
+	uint32_t          frame_idx,
+	ShVkUniformArena* p_arena
+);
+
+/**
+ * @brief Copies a structure to the current frame region of the arena.
+ * 
+ * This function copies the data to the next aligned location of the current frame region and returns the
+ * dynamic offset to pass to vkCmdBindDescriptorSets.
+ * 
+ * @param size Size of the data in bytes, must not exceed the range of the dynamic descriptor nor max_range.
+ * @param p_data Valid pointer to the data to copy.
+ * @param p_dynamic_offset Valid destination pointer to the dynamic offset of the copied data.
+ * @param p_arena Valid pointer to the ShVkUniformArena structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shUniformArenaPush(
+	uint32_t          size,
+	void*             p_data,
+	uint32_t*         p_dynamic_offset,
+	ShVkUniformArena* p_arena
+);
+
+/**
+ * @brief Destroys a dynamic uniform arena.
+ * 
+ * This function unmaps and releases the arena buffer and memory.
+ * 
+ * @param device Valid Vulkan device.
+ * @param p_arena Valid pointer to the ShVkUniformArena structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shDestroyUniformArena(
+	VkDevice          device,
+	ShVkUniformArena* p_arena
+);
+
 /**
  * @brief Creates a Vulkan image.
  * 
@@ -1463,6 +2490,45 @@ extern uint8_t shCreateImage(
 	VkImage*              p_image
 );
 
+/**
+ * @brief Creates a Vulkan image with multiple array layers, e.g. a texture array or a cube map.
+ * 
+ * Same-sized textures can share one texture array, bound once through a VK_IMAGE_VIEW_TYPE_2D_ARRAY view.
+ * 
+ * @param device Valid Vulkan device.
+ * @param type Vulkan image type.
+ * @param x Width of the image.
+ * @param y Height of the image.
+ * @param z Depth of the image.
+ * @param array_layers Number of array layers, a multiple of 6 for cube compatible images.
+ * @param cube_compatible 1 to allow cube and cube array views, which requires a square 2D image.
+ * @param format Vulkan image format.
+ * @param mip_levels Number of mipmap levels.
+ * @param sample_count Vulkan sample count flag bits.
+ * @param image_tiling Vulkan image tiling mode.
+ * @param usage Vulkan image usage flags.
+ * @param sharing_mode Vulkan sharing mode.
+ * @param p_image Valid destination pointer to the newly created Vulkan image.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shCreateLayeredImage(
+	VkDevice              device,
+	VkImageType           type,
+	uint32_t              x,
+	uint32_t              y,
+	uint32_t              z,
+	uint32_t              array_layers,
+	uint8_t               cube_compatible,
+	VkFormat              format,
+	uint32_t              mip_levels,
+	VkSampleCountFlagBits sample_count,
+	VkImageTiling         image_tiling,
+	VkImageUsageFlags     usage,
+	VkSharingMode         sharing_mode,
+	VkImage*              p_image
+);
+
 /**
  * @brief Allocates memory for a Vulkan image.
  * 
@@ -1592,6 +2658,163 @@ extern uint8_t shSetImageMemoryBarrier(
 	VkPipelineStageFlags pipeline_stage_after_barrier
 );
 
+/**
+ * @brief Creates an image memory barrier on a range of mip levels and array layers.
+ *
+ * Use VK_REMAINING_MIP_LEVELS and VK_REMAINING_ARRAY_LAYERS to cover every subresource of the image.
+ *
+ * @param device Valid Vulkan device.
+ * @param cmd_buffer Valid Vulkan command buffer.
+ * @param image Valid Vulkan image (target of the barrier).
+ * @param subresource_range Aspect mask, mip levels and array layers of the barrier.
+ * @param access_before_barrier Memory access flag before the barrier.
+ * @param access_after_barrier Memory access flag after the barrier.
+ * @param image_layout_before_barrier Image layout before the barrier.
+ * @param image_layout_after_barrier Image layout after the barrier.
+ * @param performing_queue_family_index_before_barrier Performing queue family index before the barrier.
+ * @param performing_queue_family_index_after_barrier Performing queue family index after the barrier.
+ * @param pipeline_stage_before_barrier Pipeline stage flag before the barrier.
+ * @param pipeline_stage_after_barrier Pipeline stage flag after the barrier.
+ *
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shSetImageSubresourceMemoryBarrier(
+	VkDevice                device,
+	VkCommandBuffer         cmd_buffer,
+	VkImage                 image,
+	VkImageSubresourceRange subresource_range,
+	VkAccessFlags           access_before_barrier,
+	VkAccessFlags           access_after_barrier,
+	VkImageLayout           image_layout_before_barrier,
+	VkImageLayout           image_layout_after_barrier,
+	uint32_t                performing_queue_family_index_before_barrier,
+	uint32_t                performing_queue_family_index_after_barrier,
+	VkPipelineStageFlags    pipeline_stage_before_barrier,
+	VkPipelineStageFlags    pipeline_stage_after_barrier
+);
+
+/**
+ * @brief Releases the ownership of a buffer from a queue family.
+ * 
+ * Records the release half of a queue family ownership transfer on a command buffer of the source queue. The matching
+ * shAcquireBufferOwnership must be recorded on the destination queue, after a semaphore signaled by this submission.
+ * Nothing is recorded when both queue families are equal, the semaphore is enough.
+ * 
+ * @param device Valid Vulkan device.
+ * @param cmd_buffer Valid Vulkan command buffer submitted to the source queue.
+ * @param buffer Valid Vulkan buffer.
+ * @param src_access Memory access performed on the buffer by the source queue.
+ * @param src_pipeline_stage Pipeline stage of the last source access.
+ * @param src_queue_family_index Queue family releasing the buffer.
+ * @param dst_queue_family_index Queue family acquiring the buffer.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shReleaseBufferOwnership(
+	VkDevice             device,
+	VkCommandBuffer      cmd_buffer,
+	VkBuffer             buffer,
+	VkAccessFlags        src_access,
+	VkPipelineStageFlags src_pipeline_stage,
+	uint32_t             src_queue_family_index,
+	uint32_t             dst_queue_family_index
+);
+
+/**
+ * @brief Acquires the ownership of a buffer on a queue family.
+ * 
+ * Records the acquire half of a queue family ownership transfer started with shReleaseBufferOwnership.
+ * 
+ * @param device Valid Vulkan device.
+ * @param cmd_buffer Valid Vulkan command buffer submitted to the destination queue.
+ * @param buffer Valid Vulkan buffer.
+ * @param dst_access Memory access performed on the buffer by the destination queue.
+ * @param dst_pipeline_stage Pipeline stage of the first destination access.
+ * @param src_queue_family_index Queue family releasing the buffer.
+ * @param dst_queue_family_index Queue family acquiring the buffer.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shAcquireBufferOwnership(
+	VkDevice             device,
+	VkCommandBuffer      cmd_buffer,
+	VkBuffer             buffer,
+	VkAccessFlags        dst_access,
+	VkPipelineStageFlags dst_pipeline_stage,
+	uint32_t             src_queue_family_index,
+	uint32_t             dst_queue_family_index
+);
+
+/**
+ * @brief Releases the ownership of an image from a queue family.
+ * 
+ * Same as shReleaseBufferOwnership, the layout transition is performed once, by both halves of the transfer.
+ * Subresources outside subresource_range stay owned by the source queue family.
+ * 
+ * @param device Valid Vulkan device.
+ * @param cmd_buffer Valid Vulkan command buffer submitted to the source queue.
+ * @param image Valid Vulkan image.
+ * @param subresource_range Transferred mip levels and array layers, every subresource the destination queue uses.
+ * @param src_access Memory access performed on the image by the source queue.
+ * @param src_pipeline_stage Pipeline stage of the last source access.
+ * @param image_layout_before_transfer Image layout on the source queue.
+ * @param image_layout_after_transfer Image layout on the destination queue.
+ * @param src_queue_family_index Queue family releasing the image.
+ * @param dst_queue_family_index Queue family acquiring the image.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shReleaseImageOwnership(
+	VkDevice                device,
+	VkCommandBuffer         cmd_buffer,
+	VkImage                 image,
+	VkImageSubresourceRange subresource_range,
+	VkAccessFlags           src_access,
+	VkPipelineStageFlags    src_pipeline_stage,
+	VkImageLayout           image_layout_before_transfer,
+	VkImageLayout           image_layout_after_transfer,
+	uint32_t                src_queue_family_index,
+	uint32_t                dst_queue_family_index
+);
+
+/**
+ * @brief Acquires the ownership of an image on a queue family.
+ * 
+ * Records the acquire half of a queue family ownership transfer started with shReleaseImageOwnership. When both
+ * queue families are equal, only the layout transition is recorded, synchronized with the previous access described
+ * by src_access and src_pipeline_stage. Across queue families those are made available by the release and the
+ * semaphore, so they are ignored.
+ * 
+ * @param device Valid Vulkan device.
+ * @param cmd_buffer Valid Vulkan command buffer submitted to the destination queue.
+ * @param image Valid Vulkan image.
+ * @param subresource_range Transferred mip levels and array layers, every subresource the destination queue uses.
+ * @param src_access Memory access last performed on the image, used when both queue families are equal.
+ * @param src_pipeline_stage Pipeline stage of the last access, used when both queue families are equal.
+ * @param dst_access Memory access performed on the image by the destination queue.
+ * @param dst_pipeline_stage Pipeline stage of the first destination access.
+ * @param image_layout_before_transfer Image layout on the source queue.
+ * @param image_layout_after_transfer Image layout on the destination queue.
+ * @param src_queue_family_index Queue family releasing the image.
+ * @param dst_queue_family_index Queue family acquiring the image.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shAcquireImageOwnership(
+	VkDevice                device,
+	VkCommandBuffer         cmd_buffer,
+	VkImage                 image,
+	VkImageSubresourceRange subresource_range,
+	VkAccessFlags           src_access,
+	VkPipelineStageFlags    src_pipeline_stage,
+	VkAccessFlags           dst_access,
+	VkPipelineStageFlags    dst_pipeline_stage,
+	VkImageLayout           image_layout_before_transfer,
+	VkImageLayout           image_layout_after_transfer,
+	uint32_t                src_queue_family_index,
+	uint32_t                dst_queue_family_index
+);
+
 /**
  * @brief Retrieves memory budget properties for a Vulkan physical device.
  * 
@@ -1620,13 +2843,22 @@ extern uint8_t shGetMemoryBudgetProperties(
  * 
  * @return 1 if successful, 0 otherwise.
  */
-extern uint8_t shBindVertexBuffers(
+SH_INLINE uint8_t shBindVertexBuffers(
 	VkCommandBuffer graphics_cmd_buffer,
 	uint32_t        first_binding,
 	uint32_t        binding_count,
 	VkBuffer*       p_vertex_buffers,
 	VkDeviceSize*   p_vertex_offsets
-);
+) {
+	shVkArgError(graphics_cmd_buffer == VK_NULL_HANDLE, "invalid command buffer memory", return 0);
+	shVkArgError(binding_count       == 0,    "invalid binding count",         return 0);
+	shVkArgError(p_vertex_buffers    == VK_NULL_HANDLE, "invalid vertex buffers memory", return 0);
+	shVkArgError(p_vertex_offsets    == VK_NULL_HANDLE, "invalid vertex offsets memory", return 0);
+
+	SH_VK_DEVICE_CALL(vkCmdBindVertexBuffers, graphics_cmd_buffer)(graphics_cmd_buffer, first_binding, binding_count, p_vertex_buffers, p_vertex_offsets);
+
+	return 1;
+}
 
 /**
  * @brief Binds an index buffer to a Vulkan command buffer.
@@ -1639,11 +2871,18 @@ extern uint8_t shBindVertexBuffers(
  * 
  * @return 1 if successful, 0 otherwise.
  */
-extern uint8_t shBindIndexBuffer(
+SH_INLINE uint8_t shBindIndexBuffer(
 	VkCommandBuffer graphics_cmd_buffer,
 	uint32_t        index_offset,
 	VkBuffer        index_buffer
-);
+) {
+	shVkArgError(graphics_cmd_buffer == VK_NULL_HANDLE, "invalid command buffer memory", return 0);
+	shVkArgError(index_buffer        == VK_NULL_HANDLE, "invalid index buffer memory",   return 0);
+
+	SH_VK_DEVICE_CALL(vkCmdBindIndexBuffer, graphics_cmd_buffer)(graphics_cmd_buffer, index_buffer, index_offset, VK_INDEX_TYPE_UINT32);
+	
+	return 1;
+}
 
 /**
  * @brief Sets the vertex input binding description.
@@ -1895,15 +3134,17 @@ extern uint8_t shCreateDescriptorSetLayoutBinding(
  * @param device Valid Vulkan device.
  * @param binding_count Number of descriptor set layout bindings.
  * @param p_bindings Valid pointer to an array of Vulkan descriptor set layout bindings.
+ * @param flags Descriptor set layout create flags (e.g., VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR).
  * @param p_descriptor_set_layout Valid destination pointer to the newly created Vulkan descriptor set layout.
  * 
  * @return 1 if successful, 0 otherwise.
  */
 extern uint8_t shCreateDescriptorSetLayout(
-	VkDevice                      device,
-	uint32_t                      binding_count,
-	VkDescriptorSetLayoutBinding* p_bindings,
-	VkDescriptorSetLayout*        p_descriptor_set_layout
+	VkDevice                         device,
+	uint32_t                         binding_count,
+	VkDescriptorSetLayoutBinding*    p_bindings,
+	VkDescriptorSetLayoutCreateFlags flags,
+	VkDescriptorSetLayout*           p_descriptor_set_layout
 );
 
 /**
@@ -1945,18 +3186,38 @@ extern uint8_t shSetDescriptorBufferInfo(
 );
 
 /**
- * @brief Allocates descriptor sets from a descriptor pool.
+ * @brief Sets image information for a descriptor image.
  * 
- * This function allocates descriptor sets of the specified type from the given descriptor pool.
+ * This function sets image information for sampler, sampled image, storage image and combined image sampler descriptors.
  * 
- * @param device Valid Vulkan device.
- * @param descriptor_pool Valid Vulkan descriptor pool from which to allocate descriptor sets.
- * @param descriptor_type Vulkan descriptor type (e.g., uniform buffer, sampled image).
- * @param binding Binding index for the descriptor sets.
+ * @param sampler Vulkan sampler, may be VK_NULL_HANDLE for descriptors without a sampler.
+ * @param image_view Vulkan image view, may be VK_NULL_HANDLE for sampler descriptors.
+ * @param image_layout Layout of the image when accessed through the descriptor.
+ * @param p_image_info Valid destination pointer to the Vulkan descriptor image info.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shSetDescriptorImageInfo(
+	VkSampler              sampler,
+	VkImageView            image_view,
+	VkImageLayout          image_layout,
+	VkDescriptorImageInfo* p_image_info
+);
+
+/**
+ * @brief Allocates descriptor sets from a descriptor pool.
+ * 
+ * This function allocates descriptor sets of the specified type from the given descriptor pool.
+ * 
+ * @param device Valid Vulkan device.
+ * @param descriptor_pool Valid Vulkan descriptor pool from which to allocate descriptor sets.
+ * @param descriptor_type Vulkan descriptor type (e.g., uniform buffer, sampled image).
+ * @param binding Binding index for the descriptor sets.
  * @param descriptor_set_unit_count Number of descriptor sets to allocate.
  * @param p_descriptor_set_layouts Valid pointer to an array of Vulkan descriptor set layouts.
  * @param p_descriptor_sets Valid destination pointer to an array of Vulkan descriptor sets.
- * @param p_buffer_infos Valid pointer to an array of Vulkan descriptor buffer info structures.
+ * @param p_buffer_infos Pointer to an array of Vulkan descriptor buffer info structures, required by buffer descriptor types.
+ * @param p_image_infos Pointer to an array of Vulkan descriptor image info structures, required by image and sampler descriptor types.
  * @param p_write_descriptor_sets Valid pointer to an array of Vulkan write descriptor set structures.
  * 
  * @return 1 if successful, 0 otherwise.
@@ -1970,9 +3231,154 @@ extern uint8_t shAllocateDescriptorSetUnits(
 	VkDescriptorSetLayout*  p_descriptor_set_layouts,
 	VkDescriptorSet*        p_descriptor_sets,
 	VkDescriptorBufferInfo* p_buffer_infos,
+	VkDescriptorImageInfo*  p_image_infos,
 	VkWriteDescriptorSet*   p_write_descriptor_sets
 );
 
+/**
+ * @brief Structure read by a descriptor type, selects the VkWriteDescriptorSet field to fill.
+ */
+typedef enum ShVkDescriptorInfoType {
+	SH_DESCRIPTOR_INFO_TYPE_BUFFER       = 0, ///< VkDescriptorBufferInfo, `pBufferInfo`.
+	SH_DESCRIPTOR_INFO_TYPE_IMAGE        = 1, ///< VkDescriptorImageInfo, `pImageInfo`.
+	SH_DESCRIPTOR_INFO_TYPE_TEXEL_BUFFER = 2  ///< VkBufferView, `pTexelBufferView`.
+} ShVkDescriptorInfoType;
+
+/**
+ * @brief Retrieves the structure read by a descriptor type.
+ *
+ * @param descriptor_type Vulkan descriptor type (e.g., uniform buffer, sampled image).
+ * @param p_info_type Valid destination pointer to the info type.
+ *
+ * @return 1 if successful, 0 otherwise or if the descriptor type is not supported.
+ */
+extern uint8_t shGetDescriptorInfoType(
+	VkDescriptorType        descriptor_type,
+	ShVkDescriptorInfoType* p_info_type
+);
+
+/**
+ * @brief Retrieves the size of the info structure read by a descriptor type.
+ *
+ * This function returns the size of the structure (VkDescriptorBufferInfo, VkDescriptorImageInfo or VkBufferView)
+ * that describes a single descriptor of the given type inside a descriptor update template data block.
+ *
+ * @param descriptor_type Vulkan descriptor type (e.g., uniform buffer, sampled image).
+ * @param p_size Valid destination pointer to the size in bytes.
+ *
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shGetDescriptorInfoSize(
+	VkDescriptorType descriptor_type,
+	uint32_t*        p_size
+);
+
+/**
+ * @brief Creates a descriptor update template entry.
+ *
+ * This function describes where the infos of a binding are located inside the data block passed to a descriptor update template.
+ *
+ * @param binding Binding index in the descriptor set layout.
+ * @param array_element First array element of the binding to update.
+ * @param descriptor_count Number of descriptors to update.
+ * @param descriptor_type Vulkan descriptor type (e.g., uniform buffer, sampled image).
+ * @param offset Offset in bytes of the first info structure inside the data block.
+ * @param stride Stride in bytes between consecutive info structures of the binding.
+ * @param p_entry Valid destination pointer to the Vulkan descriptor update template entry.
+ *
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shCreateDescriptorUpdateTemplateEntry(
+	uint32_t                         binding,
+	uint32_t                         array_element,
+	uint32_t                         descriptor_count,
+	VkDescriptorType                 descriptor_type,
+	uint32_t                         offset,
+	uint32_t                         stride,
+	VkDescriptorUpdateTemplateEntry* p_entry
+);
+
+/**
+ * @brief Creates a descriptor update template.
+ *
+ * This function creates a Vulkan descriptor update template for descriptor sets allocated with the given layout.
+ *
+ * @param device Valid Vulkan device.
+ * @param entry_count Number of descriptor update template entries.
+ * @param p_entries Valid pointer to an array of Vulkan descriptor update template entries.
+ * @param descriptor_set_layout Valid Vulkan descriptor set layout the template refers to.
+ * @param p_descriptor_update_template Valid destination pointer to the newly created Vulkan descriptor update template.
+ *
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shCreateDescriptorUpdateTemplate(
+	VkDevice                         device,
+	uint32_t                         entry_count,
+	VkDescriptorUpdateTemplateEntry* p_entries,
+	VkDescriptorSetLayout            descriptor_set_layout,
+	VkDescriptorUpdateTemplate*      p_descriptor_update_template
+);
+
+/**
+ * @brief Updates a descriptor set using a descriptor update template.
+ *
+ * This function writes the packed info structures pointed by p_data to the descriptor set, following the template entries.
+ *
+ * @param device Valid Vulkan device.
+ * @param descriptor_set Valid Vulkan descriptor set to update.
+ * @param descriptor_update_template Valid Vulkan descriptor update template.
+ * @param p_data Valid pointer to the packed descriptor infos.
+ *
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shUpdateDescriptorSetWithTemplate(
+	VkDevice                   device,
+	VkDescriptorSet            descriptor_set,
+	VkDescriptorUpdateTemplate descriptor_update_template,
+	void*                      p_data
+);
+
+/**
+ * @brief Loads the vkCmdPushDescriptorSetKHR entry point.
+ *
+ * This function retrieves the VK_KHR_push_descriptor command from the device. The extension must be enabled at device creation.
+ *
+ * @param device Valid Vulkan device.
+ * @param p_cmd_push_descriptor_set Valid destination pointer to the loaded function.
+ *
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shGetPushDescriptorSetFunction(
+	VkDevice                       device,
+	PFN_vkCmdPushDescriptorSetKHR* p_cmd_push_descriptor_set
+);
+
+/**
+ * @brief Pushes descriptors directly into a command buffer.
+ *
+ * This function records descriptor writes for a set created with VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR,
+ * without allocating or updating descriptor sets. The dstSet member of the write descriptor sets is ignored.
+ *
+ * @param cmd_buffer Valid Vulkan command buffer.
+ * @param cmd_push_descriptor_set Valid vkCmdPushDescriptorSetKHR function, see shGetPushDescriptorSetFunction.
+ * @param bind_point Pipeline bind point (e.g., VK_PIPELINE_BIND_POINT_GRAPHICS).
+ * @param pipeline_layout Valid Vulkan pipeline layout.
+ * @param set Index of the push descriptor set in the pipeline layout.
+ * @param write_descriptor_set_count Number of write descriptor sets.
+ * @param p_write_descriptor_sets Valid pointer to an array of Vulkan write descriptor set structures.
+ *
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shPushDescriptorSet(
+	VkCommandBuffer               cmd_buffer,
+	PFN_vkCmdPushDescriptorSetKHR cmd_push_descriptor_set,
+	VkPipelineBindPoint           bind_point,
+	VkPipelineLayout              pipeline_layout,
+	uint32_t                      set,
+	uint32_t                      write_descriptor_set_count,
+	VkWriteDescriptorSet*         p_write_descriptor_sets
+);
+
 /**
  * @brief Creates a pipeline layout.
  * 
@@ -2026,6 +3432,21 @@ extern uint8_t shDestroyDescriptorSetLayout(
 	VkDescriptorSetLayout descriptor_set_layout
 );
 
+/**
+ * @brief Destroys a Vulkan descriptor update template.
+ *
+ * This function destroys the specified Vulkan descriptor update template.
+ *
+ * @param device Valid Vulkan device.
+ * @param descriptor_update_template Vulkan descriptor update template to destroy.
+ *
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shDestroyDescriptorUpdateTemplate(
+	VkDevice                   device,
+	VkDescriptorUpdateTemplate descriptor_update_template
+);
+
 /**
  * @brief Destroys a Vulkan shader module.
  * 
@@ -2071,6 +3492,245 @@ extern uint8_t shDestroyPipeline(
 	VkPipeline pipeline
 );
 
+/**
+ * @brief Creates a Vulkan sampler.
+ * 
+ * This function creates a Vulkan sampler from the given create info.
+ * 
+ * @param device Valid Vulkan device.
+ * @param p_sampler_create_info Valid pointer to the Vulkan sampler create info.
+ * @param p_sampler Valid destination pointer to the newly created Vulkan sampler.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shCreateSampler(
+	VkDevice             device,
+	VkSamplerCreateInfo* p_sampler_create_info,
+	VkSampler*           p_sampler
+);
+
+/**
+ * @brief Destroys a Vulkan sampler.
+ * 
+ * This function destroys the specified Vulkan sampler.
+ * 
+ * @param device Valid Vulkan device.
+ * @param sampler Vulkan sampler to destroy.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shDestroySampler(
+	VkDevice  device,
+	VkSampler sampler
+);
+
+
+
+#define SH_SAMPLER_CACHE_MAX_SAMPLER_COUNT 256 //must be a power of two
+
+/**
+ * @brief Open addressing table of samplers, keyed on a hash of their create info.
+ * 
+ * Materials asking for identical sampler states receive the same VkSampler handle, which keeps
+ * the number of live samplers well below maxSamplerAllocationCount. The pNext chain of the create infos is not hashed.
+ */
+typedef struct ShVkSamplerCache {
+	uint32_t            sampler_count;                                     ///< Number of samplers created by the cache.
+	uint64_t            hashes      [SH_SAMPLER_CACHE_MAX_SAMPLER_COUNT]; ///< Hashes of the sampler create infos.
+	VkSamplerCreateInfo create_infos[SH_SAMPLER_CACHE_MAX_SAMPLER_COUNT]; ///< Sampler create infos, compared on hash match.
+	VkSampler           samplers    [SH_SAMPLER_CACHE_MAX_SAMPLER_COUNT]; ///< Cached samplers, VK_NULL_HANDLE for empty slots.
+} ShVkSamplerCache;
+
+/**
+ * @brief Allocates a new ShVkSamplerCache structure.
+ * 
+ * This macro allocates heap memory for a new ShVkSamplerCache structure and initializes it to zero.
+ * 
+ * @return Pointer to the newly allocated ShVkSamplerCache structure, or NULL if allocation fails.
+ */
+#define shAllocateSamplerCache() ((ShVkSamplerCache*)calloc(1, sizeof(ShVkSamplerCache)))
+
+/**
+ * @brief Frees the memory of an ShVkSamplerCache structure.
+ * 
+ * This macro frees the memory allocated on the heap for an ShVkSamplerCache structure. Destroy the samplers first with shDestroySamplerCache.
+ * 
+ * @param ptr Pointer to the ShVkSamplerCache structure to be freed.
+ */
+#define shFreeSamplerCache free
+
+/**
+ * @brief Hashes the sampler states of a sampler create info.
+ * 
+ * This function computes a 64 bit FNV-1a hash of the create info members following pNext. The pNext chain is not hashed.
+ * 
+ * @param p_sampler_create_info Valid pointer to the Vulkan sampler create info.
+ * @param p_hash Valid destination pointer to the hash.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shHashSamplerCreateInfo(
+	VkSamplerCreateInfo* p_sampler_create_info,
+	uint64_t*            p_hash
+);
+
+/**
+ * @brief Retrieves a shared sampler from the cache.
+ * 
+ * This function returns the cached sampler matching the create info, creating and caching it when missing.
+ * The create info must not have a pNext chain: samplers with chained structures (e.g. VkSamplerReductionModeCreateInfo,
+ * VkSamplerYcbcrConversionInfo or a custom border color) are created with shCreateSampler and are not cached.
+ * 
+ * @param device Valid Vulkan device.
+ * @param p_sampler_create_info Valid pointer to the Vulkan sampler create info, pNext must be `NULL`.
+ * @param p_sampler_cache Valid pointer to the ShVkSamplerCache structure.
+ * @param p_sampler Valid destination pointer to the shared Vulkan sampler.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shSamplerCacheGet(
+	VkDevice             device,
+	VkSamplerCreateInfo* p_sampler_create_info,
+	ShVkSamplerCache*    p_sampler_cache,
+	VkSampler*           p_sampler
+);
+
+/**
+ * @brief Destroys all the samplers of the cache.
+ * 
+ * This function destroys the cached samplers and clears the cache.
+ * 
+ * @param device Valid Vulkan device.
+ * @param p_sampler_cache Valid pointer to the ShVkSamplerCache structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shDestroySamplerCache(
+	VkDevice          device,
+	ShVkSamplerCache* p_sampler_cache
+);
+
+
+
+#define SH_DESCRIPTOR_SET_CACHE_MAX_SET_COUNT 256
+#define SH_DESCRIPTOR_SET_CACHE_TABLE_SIZE    512 //must be a power of two, at least twice SH_DESCRIPTOR_SET_CACHE_MAX_SET_COUNT
+#define SH_DESCRIPTOR_SET_CACHE_MAX_KEY_SIZE  256
+
+/**
+ * @brief Cache of descriptor sets keyed on their layout and bound resources.
+ * 
+ * Draws binding the same resources through the same layout share one descriptor set, so steady state frames
+ * neither allocate nor update descriptor sets. Sets are stored in an open addressing table with linear probing.
+ * When the cache or its pool is full, the least recently used set that has not been used by the last
+ * frames_in_flight frames is rewritten or freed, so sets still read by the GPU are never touched.
+ */
+typedef struct ShVkDescriptorSetCache {
+	VkDescriptorPool      descriptor_pool;                                      ///< Pool created with VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT.
+	uint32_t              max_set_count;                                        ///< Maximum number of cached descriptor sets.
+	uint32_t              frames_in_flight;                                     ///< Number of frames a set stays protected from eviction after its last use.
+	uint64_t              frame_idx;                                            ///< Current frame, incremented by shDescriptorSetCacheBeginFrame.
+	uint32_t              set_count;                                            ///< Number of cached descriptor sets.
+	uint64_t              hashes          [SH_DESCRIPTOR_SET_CACHE_TABLE_SIZE]; ///< Hashes of the keys.
+	uint32_t              key_sizes       [SH_DESCRIPTOR_SET_CACHE_TABLE_SIZE]; ///< Sizes of the keys.
+	uint8_t               keys            [SH_DESCRIPTOR_SET_CACHE_TABLE_SIZE][SH_DESCRIPTOR_SET_CACHE_MAX_KEY_SIZE]; ///< Layouts and bound resources of the cached sets, one 64 bit word per member.
+	uint64_t              last_used_frames[SH_DESCRIPTOR_SET_CACHE_TABLE_SIZE]; ///< Frame of the last lookup hitting each set.
+	VkDescriptorSetLayout set_layouts     [SH_DESCRIPTOR_SET_CACHE_TABLE_SIZE]; ///< Layouts of the cached sets.
+	VkDescriptorSet       descriptor_sets [SH_DESCRIPTOR_SET_CACHE_TABLE_SIZE]; ///< Cached descriptor sets, VK_NULL_HANDLE for empty slots.
+} ShVkDescriptorSetCache;
+
+/**
+ * @brief Allocates a new ShVkDescriptorSetCache structure.
+ * 
+ * This macro allocates heap memory for a new ShVkDescriptorSetCache structure and initializes it to zero.
+ * 
+ * @return Pointer to the newly allocated ShVkDescriptorSetCache structure, or NULL if allocation fails.
+ */
+#define shAllocateDescriptorSetCache() ((ShVkDescriptorSetCache*)calloc(1, sizeof(ShVkDescriptorSetCache)))
+
+/**
+ * @brief Frees the memory of an ShVkDescriptorSetCache structure.
+ * 
+ * This macro frees the memory allocated on the heap for an ShVkDescriptorSetCache structure. Call shDestroyDescriptorSetCache first.
+ * 
+ * @param ptr Pointer to the ShVkDescriptorSetCache structure to be freed.
+ */
+#define shFreeDescriptorSetCache free
+
+/**
+ * @brief Creates the descriptor pool of a descriptor set cache.
+ * 
+ * @param device Valid Vulkan device.
+ * @param pool_size_count Number of pool sizes.
+ * @param p_pool_sizes Valid pointer to an array of Vulkan descriptor pool sizes, large enough for max_set_count sets.
+ * @param max_set_count Maximum number of cached descriptor sets, up to SH_DESCRIPTOR_SET_CACHE_MAX_SET_COUNT.
+ * @param frames_in_flight Number of frames the GPU may still be reading after they are recorded.
+ * @param p_descriptor_set_cache Valid pointer to a zero initialized ShVkDescriptorSetCache structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shCreateDescriptorSetCache(
+	VkDevice                device,
+	uint32_t                pool_size_count,
+	VkDescriptorPoolSize*   p_pool_sizes,
+	uint32_t                max_set_count,
+	uint32_t                frames_in_flight,
+	ShVkDescriptorSetCache* p_descriptor_set_cache
+);
+
+/**
+ * @brief Starts a new frame of the descriptor set cache.
+ * 
+ * This function advances the frame counter used for LRU eviction. Call it once per recorded frame.
+ * 
+ * @param p_descriptor_set_cache Valid pointer to the ShVkDescriptorSetCache structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shDescriptorSetCacheBeginFrame(
+	ShVkDescriptorSetCache* p_descriptor_set_cache
+);
+
+/**
+ * @brief Retrieves a descriptor set matching a layout and a list of descriptor writes.
+ * 
+ * This function hashes the layout plus the members of the bound buffer, image and texel buffer infos, and returns
+ * the cached descriptor set on a match. Otherwise it allocates, or recycles the least recently used set, and writes
+ * it once. If the pool runs out of descriptors before max_set_count sets, least recently used sets out of flight are
+ * freed until the allocation succeeds. The dstSet member of the write descriptor sets is ignored.
+ * 
+ * @param device Valid Vulkan device.
+ * @param set_layout Valid Vulkan descriptor set layout.
+ * @param write_descriptor_set_count Number of write descriptor sets.
+ * @param p_write_descriptor_sets Valid pointer to an array of Vulkan write descriptor set structures.
+ * @param p_descriptor_set_cache Valid pointer to the ShVkDescriptorSetCache structure.
+ * @param p_descriptor_set Valid destination pointer to the Vulkan descriptor set.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shDescriptorSetCacheGet(
+	VkDevice                device,
+	VkDescriptorSetLayout   set_layout,
+	uint32_t                write_descriptor_set_count,
+	VkWriteDescriptorSet*   p_write_descriptor_sets,
+	ShVkDescriptorSetCache* p_descriptor_set_cache,
+	VkDescriptorSet*        p_descriptor_set
+);
+
+/**
+ * @brief Destroys the descriptor pool of a descriptor set cache.
+ * 
+ * This function releases all the cached descriptor sets and clears the cache.
+ * 
+ * @param device Valid Vulkan device.
+ * @param p_descriptor_set_cache Valid pointer to the ShVkDescriptorSetCache structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shDestroyDescriptorSetCache(
+	VkDevice                device,
+	ShVkDescriptorSetCache* p_descriptor_set_cache
+);
+
 
 
 #define SH_MAX_PIPELINE_VERTEX_BINDING_COUNT           32
@@ -2405,11 +4065,26 @@ extern uint8_t shSetupGraphicsPipeline(
  * 
  * @return 1 if successful, 0 otherwise.
  */
-extern uint8_t shPipelinePushConstants(
+SH_INLINE uint8_t shPipelinePushConstants(
 	VkCommandBuffer cmd_buffer,
 	void*           p_data,
 	ShVkPipeline*   p_pipeline
-);
+) {
+	shVkArgError(cmd_buffer == VK_NULL_HANDLE, "invalid command buffer memory",     return 0);
+	shVkArgError(p_data     == VK_NULL_HANDLE, "invalid push constant data memory", return 0);
+	shVkArgError(p_pipeline == VK_NULL_HANDLE, "invalid pipeline memory",           return 0);
+
+	SH_VK_DEVICE_CALL(vkCmdPushConstants, cmd_buffer)(
+		cmd_buffer,
+		p_pipeline->pipeline_layout,
+		p_pipeline->push_constant_range.stageFlags,
+		p_pipeline->push_constant_range.offset,
+		p_pipeline->push_constant_range.size,
+		p_data
+	);
+
+	return 1;
+}
 
 /**
  * @brief Binds a pipeline to a command buffer.
@@ -2422,11 +4097,18 @@ extern uint8_t shPipelinePushConstants(
  * 
  * @return 1 if successful, 0 otherwise.
  */
-extern uint8_t shBindPipeline(
+SH_INLINE uint8_t shBindPipeline(
 	VkCommandBuffer     cmd_buffer,
 	VkPipelineBindPoint bind_point,
 	ShVkPipeline*       p_pipeline
-);
+) {
+	shVkArgError(cmd_buffer == VK_NULL_HANDLE, "invalid command buffer memory", return 0);
+	shVkArgError(p_pipeline == VK_NULL_HANDLE, "invalid pipeline memory",       return 0);
+
+	SH_VK_DEVICE_CALL(vkCmdBindPipeline, cmd_buffer)(cmd_buffer, bind_point, p_pipeline->pipeline);
+
+	return 1;
+}
 
 /**
  * @brief Binds descriptor set units to a pipeline within a command buffer.
@@ -2457,6 +4139,63 @@ extern uint8_t shPipelineBindDescriptorSetUnits(
 	ShVkPipeline*       p_pipeline
 );
 
+/**
+ * @brief Binds descriptor sets to a pipeline within a command buffer.
+ * 
+ * This function binds descriptor sets which do not belong to a pipeline pool, e.g. the ones returned by shDescriptorSetCacheGet.
+ * 
+ * @param cmd_buffer Valid Vulkan command buffer.
+ * @param first_descriptor_set Index of the first descriptor set in the pipeline layout.
+ * @param descriptor_set_count Number of descriptor sets to bind.
+ * @param p_descriptor_sets Valid pointer to an array of Vulkan descriptor sets.
+ * @param bind_point Pipeline bind point (e.g., VK_PIPELINE_BIND_POINT_GRAPHICS).
+ * @param dynamic_descriptors_count Number of dynamic descriptors.
+ * @param p_dynamic_offsets Array of dynamic offsets for the descriptors.
+ * @param p_pipeline Valid destination pointer to the ShVkPipeline structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shPipelineBindDescriptorSets(
+	VkCommandBuffer     cmd_buffer,
+	uint32_t            first_descriptor_set,
+	uint32_t            descriptor_set_count,
+	VkDescriptorSet*    p_descriptor_sets,
+	VkPipelineBindPoint bind_point,
+	uint32_t            dynamic_descriptors_count,
+	uint32_t*           p_dynamic_offsets,
+	ShVkPipeline*       p_pipeline
+);
+
+/**
+ * @brief Pushes descriptors of the pipeline pool directly into a command buffer.
+ * 
+ * This function writes a range of descriptor buffer or image infos of the pipeline pool, depending on descriptor_type,
+ * to one binding of a push descriptor set, which must have been created with VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR. No descriptor set is allocated.
+ * 
+ * @param cmd_buffer Valid Vulkan command buffer.
+ * @param set Index of the push descriptor set in the pipeline layout.
+ * @param binding Binding index in the descriptor set layout.
+ * @param descriptor_type Type of the descriptor (e.g., VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER).
+ * @param first_descriptor Index of the first descriptor buffer or image info of the pipeline pool.
+ * @param descriptor_count Number of descriptors to push.
+ * @param bind_point Pipeline bind point (e.g., VK_PIPELINE_BIND_POINT_GRAPHICS).
+ * @param p_pipeline_pool Valid pointer to the ShVkPipelinePool structure.
+ * @param p_pipeline Valid destination pointer to the ShVkPipeline structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shPipelinePushDescriptors(
+	VkCommandBuffer     cmd_buffer,
+	uint32_t            set,
+	uint32_t            binding,
+	VkDescriptorType    descriptor_type,
+	uint32_t            first_descriptor,
+	uint32_t            descriptor_count,
+	VkPipelineBindPoint bind_point,
+	ShVkPipelinePool*   p_pipeline_pool,
+	ShVkPipeline*       p_pipeline
+);
+
 /**
  * @brief Destroys shader modules associated with the pipeline.
  * 
@@ -2512,6 +4251,7 @@ typedef struct ShVkPipelinePool {
 	uint32_t                     descriptor_count; ///< Combined total of all descriptors in the descriptor pools.
 	uint32_t                     write_descriptor_set_count; ///< Total number of write descriptor sets used for updates.
 	uint32_t                     descriptor_set_unit_count; ///< Number of descriptor set units, equal to write_descriptor_set_count.
+	uint32_t                     descriptor_update_template_count; ///< Number of descriptor update templates created by the pool.
 	
 	VkDescriptorSetLayoutBinding descriptor_set_layout_bindings[SH_MAX_PIPELINE_POOL_DESCRIPTOR_COUNT]; ///< Descriptor set layout bindings.	
 
@@ -2522,9 +4262,15 @@ typedef struct ShVkPipelinePool {
 	VkDescriptorSet              descriptor_sets[SH_MAX_PIPELINE_POOL_DESCRIPTOR_COUNT]; ///< Descriptor sets.	
 
 	VkDescriptorBufferInfo       descriptor_buffer_infos[SH_MAX_PIPELINE_POOL_DESCRIPTOR_COUNT]; ///< Descriptor buffer info.	
+
+	VkDescriptorImageInfo        descriptor_image_infos[SH_MAX_PIPELINE_POOL_DESCRIPTOR_COUNT]; ///< Descriptor image info.	
 	
 	VkWriteDescriptorSet         write_descriptor_sets[SH_MAX_PIPELINE_POOL_DESCRIPTOR_COUNT]; ///< Write descriptor sets.
 
+	VkDescriptorUpdateTemplate   descriptor_update_templates[SH_MAX_PIPELINE_POOL_DESCRIPTOR_COUNT]; ///< Descriptor update templates, indexed by set layout.
+
+	PFN_vkCmdPushDescriptorSetKHR cmd_push_descriptor_set; ///< vkCmdPushDescriptorSetKHR, loaded when a push descriptor set layout is created.
+
 } ShVkPipelinePool;
 
 
@@ -2575,20 +4321,25 @@ extern uint8_t shPipelinePoolCreateDescriptorSetLayoutBinding(
  * 
  * This function initializes descriptor set layouts in the pipeline pool.
  * 
+ * When flags contain VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR, the layout is meant for
+ * shPipelinePushDescriptors and the vkCmdPushDescriptorSetKHR entry point is loaded into the pipeline pool.
+ * 
  * @param device Valid Vulkan device.
  * @param first_binding_idx Index of the first binding in the layout.
  * @param binding_count Number of bindings.
  * @param set_layout_idx Index of the set layout to initialize.
+ * @param flags Descriptor set layout create flags (e.g., VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR).
  * @param[in,out] p_pipeline_pool Valid pointer to the ShVkPipelinePool structure.
  * 
  * @return 1 if successful, 0 otherwise.
  */
 extern uint8_t shPipelinePoolCreateDescriptorSetLayout(
-	VkDevice          device,
-	uint32_t          first_binding_idx,
-	uint32_t          binding_count,
-	uint32_t          set_layout_idx,//set_idx
-	ShVkPipelinePool* p_pipeline_pool
+	VkDevice                         device,
+	uint32_t                         first_binding_idx,
+	uint32_t                         binding_count,
+	uint32_t                         set_layout_idx,//set_idx
+	VkDescriptorSetLayoutCreateFlags flags,
+	ShVkPipelinePool*                p_pipeline_pool
 );
 
 /**
@@ -2679,6 +4430,29 @@ extern uint8_t shPipelinePoolSetDescriptorBufferInfos(
 	ShVkPipelinePool* p_pipeline_pool
 );
 
+/**
+ * @brief Sets descriptor image infos in the pipeline pool.
+ * 
+ * This function sets the image information for sampler and image descriptors in the pipeline pool.
+ * 
+ * @param first_descriptor Index of the first descriptor to set.
+ * @param descriptor_count Number of descriptors to update.
+ * @param sampler Vulkan sampler, may be VK_NULL_HANDLE for descriptors without a sampler (see shSamplerCacheGet).
+ * @param image_view Vulkan image view, may be VK_NULL_HANDLE for sampler descriptors.
+ * @param image_layout Layout of the image when accessed through the descriptors.
+ * @param[in,out] p_pipeline_pool Valid pointer to the ShVkPipelinePool structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shPipelinePoolSetDescriptorImageInfos(
+	uint32_t          first_descriptor,
+	uint32_t          descriptor_count,
+	VkSampler         sampler,
+	VkImageView       image_view,
+	VkImageLayout     image_layout,
+	ShVkPipelinePool* p_pipeline_pool
+);
+
 /**
  * @brief Destroys descriptor set layouts in the pipeline pool.
  * 
@@ -2736,6 +4510,1613 @@ extern uint8_t shPipelinePoolUpdateDescriptorSetUnits(
 	ShVkPipelinePool* p_pipeline_pool
 );
 
+/**
+ * @brief Creates a descriptor update template for a set layout of the pipeline pool.
+ * 
+ * This function creates a descriptor update template once per set layout. The template expects the infos of the
+ * bindings packed one after the other, in binding order, each one sized after its descriptor type
+ * (see shGetDescriptorInfoSize). A set layout with a single buffer binding reads a plain VkDescriptorBufferInfo.
+ * The set layout must already exist, an existing template of the same set layout is destroyed and replaced.
+ * 
+ * @param device Valid Vulkan device.
+ * @param first_binding_idx Index of the first binding in the layout.
+ * @param binding_count Number of bindings.
+ * @param set_layout_idx Index of the set layout the template refers to, also used as template index.
+ * @param[in,out] p_pipeline_pool Valid pointer to the ShVkPipelinePool structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shPipelinePoolCreateDescriptorUpdateTemplate(
+	VkDevice          device,
+	uint32_t          first_binding_idx,
+	uint32_t          binding_count,
+	uint32_t          set_layout_idx,
+	ShVkPipelinePool* p_pipeline_pool
+);
+
+/**
+ * @brief Updates descriptor set units in the pipeline pool using a descriptor update template.
+ * 
+ * This function updates each descriptor set unit from its own packed data block, without rebuilding write descriptor sets.
+ * Passing p_pipeline_pool->descriptor_buffer_infos with a stride of sizeof(VkDescriptorBufferInfo) updates the same
+ * buffers written by shPipelinePoolSetDescriptorBufferInfos.
+ * 
+ * @param device Valid Vulkan device.
+ * @param set_layout_idx Index of the set layout whose template is used.
+ * @param first_descriptor_set_unit Index of the first descriptor set unit to update.
+ * @param descriptor_set_unit_count Number of descriptor set units to update.
+ * @param data_stride Stride in bytes between the data blocks of consecutive descriptor set units.
+ * @param p_data Valid pointer to the packed data block of the first descriptor set unit.
+ * @param[in,out] p_pipeline_pool Valid pointer to the ShVkPipelinePool structure.
+ * 
+ * @return 1 if successful, 0 otherwise or if a descriptor set unit was allocated with another set layout.
+ */
+extern uint8_t shPipelinePoolUpdateDescriptorSetUnitsWithTemplate(
+	VkDevice          device,
+	uint32_t          set_layout_idx,
+	uint32_t          first_descriptor_set_unit,
+	uint32_t          descriptor_set_unit_count,
+	uint32_t          data_stride,
+	void*             p_data,
+	ShVkPipelinePool* p_pipeline_pool
+);
+
+/**
+ * @brief Destroys descriptor update templates in the pipeline pool.
+ * 
+ * This function destroys a range of descriptor update templates in the pipeline pool.
+ * 
+ * @param device Valid Vulkan device.
+ * @param first_template Index of the first descriptor update template to destroy.
+ * @param template_count Number of descriptor update templates to destroy.
+ * @param[in,out] p_pipeline_pool Valid pointer to the ShVkPipelinePool structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shPipelinePoolDestroyDescriptorUpdateTemplates(
+	VkDevice          device,
+	uint32_t          first_template,
+	uint32_t          template_count,
+	ShVkPipelinePool* p_pipeline_pool
+);
+
+
+
+#define SH_MAX_MULTI_DEVICE_COUNT            SH_MAX_STACK_PHYSICAL_DEVICE_COUNT
+#define SH_MULTI_DEVICE_MIN_THROUGHPUT_RATIO 0.02f//smallest weight relative to the largest, so every device keeps being measured
+
+/**
+ * @brief One logical device per suitable physical device, used to split a compute workload.
+ * 
+ * Each device owns a compute queue, a command pool, a primary command buffer and a fence. Work is expressed in
+ * abstract units (elements of a 1-D dispatch, rows of a 2-D dispatch) and split by shMultiDevicePartitionWork
+ * in proportion to the throughput of each device. When timestamps are supported, shMultiDeviceSubmit measures
+ * every device and updates the throughputs, so the next partition follows the observed speed. Input and output
+ * buffers are split and gathered per device with shMultiDeviceScatter and shMultiDeviceGather.
+ * With SH_VULKAN_DEVICE_DISPATCH, a table can be loaded for every device, calls resolve the table of their device.
+ */
+typedef struct ShVkMultiDevice {
+	uint32_t         device_count;                                    ///< Number of opened devices.
+	VkPhysicalDevice physical_devices    [SH_MAX_MULTI_DEVICE_COUNT]; ///< Physical devices, best ranked first.
+	VkDevice         devices             [SH_MAX_MULTI_DEVICE_COUNT]; ///< Logical devices.
+	uint32_t         queue_family_indices[SH_MAX_MULTI_DEVICE_COUNT]; ///< Compute queue family of each device.
+	VkQueue          queues              [SH_MAX_MULTI_DEVICE_COUNT]; ///< Compute queue of each device.
+	VkCommandPool    cmd_pools           [SH_MAX_MULTI_DEVICE_COUNT]; ///< Command pool of each device.
+	VkCommandBuffer  cmd_buffers         [SH_MAX_MULTI_DEVICE_COUNT]; ///< Command buffer recorded for each device.
+	VkFence          fences              [SH_MAX_MULTI_DEVICE_COUNT]; ///< Fence signaled when a device has finished.
+	VkQueryPool      query_pools         [SH_MAX_MULTI_DEVICE_COUNT]; ///< Timestamp query pool, `VK_NULL_HANDLE` when timestamps are not supported.
+	float            timestamp_periods   [SH_MAX_MULTI_DEVICE_COUNT]; ///< Nanoseconds per timestamp tick.
+	float            throughputs         [SH_MAX_MULTI_DEVICE_COUNT]; ///< Relative speed of each device, used as partition weight.
+	uint32_t         first_work_units    [SH_MAX_MULTI_DEVICE_COUNT]; ///< First work unit assigned to each device.
+	uint32_t         work_unit_counts    [SH_MAX_MULTI_DEVICE_COUNT]; ///< Number of work units assigned to each device.
+} ShVkMultiDevice;
+
+/**
+ * @brief Allocates a ShVkMultiDevice structure on the heap.
+ * 
+ * @return Pointer to the zero initialized structure, `NULL` on failure.
+ */
+#define shAllocateMultiDevice() ((ShVkMultiDevice*)calloc(1, sizeof(ShVkMultiDevice)))
+
+/**
+ * @brief Releases a ShVkMultiDevice structure allocated with shAllocateMultiDevice.
+ * 
+ * Call shDestroyMultiDevice first.
+ * 
+ * @param p_multi_device Pointer to the structure.
+ */
+#define shFreeMultiDevice free
+
+/**
+ * @brief Opens a logical device on every physical device supporting compute.
+ * 
+ * Devices are ranked with shRankPhysicalDevices. Dedicated compute queue families are preferred. The initial
+ * throughputs are the benchmarked copy bandwidths when p_benchmark_cache is valid, otherwise all devices weight 1.
+ * On failure the devices opened so far are destroyed.
+ * 
+ * @param instance Valid Vulkan instance.
+ * @param p_benchmark_cache Optional pointer to the ShVkPhysicalDeviceBenchmarkCache structure.
+ * @param extension_count Number of device extensions to enable on every device.
+ * @param pp_extension_names Array of device extension names, can be `VK_NULL_HANDLE` if extension_count is 0.
+ * @param[out] p_multi_device Valid pointer to a zero initialized ShVkMultiDevice structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shCreateMultiDevice(
+	VkInstance                        instance,
+	ShVkPhysicalDeviceBenchmarkCache* p_benchmark_cache,
+	uint32_t                          extension_count,
+	char**                            pp_extension_names,
+	ShVkMultiDevice*                  p_multi_device
+);
+
+/**
+ * @brief Splits a range of work units across the devices in proportion to their throughputs.
+ * 
+ * Every share except the last is rounded down to a multiple of work_unit_alignment, the last device receives the
+ * remainder. Weights are clamped to SH_MULTI_DEVICE_MIN_THROUGHPUT_RATIO of the largest one.
+ * Results are written to the first_work_units and work_unit_counts members. For a 2-D dispatch, split rows
+ * and dispatch the full width on every device.
+ * 
+ * @param work_unit_count Total number of work units.
+ * @param work_unit_alignment Granularity of every share, usually the workgroup size along the split axis.
+ * @param[in,out] p_multi_device Valid pointer to the ShVkMultiDevice structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shMultiDevicePartitionWork(
+	uint32_t         work_unit_count,
+	uint32_t         work_unit_alignment,
+	ShVkMultiDevice* p_multi_device
+);
+
+/**
+ * @brief Begins the command buffer of every device.
+ * 
+ * When timestamps are supported a timestamp is written at the start of every command buffer.
+ * 
+ * @param[in,out] p_multi_device Valid pointer to the ShVkMultiDevice structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shMultiDeviceBeginCommandBuffers(
+	ShVkMultiDevice* p_multi_device
+);
+
+/**
+ * @brief Ends the command buffer of every device.
+ * 
+ * @param[in,out] p_multi_device Valid pointer to the ShVkMultiDevice structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shMultiDeviceEndCommandBuffers(
+	ShVkMultiDevice* p_multi_device
+);
+
+/**
+ * @brief Submits the command buffer of every device and waits for all of them.
+ * 
+ * All devices run concurrently. When every device supports timestamps, throughputs are updated with the
+ * number of work units processed per nanosecond. Devices which received no work are set to the minimum weight,
+ * so that they receive a share again and are measured by the next submission.
+ * 
+ * @param[in,out] p_multi_device Valid pointer to the ShVkMultiDevice structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shMultiDeviceSubmit(
+	ShVkMultiDevice* p_multi_device
+);
+
+/**
+ * @brief Creates one buffer of the same size on every device, bound to its own memory.
+ * 
+ * @param size Size in bytes of every buffer, usually the size of the whole workload so that any partition fits.
+ * @param usage Buffer usage.
+ * @param memory_property_flags Memory properties, must contain `VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT` to use
+ * shMultiDeviceScatter and shMultiDeviceGather, which are given the same flags.
+ * @param[out] p_buffers Valid pointer to an array of device_count buffers.
+ * @param[out] p_memories Valid pointer to an array of device_count memories.
+ * @param p_multi_device Valid pointer to the ShVkMultiDevice structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shMultiDeviceCreateBuffers(
+	uint32_t              size,
+	VkBufferUsageFlags    usage,
+	VkMemoryPropertyFlags memory_property_flags,
+	VkBuffer*             p_buffers,
+	VkDeviceMemory*       p_memories,
+	ShVkMultiDevice*      p_multi_device
+);
+
+/**
+ * @brief Copies the share of every device from a host array to its buffer memory.
+ * 
+ * Device i receives work_unit_counts[i] units starting at first_work_units[i], written at dst_offset, so that its
+ * dispatch indexes its own share from 0. Call it after shMultiDevicePartitionWork. Memories without
+ * `VK_MEMORY_PROPERTY_HOST_COHERENT_BIT` are flushed after the copy.
+ * 
+ * @param work_unit_size Size in bytes of a work unit, e.g. one element or one row.
+ * @param p_src Valid pointer to the host data of all the work units.
+ * @param p_dst_memories Valid pointer to an array of device_count host visible memories.
+ * @param dst_offset Offset in bytes of the share inside every memory.
+ * @param memory_property_flags Memory properties the memories were created with, see shMultiDeviceCreateBuffers.
+ * @param p_multi_device Valid pointer to the ShVkMultiDevice structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shMultiDeviceScatter(
+	uint32_t              work_unit_size,
+	void*                 p_src,
+	VkDeviceMemory*       p_dst_memories,
+	uint32_t              dst_offset,
+	VkMemoryPropertyFlags memory_property_flags,
+	ShVkMultiDevice*      p_multi_device
+);
+
+/**
+ * @brief Copies the share of every device from its buffer memory back to a host array.
+ * 
+ * Inverse of shMultiDeviceScatter: the results of device i are written at first_work_units[i] in p_dst.
+ * Call it after shMultiDeviceSubmit, with the partition used for the submission. Memories without
+ * `VK_MEMORY_PROPERTY_HOST_COHERENT_BIT` are invalidated before the copy.
+ * 
+ * @param work_unit_size Size in bytes of a work unit.
+ * @param p_src_memories Valid pointer to an array of device_count host visible memories.
+ * @param src_offset Offset in bytes of the share inside every memory.
+ * @param memory_property_flags Memory properties the memories were created with, see shMultiDeviceCreateBuffers.
+ * @param p_dst Valid pointer to the host array receiving all the work units.
+ * @param p_multi_device Valid pointer to the ShVkMultiDevice structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shMultiDeviceGather(
+	uint32_t              work_unit_size,
+	VkDeviceMemory*       p_src_memories,
+	uint32_t              src_offset,
+	VkMemoryPropertyFlags memory_property_flags,
+	void*                 p_dst,
+	ShVkMultiDevice*      p_multi_device
+);
+
+/**
+ * @brief Destroys buffers created with shMultiDeviceCreateBuffers.
+ * 
+ * @param p_buffers Valid pointer to an array of device_count buffers.
+ * @param p_memories Valid pointer to an array of device_count memories.
+ * @param p_multi_device Valid pointer to the ShVkMultiDevice structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shMultiDeviceDestroyBuffers(
+	VkBuffer*        p_buffers,
+	VkDeviceMemory*  p_memories,
+	ShVkMultiDevice* p_multi_device
+);
+
+/**
+ * @brief Destroys the command pools, fences, query pools and logical devices of a ShVkMultiDevice structure.
+ * 
+ * @param[in,out] p_multi_device Valid pointer to the ShVkMultiDevice structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shDestroyMultiDevice(
+	ShVkMultiDevice* p_multi_device
+);
+
+
+#define SH_MAX_COMPUTE_SCHEDULER_QUEUE_COUNT      16
+#define SH_COMPUTE_SCHEDULER_CMD_BUFFER_RING_SIZE 8
+#define SH_MAX_COMPUTE_JOB_DEPENDENCY_COUNT       16
+
+typedef enum ShVkComputeSchedulePolicy {
+	SH_COMPUTE_SCHEDULE_ROUND_ROBIN  = 0,
+	SH_COMPUTE_SCHEDULE_LEAST_LOADED = 1
+} ShVkComputeSchedulePolicy;
+
+/**
+ * @brief Completion handle of a job submitted through a ShVkComputeScheduler.
+ * 
+ * A job is complete once the timeline semaphore of its queue reaches timeline_value.
+ */
+typedef struct ShVkComputeJob {
+	uint32_t        queue_idx;      ///< Scheduler queue running the job.
+	uint64_t        timeline_value; ///< Value signaled on the queue timeline semaphore when the job completes.
+	VkCommandBuffer cmd_buffer;     ///< Command buffer to record the job into, valid between begin and submit.
+} ShVkComputeJob;
+
+/**
+ * @brief Spreads independent compute jobs across several queues of one family.
+ * 
+ * Every queue owns a command pool, a ring of SH_COMPUTE_SCHEDULER_CMD_BUFFER_RING_SIZE command buffers and a timeline
+ * semaphore counting its completed jobs. Command buffers are recycled once the job which last used them has completed.
+ */
+typedef struct ShVkComputeScheduler {
+	ShVkComputeSchedulePolicy policy;                                                                                               ///< Queue selection policy.
+	uint32_t                  queue_family_index;                                                                                   ///< Queue family of all queues.
+	uint32_t                  queue_count;                                                                                          ///< Number of scheduled queues.
+	uint32_t                  next_queue_idx;                                                                                       ///< Next queue for round robin, first candidate for least loaded.
+	VkQueue                   queues             [SH_MAX_COMPUTE_SCHEDULER_QUEUE_COUNT];                                            ///< Scheduled queues.
+	VkCommandPool             cmd_pools          [SH_MAX_COMPUTE_SCHEDULER_QUEUE_COUNT];                                            ///< Command pool of each queue.
+	VkSemaphore               timeline_semaphores[SH_MAX_COMPUTE_SCHEDULER_QUEUE_COUNT];                                            ///< Timeline semaphore of each queue.
+	uint64_t                  timeline_values    [SH_MAX_COMPUTE_SCHEDULER_QUEUE_COUNT];                                            ///< Last value reserved on each queue.
+	VkCommandBuffer           cmd_buffers        [SH_MAX_COMPUTE_SCHEDULER_QUEUE_COUNT][SH_COMPUTE_SCHEDULER_CMD_BUFFER_RING_SIZE]; ///< Command buffer ring of each queue.
+} ShVkComputeScheduler;
+
+/**
+ * @brief Allocates a ShVkComputeScheduler structure on the heap.
+ * 
+ * @return Pointer to the zero initialized structure, `NULL` on failure.
+ */
+#define shAllocateComputeScheduler() ((ShVkComputeScheduler*)calloc(1, sizeof(ShVkComputeScheduler)))
+
+/**
+ * @brief Releases a ShVkComputeScheduler structure allocated with shAllocateComputeScheduler.
+ * 
+ * Call shDestroyComputeScheduler first.
+ * 
+ * @param p_scheduler Pointer to the structure.
+ */
+#define shFreeComputeScheduler free
+
+/**
+ * @brief Creates a compute scheduler over the first queue_count queues of a family.
+ * 
+ * The device must have been created with at least queue_count queues of queue_family_index and with the
+ * vulkan12.timelineSemaphore feature enabled (see shNegotiateDeviceFeatures).
+ * 
+ * @param device Valid Vulkan device.
+ * @param queue_family_index Queue family supporting compute.
+ * @param queue_count Number of queues to schedule, at most SH_MAX_COMPUTE_SCHEDULER_QUEUE_COUNT.
+ * @param policy Queue selection policy.
+ * @param[out] p_scheduler Valid pointer to a zero initialized ShVkComputeScheduler structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shCreateComputeScheduler(
+	VkDevice                  device,
+	uint32_t                  queue_family_index,
+	uint32_t                  queue_count,
+	ShVkComputeSchedulePolicy policy,
+	ShVkComputeScheduler*     p_scheduler
+);
+
+/**
+ * @brief Picks a queue for a new job and begins its command buffer.
+ * 
+ * Jobs begun on the same queue must be submitted in the same order, since their timeline values are reserved here.
+ * Blocks only when the command buffer ring of the chosen queue is full of running jobs.
+ * 
+ * @param device Valid Vulkan device.
+ * @param[in,out] p_scheduler Valid pointer to the ShVkComputeScheduler structure.
+ * @param[out] p_job Valid pointer to the job handle, its cmd_buffer is ready for recording.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shComputeSchedulerBeginJob(
+	VkDevice              device,
+	ShVkComputeScheduler* p_scheduler,
+	ShVkComputeJob*       p_job
+);
+
+/**
+ * @brief Ends the command buffer of a job and submits it to its queue.
+ * 
+ * The job can wait for other jobs, possibly on other queues, before its compute stage starts.
+ * 
+ * @param p_scheduler Valid pointer to the ShVkComputeScheduler structure.
+ * @param p_job Valid pointer to the job handle returned by shComputeSchedulerBeginJob.
+ * @param dependency_count Number of jobs to wait for, at most SH_MAX_COMPUTE_JOB_DEPENDENCY_COUNT.
+ * @param p_dependencies Array of job handles to wait for, can be `VK_NULL_HANDLE` if dependency_count is 0.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shComputeSchedulerSubmitJob(
+	ShVkComputeScheduler* p_scheduler,
+	ShVkComputeJob*       p_job,
+	uint32_t              dependency_count,
+	ShVkComputeJob*       p_dependencies
+);
+
+/**
+ * @brief Checks whether a job has completed, without blocking.
+ * 
+ * @param device Valid Vulkan device.
+ * @param p_scheduler Valid pointer to the ShVkComputeScheduler structure.
+ * @param p_job Valid pointer to the job handle.
+ * @param[out] p_completed Valid destination pointer to the completion flag.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shComputeSchedulerGetJobStatus(
+	VkDevice              device,
+	ShVkComputeScheduler* p_scheduler,
+	ShVkComputeJob*       p_job,
+	uint8_t*              p_completed
+);
+
+/**
+ * @brief Waits for a job to complete.
+ * 
+ * @param device Valid Vulkan device.
+ * @param p_scheduler Valid pointer to the ShVkComputeScheduler structure.
+ * @param p_job Valid pointer to the job handle.
+ * @param timeout_ns Timeout in nanoseconds.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shComputeSchedulerWaitJob(
+	VkDevice              device,
+	ShVkComputeScheduler* p_scheduler,
+	ShVkComputeJob*       p_job,
+	uint64_t              timeout_ns
+);
+
+/**
+ * @brief Waits for every job submitted to the scheduler.
+ * 
+ * @param device Valid Vulkan device.
+ * @param p_scheduler Valid pointer to the ShVkComputeScheduler structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shComputeSchedulerWaitIdle(
+	VkDevice              device,
+	ShVkComputeScheduler* p_scheduler
+);
+
+/**
+ * @brief Destroys the command pools and timeline semaphores of a compute scheduler.
+ * 
+ * @param device Valid Vulkan device.
+ * @param[in,out] p_scheduler Valid pointer to the ShVkComputeScheduler structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shDestroyComputeScheduler(
+	VkDevice              device,
+	ShVkComputeScheduler* p_scheduler
+);
+
+
+
+
+#define SH_MAX_RELEASE_QUEUE_SIZE 256
+
+typedef enum ShVkReleaseType {
+	SH_RELEASE_TYPE_SWAPCHAIN     = 0,
+	SH_RELEASE_TYPE_IMAGE_VIEW    = 1,
+	SH_RELEASE_TYPE_FRAMEBUFFER   = 2,
+	SH_RELEASE_TYPE_IMAGE         = 3,
+	SH_RELEASE_TYPE_BUFFER        = 4,
+	SH_RELEASE_TYPE_DEVICE_MEMORY = 5,
+	SH_RELEASE_TYPE_RENDERPASS    = 6,
+	SH_RELEASE_TYPE_PIPELINE      = 7,
+	SH_RELEASE_TYPE_SEMAPHORE     = 8
+} ShVkReleaseType;
+
+/**
+ * @brief Handle of a deferred release, the member is selected by ShVkReleaseType.
+ */
+typedef union ShVkReleaseHandle {
+	VkSwapchainKHR swapchain;
+	VkImageView    image_view;
+	VkFramebuffer  framebuffer;
+	VkImage        image;
+	VkBuffer       buffer;
+	VkDeviceMemory memory;
+	VkRenderPass   renderpass;
+	VkPipeline     pipeline;
+	VkSemaphore    semaphore;
+} ShVkReleaseHandle;
+
+/**
+ * @brief Object destroyed once the submission following its release has completed.
+ */
+typedef struct ShVkDeferredRelease {
+	ShVkReleaseType   type;             ///< Object type.
+	ShVkReleaseHandle handle;           ///< Object handle.
+	uint64_t          submission_value; ///< Last submission which could still use the object.
+} ShVkDeferredRelease;
+
+/**
+ * @brief Queue of objects waiting for the GPU to stop using them.
+ * 
+ * Releases are keyed on a monotonically increasing submission counter, advanced by shReleaseQueueSubmit for every
+ * queue submission which may use released objects. The queue never waits: the application reports which submission
+ * has completed (e.g. the value submitted with a frame fence it just waited for, or a timeline semaphore value) to
+ * shCollectReleases, so frame fences can be reset and reused freely.
+ */
+typedef struct ShVkReleaseQueue {
+	uint64_t            submission_count;                    ///< Value of the last submission counted by shReleaseQueueSubmit.
+	uint32_t            release_count;                       ///< Number of pending releases.
+	ShVkDeferredRelease releases[SH_MAX_RELEASE_QUEUE_SIZE]; ///< Pending releases, in release order.
+} ShVkReleaseQueue;
+
+/**
+ * @brief Allocates a ShVkReleaseQueue structure on the heap.
+ */
+#define shAllocateReleaseQueue() ((ShVkReleaseQueue*)calloc(1, sizeof(ShVkReleaseQueue)))
+
+/**
+ * @brief Frees a ShVkReleaseQueue structure, pending releases must have been collected.
+ */
+#define shFreeReleaseQueue free
+
+/**
+ * @brief Queues an object for destruction once the next submission has completed.
+ * 
+ * The object may still be used by every submission counted so far and by the one being recorded.
+ * 
+ * @param type Object type.
+ * @param handle Object handle, `VK_NULL_HANDLE` handles are ignored.
+ * @param[in,out] p_release_queue Valid pointer to the ShVkReleaseQueue structure.
+ * 
+ * @return 1 if successful, 0 otherwise or if the queue is full.
+ */
+extern uint8_t shDeferRelease(
+	ShVkReleaseType   type,
+	ShVkReleaseHandle handle,
+	ShVkReleaseQueue* p_release_queue
+);
+
+/**
+ * @brief Counts a queue submission, call it when submitting work which may use released objects.
+ * 
+ * Keep the returned value with the fence or timeline semaphore value of the submission, and pass it to
+ * shCollectReleases once the submission is known to be complete.
+ * 
+ * @param[in,out] p_release_queue Valid pointer to the ShVkReleaseQueue structure.
+ * @param[out] p_submission_value Valid destination pointer to the value of the submission, starting from 1.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shReleaseQueueSubmit(
+	ShVkReleaseQueue* p_release_queue,
+	uint64_t*         p_submission_value
+);
+
+/**
+ * @brief Destroys the queued objects whose last submission has completed, without waiting.
+ * 
+ * Submissions to the same queue complete in order, so waiting for the fence of a submission completes every earlier
+ * one. Before destroying the device, wait for it to be idle and pass `UINT64_MAX`.
+ * 
+ * @param device Valid Vulkan device.
+ * @param completed_submission_value Value of a completed submission, see shReleaseQueueSubmit. 0 if none completed.
+ * @param[in,out] p_release_queue Valid pointer to the ShVkReleaseQueue structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shCollectReleases(
+	VkDevice          device,
+	uint64_t          completed_submission_value,
+	ShVkReleaseQueue* p_release_queue
+);
+
+/**
+ * @brief Replaces a swapchain without waiting for the device to be idle.
+ * 
+ * The new swapchain is created with the current one as oldSwapchain, so the presentation engine can keep showing
+ * the retired images while the new ones are set up. The retired swapchain and its image views are queued in
+ * p_release_queue. Objects depending on the swapchain extent (framebuffers, depth and
+ * multisample attachments) must be released the same way by the caller. The render pass can be kept when
+ * p_format_changed is 0.
+ * 
+ * @param device Valid Vulkan device.
+ * @param physical_device Valid Vulkan physical device.
+ * @param surface Valid Vulkan surface, the same of the current swapchain.
+ * @param image_sharing_mode Sharing mode for the swapchain images.
+ * @param present_policy Present mode selection policy.
+ * @param swapchain_image_count Number of images in the swapchain, 0 to choose it from the present mode.
+ * @param[in,out] p_release_queue Valid pointer to the ShVkReleaseQueue structure.
+ * @param[in,out] p_swapchain Valid pointer to the current swapchain, replaced by the new one.
+ * @param[in,out] p_image_format Valid pointer to the current image format, replaced by the new one.
+ * @param[in,out] p_swapchain_image_count Valid pointer to the current image count, replaced by the new one.
+ * @param[in,out] p_swapchain_images Valid pointer to an array of at least the new image count images.
+ * @param[in,out] p_swapchain_image_views Valid pointer to an array of at least the new image count image views.
+ * @param[out] p_format_changed Optional destination pointer set to 1 when the image format changed.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shRecreateSwapchain(
+	VkDevice          device,
+	VkPhysicalDevice  physical_device,
+	VkSurfaceKHR      surface,
+	VkSharingMode     image_sharing_mode,
+	ShVkPresentPolicy present_policy,
+	uint32_t          swapchain_image_count,
+	ShVkReleaseQueue* p_release_queue,
+	VkSwapchainKHR*   p_swapchain,
+	VkFormat*         p_image_format,
+	uint32_t*         p_swapchain_image_count,
+	VkImage*          p_swapchain_images,
+	VkImageView*      p_swapchain_image_views,
+	uint8_t*          p_format_changed
+);
+
+
+
+
+#define SH_MAX_READBACK_SLOT_COUNT 8
+
+/**
+ * @brief Multi buffered image readback.
+ * 
+ * Each slot owns a persistently mapped host visible buffer, a command buffer and a fence. Slots are used in
+ * order: frame k can be copied to slot k % slot_count while the CPU still reads older slots, so rendering, copies
+ * and CPU work of consecutive frames overlap. A slot is reused only after it has been released.
+ * 
+ * Memory is host cached when available, which makes CPU reads several times faster than uncached coherent memory.
+ */
+typedef struct ShVkReadbackEngine {
+	uint32_t           slot_count;                                   ///< Number of slots.
+	uint32_t           width;                                        ///< Copied image width.
+	uint32_t           height;                                       ///< Copied image height.
+	uint32_t           texel_size;                                   ///< Size in bytes of a texel of the copied images.
+	VkDeviceSize       slot_size;                                    ///< Size in bytes of a tightly packed image.
+	VkImageAspectFlags image_aspect;                                 ///< Aspect of the copied images.
+	uint32_t           queue_family_index;                           ///< Queue family of the copy submissions.
+	uint8_t            host_coherent;                                ///< 0 when mapped memory must be invalidated before reads.
+	VkCommandPool      cmd_pool;                                     ///< Command pool of the slot command buffers.
+	VkCommandBuffer    cmd_buffers [SH_MAX_READBACK_SLOT_COUNT];     ///< Copy command buffers.
+	VkFence            fences      [SH_MAX_READBACK_SLOT_COUNT];     ///< Signaled when the copy of the slot has completed.
+	VkBuffer           buffers     [SH_MAX_READBACK_SLOT_COUNT];     ///< Destination buffers.
+	VkDeviceMemory     memories    [SH_MAX_READBACK_SLOT_COUNT];     ///< Memory of the destination buffers.
+	void*              p_mapped    [SH_MAX_READBACK_SLOT_COUNT];     ///< Persistently mapped memory.
+	uint64_t           frame_ids   [SH_MAX_READBACK_SLOT_COUNT];     ///< User frame identifier of each slot.
+	uint64_t           submitted_count;                              ///< Number of submitted copies.
+	uint64_t           acquired_count;                               ///< Number of copies handed to the CPU.
+	uint64_t           released_count;                               ///< Number of released slots.
+} ShVkReadbackEngine;
+
+/**
+ * @brief Allocates a ShVkReadbackEngine structure on the heap.
+ */
+#define shAllocateReadbackEngine() ((ShVkReadbackEngine*)calloc(1, sizeof(ShVkReadbackEngine)))
+
+/**
+ * @brief Frees a ShVkReadbackEngine structure.
+ */
+#define shFreeReadbackEngine free
+
+/**
+ * @brief Creates the slots of a readback engine.
+ * 
+ * @param device Valid Vulkan device.
+ * @param physical_device Valid Vulkan physical device.
+ * @param queue_family_index Queue family supporting transfer operations, used for the copies.
+ * @param slot_count Number of slots, at most SH_MAX_READBACK_SLOT_COUNT. 3 lets render, copy and CPU work overlap.
+ * @param width Width of the copied images.
+ * @param height Height of the copied images.
+ * @param texel_size Size in bytes of a texel of the copied images, width * height * texel_size must not exceed 4 GiB.
+ * @param image_aspect Aspect of the copied images.
+ * @param[out] p_engine Valid pointer to a zero initialized ShVkReadbackEngine structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shCreateReadbackEngine(
+	VkDevice            device,
+	VkPhysicalDevice    physical_device,
+	uint32_t            queue_family_index,
+	uint32_t            slot_count,
+	uint32_t            width,
+	uint32_t            height,
+	uint32_t            texel_size,
+	VkImageAspectFlags  image_aspect,
+	ShVkReadbackEngine* p_engine
+);
+
+/**
+ * @brief Submits the copy of an image to the next slot.
+ * 
+ * The image is moved to `VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL` for the copy, then back to image_layout.
+ * 
+ * @param device Valid Vulkan device.
+ * @param queue Valid queue of the engine queue family.
+ * @param image Valid image of the engine size, rendered by previous submissions.
+ * @param image_layout Layout of the image when the copy starts and after it ends.
+ * @param wait_semaphore Semaphore signaled by the rendering submission, can be `VK_NULL_HANDLE` when the rendering was submitted earlier to the same queue.
+ * @param frame_id User identifier returned with the copied data.
+ * @param[in,out] p_engine Valid pointer to the ShVkReadbackEngine structure.
+ * 
+ * @return 1 if successful, 0 otherwise or if every slot is still in use.
+ */
+extern uint8_t shReadbackEngineSubmit(
+	VkDevice            device,
+	VkQueue             queue,
+	VkImage             image,
+	VkImageLayout       image_layout,
+	VkSemaphore         wait_semaphore,
+	uint64_t            frame_id,
+	ShVkReadbackEngine* p_engine
+);
+
+/**
+ * @brief Retrieves the oldest completed copy which was not retrieved yet.
+ * 
+ * Rows are tightly packed, width * texel_size bytes each. The data stays valid until the slot is released with
+ * shReadbackEngineRelease.
+ * 
+ * @param device Valid Vulkan device.
+ * @param timeout_ns Time to wait for the copy, 0 to return immediately.
+ * @param[in,out] p_engine Valid pointer to the ShVkReadbackEngine structure.
+ * @param[out] p_ready Valid destination pointer set to 1 when a copy was retrieved.
+ * @param[out] pp_data Valid destination pointer to the mapped image data.
+ * @param[out] p_frame_id Optional destination pointer to the frame identifier given at submission.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shReadbackEngineAcquire(
+	VkDevice            device,
+	uint64_t            timeout_ns,
+	ShVkReadbackEngine* p_engine,
+	uint8_t*            p_ready,
+	void**              pp_data,
+	uint64_t*           p_frame_id
+);
+
+/**
+ * @brief Releases the oldest retrieved slot, so it can receive new copies.
+ * 
+ * @param[in,out] p_engine Valid pointer to the ShVkReadbackEngine structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shReadbackEngineRelease(
+	ShVkReadbackEngine* p_engine
+);
+
+/**
+ * @brief Waits for the pending copies and destroys the slots of a readback engine.
+ * 
+ * @param device Valid Vulkan device.
+ * @param[in,out] p_engine Valid pointer to the ShVkReadbackEngine structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shDestroyReadbackEngine(
+	VkDevice            device,
+	ShVkReadbackEngine* p_engine
+);
+
+
+
+
+/**
+ * @brief Reads a monotonic clock, for frame and stage timings.
+ * 
+ * @return Time in nanoseconds from an arbitrary origin.
+ */
+extern uint64_t shGetTimeNs(
+	void
+);
+
+#define SH_MAX_FRAME_WRITER_QUEUE_SIZE 16
+
+typedef enum ShVkFrameFileFormat {
+	SH_FRAME_FILE_FORMAT_RAW = 0, ///< Frames are written as they are, one after the other.
+	SH_FRAME_FILE_FORMAT_PPM = 1  ///< Frames are written as a sequence of binary PPM (P6) images, alpha is dropped.
+} ShVkFrameFileFormat;
+
+/**
+ * @brief Writes frames to a file from a background thread.
+ * 
+ * Frames are not copied: the pushed data, usually the mapped memory of a readback slot, must stay valid until
+ * written_count includes the frame. Frames are written in push order.
+ */
+typedef struct ShVkFrameWriter {
+	FILE*               stream;                                    ///< Output file.
+	ShVkFrameFileFormat format;                                    ///< Output file format.
+	uint32_t            width;                                     ///< Frame width.
+	uint32_t            height;                                    ///< Frame height.
+	uint32_t            texel_size;                                ///< Size in bytes of a texel, 3 or 4 for PPM output.
+	uint8_t             bgra;                                      ///< 1 when texels are stored as B8G8R8(A8), PPM output only.
+	uint8_t*            p_row;                                     ///< Row conversion memory of PPM output.
+	const void*         p_frames[SH_MAX_FRAME_WRITER_QUEUE_SIZE];  ///< Queued frames.
+	uint64_t            pushed_count;                              ///< Number of pushed frames.
+	uint64_t            written_count;                             ///< Number of written frames.
+	uint64_t            written_bytes;                             ///< Number of written bytes.
+	uint64_t            write_time_ns;                             ///< Time spent by the writer thread writing frames.
+	uint8_t             failed;                                    ///< 1 after a failed write, later frames are dropped.
+	uint8_t             stop;                                      ///< Set when the writer is closing.
+	void*               p_thread;                                  ///< Writer thread and synchronization objects.
+} ShVkFrameWriter;
+
+/**
+ * @brief Allocates a ShVkFrameWriter structure on the heap.
+ */
+#define shAllocateFrameWriter() ((ShVkFrameWriter*)calloc(1, sizeof(ShVkFrameWriter)))
+
+/**
+ * @brief Frees a ShVkFrameWriter structure.
+ */
+#define shFreeFrameWriter free
+
+/**
+ * @brief Opens the output file and starts the writer thread.
+ * 
+ * @param path Valid path of the output file, overwritten if it exists.
+ * @param format Output file format.
+ * @param width Frame width.
+ * @param height Frame height.
+ * @param texel_size Size in bytes of a texel, rows are tightly packed.
+ * @param bgra 1 when texels are stored as B8G8R8(A8) and must be swizzled for PPM output.
+ * @param[out] p_writer Valid pointer to a zero initialized ShVkFrameWriter structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shOpenFrameWriter(
+	const char*         path,
+	ShVkFrameFileFormat format,
+	uint32_t            width,
+	uint32_t            height,
+	uint32_t            texel_size,
+	uint8_t             bgra,
+	ShVkFrameWriter*    p_writer
+);
+
+/**
+ * @brief Queues a frame for writing, blocks while SH_MAX_FRAME_WRITER_QUEUE_SIZE frames are queued.
+ * 
+ * @param p_data Valid pointer to the frame data, kept until the frame is written.
+ * @param[in,out] p_writer Valid pointer to the ShVkFrameWriter structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shFrameWriterPush(
+	const void*      p_data,
+	ShVkFrameWriter* p_writer
+);
+
+/**
+ * @brief Retrieves the number of frames written so far.
+ * 
+ * @param timeout_ns Time to wait for at least min_written_count written frames, 0 to return immediately.
+ * @param min_written_count Number of written frames to wait for.
+ * @param[in,out] p_writer Valid pointer to the ShVkFrameWriter structure.
+ * @param[out] p_written_count Valid destination pointer to the number of written frames.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shFrameWriterGetWrittenCount(
+	uint64_t         timeout_ns,
+	uint64_t         min_written_count,
+	ShVkFrameWriter* p_writer,
+	uint64_t*        p_written_count
+);
+
+/**
+ * @brief Writes the queued frames, stops the writer thread and closes the output file.
+ * 
+ * @param[in,out] p_writer Valid pointer to the ShVkFrameWriter structure.
+ * 
+ * @return 1 if every frame was written, 0 otherwise.
+ */
+extern uint8_t shCloseFrameWriter(
+	ShVkFrameWriter* p_writer
+);
+
+
+
+
+#define SH_MAX_PIXEL_CONVERSION_THREAD_COUNT  16
+#define SH_PIXEL_CONVERSION_PIXELS_PER_THREAD (1u << 18)
+
+typedef enum ShVkPixelConversion {
+	SH_PIXEL_CONVERSION_COPY             = 0, ///< 8 bit RGBA or BGRA texels are copied, only the row padding is removed.
+	SH_PIXEL_CONVERSION_SWIZZLE_RB       = 1, ///< B8G8R8A8 to R8G8B8A8 and vice versa.
+	SH_PIXEL_CONVERSION_PREMULTIPLY      = 2, ///< 8 bit color channels are multiplied by alpha, stored in the fourth byte.
+	SH_PIXEL_CONVERSION_UNPREMULTIPLY    = 3, ///< 8 bit color channels are divided by alpha, stored in the fourth byte.
+	SH_PIXEL_CONVERSION_RGBA32F_TO_RGBA8 = 4  ///< R32G32B32A32_SFLOAT to R8G8B8A8_UNORM, values are clamped to [0, 1] and rounded.
+} ShVkPixelConversion;
+
+typedef enum ShVkPixelIsa {
+	SH_PIXEL_ISA_SCALAR = 0, ///< Portable C.
+	SH_PIXEL_ISA_SSE2   = 1, ///< x86 SSE2.
+	SH_PIXEL_ISA_AVX2   = 2, ///< x86 AVX2, detected at runtime.
+	SH_PIXEL_ISA_NEON   = 3  ///< AArch64 NEON.
+} ShVkPixelIsa;
+
+/**
+ * @brief Retrieves the instruction set used by shConvertPixels.
+ * 
+ * The fastest instruction set supported by the compiler and the running processor is selected on first use.
+ * 
+ * @return The instruction set in use.
+ */
+extern ShVkPixelIsa shGetPixelConversionIsa(
+	void
+);
+
+/**
+ * @brief Forces the instruction set used by shConvertPixels, to compare or validate implementations.
+ * 
+ * @param isa Instruction set supported by the build and the running processor.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shSetPixelConversionIsa(
+	ShVkPixelIsa isa
+);
+
+/**
+ * @brief Converts the texels of a readback image, removing the row padding of the source.
+ * 
+ * For mapped linear images, p_src is the mapped memory plus VkSubresourceLayout::offset and src_row_pitch is
+ * VkSubresourceLayout::rowPitch, both from shGetImageSubresourceLayout. Conversions can run in place when
+ * dst_row_pitch is not larger than src_row_pitch, on the calling thread only unless both row pitches match.
+ * 
+ * Rows are split between the calling thread and a pool of worker threads, started on the first multithreaded
+ * call and kept until the process exits.
+ * 
+ * @param conversion Conversion to run.
+ * @param width Image width.
+ * @param height Image height.
+ * @param p_src Valid pointer to the source texels.
+ * @param src_row_pitch Source row size in bytes, 0 when rows are tightly packed.
+ * @param[out] p_dst Valid pointer to the destination texels.
+ * @param dst_row_pitch Destination row size in bytes, 0 when rows are tightly packed.
+ * @param thread_count Number of threads converting rows, 0 selects it from the image size and the processor count.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shConvertPixels(
+	ShVkPixelConversion conversion,
+	uint32_t            width,
+	uint32_t            height,
+	const void*         p_src,
+	uint64_t            src_row_pitch,
+	void*               p_dst,
+	uint64_t            dst_row_pitch,
+	uint32_t            thread_count
+);
+
+
+
+
+#define SH_PACK_LOCAL_SIZE_X 8
+#define SH_PACK_LOCAL_SIZE_Y 8
+
+typedef enum ShVkPackFormat {
+	SH_PACK_FORMAT_NONE   = 0, ///< No packing, the image is read back as it is.
+	SH_PACK_FORMAT_RGBA8  = 1, ///< 4 bytes per texel.
+	SH_PACK_FORMAT_RGB565 = 2, ///< 2 bytes per texel, the width must be even.
+	SH_PACK_FORMAT_YUV420 = 3  ///< Y, U and V planes, BT.601 limited range, 1.5 bytes per texel. The width must be a multiple of 8, the height a multiple of 2.
+} ShVkPackFormat;
+
+/**
+ * @brief Push constant block of the pack compute shader (examples/shaders/src/pack.comp).
+ */
+typedef struct ShVkPackPushConstants {
+	uint32_t width;      ///< Image width.
+	uint32_t height;     ///< Image height.
+	uint32_t format;     ///< ShVkPackFormat.
+	uint32_t swizzle_rb; ///< 1 when the image is stored as B8G8R8A8.
+} ShVkPackPushConstants;
+
+/**
+ * @brief Retrieves the size of an image packed with shCmdPackImage.
+ * 
+ * @param format Pack format, not SH_PACK_FORMAT_NONE.
+ * @param width Image width.
+ * @param height Image height.
+ * @param[out] p_size Valid destination pointer to the packed size in bytes.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shGetPackedImageSize(
+	ShVkPackFormat format,
+	uint32_t       width,
+	uint32_t       height,
+	VkDeviceSize*  p_size
+);
+
+/**
+ * @brief Records the packing of an 8 bit color image into a tightly packed buffer, before the host reads it back.
+ * 
+ * The image is copied to texel_buffer, then the pack compute pipeline writes packed_buffer, which is made
+ * available to host reads. The pipeline uses pack.comp with two storage buffer descriptor set units, texel_buffer
+ * first and packed_buffer second, and a ShVkPackPushConstants push constant range. The image is returned to image_layout.
+ * 
+ * @param device Valid Vulkan device.
+ * @param cmd_buffer Valid Vulkan command buffer in recording state.
+ * @param image Valid Vulkan image with VK_IMAGE_USAGE_TRANSFER_SRC_BIT, R8G8B8A8 or B8G8R8A8.
+ * @param image_layout Current layout of the image.
+ * @param width Image width.
+ * @param height Image height.
+ * @param swizzle_rb 1 when the image is stored as B8G8R8A8.
+ * @param format Pack format, not SH_PACK_FORMAT_NONE.
+ * @param texel_buffer Valid storage buffer of at least width * height * 4 bytes with VK_BUFFER_USAGE_TRANSFER_DST_BIT.
+ * @param packed_buffer Valid storage buffer of at least the size given by shGetPackedImageSize.
+ * @param first_descriptor_set_unit_idx Index of the descriptor set unit of texel_buffer.
+ * @param p_pipeline_pool Valid pointer to the ShVkPipelinePool structure.
+ * @param p_pipeline Valid pointer to the pack compute ShVkPipeline structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shCmdPackImage(
+	VkDevice          device,
+	VkCommandBuffer   cmd_buffer,
+	VkImage           image,
+	VkImageLayout     image_layout,
+	uint32_t          width,
+	uint32_t          height,
+	uint8_t           swizzle_rb,
+	ShVkPackFormat    format,
+	VkBuffer          texel_buffer,
+	VkBuffer          packed_buffer,
+	uint32_t          first_descriptor_set_unit_idx,
+	ShVkPipelinePool* p_pipeline_pool,
+	ShVkPipeline*     p_pipeline
+);
+
+
+
+
+#define SH_DEFAULT_TILE_SIZE 64
+
+/**
+ * @brief Texel rectangle of an image.
+ */
+typedef struct ShVkTileRect {
+	uint32_t x;      ///< First column.
+	uint32_t y;      ///< First row.
+	uint32_t width;  ///< Number of columns.
+	uint32_t height; ///< Number of rows.
+} ShVkTileRect;
+
+/**
+ * @brief Detects which tiles of a stream of frames changed since the previous frame.
+ * 
+ * Tiles are hashed instead of compared with a copy of the previous frame, so only 8 bytes per tile are kept.
+ */
+typedef struct ShVkTileTracker {
+	uint32_t      width;            ///< Frame width.
+	uint32_t      height;           ///< Frame height.
+	uint32_t      texel_size;       ///< Size in bytes of a texel.
+	uint32_t      tile_size;        ///< Tile width and height, tiles on the right and bottom edges may be smaller.
+	uint32_t      tile_count_x;     ///< Number of tile columns.
+	uint32_t      tile_count_y;     ///< Number of tile rows.
+	uint64_t*     p_hashes;         ///< Tile hashes of the last frame, row major.
+	uint8_t*      p_dirty;          ///< 1 for each tile changed by the last frame.
+	ShVkTileRect* p_dirty_rects;    ///< Dirty rectangles of the last frame, adjacent dirty tiles of a tile row are merged.
+	uint32_t      dirty_rect_count; ///< Number of dirty rectangles of the last frame.
+	uint32_t      dirty_tile_count; ///< Number of dirty tiles of the last frame.
+	uint64_t      dirty_size;       ///< Size in bytes of the texels of the dirty rectangles.
+	uint8_t       full_frame;       ///< 1 when the next update marks every tile dirty.
+} ShVkTileTracker;
+
+/**
+ * @brief Allocates a ShVkTileTracker structure on the heap.
+ */
+#define shAllocateTileTracker() ((ShVkTileTracker*)calloc(1, sizeof(ShVkTileTracker)))
+
+/**
+ * @brief Frees a ShVkTileTracker structure.
+ */
+#define shFreeTileTracker free
+
+/**
+ * @brief Sets up a tile tracker, the first update marks every tile dirty.
+ * 
+ * @param width Frame width.
+ * @param height Frame height.
+ * @param texel_size Size in bytes of a texel.
+ * @param tile_size Tile width and height, e.g. SH_DEFAULT_TILE_SIZE.
+ * @param[out] p_tracker Valid pointer to a zero initialized ShVkTileTracker structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shCreateTileTracker(
+	uint32_t         width,
+	uint32_t         height,
+	uint32_t         texel_size,
+	uint32_t         tile_size,
+	ShVkTileTracker* p_tracker
+);
+
+/**
+ * @brief Hashes the tiles of a new frame and lists the ones which changed since the previous frame.
+ * 
+ * Tile rows are split between the calling thread and the worker threads of shConvertPixels.
+ * 
+ * @param p_src Valid pointer to the frame texels, e.g. a mapped readback buffer.
+ * @param src_row_pitch Frame row size in bytes, 0 when rows are tightly packed.
+ * @param thread_count Number of threads hashing tile rows, 0 selects it from the frame size and the processor count.
+ * @param[in,out] p_tracker Valid pointer to the ShVkTileTracker structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shTileTrackerUpdate(
+	const void*      p_src,
+	uint64_t         src_row_pitch,
+	uint32_t         thread_count,
+	ShVkTileTracker* p_tracker
+);
+
+/**
+ * @brief Copies the texels of the dirty rectangles of the last update, one rectangle after the other with tightly packed rows.
+ * 
+ * @param p_src Valid pointer to the frame texels given to the last update.
+ * @param src_row_pitch Frame row size in bytes, 0 when rows are tightly packed.
+ * @param[out] p_dst Valid pointer to at least ShVkTileTracker::dirty_size bytes.
+ * @param[in] p_tracker Valid pointer to the ShVkTileTracker structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shTileTrackerGatherDirtyTexels(
+	const void*      p_src,
+	uint64_t         src_row_pitch,
+	void*            p_dst,
+	ShVkTileTracker* p_tracker
+);
+
+/**
+ * @brief Marks every tile dirty at the next update, e.g. when a new consumer needs a full frame.
+ * 
+ * @param[in,out] p_tracker Valid pointer to the ShVkTileTracker structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shTileTrackerInvalidate(
+	ShVkTileTracker* p_tracker
+);
+
+/**
+ * @brief Releases the memory of a tile tracker.
+ * 
+ * @param[in,out] p_tracker Valid pointer to the ShVkTileTracker structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shDestroyTileTracker(
+	ShVkTileTracker* p_tracker
+);
+
+
+
+
+#define SH_MIP_LOCAL_SIZE_X 8
+#define SH_MIP_LOCAL_SIZE_Y 8
+
+/**
+ * @brief Retrieves the number of mip levels of a full mip chain, down to a 1x1 level.
+ * 
+ * @param width Width of the first level.
+ * @param height Height of the first level.
+ * @param[out] p_mip_levels Valid destination pointer to the mip level count.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shGetMipLevelCount(
+	uint32_t  width,
+	uint32_t  height,
+	uint32_t* p_mip_levels
+);
+
+/**
+ * @brief Checks whether mip levels of a format can be generated with shCmdGenerateMipsBlit.
+ * 
+ * Optimal tiling images must support blit source, blit destination and, for VK_FILTER_LINEAR, linear filtering.
+ * 
+ * @param physical_device Valid Vulkan physical device.
+ * @param format Format of the mipmapped image.
+ * @param filter Filter used by the blits.
+ * @param[out] p_blit_supported Valid destination pointer, set to 1 when blits are supported, 0 otherwise.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shCheckMipBlitSupport(
+	VkPhysicalDevice physical_device,
+	VkFormat         format,
+	VkFilter         filter,
+	uint8_t*         p_blit_supported
+);
+
+/**
+ * @brief Checks whether mip levels of a format can be generated with shCmdGenerateMipsCompute.
+ * 
+ * Optimal tiling images must support storage image access.
+ * 
+ * @param physical_device Valid Vulkan physical device.
+ * @param format Format of the mipmapped image.
+ * @param[out] p_compute_supported Valid destination pointer, set to 1 when storage images are supported, 0 otherwise.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shCheckMipComputeSupport(
+	VkPhysicalDevice physical_device,
+	VkFormat         format,
+	uint8_t*         p_compute_supported
+);
+
+/**
+ * @brief Fills mip levels 1 to mip_levels - 1 of a 2D image by blitting each level to the next one.
+ * 
+ * Level 0 must hold the texels and be in src_image_layout, the other levels are transitioned from VK_IMAGE_LAYOUT_UNDEFINED.
+ * Each level is made available to the next blit with its own barrier, at the end every level is in dst_image_layout.
+ * Nothing is recorded when the format does not support the blits, see shCheckMipBlitSupport.
+ * 
+ * @param device Valid Vulkan device.
+ * @param physical_device Valid Vulkan physical device.
+ * @param cmd_buffer Valid Vulkan command buffer in recording state, of a queue family supporting graphics.
+ * @param image Valid Vulkan image with VK_IMAGE_USAGE_TRANSFER_SRC_BIT and VK_IMAGE_USAGE_TRANSFER_DST_BIT.
+ * @param format Format of the image.
+ * @param aspect_mask Aspect of the image, usually VK_IMAGE_ASPECT_COLOR_BIT.
+ * @param width Width of level 0.
+ * @param height Height of level 0.
+ * @param mip_levels Number of mip levels of the image.
+ * @param layer_count Number of array layers, all of them are processed by each blit.
+ * @param filter Blit filter, see shCheckMipBlitSupport.
+ * @param src_image_layout Current layout of level 0.
+ * @param dst_image_layout Layout of every level after the generation, e.g. VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL.
+ * @param dst_access_mask Access of the first use of the image after the generation.
+ * @param dst_stage Pipeline stage of the first use of the image after the generation.
+ * 
+ * @return 1 if successful, 0 otherwise or if the format does not support the blits.
+ */
+extern uint8_t shCmdGenerateMipsBlit(
+	VkDevice             device,
+	VkPhysicalDevice     physical_device,
+	VkCommandBuffer      cmd_buffer,
+	VkImage              image,
+	VkFormat             format,
+	VkImageAspectFlags   aspect_mask,
+	uint32_t             width,
+	uint32_t             height,
+	uint32_t             mip_levels,
+	uint32_t             layer_count,
+	VkFilter             filter,
+	VkImageLayout        src_image_layout,
+	VkImageLayout        dst_image_layout,
+	VkAccessFlags        dst_access_mask,
+	VkPipelineStageFlags dst_stage
+);
+
+/**
+ * @brief Creates one 2D array image view per mip level, used as storage images by shCmdGenerateMipsCompute.
+ * 
+ * @param device Valid Vulkan device.
+ * @param image Valid Vulkan image with VK_IMAGE_USAGE_STORAGE_BIT.
+ * @param aspect_mask Aspect of the image, usually VK_IMAGE_ASPECT_COLOR_BIT.
+ * @param format Format of the views.
+ * @param mip_levels Number of mip levels of the image.
+ * @param layer_count Number of array layers of the image.
+ * @param[out] p_image_views Valid pointer to an array of mip_levels image views.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shCreateMipLevelImageViews(
+	VkDevice           device,
+	VkImage            image,
+	VkImageAspectFlags aspect_mask,
+	VkFormat           format,
+	uint32_t           mip_levels,
+	uint32_t           layer_count,
+	VkImageView*       p_image_views
+);
+
+/**
+ * @brief Fills mip levels 1 to mip_levels - 1 of a 2D image with a compute pipeline, for formats which cannot be blitted or filtered.
+ * 
+ * The image must be created with VK_IMAGE_USAGE_STORAGE_BIT, and its format must support
+ * VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT with optimal tiling, see shCheckMipComputeSupport: the function fails otherwise.
+ * 
+ * The pipeline uses mip.comp compiled with MIP_IMAGE_FORMAT set to the storage image format qualifier of the image,
+ * e.g. mip.rgba8.comp.spv for VK_FORMAT_R8G8B8A8_UNORM or mip.rgba16f.comp.spv for VK_FORMAT_R16G16B16A16_SFLOAT,
+ * and one storage image descriptor set unit per mip level, in VK_IMAGE_LAYOUT_GENERAL, created from shCreateMipLevelImageViews.
+ * Level i is generated by binding units i - 1 and i to descriptor sets 0 and 1. Level 0 must hold the texels and be in src_image_layout,
+ * the other levels are transitioned from VK_IMAGE_LAYOUT_UNDEFINED. At the end every level is in dst_image_layout.
+ * 
+ * @param device Valid Vulkan device.
+ * @param physical_device Valid Vulkan physical device, used to check the format features.
+ * @param cmd_buffer Valid Vulkan command buffer in recording state.
+ * @param image Valid Vulkan image with VK_IMAGE_USAGE_STORAGE_BIT.
+ * @param format Format of the image.
+ * @param aspect_mask Aspect of the image, usually VK_IMAGE_ASPECT_COLOR_BIT.
+ * @param width Width of level 0.
+ * @param height Height of level 0.
+ * @param mip_levels Number of mip levels of the image.
+ * @param layer_count Number of array layers of the image.
+ * @param src_image_layout Current layout of level 0.
+ * @param dst_image_layout Layout of every level after the generation.
+ * @param dst_access_mask Access of the first use of the image after the generation.
+ * @param dst_stage Pipeline stage of the first use of the image after the generation.
+ * @param first_descriptor_set_unit_idx Index of the descriptor set unit of mip level 0.
+ * @param p_pipeline_pool Valid pointer to the pipeline pool owning the descriptor set units.
+ * @param p_pipeline Valid pointer to the mip compute pipeline.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shCmdGenerateMipsCompute(
+	VkDevice             device,
+	VkPhysicalDevice     physical_device,
+	VkCommandBuffer      cmd_buffer,
+	VkImage              image,
+	VkFormat             format,
+	VkImageAspectFlags   aspect_mask,
+	uint32_t             width,
+	uint32_t             height,
+	uint32_t             mip_levels,
+	uint32_t             layer_count,
+	VkImageLayout        src_image_layout,
+	VkImageLayout        dst_image_layout,
+	VkAccessFlags        dst_access_mask,
+	VkPipelineStageFlags dst_stage,
+	uint32_t             first_descriptor_set_unit_idx,
+	ShVkPipelinePool*    p_pipeline_pool,
+	ShVkPipeline*        p_pipeline
+);
+
+
+
+
+#define SH_MAX_TRANSIENT_ATTACHMENT_COUNT  32
+#define SH_TRANSIENT_ATTACHMENT_SIZE_CLASS 128
+
+/**
+ * @brief Render target owned by a ShVkTransientAttachmentPool.
+ */
+typedef struct ShVkTransientAttachment {
+	VkFormat              format;       ///< Image format.
+	uint32_t              width;        ///< Image width, the requested width rounded up to SH_TRANSIENT_ATTACHMENT_SIZE_CLASS.
+	uint32_t              height;       ///< Image height, the requested height rounded up to SH_TRANSIENT_ATTACHMENT_SIZE_CLASS.
+	VkSampleCountFlagBits sample_count; ///< Number of samples.
+	VkImageUsageFlags     usage;        ///< Image usage, with VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT when it only contains attachment usages.
+	VkImageAspectFlags    aspect_mask;  ///< Aspect of the image view.
+	uint32_t              first_pass;   ///< First pass of the frame using the attachment.
+	uint32_t              last_pass;    ///< Last pass of the frame using the attachment.
+	VkImage               image;        ///< Image, VK_NULL_HANDLE until the pool is committed.
+	VkImageView           image_view;   ///< 2D view of the whole image.
+	uint32_t              memory_idx;   ///< Index of the memory block bound to the image.
+	uint8_t               acquired;     ///< 1 when acquired since the last shTransientAttachmentPoolBegin.
+} ShVkTransientAttachment;
+
+/**
+ * @brief Pool of render targets which only live inside render passes, such as multisample color and depth attachments.
+ * 
+ * Attachments are keyed by format, size class, sample count, usage and pass range, so that resizing the window
+ * within the same size class keeps every image. Attachments whose pass ranges do not overlap share the same memory
+ * block, and transient attachments use lazily allocated memory when the device exposes it, which tile based GPUs
+ * may never commit. Aliased or lazily allocated contents do not survive the passes using them: render passes must use
+ * VK_IMAGE_LAYOUT_UNDEFINED as initial layout and should not store them.
+ * 
+ * Passes are indices chosen by the application, the pool records no command and emits no barrier. When two attachments
+ * share a memory block, the application must order the last pass using the first one before the first pass using the
+ * second one, e.g. with an external subpass dependency or a pipeline barrier from the attachment output and late fragment
+ * test stages to the same stages, with attachment write accesses. Passes in the same render pass need
+ * VK_ATTACHMENT_DESCRIPTION_MAY_ALIAS_BIT on both attachment descriptions.
+ */
+typedef struct ShVkTransientAttachmentPool {
+	VkDevice                device;                                                            ///< Device owning the attachments.
+	VkPhysicalDevice        physical_device;                                                   ///< Physical device of the memory types.
+	ShVkTransientAttachment attachments            [SH_MAX_TRANSIENT_ATTACHMENT_COUNT];        ///< Attachment slots, indices stay valid until released.
+	VkDeviceMemory          memories               [SH_MAX_TRANSIENT_ATTACHMENT_COUNT];        ///< Memory blocks, shared by attachments with disjoint pass ranges.
+	VkDeviceSize            memory_sizes           [SH_MAX_TRANSIENT_ATTACHMENT_COUNT];        ///< Size of each memory block.
+	uint8_t                 memory_lazily_allocated[SH_MAX_TRANSIENT_ATTACHMENT_COUNT];        ///< 1 for lazily allocated memory blocks.
+	uint32_t                memory_reference_counts[SH_MAX_TRANSIENT_ATTACHMENT_COUNT];        ///< Number of attachments bound to each memory block.
+	VkDeviceSize            allocated_size;                                                    ///< Total size of the memory blocks.
+	VkDeviceSize            lazily_allocated_size;                                             ///< Part of allocated_size which is lazily allocated.
+} ShVkTransientAttachmentPool;
+
+/**
+ * @brief Allocates a ShVkTransientAttachmentPool structure on the heap.
+ */
+#define shAllocateTransientAttachmentPool() ((ShVkTransientAttachmentPool*)calloc(1, sizeof(ShVkTransientAttachmentPool)))
+
+/**
+ * @brief Frees a ShVkTransientAttachmentPool structure.
+ */
+#define shFreeTransientAttachmentPool free
+
+/**
+ * @brief Sets up an empty transient attachment pool.
+ * 
+ * @param device Valid Vulkan device.
+ * @param physical_device Valid Vulkan physical device.
+ * @param[out] p_pool Valid pointer to a zero initialized ShVkTransientAttachmentPool structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shCreateTransientAttachmentPool(
+	VkDevice                     device,
+	VkPhysicalDevice             physical_device,
+	ShVkTransientAttachmentPool* p_pool
+);
+
+/**
+ * @brief Starts a new set of attachments, e.g. after a resize. Attachments which are not acquired again are released by shTransientAttachmentPoolCommit.
+ * 
+ * @param[in,out] p_pool Valid pointer to the ShVkTransientAttachmentPool structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shTransientAttachmentPoolBegin(
+	ShVkTransientAttachmentPool* p_pool
+);
+
+/**
+ * @brief Acquires an attachment, reusing a committed one with the same format, size class, sample count, usage and pass range.
+ * 
+ * The image and view are available in ShVkTransientAttachmentPool::attachments after shTransientAttachmentPoolCommit.
+ * 
+ * @param format Image format.
+ * @param width Minimum width, e.g. the framebuffer width.
+ * @param height Minimum height, e.g. the framebuffer height.
+ * @param sample_count Number of samples.
+ * @param usage Image usage, VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT is added when it only contains attachment usages.
+ * @param aspect_mask Aspect of the image view.
+ * @param first_pass First pass of the frame using the attachment.
+ * @param last_pass Last pass of the frame using the attachment.
+ * @param[in,out] p_pool Valid pointer to the ShVkTransientAttachmentPool structure.
+ * @param[out] p_attachment_idx Valid pointer to the index of the attachment in ShVkTransientAttachmentPool::attachments.
+ * 
+ * @return 1 if successful, 0 otherwise or if the pool is full.
+ */
+extern uint8_t shTransientAttachmentPoolAcquire(
+	VkFormat                     format,
+	uint32_t                     width,
+	uint32_t                     height,
+	VkSampleCountFlagBits        sample_count,
+	VkImageUsageFlags            usage,
+	VkImageAspectFlags           aspect_mask,
+	uint32_t                     first_pass,
+	uint32_t                     last_pass,
+	ShVkTransientAttachmentPool* p_pool,
+	uint32_t*                    p_attachment_idx
+);
+
+/**
+ * @brief Releases the attachments which were not acquired since shTransientAttachmentPoolBegin, then creates the new ones.
+ * 
+ * New attachments with disjoint pass ranges and compatible memory types are bound to the same memory block, see
+ * ShVkTransientAttachmentPool for the synchronization this requires. When a new attachment cannot be created, every object
+ * created by the commit is destroyed and the new attachments stay acquired without image, so the commit can be retried.
+ * 
+ * @param p_release_queue Optional pointer to a ShVkReleaseQueue structure, `VK_NULL_HANDLE` destroys the released objects immediately.
+ * @param[in,out] p_pool Valid pointer to the ShVkTransientAttachmentPool structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shTransientAttachmentPoolCommit(
+	ShVkReleaseQueue*            p_release_queue,
+	ShVkTransientAttachmentPool* p_pool
+);
+
+/**
+ * @brief Destroys every attachment and memory block of the pool, the device must not use them anymore.
+ * 
+ * @param[in,out] p_pool Valid pointer to the ShVkTransientAttachmentPool structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shDestroyTransientAttachmentPool(
+	ShVkTransientAttachmentPool* p_pool
+);
+
+
+/**
+ * @brief Fills an attachment of a dynamic rendering scope, see shBeginRendering.
+ * 
+ * @param image_view Image view to render to, `VK_NULL_HANDLE` leaves the attachment unused.
+ * @param image_layout Layout of the image during rendering, e.g. VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL.
+ * @param resolve_mode Multisample resolve mode, VK_RESOLVE_MODE_NONE to skip the resolve.
+ * @param resolve_image_view Image view receiving the resolved samples, can be `VK_NULL_HANDLE` if resolve_mode is VK_RESOLVE_MODE_NONE.
+ * @param resolve_image_layout Layout of the resolve image during rendering.
+ * @param load_op Load operation of the attachment.
+ * @param store_op Store operation of the attachment.
+ * @param p_clear_value Clear value used with VK_ATTACHMENT_LOAD_OP_CLEAR, can be `VK_NULL_HANDLE` with other load operations.
+ * @param[out] p_attachment Valid pointer to the destination VkRenderingAttachmentInfo structure.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shSetRenderingAttachment(
+	VkImageView                image_view,
+	VkImageLayout              image_layout,
+	VkResolveModeFlagBits      resolve_mode,
+	VkImageView                resolve_image_view,
+	VkImageLayout              resolve_image_layout,
+	VkAttachmentLoadOp         load_op,
+	VkAttachmentStoreOp        store_op,
+	VkClearValue*              p_clear_value,
+	VkRenderingAttachmentInfo* p_attachment
+);
+
+/**
+ * @brief Begins a dynamic rendering scope, renders to image views without render pass and framebuffer objects.
+ * 
+ * Requires a Vulkan 1.3 device with VkPhysicalDeviceVulkan13Features::dynamicRendering enabled, or VK_KHR_dynamic_rendering.
+ * The function is never linked from the loader: it is resolved once with vkGetDeviceProcAddr by shSetLogicalDevice,
+ * devices created without shSetLogicalDevice look it up on each call. Attachments are not transitioned: use image memory barriers
+ * to move them to the rendering layouts before, and to the following layouts (e.g. VK_IMAGE_LAYOUT_PRESENT_SRC_KHR) after.
+ * Pipelines must have been created with shSetupGraphicsPipelineRendering and matching attachment formats.
+ * 
+ * @param device Valid Vulkan device owning graphics_cmd_buffer.
+ * @param graphics_cmd_buffer Valid Vulkan command buffer.
+ * @param render_offset_x X offset for the render area.
+ * @param render_offset_y Y offset for the render area.
+ * @param render_size_x Width of the render area.
+ * @param render_size_y Height of the render area.
+ * @param layer_count Number of layers rendered.
+ * @param color_attachment_count Number of color attachments.
+ * @param p_color_attachments Valid pointer to an array of color attachments, can be `VK_NULL_HANDLE` if color_attachment_count is 0.
+ * @param p_depth_attachment Optional pointer to the depth attachment, can be `VK_NULL_HANDLE`.
+ * @param p_stencil_attachment Optional pointer to the stencil attachment, can be `VK_NULL_HANDLE`.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shBeginRendering(
+	VkDevice                   device,
+	VkCommandBuffer            graphics_cmd_buffer,
+	int32_t                    render_offset_x,
+	int32_t                    render_offset_y,
+	uint32_t                   render_size_x,
+	uint32_t                   render_size_y,
+	uint32_t                   layer_count,
+	uint32_t                   color_attachment_count,
+	VkRenderingAttachmentInfo* p_color_attachments,
+	VkRenderingAttachmentInfo* p_depth_attachment,
+	VkRenderingAttachmentInfo* p_stencil_attachment
+);
+
+/**
+ * @brief Ends a dynamic rendering scope started by shBeginRendering.
+ * 
+ * vkCmdEndRendering is resolved like vkCmdBeginRendering in shBeginRendering.
+ * 
+ * @param device Valid Vulkan device owning graphics_cmd_buffer.
+ * @param graphics_cmd_buffer Valid Vulkan command buffer.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shEndRendering(
+	VkDevice        device,
+	VkCommandBuffer graphics_cmd_buffer
+);
+
+/**
+ * @brief Sets up a graphics pipeline for dynamic rendering.
+ * 
+ * The pipeline is described by the attachment formats instead of a render pass, so it can be used by any
+ * shBeginRendering scope with the same formats. With dynamic_viewport the viewport and scissors are not baked in
+ * the pipeline: record them with shCmdSetPipelineViewport, and a resize only takes a shPipelineSetViewport call.
+ * 
+ * @param device Valid Vulkan device.
+ * @param color_attachment_count Number of color attachments, must match shPipelineColorBlendSettings.
+ * @param p_color_attachment_formats Valid pointer to an array of color attachment formats, can be `VK_NULL_HANDLE` if color_attachment_count is 0.
+ * @param depth_attachment_format Depth attachment format, VK_FORMAT_UNDEFINED without depth attachment.
+ * @param stencil_attachment_format Stencil attachment format, VK_FORMAT_UNDEFINED without stencil attachment.
+ * @param dynamic_viewport Flag making the viewport and scissors dynamic states.
+ * @param p_pipeline Valid destination pointer to the ShVkPipeline structure to setup.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shSetupGraphicsPipelineRendering(
+	VkDevice      device,
+	uint32_t      color_attachment_count,
+	VkFormat*     p_color_attachment_formats,
+	VkFormat      depth_attachment_format,
+	VkFormat      stencil_attachment_format,
+	uint8_t       dynamic_viewport,
+	ShVkPipeline* p_pipeline
+);
+
+/**
+ * @brief Records the viewport and scissors of a pipeline created with dynamic viewport.
+ * 
+ * @param cmd_buffer Valid Vulkan command buffer.
+ * @param p_pipeline Valid pointer to the ShVkPipeline structure, updated by shPipelineSetViewport.
+ * 
+ * @return 1 if successful, 0 otherwise.
+ */
+extern uint8_t shCmdSetPipelineViewport(
+	VkCommandBuffer cmd_buffer,
+	ShVkPipeline*   p_pipeline
+);
 
 
 #ifdef __cplusplus
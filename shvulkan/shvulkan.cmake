@@ -5,6 +5,9 @@ add_definitions(-DCMAKE_EXPORT_COMPILE_COMMANDS=ON)
 
 option(SH_VULKAN_VK_SDK_PATH     CACHE sdk_path)
 option(SH_VULKAN_VK_INCLUDE_DIRS CACHE include_dirs)
+option(SH_VULKAN_DEVICE_DISPATCH "call device level functions through ShVkDeviceDispatchTable" OFF)
+set(SH_VULKAN_VALIDATION PRINT CACHE STRING "shVkArgError checks inside shvulkan: PRINT, ASSERT or NONE")
+set_property(CACHE SH_VULKAN_VALIDATION PROPERTY STRINGS PRINT ASSERT NONE)
 
 
 
@@ -21,6 +24,7 @@ endif()
 function(build_shvulkan)
 
 find_package(Vulkan REQUIRED)
+find_package(Threads REQUIRED)
 
 message(STATUS "shvulkan message: found Vulkan")
 message(STATUS "shvulkan message: Vulkan_INCLUDE_DIR: ${Vulkan_INCLUDE_DIR}")
@@ -35,7 +39,17 @@ target_include_directories(shvulkan PUBLIC
     ${SH_VULKAN_ROOT_DIR}/shvulkan/include
 )
 
-target_link_libraries(shvulkan PUBLIC ${Vulkan_LIBRARY})
+target_link_libraries(shvulkan PUBLIC ${Vulkan_LIBRARY} Threads::Threads)
+
+if (SH_VULKAN_DEVICE_DISPATCH)
+target_compile_definitions(shvulkan PUBLIC SH_VULKAN_DEVICE_DISPATCH)
+endif(SH_VULKAN_DEVICE_DISPATCH)
+
+if (SH_VULKAN_VALIDATION STREQUAL "ASSERT")
+target_compile_definitions(shvulkan PUBLIC SH_VULKAN_VALIDATION_ASSERT)
+elseif (SH_VULKAN_VALIDATION STREQUAL "NONE")
+target_compile_definitions(shvulkan PUBLIC SH_VULKAN_VALIDATION_NONE)
+endif()
 set_target_properties(shvulkan PROPERTIES ARCHIVE_OUTPUT_DIRECTORY ${SH_VULKAN_BINARIES_DIR})
 
 endfunction()
\ No newline at end of file
@@ -7,13 +7,305 @@
 #include <memory.h>
 #include <string.h>
 #include <stdio.h>
+#include <stddef.h>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif//WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#endif//_WIN32
+
+
+
+#define SH_VK_LOADER_DISPATCH_TABLE_MEMBER(function_name) .function_name = function_name,
+#define SH_VK_LOAD_DEVICE_FUNCTION(function_name)\
+	p_function = vkGetDeviceProcAddr(device, #function_name);\
+	p_dispatch_table->function_name = (p_function != VK_NULL_HANDLE) ?\
+		(PFN_##function_name)p_function : sh_vk_loader_dispatch_table.function_name;
+
+//the loader-driver interface requires every dispatchable object to start with the dispatch pointer of its device,
+//shared by the device, its queues and its command buffers
+#define SH_VK_DISPATCH_KEY(dispatchable_handle) (*(void* const*)(dispatchable_handle))
+
+//open addressing slots, kept at most half full so that probes stay short
+#define SH_VK_DEVICE_DISPATCH_SLOT_COUNT (SH_MAX_DEVICE_DISPATCH_TABLE_COUNT * 2)
+#define SH_VK_DEVICE_DISPATCH_SLOT(dispatch_key)\
+	((uint32_t)((((uintptr_t)(dispatch_key)) >> 4) * 2654435761u) % SH_VK_DEVICE_DISPATCH_SLOT_COUNT)
+
+ShVkDeviceDispatchTable sh_vk_loader_dispatch_table = { SH_VK_DEVICE_DISPATCH_FUNCTIONS(SH_VK_LOADER_DISPATCH_TABLE_MEMBER) };
+
+#ifdef SH_VULKAN_DEVICE_DISPATCH
+SH_VK_THREAD_LOCAL ShVkRecordingDispatch sh_vk_recording_dispatch = { VK_NULL_HANDLE, &sh_vk_loader_dispatch_table };
+#endif//SH_VULKAN_DEVICE_DISPATCH
+
+//core entry point, or its VK_KHR_dynamic_rendering alias before Vulkan 1.3, never linked from the loader
+static PFN_vkVoidFunction shGetDynamicRenderingFunction(
+	VkDevice    device,
+	const char* function_name,
+	const char* khr_function_name
+) {
+	PFN_vkVoidFunction p_function = vkGetDeviceProcAddr(device, function_name);
+	if (p_function == VK_NULL_HANDLE) {
+		p_function = vkGetDeviceProcAddr(device, khr_function_name);
+	}
+	return p_function;
+}
+
+//per device state, keyed on the dispatch key shared by the device, its queues and command buffers
+typedef struct ShVkDeviceSlot {
+	const void*              dispatch_key;        //NULL for empty slots
+	ShVkDeviceDispatchTable* p_dispatch_table;    //VK_NULL_HANDLE until shLoadDeviceDispatchTable
+	PFN_vkCmdBeginRendering  vkCmdBeginRendering; //resolved once, when the device is registered
+	PFN_vkCmdEndRendering    vkCmdEndRendering;
+} ShVkDeviceSlot;
+
+//written only when devices are created or destroyed and when tables are loaded or unloaded, which are setup and teardown steps
+static ShVkDeviceSlot sh_vk_device_slots[SH_VK_DEVICE_DISPATCH_SLOT_COUNT];
+static uint32_t       sh_vk_device_slot_count = 0;
+
+//slot of the key, or the empty slot ending its probe sequence
+static uint32_t shFindDeviceSlot(
+	const void* dispatch_key
+) {
+	uint32_t slot_idx = SH_VK_DEVICE_DISPATCH_SLOT(dispatch_key);
+	while (sh_vk_device_slots[slot_idx].dispatch_key != NULL && sh_vk_device_slots[slot_idx].dispatch_key != dispatch_key) {
+		slot_idx = (slot_idx + 1) % SH_VK_DEVICE_DISPATCH_SLOT_COUNT;
+	}
+	return slot_idx;
+}
+
+static ShVkDeviceSlot* shGetDeviceSlot(
+	const void* dispatchable_handle
+) {
+	if (dispatchable_handle == VK_NULL_HANDLE || sh_vk_device_slot_count == 0) {
+		return VK_NULL_HANDLE;
+	}
+	ShVkDeviceSlot* p_slot = &sh_vk_device_slots[shFindDeviceSlot(SH_VK_DISPATCH_KEY(dispatchable_handle))];
+	return p_slot->dispatch_key != NULL ? p_slot : VK_NULL_HANDLE;
+}
+
+static ShVkDeviceSlot* shRegisterDevice(
+	VkDevice device
+) {
+	const void*     dispatch_key = SH_VK_DISPATCH_KEY(device);
+	ShVkDeviceSlot* p_slot       = &sh_vk_device_slots[shFindDeviceSlot(dispatch_key)];
+
+	if (p_slot->dispatch_key != NULL) {
+		return p_slot;
+	}
+	shVkError(
+		sh_vk_device_slot_count == SH_MAX_DEVICE_DISPATCH_TABLE_COUNT,
+		"reached max device dispatch table count",
+		return VK_NULL_HANDLE
+	);
+
+	p_slot->dispatch_key        = dispatch_key;
+	p_slot->p_dispatch_table    = VK_NULL_HANDLE;
+	p_slot->vkCmdBeginRendering = (PFN_vkCmdBeginRendering)shGetDynamicRenderingFunction(
+		device, "vkCmdBeginRendering", "vkCmdBeginRenderingKHR"
+	);
+	p_slot->vkCmdEndRendering   = (PFN_vkCmdEndRendering)shGetDynamicRenderingFunction(
+		device, "vkCmdEndRendering", "vkCmdEndRenderingKHR"
+	);
+	sh_vk_device_slot_count++;
+
+	return p_slot;
+}
+
+static void shUnregisterDevice(
+	VkDevice device
+) {
+	uint32_t slot_idx = shFindDeviceSlot(SH_VK_DISPATCH_KEY(device));
+	if (sh_vk_device_slots[slot_idx].dispatch_key == NULL) {
+		return;
+	}
+
+	//backward shift, the following keys of the probe sequence must stay reachable without tombstones
+	uint32_t next_idx = slot_idx;
+	for (;;) {
+		next_idx = (next_idx + 1) % SH_VK_DEVICE_DISPATCH_SLOT_COUNT;
+		const void* next_key = sh_vk_device_slots[next_idx].dispatch_key;
+		if (next_key == NULL) {
+			break;
+		}
+		uint32_t home_idx = SH_VK_DEVICE_DISPATCH_SLOT(next_key);
+		//keep the key if its home lies cyclically in (slot_idx, next_idx]
+		uint8_t reachable = (slot_idx <= next_idx) ?
+			(slot_idx < home_idx && home_idx <= next_idx) :
+			(slot_idx < home_idx || home_idx <= next_idx);
+		if (!reachable) {
+			sh_vk_device_slots[slot_idx] = sh_vk_device_slots[next_idx];
+			slot_idx = next_idx;
+		}
+	}
+	memset(&sh_vk_device_slots[slot_idx], 0, sizeof(ShVkDeviceSlot));
+	sh_vk_device_slot_count--;
+}
+
+uint8_t shLoadDeviceDispatchTable(
+	VkDevice                 device,
+	ShVkDeviceDispatchTable* p_dispatch_table
+) {
+	shVkArgError(device           == VK_NULL_HANDLE, "invalid device memory",         return 0);
+	shVkArgError(p_dispatch_table == VK_NULL_HANDLE, "invalid dispatch table memory", return 0);
+
+	ShVkDeviceSlot* p_slot = shRegisterDevice(device);
+	shVkError(p_slot == VK_NULL_HANDLE, "failed registering device", return 0);
+
+	PFN_vkVoidFunction p_function = VK_NULL_HANDLE;
+
+	SH_VK_DEVICE_DISPATCH_FUNCTIONS(SH_VK_LOAD_DEVICE_FUNCTION)
+
+	p_dispatch_table->vkCmdBeginRendering = p_slot->vkCmdBeginRendering;
+	p_dispatch_table->vkCmdEndRendering   = p_slot->vkCmdEndRendering;
+
+	p_slot->p_dispatch_table = p_dispatch_table;
+
+	return 1;
+}
+
+uint8_t shUnloadDeviceDispatchTable(
+	VkDevice device
+) {
+	shVkArgError(device == VK_NULL_HANDLE, "invalid device memory", return 0);
+
+	ShVkDeviceSlot* p_slot = shGetDeviceSlot(device);
+	if (p_slot == VK_NULL_HANDLE || p_slot->p_dispatch_table == VK_NULL_HANDLE) {
+		return 1;
+	}
+
+#ifdef SH_VULKAN_DEVICE_DISPATCH
+	if (sh_vk_recording_dispatch.p_dispatch_table == p_slot->p_dispatch_table) {
+		sh_vk_recording_dispatch.cmd_buffer       = VK_NULL_HANDLE;
+		sh_vk_recording_dispatch.p_dispatch_table = &sh_vk_loader_dispatch_table;
+	}
+#endif//SH_VULKAN_DEVICE_DISPATCH
+
+	//the device stays registered with its rendering functions until shDestroyDevice
+	p_slot->p_dispatch_table = VK_NULL_HANDLE;
+
+	return 1;
+}
+
+ShVkDeviceDispatchTable* shGetDeviceDispatchTable(
+	const void* dispatchable_handle
+) {
+	ShVkDeviceSlot* p_slot = shGetDeviceSlot(dispatchable_handle);
+
+	return (p_slot != VK_NULL_HANDLE && p_slot->p_dispatch_table != VK_NULL_HANDLE) ?
+		p_slot->p_dispatch_table : &sh_vk_loader_dispatch_table;
+}
+
+#ifdef SH_VULKAN_DEVICE_DISPATCH
+//from here on device level calls go through the table of the device owning their first argument
+#define SH_VK_EXPAND(x) x
+#define SH_VK_FIRST_ARGUMENT(first, ...) first
+#define SH_VK_DEVICE_DISPATCH(function_name, ...)\
+	SH_VK_DEVICE_CALL(function_name, SH_VK_EXPAND(SH_VK_FIRST_ARGUMENT(__VA_ARGS__, 0)))(__VA_ARGS__)
+
+#define vkAcquireNextImageKHR(...)             SH_VK_DEVICE_DISPATCH(vkAcquireNextImageKHR, __VA_ARGS__)
+#define vkAllocateCommandBuffers(...)          SH_VK_DEVICE_DISPATCH(vkAllocateCommandBuffers, __VA_ARGS__)
+#define vkAllocateDescriptorSets(...)          SH_VK_DEVICE_DISPATCH(vkAllocateDescriptorSets, __VA_ARGS__)
+#define vkAllocateMemory(...)                  SH_VK_DEVICE_DISPATCH(vkAllocateMemory, __VA_ARGS__)
+#define vkBeginCommandBuffer(...)              SH_VK_DEVICE_DISPATCH(vkBeginCommandBuffer, __VA_ARGS__)
+#define vkBindBufferMemory(...)                SH_VK_DEVICE_DISPATCH(vkBindBufferMemory, __VA_ARGS__)
+#define vkBindImageMemory(...)                 SH_VK_DEVICE_DISPATCH(vkBindImageMemory, __VA_ARGS__)
+#define vkCmdBeginRenderPass(...)              SH_VK_DEVICE_DISPATCH(vkCmdBeginRenderPass, __VA_ARGS__)
+#define vkCmdBindDescriptorSets(...)           SH_VK_DEVICE_DISPATCH(vkCmdBindDescriptorSets, __VA_ARGS__)
+#define vkCmdBindIndexBuffer(...)              SH_VK_DEVICE_DISPATCH(vkCmdBindIndexBuffer, __VA_ARGS__)
+#define vkCmdBindPipeline(...)                 SH_VK_DEVICE_DISPATCH(vkCmdBindPipeline, __VA_ARGS__)
+#define vkCmdBindVertexBuffers(...)            SH_VK_DEVICE_DISPATCH(vkCmdBindVertexBuffers, __VA_ARGS__)
+#define vkCmdBlitImage(...)                    SH_VK_DEVICE_DISPATCH(vkCmdBlitImage, __VA_ARGS__)
+#define vkCmdCopyBuffer(...)                   SH_VK_DEVICE_DISPATCH(vkCmdCopyBuffer, __VA_ARGS__)
+#define vkCmdCopyBufferToImage(...)            SH_VK_DEVICE_DISPATCH(vkCmdCopyBufferToImage, __VA_ARGS__)
+#define vkCmdCopyImage(...)                    SH_VK_DEVICE_DISPATCH(vkCmdCopyImage, __VA_ARGS__)
+#define vkCmdCopyImageToBuffer(...)            SH_VK_DEVICE_DISPATCH(vkCmdCopyImageToBuffer, __VA_ARGS__)
+#define vkCmdDispatch(...)                     SH_VK_DEVICE_DISPATCH(vkCmdDispatch, __VA_ARGS__)
+#define vkCmdDraw(...)                         SH_VK_DEVICE_DISPATCH(vkCmdDraw, __VA_ARGS__)
+#define vkCmdDrawIndexed(...)                  SH_VK_DEVICE_DISPATCH(vkCmdDrawIndexed, __VA_ARGS__)
+#define vkCmdEndRenderPass(...)                SH_VK_DEVICE_DISPATCH(vkCmdEndRenderPass, __VA_ARGS__)
+#define vkCmdFillBuffer(...)                   SH_VK_DEVICE_DISPATCH(vkCmdFillBuffer, __VA_ARGS__)
+#define vkCmdPipelineBarrier(...)              SH_VK_DEVICE_DISPATCH(vkCmdPipelineBarrier, __VA_ARGS__)
+#define vkCmdPushConstants(...)                SH_VK_DEVICE_DISPATCH(vkCmdPushConstants, __VA_ARGS__)
+#define vkCmdResetQueryPool(...)               SH_VK_DEVICE_DISPATCH(vkCmdResetQueryPool, __VA_ARGS__)
+#define vkCmdSetScissor(...)                   SH_VK_DEVICE_DISPATCH(vkCmdSetScissor, __VA_ARGS__)
+#define vkCmdSetViewport(...)                  SH_VK_DEVICE_DISPATCH(vkCmdSetViewport, __VA_ARGS__)
+#define vkCmdWriteTimestamp(...)               SH_VK_DEVICE_DISPATCH(vkCmdWriteTimestamp, __VA_ARGS__)
+#define vkCreateBuffer(...)                    SH_VK_DEVICE_DISPATCH(vkCreateBuffer, __VA_ARGS__)
+#define vkCreateCommandPool(...)               SH_VK_DEVICE_DISPATCH(vkCreateCommandPool, __VA_ARGS__)
+#define vkCreateComputePipelines(...)          SH_VK_DEVICE_DISPATCH(vkCreateComputePipelines, __VA_ARGS__)
+#define vkCreateDescriptorPool(...)            SH_VK_DEVICE_DISPATCH(vkCreateDescriptorPool, __VA_ARGS__)
+#define vkCreateDescriptorSetLayout(...)       SH_VK_DEVICE_DISPATCH(vkCreateDescriptorSetLayout, __VA_ARGS__)
+#define vkCreateDescriptorUpdateTemplate(...)  SH_VK_DEVICE_DISPATCH(vkCreateDescriptorUpdateTemplate, __VA_ARGS__)
+#define vkCreateFence(...)                     SH_VK_DEVICE_DISPATCH(vkCreateFence, __VA_ARGS__)
+#define vkCreateFramebuffer(...)               SH_VK_DEVICE_DISPATCH(vkCreateFramebuffer, __VA_ARGS__)
+#define vkCreateGraphicsPipelines(...)         SH_VK_DEVICE_DISPATCH(vkCreateGraphicsPipelines, __VA_ARGS__)
+#define vkCreateImage(...)                     SH_VK_DEVICE_DISPATCH(vkCreateImage, __VA_ARGS__)
+#define vkCreateImageView(...)                 SH_VK_DEVICE_DISPATCH(vkCreateImageView, __VA_ARGS__)
+#define vkCreatePipelineLayout(...)            SH_VK_DEVICE_DISPATCH(vkCreatePipelineLayout, __VA_ARGS__)
+#define vkCreateQueryPool(...)                 SH_VK_DEVICE_DISPATCH(vkCreateQueryPool, __VA_ARGS__)
+#define vkCreateRenderPass(...)                SH_VK_DEVICE_DISPATCH(vkCreateRenderPass, __VA_ARGS__)
+#define vkCreateSampler(...)                   SH_VK_DEVICE_DISPATCH(vkCreateSampler, __VA_ARGS__)
+#define vkCreateSemaphore(...)                 SH_VK_DEVICE_DISPATCH(vkCreateSemaphore, __VA_ARGS__)
+#define vkCreateShaderModule(...)              SH_VK_DEVICE_DISPATCH(vkCreateShaderModule, __VA_ARGS__)
+#define vkCreateSwapchainKHR(...)              SH_VK_DEVICE_DISPATCH(vkCreateSwapchainKHR, __VA_ARGS__)
+#define vkDestroyBuffer(...)                   SH_VK_DEVICE_DISPATCH(vkDestroyBuffer, __VA_ARGS__)
+#define vkDestroyCommandPool(...)              SH_VK_DEVICE_DISPATCH(vkDestroyCommandPool, __VA_ARGS__)
+#define vkDestroyDescriptorPool(...)           SH_VK_DEVICE_DISPATCH(vkDestroyDescriptorPool, __VA_ARGS__)
+#define vkDestroyDescriptorSetLayout(...)      SH_VK_DEVICE_DISPATCH(vkDestroyDescriptorSetLayout, __VA_ARGS__)
+#define vkDestroyDescriptorUpdateTemplate(...) SH_VK_DEVICE_DISPATCH(vkDestroyDescriptorUpdateTemplate, __VA_ARGS__)
+#define vkDestroyDevice(...)                   SH_VK_DEVICE_DISPATCH(vkDestroyDevice, __VA_ARGS__)
+#define vkDestroyFence(...)                    SH_VK_DEVICE_DISPATCH(vkDestroyFence, __VA_ARGS__)
+#define vkDestroyFramebuffer(...)              SH_VK_DEVICE_DISPATCH(vkDestroyFramebuffer, __VA_ARGS__)
+#define vkDestroyImage(...)                    SH_VK_DEVICE_DISPATCH(vkDestroyImage, __VA_ARGS__)
+#define vkDestroyImageView(...)                SH_VK_DEVICE_DISPATCH(vkDestroyImageView, __VA_ARGS__)
+#define vkDestroyPipeline(...)                 SH_VK_DEVICE_DISPATCH(vkDestroyPipeline, __VA_ARGS__)
+#define vkDestroyPipelineLayout(...)           SH_VK_DEVICE_DISPATCH(vkDestroyPipelineLayout, __VA_ARGS__)
+#define vkDestroyQueryPool(...)                SH_VK_DEVICE_DISPATCH(vkDestroyQueryPool, __VA_ARGS__)
+#define vkDestroyRenderPass(...)               SH_VK_DEVICE_DISPATCH(vkDestroyRenderPass, __VA_ARGS__)
+#define vkDestroySampler(...)                  SH_VK_DEVICE_DISPATCH(vkDestroySampler, __VA_ARGS__)
+#define vkDestroySemaphore(...)                SH_VK_DEVICE_DISPATCH(vkDestroySemaphore, __VA_ARGS__)
+#define vkDestroyShaderModule(...)             SH_VK_DEVICE_DISPATCH(vkDestroyShaderModule, __VA_ARGS__)
+#define vkDestroySwapchainKHR(...)             SH_VK_DEVICE_DISPATCH(vkDestroySwapchainKHR, __VA_ARGS__)
+#define vkDeviceWaitIdle(...)                  SH_VK_DEVICE_DISPATCH(vkDeviceWaitIdle, __VA_ARGS__)
+#define vkEndCommandBuffer(...)                SH_VK_DEVICE_DISPATCH(vkEndCommandBuffer, __VA_ARGS__)
+#define vkFlushMappedMemoryRanges(...)         SH_VK_DEVICE_DISPATCH(vkFlushMappedMemoryRanges, __VA_ARGS__)
+#define vkFreeCommandBuffers(...)              SH_VK_DEVICE_DISPATCH(vkFreeCommandBuffers, __VA_ARGS__)
+#define vkFreeDescriptorSets(...)              SH_VK_DEVICE_DISPATCH(vkFreeDescriptorSets, __VA_ARGS__)
+#define vkFreeMemory(...)                      SH_VK_DEVICE_DISPATCH(vkFreeMemory, __VA_ARGS__)
+#define vkGetBufferMemoryRequirements(...)     SH_VK_DEVICE_DISPATCH(vkGetBufferMemoryRequirements, __VA_ARGS__)
+#define vkGetDeviceQueue(...)                  SH_VK_DEVICE_DISPATCH(vkGetDeviceQueue, __VA_ARGS__)
+#define vkGetFenceStatus(...)                  SH_VK_DEVICE_DISPATCH(vkGetFenceStatus, __VA_ARGS__)
+#define vkGetImageMemoryRequirements(...)      SH_VK_DEVICE_DISPATCH(vkGetImageMemoryRequirements, __VA_ARGS__)
+#define vkGetImageSubresourceLayout(...)       SH_VK_DEVICE_DISPATCH(vkGetImageSubresourceLayout, __VA_ARGS__)
+#define vkGetQueryPoolResults(...)             SH_VK_DEVICE_DISPATCH(vkGetQueryPoolResults, __VA_ARGS__)
+#define vkGetSemaphoreCounterValue(...)        SH_VK_DEVICE_DISPATCH(vkGetSemaphoreCounterValue, __VA_ARGS__)
+#define vkGetSwapchainImagesKHR(...)           SH_VK_DEVICE_DISPATCH(vkGetSwapchainImagesKHR, __VA_ARGS__)
+#define vkInvalidateMappedMemoryRanges(...)    SH_VK_DEVICE_DISPATCH(vkInvalidateMappedMemoryRanges, __VA_ARGS__)
+#define vkMapMemory(...)                       SH_VK_DEVICE_DISPATCH(vkMapMemory, __VA_ARGS__)
+#define vkQueuePresentKHR(...)                 SH_VK_DEVICE_DISPATCH(vkQueuePresentKHR, __VA_ARGS__)
+#define vkQueueSubmit(...)                     SH_VK_DEVICE_DISPATCH(vkQueueSubmit, __VA_ARGS__)
+#define vkQueueWaitIdle(...)                   SH_VK_DEVICE_DISPATCH(vkQueueWaitIdle, __VA_ARGS__)
+#define vkResetCommandBuffer(...)              SH_VK_DEVICE_DISPATCH(vkResetCommandBuffer, __VA_ARGS__)
+#define vkResetFences(...)                     SH_VK_DEVICE_DISPATCH(vkResetFences, __VA_ARGS__)
+#define vkUnmapMemory(...)                     SH_VK_DEVICE_DISPATCH(vkUnmapMemory, __VA_ARGS__)
+#define vkUpdateDescriptorSets(...)            SH_VK_DEVICE_DISPATCH(vkUpdateDescriptorSets, __VA_ARGS__)
+#define vkUpdateDescriptorSetWithTemplate(...) SH_VK_DEVICE_DISPATCH(vkUpdateDescriptorSetWithTemplate, __VA_ARGS__)
+#define vkWaitForFences(...)                   SH_VK_DEVICE_DISPATCH(vkWaitForFences, __VA_ARGS__)
+#define vkWaitSemaphores(...)                  SH_VK_DEVICE_DISPATCH(vkWaitSemaphores, __VA_ARGS__)
+#endif//SH_VULKAN_DEVICE_DISPATCH
 
 
 
 uint8_t shFindValidationLayer(
 	const char* validation_layer_name
 ) {
-	shVkError(validation_layer_name == VK_NULL_HANDLE, "invalid validation layer name memory", return 0);
+	shVkArgError(validation_layer_name == VK_NULL_HANDLE, "invalid validation layer name memory", return 0);
 
 	uint32_t           available_layer_count =   0;
 	VkLayerProperties* p_layer_properties    = { 0 };
@@ -142,6 +434,196 @@ const char* shTranslateVkResult(
     }
 }
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define SH_THREAD_LOCAL __declspec(thread)
+#define SH_ATOMIC_LOAD_U64(p_value)\
+	((uint64_t)_InterlockedOr64((volatile __int64*)(p_value), 0))
+#define SH_ATOMIC_STORE_U64(p_value, value)\
+	_InterlockedExchange64((volatile __int64*)(p_value), (__int64)(value))
+#define SH_ATOMIC_ADD_U64(p_value, value)\
+	_InterlockedExchangeAdd64((volatile __int64*)(p_value), (__int64)(value))
+#define SH_ATOMIC_CAS_U64(p_value, expected, desired)\
+	(_InterlockedCompareExchange64((volatile __int64*)(p_value), (__int64)(desired), (__int64)(expected)) == (__int64)(expected))
+#else
+#define SH_THREAD_LOCAL __thread
+#define SH_ATOMIC_LOAD_U64(p_value)\
+	__atomic_load_n((p_value), __ATOMIC_ACQUIRE)
+#define SH_ATOMIC_STORE_U64(p_value, value)\
+	__atomic_store_n((p_value), (value), __ATOMIC_RELEASE)
+#define SH_ATOMIC_ADD_U64(p_value, value)\
+	__atomic_fetch_add((p_value), (value), __ATOMIC_ACQ_REL)
+#define SH_ATOMIC_CAS_U64(p_value, expected, desired)\
+	__atomic_compare_exchange_n((p_value), &(expected), (desired), 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#endif//_MSC_VER
+
+typedef struct ShVkErrorRingSlot {
+	uint64_t        sequence; //write index + 1 once the record is published
+	ShVkErrorRecord record;
+} ShVkErrorRingSlot;
+
+SH_THREAD_LOCAL ShVkErrorRecord sh_vk_last_error_record;
+
+ShVkErrorCallback sh_vk_error_callback        = VK_NULL_HANDLE;
+void*             p_sh_vk_error_callback_data = VK_NULL_HANDLE;
+ShVkErrorOutput   sh_vk_error_output          = SH_ERROR_OUTPUT_PRINT;
+
+ShVkErrorRingSlot sh_vk_error_ring[SH_ERROR_RING_SIZE];
+volatile uint64_t sh_vk_error_ring_write_idx  = 0;
+volatile uint64_t sh_vk_error_ring_read_idx   = 0;
+volatile uint64_t sh_vk_error_count           = 0;
+volatile uint64_t sh_vk_error_dropped_count   = 0;
+
+void shReportError(
+	VkResult    result,
+	const char* function,
+	const char* message
+) {
+	ShVkErrorRecord record = {
+		.result   = result,
+		.function = function,
+		.message  = message
+	};
+
+	sh_vk_last_error_record = record;
+
+	SH_ATOMIC_ADD_U64(&sh_vk_error_count, 1);
+
+	if (sh_vk_error_callback != VK_NULL_HANDLE) {
+		sh_vk_error_callback(&record, p_sh_vk_error_callback_data);
+	}
+
+	if (sh_vk_error_output == SH_ERROR_OUTPUT_PRINT) {
+		if (result == VK_ERROR_UNKNOWN) {
+			printf("shvulkan error: %s: %s\n", function, message);
+		}
+		else {
+			printf("shvulkan error: %s: %s, %s\n", function, message, shTranslateVkResult(result));
+		}
+		return;
+	}
+
+	if (sh_vk_error_output != SH_ERROR_OUTPUT_RING) {
+		return;
+	}
+
+	//claim a slot, only free slots can be claimed so published records are never overwritten
+	uint64_t write_idx = SH_ATOMIC_LOAD_U64(&sh_vk_error_ring_write_idx);
+	for (;;) {
+		if (write_idx - SH_ATOMIC_LOAD_U64(&sh_vk_error_ring_read_idx) >= SH_ERROR_RING_SIZE) {
+			SH_ATOMIC_ADD_U64(&sh_vk_error_dropped_count, 1);
+			return;
+		}
+		uint64_t expected = write_idx;
+		if (SH_ATOMIC_CAS_U64(&sh_vk_error_ring_write_idx, expected, write_idx + 1)) {
+			break;
+		}
+		write_idx = SH_ATOMIC_LOAD_U64(&sh_vk_error_ring_write_idx);
+	}
+
+	ShVkErrorRingSlot* p_slot = &sh_vk_error_ring[write_idx & (SH_ERROR_RING_SIZE - 1)];
+	p_slot->record = record;
+	SH_ATOMIC_STORE_U64(&p_slot->sequence, write_idx + 1);
+}
+
+uint8_t shGetLastError(
+	ShVkErrorRecord* p_record
+) {
+	if (p_record == VK_NULL_HANDLE) {
+		return 0;
+	}
+
+	(*p_record) = sh_vk_last_error_record;
+
+	return sh_vk_last_error_record.message != VK_NULL_HANDLE;
+}
+
+void shClearLastError(
+	void
+) {
+	memset(&sh_vk_last_error_record, 0, sizeof(ShVkErrorRecord));
+}
+
+uint8_t shSetErrorHandling(
+	ShVkErrorCallback callback,
+	void*             p_user_data,
+	ShVkErrorOutput   output
+) {
+	sh_vk_error_callback        = callback;
+	p_sh_vk_error_callback_data = p_user_data;
+	sh_vk_error_output          = output;
+
+	return 1;
+}
+
+uint8_t shDrainErrors(
+	uint32_t         max_record_count,
+	ShVkErrorRecord* p_records,
+	uint32_t*        p_record_count
+) {
+	shVkArgError(max_record_count > 0 && p_records == VK_NULL_HANDLE, "invalid error records memory",      return 0);
+	shVkArgError(p_record_count   == VK_NULL_HANDLE,                  "invalid error record count memory", return 0);
+
+	uint64_t read_idx     = SH_ATOMIC_LOAD_U64(&sh_vk_error_ring_read_idx);
+	uint32_t record_count = 0;
+
+	while (record_count < max_record_count) {
+		ShVkErrorRingSlot* p_slot = &sh_vk_error_ring[read_idx & (SH_ERROR_RING_SIZE - 1)];
+
+		//claimed but not yet published slots stop the drain
+		if (SH_ATOMIC_LOAD_U64(&p_slot->sequence) != read_idx + 1) {
+			break;
+		}
+
+		p_records[record_count] = p_slot->record;
+		record_count++;
+		read_idx++;
+
+		SH_ATOMIC_STORE_U64(&sh_vk_error_ring_read_idx, read_idx);
+	}
+
+	(*p_record_count) = record_count;
+
+	return 1;
+}
+
+uint8_t shPrintErrors(
+	void
+) {
+	ShVkErrorRecord records[16] = { 0 };
+	uint32_t        record_count = 0;
+
+	do {
+		shDrainErrors(16, records, &record_count);
+
+		for (uint32_t record_idx = 0; record_idx < record_count; record_idx++) {
+			ShVkErrorRecord* p_record = &records[record_idx];
+			if (p_record->result == VK_ERROR_UNKNOWN) {
+				printf("shvulkan error: %s: %s\n", p_record->function, p_record->message);
+			}
+			else {
+				printf("shvulkan error: %s: %s, %s\n", p_record->function, p_record->message, shTranslateVkResult(p_record->result));
+			}
+		}
+	} while (record_count == 16);
+
+	return 1;
+}
+
+uint8_t shGetErrorStats(
+	uint64_t* p_error_count,
+	uint64_t* p_dropped_count
+) {
+	if (p_error_count != VK_NULL_HANDLE) {
+		(*p_error_count) = SH_ATOMIC_LOAD_U64(&sh_vk_error_count);
+	}
+	if (p_dropped_count != VK_NULL_HANDLE) {
+		(*p_dropped_count) = SH_ATOMIC_LOAD_U64(&sh_vk_error_dropped_count);
+	}
+
+	return 1;
+}
+
 
 
 uint8_t shCreateInstance(
@@ -153,11 +635,11 @@ uint8_t shCreateInstance(
 	uint32_t       api_version,
 	VkInstance*    p_instance
 ) {
-	shVkError(p_instance         == VK_NULL_HANDLE, "invalid instance memory",          return 0);
-	shVkError(application_name   == VK_NULL_HANDLE, "invalid application name memory",  return 0);
-	shVkError(engine_name        == VK_NULL_HANDLE, "invalid engine name memory",       return 0);
+	shVkArgError(p_instance         == VK_NULL_HANDLE, "invalid instance memory",          return 0);
+	shVkArgError(application_name   == VK_NULL_HANDLE, "invalid application name memory",  return 0);
+	shVkArgError(engine_name        == VK_NULL_HANDLE, "invalid engine name memory",       return 0);
 	
-	shVkError(
+	shVkArgError(
 		extension_count > 0 && pp_extension_names == VK_NULL_HANDLE, 
 		"invalid extension names memory",   
 		return 0
@@ -215,7 +697,7 @@ uint8_t shGetPhysicalDeviceQueueFamilies(
 	uint32_t*                p_transfer_queue_family_indices,
 	VkQueueFamilyProperties* p_queue_families_properties
 ) {
-	shVkError(physical_device == VK_NULL_HANDLE, "invalid physical device memory",    return 0);
+	shVkArgError(physical_device == VK_NULL_HANDLE, "invalid physical device memory",    return 0);
 
 	uint32_t                queue_family_count = 0;
 	VkQueueFamilyProperties queue_families_properties[SH_MAX_STACK_QUEUE_FAMILY_COUNT];
@@ -301,8 +783,8 @@ uint8_t shGetQueueFamilySurfaceSupport(
 	VkSurfaceKHR     surface,
 	uint8_t*         p_support
 ) {
-	shVkError(physical_device == VK_NULL_HANDLE, "invalid physical device memory", return 0);
-	shVkError(p_support       == VK_NULL_HANDLE, "invalid support value memory",   return 0);
+	shVkArgError(physical_device == VK_NULL_HANDLE, "invalid physical device memory", return 0);
+	shVkArgError(p_support       == VK_NULL_HANDLE, "invalid support value memory",   return 0);
 
 	VkBool32 supported = 0;
 	vkGetPhysicalDeviceSurfaceSupportKHR(
@@ -324,196 +806,478 @@ uint8_t shSelectPhysicalDevice(
 	VkPhysicalDeviceFeatures*         p_physical_device_features,
 	VkPhysicalDeviceMemoryProperties* p_physical_device_memory_properties
 ) {
-	shVkError(instance                            == VK_NULL_HANDLE, "invalid instance memory",                return 0);
-	shVkError(p_physical_device                   == VK_NULL_HANDLE, "invalid physical device memory",         return 0);
-	shVkError(requirements                        == 0,    "invalid requirement flags",                        return 0);
-
-	uint32_t         physical_device_count = 0;
-	VkPhysicalDevice physical_devices[SH_MAX_STACK_PHYSICAL_DEVICE_COUNT] = { 0 };
-
-	vkEnumeratePhysicalDevices(instance, &physical_device_count, VK_NULL_HANDLE);
-	vkEnumeratePhysicalDevices(instance, &physical_device_count, physical_devices);
-	
-	shVkError(physical_device_count == 0, "no vulkan compatible gpu has been found", return 0);
-	shVkError(physical_device_count > SH_MAX_STACK_PHYSICAL_DEVICE_COUNT, "reached max physical device count", return 0);
-
-	uint32_t          suitable_physical_device_count = 0;
-	VkPhysicalDevice  suitable_physical_devices      [SH_MAX_STACK_PHYSICAL_DEVICE_COUNT] = { 0 };
+	shVkArgError(instance          == VK_NULL_HANDLE, "invalid instance memory",        return 0);
+	shVkArgError(p_physical_device == VK_NULL_HANDLE, "invalid physical device memory", return 0);
+	shVkArgError(requirements      == 0,              "invalid requirement flags",      return 0);
 
-	uint32_t graphics_queue_families_count[SH_MAX_STACK_PHYSICAL_DEVICE_COUNT] = { 0 };//for multiple device
-	uint32_t surface_queue_families_count [SH_MAX_STACK_PHYSICAL_DEVICE_COUNT] = { 0 };
-	uint32_t compute_queue_families_count [SH_MAX_STACK_PHYSICAL_DEVICE_COUNT] = { 0 };
-	uint32_t transfer_queue_families_count[SH_MAX_STACK_PHYSICAL_DEVICE_COUNT] = { 0 };
+	uint32_t         ranked_physical_device_count = 0;
+	VkPhysicalDevice ranked_physical_devices[SH_MAX_STACK_PHYSICAL_DEVICE_COUNT] = { 0 };
 
-	for (uint32_t physical_device_idx = 0; physical_device_idx < physical_device_count; physical_device_idx++) {
-		shGetPhysicalDeviceQueueFamilies(
-			physical_devices[physical_device_idx], 
+	shVkError(
+		shRankPhysicalDevices(
+			instance,
 			surface,
+			requirements,
 			VK_NULL_HANDLE,
-			&graphics_queue_families_count[physical_device_idx],
-			&surface_queue_families_count[physical_device_idx],
-			&compute_queue_families_count[physical_device_idx],
-			&transfer_queue_families_count[physical_device_idx],
-			VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE
-		);
-	}
-
-	for (uint32_t physical_device_idx = 0; physical_device_idx < physical_device_count; physical_device_idx++) {
-		VkPhysicalDevice physical_device      = physical_devices[physical_device_idx];
-
-		uint32_t graphics_queue_family_count  = graphics_queue_families_count[physical_device_idx];
-		uint32_t surface_queue_family_count   = surface_queue_families_count [physical_device_idx];
-		uint32_t compute_queue_family_count   = compute_queue_families_count [physical_device_idx];
-		uint32_t transfer_queue_family_count  = transfer_queue_families_count[physical_device_idx];
+			&ranked_physical_device_count,
+			ranked_physical_devices
+		) == 0,
+		"failed ranking physical devices",
+		return 0
+	);
 
-		uint32_t graphics_bit = ((requirements & VK_QUEUE_GRAPHICS_BIT) == 0) ? 1 : graphics_queue_family_count;
-		uint32_t surface_bit  = (surface == VK_NULL_HANDLE)                             ? 1 : surface_queue_family_count ;
-		uint32_t compute_bit  = ((requirements & VK_QUEUE_COMPUTE_BIT) == 0)  ? 1 : compute_queue_family_count;
-		uint32_t transfer_bit = ((requirements & VK_QUEUE_TRANSFER_BIT) == 0) ? 1 : transfer_queue_family_count;
-		
-		if (graphics_bit && surface_bit && compute_bit && transfer_bit) {
-			suitable_physical_devices[suitable_physical_device_count] = physical_device;
-			suitable_physical_device_count++;
-		}
+	(*p_physical_device) = ranked_physical_devices[0];
 
+	if (p_physical_device_properties != VK_NULL_HANDLE) {
+		vkGetPhysicalDeviceProperties(*p_physical_device, p_physical_device_properties);
+	}
+	if (p_physical_device_features != VK_NULL_HANDLE) {
+		vkGetPhysicalDeviceFeatures(*p_physical_device, p_physical_device_features);
+	}
+	if (p_physical_device_memory_properties != VK_NULL_HANDLE) {
+		vkGetPhysicalDeviceMemoryProperties(*p_physical_device, p_physical_device_memory_properties);
 	}
 
-	shVkError(suitable_physical_device_count == 0, "no suitable gpu has been found", return 0);
-
-	uint32_t scores[SH_MAX_STACK_PHYSICAL_DEVICE_COUNT] = { 0 };
-	for (uint32_t suitable_device_idx = 0; suitable_device_idx < suitable_physical_device_count; suitable_device_idx++) {
+	return 1;
+}
 
-		VkPhysicalDeviceProperties physical_device_properties = { 0 };
-		vkGetPhysicalDeviceProperties(physical_devices[suitable_device_idx], &physical_device_properties);
+uint8_t shScorePhysicalDevice(
+	VkPhysicalDevice physical_device,
+	uint64_t*        p_score
+) {
+	shVkArgError(physical_device == VK_NULL_HANDLE, "invalid physical device memory", return 0);
+	shVkArgError(p_score         == VK_NULL_HANDLE, "invalid score memory",           return 0);
+
+	VkPhysicalDeviceProperties physical_device_properties = { 0 };
+	vkGetPhysicalDeviceProperties(physical_device, &physical_device_properties);
+
+	uint64_t type_rank = 0;
+	switch (physical_device_properties.deviceType) {
+	case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU:
+		type_rank = 4;
+		break;
+	case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU:
+		type_rank = 3;
+		break;
+	case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU:
+		type_rank = 2;
+		break;
+	case VK_PHYSICAL_DEVICE_TYPE_CPU:
+		type_rank = 1;
+		break;
+	default:
+		type_rank = 0;
+		break;
+	}
 
-		VkPhysicalDeviceFeatures device_features = { 0 };
-		vkGetPhysicalDeviceFeatures(physical_devices[suitable_device_idx], &device_features);
+	VkPhysicalDeviceMemoryProperties memory_properties = { 0 };
+	vkGetPhysicalDeviceMemoryProperties(physical_device, &memory_properties);
 
-		if (requirements & VK_QUEUE_COMPUTE_BIT) {
-			scores[suitable_device_idx] += physical_device_properties.limits.maxMemoryAllocationCount;
-			scores[suitable_device_idx] += physical_device_properties.limits.maxComputeSharedMemorySize;
-			scores[suitable_device_idx] += physical_device_properties.limits.maxComputeWorkGroupInvocations;
-		}
-		if (requirements & VK_QUEUE_GRAPHICS_BIT) {
-			scores[suitable_device_idx] += physical_device_properties.limits.maxMemoryAllocationCount;
-			scores[suitable_device_idx] += physical_device_properties.limits.maxVertexInputAttributes;
-			scores[suitable_device_idx] += physical_device_properties.limits.maxVertexInputBindings;
-			scores[suitable_device_idx] += physical_device_properties.limits.maxVertexInputAttributeOffset;
-			scores[suitable_device_idx] += physical_device_properties.limits.maxVertexInputBindingStride;
-			scores[suitable_device_idx] += physical_device_properties.limits.maxVertexOutputComponents;
-			scores[suitable_device_idx] += physical_device_properties.limits.maxComputeWorkGroupInvocations;
+	uint64_t device_local_size = 0;
+	for (uint32_t heap_idx = 0; heap_idx < memory_properties.memoryHeapCount; heap_idx++) {
+		if (memory_properties.memoryHeaps[heap_idx].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) {
+			device_local_size += (uint64_t)memory_properties.memoryHeaps[heap_idx].size;
 		}
-
 	}
 
-	for (uint32_t suitable_device_idx = 0; suitable_device_idx < suitable_physical_device_count; suitable_device_idx++) {
-		if ((suitable_device_idx + 1) > suitable_physical_device_count) {
-			break;
-		}
-		if (scores[suitable_device_idx] > scores[suitable_device_idx + 1]) {
-			(*p_physical_device) = physical_devices[suitable_device_idx];
+	uint32_t                queue_family_count = 0;
+	VkQueueFamilyProperties queue_families_properties[SH_MAX_STACK_QUEUE_FAMILY_COUNT] = { 0 };
+
+	shGetPhysicalDeviceQueueFamilies(
+		physical_device, VK_NULL_HANDLE,
+		&queue_family_count,
+		VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE,
+		VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE,
+		queue_families_properties
+	);
+
+	uint64_t dedicated_queue_family_count = 0;
+	for (uint32_t queue_family_idx = 0; queue_family_idx < queue_family_count; queue_family_idx++) {
+		VkQueueFlags queue_flags = queue_families_properties[queue_family_idx].queueFlags;
+		if ((queue_flags & VK_QUEUE_COMPUTE_BIT) && !(queue_flags & VK_QUEUE_GRAPHICS_BIT)) {
+			dedicated_queue_family_count++;
 		}
-		else {
-			(*p_physical_device) = physical_devices[suitable_device_idx + 1];
+		else if ((queue_flags & VK_QUEUE_TRANSFER_BIT) && !(queue_flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT))) {
+			dedicated_queue_family_count++;
 		}
 	}
 
-	if (p_physical_device_properties != VK_NULL_HANDLE) {
-		vkGetPhysicalDeviceProperties(*p_physical_device, p_physical_device_properties);
+	uint64_t device_local_mib = device_local_size / (1024 * 1024);
+	if (device_local_mib > 0xFFFFFFFFFFFull) {
+		device_local_mib = 0xFFFFFFFFFFFull;
 	}
-	if (p_physical_device_features != VK_NULL_HANDLE) {
-		vkGetPhysicalDeviceFeatures(*p_physical_device, p_physical_device_features);
-	}
-	if (p_physical_device_memory_properties != VK_NULL_HANDLE) {
-		vkGetPhysicalDeviceMemoryProperties(*p_physical_device, p_physical_device_memory_properties);
+	if (dedicated_queue_family_count > 0xFF) {
+		dedicated_queue_family_count = 0xFF;
 	}
 
+	//type | device local MiB | dedicated queue families
+	(*p_score) = (type_rank << 56) | (device_local_mib << 8) | dedicated_queue_family_count;
+
 	return 1;
 }
 
-uint8_t shGetPhysicalDeviceSurfaceSupport(
-	VkPhysicalDevice          physical_device,
-	uint32_t                  queue_family_index,
-	VkSurfaceKHR              surface,
-	uint8_t*                  p_supported
+uint8_t shBenchmarkPhysicalDevice(
+	VkPhysicalDevice                  physical_device,
+	ShVkPhysicalDeviceBenchmarkCache* p_benchmark_cache,
+	float*                            p_copy_bandwidth
 ) {
-	shVkError(physical_device        == VK_NULL_HANDLE, "invalid physical device memory", return 0);
-	shVkError(surface                == VK_NULL_HANDLE, "invalid surface memory",         return 0);
+	shVkArgError(physical_device   == VK_NULL_HANDLE, "invalid physical device memory", return 0);
+	shVkArgError(p_benchmark_cache == VK_NULL_HANDLE, "invalid benchmark cache memory", return 0);
+	shVkArgError(p_copy_bandwidth  == VK_NULL_HANDLE, "invalid copy bandwidth memory",  return 0);
 
-	VkBool32 supported = 0;
-	vkGetPhysicalDeviceSurfaceSupportKHR(
-		physical_device, queue_family_index, surface, &supported
-	);
+	VkPhysicalDeviceIDProperties id_properties = {
+		.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ID_PROPERTIES
+	};
+	VkPhysicalDeviceProperties2 physical_device_properties = {
+		.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2,
+		.pNext = &id_properties
+	};
+	vkGetPhysicalDeviceProperties2(physical_device, &physical_device_properties);
 
-	if (p_supported != NULL) {
-		(*p_supported) = (uint8_t)supported;
+	for (uint32_t device_idx = 0; device_idx < p_benchmark_cache->device_count; device_idx++) {
+		if (memcmp(p_benchmark_cache->device_uuids[device_idx], id_properties.deviceUUID, VK_UUID_SIZE) == 0) {
+			(*p_copy_bandwidth) = p_benchmark_cache->copy_bandwidths[device_idx];
+			return 1;
+		}
 	}
 
-	return 1;
-}
+	shVkError(
+		p_benchmark_cache->device_count == SH_MAX_STACK_PHYSICAL_DEVICE_COUNT,
+		"reached max benchmark cache device count",
+		return 0
+	);
 
-uint8_t shGetPhysicalDeviceSurfaceCapabilities(
-	VkPhysicalDevice          physical_device,
-	VkSurfaceKHR              surface,
-	VkSurfaceCapabilitiesKHR* p_surface_capabilities
-) {
-	shVkError(physical_device        == VK_NULL_HANDLE, "invalid physical device memory",      return 0);
-	shVkError(surface                == VK_NULL_HANDLE, "invalid surface memory",              return 0);
-	shVkError(p_surface_capabilities == VK_NULL_HANDLE, "invalid surface capabilities memory", return 0);
+	uint32_t                queue_family_count = 0;
+	VkQueueFamilyProperties queue_families_properties[SH_MAX_STACK_QUEUE_FAMILY_COUNT] = { 0 };
+
+	shGetPhysicalDeviceQueueFamilies(
+		physical_device, VK_NULL_HANDLE,
+		&queue_family_count,
+		VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE,
+		VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE,
+		queue_families_properties
+	);
 
-	shVkResultError(
-		vkGetPhysicalDeviceSurfaceCapabilitiesKHR(physical_device, surface, p_surface_capabilities),
-		"failed getting physical device surface capabilities",
+	uint32_t queue_family_index = queue_family_count;
+	for (uint32_t queue_family_idx = 0; queue_family_idx < queue_family_count; queue_family_idx++) {
+		VkQueueFlags queue_flags = queue_families_properties[queue_family_idx].queueFlags;
+		if ((queue_flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT | VK_QUEUE_TRANSFER_BIT)) &&
+			queue_families_properties[queue_family_idx].timestampValidBits != 0) {
+			queue_family_index = queue_family_idx;
+			break;
+		}
+	}
+	shVkError(
+		queue_family_index == queue_family_count,
+		"no queue family supports timestamps",
 		return 0
 	);
 
-	return 1;
-}
+	float                   queue_priority = 1.0f;
+	VkDeviceQueueCreateInfo queue_info     = { 0 };
+	shQueryForDeviceQueueInfo(queue_family_index, 1, &queue_priority, 0, &queue_info);
 
-uint8_t shQueryForDeviceQueueInfo(
-	uint32_t                 queue_family_index, 
-	uint32_t                 queue_count,
-	float*                   p_queue_priorities,
-	uint8_t                  protected,
-	VkDeviceQueueCreateInfo* p_device_queue_info
-) {
-	shVkError(queue_count         == 0,    "invalid queue count",              return 0);
-	shVkError(p_queue_priorities  == VK_NULL_HANDLE, "invalid queue priorities memory",  return 0);
-	shVkError(p_device_queue_info == VK_NULL_HANDLE, "invalid device queue info memory", return 0);
+	VkDevice device = VK_NULL_HANDLE;
+	shVkError(
+		shSetLogicalDevice(physical_device, &device, 0, VK_NULL_HANDLE, 1, &queue_info, VK_NULL_HANDLE) == 0,
+		"failed creating benchmark device",
+		return 0
+	);
 
-	VkDeviceQueueCreateFlagBits flags = protected ? VK_DEVICE_QUEUE_CREATE_PROTECTED_BIT : 0;
+	VkQueue queue = VK_NULL_HANDLE;
+	vkGetDeviceQueue(device, queue_family_index, 0, &queue);
+
+	uint8_t         result        = 1;
+	VkBuffer        buffers[2]    = { VK_NULL_HANDLE, VK_NULL_HANDLE };
+	VkDeviceMemory  memories[2]   = { VK_NULL_HANDLE, VK_NULL_HANDLE };
+	VkCommandPool   cmd_pool      = VK_NULL_HANDLE;
+	VkCommandBuffer cmd_buffer    = VK_NULL_HANDLE;
+	VkFence         fence         = VK_NULL_HANDLE;
+	VkQueryPool     query_pool    = VK_NULL_HANDLE;
+	uint64_t        timestamps[2] = { 0 };
+
+	for (uint32_t buffer_idx = 0; buffer_idx < 2 && result; buffer_idx++) {
+		result = shCreateBuffer(
+			device, SH_PHYSICAL_DEVICE_BENCHMARK_BUFFER_SIZE,
+			VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+			VK_SHARING_MODE_EXCLUSIVE, &buffers[buffer_idx]
+		);
+		result = result && shAllocateBufferMemory(
+			device, physical_device, buffers[buffer_idx],
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &memories[buffer_idx]
+		);
+		result = result && shBindBufferMemory(device, buffers[buffer_idx], 0, memories[buffer_idx]);
+	}
 
-	VkDeviceQueueCreateInfo device_queue_info = {
-		.sType            = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
-		.pNext            = VK_NULL_HANDLE,                            
-		.flags            = flags,                                     
-		.queueFamilyIndex = queue_family_index,                        
-		.queueCount       = queue_count,                               
-		.pQueuePriorities = p_queue_priorities                         
-	};
-	
-	(*p_device_queue_info) = device_queue_info;
+	result = result && shCreateCommandPool(device, queue_family_index, &cmd_pool);
+	result = result && shAllocateCommandBuffers(device, cmd_pool, 1, &cmd_buffer);
+	result = result && shCreateFences(device, 1, 0, &fence);
+
+	if (result) {
+		VkQueryPoolCreateInfo query_pool_create_info = {
+			.sType              = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO, //sType;
+			.pNext              = VK_NULL_HANDLE,                           //pNext;
+			.flags              = 0,                                        //flags;
+			.queryType          = VK_QUERY_TYPE_TIMESTAMP,                  //queryType;
+			.queryCount         = 2,                                        //queryCount;
+			.pipelineStatistics = 0                                         //pipelineStatistics;
+		};
+		result = vkCreateQueryPool(device, &query_pool_create_info, VK_NULL_HANDLE, &query_pool) == VK_SUCCESS;
+	}
 
-	return 1;
-}
+	if (result) {
+		shBeginCommandBuffer(cmd_buffer);
 
-uint8_t shSetLogicalDevice(
-	VkPhysicalDevice         physical_device,
-	VkDevice*                p_device, 
-	uint32_t                 extension_count, 
-	char**                   pp_extension_names, 
+		vkCmdResetQueryPool(cmd_buffer, query_pool, 0, 2);
+		vkCmdFillBuffer(cmd_buffer, buffers[0], 0, VK_WHOLE_SIZE, 0);
+
+		VkMemoryBarrier memory_barrier = {
+			.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER, //sType;
+			.pNext         = VK_NULL_HANDLE,                   //pNext;
+			.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,     //srcAccessMask;
+			.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT       //dstAccessMask;
+		};
+		vkCmdPipelineBarrier(
+			cmd_buffer,
+			VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+			0, 1, &memory_barrier, 0, VK_NULL_HANDLE, 0, VK_NULL_HANDLE
+		);
+
+		vkCmdWriteTimestamp(cmd_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, query_pool, 0);
+		for (uint32_t iteration_idx = 0; iteration_idx < SH_PHYSICAL_DEVICE_BENCHMARK_ITERATION_COUNT; iteration_idx++) {
+			shCopyBuffer(cmd_buffer, buffers[0], 0, 0, SH_PHYSICAL_DEVICE_BENCHMARK_BUFFER_SIZE, buffers[1]);
+		}
+		vkCmdWriteTimestamp(cmd_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, query_pool, 1);
+
+		shEndCommandBuffer(cmd_buffer);
+
+		result = shQueueSubmit(1, &cmd_buffer, queue, fence, 0, VK_NULL_HANDLE, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, VK_NULL_HANDLE);
+		result = result && shWaitForFences(device, 1, &fence, 1, UINT64_MAX);
+		result = result && vkGetQueryPoolResults(
+			device, query_pool, 0, 2,
+			sizeof(timestamps), timestamps, sizeof(uint64_t),
+			VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT
+		) == VK_SUCCESS;
+	}
+
+	if (query_pool != VK_NULL_HANDLE) {
+		vkDestroyQueryPool(device, query_pool, VK_NULL_HANDLE);
+	}
+	if (fence != VK_NULL_HANDLE) {
+		shDestroyFences(device, 1, &fence);
+	}
+	if (cmd_pool != VK_NULL_HANDLE) {
+		shDestroyCommandPool(device, cmd_pool);
+	}
+	for (uint32_t buffer_idx = 0; buffer_idx < 2; buffer_idx++) {
+		if (buffers[buffer_idx] != VK_NULL_HANDLE) {
+			vkDestroyBuffer(device, buffers[buffer_idx], VK_NULL_HANDLE);
+		}
+		if (memories[buffer_idx] != VK_NULL_HANDLE) {
+			vkFreeMemory(device, memories[buffer_idx], VK_NULL_HANDLE);
+		}
+	}
+	shDestroyDevice(device);
+
+	shVkError(result == 0, "failed running physical device benchmark", return 0);
+
+	double elapsed_ns = (double)(timestamps[1] - timestamps[0]) * (double)physical_device_properties.properties.limits.timestampPeriod;
+	double copied     = (double)SH_PHYSICAL_DEVICE_BENCHMARK_BUFFER_SIZE * (double)SH_PHYSICAL_DEVICE_BENCHMARK_ITERATION_COUNT;
+
+	float copy_bandwidth = (elapsed_ns > 0.0) ? (float)(copied / elapsed_ns) : 0.0f;//bytes per ns = GB/s
+
+	uint32_t device_idx = p_benchmark_cache->device_count;
+	memcpy(p_benchmark_cache->device_uuids[device_idx], id_properties.deviceUUID, VK_UUID_SIZE);
+	p_benchmark_cache->copy_bandwidths[device_idx] = copy_bandwidth;
+	p_benchmark_cache->device_count++;
+
+	(*p_copy_bandwidth) = copy_bandwidth;
+
+	return 1;
+}
+
+uint8_t shRankPhysicalDevices(
+	VkInstance                        instance,
+	VkSurfaceKHR                      surface,
+	VkQueueFlags                      requirements,
+	ShVkPhysicalDeviceBenchmarkCache* p_benchmark_cache,
+	uint32_t*                         p_physical_device_count,
+	VkPhysicalDevice*                 p_physical_devices
+) {
+	shVkArgError(instance                == VK_NULL_HANDLE, "invalid instance memory",              return 0);
+	shVkArgError(requirements            == 0,              "invalid requirement flags",            return 0);
+	shVkArgError(p_physical_device_count == VK_NULL_HANDLE, "invalid physical device count memory", return 0);
+	shVkArgError(p_physical_devices      == VK_NULL_HANDLE, "invalid physical devices memory",      return 0);
+
+	uint32_t         physical_device_count = 0;
+	VkPhysicalDevice physical_devices[SH_MAX_STACK_PHYSICAL_DEVICE_COUNT] = { 0 };
+
+	vkEnumeratePhysicalDevices(instance, &physical_device_count, VK_NULL_HANDLE);
+
+	shVkError(physical_device_count == 0, "no vulkan compatible gpu has been found", return 0);
+	shVkError(physical_device_count > SH_MAX_STACK_PHYSICAL_DEVICE_COUNT, "reached max physical device count", return 0);
+
+	vkEnumeratePhysicalDevices(instance, &physical_device_count, physical_devices);
+
+	uint32_t         suitable_physical_device_count = 0;
+	VkPhysicalDevice suitable_physical_devices[SH_MAX_STACK_PHYSICAL_DEVICE_COUNT] = { 0 };
+	uint64_t         primary_scores           [SH_MAX_STACK_PHYSICAL_DEVICE_COUNT] = { 0 };
+	uint64_t         secondary_scores         [SH_MAX_STACK_PHYSICAL_DEVICE_COUNT] = { 0 };
+
+	for (uint32_t physical_device_idx = 0; physical_device_idx < physical_device_count; physical_device_idx++) {
+		VkPhysicalDevice physical_device = physical_devices[physical_device_idx];
+
+		uint32_t graphics_queue_family_count = 0;
+		uint32_t surface_queue_family_count  = 0;
+		uint32_t compute_queue_family_count  = 0;
+		uint32_t transfer_queue_family_count = 0;
+
+		shGetPhysicalDeviceQueueFamilies(
+			physical_device, 
+			surface,
+			VK_NULL_HANDLE,
+			&graphics_queue_family_count,
+			&surface_queue_family_count,
+			&compute_queue_family_count,
+			&transfer_queue_family_count,
+			VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE
+		);
+
+		uint32_t graphics_bit = ((requirements & VK_QUEUE_GRAPHICS_BIT) == 0) ? 1 : graphics_queue_family_count;
+		uint32_t surface_bit  = (surface == VK_NULL_HANDLE)                   ? 1 : surface_queue_family_count;
+		uint32_t compute_bit  = ((requirements & VK_QUEUE_COMPUTE_BIT) == 0)  ? 1 : compute_queue_family_count;
+		uint32_t transfer_bit = ((requirements & VK_QUEUE_TRANSFER_BIT) == 0) ? 1 : transfer_queue_family_count;
+		
+		if (!(graphics_bit && surface_bit && compute_bit && transfer_bit)) {
+			continue;
+		}
+
+		uint64_t static_score = 0;
+		shScorePhysicalDevice(physical_device, &static_score);
+
+		uint64_t primary_score   = static_score;
+		uint64_t secondary_score = 0;
+
+		if (p_benchmark_cache != VK_NULL_HANDLE) {
+			float copy_bandwidth = 0.0f;
+			if (shBenchmarkPhysicalDevice(physical_device, p_benchmark_cache, &copy_bandwidth)) {
+				primary_score   = (uint64_t)(copy_bandwidth * 1000.0f);//MB/s
+				secondary_score = static_score;
+			}
+		}
+
+		//insertion sort, best first
+		uint32_t insert_idx = suitable_physical_device_count;
+		while (
+			insert_idx > 0 && (
+				primary_scores[insert_idx - 1] < primary_score || (
+				primary_scores[insert_idx - 1] == primary_score && secondary_scores[insert_idx - 1] < secondary_score)
+			)
+		) {
+			suitable_physical_devices[insert_idx] = suitable_physical_devices[insert_idx - 1];
+			primary_scores           [insert_idx] = primary_scores           [insert_idx - 1];
+			secondary_scores         [insert_idx] = secondary_scores         [insert_idx - 1];
+			insert_idx--;
+		}
+		suitable_physical_devices[insert_idx] = physical_device;
+		primary_scores           [insert_idx] = primary_score;
+		secondary_scores         [insert_idx] = secondary_score;
+
+		suitable_physical_device_count++;
+	}
+
+	shVkError(suitable_physical_device_count == 0, "no suitable gpu has been found", return 0);
+
+	memcpy(p_physical_devices, suitable_physical_devices, sizeof(VkPhysicalDevice) * suitable_physical_device_count);
+	(*p_physical_device_count) = suitable_physical_device_count;
+
+	return 1;
+}
+
+uint8_t shGetPhysicalDeviceSurfaceSupport(
+	VkPhysicalDevice          physical_device,
+	uint32_t                  queue_family_index,
+	VkSurfaceKHR              surface,
+	uint8_t*                  p_supported
+) {
+	shVkArgError(physical_device        == VK_NULL_HANDLE, "invalid physical device memory", return 0);
+	shVkArgError(surface                == VK_NULL_HANDLE, "invalid surface memory",         return 0);
+
+	VkBool32 supported = 0;
+	vkGetPhysicalDeviceSurfaceSupportKHR(
+		physical_device, queue_family_index, surface, &supported
+	);
+
+	if (p_supported != NULL) {
+		(*p_supported) = (uint8_t)supported;
+	}
+
+	return 1;
+}
+
+uint8_t shGetPhysicalDeviceSurfaceCapabilities(
+	VkPhysicalDevice          physical_device,
+	VkSurfaceKHR              surface,
+	VkSurfaceCapabilitiesKHR* p_surface_capabilities
+) {
+	shVkArgError(physical_device        == VK_NULL_HANDLE, "invalid physical device memory",      return 0);
+	shVkArgError(surface                == VK_NULL_HANDLE, "invalid surface memory",              return 0);
+	shVkArgError(p_surface_capabilities == VK_NULL_HANDLE, "invalid surface capabilities memory", return 0);
+
+	shVkResultError(
+		vkGetPhysicalDeviceSurfaceCapabilitiesKHR(physical_device, surface, p_surface_capabilities),
+		"failed getting physical device surface capabilities",
+		return 0
+	);
+
+	return 1;
+}
+
+uint8_t shQueryForDeviceQueueInfo(
+	uint32_t                 queue_family_index, 
+	uint32_t                 queue_count,
+	float*                   p_queue_priorities,
+	uint8_t                  protected,
+	VkDeviceQueueCreateInfo* p_device_queue_info
+) {
+	shVkArgError(queue_count         == 0,    "invalid queue count",              return 0);
+	shVkArgError(p_queue_priorities  == VK_NULL_HANDLE, "invalid queue priorities memory",  return 0);
+	shVkArgError(p_device_queue_info == VK_NULL_HANDLE, "invalid device queue info memory", return 0);
+
+	VkDeviceQueueCreateFlagBits flags = protected ? VK_DEVICE_QUEUE_CREATE_PROTECTED_BIT : 0;
+
+	VkDeviceQueueCreateInfo device_queue_info = {
+		.sType            = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
+		.pNext            = VK_NULL_HANDLE,                            
+		.flags            = flags,                                     
+		.queueFamilyIndex = queue_family_index,                        
+		.queueCount       = queue_count,                               
+		.pQueuePriorities = p_queue_priorities                         
+	};
+	
+	(*p_device_queue_info) = device_queue_info;
+
+	return 1;
+}
+
+uint8_t shSetLogicalDevice(
+	VkPhysicalDevice         physical_device,
+	VkDevice*                p_device, 
+	uint32_t                 extension_count, 
+	char**                   pp_extension_names, 
 	uint32_t                 device_queue_count, 
-	VkDeviceQueueCreateInfo* p_device_queue_infos
+	VkDeviceQueueCreateInfo* p_device_queue_infos,
+	void*                    p_next
 ) {
-	shVkError(physical_device        == VK_NULL_HANDLE,                 "invalid physical device memory",      return 0);
-	shVkError(p_device               == VK_NULL_HANDLE,                 "invalid device memory",               return 0);
-	shVkError(extension_count        > 0 && pp_extension_names == NULL, "invalid extensions names memory",     return 0);
-	shVkError(device_queue_count     == 0,                              "invalid device queue count",          return 0);
-	shVkError(p_device_queue_infos   == VK_NULL_HANDLE,                 "invalid device queue infos memory",   return 0);
+	shVkArgError(physical_device        == VK_NULL_HANDLE,                 "invalid physical device memory",      return 0);
+	shVkArgError(p_device               == VK_NULL_HANDLE,                 "invalid device memory",               return 0);
+	shVkArgError(extension_count        > 0 && pp_extension_names == NULL, "invalid extensions names memory",     return 0);
+	shVkArgError(device_queue_count     == 0,                              "invalid device queue count",          return 0);
+	shVkArgError(p_device_queue_infos   == VK_NULL_HANDLE,                 "invalid device queue infos memory",   return 0);
 
 	VkDeviceCreateInfo device_create_info = {
 		.sType                   = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,   //sType;
-		.pNext                   = VK_NULL_HANDLE,                         //pNext;
+		.pNext                   = p_next,                                 //pNext;
 		.flags                   = 0,                                      //flags;
 		.queueCreateInfoCount    = device_queue_count,                     //queueCreateInfoCount;
 		.pQueueCreateInfos       = p_device_queue_infos,                   //pQueueCreateInfos;
@@ -529,6 +1293,147 @@ uint8_t shSetLogicalDevice(
 		"error creating logical device", return 0
 	);
 
+	//without room left, shBeginRendering and shEndRendering look their functions up on each call
+	shRegisterDevice(*p_device);
+
+	return 1;
+}
+
+uint8_t shInitDeviceFeatures(
+	uint32_t            api_version,
+	ShVkDeviceFeatures* p_features
+) {
+	shVkArgError(p_features == VK_NULL_HANDLE, "invalid device features memory", return 0);
+
+	memset(p_features, 0, sizeof(ShVkDeviceFeatures));
+
+	p_features->api_version    = api_version;
+	p_features->features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+	p_features->vulkan11.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_1_FEATURES;
+	p_features->vulkan12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+	p_features->vulkan13.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+
+	//the VulkanXY feature structures are only valid on devices of that version
+	if (api_version >= VK_API_VERSION_1_2) {
+		p_features->features.pNext = &p_features->vulkan11;
+		p_features->vulkan11.pNext = &p_features->vulkan12;
+	}
+	if (api_version >= VK_API_VERSION_1_3) {
+		p_features->vulkan12.pNext = &p_features->vulkan13;
+	}
+
+	return 1;
+}
+
+uint8_t shGetPhysicalDeviceFeatures(
+	VkPhysicalDevice    physical_device,
+	uint32_t            instance_api_version,
+	ShVkDeviceFeatures* p_features
+) {
+	shVkArgError(physical_device == VK_NULL_HANDLE, "invalid physical device memory", return 0);
+	shVkArgError(p_features      == VK_NULL_HANDLE, "invalid device features memory", return 0);
+
+	VkPhysicalDeviceProperties properties = { 0 };
+	vkGetPhysicalDeviceProperties(physical_device, &properties);
+
+	//the instance version caps what the application may use, whatever the device reports
+	uint32_t api_version = (instance_api_version < properties.apiVersion) ? instance_api_version : properties.apiVersion;
+
+	shInitDeviceFeatures(api_version, p_features);
+
+	if (api_version >= VK_API_VERSION_1_1) {
+		vkGetPhysicalDeviceFeatures2(physical_device, &p_features->features);
+	}
+	else {
+		vkGetPhysicalDeviceFeatures(physical_device, &p_features->features.features);
+	}
+
+	return 1;
+}
+
+static uint8_t shCombineFeatureBools(
+	uint32_t  bool_count,
+	VkBool32* p_required,
+	VkBool32* p_wanted,
+	VkBool32* p_supported,
+	VkBool32* p_enabled
+) {
+	uint8_t all_required_supported = 1;
+
+	for (uint32_t bool_idx = 0; bool_idx < bool_count; bool_idx++) {
+		VkBool32 required = p_required != VK_NULL_HANDLE ? p_required[bool_idx] : VK_FALSE;
+		VkBool32 wanted   = p_wanted   != VK_NULL_HANDLE ? p_wanted[bool_idx]   : VK_FALSE;
+
+		if (required && !p_supported[bool_idx]) {
+			all_required_supported = 0;
+		}
+
+		p_enabled[bool_idx] = (required || wanted) && p_supported[bool_idx];
+	}
+
+	return all_required_supported;
+}
+
+//feature structures are a sType/pNext header followed by contiguous VkBool32 members, counted from the first to
+//the last member: sizeof includes the tail padding after an odd member count
+#define SH_FEATURE_BOOL_COUNT(feature_struct_type, first_member, last_member)\
+	((uint32_t)((offsetof(feature_struct_type, last_member) - offsetof(feature_struct_type, first_member)) / sizeof(VkBool32) + 1))
+
+#define SH_VULKAN11_FEATURE_BOOL_COUNT\
+	SH_FEATURE_BOOL_COUNT(VkPhysicalDeviceVulkan11Features, storageBuffer16BitAccess, shaderDrawParameters)        //12
+#define SH_VULKAN12_FEATURE_BOOL_COUNT\
+	SH_FEATURE_BOOL_COUNT(VkPhysicalDeviceVulkan12Features, samplerMirrorClampToEdge, subgroupBroadcastDynamicId) //47
+#define SH_VULKAN13_FEATURE_BOOL_COUNT\
+	SH_FEATURE_BOOL_COUNT(VkPhysicalDeviceVulkan13Features, robustImageAccess, maintenance4)                      //15
+
+uint8_t shNegotiateDeviceFeatures(
+	VkPhysicalDevice    physical_device,
+	uint32_t            instance_api_version,
+	ShVkDeviceFeatures* p_required,
+	ShVkDeviceFeatures* p_wanted,
+	ShVkDeviceFeatures* p_enabled
+) {
+	shVkArgError(physical_device == VK_NULL_HANDLE, "invalid physical device memory",         return 0);
+	shVkArgError(p_enabled       == VK_NULL_HANDLE, "invalid enabled device features memory", return 0);
+
+	ShVkDeviceFeatures supported = { 0 };
+	shGetPhysicalDeviceFeatures(physical_device, instance_api_version, &supported);
+
+	shInitDeviceFeatures(supported.api_version, p_enabled);
+
+	uint8_t all_required_supported = shCombineFeatureBools(
+		(uint32_t)(sizeof(VkPhysicalDeviceFeatures) / sizeof(VkBool32)),
+		p_required != VK_NULL_HANDLE ? (VkBool32*)&p_required->features.features : VK_NULL_HANDLE,
+		p_wanted   != VK_NULL_HANDLE ? (VkBool32*)&p_wanted->features.features   : VK_NULL_HANDLE,
+		(VkBool32*)&supported.features.features,
+		(VkBool32*)&p_enabled->features.features
+	);
+	
+	//unsupported structures are zero in supported, so required features inside them are reported as missing
+	all_required_supported &= shCombineFeatureBools(
+		SH_VULKAN11_FEATURE_BOOL_COUNT,
+		p_required != VK_NULL_HANDLE ? &p_required->vulkan11.storageBuffer16BitAccess : VK_NULL_HANDLE,
+		p_wanted   != VK_NULL_HANDLE ? &p_wanted->vulkan11.storageBuffer16BitAccess   : VK_NULL_HANDLE,
+		&supported.vulkan11.storageBuffer16BitAccess,
+		&p_enabled->vulkan11.storageBuffer16BitAccess
+	);
+	all_required_supported &= shCombineFeatureBools(
+		SH_VULKAN12_FEATURE_BOOL_COUNT,
+		p_required != VK_NULL_HANDLE ? &p_required->vulkan12.samplerMirrorClampToEdge : VK_NULL_HANDLE,
+		p_wanted   != VK_NULL_HANDLE ? &p_wanted->vulkan12.samplerMirrorClampToEdge   : VK_NULL_HANDLE,
+		&supported.vulkan12.samplerMirrorClampToEdge,
+		&p_enabled->vulkan12.samplerMirrorClampToEdge
+	);
+	all_required_supported &= shCombineFeatureBools(
+		SH_VULKAN13_FEATURE_BOOL_COUNT,
+		p_required != VK_NULL_HANDLE ? &p_required->vulkan13.robustImageAccess : VK_NULL_HANDLE,
+		p_wanted   != VK_NULL_HANDLE ? &p_wanted->vulkan13.robustImageAccess   : VK_NULL_HANDLE,
+		&supported.vulkan13.robustImageAccess,
+		&p_enabled->vulkan13.robustImageAccess
+	);
+
+	shVkError(all_required_supported == 0, "required device features are not supported", return 0);
+
 	return 1;
 }
 
@@ -538,15 +1443,22 @@ uint8_t shGetDeviceQueues(
 	uint32_t* p_queue_family_indices,
 	VkQueue*  p_queues
 ) {
-	shVkError(device                 == VK_NULL_HANDLE, "invalid device memory",               return 0);
-	shVkError(p_queue_family_indices == VK_NULL_HANDLE, "invalid queue family indices memory", return 0);
-	shVkError(p_queues               == VK_NULL_HANDLE, "invalid queues memory",               return 0);
+	shVkArgError(device                 == VK_NULL_HANDLE, "invalid device memory",               return 0);
+	shVkArgError(p_queue_family_indices == VK_NULL_HANDLE, "invalid queue family indices memory", return 0);
+	shVkArgError(p_queues               == VK_NULL_HANDLE, "invalid queues memory",               return 0);
 
 	for (uint32_t queue_idx = 0; queue_idx < queue_count; queue_idx++) {
+		//index inside the family, not inside the array
+		uint32_t family_queue_idx = 0;
+		for (uint32_t previous_idx = 0; previous_idx < queue_idx; previous_idx++) {
+			if (p_queue_family_indices[previous_idx] == p_queue_family_indices[queue_idx]) {
+				family_queue_idx++;
+			}
+		}
 		vkGetDeviceQueue(
 			device,
 			p_queue_family_indices[queue_idx],
-			queue_idx,
+			family_queue_idx,
 			&p_queues[queue_idx]
 		);
 	}
@@ -554,14 +1466,166 @@ uint8_t shGetDeviceQueues(
 	return 1;
 }
 
+uint8_t shQueryQueueTopology(
+	VkPhysicalDevice   physical_device,
+	VkSurfaceKHR       surface,
+	float*             p_queue_priorities,
+	ShVkQueueTopology* p_topology
+) {
+	shVkArgError(physical_device    == VK_NULL_HANDLE, "invalid physical device memory",  return 0);
+	shVkArgError(p_queue_priorities == VK_NULL_HANDLE, "invalid queue priorities memory", return 0);
+	shVkArgError(p_topology         == VK_NULL_HANDLE, "invalid queue topology memory",   return 0);
+
+	uint32_t                queue_family_count = 0;
+	VkQueueFamilyProperties queue_families_properties[SH_MAX_STACK_QUEUE_FAMILY_COUNT] = { 0 };
+
+	shGetPhysicalDeviceQueueFamilies(
+		physical_device, VK_NULL_HANDLE,
+		&queue_family_count,
+		VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE,
+		VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE,
+		queue_families_properties
+	);
+
+	ShVkQueueTopology topology = { 0 };
+	for (uint32_t role_idx = 0; role_idx < SH_QUEUE_ROLE_COUNT; role_idx++) {
+		topology.queue_family_indices[role_idx] = VK_QUEUE_FAMILY_IGNORED;
+	}
+
+	uint32_t graphics_family = VK_QUEUE_FAMILY_IGNORED;
+	uint32_t compute_family  = VK_QUEUE_FAMILY_IGNORED;
+	uint32_t transfer_family = VK_QUEUE_FAMILY_IGNORED;
+
+	for (uint32_t queue_family_idx = 0; queue_family_idx < queue_family_count; queue_family_idx++) {
+		VkQueueFlags queue_flags = queue_families_properties[queue_family_idx].queueFlags;
+
+		if ((queue_flags & VK_QUEUE_GRAPHICS_BIT) && graphics_family == VK_QUEUE_FAMILY_IGNORED) {
+			uint8_t surface_support = 1;
+			if (surface != VK_NULL_HANDLE) {
+				shGetPhysicalDeviceSurfaceSupport(physical_device, queue_family_idx, surface, &surface_support);
+			}
+			if (surface_support) {
+				graphics_family = queue_family_idx;
+			}
+		}
+		if ((queue_flags & VK_QUEUE_COMPUTE_BIT) && !(queue_flags & VK_QUEUE_GRAPHICS_BIT) &&
+			compute_family == VK_QUEUE_FAMILY_IGNORED) {
+			compute_family = queue_family_idx;
+			topology.dedicated[SH_QUEUE_ROLE_COMPUTE] = 1;
+		}
+		if ((queue_flags & VK_QUEUE_TRANSFER_BIT) && !(queue_flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)) &&
+			transfer_family == VK_QUEUE_FAMILY_IGNORED) {
+			transfer_family = queue_family_idx;
+			topology.dedicated[SH_QUEUE_ROLE_TRANSFER] = 1;
+		}
+	}
+
+	//graphics and compute families implicitly support transfer
+	if (compute_family == VK_QUEUE_FAMILY_IGNORED) {
+		for (uint32_t queue_family_idx = 0; queue_family_idx < queue_family_count; queue_family_idx++) {
+			if (queue_families_properties[queue_family_idx].queueFlags & VK_QUEUE_COMPUTE_BIT) {
+				compute_family = (graphics_family != VK_QUEUE_FAMILY_IGNORED &&
+					(queue_families_properties[graphics_family].queueFlags & VK_QUEUE_COMPUTE_BIT)) ?
+					graphics_family : queue_family_idx;
+				break;
+			}
+		}
+	}
+	if (transfer_family == VK_QUEUE_FAMILY_IGNORED) {
+		transfer_family = topology.dedicated[SH_QUEUE_ROLE_COMPUTE] ? compute_family :
+			(graphics_family != VK_QUEUE_FAMILY_IGNORED) ? graphics_family : compute_family;
+	}
+
+	shVkError(
+		graphics_family == VK_QUEUE_FAMILY_IGNORED && compute_family == VK_QUEUE_FAMILY_IGNORED,
+		"no graphics or compute queue family found",
+		return 0
+	);
+
+	uint32_t role_families[SH_QUEUE_ROLE_COUNT] = { graphics_family, compute_family, transfer_family };
+
+	uint32_t family_infos      [SH_MAX_STACK_QUEUE_FAMILY_COUNT] = { 0 };
+	uint32_t family_queue_count[SH_MAX_STACK_QUEUE_FAMILY_COUNT] = { 0 };
+
+	for (uint32_t role_idx = 0; role_idx < SH_QUEUE_ROLE_COUNT; role_idx++) {
+		uint32_t family = role_families[role_idx];
+		if (family == VK_QUEUE_FAMILY_IGNORED) {
+			continue;
+		}
+
+		if (family_queue_count[family] == 0) {
+			family_infos[family] = topology.device_queue_info_count;
+			topology.device_queue_info_count++;
+		}
+
+		uint32_t info_idx = family_infos[family];
+
+		if (family_queue_count[family] < queue_families_properties[family].queueCount) {
+			topology.queue_priorities[info_idx][family_queue_count[family]] = p_queue_priorities[role_idx];
+			topology.queue_indices[role_idx] = family_queue_count[family];
+			family_queue_count[family]++;
+		}
+		else {
+			//share the last queue of the family
+			topology.queue_indices[role_idx] = family_queue_count[family] - 1;
+		}
+		topology.queue_family_indices[role_idx] = family;
+	}
+
+	(*p_topology) = topology;
+
+	for (uint32_t role_idx = 0; role_idx < SH_QUEUE_ROLE_COUNT; role_idx++) {
+		uint32_t family = role_families[role_idx];
+		if (family == VK_QUEUE_FAMILY_IGNORED) {
+			continue;
+		}
+		uint32_t info_idx = family_infos[family];
+		if (p_topology->device_queue_infos[info_idx].sType == VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO) {//already queried
+			continue;
+		}
+		shQueryForDeviceQueueInfo(
+			family,
+			family_queue_count[family],
+			p_topology->queue_priorities[info_idx],
+			0,
+			&p_topology->device_queue_infos[info_idx]
+		);
+	}
+
+	return 1;
+}
+
+uint8_t shGetQueueTopologyQueues(
+	VkDevice           device,
+	ShVkQueueTopology* p_topology
+) {
+	shVkArgError(device     == VK_NULL_HANDLE, "invalid device memory",         return 0);
+	shVkArgError(p_topology == VK_NULL_HANDLE, "invalid queue topology memory", return 0);
+
+	for (uint32_t role_idx = 0; role_idx < SH_QUEUE_ROLE_COUNT; role_idx++) {
+		if (p_topology->queue_family_indices[role_idx] == VK_QUEUE_FAMILY_IGNORED) {
+			p_topology->queues[role_idx] = VK_NULL_HANDLE;
+			continue;
+		}
+		vkGetDeviceQueue(
+			device,
+			p_topology->queue_family_indices[role_idx],
+			p_topology->queue_indices[role_idx],
+			&p_topology->queues[role_idx]
+		);
+	}
+
+	return 1;
+}
+
 uint8_t shCheckSupportedDeviceColorFormat(
 	VkPhysicalDevice physical_device,
 	VkFormat         format,
 	uint8_t*         p_color_attachment_supported
 ) {
-	shVkError(physical_device              == NULL,                "invalid physical device memory",               return 0);
-	shVkError(format                       == VK_FORMAT_UNDEFINED, "invalid color format",                         return 0);
-	shVkError(p_color_attachment_supported == NULL,                "invalid color attachment support byte memory", return 0);
+	shVkArgError(physical_device              == NULL,                "invalid physical device memory",               return 0);
+	shVkArgError(format                       == VK_FORMAT_UNDEFINED, "invalid color format",                         return 0);
+	shVkArgError(p_color_attachment_supported == NULL,                "invalid color attachment support byte memory", return 0);
 
 	VkFormatProperties format_properties = { 0 };
 
@@ -587,12 +1651,12 @@ uint8_t shFindSupportedDeviceColorFormats(
 	uint32_t*               p_single_channels_sizes,
 	uint32_t*               p_channels_types
 ) {
-	shVkError(physical_device              == NULL, "invalid physical device memory",         return 0);
-	shVkError(p_supported_format_count     == NULL, "invalid supported format count pointer", return 0);
-	shVkError(p_supported_formats          == NULL, "invalid supported formats memory",       return 0);
-	shVkError(p_single_channels_sizes      == NULL, "invalid channels sizes memory",          return 0);
-	shVkError(p_channels_count             == NULL, "invalid channels count memory",          return 0);
-	shVkError(p_channels_types             == NULL, "invalid channels types memort",          return 0);
+	shVkArgError(physical_device              == NULL, "invalid physical device memory",         return 0);
+	shVkArgError(p_supported_format_count     == NULL, "invalid supported format count pointer", return 0);
+	shVkArgError(p_supported_formats          == NULL, "invalid supported formats memory",       return 0);
+	shVkArgError(p_single_channels_sizes      == NULL, "invalid channels sizes memory",          return 0);
+	shVkArgError(p_channels_count             == NULL, "invalid channels count memory",          return 0);
+	shVkArgError(p_channels_types             == NULL, "invalid channels types memort",          return 0);
 
 	VkFormat color_formats[SH_MAX_STACK_DEVICE_COLOR_FORMATS_QUERIES] = {
 
@@ -936,25 +2000,92 @@ uint8_t shFindSupportedDeviceColorFormats(
 	return 1;
 }
 
-uint8_t shCreateSwapchain(
-	VkDevice                 device, 
-	VkPhysicalDevice         physical_device,
-	VkSurfaceKHR             surface,
-	VkFormat                 image_format,
-	VkFormat*                p_image_format,
-	uint32_t                 swapchain_image_count,
-	VkSharingMode            image_sharing_mode,
-	uint8_t                  vsync,
-	uint32_t*                p_swapchain_image_count,
-	VkSwapchainKHR*          p_swapchain
+uint8_t shSelectPresentMode(
+	VkPhysicalDevice  physical_device,
+	VkSurfaceKHR      surface,
+	ShVkPresentPolicy present_policy,
+	VkPresentModeKHR* p_present_mode
 ) {
-	shVkError(device                  == VK_NULL_HANDLE, "invalid device memory",                return 0);
-	shVkError(swapchain_image_count   == 0,              "invalid swapchain image count",        return 0);
-	shVkError(p_swapchain_image_count == NULL,           "invalid swapchain image count memory", return 0);
+	shVkArgError(physical_device == VK_NULL_HANDLE, "invalid physical device memory", return 0);
+	shVkArgError(surface         == VK_NULL_HANDLE, "invalid surface memory",         return 0);
+	shVkArgError(p_present_mode  == VK_NULL_HANDLE, "invalid present mode memory",    return 0);
 
-	uint32_t                 _swapchain_image_count                                    =   0  ;
-	uint32_t                 format_count                                              =   0  ;
-	VkSurfaceFormatKHR       surface_formats[SH_MAX_STACK_DEVICE_SURFACE_FORMAT_COUNT] = { 0 };
+	uint32_t         present_mode_count                                     = 0;
+	VkPresentModeKHR present_modes[SH_MAX_STACK_SURFACE_PRESENT_MODE_COUNT] = { 0 };
+
+	shVkResultError(
+		vkGetPhysicalDeviceSurfacePresentModesKHR(physical_device, surface, &present_mode_count, VK_NULL_HANDLE),
+		"error getting surface present modes",
+		return 0
+	);
+	shVkError(
+		present_mode_count > SH_MAX_STACK_SURFACE_PRESENT_MODE_COUNT,
+		"reached max stack surface present mode count",
+		return 0
+	);
+	shVkResultError(
+		vkGetPhysicalDeviceSurfacePresentModesKHR(physical_device, surface, &present_mode_count, present_modes),
+		"error getting surface present modes",
+		return 0
+	);
+
+	VkPresentModeKHR preferred_modes[2]   = { VK_PRESENT_MODE_FIFO_KHR, VK_PRESENT_MODE_FIFO_KHR };
+	uint32_t         preferred_mode_count = 0;
+
+	switch (present_policy) {
+	case SH_PRESENT_POLICY_LOW_LATENCY:
+		preferred_modes[0]   = VK_PRESENT_MODE_MAILBOX_KHR;
+		preferred_modes[1]   = VK_PRESENT_MODE_IMMEDIATE_KHR;
+		preferred_mode_count = 2;
+		break;
+	case SH_PRESENT_POLICY_TEAR_FREE_UNCAPPED:
+		preferred_modes[0]   = VK_PRESENT_MODE_MAILBOX_KHR;
+		preferred_mode_count = 1;
+		break;
+	default:
+		break;
+	}
+
+	VkPresentModeKHR present_mode = VK_PRESENT_MODE_FIFO_KHR;
+
+	for (uint32_t preferred_idx = 0; preferred_idx < preferred_mode_count; preferred_idx++) {
+		uint8_t found = 0;
+		for (uint32_t present_mode_idx = 0; present_mode_idx < present_mode_count; present_mode_idx++) {
+			if (present_modes[present_mode_idx] == preferred_modes[preferred_idx]) {
+				found = 1;
+				break;
+			}
+		}
+		if (found) {
+			present_mode = preferred_modes[preferred_idx];
+			break;
+		}
+	}
+
+	(*p_present_mode) = present_mode;
+
+	return 1;
+}
+
+uint8_t shCreateSwapchain(
+	VkDevice                 device, 
+	VkPhysicalDevice         physical_device,
+	VkSurfaceKHR             surface,
+	VkFormat                 image_format,
+	VkFormat*                p_image_format,
+	uint32_t                 swapchain_image_count,
+	VkSharingMode            image_sharing_mode,
+	ShVkPresentPolicy        present_policy,
+	VkSwapchainKHR           old_swapchain,
+	uint32_t*                p_swapchain_image_count,
+	VkSwapchainKHR*          p_swapchain
+) {
+	shVkArgError(device                  == VK_NULL_HANDLE, "invalid device memory",                return 0);
+	shVkArgError(p_swapchain_image_count == NULL,           "invalid swapchain image count memory", return 0);
+
+	uint32_t                 _swapchain_image_count                                    =   0  ;
+	uint32_t                 format_count                                              =   0  ;
+	VkSurfaceFormatKHR       surface_formats[SH_MAX_STACK_DEVICE_SURFACE_FORMAT_COUNT] = { 0 };
 	uint8_t                  format_found                                              =   0  ;
 	VkSurfaceFormatKHR       surface_format                                            = { 0 };
 
@@ -994,10 +2125,31 @@ uint8_t shCreateSwapchain(
 		return 0
 	);
 
+	VkPresentModeKHR present_mode = VK_PRESENT_MODE_FIFO_KHR;
+	shVkError(
+		shSelectPresentMode(physical_device, surface, present_policy, &present_mode) == 0,
+		"failed selecting present mode",
+		return 0
+	);
+
 	_swapchain_image_count = swapchain_image_count;
+	if (_swapchain_image_count == 0) {
+		//mailbox needs a spare image to render into while one is queued and one is displayed
+		_swapchain_image_count = present_mode == VK_PRESENT_MODE_MAILBOX_KHR ?
+			surface_capabilities.minImageCount + 1 : surface_capabilities.minImageCount;
+		if (present_mode == VK_PRESENT_MODE_MAILBOX_KHR && _swapchain_image_count < 3) {
+			_swapchain_image_count = 3;
+		}
+		if (_swapchain_image_count < 2) {
+			_swapchain_image_count = 2;
+		}
+	}
 	if (_swapchain_image_count < surface_capabilities.minImageCount) {
 		_swapchain_image_count = surface_capabilities.minImageCount;
 	}
+	if (surface_capabilities.maxImageCount != 0 && _swapchain_image_count > surface_capabilities.maxImageCount) {
+		_swapchain_image_count = surface_capabilities.maxImageCount;
+	}
 	(*p_swapchain_image_count) = _swapchain_image_count;
 
 	VkCompositeAlphaFlagBitsKHR composite_alpha_flags[4] = {
@@ -1017,37 +2169,6 @@ uint8_t shCreateSwapchain(
 		(*p_image_format) = surface_format.format;
 	}
 
-	uint32_t         present_mode_count                                     = 0;
-	VkPresentModeKHR present_modes[SH_MAX_STACK_SURFACE_PRESENT_MODE_COUNT] = { 0 };
-	VkPresentModeKHR present_mode                                           = VK_PRESENT_MODE_MAX_ENUM_KHR;
-	shVkError(
-		vkGetPhysicalDeviceSurfacePresentModesKHR(physical_device, surface, &present_mode_count, VK_NULL_HANDLE),
-		"present mode count exceeds max stack count",
-		return 0
-	);
-	shVkError(
-		present_mode_count > SH_MAX_STACK_SURFACE_PRESENT_MODE_COUNT,
-		"reached max stack surface present mode count",
-		return 0
-	);
-	shVkError(
-		vkGetPhysicalDeviceSurfacePresentModesKHR(physical_device, surface, &present_mode_count, present_modes),
-		"present mode count exceeds max stack count",
-		return 0
-	);
-	if (!vsync) {
-		for (uint32_t present_mode_idx = 0; present_mode_idx < present_mode_count; present_mode_idx++) {
-			if (present_modes[present_mode_idx] == VK_PRESENT_MODE_IMMEDIATE_KHR) {
-				present_mode = VK_PRESENT_MODE_IMMEDIATE_KHR;
-				break;
-			}
-		}
-	}
-	if (present_mode == VK_PRESENT_MODE_MAX_ENUM_KHR) {
-		present_mode = VK_PRESENT_MODE_FIFO_KHR;
-	}
-	
-
 	VkSwapchainCreateInfoKHR swapchain_create_info = {
 
 		.sType           = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR, //sType;
@@ -1072,7 +2193,7 @@ uint8_t shCreateSwapchain(
 		.compositeAlpha        = composite_alpha,                        //compositeAlpha;
 		.presentMode           = present_mode,                           //presentMode;
 		.clipped               = 1,                                      //clipped;
-		.oldSwapchain          = 0,                                      //oldSwapchain;
+		.oldSwapchain          = old_swapchain,                          //oldSwapchain;
 	};
 
 	shVkResultError(
@@ -1091,8 +2212,8 @@ uint8_t shCombineMaxSamples(
 	uint8_t                    combine_depth_sample, 
 	uint32_t*                  p_sample_count
 ) {
-	shVkError(p_sample_count == VK_NULL_HANDLE, "invalid sample count memory",        return 0);
-	shVkError(sample_count   == 0, "invalid starting sample count value 0", return 0);
+	shVkArgError(p_sample_count == VK_NULL_HANDLE, "invalid sample count memory",        return 0);
+	shVkArgError(sample_count   == 0, "invalid starting sample count value 0", return 0);
 
 	//fill bits, example: decimal 8 = 0b1000 ---> 0b1111 = 15
 	VkSampleCountFlags _sample_count = 0;
@@ -1128,10 +2249,10 @@ uint8_t shGetSwapchainImages(
 	uint32_t*      p_swapchain_image_count,
 	VkImage*       p_swapchain_images
 ) {
-	shVkError(swapchain               == VK_NULL_HANDLE, "invalid swapchain memory",   return 0);
-	shVkError(device                  == VK_NULL_HANDLE, "invalid device memory",      return 0);
-	shVkError(p_swapchain_image_count == VK_NULL_HANDLE, "invalid image count memory", return 0);
-	shVkError(p_swapchain_images      == VK_NULL_HANDLE, "invalid images memory",      return 0);
+	shVkArgError(swapchain               == VK_NULL_HANDLE, "invalid swapchain memory",   return 0);
+	shVkArgError(device                  == VK_NULL_HANDLE, "invalid device memory",      return 0);
+	shVkArgError(p_swapchain_image_count == VK_NULL_HANDLE, "invalid image count memory", return 0);
+	shVkArgError(p_swapchain_images      == VK_NULL_HANDLE, "invalid images memory",      return 0);
 
 	shVkResultError(
 		vkGetSwapchainImagesKHR(device, swapchain, p_swapchain_image_count, VK_NULL_HANDLE),
@@ -1156,17 +2277,44 @@ uint8_t shCreateImageView(
 	VkFormat              format, 
 	VkImageView*          p_image_view
 ) {
-	shVkError(device       == VK_NULL_HANDLE, "invalid device memory",     return 0);
-	shVkError(image        == VK_NULL_HANDLE, "invalid image memory",      return 0);
-	shVkError(mip_levels   == 0,    "invalid mip levels value",  return 0);
-	shVkError(p_image_view == VK_NULL_HANDLE, "invalid image view memory", return 0);
+	return shCreateLayeredImageView(
+		device, image, view_type, image_aspect,
+		0, mip_levels,
+		0, 1,
+		format, p_image_view
+	);
+}
+
+uint8_t shCreateLayeredImageView(
+	VkDevice              device,
+	VkImage               image,
+	VkImageViewType       view_type,
+	VkImageAspectFlags    image_aspect,
+	uint32_t              base_mip_level,
+	uint32_t              mip_levels,
+	uint32_t              base_array_layer,
+	uint32_t              layer_count,
+	VkFormat              format,
+	VkImageView*          p_image_view
+) {
+	shVkArgError(device       == VK_NULL_HANDLE, "invalid device memory",     return 0);
+	shVkArgError(image        == VK_NULL_HANDLE, "invalid image memory",      return 0);
+	shVkArgError(mip_levels   == 0,              "invalid mip levels value",  return 0);
+	shVkArgError(layer_count  == 0,              "invalid layer count",       return 0);
+	shVkArgError(p_image_view == VK_NULL_HANDLE, "invalid image view memory", return 0);
+	shVkArgError(
+		(view_type == VK_IMAGE_VIEW_TYPE_CUBE && layer_count != 6) ||
+		(view_type == VK_IMAGE_VIEW_TYPE_CUBE_ARRAY && layer_count != VK_REMAINING_ARRAY_LAYERS && layer_count % 6 != 0),
+		"invalid cube view layer count",
+		return 0
+	);
 
 	VkImageSubresourceRange subresource_range = {
-		.aspectMask     = image_aspect, //aspectMask
-		.baseMipLevel   = 0,            //baseMipLevel;
-		.levelCount     = mip_levels,   //levelCount;
-		.baseArrayLayer = 0,            //baseArrayLayer;
-		.layerCount     = 1             //layerCount;
+		.aspectMask     = image_aspect,     //aspectMask
+		.baseMipLevel   = base_mip_level,   //baseMipLevel;
+		.levelCount     = mip_levels,       //levelCount;
+		.baseArrayLayer = base_array_layer, //baseArrayLayer;
+		.layerCount     = layer_count       //layerCount;
 	};
 	
 	VkImageViewCreateInfo image_view_create_info = {
@@ -1196,10 +2344,10 @@ uint8_t shCreateSwapchainImageViews(
 	VkImage*     p_swapchain_images,
 	VkImageView* p_swapchain_image_views
 ) {
-	shVkError(device                  == VK_NULL_HANDLE, "invalid device memory",           return 0);
-	shVkError(swapchain_image_count   == 0,    "invalid swapchain image count",   return 0);
-	shVkError(p_swapchain_images      == VK_NULL_HANDLE, "invalid swapchain images memory", return 0);
-	shVkError(p_swapchain_image_views == VK_NULL_HANDLE, "invalid swapchain image views",   return 0);
+	shVkArgError(device                  == VK_NULL_HANDLE, "invalid device memory",           return 0);
+	shVkArgError(swapchain_image_count   == 0,    "invalid swapchain image count",   return 0);
+	shVkArgError(p_swapchain_images      == VK_NULL_HANDLE, "invalid swapchain images memory", return 0);
+	shVkArgError(p_swapchain_image_views == VK_NULL_HANDLE, "invalid swapchain image views",   return 0);
 
 	for (uint32_t image_idx = 0; image_idx < swapchain_image_count; image_idx++) {
 		shCreateImageView(
@@ -1221,8 +2369,8 @@ uint8_t shCreateCommandPool(
 	uint32_t       queue_family_index,
 	VkCommandPool* p_cmd_pool
 ) {
-	shVkError(device     == VK_NULL_HANDLE, "invalid device memory",       return 0);
-	shVkError(p_cmd_pool == VK_NULL_HANDLE, "invalid command pool memory", return 0);
+	shVkArgError(device     == VK_NULL_HANDLE, "invalid device memory",       return 0);
+	shVkArgError(p_cmd_pool == VK_NULL_HANDLE, "invalid command pool memory", return 0);
 
 	VkCommandPoolCreateInfo cmd_pool_create_info = {
 		VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,			//sType;
@@ -1245,9 +2393,9 @@ uint8_t shAllocateCommandBuffers(
 	uint32_t         cmd_buffer_count,
 	VkCommandBuffer* p_cmd_buffer
 ) {
-	shVkError(device       == VK_NULL_HANDLE, "invalid device memory",         return 0);
-	shVkError(cmd_pool     == VK_NULL_HANDLE, "invalid command pool memory",   return 0);
-	shVkError(p_cmd_buffer == VK_NULL_HANDLE, "invalid command buffer memory", return 0);
+	shVkArgError(device       == VK_NULL_HANDLE, "invalid device memory",         return 0);
+	shVkArgError(cmd_pool     == VK_NULL_HANDLE, "invalid command pool memory",   return 0);
+	shVkArgError(p_cmd_buffer == VK_NULL_HANDLE, "invalid command buffer memory", return 0);
 	
 	VkCommandBufferAllocateInfo cmd_buffer_allocate_info = {
 		.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO, //sType;
@@ -1277,7 +2425,7 @@ uint8_t shCreateRenderpassAttachment(
 	VkImageLayout            final_layout,
 	VkAttachmentDescription* p_attachment_description
 ) {
-	shVkError(p_attachment_description == VK_NULL_HANDLE, "invalid attachment description memory", return 0);
+	shVkArgError(p_attachment_description == VK_NULL_HANDLE, "invalid attachment description memory", return 0);
 	
 	VkAttachmentDescription attachment_description = {
 		.flags          = 0,                       //flags;
@@ -1301,7 +2449,7 @@ uint8_t shCreateRenderpassAttachmentReference(
 	VkImageLayout          layout,
 	VkAttachmentReference* p_attachment_reference
 ) {
-	shVkError(p_attachment_reference == VK_NULL_HANDLE, "invalid attachment reference memory", return 0);
+	shVkArgError(p_attachment_reference == VK_NULL_HANDLE, "invalid attachment reference memory", return 0);
 
 	VkAttachmentReference attachment_reference = {
 		.attachment = attachment_idx, //attachment;
@@ -1325,19 +2473,19 @@ uint8_t shCreateSubpass(
 	uint32_t*              p_preserve_attachments,
 	VkSubpassDescription*  p_subpass
 ) {
-	shVkError(p_subpass == VK_NULL_HANDLE, "invalid subpass memory", return 0);
+	shVkArgError(p_subpass == VK_NULL_HANDLE, "invalid subpass memory", return 0);
 
-	shVkError(
+	shVkArgError(
 		input_attachment_count != 0 && p_input_attachments_reference == VK_NULL_HANDLE,
 		"invalid input attachment memory",
 		return 0
 	);
-	shVkError(
+	shVkArgError(
 		color_attachment_count != 0 && p_color_attachments_reference == VK_NULL_HANDLE,
 		"invalid color attachment memory",
 		return 0
 	);
-	shVkError(
+	shVkArgError(
 		preserve_attachment_count != 0 && p_preserve_attachments == VK_NULL_HANDLE,
 		"invalid color attachment memory",
 		return 0
@@ -1371,12 +2519,12 @@ uint8_t shCreateRenderpass(
 	VkSubpassDescription*    p_subpasses,
 	VkRenderPass*            p_renderpass
 ) {
-	shVkError(device                     == VK_NULL_HANDLE,  "invalid device memory",                   return 0);
-	shVkError(attachment_count           == 0,               "invalid attachment count",                return 0);
-	shVkError(p_attachments_descriptions == VK_NULL_HANDLE,  "invalid attachments descriptions memory", return 0);
-	shVkError(subpass_count              == 0,               "invalid subpass count",                   return 0);
-	shVkError(p_subpasses                == VK_NULL_HANDLE,  "invalid subpasses memory",                return 0);
-	shVkError(p_renderpass               == VK_NULL_HANDLE,  "invalid renderpass memory",               return 0);
+	shVkArgError(device                     == VK_NULL_HANDLE,  "invalid device memory",                   return 0);
+	shVkArgError(attachment_count           == 0,               "invalid attachment count",                return 0);
+	shVkArgError(p_attachments_descriptions == VK_NULL_HANDLE,  "invalid attachments descriptions memory", return 0);
+	shVkArgError(subpass_count              == 0,               "invalid subpass count",                   return 0);
+	shVkArgError(p_subpasses                == VK_NULL_HANDLE,  "invalid subpasses memory",                return 0);
+	shVkArgError(p_renderpass               == VK_NULL_HANDLE,  "invalid renderpass memory",               return 0);
 
 	VkRenderPassCreateInfo renderpass_create_info = {
 		.sType           = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO, //sType;
@@ -1409,12 +2557,12 @@ uint8_t shCreateFramebuffer(
 	uint32_t       z,
 	VkFramebuffer* p_framebuffer
 ) {
-	shVkError(device           == VK_NULL_HANDLE, "invalid device memory",      return 0);
-	shVkError(renderpass       == VK_NULL_HANDLE, "invalid renderpass memory",  return 0);
-	shVkError(x                == 0,    "invalid framebuffer x size", return 0);
-	shVkError(y                == 0,    "invalid framebuffer y size", return 0);
-	shVkError(z                == 0,    "invalid framebuffer z size", return 0);
-	shVkError(p_framebuffer    == VK_NULL_HANDLE, "invalid framebuffer memory", return 0);
+	shVkArgError(device           == VK_NULL_HANDLE, "invalid device memory",      return 0);
+	shVkArgError(renderpass       == VK_NULL_HANDLE, "invalid renderpass memory",  return 0);
+	shVkArgError(x                == 0,    "invalid framebuffer x size", return 0);
+	shVkArgError(y                == 0,    "invalid framebuffer y size", return 0);
+	shVkArgError(z                == 0,    "invalid framebuffer z size", return 0);
+	shVkArgError(p_framebuffer    == VK_NULL_HANDLE, "invalid framebuffer memory", return 0);
 
 	VkFramebufferCreateFlags flags = 0;
 
@@ -1451,7 +2599,7 @@ uint8_t shCreateFramebuffer(
 uint8_t shWaitDeviceIdle(
 	VkDevice device
 ) {
-	shVkError(device == VK_NULL_HANDLE, "invalid device memory", return 0);
+	shVkArgError(device == VK_NULL_HANDLE, "invalid device memory", return 0);
 
 	shVkResultError(
 		vkDeviceWaitIdle(device),
@@ -1466,8 +2614,8 @@ uint8_t shDestroySwapchain(
 	VkDevice       device, 
 	VkSwapchainKHR swapchain
 ) {
-	shVkError(device    == VK_NULL_HANDLE, "invalid device memory",    return 0);
-	shVkError(swapchain == VK_NULL_HANDLE, "invalid swapchain memory", return 0);
+	shVkArgError(device    == VK_NULL_HANDLE, "invalid device memory",    return 0);
+	shVkArgError(swapchain == VK_NULL_HANDLE, "invalid swapchain memory", return 0);
 	
 	shVkError(
 		shWaitDeviceIdle(device) == 0, 
@@ -1485,9 +2633,9 @@ uint8_t shDestroyFramebuffers(
 	uint32_t       framebuffer_count, 
 	VkFramebuffer* p_framebuffers
 ) {
-	shVkError(device            == VK_NULL_HANDLE, "invalid device memory",       return 0);
-	shVkError(framebuffer_count == 0,    "invalid framebuffer count",   return 0);
-	shVkError(p_framebuffers    == VK_NULL_HANDLE, "invalid framebuffers memory", return 0);
+	shVkArgError(device            == VK_NULL_HANDLE, "invalid device memory",       return 0);
+	shVkArgError(framebuffer_count == 0,    "invalid framebuffer count",   return 0);
+	shVkArgError(p_framebuffers    == VK_NULL_HANDLE, "invalid framebuffers memory", return 0);
 
 	shVkError(
 		shWaitDeviceIdle(device) == 0,
@@ -1507,9 +2655,9 @@ uint8_t shDestroyImageViews(
 	uint32_t     image_view_count,
 	VkImageView* p_image_views
 ) {
-	shVkError(device           == VK_NULL_HANDLE, "invalid device memory",      return 0);
-	shVkError(image_view_count == 0,    "invalid image view count",   return 0);
-	shVkError(p_image_views    == VK_NULL_HANDLE, "invalid image views memory", return 0);
+	shVkArgError(device           == VK_NULL_HANDLE, "invalid device memory",      return 0);
+	shVkArgError(image_view_count == 0,    "invalid image view count",   return 0);
+	shVkArgError(p_image_views    == VK_NULL_HANDLE, "invalid image views memory", return 0);
 
 	shVkError(
 		shWaitDeviceIdle(device) == 0,
@@ -1528,8 +2676,8 @@ uint8_t shDestroySurface(
 	VkInstance instance,
 	VkSurfaceKHR surface
 ) {
-	shVkError(instance == VK_NULL_HANDLE, "invalid instance memory",  return 0);
-	shVkError(surface  == VK_NULL_HANDLE, "invalid surface memory",   return 0);
+	shVkArgError(instance == VK_NULL_HANDLE, "invalid instance memory",  return 0);
+	shVkArgError(surface  == VK_NULL_HANDLE, "invalid surface memory",   return 0);
 	
 	vkDestroySurfaceKHR(instance, surface, VK_NULL_HANDLE);
 	
@@ -1542,9 +2690,9 @@ uint8_t shDestroyCommandBuffers(
 	uint32_t         cmd_buffer_count,
 	VkCommandBuffer* p_cmd_buffers
 ) {
-	shVkError(device           == VK_NULL_HANDLE, "invalid device memory",          return 0);
-	shVkError(cmd_buffer_count == 0,    "invalid command buffer count",   return 0);
-	shVkError(p_cmd_buffers    == VK_NULL_HANDLE, "invalid command buffers memory", return 0);
+	shVkArgError(device           == VK_NULL_HANDLE, "invalid device memory",          return 0);
+	shVkArgError(cmd_buffer_count == 0,    "invalid command buffer count",   return 0);
+	shVkArgError(p_cmd_buffers    == VK_NULL_HANDLE, "invalid command buffers memory", return 0);
 	
 	shVkError(
 		shWaitDeviceIdle(device) == 0,
@@ -1561,8 +2709,8 @@ uint8_t shDestroyCommandPool(
 	VkDevice      device,
 	VkCommandPool cmd_pool
 ) {
-	shVkError(device   == VK_NULL_HANDLE, "invalid device memory",       return 0);
-	shVkError(cmd_pool == VK_NULL_HANDLE, "invalid command pool memory", return 0);
+	shVkArgError(device   == VK_NULL_HANDLE, "invalid device memory",       return 0);
+	shVkArgError(cmd_pool == VK_NULL_HANDLE, "invalid command pool memory", return 0);
 
 	shVkError(
 		shWaitDeviceIdle(device) == 0,
@@ -1579,8 +2727,8 @@ uint8_t shDestroyRenderpass(
 	VkDevice device, 
 	VkRenderPass render_pass
 ) {
-	shVkError(device      == VK_NULL_HANDLE, "invalid device memory",      return 0);
-	shVkError(render_pass == VK_NULL_HANDLE, "invalid render pass memory", return 0);
+	shVkArgError(device      == VK_NULL_HANDLE, "invalid device memory",      return 0);
+	shVkArgError(render_pass == VK_NULL_HANDLE, "invalid render pass memory", return 0);
 	
 	shVkError(
 		shWaitDeviceIdle(device) == 0,
@@ -1596,7 +2744,7 @@ uint8_t shDestroyRenderpass(
 uint8_t shDestroyDevice(
 	VkDevice device
 ) {
-	shVkError(device == VK_NULL_HANDLE, "invalid device memory", return 0);
+	shVkArgError(device == VK_NULL_HANDLE, "invalid device memory", return 0);
 	
 	shVkError(
 		shWaitDeviceIdle(device) == 0,
@@ -1604,6 +2752,9 @@ uint8_t shDestroyDevice(
 		return 0
 	);
 
+	shUnloadDeviceDispatchTable(device);
+	shUnregisterDevice(device);
+
 	vkDestroyDevice(device, VK_NULL_HANDLE);
 
 	return 1;
@@ -1612,7 +2763,7 @@ uint8_t shDestroyDevice(
 uint8_t shDestroyInstance(
 	VkInstance instance
 ) {
-	shVkError(instance == VK_NULL_HANDLE, "invalid instance memory", return 0);
+	shVkArgError(instance == VK_NULL_HANDLE, "invalid instance memory", return 0);
 
 	vkDestroyInstance(instance, VK_NULL_HANDLE);
 
@@ -1622,7 +2773,7 @@ uint8_t shDestroyInstance(
 uint8_t shResetCommandBuffer(
 	VkCommandBuffer cmd_buffer
 ) {
-	shVkError(cmd_buffer == VK_NULL_HANDLE, "invalid command buffer memory", return 0);
+	shVkArgError(cmd_buffer == VK_NULL_HANDLE, "invalid command buffer memory", return 0);
 
 	shVkResultError(
 		vkResetCommandBuffer(cmd_buffer, 0),
@@ -1636,7 +2787,7 @@ uint8_t shResetCommandBuffer(
 uint8_t shBeginCommandBuffer(
 	VkCommandBuffer cmd_buffer
 ) {
-	shVkError(cmd_buffer == VK_NULL_HANDLE, "invalid command buffer", return 0);
+	shVkArgError(cmd_buffer == VK_NULL_HANDLE, "invalid command buffer", return 0);
 
 	VkCommandBufferBeginInfo command_buffer_begin_info = {
 		.sType            = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
@@ -1651,13 +2802,26 @@ uint8_t shBeginCommandBuffer(
 		return 0
 	);
 
+#ifdef SH_VULKAN_DEVICE_DISPATCH
+	//resolved once, the commands recorded until shEndCommandBuffer skip the lookup
+	sh_vk_recording_dispatch.p_dispatch_table = shGetDeviceDispatchTable(cmd_buffer);
+	sh_vk_recording_dispatch.cmd_buffer       = cmd_buffer;
+#endif//SH_VULKAN_DEVICE_DISPATCH
+
 	return 1;
 }
 
 uint8_t shEndCommandBuffer(
 	VkCommandBuffer cmd_buffer
 ) {
-	shVkError(cmd_buffer == VK_NULL_HANDLE, "invalid command buffer memory", return 0);
+	shVkArgError(cmd_buffer == VK_NULL_HANDLE, "invalid command buffer memory", return 0);
+
+#ifdef SH_VULKAN_DEVICE_DISPATCH
+	if (sh_vk_recording_dispatch.cmd_buffer == cmd_buffer) {
+		sh_vk_recording_dispatch.cmd_buffer       = VK_NULL_HANDLE;
+		sh_vk_recording_dispatch.p_dispatch_table = &sh_vk_loader_dispatch_table;
+	}
+#endif//SH_VULKAN_DEVICE_DISPATCH
 
 	shVkResultError(
 		vkEndCommandBuffer(cmd_buffer),
@@ -1668,22 +2832,6 @@ uint8_t shEndCommandBuffer(
 	return 1;
 }
 
-uint8_t shCmdDispatch(
-	VkCommandBuffer cmd_buffer,
-	uint32_t        group_count_x,
-	uint32_t        group_count_y,
-	uint32_t        group_count_z
-) {
-	shVkError(cmd_buffer    == VK_NULL_HANDLE, "invalid command buffer memory", return 0);
-	shVkError(group_count_x == 0,    "invalid x group count",         return 0);
-	shVkError(group_count_y == 0,    "invalid y group count",         return 0);
-	shVkError(group_count_z == 0,    "invalid z group count",         return 0);
-
-	vkCmdDispatch(cmd_buffer, group_count_x, group_count_y, group_count_z);
-
-	return 1;
-}
-
 uint8_t shQueueSubmit(
 	uint32_t             cmd_buffer_count,
 	VkCommandBuffer*     p_cmd_buffers,
@@ -1695,8 +2843,8 @@ uint8_t shQueueSubmit(
 	uint32_t             signal_semaphore_count,
 	VkSemaphore*         p_signal_semaphores
 ) {
-	shVkError(p_cmd_buffers == VK_NULL_HANDLE,	"invalid command buffers memory",	return 0);
-	shVkError(queue == VK_NULL_HANDLE,			"invalid queue",					return 0);
+	shVkArgError(p_cmd_buffers == VK_NULL_HANDLE,	"invalid command buffers memory",	return 0);
+	shVkArgError(queue == VK_NULL_HANDLE,			"invalid queue",					return 0);
 
 	VkSubmitInfo submit_info = {
 		.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO, //sType;
@@ -1722,7 +2870,7 @@ uint8_t shQueueSubmit(
 uint8_t shWaitForQueue(
 	VkQueue queue
 ) {
-	shVkError(queue == VK_NULL_HANDLE, "invalid queue memory", return 0);
+	shVkArgError(queue == VK_NULL_HANDLE, "invalid queue memory", return 0);
 
 	vkQueueWaitIdle(queue);
 
@@ -1736,9 +2884,9 @@ uint8_t shCreateFences(
 	uint8_t   signaled,
 	VkFence*  p_fences
 ) {
-	shVkError(device      == VK_NULL_HANDLE, "invalid device memory", return 0);
-	shVkError(fence_count == 0,    "invalid fence count",   return 0);
-	shVkError(p_fences    == VK_NULL_HANDLE, "invalid fences memory", return 0);
+	shVkArgError(device      == VK_NULL_HANDLE, "invalid device memory", return 0);
+	shVkArgError(fence_count == 0,    "invalid fence count",   return 0);
+	shVkArgError(p_fences    == VK_NULL_HANDLE, "invalid fences memory", return 0);
 
 	VkFenceCreateFlags flags = signaled ? VK_FENCE_CREATE_SIGNALED_BIT : 0;
 
@@ -1763,9 +2911,9 @@ uint8_t shCreateSemaphores(
 	uint32_t     semaphore_count,
 	VkSemaphore* p_semaphores
 ) {
-	shVkError(device          == VK_NULL_HANDLE, "invalid device memory",     return 0);
-	shVkError(semaphore_count == 0,              "invalid semaphore count",   return 0);
-	shVkError(p_semaphores    == VK_NULL_HANDLE, "invalid semaphores memory", return 0);
+	shVkArgError(device          == VK_NULL_HANDLE, "invalid device memory",     return 0);
+	shVkArgError(semaphore_count == 0,              "invalid semaphore count",   return 0);
+	shVkArgError(p_semaphores    == VK_NULL_HANDLE, "invalid semaphores memory", return 0);
 
 	VkSemaphoreCreateInfo semaphore_create_info = {
 		.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO, //sType;
@@ -1783,14 +2931,69 @@ uint8_t shCreateSemaphores(
 	return 1;
 }
 
+uint8_t shCreateTimelineSemaphore(
+	VkDevice     device,
+	uint64_t     initial_value,
+	VkSemaphore* p_semaphore
+) {
+	shVkArgError(device      == VK_NULL_HANDLE, "invalid device memory",    return 0);
+	shVkArgError(p_semaphore == VK_NULL_HANDLE, "invalid semaphore memory", return 0);
+
+	VkSemaphoreTypeCreateInfo semaphore_type_create_info = {
+		.sType         = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO, //sType;
+		.pNext         = VK_NULL_HANDLE,                               //pNext;
+		.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE,                   //semaphoreType;
+		.initialValue  = initial_value                                 //initialValue;
+	};
+
+	VkSemaphoreCreateInfo semaphore_create_info = {
+		.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO, //sType;
+		.pNext = &semaphore_type_create_info,             //pNext;
+		.flags = 0                                        //flags;
+	};
+
+	shVkResultError(
+		vkCreateSemaphore(device, &semaphore_create_info, VK_NULL_HANDLE, p_semaphore),
+		"error creating timeline semaphore", return 0
+	);
+
+	return 1;
+}
+
+uint8_t shWaitTimelineSemaphore(
+	VkDevice    device,
+	VkSemaphore semaphore,
+	uint64_t    value,
+	uint64_t    timeout_ns
+) {
+	shVkArgError(device    == VK_NULL_HANDLE, "invalid device memory",    return 0);
+	shVkArgError(semaphore == VK_NULL_HANDLE, "invalid semaphore memory", return 0);
+
+	VkSemaphoreWaitInfo semaphore_wait_info = {
+		.sType          = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO, //sType;
+		.pNext          = VK_NULL_HANDLE,                        //pNext;
+		.flags          = 0,                                     //flags;
+		.semaphoreCount = 1,                                     //semaphoreCount;
+		.pSemaphores    = &semaphore,                            //pSemaphores;
+		.pValues        = &value                                 //pValues;
+	};
+
+	shVkResultError(
+		vkWaitSemaphores(device, &semaphore_wait_info, timeout_ns),
+		"failed waiting for timeline semaphore", return 0
+	);
+
+	return 1;
+}
+
 uint8_t shDestroyFences(
 	VkDevice  device,
 	uint32_t  fence_count,
 	VkFence*  p_fences
 ) {
-	shVkError(device      == VK_NULL_HANDLE, "invalid device memory", return 0);
-	shVkError(fence_count == 0,    "invalid fence count",   return 0);
-	shVkError(p_fences    == VK_NULL_HANDLE, "invalid fences memory", return 0);
+	shVkArgError(device      == VK_NULL_HANDLE, "invalid device memory", return 0);
+	shVkArgError(fence_count == 0,    "invalid fence count",   return 0);
+	shVkArgError(p_fences    == VK_NULL_HANDLE, "invalid fences memory", return 0);
 
 	shVkError(
 		shWaitDeviceIdle(device) == 0,
@@ -1810,9 +3013,9 @@ uint8_t shDestroySemaphores(
 	uint32_t      semaphore_count,
 	VkSemaphore*  p_semaphores
 ) {
-	shVkError(device          == VK_NULL_HANDLE, "invalid device memory",     return 0);
-	shVkError(semaphore_count == 0,    "invalid semaphore count",   return 0);
-	shVkError(p_semaphores    == VK_NULL_HANDLE, "invalid semaphores memory", return 0);
+	shVkArgError(device          == VK_NULL_HANDLE, "invalid device memory",     return 0);
+	shVkArgError(semaphore_count == 0,    "invalid semaphore count",   return 0);
+	shVkArgError(p_semaphores    == VK_NULL_HANDLE, "invalid semaphores memory", return 0);
 
 	shVkError(
 		shWaitDeviceIdle(device) == 0,
@@ -1832,9 +3035,9 @@ uint8_t shResetFences(
 	uint32_t fence_count,
 	VkFence* p_fences
 ) {
-	shVkError(device      == VK_NULL_HANDLE, "invalid command buffer memory", return 0);
-	shVkError(fence_count == 0,    "invalid fence count",           return 0);
-	shVkError(p_fences    == VK_NULL_HANDLE, "invalid fences memory",         return 0);
+	shVkArgError(device      == VK_NULL_HANDLE, "invalid command buffer memory", return 0);
+	shVkArgError(fence_count == 0,    "invalid fence count",           return 0);
+	shVkArgError(p_fences    == VK_NULL_HANDLE, "invalid fences memory",         return 0);
 
 	shVkResultError(
 		vkResetFences(device, fence_count, p_fences),
@@ -1850,9 +3053,9 @@ uint8_t shResetSemaphores(
 	uint32_t     semaphore_count,
 	VkSemaphore* p_semaphores
 ) {
-	shVkError(device          == VK_NULL_HANDLE, "invalid command buffer memory", return 0);
-	shVkError(semaphore_count == 0,              "invalid semaphore count",       return 0);
-	shVkError(p_semaphores    == VK_NULL_HANDLE, "invalid semaphores memory",     return 0);
+	shVkArgError(device          == VK_NULL_HANDLE, "invalid command buffer memory", return 0);
+	shVkArgError(semaphore_count == 0,              "invalid semaphore count",       return 0);
+	shVkArgError(p_semaphores    == VK_NULL_HANDLE, "invalid semaphores memory",     return 0);
 
 	uint8_t r = 1;
 	r = r && shDestroySemaphores(device, semaphore_count, p_semaphores);
@@ -1874,9 +3077,9 @@ uint8_t shWaitForFences(
 	uint8_t  wait_for_all,
 	uint64_t timeout_ns
 ) {
-	shVkError(device      == VK_NULL_HANDLE, "invalid command buffer memory", return 0);
-	shVkError(fence_count == 0,              "invalid fence count",           return 0);
-	shVkError(p_fences    == VK_NULL_HANDLE, "invalid fences memory",         return 0);
+	shVkArgError(device      == VK_NULL_HANDLE, "invalid command buffer memory", return 0);
+	shVkArgError(fence_count == 0,              "invalid fence count",           return 0);
+	shVkArgError(p_fences    == VK_NULL_HANDLE, "invalid fences memory",         return 0);
 
 	shVkResultError(
 		vkWaitForFences(device, fence_count, p_fences, (VkBool32)wait_for_all, timeout_ns),
@@ -1895,10 +3098,10 @@ uint8_t shWaitForSemaphores(
 	uint64_t     timeout_ns,
 	uint64_t*    p_semaphores_values
 ) {
-	shVkError(device              == VK_NULL_HANDLE, "invalid command buffer memory",    return 0);
-	shVkError(semaphore_count     == 0,              "invalid semaphore count",          return 0);
-	shVkError(p_semaphores        == VK_NULL_HANDLE, "invalid semaphores memory",        return 0);
-	shVkError(p_semaphores_values == VK_NULL_HANDLE, "invalid semaphores values memory", return 0);
+	shVkArgError(device              == VK_NULL_HANDLE, "invalid command buffer memory",    return 0);
+	shVkArgError(semaphore_count     == 0,              "invalid semaphore count",          return 0);
+	shVkArgError(p_semaphores        == VK_NULL_HANDLE, "invalid semaphores memory",        return 0);
+	shVkArgError(p_semaphores_values == VK_NULL_HANDLE, "invalid semaphores values memory", return 0);
 
 	VkSemaphoreWaitInfo semaphore_wait_info = {
 		.sType          = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO,
@@ -1927,11 +3130,11 @@ uint8_t shAcquireSwapchainImage(
 	uint32_t*      p_swapchain_image_index,
 	uint8_t*       p_swapchain_suboptimal
 ) {
-	shVkError(device                  == VK_NULL_HANDLE, "invalid command buffer memory",        return 0);
-	shVkError(p_swapchain_image_index == NULL,           "invalid swapchain image index memory", return 0);
-	shVkError(p_swapchain_suboptimal  == NULL,           "invalid swapchain suboptimal memory",  return 0);
+	shVkArgError(device                  == VK_NULL_HANDLE, "invalid command buffer memory",        return 0);
+	shVkArgError(p_swapchain_image_index == NULL,           "invalid swapchain image index memory", return 0);
+	shVkArgError(p_swapchain_suboptimal  == NULL,           "invalid swapchain suboptimal memory",  return 0);
 
-	shVkError(
+	shVkArgError(
 		acquired_signal_semaphore == VK_NULL_HANDLE && acquired_signal_fence == VK_NULL_HANDLE, 
 		"semaphore and fence are both VK_NULL_HANDLE", 
 		return 0
@@ -1966,13 +3169,13 @@ uint8_t shBeginRenderpass(
 	VkClearValue*      p_clear_values,
 	VkFramebuffer      framebuffer
 ) {
-	shVkError(graphics_cmd_buffer == VK_NULL_HANDLE, "invalid command buffer memory", return 0);
-	shVkError(renderpass          == VK_NULL_HANDLE, "invalid renderpass memory",     return 0);
-	shVkError(framebuffer         == VK_NULL_HANDLE, "invalid framebuffer memory",    return 0);
-	shVkError(render_size_x       == 0,    "invalid render size x",         return 0);
-	shVkError(render_size_y       == 0,    "invalid render size y",         return 0);
+	shVkArgError(graphics_cmd_buffer == VK_NULL_HANDLE, "invalid command buffer memory", return 0);
+	shVkArgError(renderpass          == VK_NULL_HANDLE, "invalid renderpass memory",     return 0);
+	shVkArgError(framebuffer         == VK_NULL_HANDLE, "invalid framebuffer memory",    return 0);
+	shVkArgError(render_size_x       == 0,    "invalid render size x",         return 0);
+	shVkArgError(render_size_y       == 0,    "invalid render size y",         return 0);
 
-	shVkError(
+	shVkArgError(
 		clear_value_count != 0 && p_clear_values == VK_NULL_HANDLE,
 		"invalid framebuffer attachments clear values memory",
 		return 0
@@ -2005,55 +3208,13 @@ uint8_t shBeginRenderpass(
 uint8_t shEndRenderpass(
 	VkCommandBuffer graphics_cmd_buffer
 ) {
-	shVkError(graphics_cmd_buffer == VK_NULL_HANDLE, "invalid command buffer memory", return 0);
+	shVkArgError(graphics_cmd_buffer == VK_NULL_HANDLE, "invalid command buffer memory", return 0);
 
 	vkCmdEndRenderPass(graphics_cmd_buffer);
 
 	return 1;
 }
 
-uint8_t shDraw(
-	VkCommandBuffer graphics_cmd_buffer,
-	uint32_t        vertex_count,
-	uint32_t        first_vertex,
-	uint32_t        instance_count,
-	uint32_t        first_instance
-) {
-	shVkError(graphics_cmd_buffer == VK_NULL_HANDLE, "invalid command buffer memory", return 0);
-
-	vkCmdDraw(
-		graphics_cmd_buffer,
-		vertex_count,
-		instance_count,
-		first_vertex,
-		first_instance
-	);
-
-	return 1;
-}
-
-uint8_t shDrawIndexed(
-	VkCommandBuffer graphics_cmd_buffer,
-	uint32_t        index_count,
-	uint32_t        instance_count,
-	uint32_t        first_index,
-	int32_t         vertex_offset,
-	uint32_t        first_instance
-) {
-	shVkError(graphics_cmd_buffer == VK_NULL_HANDLE, "invalid command buffer memory", return 0);
-
-	vkCmdDrawIndexed(
-		graphics_cmd_buffer, 
-		index_count,
-		instance_count,
-		first_index,
-		vertex_offset,
-		first_instance
-	);
-
-	return 1;
-}
-
 uint8_t shQueuePresentSwapchainImage(
 	VkQueue        present_queue,
 	uint32_t       semaphores_to_wait_for_count,
@@ -2061,8 +3222,8 @@ uint8_t shQueuePresentSwapchainImage(
 	VkSwapchainKHR swapchain,
 	uint32_t       swapchain_image_idx
 ) {
-	shVkError(present_queue == VK_NULL_HANDLE, "invalid present queue memory", return 0);
-	shVkError(swapchain == VK_NULL_HANDLE,     "invalid swapchain memory",     return 0);
+	shVkArgError(present_queue == VK_NULL_HANDLE, "invalid present queue memory", return 0);
+	shVkArgError(swapchain == VK_NULL_HANDLE,     "invalid swapchain memory",     return 0);
 
 	VkResult swapchain_result = VK_SUCCESS;
 
@@ -2100,9 +3261,9 @@ uint8_t shCreateBuffer(
 	VkSharingMode      sharing_mode,
 	VkBuffer*          p_buffer
 ) {
-	shVkError(device   == VK_NULL_HANDLE, "invalid device memory", return 0);
-	shVkError(p_buffer == VK_NULL_HANDLE, "invalid arguments",     return 0);
-	shVkError(size     == 0,    "invalid buffer size",   return 0);
+	shVkArgError(device   == VK_NULL_HANDLE, "invalid device memory", return 0);
+	shVkArgError(p_buffer == VK_NULL_HANDLE, "invalid arguments",     return 0);
+	shVkArgError(size     == 0,    "invalid buffer size",   return 0);
 
 	VkBufferCreateInfo buffer_create_info = {
 		.sType                 = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO, //sType;
@@ -2131,10 +3292,10 @@ uint8_t shAllocateBufferMemory(
 	VkMemoryPropertyFlags property_flags,
 	VkDeviceMemory*       p_memory
 ) {
-	shVkError(device          == VK_NULL_HANDLE, "invalid device handle",          return 0);
-	shVkError(physical_device == VK_NULL_HANDLE, "invalid physical device memory", return 0);
-	shVkError(buffer          == VK_NULL_HANDLE, "invalid buffer pointer",         return 0);
-	shVkError(p_memory        == VK_NULL_HANDLE, "invalid device memory pointer",  return 0);
+	shVkArgError(device          == VK_NULL_HANDLE, "invalid device handle",          return 0);
+	shVkArgError(physical_device == VK_NULL_HANDLE, "invalid physical device memory", return 0);
+	shVkArgError(buffer          == VK_NULL_HANDLE, "invalid buffer pointer",         return 0);
+	shVkArgError(p_memory        == VK_NULL_HANDLE, "invalid device memory pointer",  return 0);
 
 	uint32_t memory_type_index = 0;
 	shGetMemoryType(device, physical_device, property_flags, &memory_type_index);
@@ -2158,36 +3319,6 @@ uint8_t shAllocateBufferMemory(
 	return 1;
 }
 
-uint8_t shCopyBuffer(
-	VkCommandBuffer transfer_cmd_buffer,
-	VkBuffer        src_buffer,
-	uint32_t        src_offset,
-	uint32_t        dst_offset,
-	uint64_t        size,
-	VkBuffer        dst_buffer
-) {
-	shVkError(transfer_cmd_buffer == VK_NULL_HANDLE, "invalid command buffer",     return 0);
-	shVkError(src_buffer          == VK_NULL_HANDLE, "invalid source buffer",      return 0);
-	shVkError(size                == 0,              "invalid copy size",          return 0);
-	shVkError(dst_buffer          == VK_NULL_HANDLE, "invalid destination buffer", return 0);
-
-	VkBufferCopy region = {
-		.srcOffset = src_offset,
-		.dstOffset = dst_offset,
-		.size      = size
-	};
-
-	vkCmdCopyBuffer(
-		transfer_cmd_buffer, 
-		src_buffer, 
-		dst_buffer, 
-		1, 
-		&region
-	);
-
-	return 1;
-}
-
 uint8_t shCopyImage(
 	VkCommandBuffer    transfer_cmd_buffer,
 	uint32_t           width,
@@ -2197,11 +3328,11 @@ uint8_t shCopyImage(
 	VkImage            src_image,
 	VkImage            dst_image
 ) {
-	shVkError(transfer_cmd_buffer == VK_NULL_HANDLE, "invalid command buffer",    return 0);
-	shVkError(width               == 0,              "invalid copy width",        return 0);
-	shVkError(height              == 0,              "invalid copy height",       return 0);
-	shVkError(src_image           == VK_NULL_HANDLE, "invalid source image",      return 0);
-	shVkError(dst_image           == VK_NULL_HANDLE, "invalid destination image", return 0);
+	shVkArgError(transfer_cmd_buffer == VK_NULL_HANDLE, "invalid command buffer",    return 0);
+	shVkArgError(width               == 0,              "invalid copy width",        return 0);
+	shVkArgError(height              == 0,              "invalid copy height",       return 0);
+	shVkArgError(src_image           == VK_NULL_HANDLE, "invalid source image",      return 0);
+	shVkArgError(dst_image           == VK_NULL_HANDLE, "invalid destination image", return 0);
 
 	VkImageSubresourceLayers src_subresource = {
 		.aspectMask     = src_image_aspect,
@@ -2244,138 +3375,539 @@ uint8_t shCopyImage(
 	return 1;
 }
 
-//uint8_t shCopyBufferToImage(
-//	VkCommandBuffer transfer_cmd_buffer,
-//	VkBuffer        src_buffer,
-//	uint32_t        src_offset,
-//	uint32_t        dst_offset,
-//	uint32_t        width,
-//	uint32_t        height,
-//	VkImageAspectFlags dst_image_aspect_mask,
-//	uint32_t        dst_image_mip_level,
-//	VkImageLayout   dst_image_layout,
-//	VkImage         dst_image
-//) {
-//	shVkError(transfer_cmd_buffer == VK_NULL_HANDLE, "invalid command buffer",    return 0);
-//	shVkError(src_buffer          == VK_NULL_HANDLE, "invalid source buffer",     return 0);
-//	shVkError(size                == 0,              "invalid copy size",         return 0);
-//	shVkError(dst_image           == VK_NULL_HANDLE, "invalid destination image", return 0);
-//
-//	VkImageSubresource image_subresource = {
-//		dst_image_aspect_mask,//aspectMask
-//		dst_image_mip_level,//mipLevel
-//		//arrayLayer
-//	};
-//
-//	VkBufferImageCopy region = {
-//		src_offset,//bufferOffset
-//		0,//bufferRowLength
-//		0,//bufferImageHeight
-//				   //imageSubresource
-//				   //imageOffset
-//				   //imageExtent
-//
-//
-//	};
-//	vkCmdCopyBufferToImage(
-//		transfer_cmd_buffer, 
-//		src_buffer, 
-//		dst_image,
-//		dst_image_layout,
-//		1, 
-//		&region
-//	);
-//
-//	return 1;
-//}
-
-uint8_t shCopyBufferRegions(
-	VkCommandBuffer transfer_cmd_buffer,
-	VkBuffer        src_buffer,
-	uint32_t        region_count,
-	uint32_t*       p_src_offsets,
-	uint32_t*       p_dst_offsets,
-	uint32_t*       p_sizes,
-	VkBuffer        dst_buffer
+uint8_t shCopyImageRegions(
+	VkCommandBuffer    transfer_cmd_buffer,
+	VkImage            src_image,
+	VkImageLayout      src_image_layout,
+	uint32_t           region_count,
+	const VkImageCopy* p_regions,
+	VkImageLayout      dst_image_layout,
+	VkImage            dst_image
 ) {
-	shVkError(transfer_cmd_buffer == VK_NULL_HANDLE, "invalid command buffer",     return 0);
-	shVkError(src_buffer          == VK_NULL_HANDLE, "invalid source buffer",      return 0);
-	shVkError(region_count        == 0,    "invalid region count",       return 0);
-	shVkError(p_src_offsets       == VK_NULL_HANDLE, "invalid src offsets memory", return 0);
-	shVkError(p_dst_offsets       == VK_NULL_HANDLE, "invalid dst offsets memory", return 0);
-	shVkError(p_sizes             == VK_NULL_HANDLE, "invalid copy sizes memory",  return 0);
-	shVkError(dst_buffer          == VK_NULL_HANDLE, "invalid destination buffer", return 0);
+	shVkArgError(transfer_cmd_buffer == VK_NULL_HANDLE, "invalid command buffer",    return 0);
+	shVkArgError(src_image           == VK_NULL_HANDLE, "invalid source image",      return 0);
+	shVkArgError(region_count        == 0,              "invalid region count",      return 0);
+	shVkArgError(p_regions           == VK_NULL_HANDLE, "invalid regions memory",    return 0);
+	shVkArgError(dst_image           == VK_NULL_HANDLE, "invalid destination image", return 0);
 
-	VkBufferCopy regions[SH_MAX_STACK_BUFFER_REGION_COUNT] = { 0 };
+	vkCmdCopyImage(
+		transfer_cmd_buffer,//commandBuffer
+		src_image,//srcImage
+		src_image_layout,//srcImageLayout
+		dst_image,//dstImage
+		dst_image_layout,//dstImageLayout
+		region_count,//regionCount
+		p_regions//pRegions
+	);
 
-	for (uint32_t region_idx = 0; region_idx < region_count; region_idx++) {
-		shVkError(
-			p_sizes[region_idx] == 0,
-			"invalid copy size",
-			return 0
-		);
-		regions[region_idx].srcOffset = p_src_offsets[region_idx];
-		regions[region_idx].dstOffset = p_dst_offsets[region_idx];
-		regions[region_idx].size      = p_sizes[region_idx];
+	return 1;
+}
+
+uint8_t shCopyImageSubresourceRange(
+	VkCommandBuffer         transfer_cmd_buffer,
+	uint32_t                width,
+	uint32_t                height,
+	uint32_t                depth,
+	VkImageSubresourceRange subresource_range,
+	VkImage                 src_image,
+	VkImage                 dst_image
+) {
+	shVkArgError(transfer_cmd_buffer == VK_NULL_HANDLE,                     "invalid command buffer",    return 0);
+	shVkArgError(width == 0 || height == 0 || depth == 0,                   "invalid copy size",         return 0);
+	shVkArgError(subresource_range.levelCount == 0,                         "invalid mip level count",   return 0);
+	shVkArgError(subresource_range.levelCount > 32,                         "too many mip levels",       return 0);
+	shVkArgError(subresource_range.layerCount == 0,                         "invalid layer count",       return 0);
+	shVkArgError(subresource_range.layerCount == VK_REMAINING_ARRAY_LAYERS, "invalid layer count",       return 0);
+	shVkArgError(src_image           == VK_NULL_HANDLE,                     "invalid source image",      return 0);
+	shVkArgError(dst_image           == VK_NULL_HANDLE,                     "invalid destination image", return 0);
+
+	VkImageCopy regions[32] = { 0 };//a 32 bit extent has at most 32 mip levels
+
+	for (uint32_t level_idx = 0; level_idx < subresource_range.levelCount; level_idx++) {
+		uint32_t level = subresource_range.baseMipLevel + level_idx;
+
+		VkImageSubresourceLayers subresource = {
+			.aspectMask     = subresource_range.aspectMask,
+			.mipLevel       = level,
+			.baseArrayLayer = subresource_range.baseArrayLayer,
+			.layerCount     = subresource_range.layerCount
+		};
+
+		regions[level_idx].srcSubresource = subresource;
+		regions[level_idx].dstSubresource = subresource;
+		regions[level_idx].extent.width   = (width  >> level) ? (width  >> level) : 1;
+		regions[level_idx].extent.height  = (height >> level) ? (height >> level) : 1;
+		regions[level_idx].extent.depth   = (depth  >> level) ? (depth  >> level) : 1;
 	}
 
-	vkCmdCopyBuffer(
-		transfer_cmd_buffer, 
-		src_buffer, 
-		dst_buffer, 
-		region_count, 
-		regions
+	vkCmdCopyImage(
+		transfer_cmd_buffer,//commandBuffer
+		src_image,//srcImage
+		VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,//srcImageLayout
+		dst_image,//dstImage
+		VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,//dstImageLayout
+		subresource_range.levelCount,//regionCount
+		regions//pRegions
 	);
 
 	return 1;
 }
 
-uint8_t shBindBufferMemory(
-	VkDevice       device,
-	VkBuffer       buffer,
-	uint32_t       offset,
-	VkDeviceMemory buffer_memory
+uint8_t shCopyBufferToImage(
+	VkCommandBuffer          transfer_cmd_buffer,
+	VkBuffer                 src_buffer,
+	uint32_t                 region_count,
+	const VkBufferImageCopy* p_regions,
+	VkImageLayout            dst_image_layout,
+	VkImage                  dst_image
 ) {
-	shVkError(device == VK_NULL_HANDLE,			"invalid device memory", return 0);
-	shVkError(buffer == VK_NULL_HANDLE,			"invalid buffer handle", return 0);
-	shVkError(buffer_memory == VK_NULL_HANDLE,	"invalid buffer memory", return 0);
-	
-	shVkResultError(
-		vkBindBufferMemory(device, buffer, buffer_memory, offset),
-		"error binding buffer memory", return 0
-	)
+	shVkArgError(transfer_cmd_buffer == VK_NULL_HANDLE, "invalid command buffer",    return 0);
+	shVkArgError(src_buffer          == VK_NULL_HANDLE, "invalid source buffer",     return 0);
+	shVkArgError(region_count        == 0,              "invalid region count",      return 0);
+	shVkArgError(p_regions           == VK_NULL_HANDLE, "invalid regions memory",    return 0);
+	shVkArgError(dst_image           == VK_NULL_HANDLE, "invalid destination image", return 0);
+
+	vkCmdCopyBufferToImage(
+		transfer_cmd_buffer,//commandBuffer
+		src_buffer,//srcBuffer
+		dst_image,//dstImage
+		dst_image_layout,//dstImageLayout
+		region_count,//regionCount
+		p_regions//pRegions
+	);
 
 	return 1;
 }
 
-uint8_t shGetMemoryType(
-	VkDevice              device,
-	VkPhysicalDevice      physical_device,
-	VkMemoryPropertyFlags property_flags,
-	uint32_t*             p_memory_type_index
+uint8_t shCopyImageToBuffer(
+	VkCommandBuffer          transfer_cmd_buffer,
+	VkImage                  src_image,
+	VkImageLayout            src_image_layout,
+	uint32_t                 region_count,
+	const VkBufferImageCopy* p_regions,
+	VkBuffer                 dst_buffer
 ) {
-	shVkError(device              == VK_NULL_HANDLE, "invalid device memory",             return 0);
-	shVkError(physical_device     == VK_NULL_HANDLE, "invalid physical device memory",    return 0);
-	shVkError(p_memory_type_index == VK_NULL_HANDLE, "invalid memory type index pointer", return 0);
-
-	VkPhysicalDeviceMemoryProperties memory_properties;
-	vkGetPhysicalDeviceMemoryProperties(physical_device, &memory_properties);
+	shVkArgError(transfer_cmd_buffer == VK_NULL_HANDLE, "invalid command buffer",     return 0);
+	shVkArgError(src_image           == VK_NULL_HANDLE, "invalid source image",       return 0);
+	shVkArgError(region_count        == 0,              "invalid region count",       return 0);
+	shVkArgError(p_regions           == VK_NULL_HANDLE, "invalid regions memory",     return 0);
+	shVkArgError(dst_buffer          == VK_NULL_HANDLE, "invalid destination buffer", return 0);
 
-	for (uint32_t i = 0; i < memory_properties.memoryTypeCount; i++) {
+	vkCmdCopyImageToBuffer(
+		transfer_cmd_buffer,//commandBuffer
+		src_image,//srcImage
+		src_image_layout,//srcImageLayout
+		dst_buffer,//dstBuffer
+		region_count,//regionCount
+		p_regions//pRegions
+	);
 
-		if (memory_properties.memoryTypes[i].propertyFlags & (1 << i) &&
-			(memory_properties.memoryTypes[i].propertyFlags & property_flags) == property_flags) {
-			*p_memory_type_index = i;
-			return 1;
-		}
+	return 1;
+}
 
-	}
+//texels read by vkCmdCopyBufferToImage, from the first one to the last one of the region
+static uint8_t shGetTextureUploadSize(
+	const ShVkTextureUpload* p_upload,
+	VkDeviceSize*            p_size
+) {
+	shVkError(p_upload->texel_size == 0,                     "invalid upload texel size", return 0);
+	shVkError(p_upload->width == 0 || p_upload->height == 0, "invalid upload extent",     return 0);
 	shVkError(
-		0,
-		"cannot find suitable memory type for the given buffer", 
+		p_upload->buffer_row_length != 0 && p_upload->buffer_row_length < p_upload->width,
+		"upload buffer row length smaller than the region width",
 		return 0
 	);
-
+	shVkError(
+		p_upload->buffer_image_height != 0 && p_upload->buffer_image_height < p_upload->height,
+		"upload buffer image height smaller than the region height",
+		return 0
+	);
+
+	VkDeviceSize block_width   = p_upload->block_width         ? p_upload->block_width         : 1;
+	VkDeviceSize block_height  = p_upload->block_height        ? p_upload->block_height        : 1;
+	VkDeviceSize row_length    = p_upload->buffer_row_length   ? p_upload->buffer_row_length   : p_upload->width;
+	VkDeviceSize image_height  = p_upload->buffer_image_height ? p_upload->buffer_image_height : p_upload->height;
+	VkDeviceSize slice_count   = (VkDeviceSize)(p_upload->depth ? p_upload->depth : 1) * (p_upload->layer_count ? p_upload->layer_count : 1);
+
+	VkDeviceSize row_blocks    = (row_length       + block_width  - 1) / block_width;
+	VkDeviceSize slice_rows    = (image_height     + block_height - 1) / block_height;
+	VkDeviceSize region_blocks = (p_upload->width  + block_width  - 1) / block_width;
+	VkDeviceSize region_rows   = (p_upload->height + block_height - 1) / block_height;
+
+	(*p_size) = (((slice_count - 1) * slice_rows + region_rows - 1) * row_blocks + region_blocks) * p_upload->texel_size;
+
+	return 1;
+}
+
+uint8_t shGetTextureUploadStagingSize(
+	uint32_t                 upload_count,
+	const ShVkTextureUpload* p_uploads,
+	VkDeviceSize*            p_offsets,
+	VkDeviceSize*            p_sizes,
+	VkDeviceSize*            p_staging_size
+) {
+	shVkArgError(upload_count   == 0,              "invalid upload count",        return 0);
+	shVkArgError(p_uploads      == VK_NULL_HANDLE, "invalid uploads memory",      return 0);
+	shVkArgError(p_staging_size == VK_NULL_HANDLE, "invalid staging size memory", return 0);
+
+	VkDeviceSize offset = 0;
+
+	for (uint32_t upload_idx = 0; upload_idx < upload_count; upload_idx++) {
+		const ShVkTextureUpload* p_upload = &p_uploads[upload_idx];
+
+		VkDeviceSize size = 0;
+		shVkError(
+			shGetTextureUploadSize(p_upload, &size) == 0,
+			"invalid texture upload",
+			return 0
+		);
+
+		//bufferOffset must be a multiple of both the texel size and 4
+		VkDeviceSize alignment = p_upload->texel_size;
+		while (alignment % 4 != 0) {
+			alignment += p_upload->texel_size;
+		}
+		offset = (offset + alignment - 1) / alignment * alignment;
+
+		if (p_offsets != VK_NULL_HANDLE) {
+			p_offsets[upload_idx] = offset;
+		}
+		if (p_sizes != VK_NULL_HANDLE) {
+			p_sizes[upload_idx] = size;
+		}
+		offset += size;
+	}
+
+	(*p_staging_size) = offset;
+
+	return 1;
+}
+
+//entirely overwritten subresources can be transitioned from VK_IMAGE_LAYOUT_UNDEFINED
+static uint8_t shTextureUploadCoversLevel(
+	const ShVkTextureUpload* p_upload
+) {
+	if (p_upload->image_offset.x != 0 || p_upload->image_offset.y != 0 || p_upload->image_offset.z != 0) {
+		return 0;
+	}
+	uint32_t depth = p_upload->depth ? p_upload->depth : 1;
+	return
+		p_upload->width  >= p_upload->level_extent.width  &&
+		p_upload->height >= p_upload->level_extent.height &&
+		depth            >= p_upload->level_extent.depth;
+}
+
+uint8_t shCmdUploadTextures(
+	VkDevice                 device,
+	VkPhysicalDevice         physical_device,
+	VkCommandBuffer          transfer_cmd_buffer,
+	uint32_t                 upload_count,
+	const ShVkTextureUpload* p_uploads,
+	VkImageLayout            dst_image_layout,
+	VkAccessFlags            dst_access_mask,
+	VkPipelineStageFlags     dst_stage,
+	VkBuffer*                p_staging_buffer,
+	VkDeviceMemory*          p_staging_memory
+) {
+	shVkArgError(device              == VK_NULL_HANDLE,              "invalid device handle",          return 0);
+	shVkArgError(physical_device     == VK_NULL_HANDLE,              "invalid physical device handle", return 0);
+	shVkArgError(transfer_cmd_buffer == VK_NULL_HANDLE,              "invalid command buffer",         return 0);
+	shVkArgError(upload_count        >  SH_MAX_TEXTURE_UPLOAD_COUNT, "too many texture uploads",       return 0);
+	shVkArgError(p_staging_buffer    == VK_NULL_HANDLE,              "invalid staging buffer memory",  return 0);
+	shVkArgError(p_staging_memory    == VK_NULL_HANDLE,              "invalid staging memory pointer", return 0);
+
+	VkDeviceSize offsets[SH_MAX_TEXTURE_UPLOAD_COUNT] = { 0 };
+	VkDeviceSize sizes  [SH_MAX_TEXTURE_UPLOAD_COUNT] = { 0 };
+	VkDeviceSize staging_size                         = 0;
+
+	shVkError(
+		shGetTextureUploadStagingSize(upload_count, p_uploads, offsets, sizes, &staging_size) == 0,
+		"failed computing texture upload staging size",
+		return 0
+	);
+	shVkError(staging_size > UINT32_MAX, "texture upload staging size is too large", return 0);
+
+	//nothing is created, mapped or copied before every upload is valid
+	for (uint32_t upload_idx = 0; upload_idx < upload_count; upload_idx++) {
+		const ShVkTextureUpload* p_upload = &p_uploads[upload_idx];
+		shVkError(p_upload->image    == VK_NULL_HANDLE, "invalid upload image",  return 0);
+		shVkError(p_upload->p_texels == VK_NULL_HANDLE, "invalid upload texels", return 0);
+		shVkError(
+			!shTextureUploadCoversLevel(p_upload) && p_upload->current_layout == VK_IMAGE_LAYOUT_UNDEFINED,
+			"partial texture upload without the current layout of the image",
+			return 0
+		);
+	}
+
+	//uploads grouped by image, in their original order within each image
+	uint32_t order[SH_MAX_TEXTURE_UPLOAD_COUNT]   = { 0 };
+	uint8_t  ordered[SH_MAX_TEXTURE_UPLOAD_COUNT] = { 0 };
+	uint32_t ordered_count                        = 0;
+	for (uint32_t upload_idx = 0; upload_idx < upload_count; upload_idx++) {
+		if (ordered[upload_idx]) {
+			continue;
+		}
+		for (uint32_t same_idx = upload_idx; same_idx < upload_count; same_idx++) {
+			if (!ordered[same_idx] && p_uploads[same_idx].image == p_uploads[upload_idx].image) {
+				order[ordered_count] = same_idx;
+				ordered[same_idx]    = 1;
+				ordered_count++;
+			}
+		}
+	}
+
+	VkBuffer       staging_buffer = VK_NULL_HANDLE;
+	VkDeviceMemory staging_memory = VK_NULL_HANDLE;
+
+	shVkError(
+		shCreateBuffer(device, (uint32_t)staging_size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_SHARING_MODE_EXCLUSIVE, &staging_buffer) == 0,
+		"failed creating texture upload staging buffer",
+		return 0
+	);
+	shVkError(
+		shAllocateBufferMemory(device, physical_device, staging_buffer, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &staging_memory) == 0,
+		"failed allocating texture upload staging memory",
+		vkDestroyBuffer(device, staging_buffer, VK_NULL_HANDLE); return 0
+	);
+	shVkError(
+		shBindBufferMemory(device, staging_buffer, 0, staging_memory) == 0,
+		"failed binding texture upload staging memory",
+		vkDestroyBuffer(device, staging_buffer, VK_NULL_HANDLE); vkFreeMemory(device, staging_memory, VK_NULL_HANDLE); return 0
+	);
+
+	void* p_staging_data = VK_NULL_HANDLE;
+	shVkResultError(
+		vkMapMemory(device, staging_memory, 0, staging_size, 0, &p_staging_data),
+		"error mapping texture upload staging memory",
+		vkDestroyBuffer(device, staging_buffer, VK_NULL_HANDLE); vkFreeMemory(device, staging_memory, VK_NULL_HANDLE); return 0
+	);
+	for (uint32_t upload_idx = 0; upload_idx < upload_count; upload_idx++) {
+		memcpy(&((uint8_t*)p_staging_data)[offsets[upload_idx]], p_uploads[upload_idx].p_texels, (size_t)sizes[upload_idx]);
+	}
+	vkUnmapMemory(device, staging_memory);
+
+	(*p_staging_buffer) = staging_buffer;
+	(*p_staging_memory) = staging_memory;
+
+	VkBufferImageCopy    regions[SH_MAX_TEXTURE_UPLOAD_COUNT]  = { 0 };
+	VkImageMemoryBarrier barriers[SH_MAX_TEXTURE_UPLOAD_COUNT] = { 0 };
+	uint32_t             barrier_count                         = 0;
+	VkPipelineStageFlags src_stage                             = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+
+	for (uint32_t region_idx = 0; region_idx < upload_count; region_idx++) {
+		const ShVkTextureUpload* p_upload    = &p_uploads[order[region_idx]];
+		uint32_t                 layer_count = p_upload->layer_count ? p_upload->layer_count : 1;
+
+		regions[region_idx] = (VkBufferImageCopy) {
+			.bufferOffset      = offsets[order[region_idx]],//bufferOffset;
+			.bufferRowLength   = p_upload->buffer_row_length,//bufferRowLength;
+			.bufferImageHeight = p_upload->buffer_image_height,//bufferImageHeight;
+			.imageSubresource  = {
+				.aspectMask     = p_upload->aspect_mask,
+				.mipLevel       = p_upload->mip_level,
+				.baseArrayLayer = p_upload->base_array_layer,
+				.layerCount     = layer_count
+			},//imageSubresource;
+			.imageOffset       = p_upload->image_offset,//imageOffset;
+			.imageExtent       = {
+				.width  = p_upload->width,
+				.height = p_upload->height,
+				.depth  = p_upload->depth ? p_upload->depth : 1
+			}//imageExtent;
+		};
+
+		//only the uploaded subresources are transitioned, partially overwritten ones keep their content
+		uint8_t covers_level = shTextureUploadCoversLevel(p_upload);
+
+		VkImageSubresourceRange range = {
+			.aspectMask     = p_upload->aspect_mask,     //aspectMask;
+			.baseMipLevel   = p_upload->mip_level,       //baseMipLevel;
+			.levelCount     = 1,                         //levelCount;
+			.baseArrayLayer = p_upload->base_array_layer,//baseArrayLayer;
+			.layerCount     = layer_count                //layerCount;
+		};
+
+		if (!covers_level) {
+			src_stage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+		}
+
+		VkImageMemoryBarrier* p_duplicate = VK_NULL_HANDLE;
+		for (uint32_t barrier_idx = 0; barrier_idx < barrier_count && p_duplicate == VK_NULL_HANDLE; barrier_idx++) {
+			if (barriers[barrier_idx].image == p_upload->image &&
+				memcmp(&barriers[barrier_idx].subresourceRange, &range, sizeof(VkImageSubresourceRange)) == 0) {
+				p_duplicate = &barriers[barrier_idx];
+			}
+		}
+		if (p_duplicate != VK_NULL_HANDLE) {
+			//a partial region of the same subresources keeps the texels written before the batch
+			if (!covers_level) {
+				p_duplicate->srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+				p_duplicate->oldLayout     = p_upload->current_layout;
+			}
+			continue;
+		}
+
+		barriers[barrier_count] = (VkImageMemoryBarrier) {
+			.sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,//sType;
+			.pNext               = VK_NULL_HANDLE,//pNext;
+			.srcAccessMask       = covers_level ? 0 : VK_ACCESS_MEMORY_WRITE_BIT,//srcAccessMask;
+			.dstAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT,//dstAccessMask;
+			.oldLayout           = covers_level ? VK_IMAGE_LAYOUT_UNDEFINED : p_upload->current_layout,//oldLayout;
+			.newLayout           = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,//newLayout;
+			.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,//srcQueueFamilyIndex;
+			.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,//dstQueueFamilyIndex;
+			.image               = p_upload->image,//image;
+			.subresourceRange    = range//subresourceRange;
+		};
+		barrier_count++;
+	}
+
+	vkCmdPipelineBarrier(
+		transfer_cmd_buffer,//commandBuffer
+		src_stage,//srcStageMask
+		VK_PIPELINE_STAGE_TRANSFER_BIT,//dstStageMask
+		0,//dependencyFlags
+		0,//memoryBarrierCount
+		VK_NULL_HANDLE,//pMemoryBarriers
+		0,//bufferMemoryBarrierCount
+		VK_NULL_HANDLE,//pBufferMemoryBarriers
+		barrier_count,//imageMemoryBarrierCount
+		barriers//pImageMemoryBarriers
+	);
+
+	//one copy per image, with a region per upload
+	for (uint32_t first_region_idx = 0; first_region_idx < upload_count;) {
+		VkImage  image        = p_uploads[order[first_region_idx]].image;
+		uint32_t region_count = 1;
+		while (
+			first_region_idx + region_count < upload_count &&
+			p_uploads[order[first_region_idx + region_count]].image == image
+			) {
+			region_count++;
+		}
+
+		vkCmdCopyBufferToImage(
+			transfer_cmd_buffer,//commandBuffer
+			staging_buffer,//srcBuffer
+			image,//dstImage
+			VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,//dstImageLayout
+			region_count,//regionCount
+			&regions[first_region_idx]//pRegions
+		);
+
+		first_region_idx += region_count;
+	}
+
+	for (uint32_t barrier_idx = 0; barrier_idx < barrier_count; barrier_idx++) {
+		barriers[barrier_idx].srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		barriers[barrier_idx].dstAccessMask = dst_access_mask;
+		barriers[barrier_idx].oldLayout     = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+		barriers[barrier_idx].newLayout     = dst_image_layout;
+	}
+
+	vkCmdPipelineBarrier(
+		transfer_cmd_buffer,//commandBuffer
+		VK_PIPELINE_STAGE_TRANSFER_BIT,//srcStageMask
+		dst_stage,//dstStageMask
+		0,//dependencyFlags
+		0,//memoryBarrierCount
+		VK_NULL_HANDLE,//pMemoryBarriers
+		0,//bufferMemoryBarrierCount
+		VK_NULL_HANDLE,//pBufferMemoryBarriers
+		barrier_count,//imageMemoryBarrierCount
+		barriers//pImageMemoryBarriers
+	);
+
+	return 1;
+}
+
+uint8_t shCopyBufferRegions(
+	VkCommandBuffer transfer_cmd_buffer,
+	VkBuffer        src_buffer,
+	uint32_t        region_count,
+	uint32_t*       p_src_offsets,
+	uint32_t*       p_dst_offsets,
+	uint32_t*       p_sizes,
+	VkBuffer        dst_buffer
+) {
+	shVkArgError(transfer_cmd_buffer == VK_NULL_HANDLE, "invalid command buffer",     return 0);
+	shVkArgError(src_buffer          == VK_NULL_HANDLE, "invalid source buffer",      return 0);
+	shVkArgError(region_count        == 0,    "invalid region count",       return 0);
+	shVkArgError(p_src_offsets       == VK_NULL_HANDLE, "invalid src offsets memory", return 0);
+	shVkArgError(p_dst_offsets       == VK_NULL_HANDLE, "invalid dst offsets memory", return 0);
+	shVkArgError(p_sizes             == VK_NULL_HANDLE, "invalid copy sizes memory",  return 0);
+	shVkArgError(dst_buffer          == VK_NULL_HANDLE, "invalid destination buffer", return 0);
+
+	VkBufferCopy regions[SH_MAX_STACK_BUFFER_REGION_COUNT] = { 0 };
+
+	for (uint32_t region_idx = 0; region_idx < region_count; region_idx++) {
+		shVkError(
+			p_sizes[region_idx] == 0,
+			"invalid copy size",
+			return 0
+		);
+		regions[region_idx].srcOffset = p_src_offsets[region_idx];
+		regions[region_idx].dstOffset = p_dst_offsets[region_idx];
+		regions[region_idx].size      = p_sizes[region_idx];
+	}
+
+	vkCmdCopyBuffer(
+		transfer_cmd_buffer, 
+		src_buffer, 
+		dst_buffer, 
+		region_count, 
+		regions
+	);
+
+	return 1;
+}
+
+uint8_t shBindBufferMemory(
+	VkDevice       device,
+	VkBuffer       buffer,
+	uint32_t       offset,
+	VkDeviceMemory buffer_memory
+) {
+	shVkArgError(device == VK_NULL_HANDLE,			"invalid device memory", return 0);
+	shVkArgError(buffer == VK_NULL_HANDLE,			"invalid buffer handle", return 0);
+	shVkArgError(buffer_memory == VK_NULL_HANDLE,	"invalid buffer memory", return 0);
+	
+	shVkResultError(
+		vkBindBufferMemory(device, buffer, buffer_memory, offset),
+		"error binding buffer memory", return 0
+	)
+
+	return 1;
+}
+
+uint8_t shGetMemoryType(
+	VkDevice              device,
+	VkPhysicalDevice      physical_device,
+	VkMemoryPropertyFlags property_flags,
+	uint32_t*             p_memory_type_index
+) {
+	shVkArgError(device              == VK_NULL_HANDLE, "invalid device memory",             return 0);
+	shVkArgError(physical_device     == VK_NULL_HANDLE, "invalid physical device memory",    return 0);
+	shVkArgError(p_memory_type_index == VK_NULL_HANDLE, "invalid memory type index pointer", return 0);
+
+	VkPhysicalDeviceMemoryProperties memory_properties;
+	vkGetPhysicalDeviceMemoryProperties(physical_device, &memory_properties);
+
+	for (uint32_t i = 0; i < memory_properties.memoryTypeCount; i++) {
+
+		if (memory_properties.memoryTypes[i].propertyFlags & (1 << i) &&
+			(memory_properties.memoryTypes[i].propertyFlags & property_flags) == property_flags) {
+			*p_memory_type_index = i;
+			return 1;
+		}
+
+	}
+	shVkError(
+		0,
+		"cannot find suitable memory type for the given buffer", 
+		return 0
+	);
+
 	return 0;
 }
 
@@ -2387,11 +3919,11 @@ uint8_t shReadMemory(
 	void**         pp_map_data,
 	void*          p_dst_data
 ) {
-	shVkError(device      == VK_NULL_HANDLE, "invalid device memory",  return 0);
-	shVkError(memory      == VK_NULL_HANDLE, "invalid memory",         return 0);
-	shVkError(data_size   == 0,              "invalid read data size", return 0);
+	shVkArgError(device      == VK_NULL_HANDLE, "invalid device memory",  return 0);
+	shVkArgError(memory      == VK_NULL_HANDLE, "invalid memory",         return 0);
+	shVkArgError(data_size   == 0,              "invalid read data size", return 0);
 	
-	shVkError(
+	shVkArgError(
 		pp_map_data == NULL && p_dst_data == NULL,
 		"both map pointer and dst heap pointer are invalid",
 		return 0
@@ -2432,8 +3964,8 @@ uint8_t shUnmapMemory(
 	VkDevice       device,
 	VkDeviceMemory memory
 ) {
-	shVkError(device == VK_NULL_HANDLE, "invalid device memory",  return 0);
-	shVkError(memory == VK_NULL_HANDLE, "invalid memory",         return 0);
+	shVkArgError(device == VK_NULL_HANDLE, "invalid device memory",  return 0);
+	shVkArgError(memory == VK_NULL_HANDLE, "invalid memory",         return 0);
 	
 	vkUnmapMemory(device, memory);
 
@@ -2447,10 +3979,10 @@ uint8_t shWriteMemory(
 	uint32_t       data_size,
 	void*          p_data
 ) {
-	shVkError(device == VK_NULL_HANDLE, "invalid device memory", return 0);
-	shVkError(memory == VK_NULL_HANDLE, "invalid memory",        return 0);
-	shVkError(data_size == 0, "invalid data size",     return 0);
-	shVkError(p_data == VK_NULL_HANDLE, "invalid memory buffer", return 0);
+	shVkArgError(device == VK_NULL_HANDLE, "invalid device memory", return 0);
+	shVkArgError(memory == VK_NULL_HANDLE, "invalid memory",        return 0);
+	shVkArgError(data_size == 0, "invalid data size",     return 0);
+	shVkArgError(p_data == VK_NULL_HANDLE, "invalid memory buffer", return 0);
 
 	void* data;
 	shVkResultError(
@@ -2468,9 +4000,9 @@ uint8_t shClearBufferMemory(
 	VkBuffer       buffer,
 	VkDeviceMemory memory
 ) {
-	shVkError(device == VK_NULL_HANDLE, "invalid device handle", return 0);
-	shVkError(buffer == VK_NULL_HANDLE, "invalid buffer memory", return 0);
-	shVkError(memory == VK_NULL_HANDLE, "invalid device memory", return 0);
+	shVkArgError(device == VK_NULL_HANDLE, "invalid device handle", return 0);
+	shVkArgError(buffer == VK_NULL_HANDLE, "invalid buffer memory", return 0);
+	shVkArgError(memory == VK_NULL_HANDLE, "invalid device memory", return 0);
 
 	shVkResultError(
 		vkDeviceWaitIdle(device),
@@ -2483,107 +4015,301 @@ uint8_t shClearBufferMemory(
 	return 1;
 }
 
-uint8_t shCreateImage(
-	VkDevice              device,
-	VkImageType           type,
-	uint32_t              x,
-	uint32_t              y,
-	uint32_t              z,
-	VkFormat              format,
-	uint32_t              mip_levels,
-	VkSampleCountFlagBits sample_count,
-	VkImageTiling         image_tiling,
-	VkImageUsageFlags     usage,
-	VkSharingMode         sharing_mode,
-	VkImage*              p_image
+uint8_t shCreateUniformArena(
+	VkDevice           device,
+	VkPhysicalDevice   physical_device,
+	uint32_t           frame_count,
+	uint32_t           frame_size,
+	VkBufferUsageFlags usage,
+	ShVkUniformArena*  p_arena
 ) {
-	shVkError(device       == VK_NULL_HANDLE, "invalid device memory",   return 0);
-	shVkError(x            == 0,              "invalid image x size",    return 0);
-	shVkError(y            == 0,              "invalid image y size",    return 0);
-	shVkError(z            == 0,              "invalid image z size",    return 0);
-	shVkError(mip_levels   == 0,              "invalid mip level count", return 0);
-	shVkError(sample_count == 0,              "invalid sample count",    return 0);
-	shVkError(p_image      == VK_NULL_HANDLE, "invalid image memory",    return 0);
-
-	VkExtent3D image_extent = {
-		.width  = x,
-		.height = y,
-		.depth  = z
-	};
-
-	VkImageCreateInfo image_create_info = {
-		.sType                 = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO, //sType;			
-		.pNext                 = VK_NULL_HANDLE,                      //pNext;
-		.flags                 = 0,                                   //flags;
-		.imageType             = type,                                //imageType;
-		.format                = format,                              //format;
-		.extent                = image_extent,                        //extent;
-		.mipLevels             = mip_levels,                          //mipLevels;
-		.arrayLayers           = 1,                                   //arrayLayers;
-		.samples               = sample_count,                        //samples;
-		.tiling                = image_tiling,                        //tiling;
-		.usage                 = usage,                               //usage;
-		.sharingMode           = sharing_mode,                        //sharingMode;
-		.queueFamilyIndexCount = 0,                                   //queueFamilyIndexCount;
-		.pQueueFamilyIndices   = VK_NULL_HANDLE                       //pQueueFamilyIndices;
-	};
-
-	shVkResultError(
-		vkCreateImage(device, &image_create_info, VK_NULL_HANDLE, p_image),
-		"error creating image", 
+	shVkArgError(device          == VK_NULL_HANDLE, "invalid device memory",          return 0);
+	shVkArgError(physical_device == VK_NULL_HANDLE, "invalid physical device memory", return 0);
+	shVkArgError(frame_size      == 0,              "invalid arena frame size",       return 0);
+	shVkArgError(p_arena         == VK_NULL_HANDLE, "invalid uniform arena memory",   return 0);
+
+	shVkArgError(
+		frame_count == 0 || frame_count > SH_MAX_UNIFORM_ARENA_FRAME_COUNT,
+		"invalid arena frame count",
 		return 0
 	);
 
-	return 1;
-}
+	VkPhysicalDeviceProperties physical_device_properties = { 0 };
+	vkGetPhysicalDeviceProperties(physical_device, &physical_device_properties);
 
-uint8_t shAllocateImageMemory(
-	VkDevice              device,
-	VkPhysicalDevice      physical_device,
-	VkImage               image,
-	VkMemoryPropertyFlags memory_property_flags,
-	VkDeviceMemory*       p_image_memory
-) {
-	shVkError(device          == VK_NULL_HANDLE, "invalid device memory",    return 0);
-	shVkError(physical_device == VK_NULL_HANDLE, "invalid physical device ", return 0);
-	shVkError(image           == VK_NULL_HANDLE, "invalid image",            return 0);
-	shVkError(p_image_memory  == VK_NULL_HANDLE, "invalid image memory",     return 0);
+	uint8_t storage = (usage & VK_BUFFER_USAGE_STORAGE_BUFFER_BIT) != 0;
 
-	VkMemoryRequirements memory_requirements = { 0 };
-	vkGetImageMemoryRequirements(device, image, &memory_requirements);
+	uint32_t alignment = storage ?
+		(uint32_t)physical_device_properties.limits.minStorageBufferOffsetAlignment :
+		(uint32_t)physical_device_properties.limits.minUniformBufferOffsetAlignment;
 
-	uint32_t memory_type_index = 0;
+	if (alignment == 0) {
+		alignment = 1;
+	}
+
+	VkDeviceSize aligned_frame_size = ((VkDeviceSize)frame_size + alignment - 1) / alignment * alignment;
+	VkDeviceSize arena_size         = aligned_frame_size * frame_count;
+
+	//dynamic offsets are 32 bit, every byte of the arena must be addressable by one
 	shVkError(
-		shGetMemoryType(device, physical_device, memory_property_flags, &memory_type_index) == 0,
-		"failed detecting memory type",
+		arena_size > UINT32_MAX,
+		"uniform arena size exceeds the 32 bit dynamic offset range",
 		return 0
 	);
 
-	VkMemoryAllocateInfo memory_allocate_info = {
-		.sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
-		.pNext           = VK_NULL_HANDLE,
-		.allocationSize  = memory_requirements.size,
-		.memoryTypeIndex = memory_type_index
+	ShVkUniformArena arena = {
+		.alignment   = alignment,
+		.max_range   = storage ?
+			physical_device_properties.limits.maxStorageBufferRange :
+			physical_device_properties.limits.maxUniformBufferRange,
+		.frame_count = frame_count,
+		.frame_size  = (uint32_t)aligned_frame_size
 	};
 
-	shVkResultError(
-		vkAllocateMemory(device, &memory_allocate_info, VK_NULL_HANDLE, p_image_memory),
-		"error allocating image memory",
+	shVkError(
+		shCreateBuffer(
+			device,
+			(uint32_t)arena_size,
+			usage,
+			VK_SHARING_MODE_EXCLUSIVE,
+			&arena.buffer
+		) == 0,
+		"failed creating uniform arena buffer",
 		return 0
 	);
 
-	return 1;
-}
+	shVkError(
+		shAllocateBufferMemory(
+			device,
+			physical_device,
+			arena.buffer,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+			&arena.memory
+		) == 0,
+		"failed allocating uniform arena memory",
+		vkDestroyBuffer(device, arena.buffer, VK_NULL_HANDLE); return 0
+	);
 
-uint8_t shBindImageMemory(
-	VkDevice       device,
-	VkImage        image,
-	uint32_t       offset,
+	shVkError(
+		shBindBufferMemory(device, arena.buffer, 0, arena.memory) == 0,
+		"failed binding uniform arena memory",
+		vkDestroyBuffer(device, arena.buffer, VK_NULL_HANDLE); vkFreeMemory(device, arena.memory, VK_NULL_HANDLE); return 0
+	);
+
+	shVkResultError(
+		vkMapMemory(device, arena.memory, 0, VK_WHOLE_SIZE, 0, (void**)&arena.p_mapped_data),
+		"error mapping uniform arena memory",
+		vkDestroyBuffer(device, arena.buffer, VK_NULL_HANDLE); vkFreeMemory(device, arena.memory, VK_NULL_HANDLE); return 0
+	);
+
+	(*p_arena) = arena;
+
+	return 1;
+}
+
+uint8_t shUniformArenaBeginFrame(
+	uint32_t          frame_idx,
+	ShVkUniformArena* p_arena
+) {
+	shVkArgError(p_arena   == VK_NULL_HANDLE,       "invalid uniform arena memory", return 0);
+
+	shVkError(frame_idx >= p_arena->frame_count, "invalid arena frame index",    return 0);
+
+	p_arena->frame_idx    = frame_idx;
+	p_arena->frame_offset = 0;
+
+	return 1;
+}
+
+uint8_t shUniformArenaPush(
+	uint32_t          size,
+	void*             p_data,
+	uint32_t*         p_dynamic_offset,
+	ShVkUniformArena* p_arena
+) {
+	shVkArgError(size             == 0,              "invalid data size",             return 0);
+	shVkArgError(p_data           == VK_NULL_HANDLE, "invalid data memory",           return 0);
+	shVkArgError(p_dynamic_offset == VK_NULL_HANDLE, "invalid dynamic offset memory", return 0);
+	shVkArgError(p_arena          == VK_NULL_HANDLE, "invalid uniform arena memory",  return 0);
+
+	shVkError(
+		size > p_arena->max_range,
+		"uniform arena data exceeds the max descriptor range",
+		return 0
+	);
+
+	shVkError(
+		(VkDeviceSize)p_arena->frame_offset + size > p_arena->frame_size,
+		"uniform arena frame region is full",
+		return 0
+	);
+
+	uint32_t dynamic_offset = p_arena->frame_idx * p_arena->frame_size + p_arena->frame_offset;
+
+	memcpy(&p_arena->p_mapped_data[dynamic_offset], p_data, (size_t)size);
+
+	p_arena->frame_offset += (size + p_arena->alignment - 1) / p_arena->alignment * p_arena->alignment;
+
+	(*p_dynamic_offset) = dynamic_offset;
+
+	return 1;
+}
+
+uint8_t shDestroyUniformArena(
+	VkDevice          device,
+	ShVkUniformArena* p_arena
+) {
+	shVkArgError(device  == VK_NULL_HANDLE, "invalid device memory",        return 0);
+	shVkArgError(p_arena == VK_NULL_HANDLE, "invalid uniform arena memory", return 0);
+
+	if (p_arena->p_mapped_data != VK_NULL_HANDLE) {
+		vkUnmapMemory(device, p_arena->memory);
+	}
+
+	shVkError(
+		shClearBufferMemory(device, p_arena->buffer, p_arena->memory) == 0,
+		"failed clearing uniform arena memory",
+		return 0
+	);
+
+	memset(p_arena, 0, sizeof(ShVkUniformArena));
+
+	return 1;
+}
+
+uint8_t shCreateImage(
+	VkDevice              device,
+	VkImageType           type,
+	uint32_t              x,
+	uint32_t              y,
+	uint32_t              z,
+	VkFormat              format,
+	uint32_t              mip_levels,
+	VkSampleCountFlagBits sample_count,
+	VkImageTiling         image_tiling,
+	VkImageUsageFlags     usage,
+	VkSharingMode         sharing_mode,
+	VkImage*              p_image
+) {
+	return shCreateLayeredImage(
+		device, type, x, y, z,
+		1, 0,
+		format, mip_levels, sample_count,
+		image_tiling, usage, sharing_mode,
+		p_image
+	);
+}
+
+uint8_t shCreateLayeredImage(
+	VkDevice              device,
+	VkImageType           type,
+	uint32_t              x,
+	uint32_t              y,
+	uint32_t              z,
+	uint32_t              array_layers,
+	uint8_t               cube_compatible,
+	VkFormat              format,
+	uint32_t              mip_levels,
+	VkSampleCountFlagBits sample_count,
+	VkImageTiling         image_tiling,
+	VkImageUsageFlags     usage,
+	VkSharingMode         sharing_mode,
+	VkImage*              p_image
+) {
+	shVkArgError(device       == VK_NULL_HANDLE, "invalid device memory",   return 0);
+	shVkArgError(x            == 0,              "invalid image x size",    return 0);
+	shVkArgError(y            == 0,              "invalid image y size",    return 0);
+	shVkArgError(z            == 0,              "invalid image z size",    return 0);
+	shVkArgError(array_layers == 0,              "invalid array layers",    return 0);
+	shVkArgError(mip_levels   == 0,              "invalid mip level count", return 0);
+	shVkArgError(sample_count == 0,              "invalid sample count",    return 0);
+	shVkArgError(p_image      == VK_NULL_HANDLE, "invalid image memory",    return 0);
+	shVkArgError(
+		cube_compatible && (type != VK_IMAGE_TYPE_2D || x != y || array_layers % 6 != 0),
+		"cube compatible images must be square 2D images with a multiple of 6 layers",
+		return 0
+	);
+
+	VkExtent3D image_extent = {
+		.width  = x,
+		.height = y,
+		.depth  = z
+	};
+
+	VkImageCreateInfo image_create_info = {
+		.sType                 = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO, //sType;			
+		.pNext                 = VK_NULL_HANDLE,                      //pNext;
+		.flags                 = cube_compatible ?
+		                         VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT : 0, //flags;
+		.imageType             = type,                                //imageType;
+		.format                = format,                              //format;
+		.extent                = image_extent,                        //extent;
+		.mipLevels             = mip_levels,                          //mipLevels;
+		.arrayLayers           = array_layers,                        //arrayLayers;
+		.samples               = sample_count,                        //samples;
+		.tiling                = image_tiling,                        //tiling;
+		.usage                 = usage,                               //usage;
+		.sharingMode           = sharing_mode,                        //sharingMode;
+		.queueFamilyIndexCount = 0,                                   //queueFamilyIndexCount;
+		.pQueueFamilyIndices   = VK_NULL_HANDLE                       //pQueueFamilyIndices;
+	};
+
+	shVkResultError(
+		vkCreateImage(device, &image_create_info, VK_NULL_HANDLE, p_image),
+		"error creating image", 
+		return 0
+	);
+
+	return 1;
+}
+
+uint8_t shAllocateImageMemory(
+	VkDevice              device,
+	VkPhysicalDevice      physical_device,
+	VkImage               image,
+	VkMemoryPropertyFlags memory_property_flags,
+	VkDeviceMemory*       p_image_memory
+) {
+	shVkArgError(device          == VK_NULL_HANDLE, "invalid device memory",    return 0);
+	shVkArgError(physical_device == VK_NULL_HANDLE, "invalid physical device ", return 0);
+	shVkArgError(image           == VK_NULL_HANDLE, "invalid image",            return 0);
+	shVkArgError(p_image_memory  == VK_NULL_HANDLE, "invalid image memory",     return 0);
+
+	VkMemoryRequirements memory_requirements = { 0 };
+	vkGetImageMemoryRequirements(device, image, &memory_requirements);
+
+	uint32_t memory_type_index = 0;
+	shVkError(
+		shGetMemoryType(device, physical_device, memory_property_flags, &memory_type_index) == 0,
+		"failed detecting memory type",
+		return 0
+	);
+
+	VkMemoryAllocateInfo memory_allocate_info = {
+		.sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+		.pNext           = VK_NULL_HANDLE,
+		.allocationSize  = memory_requirements.size,
+		.memoryTypeIndex = memory_type_index
+	};
+
+	shVkResultError(
+		vkAllocateMemory(device, &memory_allocate_info, VK_NULL_HANDLE, p_image_memory),
+		"error allocating image memory",
+		return 0
+	);
+
+	return 1;
+}
+
+uint8_t shBindImageMemory(
+	VkDevice       device,
+	VkImage        image,
+	uint32_t       offset,
 	VkDeviceMemory image_memory
 ) {
-	shVkError(device       == VK_NULL_HANDLE, "invalid device memory", return 0);
-	shVkError(image        == VK_NULL_HANDLE, "invalid image",         return 0);
-	shVkError(image_memory == VK_NULL_HANDLE, "invalid image memory",  return 0);
+	shVkArgError(device       == VK_NULL_HANDLE, "invalid device memory", return 0);
+	shVkArgError(image        == VK_NULL_HANDLE, "invalid image",         return 0);
+	shVkArgError(image_memory == VK_NULL_HANDLE, "invalid image memory",  return 0);
 
 	shVkResultError(
 		vkBindImageMemory(device, image, image_memory, offset),
@@ -2599,9 +4325,9 @@ uint8_t shClearImageMemory(
 	VkImage        image,
 	VkDeviceMemory image_memory
 ) {
-	shVkError(device       == VK_NULL_HANDLE, "invalid device memory", return 0);
-	shVkError(image        == VK_NULL_HANDLE, "invalid image",         return 0);
-	shVkError(image_memory == VK_NULL_HANDLE, "invalid image memory",  return 0);
+	shVkArgError(device       == VK_NULL_HANDLE, "invalid device memory", return 0);
+	shVkArgError(image        == VK_NULL_HANDLE, "invalid image",         return 0);
+	shVkArgError(image_memory == VK_NULL_HANDLE, "invalid image memory",  return 0);
 
 	shVkResultError(
 		vkDeviceWaitIdle(device),
@@ -2653,8 +4379,8 @@ uint8_t shSetBufferMemoryBarrier(
 	VkPipelineStageFlags pipeline_stage_before_barrier,
 	VkPipelineStageFlags pipeline_stage_after_barrier
 ) {
-	shVkError(device == VK_NULL_HANDLE, "invalid device memory", return 0);
-	shVkError(buffer == VK_NULL_HANDLE, "invalid buffer memory", return 0);
+	shVkArgError(device == VK_NULL_HANDLE, "invalid device memory", return 0);
+	shVkArgError(buffer == VK_NULL_HANDLE, "invalid buffer memory", return 0);
 
 	VkBufferMemoryBarrier barrier = {
 		.sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
@@ -2698,9 +4424,6 @@ uint8_t shSetImageMemoryBarrier(
 	VkPipelineStageFlags pipeline_stage_before_barrier,
 	VkPipelineStageFlags pipeline_stage_after_barrier
 ) {
-	shVkError(device == VK_NULL_HANDLE, "invalid device memory", return 0);
-	shVkError(image  == VK_NULL_HANDLE, "invalid image memory",  return 0);
-
 	VkImageSubresourceRange subresouce_range = {
 		.aspectMask     = image_aspect_mask,
 		.baseMipLevel   = 0,
@@ -2708,7 +4431,33 @@ uint8_t shSetImageMemoryBarrier(
 		.baseArrayLayer = 0,
 		.layerCount     = 1
 	};
-	
+
+	return shSetImageSubresourceMemoryBarrier(
+		device, cmd_buffer, image, subresouce_range,
+		access_before_barrier, access_after_barrier,
+		image_layout_before_barrier, image_layout_after_barrier,
+		performing_queue_family_index_before_barrier, performing_queue_family_index_after_barrier,
+		pipeline_stage_before_barrier, pipeline_stage_after_barrier
+	);
+}
+
+uint8_t shSetImageSubresourceMemoryBarrier(
+	VkDevice                device,
+	VkCommandBuffer         cmd_buffer,
+	VkImage                 image,
+	VkImageSubresourceRange subresource_range,
+	VkAccessFlags           access_before_barrier,
+	VkAccessFlags           access_after_barrier,
+	VkImageLayout           image_layout_before_barrier,
+	VkImageLayout           image_layout_after_barrier,
+	uint32_t                performing_queue_family_index_before_barrier,
+	uint32_t                performing_queue_family_index_after_barrier,
+	VkPipelineStageFlags    pipeline_stage_before_barrier,
+	VkPipelineStageFlags    pipeline_stage_after_barrier
+) {
+	shVkArgError(device == VK_NULL_HANDLE, "invalid device memory", return 0);
+	shVkArgError(image  == VK_NULL_HANDLE, "invalid image memory",  return 0);
+
 	VkImageMemoryBarrier barrier = {
 		.sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
 		.pNext               = NULL,
@@ -2719,7 +4468,7 @@ uint8_t shSetImageMemoryBarrier(
 		.srcQueueFamilyIndex = performing_queue_family_index_before_barrier,
 		.dstQueueFamilyIndex = performing_queue_family_index_after_barrier,
 		.image               = image,
-		.subresourceRange    = subresouce_range
+		.subresourceRange    = subresource_range
 	};
 	
 	vkCmdPipelineBarrier(
@@ -2738,12 +4487,115 @@ uint8_t shSetImageMemoryBarrier(
 	return 1;
 }
 
+uint8_t shReleaseBufferOwnership(
+	VkDevice             device,
+	VkCommandBuffer      cmd_buffer,
+	VkBuffer             buffer,
+	VkAccessFlags        src_access,
+	VkPipelineStageFlags src_pipeline_stage,
+	uint32_t             src_queue_family_index,
+	uint32_t             dst_queue_family_index
+) {
+	if (src_queue_family_index == dst_queue_family_index) {
+		return 1;
+	}
+
+	return shSetBufferMemoryBarrier(
+		device, cmd_buffer, buffer,
+		src_access, 0,
+		src_queue_family_index, dst_queue_family_index,
+		src_pipeline_stage, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT
+	);
+}
+
+uint8_t shAcquireBufferOwnership(
+	VkDevice             device,
+	VkCommandBuffer      cmd_buffer,
+	VkBuffer             buffer,
+	VkAccessFlags        dst_access,
+	VkPipelineStageFlags dst_pipeline_stage,
+	uint32_t             src_queue_family_index,
+	uint32_t             dst_queue_family_index
+) {
+	if (src_queue_family_index == dst_queue_family_index) {
+		return 1;
+	}
+
+	return shSetBufferMemoryBarrier(
+		device, cmd_buffer, buffer,
+		0, dst_access,
+		src_queue_family_index, dst_queue_family_index,
+		VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, dst_pipeline_stage
+	);
+}
+
+uint8_t shReleaseImageOwnership(
+	VkDevice                device,
+	VkCommandBuffer         cmd_buffer,
+	VkImage                 image,
+	VkImageSubresourceRange subresource_range,
+	VkAccessFlags           src_access,
+	VkPipelineStageFlags    src_pipeline_stage,
+	VkImageLayout           image_layout_before_transfer,
+	VkImageLayout           image_layout_after_transfer,
+	uint32_t                src_queue_family_index,
+	uint32_t                dst_queue_family_index
+) {
+	if (src_queue_family_index == dst_queue_family_index) {
+		return 1;
+	}
+
+	return shSetImageSubresourceMemoryBarrier(
+		device, cmd_buffer, image, subresource_range,
+		src_access, 0,
+		image_layout_before_transfer, image_layout_after_transfer,
+		src_queue_family_index, dst_queue_family_index,
+		src_pipeline_stage, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT
+	);
+}
+
+uint8_t shAcquireImageOwnership(
+	VkDevice                device,
+	VkCommandBuffer         cmd_buffer,
+	VkImage                 image,
+	VkImageSubresourceRange subresource_range,
+	VkAccessFlags           src_access,
+	VkPipelineStageFlags    src_pipeline_stage,
+	VkAccessFlags           dst_access,
+	VkPipelineStageFlags    dst_pipeline_stage,
+	VkImageLayout           image_layout_before_transfer,
+	VkImageLayout           image_layout_after_transfer,
+	uint32_t                src_queue_family_index,
+	uint32_t                dst_queue_family_index
+) {
+	if (src_queue_family_index == dst_queue_family_index) {
+		if (image_layout_before_transfer == image_layout_after_transfer) {
+			return 1;
+		}
+		return shSetImageSubresourceMemoryBarrier(
+			device, cmd_buffer, image, subresource_range,
+			src_access, dst_access,
+			image_layout_before_transfer, image_layout_after_transfer,
+			VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED,
+			src_pipeline_stage, dst_pipeline_stage
+		);
+	}
+
+	return shSetImageSubresourceMemoryBarrier(
+		device, cmd_buffer, image, subresource_range,
+		0, dst_access,
+		image_layout_before_transfer, image_layout_after_transfer,
+		src_queue_family_index, dst_queue_family_index,
+		VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, dst_pipeline_stage
+	);
+}
+
 uint8_t shGetMemoryBudgetProperties(
 	VkPhysicalDevice                           physical_device,
 	VkPhysicalDeviceMemoryBudgetPropertiesEXT* p_memory_budget_properties
 ) {
-	shVkError(physical_device            == VK_NULL_HANDLE, "invalid physical device memory",          return 0);
-	shVkError(p_memory_budget_properties == VK_NULL_HANDLE, "invalid memory budget properties memory", return 0);
+	shVkArgError(physical_device            == VK_NULL_HANDLE, "invalid physical device memory",          return 0);
+	shVkArgError(p_memory_budget_properties == VK_NULL_HANDLE, "invalid memory budget properties memory", return 0);
 
 
 	VkPhysicalDeviceMemoryBudgetPropertiesEXT memory_budget_properties = {
@@ -2772,36 +4624,6 @@ uint8_t shGetMemoryBudgetProperties(
 	return 1;
 }
 
-uint8_t shBindVertexBuffers(
-	VkCommandBuffer graphics_cmd_buffer,
-	uint32_t        first_binding,
-	uint32_t        binding_count,
-	VkBuffer*       p_vertex_buffers,
-	VkDeviceSize*   p_vertex_offsets
-) {
-	shVkError(graphics_cmd_buffer == VK_NULL_HANDLE, "invalid command buffer memory", return 0);
-	shVkError(binding_count       == 0,    "invalid binding count",         return 0);
-	shVkError(p_vertex_buffers    == VK_NULL_HANDLE, "invalid vertex buffers memory", return 0);
-	shVkError(p_vertex_offsets    == VK_NULL_HANDLE, "invalid vertex offsets memory", return 0);
-
-	vkCmdBindVertexBuffers(graphics_cmd_buffer, first_binding, binding_count, p_vertex_buffers, p_vertex_offsets);
-
-	return 1;
-}
-
-uint8_t shBindIndexBuffer(
-	VkCommandBuffer graphics_cmd_buffer,
-	uint32_t        index_offset,
-	VkBuffer        index_buffer
-) {
-	shVkError(graphics_cmd_buffer == VK_NULL_HANDLE, "invalid command buffer memory", return 0);
-	shVkError(index_buffer        == VK_NULL_HANDLE, "invalid index buffer memory",   return 0);
-
-	vkCmdBindIndexBuffer(graphics_cmd_buffer, index_buffer, index_offset, VK_INDEX_TYPE_UINT32);
-	
-	return 1;
-}
-
 
 
 uint8_t shSetVertexBinding(
@@ -2810,7 +4632,7 @@ uint8_t shSetVertexBinding(
 	VkVertexInputRate                  input_rate,
 	VkVertexInputBindingDescription*   p_vertex_input_binding
 ) {
-	shVkError(p_vertex_input_binding == VK_NULL_HANDLE, "invalid vertex input binding memory", return 0);
+	shVkArgError(p_vertex_input_binding == VK_NULL_HANDLE, "invalid vertex input binding memory", return 0);
 
 	VkVertexInputBindingDescription vertex_input_binding = {
 		.binding   = binding,
@@ -2830,7 +4652,7 @@ uint8_t shSetVertexAttribute(
 	uint32_t                           offset,
 	VkVertexInputAttributeDescription* p_vertex_input_attribute
 ) {
-	shVkError(p_vertex_input_attribute == VK_NULL_HANDLE, "invalid vertex input attribute memory", return 0);
+	shVkArgError(p_vertex_input_attribute == VK_NULL_HANDLE, "invalid vertex input attribute memory", return 0);
 	
 	VkVertexInputAttributeDescription vertex_input_attribute = {
 		.location = location,
@@ -2871,7 +4693,7 @@ uint8_t shCreateInputAssembly(
 	VkBool32                                primitive_restart_enable, 
 	VkPipelineInputAssemblyStateCreateInfo* p_input_assembly
 ) {
-	shVkError(p_input_assembly == VK_NULL_HANDLE, "invalid input assembly state memory", return 0);
+	shVkArgError(p_input_assembly == VK_NULL_HANDLE, "invalid input assembly state memory", return 0);
 
 	VkPipelineInputAssemblyStateCreateInfo input_assembly_state = {
 		.sType                  = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO, //sType;
@@ -2891,7 +4713,7 @@ uint8_t shCreateRasterizer(
 	VkCullModeFlagBits                      cull_mode,
 	VkPipelineRasterizationStateCreateInfo* p_rasterizer
 ) {
-	shVkError(p_rasterizer == VK_NULL_HANDLE, "invalid rasterizer memory", return 0);
+	shVkArgError(p_rasterizer == VK_NULL_HANDLE, "invalid rasterizer memory", return 0);
 
 	VkPipelineRasterizationStateCreateInfo rasterization_state = {
 		.sType                   = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO, //sType;
@@ -2919,8 +4741,8 @@ uint8_t shSetMultisampleState(
 	float                                 min_sample_shading_size,
 	VkPipelineMultisampleStateCreateInfo* p_multisample_state
 ) {
-	shVkError(sample_count        == 0,    "invalid sample count",             return 0);
-	shVkError(p_multisample_state == VK_NULL_HANDLE, "invalid multisample state memory", return 0);
+	shVkArgError(sample_count        == 0,    "invalid sample count",             return 0);
+	shVkArgError(p_multisample_state == VK_NULL_HANDLE, "invalid multisample state memory", return 0);
 
 	VkBool32 sample_shading_enable = min_sample_shading_size == 0.0f ? VK_FALSE : VK_TRUE;
 
@@ -2954,13 +4776,13 @@ uint8_t shSetViewport(
 	VkRect2D*                          p_scissors, 
 	VkPipelineViewportStateCreateInfo* p_viewport_state
 ) {
-	shVkError(viewport_width   == 0,              "invalid viewport width",         return 0);
-	shVkError(viewport_height  == 0,              "invalid viewport height",        return 0);
-	shVkError(p_viewport       == VK_NULL_HANDLE, "invalid viewport memory",        return 0);
-	shVkError(scissors_width   == 0,              "invalid scissors width",         return 0);
-	shVkError(scissors_height  == 0,              "invalid scissors height",        return 0);
-	shVkError(p_scissors       == VK_NULL_HANDLE, "invalid scissors memory",        return 0);
-	shVkError(p_viewport_state == VK_NULL_HANDLE, "invalid viewport state pointer", return 0);
+	shVkArgError(viewport_width   == 0,              "invalid viewport width",         return 0);
+	shVkArgError(viewport_height  == 0,              "invalid viewport height",        return 0);
+	shVkArgError(p_viewport       == VK_NULL_HANDLE, "invalid viewport memory",        return 0);
+	shVkArgError(scissors_width   == 0,              "invalid scissors width",         return 0);
+	shVkArgError(scissors_height  == 0,              "invalid scissors height",        return 0);
+	shVkArgError(p_scissors       == VK_NULL_HANDLE, "invalid scissors memory",        return 0);
+	shVkArgError(p_viewport_state == VK_NULL_HANDLE, "invalid viewport state pointer", return 0);
 
 	VkViewport viewport = {
 		.x        = (float)viewport_pos_x,  //x; 
@@ -3002,8 +4824,8 @@ uint8_t shColorBlendSettings(
 	VkPipelineColorBlendAttachmentState* p_color_blend_attachment_states, 
 	VkPipelineColorBlendStateCreateInfo* p_color_blend_state
 ) {
-	shVkError(p_color_blend_attachment_states == VK_NULL_HANDLE, "invalid color blend attachment states memory", return 0);
-	shVkError(p_color_blend_state             == VK_NULL_HANDLE, "invalid color blend state memory",             return 0);
+	shVkArgError(p_color_blend_attachment_states == VK_NULL_HANDLE, "invalid color blend attachment states memory", return 0);
+	shVkArgError(p_color_blend_state             == VK_NULL_HANDLE, "invalid color blend state memory",             return 0);
 	
 	VkPipelineColorBlendAttachmentState color_blend_attachment_state = {
 		.blendEnable         = VK_FALSE,                  //blendEnable;
@@ -3059,10 +4881,10 @@ uint8_t shCreateShaderModule(
 	char*           code,
 	VkShaderModule* p_shader_module
 ) {
-	shVkError(device          == VK_NULL_HANDLE, "invalid device memory",             return 0);
-	shVkError(size            == 0,    "invalid shader module size",        return 0);
-	shVkError(code            == VK_NULL_HANDLE, "invalid shader module code memory", return 0);
-	shVkError(p_shader_module == VK_NULL_HANDLE, "invalid shader module memory",      return 0);
+	shVkArgError(device          == VK_NULL_HANDLE, "invalid device memory",             return 0);
+	shVkArgError(size            == 0,    "invalid shader module size",        return 0);
+	shVkArgError(code            == VK_NULL_HANDLE, "invalid shader module code memory", return 0);
+	shVkArgError(p_shader_module == VK_NULL_HANDLE, "invalid shader module memory",      return 0);
 
 	VkShaderModuleCreateInfo shader_module_create_info = {
 		.sType    = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO, //sType;
@@ -3085,7 +4907,7 @@ uint8_t shCreateShaderStage(
 	VkShaderStageFlags               shader_stage_flag, 
 	VkPipelineShaderStageCreateInfo* p_shader_stage
 ) {
-	shVkError(p_shader_stage == VK_NULL_HANDLE, "invalid shader stage memory", return 0);
+	shVkArgError(p_shader_stage == VK_NULL_HANDLE, "invalid shader stage memory", return 0);
 
 	VkPipelineShaderStageCreateInfo shader_stage_create_info = {
 		.sType               = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO, //sType;
@@ -3108,8 +4930,8 @@ uint8_t shSetPushConstants(
 	uint32_t             size, 
 	VkPushConstantRange* p_push_constant_range
 ) {
-	shVkError(size                  == 0,              "invalid push constant size",         return 0);
-	shVkError(p_push_constant_range == VK_NULL_HANDLE, "invalid push constant range memory", return 0);
+	shVkArgError(size                  == 0,              "invalid push constant size",         return 0);
+	shVkArgError(p_push_constant_range == VK_NULL_HANDLE, "invalid push constant range memory", return 0);
 	
 	VkPushConstantRange push_constant_range = {
 		.stageFlags = shader_stage, //stageFlags;
@@ -3130,8 +4952,8 @@ uint8_t shCreateDescriptorSetLayoutBinding(
 	VkShaderStageFlags            shader_stage,
 	VkDescriptorSetLayoutBinding* p_binding
 ) {
-	shVkError(descriptor_set_count == 0,              "invalid descriptor set count",                 return 0);
-	shVkError(p_binding            == VK_NULL_HANDLE, "invalid descriptor set layout binding memory", return 0);
+	shVkArgError(descriptor_set_count == 0,              "invalid descriptor set count",                 return 0);
+	shVkArgError(p_binding            == VK_NULL_HANDLE, "invalid descriptor set layout binding memory", return 0);
 
 	VkDescriptorSetLayoutBinding descriptor_set_layout_binding = {
 		.binding            = binding,              //binding;
@@ -3147,19 +4969,20 @@ uint8_t shCreateDescriptorSetLayoutBinding(
 }
 
 uint8_t shCreateDescriptorSetLayout(
-	VkDevice                      device, 
-	uint32_t                      binding_count,
-	VkDescriptorSetLayoutBinding* p_bindings, 
-	VkDescriptorSetLayout*        p_descriptor_set_layout
+	VkDevice                         device, 
+	uint32_t                         binding_count,
+	VkDescriptorSetLayoutBinding*    p_bindings, 
+	VkDescriptorSetLayoutCreateFlags flags,
+	VkDescriptorSetLayout*           p_descriptor_set_layout
 ) {
-	shVkError(device                  == VK_NULL_HANDLE, "invalid device memory",                         return 0);
-	shVkError(p_bindings              == VK_NULL_HANDLE, "invalid descriptor set layout bindings memory", return 0);
-	shVkError(p_descriptor_set_layout == VK_NULL_HANDLE, "invalid descriptor set layout memory",          return 0);
+	shVkArgError(device                  == VK_NULL_HANDLE, "invalid device memory",                         return 0);
+	shVkArgError(p_bindings              == VK_NULL_HANDLE, "invalid descriptor set layout bindings memory", return 0);
+	shVkArgError(p_descriptor_set_layout == VK_NULL_HANDLE, "invalid descriptor set layout memory",          return 0);
 
 	VkDescriptorSetLayoutCreateInfo descriptor_set_layout_create_info = {
 		.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO, //sType;
 		.pNext        = VK_NULL_HANDLE,                                      //pNext;
-		.flags        = 0,                                                   //flags;
+		.flags        = flags,                                               //flags;
 		.bindingCount = binding_count,                                       //bindingCount;
 		.pBindings    = p_bindings                                           //pBindings;
 	};
@@ -3178,10 +5001,10 @@ uint8_t shCreateDescriptorPool(
 	VkDescriptorPoolSize* p_pool_sizes,
 	VkDescriptorPool*     p_descriptor_pool
 ) {
-	shVkError(device            == VK_NULL_HANDLE, "invalid device memory",                return 0);
-	shVkError(pool_size_count   == 0,              "invalid descriptor pool size count",   return 0);
-	shVkError(p_pool_sizes      == VK_NULL_HANDLE, "invalid descriptor pool sizes memory", return 0);
-	shVkError(p_descriptor_pool == VK_NULL_HANDLE, "invalid descriptor pool memory",       return 0);
+	shVkArgError(device            == VK_NULL_HANDLE, "invalid device memory",                return 0);
+	shVkArgError(pool_size_count   == 0,              "invalid descriptor pool size count",   return 0);
+	shVkArgError(p_pool_sizes      == VK_NULL_HANDLE, "invalid descriptor pool sizes memory", return 0);
+	shVkArgError(p_descriptor_pool == VK_NULL_HANDLE, "invalid descriptor pool memory",       return 0);
 	
 	uint32_t max_sets = 0;
 
@@ -3212,9 +5035,9 @@ uint8_t shSetDescriptorBufferInfo(
 	uint32_t                buffer_size, 
 	VkDescriptorBufferInfo* p_buffer_info
 ) {
-	shVkError(buffer        == VK_NULL_HANDLE, "invalid descriptor set buffer memory",      return 0);
-	shVkError(buffer_size   == 0,              "invalid buffer size",                       return 0);
-	shVkError(p_buffer_info == VK_NULL_HANDLE, "invalid descriptor set buffer info memory", return 0);
+	shVkArgError(buffer        == VK_NULL_HANDLE, "invalid descriptor set buffer memory",      return 0);
+	shVkArgError(buffer_size   == 0,              "invalid buffer size",                       return 0);
+	shVkArgError(p_buffer_info == VK_NULL_HANDLE, "invalid descriptor set buffer info memory", return 0);
 
 	VkDescriptorBufferInfo buffer_info = {
 		.buffer = buffer,        //buffer;
@@ -3227,6 +5050,31 @@ uint8_t shSetDescriptorBufferInfo(
 	return 1;
 }
 
+uint8_t shSetDescriptorImageInfo(
+	VkSampler              sampler,
+	VkImageView            image_view,
+	VkImageLayout          image_layout,
+	VkDescriptorImageInfo* p_image_info
+) {
+	shVkArgError(p_image_info == VK_NULL_HANDLE, "invalid descriptor image info memory", return 0);
+
+	shVkArgError(
+		sampler == VK_NULL_HANDLE && image_view == VK_NULL_HANDLE,
+		"invalid descriptor sampler and image view memory",
+		return 0
+	);
+
+	VkDescriptorImageInfo image_info = {
+		.sampler     = sampler,     //sampler;
+		.imageView   = image_view,  //imageView;
+		.imageLayout = image_layout //imageLayout;
+	};
+
+	(*p_image_info) = image_info;
+
+	return 1;
+}
+
 uint8_t shAllocateDescriptorSetUnits(
 	VkDevice                device, 
 	VkDescriptorPool        descriptor_pool,
@@ -3236,15 +5084,36 @@ uint8_t shAllocateDescriptorSetUnits(
 	VkDescriptorSetLayout*  p_descriptor_set_layouts, 
 	VkDescriptorSet*        p_descriptor_sets, 
 	VkDescriptorBufferInfo* p_buffer_infos, 
+	VkDescriptorImageInfo*  p_image_infos,
 	VkWriteDescriptorSet*   p_write_descriptor_sets
 ) {
-	shVkError(device                    == VK_NULL_HANDLE, "invalid device memory",                  return 0);
-	shVkError(descriptor_pool           == VK_NULL_HANDLE, "invalid descriptor pool memory",         return 0);
-	shVkError(descriptor_set_unit_count == 0,              "invalid descriptor set unit count",      return 0);
-	shVkError(p_descriptor_set_layouts  == VK_NULL_HANDLE, "invalid descriptor set layouts memory",  return 0);
-	shVkError(p_buffer_infos            == VK_NULL_HANDLE, "invalid descriptor buffer infos memory", return 0);
-	shVkError(p_descriptor_sets         == VK_NULL_HANDLE, "invalid descriptor sets memory",         return 0);
-	shVkError(p_write_descriptor_sets   == VK_NULL_HANDLE, "invalid write descriptor sets memory",   return 0);
+	shVkArgError(device                    == VK_NULL_HANDLE, "invalid device memory",                  return 0);
+	shVkArgError(descriptor_pool           == VK_NULL_HANDLE, "invalid descriptor pool memory",         return 0);
+	shVkArgError(descriptor_set_unit_count == 0,              "invalid descriptor set unit count",      return 0);
+	shVkArgError(p_descriptor_set_layouts  == VK_NULL_HANDLE, "invalid descriptor set layouts memory",  return 0);
+	shVkArgError(p_descriptor_sets         == VK_NULL_HANDLE, "invalid descriptor sets memory",         return 0);
+	shVkArgError(p_write_descriptor_sets   == VK_NULL_HANDLE, "invalid write descriptor sets memory",   return 0);
+
+	ShVkDescriptorInfoType info_type = SH_DESCRIPTOR_INFO_TYPE_BUFFER;
+	if (shGetDescriptorInfoType(descriptor_type, &info_type) == 0) {
+		return 0;
+	}
+
+	shVkError(
+		info_type == SH_DESCRIPTOR_INFO_TYPE_TEXEL_BUFFER,
+		"texel buffer descriptors are not supported by descriptor set units",
+		return 0
+	);
+	shVkError(
+		info_type == SH_DESCRIPTOR_INFO_TYPE_BUFFER && p_buffer_infos == VK_NULL_HANDLE,
+		"invalid descriptor buffer infos memory",
+		return 0
+	);
+	shVkError(
+		info_type == SH_DESCRIPTOR_INFO_TYPE_IMAGE && p_image_infos == VK_NULL_HANDLE,
+		"invalid descriptor image infos memory",
+		return 0
+	);
 
 	VkDescriptorSetAllocateInfo descriptor_set_allocate_info = {
 		.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO, //sType;
@@ -3268,46 +5137,232 @@ uint8_t shAllocateDescriptorSetUnits(
 			.descriptorCount  = 1,                                      //descriptorCount;
 			.descriptorType   = descriptor_type,                        //descriptorType
 			.pImageInfo       = VK_NULL_HANDLE,                         //pImageInfo;
-			.pBufferInfo      = &p_buffer_infos[set_unit_idx],          //pBufferInfo;
+			.pBufferInfo      = VK_NULL_HANDLE,                         //pBufferInfo;
 			.pTexelBufferView = VK_NULL_HANDLE							//pTexelBufferView;
 		};
+		if (info_type == SH_DESCRIPTOR_INFO_TYPE_IMAGE) {
+			write_descriptor_set.pImageInfo = &p_image_infos[set_unit_idx];
+		}
+		else {
+			write_descriptor_set.pBufferInfo = &p_buffer_infos[set_unit_idx];
+		}
 		p_write_descriptor_sets[set_unit_idx] = write_descriptor_set;
 	}
 
 	return 1;
 }
 
-uint8_t shCreatePipelineLayout(
-	VkDevice               device,
-	uint32_t               push_constant_range_count,
-	VkPushConstantRange*   p_push_constants_range,
-	uint32_t               src_descriptor_set_layout_count,
-	VkDescriptorSetLayout* p_src_descriptor_set_layouts,
-	VkPipelineLayout*      p_pipeline_layout
+uint8_t shGetDescriptorInfoType(
+	VkDescriptorType        descriptor_type,
+	ShVkDescriptorInfoType* p_info_type
 ) {
-	shVkError(device            == VK_NULL_HANDLE, "invalid device memory",          return 0);
-	shVkError(p_pipeline_layout == VK_NULL_HANDLE, "invalid pipeline layout memory", return 0);
-	
-	shVkError(
-		push_constant_range_count != 0 && p_push_constants_range == VK_NULL_HANDLE, 
-		"invalid push constants range memory", 
-		return 0
-	);
+	shVkArgError(p_info_type == VK_NULL_HANDLE, "invalid descriptor info type memory", return 0);
+
+	switch (descriptor_type) {
+	case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+	case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+	case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
+	case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC:
+		(*p_info_type) = SH_DESCRIPTOR_INFO_TYPE_BUFFER;
+		return 1;
+	case VK_DESCRIPTOR_TYPE_SAMPLER:
+	case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+	case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+	case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+	case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:
+		(*p_info_type) = SH_DESCRIPTOR_INFO_TYPE_IMAGE;
+		return 1;
+	case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
+	case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
+		(*p_info_type) = SH_DESCRIPTOR_INFO_TYPE_TEXEL_BUFFER;
+		return 1;
+	default:
+		break;
+	}
 
-	shVkError(
-		src_descriptor_set_layout_count != 0 && p_src_descriptor_set_layouts == VK_NULL_HANDLE,
-		"invalid src descriptor set layouts memory", 
-		return 0
-	);
+	shVkError(1, "unsupported descriptor type", return 0);
 
+	return 0;
+}
 
-	VkPipelineLayoutCreateInfo pipeline_layout_create_info = {
-		.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO, //sType;
-		.pNext                  = VK_NULL_HANDLE,                                //pNext;
-		.flags                  = 0,                                             //flags;
-		.setLayoutCount         = src_descriptor_set_layout_count,               //setLayoutCount;
-		.pSetLayouts            = p_src_descriptor_set_layouts,                  //pSetLayouts;
-		.pushConstantRangeCount = push_constant_range_count,                     //pushConstantRangeCount;
+uint8_t shGetDescriptorInfoSize(
+	VkDescriptorType descriptor_type,
+	uint32_t*        p_size
+) {
+	shVkArgError(p_size == VK_NULL_HANDLE, "invalid size memory", return 0);
+
+	ShVkDescriptorInfoType info_type = SH_DESCRIPTOR_INFO_TYPE_BUFFER;
+	if (shGetDescriptorInfoType(descriptor_type, &info_type) == 0) {
+		return 0;
+	}
+
+	switch (info_type) {
+	case SH_DESCRIPTOR_INFO_TYPE_BUFFER:
+		(*p_size) = (uint32_t)sizeof(VkDescriptorBufferInfo);
+		break;
+	case SH_DESCRIPTOR_INFO_TYPE_IMAGE:
+		(*p_size) = (uint32_t)sizeof(VkDescriptorImageInfo);
+		break;
+	case SH_DESCRIPTOR_INFO_TYPE_TEXEL_BUFFER:
+		(*p_size) = (uint32_t)sizeof(VkBufferView);
+		break;
+	}
+
+	return 1;
+}
+
+uint8_t shCreateDescriptorUpdateTemplateEntry(
+	uint32_t                         binding,
+	uint32_t                         array_element,
+	uint32_t                         descriptor_count,
+	VkDescriptorType                 descriptor_type,
+	uint32_t                         offset,
+	uint32_t                         stride,
+	VkDescriptorUpdateTemplateEntry* p_entry
+) {
+	shVkArgError(descriptor_count == 0,              "invalid descriptor count",                       return 0);
+	shVkArgError(p_entry          == VK_NULL_HANDLE, "invalid descriptor update template entry memory", return 0);
+
+	VkDescriptorUpdateTemplateEntry entry = {
+		.dstBinding      = binding,          //dstBinding;
+		.dstArrayElement = array_element,    //dstArrayElement;
+		.descriptorCount = descriptor_count, //descriptorCount;
+		.descriptorType  = descriptor_type,  //descriptorType;
+		.offset          = offset,           //offset;
+		.stride          = stride            //stride;
+	};
+
+	(*p_entry) = entry;
+
+	return 1;
+}
+
+uint8_t shCreateDescriptorUpdateTemplate(
+	VkDevice                         device,
+	uint32_t                         entry_count,
+	VkDescriptorUpdateTemplateEntry* p_entries,
+	VkDescriptorSetLayout            descriptor_set_layout,
+	VkDescriptorUpdateTemplate*      p_descriptor_update_template
+) {
+	shVkArgError(device                       == VK_NULL_HANDLE, "invalid device memory",                            return 0);
+	shVkArgError(entry_count                  == 0,              "invalid descriptor update template entry count",   return 0);
+	shVkArgError(p_entries                    == VK_NULL_HANDLE, "invalid descriptor update template entries memory", return 0);
+	shVkArgError(descriptor_set_layout        == VK_NULL_HANDLE, "invalid descriptor set layout memory",             return 0);
+	shVkArgError(p_descriptor_update_template == VK_NULL_HANDLE, "invalid descriptor update template memory",        return 0);
+
+	VkDescriptorUpdateTemplateCreateInfo descriptor_update_template_create_info = {
+		.sType                      = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO, //sType;
+		.pNext                      = VK_NULL_HANDLE,                                           //pNext;
+		.flags                      = 0,                                                        //flags;
+		.descriptorUpdateEntryCount = entry_count,                                              //descriptorUpdateEntryCount;
+		.pDescriptorUpdateEntries   = p_entries,                                                //pDescriptorUpdateEntries;
+		.templateType               = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET,        //templateType;
+		.descriptorSetLayout        = descriptor_set_layout,                                    //descriptorSetLayout;
+		.pipelineBindPoint          = VK_PIPELINE_BIND_POINT_GRAPHICS,                          //pipelineBindPoint;
+		.pipelineLayout             = VK_NULL_HANDLE,                                           //pipelineLayout;
+		.set                        = 0                                                         //set;
+	};
+
+	shVkResultError(
+		vkCreateDescriptorUpdateTemplate(device, &descriptor_update_template_create_info, VK_NULL_HANDLE, p_descriptor_update_template),
+		"error creating descriptor update template", return 0
+	);
+
+	return 1;
+}
+
+uint8_t shUpdateDescriptorSetWithTemplate(
+	VkDevice                   device,
+	VkDescriptorSet            descriptor_set,
+	VkDescriptorUpdateTemplate descriptor_update_template,
+	void*                      p_data
+) {
+	shVkArgError(device                     == VK_NULL_HANDLE, "invalid device memory",                     return 0);
+	shVkArgError(descriptor_set             == VK_NULL_HANDLE, "invalid descriptor set memory",             return 0);
+	shVkArgError(descriptor_update_template == VK_NULL_HANDLE, "invalid descriptor update template memory", return 0);
+	shVkArgError(p_data                     == VK_NULL_HANDLE, "invalid descriptor data memory",            return 0);
+
+	vkUpdateDescriptorSetWithTemplate(device, descriptor_set, descriptor_update_template, p_data);
+
+	return 1;
+}
+
+uint8_t shGetPushDescriptorSetFunction(
+	VkDevice                       device,
+	PFN_vkCmdPushDescriptorSetKHR* p_cmd_push_descriptor_set
+) {
+	shVkArgError(device                    == VK_NULL_HANDLE, "invalid device memory",                   return 0);
+	shVkArgError(p_cmd_push_descriptor_set == VK_NULL_HANDLE, "invalid push descriptor function memory", return 0);
+
+	(*p_cmd_push_descriptor_set) = (PFN_vkCmdPushDescriptorSetKHR)vkGetDeviceProcAddr(device, "vkCmdPushDescriptorSetKHR");
+
+	shVkError(
+		(*p_cmd_push_descriptor_set) == VK_NULL_HANDLE,
+		"failed loading vkCmdPushDescriptorSetKHR, is VK_KHR_push_descriptor enabled?",
+		return 0
+	);
+
+	return 1;
+}
+
+uint8_t shPushDescriptorSet(
+	VkCommandBuffer               cmd_buffer,
+	PFN_vkCmdPushDescriptorSetKHR cmd_push_descriptor_set,
+	VkPipelineBindPoint           bind_point,
+	VkPipelineLayout              pipeline_layout,
+	uint32_t                      set,
+	uint32_t                      write_descriptor_set_count,
+	VkWriteDescriptorSet*         p_write_descriptor_sets
+) {
+	shVkArgError(cmd_buffer                 == VK_NULL_HANDLE, "invalid command buffer memory",           return 0);
+	shVkArgError(cmd_push_descriptor_set    == VK_NULL_HANDLE, "invalid push descriptor function memory", return 0);
+	shVkArgError(pipeline_layout            == VK_NULL_HANDLE, "invalid pipeline layout memory",          return 0);
+	shVkArgError(write_descriptor_set_count == 0,              "invalid write descriptor set count",      return 0);
+	shVkArgError(p_write_descriptor_sets    == VK_NULL_HANDLE, "invalid write descriptor sets memory",    return 0);
+
+	cmd_push_descriptor_set(
+		cmd_buffer,
+		bind_point,
+		pipeline_layout,
+		set,
+		write_descriptor_set_count,
+		p_write_descriptor_sets
+	);
+
+	return 1;
+}
+
+uint8_t shCreatePipelineLayout(
+	VkDevice               device,
+	uint32_t               push_constant_range_count,
+	VkPushConstantRange*   p_push_constants_range,
+	uint32_t               src_descriptor_set_layout_count,
+	VkDescriptorSetLayout* p_src_descriptor_set_layouts,
+	VkPipelineLayout*      p_pipeline_layout
+) {
+	shVkArgError(device            == VK_NULL_HANDLE, "invalid device memory",          return 0);
+	shVkArgError(p_pipeline_layout == VK_NULL_HANDLE, "invalid pipeline layout memory", return 0);
+	
+	shVkArgError(
+		push_constant_range_count != 0 && p_push_constants_range == VK_NULL_HANDLE, 
+		"invalid push constants range memory", 
+		return 0
+	);
+
+	shVkArgError(
+		src_descriptor_set_layout_count != 0 && p_src_descriptor_set_layouts == VK_NULL_HANDLE,
+		"invalid src descriptor set layouts memory", 
+		return 0
+	);
+
+
+	VkPipelineLayoutCreateInfo pipeline_layout_create_info = {
+		.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO, //sType;
+		.pNext                  = VK_NULL_HANDLE,                                //pNext;
+		.flags                  = 0,                                             //flags;
+		.setLayoutCount         = src_descriptor_set_layout_count,               //setLayoutCount;
+		.pSetLayouts            = p_src_descriptor_set_layouts,                  //pSetLayouts;
+		.pushConstantRangeCount = push_constant_range_count,                     //pushConstantRangeCount;
 		.pPushConstantRanges    = p_push_constants_range                         //pPushConstantRanges;
 	};
 
@@ -3319,15 +5374,14 @@ uint8_t shCreatePipelineLayout(
 	return 1;
 }
 
-uint8_t shSetupGraphicsPipeline(
-	VkDevice      device, 
-	VkRenderPass  renderpass, 
-	ShVkPipeline* p_pipeline
+static uint8_t shCreateGraphicsPipeline(
+	VkDevice        device,
+	VkRenderPass    renderpass,
+	void*           p_next,
+	uint32_t        dynamic_state_count,
+	VkDynamicState* p_dynamic_states,
+	ShVkPipeline*   p_pipeline
 ) {
-	shVkError(device      == VK_NULL_HANDLE, "invalid device memory",            return 0);
-	shVkError(renderpass  == VK_NULL_HANDLE, "invalid renderpass memory",        return 0);
-	shVkError(p_pipeline  == VK_NULL_HANDLE, "invalid graphics pipeline memory", return 0);
-
 	VkPipelineDepthStencilStateCreateInfo depth_stencil_state_create_info = {
 		.sType                 = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO, //sType;
 		.pNext                 = VK_NULL_HANDLE,                                             //pNext;
@@ -3343,9 +5397,18 @@ uint8_t shSetupGraphicsPipeline(
 		.maxDepthBounds        = 1.0f                                                        //maxDepthBounds;
 	};
 
+	VkPipelineDynamicStateCreateInfo dynamic_state_info = {
+		.sType             = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO, //sType;
+		.pNext             = VK_NULL_HANDLE,                                       //pNext;
+		.flags             = 0,                                                    //flags;
+		.dynamicStateCount = dynamic_state_count,                                  //dynamicStateCount;
+		.pDynamicStates    = p_dynamic_states                                      //pDynamicStates;
+	};
+	VkPipelineDynamicStateCreateInfo* p_dynamic_state = (dynamic_state_count != 0) ? &dynamic_state_info : VK_NULL_HANDLE;
+
 	VkGraphicsPipelineCreateInfo graphics_pipeline_create_info = {
 		.sType                = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO, //sType;
-		.pNext                = VK_NULL_HANDLE,                                  //pNext;
+		.pNext                = p_next,                                          //pNext;
 		.flags                = 0,                                               //flags;
 		.stageCount           = p_pipeline->shader_module_count,                 //stageCount;
 		.pStages              = p_pipeline->shader_stages,                       //pStages;
@@ -3357,7 +5420,7 @@ uint8_t shSetupGraphicsPipeline(
 		.pMultisampleState    = &p_pipeline->multisample_state_info,             //pMultisampleState;
 		.pDepthStencilState   = &depth_stencil_state_create_info,                //pDepthStencilState;
 		.pColorBlendState     = &p_pipeline->color_blend_state,                  //pColorBlendState;
-		.pDynamicState        = VK_NULL_HANDLE,                                  //pDynamicState;
+		.pDynamicState        = p_dynamic_state,                                 //pDynamicState;
 		.layout               = p_pipeline->pipeline_layout,                     //layout;
 		.renderPass           = renderpass,                                      //renderPass;
 		.subpass              = 0,                                               //subpass;
@@ -3380,12 +5443,24 @@ uint8_t shSetupGraphicsPipeline(
     return 1;
 }
 
+uint8_t shSetupGraphicsPipeline(
+	VkDevice      device, 
+	VkRenderPass  renderpass, 
+	ShVkPipeline* p_pipeline
+) {
+	shVkArgError(device      == VK_NULL_HANDLE, "invalid device memory",            return 0);
+	shVkArgError(renderpass  == VK_NULL_HANDLE, "invalid renderpass memory",        return 0);
+	shVkArgError(p_pipeline  == VK_NULL_HANDLE, "invalid graphics pipeline memory", return 0);
+
+	return shCreateGraphicsPipeline(device, renderpass, VK_NULL_HANDLE, 0, VK_NULL_HANDLE, p_pipeline);
+}
+
 extern uint8_t shDestroyDescriptorPool(
 	VkDevice         device,
 	VkDescriptorPool descriptor_pool
 ) {
-	shVkError(device          == VK_NULL_HANDLE, "invalid device memory",          return 0);
-	shVkError(descriptor_pool == VK_NULL_HANDLE, "invalid descriptor pool memory", return 0);
+	shVkArgError(device          == VK_NULL_HANDLE, "invalid device memory",          return 0);
+	shVkArgError(descriptor_pool == VK_NULL_HANDLE, "invalid descriptor pool memory", return 0);
 
 	vkDestroyDescriptorPool(device, descriptor_pool, VK_NULL_HANDLE);
 
@@ -3396,20 +5471,32 @@ extern uint8_t shDestroyDescriptorSetLayout(
 	VkDevice device,
 	VkDescriptorSetLayout descriptor_set_layout
 ) {
-	shVkError(device                == VK_NULL_HANDLE, "invalid device memory",                return 0);
-	shVkError(descriptor_set_layout == VK_NULL_HANDLE, "invalid descriptor set layout memory", return 0);
+	shVkArgError(device                == VK_NULL_HANDLE, "invalid device memory",                return 0);
+	shVkArgError(descriptor_set_layout == VK_NULL_HANDLE, "invalid descriptor set layout memory", return 0);
 
 	vkDestroyDescriptorSetLayout(device, descriptor_set_layout, VK_NULL_HANDLE);
 
 	return 1;
 }
 
+uint8_t shDestroyDescriptorUpdateTemplate(
+	VkDevice                   device,
+	VkDescriptorUpdateTemplate descriptor_update_template
+) {
+	shVkArgError(device                     == VK_NULL_HANDLE, "invalid device memory",                     return 0);
+	shVkArgError(descriptor_update_template == VK_NULL_HANDLE, "invalid descriptor update template memory", return 0);
+
+	vkDestroyDescriptorUpdateTemplate(device, descriptor_update_template, VK_NULL_HANDLE);
+
+	return 1;
+}
+
 uint8_t shDestroyShaderModule(
 	VkDevice       device,
 	VkShaderModule shader_module
 ) {
-	shVkError(device        == VK_NULL_HANDLE, "invalid device memory",        return 0);
-	shVkError(shader_module == VK_NULL_HANDLE, "invalid shader module memory", return 0);
+	shVkArgError(device        == VK_NULL_HANDLE, "invalid device memory",        return 0);
+	shVkArgError(shader_module == VK_NULL_HANDLE, "invalid shader module memory", return 0);
 
 	vkDestroyShaderModule(device, shader_module, VK_NULL_HANDLE);
 
@@ -3420,8 +5507,8 @@ uint8_t shDestroyPipelineLayout(
 	VkDevice         device,
 	VkPipelineLayout pipeline_layout
 ) {
-	shVkError(device          == VK_NULL_HANDLE, "invalid device memory",          return 0);
-	shVkError(pipeline_layout == VK_NULL_HANDLE, "invalid pipeline layout memory", return 0);
+	shVkArgError(device          == VK_NULL_HANDLE, "invalid device memory",          return 0);
+	shVkArgError(pipeline_layout == VK_NULL_HANDLE, "invalid pipeline layout memory", return 0);
 
 	vkDestroyPipelineLayout(device, pipeline_layout, VK_NULL_HANDLE);
 
@@ -3432,823 +5519,1390 @@ uint8_t shDestroyPipeline(
 	VkDevice   device,
 	VkPipeline pipeline
 ) {
-	shVkError(device   == VK_NULL_HANDLE, "invalid device memory",   return 0);
-	shVkError(pipeline == VK_NULL_HANDLE, "invalid pipeline memory", return 0);
+	shVkArgError(device   == VK_NULL_HANDLE, "invalid device memory",   return 0);
+	shVkArgError(pipeline == VK_NULL_HANDLE, "invalid pipeline memory", return 0);
 
 	vkDestroyPipeline(device, pipeline, VK_NULL_HANDLE);
 
 	return 1;
 }
 
-uint8_t shClearPipeline(
-	ShVkPipeline* p_pipeline
+uint8_t shCreateSampler(
+	VkDevice             device,
+	VkSamplerCreateInfo* p_sampler_create_info,
+	VkSampler*           p_sampler
 ) {
-	shVkError(p_pipeline == VK_NULL_HANDLE, "invalid pipeline memory", return 0);
+	shVkArgError(device                == VK_NULL_HANDLE, "invalid device memory",             return 0);
+	shVkArgError(p_sampler_create_info == VK_NULL_HANDLE, "invalid sampler create info memory", return 0);
+	shVkArgError(p_sampler             == VK_NULL_HANDLE, "invalid sampler memory",             return 0);
 
-	memset(p_pipeline, 0, sizeof(ShVkPipeline));
+	shVkResultError(
+		vkCreateSampler(device, p_sampler_create_info, VK_NULL_HANDLE, p_sampler),
+		"error creating sampler", return 0
+	);
 
 	return 1;
 }
 
-uint8_t shSetupComputePipeline(
-	VkDevice      device,
-	ShVkPipeline* p_pipeline
+uint8_t shDestroySampler(
+	VkDevice  device,
+	VkSampler sampler
 ) {
-	shVkError(device     == VK_NULL_HANDLE, "invalid device memory",            return 0);
-	shVkError(p_pipeline == VK_NULL_HANDLE, "invalid compute pipeline pointer", return 0);
-
-	VkComputePipelineCreateInfo pipeline_create_info = {
-		.sType  =  VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
-		.pNext  =  VK_NULL_HANDLE,
-		.flags  =  0,
-		.stage  =  p_pipeline->shader_stages[0],
-		.layout =  p_pipeline->pipeline_layout,
-	};
+	shVkArgError(device  == VK_NULL_HANDLE, "invalid device memory",  return 0);
+	shVkArgError(sampler == VK_NULL_HANDLE, "invalid sampler memory", return 0);
 
-	shVkResultError(
-		vkCreateComputePipelines(device, 0, 1, &pipeline_create_info, VK_NULL_HANDLE, &p_pipeline->pipeline),
-		"error creating pipeline layout", return 0
-	);
+	vkDestroySampler(device, sampler, VK_NULL_HANDLE);
 
-    return 1;
+	return 1;
 }
 
-uint8_t shPipelineSetVertexBinding(
-	uint32_t          binding,
-	uint32_t          size,
-	VkVertexInputRate input_rate,
-	ShVkPipeline*     p_pipeline
+uint8_t shHashSamplerCreateInfo(
+	VkSamplerCreateInfo* p_sampler_create_info,
+	uint64_t*            p_hash
 ) {
-	shVkError(p_pipeline == VK_NULL_HANDLE, "invalid pipeline memory", return 0);
-	
-	shVkError(
-		p_pipeline->vertex_binding_count == SH_MAX_PIPELINE_VERTEX_BINDING_COUNT,
-		"reached max pipeline vertex input binding count",
-		return 0
-	);
+	shVkArgError(p_sampler_create_info == NULL, "invalid sampler create info memory", return 0);
+	shVkArgError(p_hash                == NULL, "invalid hash memory",                return 0);
 
-	shVkError(
-		shSetVertexBinding(
-			binding, 
-			size, 
-			input_rate, 
-			&p_pipeline->vertex_bindings[p_pipeline->vertex_binding_count]
-		) == 0,
-		"failed setting vertex input binding",
-		return 0
-	);
+	uint8_t* p_states    = (uint8_t*)&p_sampler_create_info->flags;
+	size_t   states_size = sizeof(VkSamplerCreateInfo) - offsetof(VkSamplerCreateInfo, flags);
 
-	p_pipeline->vertex_binding_count++;
+	uint64_t hash = 14695981039346656037ULL;
+	for (size_t byte_idx = 0; byte_idx < states_size; byte_idx++) {
+		hash ^= (uint64_t)p_states[byte_idx];
+		hash *= 1099511628211ULL;
+	}
+
+	(*p_hash) = hash;
 
 	return 1;
 }
 
-uint8_t shPipelineSetVertexAttribute(
-	uint32_t      location,
-	uint32_t      binding,
-	VkFormat      format,
-	uint32_t      offset,
-	ShVkPipeline* p_pipeline
+uint8_t shSamplerCacheGet(
+	VkDevice             device,
+	VkSamplerCreateInfo* p_sampler_create_info,
+	ShVkSamplerCache*    p_sampler_cache,
+	VkSampler*           p_sampler
 ) {
-	shVkError(p_pipeline == VK_NULL_HANDLE, "invalid pipeline memory", return 0);
-	
-	shVkError(
-		p_pipeline->vertex_binding_count == SH_MAX_PIPELINE_VERTEX_ATTRIBUTE_COUNT,
-		"reached max pipeline vertex attribute count",
+	shVkArgError(device                == VK_NULL_HANDLE, "invalid device memory",              return 0);
+	shVkArgError(p_sampler_create_info == NULL,           "invalid sampler create info memory", return 0);
+	shVkArgError(p_sampler_cache       == NULL,           "invalid sampler cache memory",       return 0);
+	shVkArgError(p_sampler             == NULL,           "invalid sampler memory",             return 0);
+
+	//chained structures (reduction mode, YCbCr conversion, custom border color) are not part of the key
+	shVkArgError(
+		p_sampler_create_info->pNext != NULL,
+		"cached sampler create info must not have a pNext chain",
 		return 0
 	);
 
-	shVkError(
-		shSetVertexAttribute(
-			location, 
-			binding, 
-			format, 
-			offset, 
-			&p_pipeline->vertex_attributes[p_pipeline->vertex_attribute_count]
-		) == 0,
-		"failed setting vertex input attribute",
-		return 0
-	);
+	uint64_t hash = 0;
+	shHashSamplerCreateInfo(p_sampler_create_info, &hash);
 
-	p_pipeline->vertex_attribute_count++;
+	size_t states_offset = offsetof(VkSamplerCreateInfo, flags);
+	size_t states_size   = sizeof(VkSamplerCreateInfo) - states_offset;
 
-	return 1;
+	for (uint32_t probe_idx = 0; probe_idx < SH_SAMPLER_CACHE_MAX_SAMPLER_COUNT; probe_idx++) {
+		uint32_t slot_idx = (uint32_t)(hash + probe_idx) & (SH_SAMPLER_CACHE_MAX_SAMPLER_COUNT - 1);
+
+		if (p_sampler_cache->samplers[slot_idx] == VK_NULL_HANDLE) {
+			shVkError(
+				shCreateSampler(device, p_sampler_create_info, &p_sampler_cache->samplers[slot_idx]) == 0,
+				"failed creating cached sampler",
+				return 0
+			);
+			p_sampler_cache->hashes      [slot_idx] = hash;
+			p_sampler_cache->create_infos[slot_idx] = (*p_sampler_create_info);
+			p_sampler_cache->create_infos[slot_idx].pNext = NULL;
+			p_sampler_cache->sampler_count++;
+
+			(*p_sampler) = p_sampler_cache->samplers[slot_idx];
+			return 1;
+		}
+
+		if (
+			p_sampler_cache->hashes[slot_idx] == hash &&
+			memcmp(
+				(uint8_t*)&p_sampler_cache->create_infos[slot_idx] + states_offset,
+				(uint8_t*)p_sampler_create_info                    + states_offset,
+				states_size
+			) == 0
+		) {
+			(*p_sampler) = p_sampler_cache->samplers[slot_idx];
+			return 1;
+		}
+	}
+
+	shVkError(1, "reached max sampler cache sampler count", return 0);
+
+	return 0;
 }
 
-uint8_t shPipelineSetVertexInputState(
-	ShVkPipeline* p_pipeline
+uint8_t shDestroySamplerCache(
+	VkDevice          device,
+	ShVkSamplerCache* p_sampler_cache
 ) {
-	shVkError(p_pipeline == VK_NULL_HANDLE, "invalid pipeline memory", return 0);
+	shVkArgError(p_sampler_cache == NULL, "invalid sampler cache memory", return 0);
 
-	shVkError(
-		shSetVertexInputState(
-			p_pipeline->vertex_binding_count,
-			p_pipeline->vertex_bindings,
-			p_pipeline->vertex_attribute_count,
-			p_pipeline->vertex_attributes,
-			&p_pipeline->vertex_input_state_info
-		) == 0,
-		"failed setting vertex input state",
-		return 0
-	);
+	for (uint32_t slot_idx = 0; slot_idx < SH_SAMPLER_CACHE_MAX_SAMPLER_COUNT; slot_idx++) {
+		if (p_sampler_cache->samplers[slot_idx] == VK_NULL_HANDLE) {
+			continue;
+		}
+		shVkError(
+			shDestroySampler(device, p_sampler_cache->samplers[slot_idx]) == 0,
+			"failed destroying cached sampler",
+			return 0
+		);
+	}
+
+	memset(p_sampler_cache, 0, sizeof(ShVkSamplerCache));
 
 	return 1;
 }
 
-uint8_t shPipelineCreateInputAssembly(
-	VkPrimitiveTopology primitive_topology,
-	VkBool32            primitive_restart_enable,
-	ShVkPipeline*       p_pipeline
+uint8_t shCreateDescriptorSetCache(
+	VkDevice                device,
+	uint32_t                pool_size_count,
+	VkDescriptorPoolSize*   p_pool_sizes,
+	uint32_t                max_set_count,
+	uint32_t                frames_in_flight,
+	ShVkDescriptorSetCache* p_descriptor_set_cache
 ) {
-	shVkError(p_pipeline == VK_NULL_HANDLE, "invalid pipeline memory", return 0);
-
-	shVkError(
-		shCreateInputAssembly(
-			primitive_topology,
-			primitive_restart_enable,
-			&p_pipeline->input_assembly
-		) == 0,
-		"failed creating input assembly",
+	shVkArgError(device                 == VK_NULL_HANDLE, "invalid device memory",                return 0);
+	shVkArgError(pool_size_count        == 0,              "invalid descriptor pool size count",   return 0);
+	shVkArgError(p_pool_sizes           == VK_NULL_HANDLE, "invalid descriptor pool sizes memory", return 0);
+	shVkArgError(p_descriptor_set_cache == VK_NULL_HANDLE, "invalid descriptor set cache memory",  return 0);
+
+	shVkArgError(
+		max_set_count == 0 || max_set_count > SH_DESCRIPTOR_SET_CACHE_MAX_SET_COUNT,
+		"invalid descriptor set cache max set count",
 		return 0
 	);
 
+	VkDescriptorPoolCreateInfo descriptor_pool_create_info = {
+		.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,     //sType;
+		.pNext         = VK_NULL_HANDLE,                                    //pNext;
+		.flags         = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT, //flags;
+		.maxSets       = max_set_count,                                     //maxSets;
+		.poolSizeCount = pool_size_count,                                   //poolSizeCount;
+		.pPoolSizes    = p_pool_sizes                                       //pPoolSizes;
+	};
+
+	shVkResultError(
+		vkCreateDescriptorPool(device, &descriptor_pool_create_info, VK_NULL_HANDLE, &p_descriptor_set_cache->descriptor_pool),
+		"error creating descriptor set cache pool", return 0
+	);
+
+	p_descriptor_set_cache->max_set_count    = max_set_count;
+	p_descriptor_set_cache->frames_in_flight = frames_in_flight;
+	p_descriptor_set_cache->frame_idx        = frames_in_flight;//so that sets never used are always evictable
+	p_descriptor_set_cache->set_count        = 0;
+
 	return 1;
 }
 
-uint8_t shPipelineCreateRasterizer(
-	VkPolygonMode      polygon_mode,
-	VkCullModeFlagBits cull_mode,
-	ShVkPipeline*      p_pipeline
+uint8_t shDescriptorSetCacheBeginFrame(
+	ShVkDescriptorSetCache* p_descriptor_set_cache
 ) {
-	shVkError(p_pipeline == VK_NULL_HANDLE, "invalid pipeline memory", return 0);
+	shVkArgError(p_descriptor_set_cache == VK_NULL_HANDLE, "invalid descriptor set cache memory", return 0);
 
-	shVkError(
-		shCreateRasterizer(
-			polygon_mode, 
-			cull_mode, 
-			&p_pipeline->rasterizer
-		) == 0,
-		"failed creating pipeline rasterizer",
-		return 0
-	);
+	p_descriptor_set_cache->frame_idx++;
 
 	return 1;
 }
 
-uint8_t shPipelineSetMultisampleState(
-	VkSampleCountFlagBits sample_count,
-	float                 min_sample_shading_size,
-	ShVkPipeline*         p_pipeline
+static uint8_t shDescriptorSetCacheKeyPush(
+	uint64_t  value,
+	uint8_t*  p_key,
+	uint32_t* p_key_size
 ) {
-	shVkError(p_pipeline == VK_NULL_HANDLE, "invalid pipeline memory", return 0);
-
-	shVkError(
-		shSetMultisampleState(
-			sample_count,
-			min_sample_shading_size,
-			&p_pipeline->multisample_state_info
-		) == 0,
-		"failed setting pipeline multisample state",
-		return 0
-	);
+	if ((*p_key_size) + (uint32_t)sizeof(uint64_t) > SH_DESCRIPTOR_SET_CACHE_MAX_KEY_SIZE) {
+		return 0;
+	}
+	memcpy(&p_key[*p_key_size], &value, sizeof(uint64_t));
+	(*p_key_size) += (uint32_t)sizeof(uint64_t);
 
 	return 1;
 }
 
-uint8_t shPipelineSetViewport(
-	uint32_t      viewport_pos_x,
-	uint32_t      viewport_pos_y,
-	uint32_t      viewport_width, 
-	uint32_t      viewport_height, 
-	uint32_t      scissors_pos_x,
-	uint32_t      scissors_pos_y,
-	uint32_t      scissors_width,
-	uint32_t      scissors_height,
-	ShVkPipeline* p_pipeline
+//handles are pointers or 64 bit integers depending on the platform
+static uint64_t shDescriptorSetCacheHandleWord(
+	const void* p_handle,
+	size_t      handle_size
 ) {
-	shVkError(p_pipeline == VK_NULL_HANDLE, "invalid pipeline memory", return 0);
+	uint64_t word = 0;
+	memcpy(&word, p_handle, handle_size);
+	return word;
+}
 
-	shVkError(
-		shSetViewport(
-			viewport_pos_x,
-			viewport_pos_y,
-			viewport_width,
-			viewport_height,
-			&p_pipeline->viewport,
-			scissors_pos_x,
-			scissors_pos_y,
-			scissors_width,
-			scissors_height,
-			&p_pipeline->scissors,
-			&p_pipeline->viewport_state
-		) == 0,
-		"failed setting pipeline viewport",
-		return 0
-	);
+#define SH_DESCRIPTOR_SET_CACHE_HANDLE_WORD(handle) shDescriptorSetCacheHandleWord(&(handle), sizeof(handle))
 
-	return 1;
+static uint32_t shDescriptorSetCacheFindLru(
+	ShVkDescriptorSetCache* p_cache
+) {
+	uint32_t lru_slot  = UINT32_MAX;
+	uint64_t lru_frame = UINT64_MAX;
+	for (uint32_t slot_idx = 0; slot_idx < SH_DESCRIPTOR_SET_CACHE_TABLE_SIZE; slot_idx++) {
+		if (p_cache->descriptor_sets[slot_idx] == VK_NULL_HANDLE) {
+			continue;
+		}
+		uint64_t last_used_frame = p_cache->last_used_frames[slot_idx];
+		if (
+			p_cache->frame_idx - last_used_frame >= p_cache->frames_in_flight &&
+			last_used_frame < lru_frame
+		) {
+			lru_frame = last_used_frame;
+			lru_slot  = slot_idx;
+		}
+	}
+	return lru_slot;
 }
 
-uint8_t shPipelineColorBlendSettings(
-	uint8_t       enable_color_blending,
-	uint8_t       enable_alpha_blending,
-	uint32_t      subpass_color_attachment_count,
-	ShVkPipeline* p_pipeline
+static void shDescriptorSetCacheRemove(
+	uint32_t                slot_idx,
+	ShVkDescriptorSetCache* p_cache
 ) {
-	shVkError(p_pipeline == VK_NULL_HANDLE, "invalid pipeline memory", return 0);
+	uint32_t mask = SH_DESCRIPTOR_SET_CACHE_TABLE_SIZE - 1;
+
+	p_cache->descriptor_sets[slot_idx] = VK_NULL_HANDLE;
+	p_cache->set_count--;
+
+	//backward shift, so that probe sequences never cross an empty slot
+	uint32_t hole_idx = slot_idx;
+	for (uint32_t next_idx = (slot_idx + 1) & mask; p_cache->descriptor_sets[next_idx] != VK_NULL_HANDLE; next_idx = (next_idx + 1) & mask) {
+		uint32_t home_idx = (uint32_t)p_cache->hashes[next_idx] & mask;
+		uint8_t  stays    = (hole_idx <= next_idx) ?
+			(home_idx > hole_idx && home_idx <= next_idx) :
+			(home_idx > hole_idx || home_idx <= next_idx);
+		if (stays) {
+			continue;
+		}
+		p_cache->hashes          [hole_idx] = p_cache->hashes          [next_idx];
+		p_cache->key_sizes       [hole_idx] = p_cache->key_sizes       [next_idx];
+		p_cache->last_used_frames[hole_idx] = p_cache->last_used_frames[next_idx];
+		p_cache->set_layouts     [hole_idx] = p_cache->set_layouts     [next_idx];
+		p_cache->descriptor_sets [hole_idx] = p_cache->descriptor_sets [next_idx];
+		memcpy(p_cache->keys[hole_idx], p_cache->keys[next_idx], (size_t)p_cache->key_sizes[next_idx]);
+
+		p_cache->descriptor_sets[next_idx] = VK_NULL_HANDLE;
+		hole_idx = next_idx;
+	}
+}
 
-	shVkError(
-		shColorBlendSettings(
-			enable_color_blending,
-			enable_alpha_blending,
-			subpass_color_attachment_count,
-			p_pipeline->color_blend_attachment_states,
-			&p_pipeline->color_blend_state
-		) == 0,
-		"failed setting pipeline color blend settings",
+uint8_t shDescriptorSetCacheGet(
+	VkDevice                device,
+	VkDescriptorSetLayout   set_layout,
+	uint32_t                write_descriptor_set_count,
+	VkWriteDescriptorSet*   p_write_descriptor_sets,
+	ShVkDescriptorSetCache* p_descriptor_set_cache,
+	VkDescriptorSet*        p_descriptor_set
+) {
+	shVkArgError(device                     == VK_NULL_HANDLE, "invalid device memory",                return 0);
+	shVkArgError(set_layout                 == VK_NULL_HANDLE, "invalid descriptor set layout memory", return 0);
+	shVkArgError(write_descriptor_set_count == 0,              "invalid write descriptor set count",   return 0);
+	shVkArgError(p_write_descriptor_sets    == VK_NULL_HANDLE, "invalid write descriptor sets memory", return 0);
+	shVkArgError(p_descriptor_set_cache     == VK_NULL_HANDLE, "invalid descriptor set cache memory",  return 0);
+	shVkArgError(p_descriptor_set           == VK_NULL_HANDLE, "invalid descriptor set memory",        return 0);
+
+	shVkArgError(
+		write_descriptor_set_count > SH_MAX_PIPELINE_POOL_DESCRIPTOR_COUNT,
+		"reached max descriptor set cache write count",
 		return 0
 	);
 
+	ShVkDescriptorSetCache* p_cache = p_descriptor_set_cache;
+	uint32_t                mask    = SH_DESCRIPTOR_SET_CACHE_TABLE_SIZE - 1;
+
+	//key: layout, then for each write its destination, type and the members of its infos, so that padding is never read
+	uint8_t  key[SH_DESCRIPTOR_SET_CACHE_MAX_KEY_SIZE] = { 0 };
+	uint32_t key_size                                  = 0;
+	uint8_t  key_fits                                  = 1;
+
+	key_fits &= shDescriptorSetCacheKeyPush(SH_DESCRIPTOR_SET_CACHE_HANDLE_WORD(set_layout), key, &key_size);
+
+	for (uint32_t write_idx = 0; write_idx < write_descriptor_set_count; write_idx++) {
+		VkWriteDescriptorSet* p_write = &p_write_descriptor_sets[write_idx];
+
+		ShVkDescriptorInfoType info_type = SH_DESCRIPTOR_INFO_TYPE_BUFFER;
+		if (shGetDescriptorInfoType(p_write->descriptorType, &info_type) == 0) {
+			return 0;
+		}
+
+		shVkError(
+			(info_type == SH_DESCRIPTOR_INFO_TYPE_BUFFER       && p_write->pBufferInfo      == VK_NULL_HANDLE) ||
+			(info_type == SH_DESCRIPTOR_INFO_TYPE_IMAGE        && p_write->pImageInfo       == VK_NULL_HANDLE) ||
+			(info_type == SH_DESCRIPTOR_INFO_TYPE_TEXEL_BUFFER && p_write->pTexelBufferView == VK_NULL_HANDLE),
+			"invalid descriptor infos memory",
+			return 0
+		);
+
+		key_fits &= shDescriptorSetCacheKeyPush(((uint64_t)p_write->dstBinding      << 32) | (uint64_t)p_write->dstArrayElement,         key, &key_size);
+		key_fits &= shDescriptorSetCacheKeyPush(((uint64_t)p_write->descriptorCount << 32) | (uint64_t)(uint32_t)p_write->descriptorType, key, &key_size);
+
+		for (uint32_t descriptor_idx = 0; descriptor_idx < p_write->descriptorCount; descriptor_idx++) {
+			switch (info_type) {
+			case SH_DESCRIPTOR_INFO_TYPE_BUFFER: {
+				const VkDescriptorBufferInfo* p_info = &p_write->pBufferInfo[descriptor_idx];
+				key_fits &= shDescriptorSetCacheKeyPush(SH_DESCRIPTOR_SET_CACHE_HANDLE_WORD(p_info->buffer), key, &key_size);
+				key_fits &= shDescriptorSetCacheKeyPush((uint64_t)p_info->offset,                            key, &key_size);
+				key_fits &= shDescriptorSetCacheKeyPush((uint64_t)p_info->range,                             key, &key_size);
+				break;
+			}
+			case SH_DESCRIPTOR_INFO_TYPE_IMAGE: {
+				const VkDescriptorImageInfo* p_info = &p_write->pImageInfo[descriptor_idx];
+				key_fits &= shDescriptorSetCacheKeyPush(SH_DESCRIPTOR_SET_CACHE_HANDLE_WORD(p_info->sampler),   key, &key_size);
+				key_fits &= shDescriptorSetCacheKeyPush(SH_DESCRIPTOR_SET_CACHE_HANDLE_WORD(p_info->imageView), key, &key_size);
+				key_fits &= shDescriptorSetCacheKeyPush((uint64_t)(uint32_t)p_info->imageLayout,               key, &key_size);
+				break;
+			}
+			case SH_DESCRIPTOR_INFO_TYPE_TEXEL_BUFFER:
+				key_fits &= shDescriptorSetCacheKeyPush(SH_DESCRIPTOR_SET_CACHE_HANDLE_WORD(p_write->pTexelBufferView[descriptor_idx]), key, &key_size);
+				break;
+			}
+		}
+	}
+
+	shVkError(key_fits == 0, "reached max descriptor set cache key size", return 0);
+
+	uint64_t hash = 14695981039346656037ULL;
+	for (uint32_t byte_idx = 0; byte_idx < key_size; byte_idx++) {
+		hash ^= (uint64_t)key[byte_idx];
+		hash *= 1099511628211ULL;
+	}
+
+	//lookup, the table is never full so the probe always reaches an empty slot
+	for (uint32_t slot_idx = (uint32_t)hash & mask; p_cache->descriptor_sets[slot_idx] != VK_NULL_HANDLE; slot_idx = (slot_idx + 1) & mask) {
+		if (
+			p_cache->hashes[slot_idx]    == hash     &&
+			p_cache->key_sizes[slot_idx] == key_size &&
+			memcmp(p_cache->keys[slot_idx], key, (size_t)key_size) == 0
+		) {
+			p_cache->last_used_frames[slot_idx] = p_cache->frame_idx;
+			(*p_descriptor_set)                 = p_cache->descriptor_sets[slot_idx];
+			return 1;
+		}
+	}
+
+	//miss: recycle the least recently used set out of flight when the cache is full
+	VkDescriptorSet descriptor_set = VK_NULL_HANDLE;
+
+	if (p_cache->set_count == p_cache->max_set_count) {
+		uint32_t lru_slot = shDescriptorSetCacheFindLru(p_cache);
+		shVkError(
+			lru_slot == UINT32_MAX,
+			"all cached descriptor sets are in flight",
+			return 0
+		);
+
+		descriptor_set = p_cache->descriptor_sets[lru_slot];
+		if (p_cache->set_layouts[lru_slot] != set_layout) {
+			shVkResultError(
+				vkFreeDescriptorSets(device, p_cache->descriptor_pool, 1, &descriptor_set),
+				"error freeing cached descriptor set", return 0
+			);
+			descriptor_set = VK_NULL_HANDLE;
+		}
+		shDescriptorSetCacheRemove(lru_slot, p_cache);
+	}
+
+	//pool exhaustion before max_set_count: free sets out of flight until the allocation fits
+	while (descriptor_set == VK_NULL_HANDLE) {
+		VkDescriptorSetAllocateInfo descriptor_set_allocate_info = {
+			.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO, //sType;
+			.pNext              = VK_NULL_HANDLE,                                 //pNext;
+			.descriptorPool     = p_cache->descriptor_pool,                       //descriptorPool;
+			.descriptorSetCount = 1,                                              //descriptorSetCount;
+			.pSetLayouts        = &set_layout                                     //pSetLayouts;
+		};
+		VkResult r = vkAllocateDescriptorSets(device, &descriptor_set_allocate_info, &descriptor_set);
+		if (r == VK_SUCCESS) {
+			break;
+		}
+		descriptor_set = VK_NULL_HANDLE;
+
+		shVkError(
+			r != VK_ERROR_OUT_OF_POOL_MEMORY && r != VK_ERROR_FRAGMENTED_POOL,
+			"failed allocating cached descriptor set",
+			return 0
+		);
+
+		uint32_t lru_slot = shDescriptorSetCacheFindLru(p_cache);
+		shVkError(
+			lru_slot == UINT32_MAX,
+			"descriptor set cache pool is exhausted and all cached descriptor sets are in flight",
+			return 0
+		);
+
+		shVkResultError(
+			vkFreeDescriptorSets(device, p_cache->descriptor_pool, 1, &p_cache->descriptor_sets[lru_slot]),
+			"error freeing cached descriptor set", return 0
+		);
+		shDescriptorSetCacheRemove(lru_slot, p_cache);
+	}
+
+	VkWriteDescriptorSet write_descriptor_sets[SH_MAX_PIPELINE_POOL_DESCRIPTOR_COUNT];
+	for (uint32_t write_idx = 0; write_idx < write_descriptor_set_count; write_idx++) {
+		write_descriptor_sets[write_idx]        = p_write_descriptor_sets[write_idx];
+		write_descriptor_sets[write_idx].dstSet = descriptor_set;
+	}
+	vkUpdateDescriptorSets(device, write_descriptor_set_count, write_descriptor_sets, 0, VK_NULL_HANDLE);
+
+	uint32_t slot_idx = (uint32_t)hash & mask;
+	while (p_cache->descriptor_sets[slot_idx] != VK_NULL_HANDLE) {
+		slot_idx = (slot_idx + 1) & mask;
+	}
+
+	memcpy(p_cache->keys[slot_idx], key, (size_t)key_size);
+	p_cache->hashes          [slot_idx] = hash;
+	p_cache->key_sizes       [slot_idx] = key_size;
+	p_cache->set_layouts     [slot_idx] = set_layout;
+	p_cache->last_used_frames[slot_idx] = p_cache->frame_idx;
+	p_cache->descriptor_sets [slot_idx] = descriptor_set;
+	p_cache->set_count++;
+
+	(*p_descriptor_set) = descriptor_set;
+
 	return 1;
 }
 
-uint8_t shPipelineCreateShaderModule(
-	VkDevice        device,
-	uint32_t        size,
-	char*           code,
-	ShVkPipeline*   p_pipeline
+uint8_t shDestroyDescriptorSetCache(
+	VkDevice                device,
+	ShVkDescriptorSetCache* p_descriptor_set_cache
 ) {
-	shVkError(p_pipeline == VK_NULL_HANDLE, "invalid pipeline memory", return 0);
+	shVkArgError(p_descriptor_set_cache == VK_NULL_HANDLE, "invalid descriptor set cache memory", return 0);
 
 	shVkError(
-		shCreateShaderModule(
-			device,
-			size,
-			code,
-			&p_pipeline->shader_modules[p_pipeline->shader_module_count]
-		) == 0,
-		"failed creating shader module",
+		shDestroyDescriptorPool(device, p_descriptor_set_cache->descriptor_pool) == 0,
+		"failed destroying descriptor set cache pool",
 		return 0
 	);
 
-	p_pipeline->shader_module_count++;
+	memset(p_descriptor_set_cache, 0, sizeof(ShVkDescriptorSetCache));
 
 	return 1;
 }
 
-uint8_t shPipelineCreateShaderStage(
-	VkShaderStageFlags shader_stage,
-	ShVkPipeline*      p_pipeline
+uint8_t shClearPipeline(
+	ShVkPipeline* p_pipeline
 ) {
+	shVkArgError(p_pipeline == VK_NULL_HANDLE, "invalid pipeline memory", return 0);
 
-	shVkError(
-		shCreateShaderStage(
-			p_pipeline->shader_modules[p_pipeline->shader_stage_count],
-			shader_stage,
-			&p_pipeline->shader_stages[p_pipeline->shader_stage_count]
-		) == 0,
-		"failed creating shader stage",
-		return 0
-	);
-
-	p_pipeline->shader_stage_count++;
+	memset(p_pipeline, 0, sizeof(ShVkPipeline));
 
 	return 1;
 }
 
-uint8_t shPipelineSetPushConstants(
-	VkShaderStageFlags shader_stage,
-	uint32_t           offset,
-	uint32_t           size,
-	ShVkPipeline*      p_pipeline
+uint8_t shSetupComputePipeline(
+	VkDevice      device,
+	ShVkPipeline* p_pipeline
 ) {
-	shVkError(p_pipeline == VK_NULL_HANDLE, "invalid pipeline memory", return 0);
+	shVkArgError(device     == VK_NULL_HANDLE, "invalid device memory",            return 0);
+	shVkArgError(p_pipeline == VK_NULL_HANDLE, "invalid compute pipeline pointer", return 0);
 
-	shVkError(
-		shSetPushConstants(
-			shader_stage,
-			offset,
-			size,
-			&p_pipeline->push_constant_range
-		) == 0,
-		"failed setting push constant info",
-		return 0
+	VkComputePipelineCreateInfo pipeline_create_info = {
+		.sType  =  VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+		.pNext  =  VK_NULL_HANDLE,
+		.flags  =  0,
+		.stage  =  p_pipeline->shader_stages[0],
+		.layout =  p_pipeline->pipeline_layout,
+	};
+
+	shVkResultError(
+		vkCreateComputePipelines(device, 0, 1, &pipeline_create_info, VK_NULL_HANDLE, &p_pipeline->pipeline),
+		"error creating pipeline layout", return 0
 	);
 
-	return 1;
+    return 1;
 }
 
-uint8_t shPipelineCreateLayout(
-	VkDevice          device,
-	uint32_t          first_descriptor_set_layout,
-	uint32_t          descriptor_set_layout_count,
-	ShVkPipelinePool* p_pipeline_pool,
+uint8_t shPipelineSetVertexBinding(
+	uint32_t          binding,
+	uint32_t          size,
+	VkVertexInputRate input_rate,
 	ShVkPipeline*     p_pipeline
 ) {
-	shVkError(p_pipeline      == VK_NULL_HANDLE, "invalid pipeline memory",      return 0);
-	shVkError(p_pipeline_pool == VK_NULL_HANDLE, "invalid pipeline pool memory", return 0);
-
+	shVkArgError(p_pipeline == VK_NULL_HANDLE, "invalid pipeline memory", return 0);
+	
 	shVkError(
-		(first_descriptor_set_layout + descriptor_set_layout_count) > SH_MAX_PIPELINE_POOL_DESCRIPTOR_COUNT,
-		"invalid descriptors set layout range",
+		p_pipeline->vertex_binding_count == SH_MAX_PIPELINE_VERTEX_BINDING_COUNT,
+		"reached max pipeline vertex input binding count",
 		return 0
 	);
 
 	shVkError(
-		shCreatePipelineLayout(
-			device,
-			p_pipeline->push_constant_range.size != 0,
-			&p_pipeline->push_constant_range,
-			descriptor_set_layout_count,
-			&p_pipeline_pool->descriptor_set_layouts[first_descriptor_set_layout],
-			&p_pipeline->pipeline_layout
+		shSetVertexBinding(
+			binding, 
+			size, 
+			input_rate, 
+			&p_pipeline->vertex_bindings[p_pipeline->vertex_binding_count]
 		) == 0,
-		"failed creating pipeline layout",
+		"failed setting vertex input binding",
 		return 0
 	);
 
-	//p_pipeline->descriptor_set_count      = descriptor_set_count;
-	//p_pipeline->descriptor_set_unit_count = descriptor_set_unit_count;
+	p_pipeline->vertex_binding_count++;
 
 	return 1;
 }
 
-uint8_t shPipelinePushConstants(
-	VkCommandBuffer cmd_buffer,
-	void*           p_data,
-	ShVkPipeline*   p_pipeline
+uint8_t shPipelineSetVertexAttribute(
+	uint32_t      location,
+	uint32_t      binding,
+	VkFormat      format,
+	uint32_t      offset,
+	ShVkPipeline* p_pipeline
 ) {
-	shVkError(cmd_buffer == VK_NULL_HANDLE, "invalid command buffer memory",     return 0);
-	shVkError(p_data     == VK_NULL_HANDLE, "invalid push constant data memory", return 0);
-	shVkError(p_pipeline == VK_NULL_HANDLE, "invalid pipeline memory",           return 0);
+	shVkArgError(p_pipeline == VK_NULL_HANDLE, "invalid pipeline memory", return 0);
+	
+	shVkError(
+		p_pipeline->vertex_binding_count == SH_MAX_PIPELINE_VERTEX_ATTRIBUTE_COUNT,
+		"reached max pipeline vertex attribute count",
+		return 0
+	);
 
-	vkCmdPushConstants(
-		cmd_buffer,
-		p_pipeline->pipeline_layout,
-		p_pipeline->push_constant_range.stageFlags,
-		p_pipeline->push_constant_range.offset,
-		p_pipeline->push_constant_range.size,
-		p_data
+	shVkError(
+		shSetVertexAttribute(
+			location, 
+			binding, 
+			format, 
+			offset, 
+			&p_pipeline->vertex_attributes[p_pipeline->vertex_attribute_count]
+		) == 0,
+		"failed setting vertex input attribute",
+		return 0
 	);
 
+	p_pipeline->vertex_attribute_count++;
+
 	return 1;
 }
 
-uint8_t shBindPipeline(
-	VkCommandBuffer     cmd_buffer,
-	VkPipelineBindPoint bind_point,
-	ShVkPipeline*       p_pipeline
+uint8_t shPipelineSetVertexInputState(
+	ShVkPipeline* p_pipeline
 ) {
-	shVkError(cmd_buffer == VK_NULL_HANDLE, "invalid command buffer memory", return 0);
-	shVkError(p_pipeline == VK_NULL_HANDLE, "invalid pipeline memory",       return 0);
+	shVkArgError(p_pipeline == VK_NULL_HANDLE, "invalid pipeline memory", return 0);
 
-	vkCmdBindPipeline(cmd_buffer, bind_point, p_pipeline->pipeline);
+	shVkError(
+		shSetVertexInputState(
+			p_pipeline->vertex_binding_count,
+			p_pipeline->vertex_bindings,
+			p_pipeline->vertex_attribute_count,
+			p_pipeline->vertex_attributes,
+			&p_pipeline->vertex_input_state_info
+		) == 0,
+		"failed setting vertex input state",
+		return 0
+	);
 
 	return 1;
 }
 
-uint8_t shPipelineBindDescriptorSetUnits(
-	VkCommandBuffer     cmd_buffer,
-	uint32_t            first_descriptor_set,
-	uint32_t            first_descriptor_set_unit_idx,
-	uint32_t            descriptor_set_unit_count,
-	VkPipelineBindPoint bind_point,
-	uint32_t            dynamic_descriptors_count,
-	uint32_t*           p_dynamic_offsets,
-	ShVkPipelinePool*   p_pipeline_pool,
+uint8_t shPipelineCreateInputAssembly(
+	VkPrimitiveTopology primitive_topology,
+	VkBool32            primitive_restart_enable,
 	ShVkPipeline*       p_pipeline
 ) {
-	shVkError(cmd_buffer      == VK_NULL_HANDLE, "invalid command buffer memory", return 0);
-	shVkError(p_pipeline_pool == VK_NULL_HANDLE, "invalid pipeline pool memory",  return 0);
-	shVkError(p_pipeline      == VK_NULL_HANDLE, "invalid pipeline memory",       return 0);
+	shVkArgError(p_pipeline == VK_NULL_HANDLE, "invalid pipeline memory", return 0);
 
 	shVkError(
-		(first_descriptor_set_unit_idx + descriptor_set_unit_count) > p_pipeline_pool->descriptor_set_unit_count,
-		"invalid descriptor set units range",
+		shCreateInputAssembly(
+			primitive_topology,
+			primitive_restart_enable,
+			&p_pipeline->input_assembly
+		) == 0,
+		"failed creating input assembly",
 		return 0
 	);
 
+	return 1;
+}
+
+uint8_t shPipelineCreateRasterizer(
+	VkPolygonMode      polygon_mode,
+	VkCullModeFlagBits cull_mode,
+	ShVkPipeline*      p_pipeline
+) {
+	shVkArgError(p_pipeline == VK_NULL_HANDLE, "invalid pipeline memory", return 0);
+
 	shVkError(
-		dynamic_descriptors_count != 0 && p_dynamic_offsets == VK_NULL_HANDLE,
-		"invalid dynamic offsets memory",
+		shCreateRasterizer(
+			polygon_mode, 
+			cull_mode, 
+			&p_pipeline->rasterizer
+		) == 0,
+		"failed creating pipeline rasterizer",
 		return 0
 	);
 
-	vkCmdBindDescriptorSets(
-		cmd_buffer,
-		bind_point,
-		p_pipeline->pipeline_layout,
-		first_descriptor_set,
-		descriptor_set_unit_count,
-		&p_pipeline_pool->descriptor_sets[first_descriptor_set_unit_idx],
-		dynamic_descriptors_count,
-		p_dynamic_offsets
-	);
-
 	return 1;
 }
 
-uint8_t shPipelineDestroyShaderModules(
-	VkDevice      device,
-	uint32_t      first_module,
-	uint32_t      module_count,
-	ShVkPipeline* p_pipeline
+uint8_t shPipelineSetMultisampleState(
+	VkSampleCountFlagBits sample_count,
+	float                 min_sample_shading_size,
+	ShVkPipeline*         p_pipeline
 ) {
-	shVkError(p_pipeline == VK_NULL_HANDLE, "invalid pipeline memory", return 0);
+	shVkArgError(p_pipeline == VK_NULL_HANDLE, "invalid pipeline memory", return 0);
 
 	shVkError(
-		first_module + module_count > p_pipeline->shader_module_count,
-		"invalid shader module range",
+		shSetMultisampleState(
+			sample_count,
+			min_sample_shading_size,
+			&p_pipeline->multisample_state_info
+		) == 0,
+		"failed setting pipeline multisample state",
 		return 0
 	);
 
-	for (uint32_t module_idx = first_module; module_idx < (first_module + module_count); module_idx++) {
-		shVkError(
-			shDestroyShaderModule(
-				device,
-				p_pipeline->shader_modules[module_idx]
-			) == 0,
-			"failed destroying shader moudule",
-			return 0
-		);
-	}
-
-	p_pipeline->shader_module_count -= module_count;
-	
 	return 1;
 }
 
-uint8_t shPipelineDestroyLayout(
-	VkDevice      device,
+uint8_t shPipelineSetViewport(
+	uint32_t      viewport_pos_x,
+	uint32_t      viewport_pos_y,
+	uint32_t      viewport_width, 
+	uint32_t      viewport_height, 
+	uint32_t      scissors_pos_x,
+	uint32_t      scissors_pos_y,
+	uint32_t      scissors_width,
+	uint32_t      scissors_height,
 	ShVkPipeline* p_pipeline
 ) {
-	shVkError(p_pipeline == VK_NULL_HANDLE, "invalid pipeline memory", return 0);
+	shVkArgError(p_pipeline == VK_NULL_HANDLE, "invalid pipeline memory", return 0);
 
 	shVkError(
-		shDestroyPipelineLayout(
-			device, p_pipeline->pipeline_layout
+		shSetViewport(
+			viewport_pos_x,
+			viewport_pos_y,
+			viewport_width,
+			viewport_height,
+			&p_pipeline->viewport,
+			scissors_pos_x,
+			scissors_pos_y,
+			scissors_width,
+			scissors_height,
+			&p_pipeline->scissors,
+			&p_pipeline->viewport_state
 		) == 0,
-		"failed destroying pipeline layout",
+		"failed setting pipeline viewport",
 		return 0
 	);
 
 	return 1;
 }
 
-
-
-uint8_t shPipelinePoolCreateDescriptorSetLayoutBinding(
-	uint32_t           binding,
-	VkDescriptorType   descriptor_type,
-	uint32_t           descriptor_set_count,
-	VkShaderStageFlags shader_stage,
-	ShVkPipelinePool*  p_pipeline_pool
+uint8_t shPipelineColorBlendSettings(
+	uint8_t       enable_color_blending,
+	uint8_t       enable_alpha_blending,
+	uint32_t      subpass_color_attachment_count,
+	ShVkPipeline* p_pipeline
 ) {
-	shVkError(p_pipeline_pool == VK_NULL_HANDLE, "invalid pipeline pool memory", return 0);
-	
+	shVkArgError(p_pipeline == VK_NULL_HANDLE, "invalid pipeline memory", return 0);
+
 	shVkError(
-		binding > SH_MAX_PIPELINE_POOL_DESCRIPTOR_COUNT,
-		"invalid descriptor set layout binding value",
+		shColorBlendSettings(
+			enable_color_blending,
+			enable_alpha_blending,
+			subpass_color_attachment_count,
+			p_pipeline->color_blend_attachment_states,
+			&p_pipeline->color_blend_state
+		) == 0,
+		"failed setting pipeline color blend settings",
 		return 0
 	);
 
-	shCreateDescriptorSetLayoutBinding(
-		binding,
-		descriptor_type,
-		descriptor_set_count,
-		shader_stage,
-		&p_pipeline_pool->descriptor_set_layout_bindings[binding]
-	);
-
-	p_pipeline_pool->descriptor_set_layout_binding_count++;
-
 	return 1;
 }
 
-uint8_t shPipelinePoolCreateDescriptorSetLayout(
-	VkDevice          device, 
-	uint32_t          first_binding_idx,
-	uint32_t          binding_count,
-	uint32_t          set_layout_idx,//set_idx
-	ShVkPipelinePool* p_pipeline_pool
+uint8_t shPipelineCreateShaderModule(
+	VkDevice        device,
+	uint32_t        size,
+	char*           code,
+	ShVkPipeline*   p_pipeline
 ) {
-	shVkError(p_pipeline_pool == VK_NULL_HANDLE, "invalid pipeline pool memory", return 0);
-
-	shVkError(
-		(first_binding_idx + binding_count) > SH_MAX_PIPELINE_POOL_DESCRIPTOR_COUNT,
-		"invalid descriptor set layout binding range", 
-		return 0
-	);
+	shVkArgError(p_pipeline == VK_NULL_HANDLE, "invalid pipeline memory", return 0);
 
 	shVkError(
-		shCreateDescriptorSetLayout(
+		shCreateShaderModule(
 			device,
-			binding_count,
-			&p_pipeline_pool->descriptor_set_layout_bindings[first_binding_idx],
-			&p_pipeline_pool->descriptor_set_layouts        [set_layout_idx]
+			size,
+			code,
+			&p_pipeline->shader_modules[p_pipeline->shader_module_count]
 		) == 0,
-		"failed creating descriptor set layout",
+		"failed creating shader module",
 		return 0
 	);
 
-	p_pipeline_pool->src_descriptor_set_layout_count++;
+	p_pipeline->shader_module_count++;
 
 	return 1;
 }
 
-uint8_t shPipelinePoolCopyDescriptorSetLayout(
-	uint32_t          src_set_layout_idx,
-	uint32_t          first_dst_set_layout_idx,
-	uint32_t          dst_set_layout_count,
-	ShVkPipelinePool* p_pipeline_pool
+uint8_t shPipelineCreateShaderStage(
+	VkShaderStageFlags shader_stage,
+	ShVkPipeline*      p_pipeline
 ) {
-	shVkError(p_pipeline_pool == VK_NULL_HANDLE, "invalid pipeline pool memory", return 0);
 
 	shVkError(
-		(first_dst_set_layout_idx + dst_set_layout_count) > SH_MAX_PIPELINE_POOL_DESCRIPTOR_COUNT,
-		"invalid descriptor set layouts range",
+		shCreateShaderStage(
+			p_pipeline->shader_modules[p_pipeline->shader_stage_count],
+			shader_stage,
+			&p_pipeline->shader_stages[p_pipeline->shader_stage_count]
+		) == 0,
+		"failed creating shader stage",
 		return 0
 	);
 
-	for (uint32_t set_layout_idx = first_dst_set_layout_idx; set_layout_idx < (first_dst_set_layout_idx + dst_set_layout_count); set_layout_idx++) {
-		p_pipeline_pool->descriptor_set_layouts[set_layout_idx] = p_pipeline_pool->descriptor_set_layouts[src_set_layout_idx];
-	}
+	p_pipeline->shader_stage_count++;
 
 	return 1;
 }
 
-uint8_t shPipelinePoolCreateDescriptorPool(
-	VkDevice          device,
-	uint32_t          pool_idx,
-	VkDescriptorType  descriptor_type,
-	uint32_t          descriptor_count,
-	ShVkPipelinePool* p_pipeline_pool
+uint8_t shPipelineSetPushConstants(
+	VkShaderStageFlags shader_stage,
+	uint32_t           offset,
+	uint32_t           size,
+	ShVkPipeline*      p_pipeline
 ) {
-	shVkError(p_pipeline_pool  == VK_NULL_HANDLE, "invalid pipeline pool memory", return 0);
-	shVkError(descriptor_count == 0,              "invvalid descriptor count",    return 0);
-
-	VkDescriptorPoolSize pool_size = {
-		.type            = descriptor_type,
-		.descriptorCount = descriptor_count
-	};
+	shVkArgError(p_pipeline == VK_NULL_HANDLE, "invalid pipeline memory", return 0);
 
 	shVkError(
-		shCreateDescriptorPool(
-			device,
-			1,
-			&pool_size,
-			&p_pipeline_pool->descriptor_pools[pool_idx]
+		shSetPushConstants(
+			shader_stage,
+			offset,
+			size,
+			&p_pipeline->push_constant_range
 		) == 0,
-		"failed creating descriptor pool",
+		"failed setting push constant info",
 		return 0
 	);
 
-	p_pipeline_pool->descriptor_pool_count++;
-
 	return 1;
 }
 
-uint8_t shPipelinePoolAllocateDescriptorSetUnits(
+uint8_t shPipelineCreateLayout(
 	VkDevice          device,
-	uint32_t          binding,
-	uint32_t          pool_idx,
-	VkDescriptorType  descriptor_type,
-	uint32_t          first_descriptor_set_unit,
-	uint32_t          descriptor_set_unit_count,
-	ShVkPipelinePool* p_pipeline_pool
+	uint32_t          first_descriptor_set_layout,
+	uint32_t          descriptor_set_layout_count,
+	ShVkPipelinePool* p_pipeline_pool,
+	ShVkPipeline*     p_pipeline
 ) {
-	shVkError(p_pipeline_pool == VK_NULL_HANDLE, "invalid pipeline pool memory", return 0);
+	shVkArgError(p_pipeline      == VK_NULL_HANDLE, "invalid pipeline memory",      return 0);
+	shVkArgError(p_pipeline_pool == VK_NULL_HANDLE, "invalid pipeline pool memory", return 0);
 
-	shVkError(
-		(first_descriptor_set_unit + descriptor_set_unit_count) > SH_MAX_PIPELINE_POOL_DESCRIPTOR_COUNT,
-		"invalid descriptor set range",
+	shVkArgError(
+		(first_descriptor_set_layout + descriptor_set_layout_count) > SH_MAX_PIPELINE_POOL_DESCRIPTOR_COUNT,
+		"invalid descriptors set layout range",
 		return 0
 	);
 
 	shVkError(
-		shAllocateDescriptorSetUnits(
+		shCreatePipelineLayout(
 			device,
-			p_pipeline_pool->descriptor_pools[pool_idx],
-			descriptor_type,
-			binding,
-			descriptor_set_unit_count,
-			&p_pipeline_pool->descriptor_set_layouts[first_descriptor_set_unit],
-			&p_pipeline_pool->descriptor_sets[first_descriptor_set_unit],
-			&p_pipeline_pool->descriptor_buffer_infos[first_descriptor_set_unit],
-			&p_pipeline_pool->write_descriptor_sets[first_descriptor_set_unit]
+			p_pipeline->push_constant_range.size != 0,
+			&p_pipeline->push_constant_range,
+			descriptor_set_layout_count,
+			&p_pipeline_pool->descriptor_set_layouts[first_descriptor_set_layout],
+			&p_pipeline->pipeline_layout
 		) == 0,
-		"failed allocating descriptor set",
+		"failed creating pipeline layout",
 		return 0
 	);
 
-	p_pipeline_pool->write_descriptor_set_count += descriptor_set_unit_count;
-	p_pipeline_pool->descriptor_set_unit_count  += descriptor_set_unit_count;
+	//p_pipeline->descriptor_set_count      = descriptor_set_count;
+	//p_pipeline->descriptor_set_unit_count = descriptor_set_unit_count;
 
 	return 1;
 }
 
-uint8_t shPipelinePoolSetDescriptorBufferInfos(
-	uint32_t          first_descriptor,
-	uint32_t          descriptor_count,
-	VkBuffer          buffer,
-	uint32_t          buffer_offset,
-	uint32_t          buffer_size,
-	ShVkPipelinePool* p_pipeline_pool
-) {
-	shVkError(p_pipeline_pool == VK_NULL_HANDLE, "invalid pipeline pool memory", return 0);
-
-	shVkError(
-		(first_descriptor + descriptor_count) > SH_MAX_PIPELINE_POOL_DESCRIPTOR_COUNT,
-		"reached max pipeline descriptor buffer info count",
-		return 0
+uint8_t shPipelineBindDescriptorSetUnits(
+	VkCommandBuffer     cmd_buffer,
+	uint32_t            first_descriptor_set,
+	uint32_t            first_descriptor_set_unit_idx,
+	uint32_t            descriptor_set_unit_count,
+	VkPipelineBindPoint bind_point,
+	uint32_t            dynamic_descriptors_count,
+	uint32_t*           p_dynamic_offsets,
+	ShVkPipelinePool*   p_pipeline_pool,
+	ShVkPipeline*       p_pipeline
+) {
+	shVkArgError(cmd_buffer      == VK_NULL_HANDLE, "invalid command buffer memory", return 0);
+	shVkArgError(p_pipeline_pool == VK_NULL_HANDLE, "invalid pipeline pool memory",  return 0);
+	shVkArgError(p_pipeline      == VK_NULL_HANDLE, "invalid pipeline memory",       return 0);
+
+	shVkError(
+		(first_descriptor_set_unit_idx + descriptor_set_unit_count) > p_pipeline_pool->descriptor_set_unit_count,
+		"invalid descriptor set units range",
+		return 0
 	);
 
-	for (uint32_t descriptor_idx = first_descriptor; descriptor_idx < (first_descriptor + descriptor_count); descriptor_idx++) {
+	shVkArgError(
+		dynamic_descriptors_count != 0 && p_dynamic_offsets == VK_NULL_HANDLE,
+		"invalid dynamic offsets memory",
+		return 0
+	);
+
+	vkCmdBindDescriptorSets(
+		cmd_buffer,
+		bind_point,
+		p_pipeline->pipeline_layout,
+		first_descriptor_set,
+		descriptor_set_unit_count,
+		&p_pipeline_pool->descriptor_sets[first_descriptor_set_unit_idx],
+		dynamic_descriptors_count,
+		p_dynamic_offsets
+	);
+
+	return 1;
+}
+
+uint8_t shPipelineBindDescriptorSets(
+	VkCommandBuffer     cmd_buffer,
+	uint32_t            first_descriptor_set,
+	uint32_t            descriptor_set_count,
+	VkDescriptorSet*    p_descriptor_sets,
+	VkPipelineBindPoint bind_point,
+	uint32_t            dynamic_descriptors_count,
+	uint32_t*           p_dynamic_offsets,
+	ShVkPipeline*       p_pipeline
+) {
+	shVkArgError(cmd_buffer           == VK_NULL_HANDLE, "invalid command buffer memory",  return 0);
+	shVkArgError(descriptor_set_count == 0,              "invalid descriptor set count",   return 0);
+	shVkArgError(p_descriptor_sets    == VK_NULL_HANDLE, "invalid descriptor sets memory", return 0);
+	shVkArgError(p_pipeline           == VK_NULL_HANDLE, "invalid pipeline memory",        return 0);
+
+	shVkArgError(
+		dynamic_descriptors_count != 0 && p_dynamic_offsets == VK_NULL_HANDLE,
+		"invalid dynamic offsets memory",
+		return 0
+	);
+
+	vkCmdBindDescriptorSets(
+		cmd_buffer,
+		bind_point,
+		p_pipeline->pipeline_layout,
+		first_descriptor_set,
+		descriptor_set_count,
+		p_descriptor_sets,
+		dynamic_descriptors_count,
+		p_dynamic_offsets
+	);
+
+	return 1;
+}
+
+uint8_t shPipelinePushDescriptors(
+	VkCommandBuffer     cmd_buffer,
+	uint32_t            set,
+	uint32_t            binding,
+	VkDescriptorType    descriptor_type,
+	uint32_t            first_descriptor,
+	uint32_t            descriptor_count,
+	VkPipelineBindPoint bind_point,
+	ShVkPipelinePool*   p_pipeline_pool,
+	ShVkPipeline*       p_pipeline
+) {
+	shVkArgError(cmd_buffer       == VK_NULL_HANDLE, "invalid command buffer memory", return 0);
+	shVkArgError(descriptor_count == 0,              "invalid descriptor count",      return 0);
+	shVkArgError(p_pipeline_pool  == VK_NULL_HANDLE, "invalid pipeline pool memory",  return 0);
+	shVkArgError(p_pipeline       == VK_NULL_HANDLE, "invalid pipeline memory",       return 0);
+
+	shVkArgError(
+		(first_descriptor + descriptor_count) > SH_MAX_PIPELINE_POOL_DESCRIPTOR_COUNT,
+		"invalid descriptors range",
+		return 0
+	);
+
+	ShVkDescriptorInfoType info_type = SH_DESCRIPTOR_INFO_TYPE_BUFFER;
+	if (shGetDescriptorInfoType(descriptor_type, &info_type) == 0) {
+		return 0;
+	}
+
+	shVkError(
+		info_type == SH_DESCRIPTOR_INFO_TYPE_TEXEL_BUFFER,
+		"texel buffer descriptors are not supported by pipeline pool push descriptors",
+		return 0
+	);
+
+	VkWriteDescriptorSet write_descriptor_set = {
+		.sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, //sType;
+		.pNext            = VK_NULL_HANDLE,                         //pNext;
+		.dstSet           = VK_NULL_HANDLE,                         //dstSet;
+		.dstBinding       = binding,                                //dstBinding
+		.dstArrayElement  = 0,                                      //dstArrayElement;
+		.descriptorCount  = descriptor_count,                       //descriptorCount;
+		.descriptorType   = descriptor_type,                        //descriptorType
+		.pImageInfo       = VK_NULL_HANDLE,                         //pImageInfo;
+		.pBufferInfo      = VK_NULL_HANDLE,                         //pBufferInfo;
+		.pTexelBufferView = VK_NULL_HANDLE                          //pTexelBufferView;
+	};
+	if (info_type == SH_DESCRIPTOR_INFO_TYPE_IMAGE) {
+		write_descriptor_set.pImageInfo = &p_pipeline_pool->descriptor_image_infos[first_descriptor];
+	}
+	else {
+		write_descriptor_set.pBufferInfo = &p_pipeline_pool->descriptor_buffer_infos[first_descriptor];
+	}
+
+	shVkError(
+		shPushDescriptorSet(
+			cmd_buffer,
+			p_pipeline_pool->cmd_push_descriptor_set,
+			bind_point,
+			p_pipeline->pipeline_layout,
+			set,
+			1,
+			&write_descriptor_set
+		) == 0,
+		"failed pushing descriptors",
+		return 0
+	);
+
+	return 1;
+}
+
+uint8_t shPipelineDestroyShaderModules(
+	VkDevice      device,
+	uint32_t      first_module,
+	uint32_t      module_count,
+	ShVkPipeline* p_pipeline
+) {
+	shVkArgError(p_pipeline == VK_NULL_HANDLE, "invalid pipeline memory", return 0);
+
+	shVkError(
+		first_module + module_count > p_pipeline->shader_module_count,
+		"invalid shader module range",
+		return 0
+	);
+
+	for (uint32_t module_idx = first_module; module_idx < (first_module + module_count); module_idx++) {
 		shVkError(
-			shSetDescriptorBufferInfo(
-				buffer,
-				buffer_offset,
-				buffer_size,
-				&p_pipeline_pool->descriptor_buffer_infos[descriptor_idx]
+			shDestroyShaderModule(
+				device,
+				p_pipeline->shader_modules[module_idx]
 			) == 0,
-			"failed setting descriptor buffer info",
+			"failed destroying shader moudule",
 			return 0
 		);
 	}
 
+	p_pipeline->shader_module_count -= module_count;
+	
 	return 1;
 }
 
-//uint8_t shReadShaderSourceCodeArgs(
-//	char*                       p_source_code,
-//	uint32_t                    code_size,
-//	const char*                 declaration_block,
-//	uint32_t*                   p_declaration_block_count,
-//	uint32_t                    declaration_arg_count,
-//	uint32_t*                   p_working_declaration_arg_values
-//) {
-//	shVkError(p_source_code                    == NULL, "invalid shader source code memory",      return 0);
-//	shVkError(declaration_block                == NULL, "invalid declaration block memory",       return 0);
-//	shVkError(p_declaration_block_count        == NULL, "invalid declaration block count memory", return 0);
-//	shVkError(p_working_declaration_arg_values == NULL, "invalid declaration arg values memory",  return 0);
-//	
-//	uint32_t declaration_arg_idx  = 0;
-//	uint32_t declaration_block_idx        = 0;
-//
-//	for (uint32_t char_idx = 0; char_idx < code_size; char_idx++) {
-//
-//		char*    p_current_token = &p_source_code[char_idx];
-//		uint32_t remaining_bytes = code_size - char_idx;//remaining source code bytes, exluding the current byte
-//
-//		if ((*p_current_token) == ' ') {
-//			p_current_token++;
-//		}
-//
-//		if (remaining_bytes > strlen(declaration_block)) {
-//			if ((*p_current_token) == ',') {
-//				p_current_token++;
-//				declaration_arg_idx++;
-//			}
-//			if (declaration_block_idx != (*p_declaration_block_count)) {
-//				
-//				if (declaration_arg_idx < declaration_arg_count) {
-//					char* p_last_value_char = NULL;
-//					p_working_declaration_arg_values[declaration_block_idx * SH_PIPELINE_MAX_DECLARATION_BLOCK_ARG_COUNT + declaration_arg_idx] 
-//						= strtol(p_current_token, &p_last_value_char, 10);
-//					char_idx += (uint32_t)(p_last_value_char - p_current_token);
-//				}
-//				else {
-//					declaration_block_idx++;
-//				}
-//			}
-//
-//			if (memcmp(p_current_token, declaration_block, strlen(declaration_block)) == 0) {
-//				declaration_block_idx = (*p_declaration_block_count);
-//				declaration_arg_idx   = 0;//reset args
-//				(*p_declaration_block_count)++;
-//				char_idx += (uint32_t)strlen(declaration_block) - 1;//-1 because is followed by char_idx++
-//			}
-//
-//		}
-//
-//	}
-//
-//	return 0;
-//}
-//
-//uint8_t shParseShaderSourceCode(
-//	char*              p_source_code,
-//	uint32_t           code_size,
-//	uint32_t           swapchain_image_count,
-//	VkShaderStageFlags shader_stage,
-//	ShVkPipeline*      p_pipeline
-//) {
-//	shVkError(p_source_code == NULL, "invalid shader source code memory", return 0);
-//
-//	uint32_t vertex_binding_count                = 0;
-//	uint32_t vertex_attribute_count              = 0;
-//	uint32_t push_constant_count                 = 0;
-//	uint32_t descriptor_set_layout_binding_count = 0;
-//	uint32_t descriptor_set_count                = 0;
-//
-//	uint32_t vertex_binding_arg_values                [SH_MAX_PIPELINE_VERTEX_BINDING_COUNT                * SH_PIPELINE_MAX_DECLARATION_BLOCK_ARG_COUNT] = { 0 };
-//	uint32_t vertex_attribute_arg_values              [SH_MAX_PIPELINE_VERTEX_ATTRIBUTE_COUNT              * SH_PIPELINE_MAX_DECLARATION_BLOCK_ARG_COUNT] = { 0 };
-//	uint32_t push_constant_arg_values                 [1                                                   * SH_PIPELINE_MAX_DECLARATION_BLOCK_ARG_COUNT] = { 0 };
-//	uint32_t descriptor_set_layout_binding_arg_values [SH_MAX_PIPELINE_DESCRIPTOR_SET_LAYOUT_BINDING_COUNT * SH_PIPELINE_MAX_DECLARATION_BLOCK_ARG_COUNT] = { 0 };
-//	uint32_t descriptor_set_arg_values                [SH_MAX_PIPELINE_DESCRIPTOR_SET_COUNT                * SH_PIPELINE_MAX_DECLARATION_BLOCK_ARG_COUNT] = { 0 };
-//
-//	shReadShaderSourceCodeArgs(
-//		p_source_code, code_size, SH_PIPELINE_VERTEX_BINDING_DECLARATION_BLOCK,
-//		&vertex_binding_count, SH_PARSER_VERTEX_BINDING_ARG_COUNT,
-//		vertex_binding_arg_values
-//	);
-//
-//	shReadShaderSourceCodeArgs(
-//		p_source_code, code_size, SH_PIPELINE_VERTEX_ATTRIBUTE_DECLARATION_BLOCK,
-//		&vertex_attribute_count, SH_PARSER_VERTEX_ATTRIBUTE_ARG_COUNT,
-//		vertex_attribute_arg_values
-//	);
-//
-//	shReadShaderSourceCodeArgs(
-//		p_source_code, code_size, SH_PIPELINE_PUSH_CONSTANT_DECLARATION_BLOCK,
-//		&push_constant_count, SH_PARSER_PUSH_CONSTANT_ARG_COUNT,
-//		push_constant_arg_values
-//	);
-//
-//	shReadShaderSourceCodeArgs(
-//		p_source_code, code_size, SH_PIPELINE_DESCRIPTOR_SET_LAYOUT_BINDING_DECLARATION_BLOCK,
-//		&descriptor_set_layout_binding_count, SH_PARSER_DESCRIPTOR_SET_LAYOUT_BINDING_ARG_COUNT,
-//		descriptor_set_layout_binding_arg_values
-//	);
-//
-//	shReadShaderSourceCodeArgs(
-//		p_source_code, code_size, SH_PIPELINE_DESCRIPTOR_SET_DECLARATION_BLOCK,
-//		&descriptor_set_count, SH_PARSER_DESCRIPTOR_SET_ARG_COUNT,
-//		descriptor_set_arg_values
-//	);
-//
-//	//
-//	//VERTEX BINDING
-//	//
-//	for (uint32_t vertex_binding_idx = 0; vertex_binding_idx < vertex_binding_count; vertex_binding_idx++) {
-//
-//		uint32_t binding             = vertex_binding_arg_values[SH_PIPELINE_MAX_DECLARATION_BLOCK_ARG_COUNT * vertex_binding_idx + 0];//_binding
-//		uint32_t size                = vertex_binding_arg_values[SH_PIPELINE_MAX_DECLARATION_BLOCK_ARG_COUNT * vertex_binding_idx + 1];//_size
-//		uint32_t input_rate_vertex   = vertex_binding_arg_values[SH_PIPELINE_MAX_DECLARATION_BLOCK_ARG_COUNT * vertex_binding_idx + 2];//_is_input_rate_vertex
-//		uint32_t input_rate_instance = vertex_binding_arg_values[SH_PIPELINE_MAX_DECLARATION_BLOCK_ARG_COUNT * vertex_binding_idx + 3];//_is_input_rate_instance
-//		
-//		VkVertexInputRate vertex_input_rate         = VK_VERTEX_INPUT_RATE_MAX_ENUM;
-//		(input_rate_vertex)   && (vertex_input_rate = VK_VERTEX_INPUT_RATE_VERTEX);
-//		(input_rate_instance) && (vertex_input_rate = VK_VERTEX_INPUT_RATE_INSTANCE);
-//
-//		shVkError(
-//			shPipelineSetVertexBinding(binding, size, vertex_input_rate, p_pipeline) == 0,
-//			"failed setting vertex binding",
-//			return 0
-//		);
-//	}
-//
-//	//
-//	//VERTEX ATTRIBUTE
-//	//
-//	for (uint32_t vertex_attribute_idx = 0; vertex_attribute_idx < vertex_attribute_count; vertex_attribute_idx++) {
-//		uint32_t binding  = vertex_attribute_arg_values[SH_PIPELINE_MAX_DECLARATION_BLOCK_ARG_COUNT * vertex_attribute_idx + 0];//_binding
-//		uint32_t location = vertex_attribute_arg_values[SH_PIPELINE_MAX_DECLARATION_BLOCK_ARG_COUNT * vertex_attribute_idx + 1];//_location
-//		uint32_t offset   = vertex_attribute_arg_values[SH_PIPELINE_MAX_DECLARATION_BLOCK_ARG_COUNT * vertex_attribute_idx + 2];//_offset
-//		uint32_t size     = vertex_attribute_arg_values[SH_PIPELINE_MAX_DECLARATION_BLOCK_ARG_COUNT * vertex_attribute_idx + 3];//_size
-//
-//		VkFormat format   = VK_FORMAT_MAX_ENUM;
-//
-//		//hmm not precise
-//		     if (size == 4)  { format = VK_FORMAT_R32_SFLOAT; }
-//		else if (size == 8)  { format = VK_FORMAT_R32G32_SFLOAT; }
-//		else if (size == 12) { format = VK_FORMAT_R32G32B32_SFLOAT; }
-//		else                 { format = VK_FORMAT_R32G32B32A32_SFLOAT; }
+uint8_t shPipelineDestroyLayout(
+	VkDevice      device,
+	ShVkPipeline* p_pipeline
+) {
+	shVkArgError(p_pipeline == VK_NULL_HANDLE, "invalid pipeline memory", return 0);
+
+	shVkError(
+		shDestroyPipelineLayout(
+			device, p_pipeline->pipeline_layout
+		) == 0,
+		"failed destroying pipeline layout",
+		return 0
+	);
+
+	return 1;
+}
+
+
+
+uint8_t shPipelinePoolCreateDescriptorSetLayoutBinding(
+	uint32_t           binding,
+	VkDescriptorType   descriptor_type,
+	uint32_t           descriptor_set_count,
+	VkShaderStageFlags shader_stage,
+	ShVkPipelinePool*  p_pipeline_pool
+) {
+	shVkArgError(p_pipeline_pool == VK_NULL_HANDLE, "invalid pipeline pool memory", return 0);
+	
+	shVkArgError(
+		binding > SH_MAX_PIPELINE_POOL_DESCRIPTOR_COUNT,
+		"invalid descriptor set layout binding value",
+		return 0
+	);
+
+	shCreateDescriptorSetLayoutBinding(
+		binding,
+		descriptor_type,
+		descriptor_set_count,
+		shader_stage,
+		&p_pipeline_pool->descriptor_set_layout_bindings[binding]
+	);
+
+	p_pipeline_pool->descriptor_set_layout_binding_count++;
+
+	return 1;
+}
+
+uint8_t shPipelinePoolCreateDescriptorSetLayout(
+	VkDevice                         device, 
+	uint32_t                         first_binding_idx,
+	uint32_t                         binding_count,
+	uint32_t                         set_layout_idx,//set_idx
+	VkDescriptorSetLayoutCreateFlags flags,
+	ShVkPipelinePool*                p_pipeline_pool
+) {
+	shVkArgError(p_pipeline_pool == VK_NULL_HANDLE, "invalid pipeline pool memory", return 0);
+
+	shVkArgError(
+		(first_binding_idx + binding_count) > SH_MAX_PIPELINE_POOL_DESCRIPTOR_COUNT,
+		"invalid descriptor set layout binding range", 
+		return 0
+	);
+
+	shVkError(
+		shCreateDescriptorSetLayout(
+			device,
+			binding_count,
+			&p_pipeline_pool->descriptor_set_layout_bindings[first_binding_idx],
+			flags,
+			&p_pipeline_pool->descriptor_set_layouts        [set_layout_idx]
+		) == 0,
+		"failed creating descriptor set layout",
+		return 0
+	);
+
+	if ((flags & VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR) && p_pipeline_pool->cmd_push_descriptor_set == VK_NULL_HANDLE) {
+		shVkError(
+			shGetPushDescriptorSetFunction(device, &p_pipeline_pool->cmd_push_descriptor_set) == 0,
+			"failed loading push descriptor function",
+			return 0
+		);
+	}
+
+	p_pipeline_pool->src_descriptor_set_layout_count++;
+
+	return 1;
+}
+
+uint8_t shPipelinePoolCopyDescriptorSetLayout(
+	uint32_t          src_set_layout_idx,
+	uint32_t          first_dst_set_layout_idx,
+	uint32_t          dst_set_layout_count,
+	ShVkPipelinePool* p_pipeline_pool
+) {
+	shVkArgError(p_pipeline_pool == VK_NULL_HANDLE, "invalid pipeline pool memory", return 0);
+
+	shVkArgError(
+		(first_dst_set_layout_idx + dst_set_layout_count) > SH_MAX_PIPELINE_POOL_DESCRIPTOR_COUNT,
+		"invalid descriptor set layouts range",
+		return 0
+	);
+
+	for (uint32_t set_layout_idx = first_dst_set_layout_idx; set_layout_idx < (first_dst_set_layout_idx + dst_set_layout_count); set_layout_idx++) {
+		p_pipeline_pool->descriptor_set_layouts[set_layout_idx] = p_pipeline_pool->descriptor_set_layouts[src_set_layout_idx];
+	}
+
+	return 1;
+}
+
+uint8_t shPipelinePoolCreateDescriptorPool(
+	VkDevice          device,
+	uint32_t          pool_idx,
+	VkDescriptorType  descriptor_type,
+	uint32_t          descriptor_count,
+	ShVkPipelinePool* p_pipeline_pool
+) {
+	shVkArgError(p_pipeline_pool  == VK_NULL_HANDLE, "invalid pipeline pool memory", return 0);
+	shVkArgError(descriptor_count == 0,              "invvalid descriptor count",    return 0);
+
+	VkDescriptorPoolSize pool_size = {
+		.type            = descriptor_type,
+		.descriptorCount = descriptor_count
+	};
+
+	shVkError(
+		shCreateDescriptorPool(
+			device,
+			1,
+			&pool_size,
+			&p_pipeline_pool->descriptor_pools[pool_idx]
+		) == 0,
+		"failed creating descriptor pool",
+		return 0
+	);
+
+	p_pipeline_pool->descriptor_pool_count++;
+
+	return 1;
+}
+
+uint8_t shPipelinePoolAllocateDescriptorSetUnits(
+	VkDevice          device,
+	uint32_t          binding,
+	uint32_t          pool_idx,
+	VkDescriptorType  descriptor_type,
+	uint32_t          first_descriptor_set_unit,
+	uint32_t          descriptor_set_unit_count,
+	ShVkPipelinePool* p_pipeline_pool
+) {
+	shVkArgError(p_pipeline_pool == VK_NULL_HANDLE, "invalid pipeline pool memory", return 0);
+
+	shVkArgError(
+		(first_descriptor_set_unit + descriptor_set_unit_count) > SH_MAX_PIPELINE_POOL_DESCRIPTOR_COUNT,
+		"invalid descriptor set range",
+		return 0
+	);
+
+	shVkError(
+		shAllocateDescriptorSetUnits(
+			device,
+			p_pipeline_pool->descriptor_pools[pool_idx],
+			descriptor_type,
+			binding,
+			descriptor_set_unit_count,
+			&p_pipeline_pool->descriptor_set_layouts[first_descriptor_set_unit],
+			&p_pipeline_pool->descriptor_sets[first_descriptor_set_unit],
+			&p_pipeline_pool->descriptor_buffer_infos[first_descriptor_set_unit],
+			&p_pipeline_pool->descriptor_image_infos[first_descriptor_set_unit],
+			&p_pipeline_pool->write_descriptor_sets[first_descriptor_set_unit]
+		) == 0,
+		"failed allocating descriptor set",
+		return 0
+	);
+
+	p_pipeline_pool->write_descriptor_set_count += descriptor_set_unit_count;
+	p_pipeline_pool->descriptor_set_unit_count  += descriptor_set_unit_count;
+
+	return 1;
+}
+
+uint8_t shPipelinePoolSetDescriptorBufferInfos(
+	uint32_t          first_descriptor,
+	uint32_t          descriptor_count,
+	VkBuffer          buffer,
+	uint32_t          buffer_offset,
+	uint32_t          buffer_size,
+	ShVkPipelinePool* p_pipeline_pool
+) {
+	shVkArgError(p_pipeline_pool == VK_NULL_HANDLE, "invalid pipeline pool memory", return 0);
+
+	shVkArgError(
+		(first_descriptor + descriptor_count) > SH_MAX_PIPELINE_POOL_DESCRIPTOR_COUNT,
+		"reached max pipeline descriptor buffer info count",
+		return 0
+	);
+
+	for (uint32_t descriptor_idx = first_descriptor; descriptor_idx < (first_descriptor + descriptor_count); descriptor_idx++) {
+		shVkError(
+			shSetDescriptorBufferInfo(
+				buffer,
+				buffer_offset,
+				buffer_size,
+				&p_pipeline_pool->descriptor_buffer_infos[descriptor_idx]
+			) == 0,
+			"failed setting descriptor buffer info",
+			return 0
+		);
+	}
+
+	return 1;
+}
+
+uint8_t shPipelinePoolSetDescriptorImageInfos(
+	uint32_t          first_descriptor,
+	uint32_t          descriptor_count,
+	VkSampler         sampler,
+	VkImageView       image_view,
+	VkImageLayout     image_layout,
+	ShVkPipelinePool* p_pipeline_pool
+) {
+	shVkArgError(p_pipeline_pool == VK_NULL_HANDLE, "invalid pipeline pool memory", return 0);
+
+	shVkArgError(
+		(first_descriptor + descriptor_count) > SH_MAX_PIPELINE_POOL_DESCRIPTOR_COUNT,
+		"reached max pipeline descriptor image info count",
+		return 0
+	);
+
+	for (uint32_t descriptor_idx = first_descriptor; descriptor_idx < (first_descriptor + descriptor_count); descriptor_idx++) {
+		shVkError(
+			shSetDescriptorImageInfo(
+				sampler,
+				image_view,
+				image_layout,
+				&p_pipeline_pool->descriptor_image_infos[descriptor_idx]
+			) == 0,
+			"failed setting descriptor image info",
+			return 0
+		);
+	}
+
+	return 1;
+}
+
+//uint8_t shReadShaderSourceCodeArgs(
+//	char*                       p_source_code,
+//	uint32_t                    code_size,
+//	const char*                 declaration_block,
+//	uint32_t*                   p_declaration_block_count,
+//	uint32_t                    declaration_arg_count,
+//	uint32_t*                   p_working_declaration_arg_values
+//) {
+//	shVkError(p_source_code                    == NULL, "invalid shader source code memory",      return 0);
+//	shVkError(declaration_block                == NULL, "invalid declaration block memory",       return 0);
+//	shVkError(p_declaration_block_count        == NULL, "invalid declaration block count memory", return 0);
+//	shVkError(p_working_declaration_arg_values == NULL, "invalid declaration arg values memory",  return 0);
+//	
+//	uint32_t declaration_arg_idx  = 0;
+//	uint32_t declaration_block_idx        = 0;
 //
-//		shVkError(
-//			shPipelineSetVertexAttribute(location, binding, format, offset, p_pipeline) == 0,
-//			"failed setting vertex attribute",
-//			return 0
-//		);
-//	}
+//	for (uint32_t char_idx = 0; char_idx < code_size; char_idx++) {
 //
-//	//
-//	//PUSH CONSTANTS
-//	//
-//	for (uint32_t push_constant_idx = 0; push_constant_idx < push_constant_count; push_constant_idx++) {//actually only one is allowed
-//		uint32_t offset = push_constant_arg_values[SH_PIPELINE_MAX_DECLARATION_BLOCK_ARG_COUNT * push_constant_idx + 0];//_offset
-//		uint32_t size   = push_constant_arg_values[SH_PIPELINE_MAX_DECLARATION_BLOCK_ARG_COUNT * push_constant_idx + 1];//_size
+//		char*    p_current_token = &p_source_code[char_idx];
+//		uint32_t remaining_bytes = code_size - char_idx;//remaining source code bytes, exluding the current byte
 //
-//		shVkError(
-//			shPipelineSetPushConstants(shader_stage, offset, size, p_pipeline) == 0,
-//			"failed setting push constant range",
-//			return 0
-//		);
-//	}
+//		if ((*p_current_token) == ' ') {
+//			p_current_token++;
+//		}
+//
+//		if (remaining_bytes > strlen(declaration_block)) {
+//			if ((*p_current_token) == ',') {
+//				p_current_token++;
+//				declaration_arg_idx++;
+//			}
+//			if (declaration_block_idx != (*p_declaration_block_count)) {
+//				
+//				if (declaration_arg_idx < declaration_arg_count) {
+//					char* p_last_value_char = NULL;
+//					p_working_declaration_arg_values[declaration_block_idx * SH_PIPELINE_MAX_DECLARATION_BLOCK_ARG_COUNT + declaration_arg_idx] 
+//						= strtol(p_current_token, &p_last_value_char, 10);
+//					char_idx += (uint32_t)(p_last_value_char - p_current_token);
+//				}
+//				else {
+//					declaration_block_idx++;
+//				}
+//			}
+//
+//			if (memcmp(p_current_token, declaration_block, strlen(declaration_block)) == 0) {
+//				declaration_block_idx = (*p_declaration_block_count);
+//				declaration_arg_idx   = 0;//reset args
+//				(*p_declaration_block_count)++;
+//				char_idx += (uint32_t)strlen(declaration_block) - 1;//-1 because is followed by char_idx++
+//			}
+//
+//		}
+//
+//	}
+//
+//	return 0;
+//}
+//
+//uint8_t shParseShaderSourceCode(
+//	char*              p_source_code,
+//	uint32_t           code_size,
+//	uint32_t           swapchain_image_count,
+//	VkShaderStageFlags shader_stage,
+//	ShVkPipeline*      p_pipeline
+//) {
+//	shVkError(p_source_code == NULL, "invalid shader source code memory", return 0);
+//
+//	uint32_t vertex_binding_count                = 0;
+//	uint32_t vertex_attribute_count              = 0;
+//	uint32_t push_constant_count                 = 0;
+//	uint32_t descriptor_set_layout_binding_count = 0;
+//	uint32_t descriptor_set_count                = 0;
+//
+//	uint32_t vertex_binding_arg_values                [SH_MAX_PIPELINE_VERTEX_BINDING_COUNT                * SH_PIPELINE_MAX_DECLARATION_BLOCK_ARG_COUNT] = { 0 };
+//	uint32_t vertex_attribute_arg_values              [SH_MAX_PIPELINE_VERTEX_ATTRIBUTE_COUNT              * SH_PIPELINE_MAX_DECLARATION_BLOCK_ARG_COUNT] = { 0 };
+//	uint32_t push_constant_arg_values                 [1                                                   * SH_PIPELINE_MAX_DECLARATION_BLOCK_ARG_COUNT] = { 0 };
+//	uint32_t descriptor_set_layout_binding_arg_values [SH_MAX_PIPELINE_DESCRIPTOR_SET_LAYOUT_BINDING_COUNT * SH_PIPELINE_MAX_DECLARATION_BLOCK_ARG_COUNT] = { 0 };
+//	uint32_t descriptor_set_arg_values                [SH_MAX_PIPELINE_DESCRIPTOR_SET_COUNT                * SH_PIPELINE_MAX_DECLARATION_BLOCK_ARG_COUNT] = { 0 };
+//
+//	shReadShaderSourceCodeArgs(
+//		p_source_code, code_size, SH_PIPELINE_VERTEX_BINDING_DECLARATION_BLOCK,
+//		&vertex_binding_count, SH_PARSER_VERTEX_BINDING_ARG_COUNT,
+//		vertex_binding_arg_values
+//	);
+//
+//	shReadShaderSourceCodeArgs(
+//		p_source_code, code_size, SH_PIPELINE_VERTEX_ATTRIBUTE_DECLARATION_BLOCK,
+//		&vertex_attribute_count, SH_PARSER_VERTEX_ATTRIBUTE_ARG_COUNT,
+//		vertex_attribute_arg_values
+//	);
+//
+//	shReadShaderSourceCodeArgs(
+//		p_source_code, code_size, SH_PIPELINE_PUSH_CONSTANT_DECLARATION_BLOCK,
+//		&push_constant_count, SH_PARSER_PUSH_CONSTANT_ARG_COUNT,
+//		push_constant_arg_values
+//	);
+//
+//	shReadShaderSourceCodeArgs(
+//		p_source_code, code_size, SH_PIPELINE_DESCRIPTOR_SET_LAYOUT_BINDING_DECLARATION_BLOCK,
+//		&descriptor_set_layout_binding_count, SH_PARSER_DESCRIPTOR_SET_LAYOUT_BINDING_ARG_COUNT,
+//		descriptor_set_layout_binding_arg_values
+//	);
+//
+//	shReadShaderSourceCodeArgs(
+//		p_source_code, code_size, SH_PIPELINE_DESCRIPTOR_SET_DECLARATION_BLOCK,
+//		&descriptor_set_count, SH_PARSER_DESCRIPTOR_SET_ARG_COUNT,
+//		descriptor_set_arg_values
+//	);
+//
+//	//
+//	//VERTEX BINDING
+//	//
+//	for (uint32_t vertex_binding_idx = 0; vertex_binding_idx < vertex_binding_count; vertex_binding_idx++) {
+//
+//		uint32_t binding             = vertex_binding_arg_values[SH_PIPELINE_MAX_DECLARATION_BLOCK_ARG_COUNT * vertex_binding_idx + 0];//_binding
+//		uint32_t size                = vertex_binding_arg_values[SH_PIPELINE_MAX_DECLARATION_BLOCK_ARG_COUNT * vertex_binding_idx + 1];//_size
+//		uint32_t input_rate_vertex   = vertex_binding_arg_values[SH_PIPELINE_MAX_DECLARATION_BLOCK_ARG_COUNT * vertex_binding_idx + 2];//_is_input_rate_vertex
+//		uint32_t input_rate_instance = vertex_binding_arg_values[SH_PIPELINE_MAX_DECLARATION_BLOCK_ARG_COUNT * vertex_binding_idx + 3];//_is_input_rate_instance
+//		
+//		VkVertexInputRate vertex_input_rate         = VK_VERTEX_INPUT_RATE_MAX_ENUM;
+//		(input_rate_vertex)   && (vertex_input_rate = VK_VERTEX_INPUT_RATE_VERTEX);
+//		(input_rate_instance) && (vertex_input_rate = VK_VERTEX_INPUT_RATE_INSTANCE);
+//
+//		shVkError(
+//			shPipelineSetVertexBinding(binding, size, vertex_input_rate, p_pipeline) == 0,
+//			"failed setting vertex binding",
+//			return 0
+//		);
+//	}
+//
+//	//
+//	//VERTEX ATTRIBUTE
+//	//
+//	for (uint32_t vertex_attribute_idx = 0; vertex_attribute_idx < vertex_attribute_count; vertex_attribute_idx++) {
+//		uint32_t binding  = vertex_attribute_arg_values[SH_PIPELINE_MAX_DECLARATION_BLOCK_ARG_COUNT * vertex_attribute_idx + 0];//_binding
+//		uint32_t location = vertex_attribute_arg_values[SH_PIPELINE_MAX_DECLARATION_BLOCK_ARG_COUNT * vertex_attribute_idx + 1];//_location
+//		uint32_t offset   = vertex_attribute_arg_values[SH_PIPELINE_MAX_DECLARATION_BLOCK_ARG_COUNT * vertex_attribute_idx + 2];//_offset
+//		uint32_t size     = vertex_attribute_arg_values[SH_PIPELINE_MAX_DECLARATION_BLOCK_ARG_COUNT * vertex_attribute_idx + 3];//_size
+//
+//		VkFormat format   = VK_FORMAT_MAX_ENUM;
+//
+//		//hmm not precise
+//		     if (size == 4)  { format = VK_FORMAT_R32_SFLOAT; }
+//		else if (size == 8)  { format = VK_FORMAT_R32G32_SFLOAT; }
+//		else if (size == 12) { format = VK_FORMAT_R32G32B32_SFLOAT; }
+//		else                 { format = VK_FORMAT_R32G32B32A32_SFLOAT; }
+//
+//		shVkError(
+//			shPipelineSetVertexAttribute(location, binding, format, offset, p_pipeline) == 0,
+//			"failed setting vertex attribute",
+//			return 0
+//		);
+//	}
 //
 //	//
-//	//DESCRIPTOR SET LAYOUT BINDINGS
-//	//
+//	//PUSH CONSTANTS
+//	//
+//	for (uint32_t push_constant_idx = 0; push_constant_idx < push_constant_count; push_constant_idx++) {//actually only one is allowed
+//		uint32_t offset = push_constant_arg_values[SH_PIPELINE_MAX_DECLARATION_BLOCK_ARG_COUNT * push_constant_idx + 0];//_offset
+//		uint32_t size   = push_constant_arg_values[SH_PIPELINE_MAX_DECLARATION_BLOCK_ARG_COUNT * push_constant_idx + 1];//_size
+//
+//		shVkError(
+//			shPipelineSetPushConstants(shader_stage, offset, size, p_pipeline) == 0,
+//			"failed setting push constant range",
+//			return 0
+//		);
+//	}
+//
+//	//
+//	//DESCRIPTOR SET LAYOUT BINDINGS
+//	//
 //	for (uint32_t set_layout_binding_idx = 0; set_layout_binding_idx < descriptor_set_layout_binding_count; set_layout_binding_idx++) {
 //		uint32_t binding    = descriptor_set_layout_binding_arg_values[SH_PIPELINE_MAX_DECLARATION_BLOCK_ARG_COUNT * set_layout_binding_idx + 0];//_binding
 //		uint32_t desc_type  = descriptor_set_layout_binding_arg_values[SH_PIPELINE_MAX_DECLARATION_BLOCK_ARG_COUNT * set_layout_binding_idx + 1];//_descriptor_type
@@ -4265,21 +6919,3450 @@ uint8_t shPipelinePoolSetDescriptorBufferInfos(
 //	return 1;
 //}
 
-uint8_t shPipelinePoolDestroyDescriptorSetLayouts(
-	VkDevice          device,
-	uint32_t          first_set_layout,
-	uint32_t          set_layout_count,
-	ShVkPipelinePool* p_pipeline_pool
+uint8_t shPipelinePoolDestroyDescriptorSetLayouts(
+	VkDevice          device,
+	uint32_t          first_set_layout,
+	uint32_t          set_layout_count,
+	ShVkPipelinePool* p_pipeline_pool
+) {
+	shVkArgError(p_pipeline_pool == VK_NULL_HANDLE, "invalid pipeline pool memory", return 0);
+
+	for (uint32_t set_layout_idx = first_set_layout; set_layout_idx < (first_set_layout + set_layout_count); set_layout_idx++) {
+		shVkError(
+			shDestroyDescriptorSetLayout(
+				device,
+				p_pipeline_pool->descriptor_set_layouts[set_layout_idx]
+			) == 0,
+			"failed destroying descriptor set layout",
+			return 0
+		);
+	}
+
+	return 1;
+}
+
+uint8_t shPipelinePoolDestroyDescriptorPools(
+	VkDevice          device,
+	uint32_t          first_pool,
+	uint32_t          pool_count,
+	ShVkPipelinePool* p_pipeline_pool
+) {
+	shVkArgError(p_pipeline_pool == VK_NULL_HANDLE, "invalid pipeline memory", return 0);
+
+	shVkError(
+		first_pool + pool_count > p_pipeline_pool->descriptor_pool_count,
+		"invalid descriptor pool range",
+		return 0
+	);
+
+	for (uint32_t pool_idx = first_pool; pool_idx < (first_pool + pool_count); pool_idx++) {
+		shVkError(
+			shDestroyDescriptorPool(
+				device,
+				p_pipeline_pool->descriptor_pools[pool_idx]
+			) == 0,
+			"failed destroying descriptor pool",
+			return 0
+		);
+	}
+
+	p_pipeline_pool->descriptor_pool_count -= pool_count;
+
+	return 1;
+}
+
+uint8_t shPipelinePoolUpdateDescriptorSetUnits(
+	VkDevice          device,
+	uint32_t          first_descriptor_set_unit,
+	uint32_t          descriptor_set_unit_count,
+	ShVkPipelinePool* p_pipeline_pool
+) {
+	shVkArgError(device == VK_NULL_HANDLE, "invalid device memory", return 0);
+	shVkArgError(p_pipeline_pool == VK_NULL_HANDLE, "invalid pipeline pool memory", return 0);
+
+	shVkError(
+		(first_descriptor_set_unit + descriptor_set_unit_count) > p_pipeline_pool->descriptor_set_unit_count,
+		"invalid descriptors range",
+		return 0
+	);
+
+	vkUpdateDescriptorSets(
+		device,
+		descriptor_set_unit_count,
+		&p_pipeline_pool->write_descriptor_sets[first_descriptor_set_unit],
+		0,
+		VK_NULL_HANDLE
+	);
+
+	return 1;
+}
+
+uint8_t shPipelinePoolCreateDescriptorUpdateTemplate(
+	VkDevice          device,
+	uint32_t          first_binding_idx,
+	uint32_t          binding_count,
+	uint32_t          set_layout_idx,
+	ShVkPipelinePool* p_pipeline_pool
+) {
+	shVkArgError(p_pipeline_pool == VK_NULL_HANDLE, "invalid pipeline pool memory", return 0);
+	shVkArgError(binding_count   == 0,              "invalid binding count",        return 0);
+
+	shVkArgError(
+		(first_binding_idx + binding_count) > SH_MAX_PIPELINE_POOL_DESCRIPTOR_COUNT,
+		"invalid descriptor set layout binding range",
+		return 0
+	);
+
+	shVkArgError(
+		set_layout_idx >= SH_MAX_PIPELINE_POOL_DESCRIPTOR_COUNT,
+		"invalid descriptor set layout index",
+		return 0
+	);
+
+	shVkError(
+		p_pipeline_pool->descriptor_set_layouts[set_layout_idx] == VK_NULL_HANDLE,
+		"invalid descriptor set layout memory, create the set layout before its template",
+		return 0
+	);
+
+	//recreating the template of a set layout replaces the previous one
+	if (p_pipeline_pool->descriptor_update_templates[set_layout_idx] != VK_NULL_HANDLE) {
+		shVkError(
+			shPipelinePoolDestroyDescriptorUpdateTemplates(device, set_layout_idx, 1, p_pipeline_pool) == 0,
+			"failed destroying previous descriptor update template",
+			return 0
+		);
+	}
+
+	VkDescriptorUpdateTemplateEntry entries[SH_MAX_PIPELINE_POOL_DESCRIPTOR_COUNT] = { 0 };
+
+	uint32_t offset = 0;
+
+	for (uint32_t entry_idx = 0; entry_idx < binding_count; entry_idx++) {
+		VkDescriptorSetLayoutBinding* p_binding = &p_pipeline_pool->descriptor_set_layout_bindings[first_binding_idx + entry_idx];
+
+		uint32_t stride = 0;
+		shVkError(
+			shGetDescriptorInfoSize(p_binding->descriptorType, &stride) == 0,
+			"failed retrieving descriptor info size",
+			return 0
+		);
+
+		shVkError(
+			shCreateDescriptorUpdateTemplateEntry(
+				p_binding->binding,
+				0,
+				p_binding->descriptorCount,
+				p_binding->descriptorType,
+				offset,
+				stride,
+				&entries[entry_idx]
+			) == 0,
+			"failed creating descriptor update template entry",
+			return 0
+		);
+
+		offset += stride * p_binding->descriptorCount;
+	}
+
+	shVkError(
+		shCreateDescriptorUpdateTemplate(
+			device,
+			binding_count,
+			entries,
+			p_pipeline_pool->descriptor_set_layouts     [set_layout_idx],
+			&p_pipeline_pool->descriptor_update_templates[set_layout_idx]
+		) == 0,
+		"failed creating descriptor update template",
+		return 0
+	);
+
+	p_pipeline_pool->descriptor_update_template_count++;
+
+	return 1;
+}
+
+uint8_t shPipelinePoolUpdateDescriptorSetUnitsWithTemplate(
+	VkDevice          device,
+	uint32_t          set_layout_idx,
+	uint32_t          first_descriptor_set_unit,
+	uint32_t          descriptor_set_unit_count,
+	uint32_t          data_stride,
+	void*             p_data,
+	ShVkPipelinePool* p_pipeline_pool
+) {
+	shVkArgError(device          == VK_NULL_HANDLE, "invalid device memory",         return 0);
+	shVkArgError(p_data          == VK_NULL_HANDLE, "invalid descriptor data memory", return 0);
+	shVkArgError(p_pipeline_pool == VK_NULL_HANDLE, "invalid pipeline pool memory",  return 0);
+
+	shVkArgError(
+		set_layout_idx >= SH_MAX_PIPELINE_POOL_DESCRIPTOR_COUNT,
+		"invalid descriptor set layout index",
+		return 0
+	);
+
+	shVkError(
+		(first_descriptor_set_unit + descriptor_set_unit_count) > p_pipeline_pool->descriptor_set_unit_count,
+		"invalid descriptors range",
+		return 0
+	);
+
+	VkDescriptorUpdateTemplate descriptor_update_template = p_pipeline_pool->descriptor_update_templates[set_layout_idx];
+
+	shVkError(
+		descriptor_update_template == VK_NULL_HANDLE,
+		"invalid descriptor update template memory",
+		return 0
+	);
+
+	for (uint32_t set_unit_idx = first_descriptor_set_unit; set_unit_idx < (first_descriptor_set_unit + descriptor_set_unit_count); set_unit_idx++) {
+		shVkError(
+			p_pipeline_pool->descriptor_set_layouts[set_unit_idx] != p_pipeline_pool->descriptor_set_layouts[set_layout_idx],
+			"descriptor set unit does not use the set layout of the descriptor update template",
+			return 0
+		);
+	}
+
+	uint8_t* p_unit_data = (uint8_t*)p_data;
+
+	for (uint32_t set_unit_idx = first_descriptor_set_unit; set_unit_idx < (first_descriptor_set_unit + descriptor_set_unit_count); set_unit_idx++) {
+		vkUpdateDescriptorSetWithTemplate(
+			device,
+			p_pipeline_pool->descriptor_sets[set_unit_idx],
+			descriptor_update_template,
+			p_unit_data
+		);
+		p_unit_data += data_stride;
+	}
+
+	return 1;
+}
+
+uint8_t shPipelinePoolDestroyDescriptorUpdateTemplates(
+	VkDevice          device,
+	uint32_t          first_template,
+	uint32_t          template_count,
+	ShVkPipelinePool* p_pipeline_pool
+) {
+	shVkArgError(p_pipeline_pool == VK_NULL_HANDLE, "invalid pipeline pool memory", return 0);
+
+	shVkArgError(
+		(first_template + template_count) > SH_MAX_PIPELINE_POOL_DESCRIPTOR_COUNT,
+		"invalid descriptor update template range",
+		return 0
+	);
+
+	for (uint32_t template_idx = first_template; template_idx < (first_template + template_count); template_idx++) {
+		if (p_pipeline_pool->descriptor_update_templates[template_idx] == VK_NULL_HANDLE) {
+			continue;
+		}
+		shVkError(
+			shDestroyDescriptorUpdateTemplate(
+				device,
+				p_pipeline_pool->descriptor_update_templates[template_idx]
+			) == 0,
+			"failed destroying descriptor update template",
+			return 0
+		);
+		p_pipeline_pool->descriptor_update_templates[template_idx] = VK_NULL_HANDLE;
+		p_pipeline_pool->descriptor_update_template_count--;
+	}
+
+	return 1;
+}
+
+
+
+uint8_t shCreateMultiDevice(
+	VkInstance                        instance,
+	ShVkPhysicalDeviceBenchmarkCache* p_benchmark_cache,
+	uint32_t                          extension_count,
+	char**                            pp_extension_names,
+	ShVkMultiDevice*                  p_multi_device
+) {
+	shVkArgError(instance       == VK_NULL_HANDLE, "invalid instance memory",     return 0);
+	shVkArgError(p_multi_device == VK_NULL_HANDLE, "invalid multi device memory", return 0);
+
+	uint32_t         physical_device_count = 0;
+	VkPhysicalDevice physical_devices[SH_MAX_STACK_PHYSICAL_DEVICE_COUNT] = { 0 };
+
+	shVkError(
+		shRankPhysicalDevices(
+			instance,
+			VK_NULL_HANDLE,
+			VK_QUEUE_COMPUTE_BIT,
+			p_benchmark_cache,
+			&physical_device_count,
+			physical_devices
+		) == 0,
+		"failed ranking physical devices",
+		return 0
+	);
+
+	for (uint32_t device_idx = 0; device_idx < physical_device_count; device_idx++) {
+		VkPhysicalDevice physical_device = physical_devices[device_idx];
+
+		uint32_t                queue_family_count = 0;
+		VkQueueFamilyProperties queue_families_properties[SH_MAX_STACK_QUEUE_FAMILY_COUNT] = { 0 };
+
+		shGetPhysicalDeviceQueueFamilies(
+			physical_device, VK_NULL_HANDLE,
+			&queue_family_count,
+			VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE,
+			VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE,
+			queue_families_properties
+		);
+
+		//prefer a compute family without graphics
+		uint32_t queue_family_index = queue_family_count;
+		for (uint32_t queue_family_idx = 0; queue_family_idx < queue_family_count; queue_family_idx++) {
+			VkQueueFlags queue_flags = queue_families_properties[queue_family_idx].queueFlags;
+			if (!(queue_flags & VK_QUEUE_COMPUTE_BIT)) {
+				continue;
+			}
+			if (queue_family_index == queue_family_count || !(queue_flags & VK_QUEUE_GRAPHICS_BIT)) {
+				queue_family_index = queue_family_idx;
+			}
+			if (!(queue_flags & VK_QUEUE_GRAPHICS_BIT)) {
+				break;
+			}
+		}
+		shVkError(
+			queue_family_index == queue_family_count,
+			"no compute queue family found",
+			shDestroyMultiDevice(p_multi_device); return 0
+		);
+
+		float                   queue_priority = 1.0f;
+		VkDeviceQueueCreateInfo queue_info     = { 0 };
+		shQueryForDeviceQueueInfo(queue_family_index, 1, &queue_priority, 0, &queue_info);
+
+		VkDevice device = VK_NULL_HANDLE;
+		shVkError(
+			shSetLogicalDevice(physical_device, &device, extension_count, pp_extension_names, 1, &queue_info, VK_NULL_HANDLE) == 0,
+			"failed creating logical device",
+			shDestroyMultiDevice(p_multi_device); return 0
+		);
+
+		uint32_t slot_idx = p_multi_device->device_count;
+		p_multi_device->physical_devices    [slot_idx] = physical_device;
+		p_multi_device->devices             [slot_idx] = device;
+		p_multi_device->queue_family_indices[slot_idx] = queue_family_index;
+		p_multi_device->throughputs         [slot_idx] = 1.0f;
+		p_multi_device->device_count++;
+
+		vkGetDeviceQueue(device, queue_family_index, 0, &p_multi_device->queues[slot_idx]);
+
+		shVkError(
+			shCreateCommandPool(device, queue_family_index, &p_multi_device->cmd_pools[slot_idx]) == 0,
+			"failed creating command pool",
+			shDestroyMultiDevice(p_multi_device); return 0
+		);
+		shVkError(
+			shAllocateCommandBuffers(device, p_multi_device->cmd_pools[slot_idx], 1, &p_multi_device->cmd_buffers[slot_idx]) == 0,
+			"failed allocating command buffer",
+			shDestroyMultiDevice(p_multi_device); return 0
+		);
+		shVkError(
+			shCreateFences(device, 1, 0, &p_multi_device->fences[slot_idx]) == 0,
+			"failed creating fence",
+			shDestroyMultiDevice(p_multi_device); return 0
+		);
+
+		if (queue_families_properties[queue_family_index].timestampValidBits != 0) {
+			VkPhysicalDeviceProperties physical_device_properties = { 0 };
+			vkGetPhysicalDeviceProperties(physical_device, &physical_device_properties);
+
+			VkQueryPoolCreateInfo query_pool_create_info = {
+				.sType              = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO, //sType;
+				.pNext              = VK_NULL_HANDLE,                           //pNext;
+				.flags              = 0,                                        //flags;
+				.queryType          = VK_QUERY_TYPE_TIMESTAMP,                  //queryType;
+				.queryCount         = 2,                                        //queryCount;
+				.pipelineStatistics = 0                                         //pipelineStatistics;
+			};
+			shVkResultError(
+				vkCreateQueryPool(device, &query_pool_create_info, VK_NULL_HANDLE, &p_multi_device->query_pools[slot_idx]),
+				"failed creating query pool",
+				shDestroyMultiDevice(p_multi_device); return 0
+			);
+			p_multi_device->timestamp_periods[slot_idx] = physical_device_properties.limits.timestampPeriod;
+		}
+
+		if (p_benchmark_cache != VK_NULL_HANDLE) {
+			float copy_bandwidth = 0.0f;
+			if (shBenchmarkPhysicalDevice(physical_device, p_benchmark_cache, &copy_bandwidth) && copy_bandwidth > 0.0f) {
+				p_multi_device->throughputs[slot_idx] = copy_bandwidth;
+			}
+		}
+	}
+
+	return 1;
+}
+
+uint8_t shMultiDevicePartitionWork(
+	uint32_t         work_unit_count,
+	uint32_t         work_unit_alignment,
+	ShVkMultiDevice* p_multi_device
+) {
+	shVkArgError(p_multi_device               == VK_NULL_HANDLE, "invalid multi device memory", return 0);
+
+	shVkError(p_multi_device->device_count == 0,              "invalid device count",        return 0);
+
+	shVkArgError(work_unit_alignment          == 0,              "invalid work unit alignment", return 0);
+
+	//clamp the weights, a device starved by a stale measurement would never be measured again
+	float max_throughput = 0.0f;
+	for (uint32_t device_idx = 0; device_idx < p_multi_device->device_count; device_idx++) {
+		if (p_multi_device->throughputs[device_idx] > max_throughput) {
+			max_throughput = p_multi_device->throughputs[device_idx];
+		}
+	}
+
+	double total_throughput = 0.0;
+	for (uint32_t device_idx = 0; device_idx < p_multi_device->device_count; device_idx++) {
+		if (p_multi_device->throughputs[device_idx] < max_throughput * SH_MULTI_DEVICE_MIN_THROUGHPUT_RATIO) {
+			p_multi_device->throughputs[device_idx] = max_throughput * SH_MULTI_DEVICE_MIN_THROUGHPUT_RATIO;
+		}
+		total_throughput += (double)p_multi_device->throughputs[device_idx];
+	}
+
+	uint32_t first_work_unit = 0;
+	for (uint32_t device_idx = 0; device_idx < p_multi_device->device_count; device_idx++) {
+		uint32_t share = work_unit_count - first_work_unit;
+
+		if (device_idx + 1 < p_multi_device->device_count) {
+			double ratio = (total_throughput > 0.0) ?
+				(double)p_multi_device->throughputs[device_idx] / total_throughput :
+				1.0 / (double)p_multi_device->device_count;
+
+			uint32_t proportional_share = (uint32_t)((double)work_unit_count * ratio);
+			proportional_share -= proportional_share % work_unit_alignment;
+
+			share = (proportional_share < share) ? proportional_share : share;
+		}
+
+		p_multi_device->first_work_units[device_idx] = first_work_unit;
+		p_multi_device->work_unit_counts[device_idx] = share;
+		first_work_unit += share;
+	}
+
+	return 1;
+}
+
+uint8_t shMultiDeviceBeginCommandBuffers(
+	ShVkMultiDevice* p_multi_device
+) {
+	shVkArgError(p_multi_device == VK_NULL_HANDLE, "invalid multi device memory", return 0);
+
+	for (uint32_t device_idx = 0; device_idx < p_multi_device->device_count; device_idx++) {
+		VkCommandBuffer cmd_buffer = p_multi_device->cmd_buffers[device_idx];
+		VkQueryPool     query_pool = p_multi_device->query_pools[device_idx];
+
+		shVkError(shBeginCommandBuffer(cmd_buffer) == 0, "failed beginning command buffer", return 0);
+
+		if (query_pool != VK_NULL_HANDLE) {
+			vkCmdResetQueryPool(cmd_buffer, query_pool, 0, 2);
+			vkCmdWriteTimestamp(cmd_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, query_pool, 0);
+		}
+	}
+
+	return 1;
+}
+
+uint8_t shMultiDeviceEndCommandBuffers(
+	ShVkMultiDevice* p_multi_device
+) {
+	shVkArgError(p_multi_device == VK_NULL_HANDLE, "invalid multi device memory", return 0);
+
+	for (uint32_t device_idx = 0; device_idx < p_multi_device->device_count; device_idx++) {
+		VkCommandBuffer cmd_buffer = p_multi_device->cmd_buffers[device_idx];
+		VkQueryPool     query_pool = p_multi_device->query_pools[device_idx];
+
+		if (query_pool != VK_NULL_HANDLE) {
+			vkCmdWriteTimestamp(cmd_buffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, query_pool, 1);
+		}
+
+		shVkError(shEndCommandBuffer(cmd_buffer) == 0, "failed ending command buffer", return 0);
+	}
+
+	return 1;
+}
+
+uint8_t shMultiDeviceSubmit(
+	ShVkMultiDevice* p_multi_device
+) {
+	shVkArgError(p_multi_device == VK_NULL_HANDLE, "invalid multi device memory", return 0);
+
+	for (uint32_t device_idx = 0; device_idx < p_multi_device->device_count; device_idx++) {
+		shVkError(
+			shQueueSubmit(
+				1, &p_multi_device->cmd_buffers[device_idx],
+				p_multi_device->queues[device_idx],
+				p_multi_device->fences[device_idx],
+				0, VK_NULL_HANDLE,
+				VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+				0, VK_NULL_HANDLE
+			) == 0,
+			"failed submitting multi device command buffer",
+			return 0
+		);
+	}
+
+	float   throughputs[SH_MAX_MULTI_DEVICE_COUNT] = { 0 };
+	uint8_t measured = 1;
+
+	for (uint32_t device_idx = 0; device_idx < p_multi_device->device_count; device_idx++) {
+		VkDevice device = p_multi_device->devices[device_idx];
+
+		shVkError(
+			shWaitForFences(device, 1, &p_multi_device->fences[device_idx], 1, UINT64_MAX) == 0,
+			"failed waiting for multi device fence",
+			return 0
+		);
+		shVkError(
+			shResetFences(device, 1, &p_multi_device->fences[device_idx]) == 0,
+			"failed resetting multi device fence",
+			return 0
+		);
+
+		VkQueryPool query_pool    = p_multi_device->query_pools[device_idx];
+		uint64_t    timestamps[2] = { 0 };
+
+		if (query_pool == VK_NULL_HANDLE ||
+			vkGetQueryPoolResults(
+				device, query_pool, 0, 2,
+				sizeof(timestamps), timestamps, sizeof(uint64_t),
+				VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT
+			) != VK_SUCCESS) {
+			measured = 0;
+			continue;
+		}
+
+		//no work: the weight is clamped to the minimum below, so the device gets a share again
+		if (p_multi_device->work_unit_counts[device_idx] == 0) {
+			continue;
+		}
+
+		double elapsed_ns = (double)(timestamps[1] - timestamps[0]) * (double)p_multi_device->timestamp_periods[device_idx];
+		elapsed_ns = elapsed_ns < 1.0 ? 1.0 : elapsed_ns;
+
+		throughputs[device_idx] = (float)((double)p_multi_device->work_unit_counts[device_idx] / elapsed_ns);
+	}
+
+	//mixing measured and default weights would skew the partition, only devices without timestamps prevent the update
+	if (measured) {
+		float max_throughput = 0.0f;
+		for (uint32_t device_idx = 0; device_idx < p_multi_device->device_count; device_idx++) {
+			if (throughputs[device_idx] > max_throughput) {
+				max_throughput = throughputs[device_idx];
+			}
+		}
+		if (max_throughput > 0.0f) {
+			for (uint32_t device_idx = 0; device_idx < p_multi_device->device_count; device_idx++) {
+				float min_throughput = max_throughput * SH_MULTI_DEVICE_MIN_THROUGHPUT_RATIO;
+				p_multi_device->throughputs[device_idx] = throughputs[device_idx] < min_throughput ? min_throughput : throughputs[device_idx];
+			}
+		}
+	}
+
+	return 1;
+}
+
+uint8_t shMultiDeviceCreateBuffers(
+	uint32_t              size,
+	VkBufferUsageFlags    usage,
+	VkMemoryPropertyFlags memory_property_flags,
+	VkBuffer*             p_buffers,
+	VkDeviceMemory*       p_memories,
+	ShVkMultiDevice*      p_multi_device
+) {
+	shVkArgError(size           == 0,              "invalid buffer size",            return 0);
+	shVkArgError(p_buffers      == VK_NULL_HANDLE, "invalid buffers memory",         return 0);
+	shVkArgError(p_memories     == VK_NULL_HANDLE, "invalid buffer memories memory", return 0);
+	shVkArgError(p_multi_device == VK_NULL_HANDLE, "invalid multi device memory",    return 0);
+
+	memset(p_buffers,  0, sizeof(VkBuffer)       * p_multi_device->device_count);
+	memset(p_memories, 0, sizeof(VkDeviceMemory) * p_multi_device->device_count);
+
+	for (uint32_t device_idx = 0; device_idx < p_multi_device->device_count; device_idx++) {
+		VkDevice device = p_multi_device->devices[device_idx];
+
+		uint8_t r = shCreateBuffer(device, size, usage, VK_SHARING_MODE_EXCLUSIVE, &p_buffers[device_idx]);
+		r = r && shAllocateBufferMemory(device, p_multi_device->physical_devices[device_idx], p_buffers[device_idx], memory_property_flags, &p_memories[device_idx]);
+		r = r && shBindBufferMemory(device, p_buffers[device_idx], 0, p_memories[device_idx]);
+
+		shVkError(
+			r == 0,
+			"failed creating multi device buffer",
+			shMultiDeviceDestroyBuffers(p_buffers, p_memories, p_multi_device); return 0
+		);
+	}
+
+	return 1;
+}
+
+uint8_t shMultiDeviceScatter(
+	uint32_t              work_unit_size,
+	void*                 p_src,
+	VkDeviceMemory*       p_dst_memories,
+	uint32_t              dst_offset,
+	VkMemoryPropertyFlags memory_property_flags,
+	ShVkMultiDevice*      p_multi_device
+) {
+	shVkArgError(work_unit_size == 0,              "invalid work unit size",       return 0);
+	shVkArgError(p_src          == VK_NULL_HANDLE, "invalid source memory",        return 0);
+	shVkArgError(p_dst_memories == VK_NULL_HANDLE, "invalid destination memories", return 0);
+	shVkArgError(p_multi_device == VK_NULL_HANDLE, "invalid multi device memory",  return 0);
+
+	uint8_t host_coherent = (memory_property_flags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
+
+	for (uint32_t device_idx = 0; device_idx < p_multi_device->device_count; device_idx++) {
+		VkDevice       device       = p_multi_device->devices[device_idx];
+		VkDeviceMemory memory       = p_dst_memories[device_idx];
+		uint64_t       share_offset = (uint64_t)p_multi_device->first_work_units[device_idx] * work_unit_size;
+		uint64_t       share_size   = (uint64_t)p_multi_device->work_unit_counts[device_idx] * work_unit_size;
+
+		if (share_size == 0) {
+			continue;
+		}
+
+		//the whole memory is mapped and flushed, smaller ranges would have to be aligned to nonCoherentAtomSize
+		uint8_t* p_mapped = VK_NULL_HANDLE;
+		shVkResultError(
+			vkMapMemory(device, memory, 0, VK_WHOLE_SIZE, 0, (void**)&p_mapped),
+			"error mapping multi device share",
+			return 0
+		);
+
+		memcpy(p_mapped + dst_offset, (uint8_t*)p_src + share_offset, (size_t)share_size);
+
+		if (!host_coherent) {
+			VkMappedMemoryRange range = {
+				.sType  = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE, //sType;
+				.pNext  = VK_NULL_HANDLE,                        //pNext;
+				.memory = memory,                                //memory;
+				.offset = 0,                                     //offset;
+				.size   = VK_WHOLE_SIZE                          //size;
+			};
+			shVkResultError(
+				vkFlushMappedMemoryRanges(device, 1, &range),
+				"error flushing multi device share",
+				vkUnmapMemory(device, memory); return 0
+			);
+		}
+
+		vkUnmapMemory(device, memory);
+	}
+
+	return 1;
+}
+
+uint8_t shMultiDeviceGather(
+	uint32_t              work_unit_size,
+	VkDeviceMemory*       p_src_memories,
+	uint32_t              src_offset,
+	VkMemoryPropertyFlags memory_property_flags,
+	void*                 p_dst,
+	ShVkMultiDevice*      p_multi_device
+) {
+	shVkArgError(work_unit_size == 0,              "invalid work unit size",      return 0);
+	shVkArgError(p_src_memories == VK_NULL_HANDLE, "invalid source memories",     return 0);
+	shVkArgError(p_dst          == VK_NULL_HANDLE, "invalid destination memory",  return 0);
+	shVkArgError(p_multi_device == VK_NULL_HANDLE, "invalid multi device memory", return 0);
+
+	uint8_t host_coherent = (memory_property_flags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
+
+	for (uint32_t device_idx = 0; device_idx < p_multi_device->device_count; device_idx++) {
+		VkDevice       device       = p_multi_device->devices[device_idx];
+		VkDeviceMemory memory       = p_src_memories[device_idx];
+		uint64_t       share_offset = (uint64_t)p_multi_device->first_work_units[device_idx] * work_unit_size;
+		uint64_t       share_size   = (uint64_t)p_multi_device->work_unit_counts[device_idx] * work_unit_size;
+
+		if (share_size == 0) {
+			continue;
+		}
+
+		uint8_t* p_mapped = VK_NULL_HANDLE;
+		shVkResultError(
+			vkMapMemory(device, memory, 0, VK_WHOLE_SIZE, 0, (void**)&p_mapped),
+			"error mapping multi device share",
+			return 0
+		);
+
+		if (!host_coherent) {
+			VkMappedMemoryRange range = {
+				.sType  = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE, //sType;
+				.pNext  = VK_NULL_HANDLE,                        //pNext;
+				.memory = memory,                                //memory;
+				.offset = 0,                                     //offset;
+				.size   = VK_WHOLE_SIZE                          //size;
+			};
+			shVkResultError(
+				vkInvalidateMappedMemoryRanges(device, 1, &range),
+				"error invalidating multi device share",
+				vkUnmapMemory(device, memory); return 0
+			);
+		}
+
+		memcpy((uint8_t*)p_dst + share_offset, p_mapped + src_offset, (size_t)share_size);
+
+		vkUnmapMemory(device, memory);
+	}
+
+	return 1;
+}
+
+uint8_t shMultiDeviceDestroyBuffers(
+	VkBuffer*        p_buffers,
+	VkDeviceMemory*  p_memories,
+	ShVkMultiDevice* p_multi_device
+) {
+	shVkArgError(p_buffers      == VK_NULL_HANDLE, "invalid buffers memory",         return 0);
+	shVkArgError(p_memories     == VK_NULL_HANDLE, "invalid buffer memories memory", return 0);
+	shVkArgError(p_multi_device == VK_NULL_HANDLE, "invalid multi device memory",    return 0);
+
+	for (uint32_t device_idx = 0; device_idx < p_multi_device->device_count; device_idx++) {
+		VkDevice device = p_multi_device->devices[device_idx];
+
+		if (p_buffers[device_idx] != VK_NULL_HANDLE) {
+			vkDestroyBuffer(device, p_buffers[device_idx], VK_NULL_HANDLE);
+			p_buffers[device_idx] = VK_NULL_HANDLE;
+		}
+		if (p_memories[device_idx] != VK_NULL_HANDLE) {
+			vkFreeMemory(device, p_memories[device_idx], VK_NULL_HANDLE);
+			p_memories[device_idx] = VK_NULL_HANDLE;
+		}
+	}
+
+	return 1;
+}
+
+uint8_t shDestroyMultiDevice(
+	ShVkMultiDevice* p_multi_device
+) {
+	shVkArgError(p_multi_device == VK_NULL_HANDLE, "invalid multi device memory", return 0);
+
+	//reverse creation order, also called on partially created multi devices
+	for (uint32_t device_idx = p_multi_device->device_count; device_idx-- > 0;) {
+		VkDevice device = p_multi_device->devices[device_idx];
+
+		shWaitDeviceIdle(device);
+
+		if (p_multi_device->query_pools[device_idx] != VK_NULL_HANDLE) {
+			vkDestroyQueryPool(device, p_multi_device->query_pools[device_idx], VK_NULL_HANDLE);
+		}
+		if (p_multi_device->fences[device_idx] != VK_NULL_HANDLE) {
+			shDestroyFences(device, 1, &p_multi_device->fences[device_idx]);
+		}
+		if (p_multi_device->cmd_pools[device_idx] != VK_NULL_HANDLE) {
+			shDestroyCommandPool(device, p_multi_device->cmd_pools[device_idx]);
+		}
+		shDestroyDevice(device);
+	}
+
+	memset(p_multi_device, 0, sizeof(ShVkMultiDevice));
+
+	return 1;
+}
+
+
+uint8_t shCreateComputeScheduler(
+	VkDevice                  device,
+	uint32_t                  queue_family_index,
+	uint32_t                  queue_count,
+	ShVkComputeSchedulePolicy policy,
+	ShVkComputeScheduler*     p_scheduler
+) {
+	shVkArgError(device      == VK_NULL_HANDLE,                       "invalid device memory",             return 0);
+	shVkArgError(queue_count == 0,                                    "invalid queue count",               return 0);
+	shVkArgError(queue_count >  SH_MAX_COMPUTE_SCHEDULER_QUEUE_COUNT, "reached max scheduler queue count", return 0);
+	shVkArgError(p_scheduler == VK_NULL_HANDLE,                       "invalid compute scheduler memory",  return 0);
+
+	p_scheduler->policy             = policy;
+	p_scheduler->queue_family_index = queue_family_index;
+	p_scheduler->next_queue_idx     = 0;
+
+	for (uint32_t queue_idx = 0; queue_idx < queue_count; queue_idx++) {
+		vkGetDeviceQueue(device, queue_family_index, queue_idx, &p_scheduler->queues[queue_idx]);
+
+		shVkError(
+			shCreateCommandPool(device, queue_family_index, &p_scheduler->cmd_pools[queue_idx]) == 0,
+			"failed creating scheduler command pool",
+			return 0
+		);
+		p_scheduler->queue_count++;
+
+		shVkError(
+			shAllocateCommandBuffers(
+				device, p_scheduler->cmd_pools[queue_idx],
+				SH_COMPUTE_SCHEDULER_CMD_BUFFER_RING_SIZE, p_scheduler->cmd_buffers[queue_idx]
+			) == 0,
+			"failed allocating scheduler command buffers",
+			return 0
+		);
+		shVkError(
+			shCreateTimelineSemaphore(device, 0, &p_scheduler->timeline_semaphores[queue_idx]) == 0,
+			"failed creating scheduler timeline semaphore",
+			return 0
+		);
+		p_scheduler->timeline_values[queue_idx] = 0;
+	}
+
+	return 1;
+}
+
+uint8_t shComputeSchedulerBeginJob(
+	VkDevice              device,
+	ShVkComputeScheduler* p_scheduler,
+	ShVkComputeJob*       p_job
+) {
+	shVkArgError(device                   == VK_NULL_HANDLE, "invalid device memory",            return 0);
+	shVkArgError(p_scheduler              == VK_NULL_HANDLE, "invalid compute scheduler memory", return 0);
+
+	shVkError(p_scheduler->queue_count == 0,              "invalid scheduler queue count",    return 0);
+
+	shVkArgError(p_job                    == VK_NULL_HANDLE, "invalid compute job memory",       return 0);
+
+	uint32_t queue_idx = p_scheduler->next_queue_idx % p_scheduler->queue_count;
+
+	if (p_scheduler->policy == SH_COMPUTE_SCHEDULE_LEAST_LOADED) {
+		uint64_t min_pending_job_count = UINT64_MAX;
+		for (uint32_t candidate_idx = 0; candidate_idx < p_scheduler->queue_count; candidate_idx++) {
+			uint32_t candidate_queue_idx = (p_scheduler->next_queue_idx + candidate_idx) % p_scheduler->queue_count;
+
+			uint64_t completed_value = 0;
+			shVkResultError(
+				vkGetSemaphoreCounterValue(device, p_scheduler->timeline_semaphores[candidate_queue_idx], &completed_value),
+				"failed reading scheduler timeline semaphore",
+				return 0
+			);
+
+			uint64_t pending_job_count = p_scheduler->timeline_values[candidate_queue_idx] - completed_value;
+			if (pending_job_count < min_pending_job_count) {
+				min_pending_job_count = pending_job_count;
+				queue_idx             = candidate_queue_idx;
+			}
+		}
+	}
+	p_scheduler->next_queue_idx = (queue_idx + 1) % p_scheduler->queue_count;
+
+	uint64_t timeline_value = p_scheduler->timeline_values[queue_idx] + 1;
+	uint32_t ring_idx       = (uint32_t)((timeline_value - 1) % SH_COMPUTE_SCHEDULER_CMD_BUFFER_RING_SIZE);
+
+	//the command buffer was last used by the job one ring behind
+	if (timeline_value > SH_COMPUTE_SCHEDULER_CMD_BUFFER_RING_SIZE) {
+		shVkError(
+			shWaitTimelineSemaphore(
+				device, p_scheduler->timeline_semaphores[queue_idx],
+				timeline_value - SH_COMPUTE_SCHEDULER_CMD_BUFFER_RING_SIZE, UINT64_MAX
+			) == 0,
+			"failed waiting for scheduler command buffer",
+			return 0
+		);
+	}
+
+	VkCommandBuffer cmd_buffer = p_scheduler->cmd_buffers[queue_idx][ring_idx];
+
+	shVkError(shResetCommandBuffer(cmd_buffer) == 0, "failed resetting scheduler command buffer", return 0);
+	shVkError(shBeginCommandBuffer(cmd_buffer) == 0, "failed beginning scheduler command buffer", return 0);
+
+	p_scheduler->timeline_values[queue_idx] = timeline_value;
+
+	p_job->queue_idx      = queue_idx;
+	p_job->timeline_value = timeline_value;
+	p_job->cmd_buffer     = cmd_buffer;
+
+	return 1;
+}
+
+uint8_t shComputeSchedulerSubmitJob(
+	ShVkComputeScheduler* p_scheduler,
+	ShVkComputeJob*       p_job,
+	uint32_t              dependency_count,
+	ShVkComputeJob*       p_dependencies
+) {
+	shVkArgError(p_scheduler      == VK_NULL_HANDLE,                       "invalid compute scheduler memory", return 0);
+	shVkArgError(p_job            == VK_NULL_HANDLE,                       "invalid compute job memory",       return 0);
+	shVkArgError(dependency_count >  SH_MAX_COMPUTE_JOB_DEPENDENCY_COUNT,  "reached max job dependency count", return 0);
+	shVkArgError(dependency_count >  0 && p_dependencies == VK_NULL_HANDLE, "invalid job dependencies memory",  return 0);
+
+	shVkError(shEndCommandBuffer(p_job->cmd_buffer) == 0, "failed ending scheduler command buffer", return 0);
+
+	VkSemaphore          wait_semaphores[SH_MAX_COMPUTE_JOB_DEPENDENCY_COUNT] = { 0 };
+	uint64_t             wait_values    [SH_MAX_COMPUTE_JOB_DEPENDENCY_COUNT] = { 0 };
+	VkPipelineStageFlags wait_stages    [SH_MAX_COMPUTE_JOB_DEPENDENCY_COUNT] = { 0 };
+
+	for (uint32_t dependency_idx = 0; dependency_idx < dependency_count; dependency_idx++) {
+		wait_semaphores[dependency_idx] = p_scheduler->timeline_semaphores[p_dependencies[dependency_idx].queue_idx];
+		wait_values    [dependency_idx] = p_dependencies[dependency_idx].timeline_value;
+		wait_stages    [dependency_idx] = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+	}
+
+	VkTimelineSemaphoreSubmitInfo timeline_submit_info = {
+		.sType                     = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO, //sType;
+		.pNext                     = VK_NULL_HANDLE,                                   //pNext;
+		.waitSemaphoreValueCount   = dependency_count,                                 //waitSemaphoreValueCount;
+		.pWaitSemaphoreValues      = wait_values,                                      //pWaitSemaphoreValues;
+		.signalSemaphoreValueCount = 1,                                                //signalSemaphoreValueCount;
+		.pSignalSemaphoreValues    = &p_job->timeline_value                            //pSignalSemaphoreValues;
+	};
+
+	VkSubmitInfo submit_info = {
+		.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO,                         //sType;
+		.pNext                = &timeline_submit_info,                                 //pNext;
+		.waitSemaphoreCount   = dependency_count,                                      //waitSemaphoreCount;
+		.pWaitSemaphores      = wait_semaphores,                                       //pWaitSemaphores;
+		.pWaitDstStageMask    = wait_stages,                                           //pWaitDstStageMask;
+		.commandBufferCount   = 1,                                                     //commandBufferCount;
+		.pCommandBuffers      = &p_job->cmd_buffer,                                    //pCommandBuffers;
+		.signalSemaphoreCount = 1,                                                     //signalSemaphoreCount;
+		.pSignalSemaphores    = &p_scheduler->timeline_semaphores[p_job->queue_idx]    //pSignalSemaphores;
+	};
+
+	shVkResultError(
+		vkQueueSubmit(p_scheduler->queues[p_job->queue_idx], 1, &submit_info, VK_NULL_HANDLE),
+		"failed submitting compute job",
+		return 0
+	);
+
+	return 1;
+}
+
+uint8_t shComputeSchedulerGetJobStatus(
+	VkDevice              device,
+	ShVkComputeScheduler* p_scheduler,
+	ShVkComputeJob*       p_job,
+	uint8_t*              p_completed
+) {
+	shVkArgError(device      == VK_NULL_HANDLE, "invalid device memory",            return 0);
+	shVkArgError(p_scheduler == VK_NULL_HANDLE, "invalid compute scheduler memory", return 0);
+	shVkArgError(p_job       == VK_NULL_HANDLE, "invalid compute job memory",       return 0);
+	shVkArgError(p_completed == VK_NULL_HANDLE, "invalid completion flag memory",   return 0);
+
+	uint64_t completed_value = 0;
+	shVkResultError(
+		vkGetSemaphoreCounterValue(device, p_scheduler->timeline_semaphores[p_job->queue_idx], &completed_value),
+		"failed reading scheduler timeline semaphore",
+		return 0
+	);
+
+	(*p_completed) = completed_value >= p_job->timeline_value;
+
+	return 1;
+}
+
+uint8_t shComputeSchedulerWaitJob(
+	VkDevice              device,
+	ShVkComputeScheduler* p_scheduler,
+	ShVkComputeJob*       p_job,
+	uint64_t              timeout_ns
+) {
+	shVkArgError(p_scheduler == VK_NULL_HANDLE, "invalid compute scheduler memory", return 0);
+	shVkArgError(p_job       == VK_NULL_HANDLE, "invalid compute job memory",       return 0);
+
+	return shWaitTimelineSemaphore(
+		device, p_scheduler->timeline_semaphores[p_job->queue_idx],
+		p_job->timeline_value, timeout_ns
+	);
+}
+
+uint8_t shComputeSchedulerWaitIdle(
+	VkDevice              device,
+	ShVkComputeScheduler* p_scheduler
+) {
+	shVkArgError(device      == VK_NULL_HANDLE, "invalid device memory",            return 0);
+	shVkArgError(p_scheduler == VK_NULL_HANDLE, "invalid compute scheduler memory", return 0);
+
+	VkSemaphoreWaitInfo semaphore_wait_info = {
+		.sType          = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO, //sType;
+		.pNext          = VK_NULL_HANDLE,                        //pNext;
+		.flags          = 0,                                     //flags;
+		.semaphoreCount = p_scheduler->queue_count,              //semaphoreCount;
+		.pSemaphores    = p_scheduler->timeline_semaphores,      //pSemaphores;
+		.pValues        = p_scheduler->timeline_values           //pValues;
+	};
+
+	shVkResultError(
+		vkWaitSemaphores(device, &semaphore_wait_info, UINT64_MAX),
+		"failed waiting for compute scheduler",
+		return 0
+	);
+
+	return 1;
+}
+
+uint8_t shDestroyComputeScheduler(
+	VkDevice              device,
+	ShVkComputeScheduler* p_scheduler
+) {
+	shVkArgError(device      == VK_NULL_HANDLE, "invalid device memory",            return 0);
+	shVkArgError(p_scheduler == VK_NULL_HANDLE, "invalid compute scheduler memory", return 0);
+
+	if (p_scheduler->queue_count > 0) {
+		shComputeSchedulerWaitIdle(device, p_scheduler);
+	}
+
+	for (uint32_t queue_idx = 0; queue_idx < p_scheduler->queue_count; queue_idx++) {
+		if (p_scheduler->timeline_semaphores[queue_idx] != VK_NULL_HANDLE) {
+			shDestroySemaphores(device, 1, &p_scheduler->timeline_semaphores[queue_idx]);
+		}
+		shDestroyCommandPool(device, p_scheduler->cmd_pools[queue_idx]);
+	}
+
+	memset(p_scheduler, 0, sizeof(ShVkComputeScheduler));
+
+	return 1;
+}
+
+
+
+
+uint8_t shDeferRelease(
+	ShVkReleaseType   type,
+	ShVkReleaseHandle handle,
+	ShVkReleaseQueue* p_release_queue
+) {
+	shVkArgError(p_release_queue == VK_NULL_HANDLE, "invalid release queue memory", return 0);
+
+	//every member has the size of a non dispatchable handle
+	if (handle.image == VK_NULL_HANDLE) {
+		return 1;
+	}
+
+	shVkError(
+		p_release_queue->release_count == SH_MAX_RELEASE_QUEUE_SIZE,
+		"reached max release queue size",
+		return 0
+	);
+
+	ShVkDeferredRelease* p_release = &p_release_queue->releases[p_release_queue->release_count];
+
+	//the submission being recorded, not yet counted, may still use the object
+	p_release->type             = type;
+	p_release->handle           = handle;
+	p_release->submission_value = p_release_queue->submission_count + 1;
+
+	p_release_queue->release_count++;
+
+	return 1;
+}
+
+uint8_t shReleaseQueueSubmit(
+	ShVkReleaseQueue* p_release_queue,
+	uint64_t*         p_submission_value
+) {
+	shVkArgError(p_release_queue    == VK_NULL_HANDLE, "invalid release queue memory",    return 0);
+	shVkArgError(p_submission_value == VK_NULL_HANDLE, "invalid submission value memory", return 0);
+
+	p_release_queue->submission_count++;
+	(*p_submission_value) = p_release_queue->submission_count;
+
+	return 1;
+}
+
+static void shDestroyReleasedObject(
+	VkDevice             device,
+	ShVkDeferredRelease* p_release
+) {
+	switch (p_release->type) {
+	case SH_RELEASE_TYPE_SWAPCHAIN:
+		vkDestroySwapchainKHR(device, p_release->handle.swapchain, VK_NULL_HANDLE);
+		break;
+	case SH_RELEASE_TYPE_IMAGE_VIEW:
+		vkDestroyImageView(device, p_release->handle.image_view, VK_NULL_HANDLE);
+		break;
+	case SH_RELEASE_TYPE_FRAMEBUFFER:
+		vkDestroyFramebuffer(device, p_release->handle.framebuffer, VK_NULL_HANDLE);
+		break;
+	case SH_RELEASE_TYPE_IMAGE:
+		vkDestroyImage(device, p_release->handle.image, VK_NULL_HANDLE);
+		break;
+	case SH_RELEASE_TYPE_BUFFER:
+		vkDestroyBuffer(device, p_release->handle.buffer, VK_NULL_HANDLE);
+		break;
+	case SH_RELEASE_TYPE_DEVICE_MEMORY:
+		vkFreeMemory(device, p_release->handle.memory, VK_NULL_HANDLE);
+		break;
+	case SH_RELEASE_TYPE_RENDERPASS:
+		vkDestroyRenderPass(device, p_release->handle.renderpass, VK_NULL_HANDLE);
+		break;
+	case SH_RELEASE_TYPE_PIPELINE:
+		vkDestroyPipeline(device, p_release->handle.pipeline, VK_NULL_HANDLE);
+		break;
+	case SH_RELEASE_TYPE_SEMAPHORE:
+		vkDestroySemaphore(device, p_release->handle.semaphore, VK_NULL_HANDLE);
+		break;
+	default:
+		break;
+	}
+}
+
+uint8_t shCollectReleases(
+	VkDevice          device,
+	uint64_t          completed_submission_value,
+	ShVkReleaseQueue* p_release_queue
+) {
+	shVkArgError(device          == VK_NULL_HANDLE, "invalid device memory",        return 0);
+	shVkArgError(p_release_queue == VK_NULL_HANDLE, "invalid release queue memory", return 0);
+
+	uint32_t kept_count = 0;
+
+	for (uint32_t release_idx = 0; release_idx < p_release_queue->release_count; release_idx++) {
+		ShVkDeferredRelease* p_release = &p_release_queue->releases[release_idx];
+
+		if (p_release->submission_value <= completed_submission_value) {
+			shDestroyReleasedObject(device, p_release);
+		}
+		else {
+			p_release_queue->releases[kept_count] = (*p_release);
+			kept_count++;
+		}
+	}
+
+	p_release_queue->release_count = kept_count;
+
+	return 1;
+}
+
+uint8_t shRecreateSwapchain(
+	VkDevice          device,
+	VkPhysicalDevice  physical_device,
+	VkSurfaceKHR      surface,
+	VkSharingMode     image_sharing_mode,
+	ShVkPresentPolicy present_policy,
+	uint32_t          swapchain_image_count,
+	ShVkReleaseQueue* p_release_queue,
+	VkSwapchainKHR*   p_swapchain,
+	VkFormat*         p_image_format,
+	uint32_t*         p_swapchain_image_count,
+	VkImage*          p_swapchain_images,
+	VkImageView*      p_swapchain_image_views,
+	uint8_t*          p_format_changed
+) {
+	shVkArgError(device                  == VK_NULL_HANDLE, "invalid device memory",                return 0);
+	shVkArgError(p_release_queue         == VK_NULL_HANDLE, "invalid release queue memory",         return 0);
+	shVkArgError(p_swapchain             == VK_NULL_HANDLE, "invalid swapchain memory",             return 0);
+	shVkArgError(p_image_format          == VK_NULL_HANDLE, "invalid image format memory",          return 0);
+	shVkArgError(p_swapchain_image_count == VK_NULL_HANDLE, "invalid swapchain image count memory", return 0);
+	shVkArgError(p_swapchain_images      == VK_NULL_HANDLE, "invalid swapchain images memory",      return 0);
+	shVkArgError(p_swapchain_image_views == VK_NULL_HANDLE, "invalid swapchain image views memory", return 0);
+
+	VkSwapchainKHR old_swapchain    = (*p_swapchain);
+	VkFormat       old_image_format = (*p_image_format);
+
+	for (uint32_t image_idx = 0; image_idx < (*p_swapchain_image_count); image_idx++) {
+		ShVkReleaseHandle handle = { .image_view = p_swapchain_image_views[image_idx] };
+		shVkError(
+			shDeferRelease(SH_RELEASE_TYPE_IMAGE_VIEW, handle, p_release_queue) == 0,
+			"failed releasing swapchain image view",
+			return 0
+		);
+		p_swapchain_image_views[image_idx] = VK_NULL_HANDLE;
+	}
+
+	//the retired swapchain keeps presenting until the new one takes over, then it is only kept alive for in flight frames
+	shVkError(
+		shCreateSwapchain(
+			device, physical_device, surface,
+			old_image_format, p_image_format,
+			swapchain_image_count, image_sharing_mode,
+			present_policy, old_swapchain,
+			p_swapchain_image_count, p_swapchain
+		) == 0,
+		"failed creating swapchain",
+		return 0
+	);
+
+	ShVkReleaseHandle handle = { .swapchain = old_swapchain };
+	shVkError(
+		shDeferRelease(SH_RELEASE_TYPE_SWAPCHAIN, handle, p_release_queue) == 0,
+		"failed releasing swapchain",
+		return 0
+	);
+
+	shVkError(
+		shGetSwapchainImages(device, (*p_swapchain), p_swapchain_image_count, p_swapchain_images) == 0,
+		"failed getting swapchain images",
+		return 0
+	);
+	shVkError(
+		shCreateSwapchainImageViews(
+			device, (*p_image_format),
+			(*p_swapchain_image_count), p_swapchain_images,
+			p_swapchain_image_views
+		) == 0,
+		"failed creating swapchain image views",
+		return 0
+	);
+
+	if (p_format_changed != VK_NULL_HANDLE) {
+		(*p_format_changed) = (*p_image_format) != old_image_format;
+	}
+
+	return 1;
+}
+
+
+
+
+uint8_t shCreateReadbackEngine(
+	VkDevice            device,
+	VkPhysicalDevice    physical_device,
+	uint32_t            queue_family_index,
+	uint32_t            slot_count,
+	uint32_t            width,
+	uint32_t            height,
+	uint32_t            texel_size,
+	VkImageAspectFlags  image_aspect,
+	ShVkReadbackEngine* p_engine
+) {
+	shVkArgError(device          == VK_NULL_HANDLE,             "invalid device memory",           return 0);
+	shVkArgError(physical_device == VK_NULL_HANDLE,             "invalid physical device memory",  return 0);
+	shVkArgError(slot_count      == 0,                          "invalid readback slot count",     return 0);
+	shVkArgError(slot_count      >  SH_MAX_READBACK_SLOT_COUNT, "reached max readback slot count", return 0);
+	shVkArgError(width == 0 || height == 0,                     "invalid readback image size",     return 0);
+	shVkArgError(texel_size      == 0,                          "invalid readback texel size",     return 0);
+	shVkArgError(p_engine        == VK_NULL_HANDLE,             "invalid readback engine memory",  return 0);
+
+	p_engine->slot_count         = slot_count;
+	p_engine->width              = width;
+	p_engine->height             = height;
+	p_engine->texel_size         = texel_size;
+	p_engine->slot_size          = (VkDeviceSize)width * (VkDeviceSize)height * (VkDeviceSize)texel_size;
+	p_engine->image_aspect       = image_aspect;
+	p_engine->queue_family_index = queue_family_index;
+
+	//shCreateBuffer takes a 32 bit size
+	shVkError(p_engine->slot_size > UINT32_MAX, "readback slot size exceeds 4 GiB", return 0);
+
+	shVkError(
+		shCreateCommandPool(device, queue_family_index, &p_engine->cmd_pool) == 0,
+		"failed creating readback command pool",
+		return 0
+	);
+	shVkError(
+		shAllocateCommandBuffers(device, p_engine->cmd_pool, slot_count, p_engine->cmd_buffers) == 0,
+		"failed allocating readback command buffers",
+		return 0
+	);
+	shVkError(
+		shCreateFences(device, slot_count, 0, p_engine->fences) == 0,
+		"failed creating readback fences",
+		return 0
+	);
+
+	VkPhysicalDeviceMemoryProperties memory_properties = { 0 };
+	vkGetPhysicalDeviceMemoryProperties(physical_device, &memory_properties);
+
+	for (uint32_t slot_idx = 0; slot_idx < slot_count; slot_idx++) {
+		shVkError(
+			shCreateBuffer(
+				device, (uint32_t)p_engine->slot_size,
+				VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_SHARING_MODE_EXCLUSIVE,
+				&p_engine->buffers[slot_idx]
+			) == 0,
+			"failed creating readback buffer",
+			return 0
+		);
+
+		VkMemoryRequirements memory_requirements = { 0 };
+		vkGetBufferMemoryRequirements(device, p_engine->buffers[slot_idx], &memory_requirements);
+
+		//cached memory first, reading uncached write combined memory from the CPU is slow
+		VkMemoryPropertyFlags preferred_flags[2] = {
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+		};
+		uint32_t memory_type_index = UINT32_MAX;
+		for (uint32_t flags_idx = 0; flags_idx < 2 && memory_type_index == UINT32_MAX; flags_idx++) {
+			for (uint32_t type_idx = 0; type_idx < memory_properties.memoryTypeCount; type_idx++) {
+				VkMemoryPropertyFlags type_flags = memory_properties.memoryTypes[type_idx].propertyFlags;
+				if ((memory_requirements.memoryTypeBits & (1 << type_idx)) &&
+					(type_flags & preferred_flags[flags_idx]) == preferred_flags[flags_idx]) {
+					memory_type_index = type_idx;
+					break;
+				}
+			}
+		}
+		shVkError(
+			memory_type_index == UINT32_MAX,
+			"cannot find host visible memory for readback",
+			return 0
+		);
+		p_engine->host_coherent = (memory_properties.memoryTypes[memory_type_index].propertyFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
+
+		VkMemoryAllocateInfo memory_allocate_info = {
+			.sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO, //sType;
+			.pNext           = VK_NULL_HANDLE,                         //pNext;
+			.allocationSize  = memory_requirements.size,               //allocationSize;
+			.memoryTypeIndex = memory_type_index                       //memoryTypeIndex;
+		};
+		shVkResultError(
+			vkAllocateMemory(device, &memory_allocate_info, VK_NULL_HANDLE, &p_engine->memories[slot_idx]),
+			"error allocating readback memory",
+			return 0
+		);
+		shVkError(
+			shBindBufferMemory(device, p_engine->buffers[slot_idx], 0, p_engine->memories[slot_idx]) == 0,
+			"failed binding readback memory",
+			return 0
+		);
+		shVkResultError(
+			vkMapMemory(device, p_engine->memories[slot_idx], 0, VK_WHOLE_SIZE, 0, &p_engine->p_mapped[slot_idx]),
+			"error mapping readback memory",
+			return 0
+		);
+	}
+
+	return 1;
+}
+
+uint8_t shReadbackEngineSubmit(
+	VkDevice            device,
+	VkQueue             queue,
+	VkImage             image,
+	VkImageLayout       image_layout,
+	VkSemaphore         wait_semaphore,
+	uint64_t            frame_id,
+	ShVkReadbackEngine* p_engine
+) {
+	shVkArgError(device   == VK_NULL_HANDLE, "invalid device memory",          return 0);
+	shVkArgError(queue    == VK_NULL_HANDLE, "invalid queue memory",           return 0);
+	shVkArgError(image    == VK_NULL_HANDLE, "invalid image memory",           return 0);
+	shVkArgError(p_engine == VK_NULL_HANDLE, "invalid readback engine memory", return 0);
+
+	shVkError(
+		p_engine->submitted_count - p_engine->released_count >= p_engine->slot_count,
+		"no free readback slot, release acquired slots first",
+		return 0
+	);
+
+	uint32_t        slot_idx   = (uint32_t)(p_engine->submitted_count % p_engine->slot_count);
+	VkCommandBuffer cmd_buffer = p_engine->cmd_buffers[slot_idx];
+
+	shVkError(shResetFences(device, 1, &p_engine->fences[slot_idx]) == 0, "failed resetting readback fence", return 0);
+
+	shBeginCommandBuffer(cmd_buffer);
+
+	if (image_layout != VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL) {
+		shSetImageMemoryBarrier(
+			device, cmd_buffer, image, p_engine->image_aspect,
+			VK_ACCESS_MEMORY_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+			image_layout, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+			VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED,
+			VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT
+		);
+	}
+
+	VkBufferImageCopy region = {
+		.bufferOffset      = 0,                      //bufferOffset;
+		.bufferRowLength   = 0,                      //bufferRowLength;
+		.bufferImageHeight = 0,                      //bufferImageHeight;
+		.imageSubresource  = {
+			.aspectMask     = p_engine->image_aspect,
+			.mipLevel       = 0,
+			.baseArrayLayer = 0,
+			.layerCount     = 1
+		},                                           //imageSubresource;
+		.imageOffset       = { 0, 0, 0 },            //imageOffset;
+		.imageExtent       = {
+			p_engine->width, p_engine->height, 1
+		}                                            //imageExtent;
+	};
+	vkCmdCopyImageToBuffer(
+		cmd_buffer,
+		image,
+		VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+		p_engine->buffers[slot_idx],
+		1,
+		&region
+	);
+
+	if (image_layout != VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL && image_layout != VK_IMAGE_LAYOUT_UNDEFINED) {
+		shSetImageMemoryBarrier(
+			device, cmd_buffer, image, p_engine->image_aspect,
+			VK_ACCESS_TRANSFER_READ_BIT, VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT,
+			VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, image_layout,
+			VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED,
+			VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT
+		);
+	}
+
+	VkBufferMemoryBarrier host_barrier = {
+		.sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER, //sType;
+		.pNext               = VK_NULL_HANDLE,                          //pNext;
+		.srcAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT,            //srcAccessMask;
+		.dstAccessMask       = VK_ACCESS_HOST_READ_BIT,                 //dstAccessMask;
+		.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,                 //srcQueueFamilyIndex;
+		.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,                 //dstQueueFamilyIndex;
+		.buffer              = p_engine->buffers[slot_idx],             //buffer;
+		.offset              = 0,                                       //offset;
+		.size                = VK_WHOLE_SIZE                            //size;
+	};
+	vkCmdPipelineBarrier(
+		cmd_buffer,
+		VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT,
+		0,
+		0, VK_NULL_HANDLE,
+		1, &host_barrier,
+		0, VK_NULL_HANDLE
+	);
+
+	shEndCommandBuffer(cmd_buffer);
+
+	shVkError(
+		shQueueSubmit(
+			1, &cmd_buffer, queue, p_engine->fences[slot_idx],
+			wait_semaphore != VK_NULL_HANDLE ? 1 : 0,
+			wait_semaphore != VK_NULL_HANDLE ? &wait_semaphore : VK_NULL_HANDLE,
+			VK_PIPELINE_STAGE_TRANSFER_BIT,
+			0, VK_NULL_HANDLE
+		) == 0,
+		"failed submitting readback copy",
+		return 0
+	);
+
+	p_engine->frame_ids[slot_idx] = frame_id;
+	p_engine->submitted_count++;
+
+	return 1;
+}
+
+uint8_t shReadbackEngineAcquire(
+	VkDevice            device,
+	uint64_t            timeout_ns,
+	ShVkReadbackEngine* p_engine,
+	uint8_t*            p_ready,
+	void**              pp_data,
+	uint64_t*           p_frame_id
+) {
+	shVkArgError(device   == VK_NULL_HANDLE, "invalid device memory",          return 0);
+	shVkArgError(p_engine == VK_NULL_HANDLE, "invalid readback engine memory", return 0);
+	shVkArgError(p_ready  == VK_NULL_HANDLE, "invalid ready flag memory",      return 0);
+	shVkArgError(pp_data  == VK_NULL_HANDLE, "invalid readback data memory",   return 0);
+
+	(*p_ready) = 0;
+
+	if (p_engine->acquired_count == p_engine->submitted_count) {
+		return 1;
+	}
+
+	uint32_t slot_idx = (uint32_t)(p_engine->acquired_count % p_engine->slot_count);
+
+	VkResult result = vkWaitForFences(device, 1, &p_engine->fences[slot_idx], VK_TRUE, timeout_ns);
+	if (result == VK_TIMEOUT) {
+		return 1;
+	}
+	shVkResultError(result, "error waiting for readback fence", return 0);
+
+	if (!p_engine->host_coherent) {
+		VkMappedMemoryRange range = {
+			.sType  = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE, //sType;
+			.pNext  = VK_NULL_HANDLE,                        //pNext;
+			.memory = p_engine->memories[slot_idx],          //memory;
+			.offset = 0,                                     //offset;
+			.size   = VK_WHOLE_SIZE                          //size;
+		};
+		shVkResultError(
+			vkInvalidateMappedMemoryRanges(device, 1, &range),
+			"error invalidating readback memory",
+			return 0
+		);
+	}
+
+	(*pp_data) = p_engine->p_mapped[slot_idx];
+	if (p_frame_id != VK_NULL_HANDLE) {
+		(*p_frame_id) = p_engine->frame_ids[slot_idx];
+	}
+	(*p_ready) = 1;
+
+	p_engine->acquired_count++;
+
+	return 1;
+}
+
+uint8_t shReadbackEngineRelease(
+	ShVkReadbackEngine* p_engine
+) {
+	shVkArgError(p_engine == VK_NULL_HANDLE, "invalid readback engine memory", return 0);
+	shVkError(
+		p_engine->released_count == p_engine->acquired_count,
+		"no acquired readback slot to release",
+		return 0
+	);
+
+	p_engine->released_count++;
+
+	return 1;
+}
+
+uint8_t shDestroyReadbackEngine(
+	VkDevice            device,
+	ShVkReadbackEngine* p_engine
+) {
+	shVkArgError(device   == VK_NULL_HANDLE, "invalid device memory",          return 0);
+	shVkArgError(p_engine == VK_NULL_HANDLE, "invalid readback engine memory", return 0);
+
+	uint64_t pending_count = p_engine->submitted_count - p_engine->acquired_count;
+	for (uint64_t pending_idx = 0; pending_idx < pending_count; pending_idx++) {
+		uint32_t slot_idx = (uint32_t)((p_engine->acquired_count + pending_idx) % p_engine->slot_count);
+		shWaitForFences(device, 1, &p_engine->fences[slot_idx], 1, UINT64_MAX);
+	}
+
+	for (uint32_t slot_idx = 0; slot_idx < p_engine->slot_count; slot_idx++) {
+		if (p_engine->memories[slot_idx] != VK_NULL_HANDLE) {
+			if (p_engine->p_mapped[slot_idx] != VK_NULL_HANDLE) {
+				vkUnmapMemory(device, p_engine->memories[slot_idx]);
+			}
+			shClearBufferMemory(device, p_engine->buffers[slot_idx], p_engine->memories[slot_idx]);
+		}
+		else if (p_engine->buffers[slot_idx] != VK_NULL_HANDLE) {
+			vkDestroyBuffer(device, p_engine->buffers[slot_idx], VK_NULL_HANDLE);
+		}
+		if (p_engine->fences[slot_idx] != VK_NULL_HANDLE) {
+			shDestroyFences(device, 1, &p_engine->fences[slot_idx]);
+		}
+	}
+
+	if (p_engine->cmd_pool != VK_NULL_HANDLE) {
+		shDestroyCommandBuffers(device, p_engine->cmd_pool, p_engine->slot_count, p_engine->cmd_buffers);
+		shDestroyCommandPool(device, p_engine->cmd_pool);
+	}
+
+	memset(p_engine, 0, sizeof(ShVkReadbackEngine));
+
+	return 1;
+}
+
+
+
+
+#ifdef _WIN32
+typedef HANDLE             ShThread;
+typedef CRITICAL_SECTION   ShMutex;
+typedef CONDITION_VARIABLE ShCondition;
+#define SH_THREAD_FUNCTION(function_name) DWORD WINAPI function_name(LPVOID p_arg)
+#define SH_THREAD_RETURN                  return 0
+#define shThreadCreate(p_thread, function, p_arg)\
+	((*(p_thread) = CreateThread(NULL, 0, (function), (p_arg), 0, NULL)) != NULL)
+#define shThreadJoin(thread)              { WaitForSingleObject((thread), INFINITE); CloseHandle((thread)); }
+#define shMutexInit(p_mutex)              InitializeCriticalSection(p_mutex)
+#define shMutexRelease(p_mutex)           DeleteCriticalSection(p_mutex)
+#define shMutexLock(p_mutex)              EnterCriticalSection(p_mutex)
+#define shMutexUnlock(p_mutex)            LeaveCriticalSection(p_mutex)
+#define shConditionInit(p_condition)      InitializeConditionVariable(p_condition)
+#define shConditionRelease(p_condition)
+#define shConditionWait(p_condition, p_mutex)\
+	SleepConditionVariableCS((p_condition), (p_mutex), INFINITE)
+#define shConditionWaitNs(p_condition, p_mutex, timeout_ns)\
+	SleepConditionVariableCS((p_condition), (p_mutex), (DWORD)((timeout_ns) / 1000000))
+#define shConditionBroadcast(p_condition) WakeAllConditionVariable(p_condition)
+#else
+typedef pthread_t          ShThread;
+typedef pthread_mutex_t    ShMutex;
+typedef pthread_cond_t     ShCondition;
+#define SH_THREAD_FUNCTION(function_name) void* function_name(void* p_arg)
+#define SH_THREAD_RETURN                  return NULL
+#define shThreadCreate(p_thread, function, p_arg)\
+	(pthread_create((p_thread), NULL, (function), (p_arg)) == 0)
+#define shThreadJoin(thread)              pthread_join((thread), NULL)
+#define shMutexInit(p_mutex)              pthread_mutex_init((p_mutex), NULL)
+#define shMutexRelease(p_mutex)           pthread_mutex_destroy(p_mutex)
+#define shMutexLock(p_mutex)              pthread_mutex_lock(p_mutex)
+#define shMutexUnlock(p_mutex)            pthread_mutex_unlock(p_mutex)
+#define shConditionInit(p_condition)      pthread_cond_init((p_condition), NULL)
+#define shConditionRelease(p_condition)   pthread_cond_destroy(p_condition)
+#define shConditionWait(p_condition, p_mutex)\
+	pthread_cond_wait((p_condition), (p_mutex))
+#define shConditionWaitNs(p_condition, p_mutex, timeout_ns) {\
+		struct timespec deadline = { 0 };\
+		clock_gettime(CLOCK_REALTIME, &deadline);\
+		uint64_t deadline_ns = (uint64_t)deadline.tv_nsec + (timeout_ns);\
+		deadline.tv_sec  += (time_t)(deadline_ns / 1000000000ull);\
+		deadline.tv_nsec  = (long)(deadline_ns % 1000000000ull);\
+		pthread_cond_timedwait((p_condition), (p_mutex), &deadline);\
+	}
+#define shConditionBroadcast(p_condition) pthread_cond_broadcast(p_condition)
+#endif//_WIN32
+
+uint64_t shGetTimeNs(
+	void
+) {
+#ifdef _WIN32
+	LARGE_INTEGER frequency = { 0 };
+	LARGE_INTEGER counter   = { 0 };
+	QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&counter);
+	return (uint64_t)((double)counter.QuadPart * 1.0e9 / (double)frequency.QuadPart);
+#else
+	struct timespec time = { 0 };
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return (uint64_t)time.tv_sec * 1000000000ull + (uint64_t)time.tv_nsec;
+#endif//_WIN32
+}
+
+typedef struct ShVkFrameWriterThread {
+	ShThread    thread;
+	ShMutex     mutex;
+	ShCondition pushed;  //signaled when a frame is pushed or the writer stops
+	ShCondition written; //signaled when a frame is written
+} ShVkFrameWriterThread;
+
+static uint8_t shWriteFrame(
+	ShVkFrameWriter* p_writer,
+	const uint8_t*   p_frame
+) {
+	size_t row_size = (size_t)p_writer->width * (size_t)p_writer->texel_size;
+
+	if (p_writer->format == SH_FRAME_FILE_FORMAT_RAW) {
+		size_t frame_size = row_size * (size_t)p_writer->height;
+		if (fwrite(p_frame, 1, frame_size, p_writer->stream) != frame_size) {
+			return 0;
+		}
+		p_writer->written_bytes += frame_size;
+		return 1;
+	}
+
+	int header_size = fprintf(p_writer->stream, "P6\n%u %u\n255\n", p_writer->width, p_writer->height);
+	if (header_size < 0) {
+		return 0;
+	}
+	p_writer->written_bytes += (uint64_t)header_size;
+
+	uint32_t red_idx  = p_writer->bgra ? 2 : 0;
+	uint32_t blue_idx = p_writer->bgra ? 0 : 2;
+	size_t   ppm_row  = (size_t)p_writer->width * 3;
+
+	for (uint32_t row_idx = 0; row_idx < p_writer->height; row_idx++) {
+		const uint8_t* p_src = &p_frame[row_size * row_idx];
+		uint8_t*       p_dst = p_writer->p_row;
+		for (uint32_t x = 0; x < p_writer->width; x++) {
+			p_dst[0] = p_src[red_idx];
+			p_dst[1] = p_src[1];
+			p_dst[2] = p_src[blue_idx];
+			p_src += p_writer->texel_size;
+			p_dst += 3;
+		}
+		if (fwrite(p_writer->p_row, 1, ppm_row, p_writer->stream) != ppm_row) {
+			return 0;
+		}
+	}
+	p_writer->written_bytes += (uint64_t)ppm_row * p_writer->height;
+
+	return 1;
+}
+
+static SH_THREAD_FUNCTION(shFrameWriterThread) {
+	ShVkFrameWriter*       p_writer = (ShVkFrameWriter*)p_arg;
+	ShVkFrameWriterThread* p_thread = (ShVkFrameWriterThread*)p_writer->p_thread;
+
+	shMutexLock(&p_thread->mutex);
+	for (;;) {
+		while (p_writer->written_count == p_writer->pushed_count && !p_writer->stop) {
+			shConditionWait(&p_thread->pushed, &p_thread->mutex);
+		}
+		if (p_writer->written_count == p_writer->pushed_count) {
+			break;
+		}
+		const void* p_frame = p_writer->p_frames[p_writer->written_count % SH_MAX_FRAME_WRITER_QUEUE_SIZE];
+		shMutexUnlock(&p_thread->mutex);
+
+		//the file and the statistics are only touched by this thread while it runs
+		uint64_t start_ns = shGetTimeNs();
+		if (!p_writer->failed && shWriteFrame(p_writer, (const uint8_t*)p_frame) == 0) {
+			p_writer->failed = 1;
+		}
+		uint64_t write_time_ns = shGetTimeNs() - start_ns;
+
+		shMutexLock(&p_thread->mutex);
+		p_writer->write_time_ns += write_time_ns;
+		p_writer->written_count++;
+		shConditionBroadcast(&p_thread->written);
+	}
+	shMutexUnlock(&p_thread->mutex);
+
+	SH_THREAD_RETURN;
+}
+
+uint8_t shOpenFrameWriter(
+	const char*         path,
+	ShVkFrameFileFormat format,
+	uint32_t            width,
+	uint32_t            height,
+	uint32_t            texel_size,
+	uint8_t             bgra,
+	ShVkFrameWriter*    p_writer
+) {
+	shVkArgError(path     == VK_NULL_HANDLE,            "invalid output path memory",  return 0);
+	shVkArgError(width == 0 || height == 0,             "invalid frame size",          return 0);
+	shVkArgError(texel_size == 0,                       "invalid texel size",          return 0);
+	shVkArgError(
+		format == SH_FRAME_FILE_FORMAT_PPM && texel_size != 3 && texel_size != 4,
+		"ppm output needs 8 bit rgb or rgba texels",
+		return 0
+	);
+	shVkArgError(p_writer == VK_NULL_HANDLE,            "invalid frame writer memory", return 0);
+
+	p_writer->format     = format;
+	p_writer->width      = width;
+	p_writer->height     = height;
+	p_writer->texel_size = texel_size;
+	p_writer->bgra       = bgra;
+
+	if (format == SH_FRAME_FILE_FORMAT_PPM) {
+		p_writer->p_row = (uint8_t*)malloc((size_t)width * 3);
+		shVkError(p_writer->p_row == VK_NULL_HANDLE, "failed allocating ppm row memory", return 0);
+	}
+
+	p_writer->stream = fopen(path, "wb");
+	shVkError(p_writer->stream == VK_NULL_HANDLE, "failed opening output file", return 0);
+
+	ShVkFrameWriterThread* p_thread = (ShVkFrameWriterThread*)calloc(1, sizeof(ShVkFrameWriterThread));
+	shVkError(p_thread == VK_NULL_HANDLE, "failed allocating frame writer thread memory", return 0);
+
+	shMutexInit(&p_thread->mutex);
+	shConditionInit(&p_thread->pushed);
+	shConditionInit(&p_thread->written);
+	p_writer->p_thread = p_thread;
+
+	shVkError(
+		!shThreadCreate(&p_thread->thread, shFrameWriterThread, p_writer),
+		"failed creating frame writer thread",
+		return 0
+	);
+
+	return 1;
+}
+
+uint8_t shFrameWriterPush(
+	const void*      p_data,
+	ShVkFrameWriter* p_writer
+) {
+	shVkArgError(p_data   == VK_NULL_HANDLE,           "invalid frame data memory",   return 0);
+	shVkArgError(p_writer == VK_NULL_HANDLE,           "invalid frame writer memory", return 0);
+
+	shVkError(p_writer->p_thread == VK_NULL_HANDLE, "frame writer is not open",    return 0);
+
+	ShVkFrameWriterThread* p_thread = (ShVkFrameWriterThread*)p_writer->p_thread;
+
+	shMutexLock(&p_thread->mutex);
+	while (p_writer->pushed_count - p_writer->written_count == SH_MAX_FRAME_WRITER_QUEUE_SIZE) {
+		shConditionWait(&p_thread->written, &p_thread->mutex);
+	}
+	p_writer->p_frames[p_writer->pushed_count % SH_MAX_FRAME_WRITER_QUEUE_SIZE] = p_data;
+	p_writer->pushed_count++;
+	shConditionBroadcast(&p_thread->pushed);
+	shMutexUnlock(&p_thread->mutex);
+
+	return 1;
+}
+
+uint8_t shFrameWriterGetWrittenCount(
+	uint64_t         timeout_ns,
+	uint64_t         min_written_count,
+	ShVkFrameWriter* p_writer,
+	uint64_t*        p_written_count
+) {
+	shVkArgError(p_writer        == VK_NULL_HANDLE,    "invalid frame writer memory",  return 0);
+
+	shVkError(p_writer->p_thread == VK_NULL_HANDLE, "frame writer is not open",     return 0);
+
+	shVkArgError(p_written_count == VK_NULL_HANDLE,    "invalid written count memory", return 0);
+
+	ShVkFrameWriterThread* p_thread = (ShVkFrameWriterThread*)p_writer->p_thread;
+
+	if (min_written_count > p_writer->pushed_count) {
+		min_written_count = p_writer->pushed_count;
+	}
+
+	shMutexLock(&p_thread->mutex);
+	if (timeout_ns == UINT64_MAX) {
+		while (p_writer->written_count < min_written_count) {
+			shConditionWait(&p_thread->written, &p_thread->mutex);
+		}
+	}
+	else if (timeout_ns > 0 && p_writer->written_count < min_written_count) {
+		shConditionWaitNs(&p_thread->written, &p_thread->mutex, timeout_ns);
+	}
+	(*p_written_count) = p_writer->written_count;
+	shMutexUnlock(&p_thread->mutex);
+
+	return 1;
+}
+
+uint8_t shCloseFrameWriter(
+	ShVkFrameWriter* p_writer
+) {
+	shVkArgError(p_writer == VK_NULL_HANDLE, "invalid frame writer memory", return 0);
+
+	ShVkFrameWriterThread* p_thread = (ShVkFrameWriterThread*)p_writer->p_thread;
+
+	if (p_thread != VK_NULL_HANDLE) {
+		shMutexLock(&p_thread->mutex);
+		p_writer->stop = 1;
+		shConditionBroadcast(&p_thread->pushed);
+		shMutexUnlock(&p_thread->mutex);
+
+		shThreadJoin(p_thread->thread);
+
+		shConditionRelease(&p_thread->written);
+		shConditionRelease(&p_thread->pushed);
+		shMutexRelease(&p_thread->mutex);
+		free(p_thread);
+		p_writer->p_thread = VK_NULL_HANDLE;
+	}
+
+	uint8_t succeeded = !p_writer->failed;
+
+	if (p_writer->stream != VK_NULL_HANDLE) {
+		if (fclose(p_writer->stream) != 0) {
+			succeeded = 0;
+		}
+		p_writer->stream = VK_NULL_HANDLE;
+	}
+
+	free(p_writer->p_row);
+	p_writer->p_row = VK_NULL_HANDLE;
+
+	shVkError(succeeded == 0, "failed writing frames", return 0);
+
+	return 1;
+}
+
+
+
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SH_PIXEL_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>//__cpuid, __cpuidex and _xgetbv
+#endif//_MSC_VER
+#if defined(__GNUC__) || defined(__clang__)
+#define SH_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define SH_TARGET_AVX2
+#endif//__GNUC__ || __clang__
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define SH_PIXEL_NEON
+#include <arm_neon.h>
+#endif//SIMD
+
+typedef void (*ShPixelRowFunction)(const uint8_t* p_src, uint8_t* p_dst, uint32_t width);
+
+static void shPixelCopyRow(
+	const uint8_t* p_src,
+	uint8_t*       p_dst,
+	uint32_t       width
+) {
+	if (p_src != p_dst) {
+		memmove(p_dst, p_src, (size_t)width * 4);
+	}
+}
+
+//
+//SCALAR
+//
+static void shPixelSwizzleRowScalar(
+	const uint8_t* p_src,
+	uint8_t*       p_dst,
+	uint32_t       width
+) {
+	for (uint32_t x = 0; x < width; x++) {
+		uint8_t c0 = p_src[0];
+		uint8_t c2 = p_src[2];
+		p_dst[0] = c2;
+		p_dst[1] = p_src[1];
+		p_dst[2] = c0;
+		p_dst[3] = p_src[3];
+		p_src += 4;
+		p_dst += 4;
+	}
+}
+
+static void shPixelPremultiplyRowScalar(
+	const uint8_t* p_src,
+	uint8_t*       p_dst,
+	uint32_t       width
+) {
+	for (uint32_t x = 0; x < width; x++) {
+		uint32_t alpha = p_src[3];
+		for (uint32_t channel = 0; channel < 3; channel++) {
+			uint32_t t = (uint32_t)p_src[channel] * alpha + 128;//rounded c * a / 255
+			p_dst[channel] = (uint8_t)((t + (t >> 8)) >> 8);
+		}
+		p_dst[3] = (uint8_t)alpha;
+		p_src += 4;
+		p_dst += 4;
+	}
+}
+
+static void shPixelUnpremultiplyRowScalar(
+	const uint8_t* p_src,
+	uint8_t*       p_dst,
+	uint32_t       width
+) {
+	for (uint32_t x = 0; x < width; x++) {
+		uint8_t alpha = p_src[3];
+		float   scale = alpha ? 255.0f / (float)alpha : 0.0f;
+		for (uint32_t channel = 0; channel < 3; channel++) {
+			float value = (float)p_src[channel] * scale + 0.5f;
+			p_dst[channel] = (uint8_t)(value < 255.0f ? value : 255.0f);
+		}
+		p_dst[3] = alpha;
+		p_src += 4;
+		p_dst += 4;
+	}
+}
+
+static void shPixelFloatToUnormRowScalar(
+	const uint8_t* p_src,
+	uint8_t*       p_dst,
+	uint32_t       width
+) {
+	const float* p_texels = (const float*)p_src;
+	for (uint32_t i = 0; i < width * 4; i++) {
+		float value = p_texels[i];
+		value = value > 0.0f ? value : 0.0f;//also clears NaN
+		value = value < 1.0f ? value : 1.0f;
+		p_dst[i] = (uint8_t)(value * 255.0f + 0.5f);
+	}
+}
+
+#ifdef SH_PIXEL_X86
+//
+//SSE2
+//
+static void shPixelSwizzleRowSse2(
+	const uint8_t* p_src,
+	uint8_t*       p_dst,
+	uint32_t       width
+) {
+	const __m128i ga_mask = _mm_set1_epi32((int)0xFF00FF00);
+	const __m128i rb_mask = _mm_set1_epi32(0x00FF00FF);
+
+	uint32_t x = 0;
+	for (; x + 4 <= width; x += 4) {
+		__m128i texels = _mm_loadu_si128((const __m128i*)&p_src[x * 4]);
+		__m128i rb     = _mm_and_si128(texels, rb_mask);
+		rb = _mm_or_si128(_mm_slli_epi32(rb, 16), _mm_srli_epi32(rb, 16));
+		_mm_storeu_si128((__m128i*)&p_dst[x * 4], _mm_or_si128(_mm_and_si128(texels, ga_mask), rb));
+	}
+	shPixelSwizzleRowScalar(&p_src[x * 4], &p_dst[x * 4], width - x);
+}
+
+static __m128i shPremultiplySse2(
+	__m128i texels,//2 texels, 16 bit channels
+	__m128i alpha_mask
+) {
+	__m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(texels, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+	__m128i t     = _mm_add_epi16(_mm_mullo_epi16(texels, alpha), _mm_set1_epi16(128));
+	t = _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+	return _mm_or_si128(_mm_and_si128(alpha_mask, texels), _mm_andnot_si128(alpha_mask, t));
+}
+
+static void shPixelPremultiplyRowSse2(
+	const uint8_t* p_src,
+	uint8_t*       p_dst,
+	uint32_t       width
+) {
+	const __m128i zero       = _mm_setzero_si128();
+	const __m128i alpha_mask = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+
+	uint32_t x = 0;
+	for (; x + 4 <= width; x += 4) {
+		__m128i texels = _mm_loadu_si128((const __m128i*)&p_src[x * 4]);
+		__m128i lo     = shPremultiplySse2(_mm_unpacklo_epi8(texels, zero), alpha_mask);
+		__m128i hi     = shPremultiplySse2(_mm_unpackhi_epi8(texels, zero), alpha_mask);
+		_mm_storeu_si128((__m128i*)&p_dst[x * 4], _mm_packus_epi16(lo, hi));
+	}
+	shPixelPremultiplyRowScalar(&p_src[x * 4], &p_dst[x * 4], width - x);
+}
+
+static __m128i shUnpremultiplySse2(
+	__m128i texel//1 texel, 32 bit channels
+) {
+	const __m128 alpha_mask = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+
+	__m128 value = _mm_cvtepi32_ps(texel);
+	__m128 alpha = _mm_shuffle_ps(value, value, _MM_SHUFFLE(3, 3, 3, 3));
+	__m128 scale = _mm_and_ps(_mm_div_ps(_mm_set1_ps(255.0f), alpha), _mm_cmpgt_ps(alpha, _mm_setzero_ps()));
+	__m128 color = _mm_min_ps(_mm_add_ps(_mm_mul_ps(value, scale), _mm_set1_ps(0.5f)), _mm_set1_ps(255.0f));
+	return _mm_cvttps_epi32(_mm_or_ps(_mm_and_ps(alpha_mask, value), _mm_andnot_ps(alpha_mask, color)));
+}
+
+static void shPixelUnpremultiplyRowSse2(
+	const uint8_t* p_src,
+	uint8_t*       p_dst,
+	uint32_t       width
+) {
+	const __m128i zero = _mm_setzero_si128();
+
+	uint32_t x = 0;
+	for (; x + 4 <= width; x += 4) {
+		__m128i texels = _mm_loadu_si128((const __m128i*)&p_src[x * 4]);
+		__m128i lo     = _mm_unpacklo_epi8(texels, zero);
+		__m128i hi     = _mm_unpackhi_epi8(texels, zero);
+		__m128i t0     = shUnpremultiplySse2(_mm_unpacklo_epi16(lo, zero));
+		__m128i t1     = shUnpremultiplySse2(_mm_unpackhi_epi16(lo, zero));
+		__m128i t2     = shUnpremultiplySse2(_mm_unpacklo_epi16(hi, zero));
+		__m128i t3     = shUnpremultiplySse2(_mm_unpackhi_epi16(hi, zero));
+		_mm_storeu_si128((__m128i*)&p_dst[x * 4], _mm_packus_epi16(_mm_packs_epi32(t0, t1), _mm_packs_epi32(t2, t3)));
+	}
+	shPixelUnpremultiplyRowScalar(&p_src[x * 4], &p_dst[x * 4], width - x);
+}
+
+static __m128i shFloatToUnormSse2(
+	__m128 value
+) {
+	value = _mm_min_ps(_mm_max_ps(value, _mm_setzero_ps()), _mm_set1_ps(1.0f));//maxps returns 0 for NaN
+	return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(value, _mm_set1_ps(255.0f)), _mm_set1_ps(0.5f)));
+}
+
+static void shPixelFloatToUnormRowSse2(
+	const uint8_t* p_src,
+	uint8_t*       p_dst,
+	uint32_t       width
+) {
+	const float* p_texels = (const float*)p_src;
+
+	uint32_t x = 0;
+	for (; x + 4 <= width; x += 4) {
+		__m128i t0 = shFloatToUnormSse2(_mm_loadu_ps(&p_texels[x * 4 + 0]));
+		__m128i t1 = shFloatToUnormSse2(_mm_loadu_ps(&p_texels[x * 4 + 4]));
+		__m128i t2 = shFloatToUnormSse2(_mm_loadu_ps(&p_texels[x * 4 + 8]));
+		__m128i t3 = shFloatToUnormSse2(_mm_loadu_ps(&p_texels[x * 4 + 12]));
+		_mm_storeu_si128((__m128i*)&p_dst[x * 4], _mm_packus_epi16(_mm_packs_epi32(t0, t1), _mm_packs_epi32(t2, t3)));
+	}
+	shPixelFloatToUnormRowScalar(&p_src[x * 16], &p_dst[x * 4], width - x);
+}
+
+//
+//AVX2, unpremultiply keeps the SSE2 implementation which is bound by the division
+//
+SH_TARGET_AVX2 static void shPixelSwizzleRowAvx2(
+	const uint8_t* p_src,
+	uint8_t*       p_dst,
+	uint32_t       width
+) {
+	const __m256i shuffle = _mm256_setr_epi8(
+		2, 1, 0, 3,  6, 5, 4, 7,  10, 9, 8, 11,  14, 13, 12, 15,
+		2, 1, 0, 3,  6, 5, 4, 7,  10, 9, 8, 11,  14, 13, 12, 15
+	);
+
+	uint32_t x = 0;
+	for (; x + 8 <= width; x += 8) {
+		__m256i texels = _mm256_loadu_si256((const __m256i*)&p_src[x * 4]);
+		_mm256_storeu_si256((__m256i*)&p_dst[x * 4], _mm256_shuffle_epi8(texels, shuffle));
+	}
+	shPixelSwizzleRowScalar(&p_src[x * 4], &p_dst[x * 4], width - x);
+}
+
+SH_TARGET_AVX2 static __m256i shPremultiplyAvx2(
+	__m256i texels,//4 texels, 16 bit channels
+	__m256i alpha_mask
+) {
+	__m256i alpha = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(texels, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+	__m256i t     = _mm256_add_epi16(_mm256_mullo_epi16(texels, alpha), _mm256_set1_epi16(128));
+	t = _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+	return _mm256_blendv_epi8(t, texels, alpha_mask);
+}
+
+SH_TARGET_AVX2 static void shPixelPremultiplyRowAvx2(
+	const uint8_t* p_src,
+	uint8_t*       p_dst,
+	uint32_t       width
+) {
+	const __m256i zero       = _mm256_setzero_si256();
+	const __m256i alpha_mask = _mm256_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0);
+
+	uint32_t x = 0;
+	for (; x + 8 <= width; x += 8) {
+		__m256i texels = _mm256_loadu_si256((const __m256i*)&p_src[x * 4]);
+		__m256i lo     = shPremultiplyAvx2(_mm256_unpacklo_epi8(texels, zero), alpha_mask);//in lane
+		__m256i hi     = shPremultiplyAvx2(_mm256_unpackhi_epi8(texels, zero), alpha_mask);
+		_mm256_storeu_si256((__m256i*)&p_dst[x * 4], _mm256_packus_epi16(lo, hi));
+	}
+	shPixelPremultiplyRowScalar(&p_src[x * 4], &p_dst[x * 4], width - x);
+}
+
+SH_TARGET_AVX2 static __m256i shFloatToUnormAvx2(
+	__m256 value
+) {
+	value = _mm256_min_ps(_mm256_max_ps(value, _mm256_setzero_ps()), _mm256_set1_ps(1.0f));
+	return _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(value, _mm256_set1_ps(255.0f)), _mm256_set1_ps(0.5f)));
+}
+
+SH_TARGET_AVX2 static void shPixelFloatToUnormRowAvx2(
+	const uint8_t* p_src,
+	uint8_t*       p_dst,
+	uint32_t       width
+) {
+	const float*  p_texels = (const float*)p_src;
+	const __m256i order    = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);//packs interleave the 128 bit lanes
+
+	uint32_t x = 0;
+	for (; x + 8 <= width; x += 8) {
+		__m256i t0 = shFloatToUnormAvx2(_mm256_loadu_ps(&p_texels[x * 4 + 0]));
+		__m256i t1 = shFloatToUnormAvx2(_mm256_loadu_ps(&p_texels[x * 4 + 8]));
+		__m256i t2 = shFloatToUnormAvx2(_mm256_loadu_ps(&p_texels[x * 4 + 16]));
+		__m256i t3 = shFloatToUnormAvx2(_mm256_loadu_ps(&p_texels[x * 4 + 24]));
+		__m256i texels = _mm256_packus_epi16(_mm256_packs_epi32(t0, t1), _mm256_packs_epi32(t2, t3));
+		_mm256_storeu_si256((__m256i*)&p_dst[x * 4], _mm256_permutevar8x32_epi32(texels, order));
+	}
+	shPixelFloatToUnormRowSse2(&p_src[x * 16], &p_dst[x * 4], width - x);
+}
+
+static uint8_t shCpuSupportsAvx2(
+	void
+) {
+#if defined(_MSC_VER)
+	int info[4] = { 0 };
+	__cpuid(info, 0);
+	if (info[0] < 7) {
+		return 0;
+	}
+	__cpuid(info, 1);
+	uint8_t os_avx = (info[2] & (1 << 27)) && (info[2] & (1 << 28));//OSXSAVE and AVX
+	if (!os_avx || (_xgetbv(0) & 6) != 6) {//xmm and ymm state saved by the OS
+		return 0;
+	}
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#else
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2") != 0;
+#endif//_MSC_VER
+}
+#endif//SH_PIXEL_X86
+
+#ifdef SH_PIXEL_NEON
+//
+//NEON
+//
+static void shPixelSwizzleRowNeon(
+	const uint8_t* p_src,
+	uint8_t*       p_dst,
+	uint32_t       width
+) {
+	uint32_t x = 0;
+	for (; x + 16 <= width; x += 16) {
+		uint8x16x4_t texels = vld4q_u8(&p_src[x * 4]);
+		uint8x16_t   c0     = texels.val[0];
+		texels.val[0] = texels.val[2];
+		texels.val[2] = c0;
+		vst4q_u8(&p_dst[x * 4], texels);
+	}
+	shPixelSwizzleRowScalar(&p_src[x * 4], &p_dst[x * 4], width - x);
+}
+
+static uint8x8_t shPremultiplyNeon(
+	uint8x8_t color,
+	uint8x8_t alpha
+) {
+	uint16x8_t t = vmlal_u8(vdupq_n_u16(128), color, alpha);
+	return vshrn_n_u16(vsraq_n_u16(t, t, 8), 8);
+}
+
+static void shPixelPremultiplyRowNeon(
+	const uint8_t* p_src,
+	uint8_t*       p_dst,
+	uint32_t       width
+) {
+	uint32_t x = 0;
+	for (; x + 16 <= width; x += 16) {
+		uint8x16x4_t texels = vld4q_u8(&p_src[x * 4]);
+		uint8x8_t    lo     = vget_low_u8(texels.val[3]);
+		uint8x8_t    hi     = vget_high_u8(texels.val[3]);
+		for (uint32_t channel = 0; channel < 3; channel++) {
+			texels.val[channel] = vcombine_u8(
+				shPremultiplyNeon(vget_low_u8(texels.val[channel]), lo),
+				shPremultiplyNeon(vget_high_u8(texels.val[channel]), hi)
+			);
+		}
+		vst4q_u8(&p_dst[x * 4], texels);
+	}
+	shPixelPremultiplyRowScalar(&p_src[x * 4], &p_dst[x * 4], width - x);
+}
+
+static float32x4_t shNeonU8ToF32(
+	uint8x16_t value,
+	uint32_t   quarter
+) {
+	uint16x8_t half = quarter < 2 ? vmovl_u8(vget_low_u8(value)) : vmovl_u8(vget_high_u8(value));
+	return vcvtq_f32_u32(vmovl_u16((quarter & 1) ? vget_high_u16(half) : vget_low_u16(half)));
+}
+
+static void shPixelUnpremultiplyRowNeon(
+	const uint8_t* p_src,
+	uint8_t*       p_dst,
+	uint32_t       width
+) {
+	const float32x4_t zero = vdupq_n_f32(0.0f);
+
+	uint32_t x = 0;
+	for (; x + 16 <= width; x += 16) {
+		uint8x16x4_t texels    = vld4q_u8(&p_src[x * 4]);
+		float32x4_t  scales[4] = { zero };
+		for (uint32_t quarter = 0; quarter < 4; quarter++) {
+			float32x4_t alpha = shNeonU8ToF32(texels.val[3], quarter);
+			uint32x4_t  scale = vreinterpretq_u32_f32(vdivq_f32(vdupq_n_f32(255.0f), alpha));
+			scales[quarter]   = vreinterpretq_f32_u32(vandq_u32(scale, vcgtq_f32(alpha, zero)));
+		}
+		for (uint32_t channel = 0; channel < 3; channel++) {
+			uint16x4_t values[4];
+			for (uint32_t quarter = 0; quarter < 4; quarter++) {
+				float32x4_t value = vmulq_f32(shNeonU8ToF32(texels.val[channel], quarter), scales[quarter]);
+				value = vminq_f32(vaddq_f32(value, vdupq_n_f32(0.5f)), vdupq_n_f32(255.0f));
+				values[quarter] = vmovn_u32(vcvtq_u32_f32(value));
+			}
+			texels.val[channel] = vcombine_u8(
+				vmovn_u16(vcombine_u16(values[0], values[1])),
+				vmovn_u16(vcombine_u16(values[2], values[3]))
+			);
+		}
+		vst4q_u8(&p_dst[x * 4], texels);
+	}
+	shPixelUnpremultiplyRowScalar(&p_src[x * 4], &p_dst[x * 4], width - x);
+}
+
+static uint16x4_t shFloatToUnormNeon(
+	float32x4_t value
+) {
+	value = vminq_f32(vmaxnmq_f32(value, vdupq_n_f32(0.0f)), vdupq_n_f32(1.0f));//maxnm returns 0 for NaN
+	return vmovn_u32(vcvtq_u32_f32(vaddq_f32(vmulq_f32(value, vdupq_n_f32(255.0f)), vdupq_n_f32(0.5f))));
+}
+
+static void shPixelFloatToUnormRowNeon(
+	const uint8_t* p_src,
+	uint8_t*       p_dst,
+	uint32_t       width
+) {
+	const float* p_texels = (const float*)p_src;
+
+	uint32_t x = 0;
+	for (; x + 4 <= width; x += 4) {
+		uint16x4_t t0 = shFloatToUnormNeon(vld1q_f32(&p_texels[x * 4 + 0]));
+		uint16x4_t t1 = shFloatToUnormNeon(vld1q_f32(&p_texels[x * 4 + 4]));
+		uint16x4_t t2 = shFloatToUnormNeon(vld1q_f32(&p_texels[x * 4 + 8]));
+		uint16x4_t t3 = shFloatToUnormNeon(vld1q_f32(&p_texels[x * 4 + 12]));
+		vst1q_u8(&p_dst[x * 4], vcombine_u8(vmovn_u16(vcombine_u16(t0, t1)), vmovn_u16(vcombine_u16(t2, t3))));
+	}
+	shPixelFloatToUnormRowScalar(&p_src[x * 16], &p_dst[x * 4], width - x);
+}
+#endif//SH_PIXEL_NEON
+
+static int32_t sh_pixel_isa = -1;//selected on first use
+
+static uint8_t shPixelIsaSupported(
+	ShVkPixelIsa isa
+) {
+	switch (isa) {
+	case SH_PIXEL_ISA_SCALAR:
+		return 1;
+#ifdef SH_PIXEL_X86
+	case SH_PIXEL_ISA_SSE2:
+		return 1;
+	case SH_PIXEL_ISA_AVX2:
+		return shCpuSupportsAvx2();
+#endif//SH_PIXEL_X86
+#ifdef SH_PIXEL_NEON
+	case SH_PIXEL_ISA_NEON:
+		return 1;
+#endif//SH_PIXEL_NEON
+	default:
+		return 0;
+	}
+}
+
+ShVkPixelIsa shGetPixelConversionIsa(
+	void
+) {
+	if (sh_pixel_isa < 0) {
+		ShVkPixelIsa isa = SH_PIXEL_ISA_SCALAR;
+		if (shPixelIsaSupported(SH_PIXEL_ISA_NEON)) {
+			isa = SH_PIXEL_ISA_NEON;
+		}
+		else if (shPixelIsaSupported(SH_PIXEL_ISA_AVX2)) {
+			isa = SH_PIXEL_ISA_AVX2;
+		}
+		else if (shPixelIsaSupported(SH_PIXEL_ISA_SSE2)) {
+			isa = SH_PIXEL_ISA_SSE2;
+		}
+		sh_pixel_isa = (int32_t)isa;//same value from every thread
+	}
+	return (ShVkPixelIsa)sh_pixel_isa;
+}
+
+uint8_t shSetPixelConversionIsa(
+	ShVkPixelIsa isa
+) {
+	shVkError(shPixelIsaSupported(isa) == 0, "unsupported pixel conversion instruction set", return 0);
+
+	sh_pixel_isa = (int32_t)isa;
+
+	return 1;
+}
+
+static ShPixelRowFunction shGetPixelRowFunction(
+	ShVkPixelConversion conversion,
+	ShVkPixelIsa        isa
+) {
+	ShPixelRowFunction functions[4] = {//swizzle, premultiply, unpremultiply, float to unorm
+		shPixelSwizzleRowScalar, shPixelPremultiplyRowScalar, shPixelUnpremultiplyRowScalar, shPixelFloatToUnormRowScalar
+	};
+
+	switch (isa) {
+#ifdef SH_PIXEL_X86
+	case SH_PIXEL_ISA_SSE2:
+		functions[0] = shPixelSwizzleRowSse2;
+		functions[1] = shPixelPremultiplyRowSse2;
+		functions[2] = shPixelUnpremultiplyRowSse2;
+		functions[3] = shPixelFloatToUnormRowSse2;
+		break;
+	case SH_PIXEL_ISA_AVX2:
+		functions[0] = shPixelSwizzleRowAvx2;
+		functions[1] = shPixelPremultiplyRowAvx2;
+		functions[2] = shPixelUnpremultiplyRowSse2;
+		functions[3] = shPixelFloatToUnormRowAvx2;
+		break;
+#endif//SH_PIXEL_X86
+#ifdef SH_PIXEL_NEON
+	case SH_PIXEL_ISA_NEON:
+		functions[0] = shPixelSwizzleRowNeon;
+		functions[1] = shPixelPremultiplyRowNeon;
+		functions[2] = shPixelUnpremultiplyRowNeon;
+		functions[3] = shPixelFloatToUnormRowNeon;
+		break;
+#endif//SH_PIXEL_NEON
+	default:
+		break;
+	}
+
+	switch (conversion) {
+	case SH_PIXEL_CONVERSION_COPY:
+		return shPixelCopyRow;
+	case SH_PIXEL_CONVERSION_SWIZZLE_RB:
+		return functions[0];
+	case SH_PIXEL_CONVERSION_PREMULTIPLY:
+		return functions[1];
+	case SH_PIXEL_CONVERSION_UNPREMULTIPLY:
+		return functions[2];
+	case SH_PIXEL_CONVERSION_RGBA32F_TO_RGBA8:
+		return functions[3];
+	default:
+		return VK_NULL_HANDLE;
+	}
+}
+
+typedef struct ShPixelConversionJob {
+	ShPixelRowFunction row_function;
+	const uint8_t*     p_src;
+	uint8_t*           p_dst;
+	uint64_t           src_row_pitch;
+	uint64_t           dst_row_pitch;
+	uint32_t           width;
+	uint32_t           first_row;
+	uint32_t           row_count;
+} ShPixelConversionJob;
+
+//run by the pool for any job type, the argument points to one job of the pushed array
+typedef void (*ShPixelJobFunction)(const void* p_job);
+
+static void shRunPixelConversionJob(
+	const void* p_arg
+) {
+	const ShPixelConversionJob* p_job = (const ShPixelConversionJob*)p_arg;
+
+	for (uint32_t row = p_job->first_row; row < p_job->first_row + p_job->row_count; row++) {
+		p_job->row_function(
+			&p_job->p_src[p_job->src_row_pitch * row],
+			&p_job->p_dst[p_job->dst_row_pitch * row],
+			p_job->width
+		);
+	}
+}
+
+//shared by pixel conversions and tile hashing
+typedef struct ShPixelConversionPool {
+	ShMutex            mutex;
+	ShCondition        pushed;                                            //signaled when jobs are pushed
+	ShCondition        finished;                                          //signaled when the jobs of a call are finished
+	ShThread           threads[SH_MAX_PIXEL_CONVERSION_THREAD_COUNT - 1];
+	uint32_t           thread_count;
+	ShPixelJobFunction job_function;
+	const uint8_t*     p_jobs;
+	size_t             job_size;
+	uint32_t           job_count;
+	uint32_t           next_job_idx;
+	uint32_t           pending_job_count;
+	uint8_t            in_use;                                            //a call owns the jobs
+} ShPixelConversionPool;
+
+static ShPixelConversionPool sh_pixel_conversion_pool;
+static uint64_t              sh_pixel_conversion_pool_state = 0;//0 not started, 1 starting, 2 started
+
+//workers live as long as the process, so consecutive conversions do not pay thread creation
+static SH_THREAD_FUNCTION(shPixelConversionWorker) {
+	ShPixelConversionPool* p_pool = (ShPixelConversionPool*)p_arg;
+
+	shMutexLock(&p_pool->mutex);
+	for (;;) {
+		while (p_pool->next_job_idx >= p_pool->job_count) {
+			shConditionWait(&p_pool->pushed, &p_pool->mutex);
+		}
+		ShPixelJobFunction job_function = p_pool->job_function;
+		const void*        p_job        = &p_pool->p_jobs[p_pool->job_size * p_pool->next_job_idx];
+		p_pool->next_job_idx++;
+
+		shMutexUnlock(&p_pool->mutex);
+		job_function(p_job);
+		shMutexLock(&p_pool->mutex);
+
+		p_pool->pending_job_count--;
+		if (p_pool->pending_job_count == 0) {
+			shConditionBroadcast(&p_pool->finished);
+		}
+	}
+
+	SH_THREAD_RETURN;
+}
+
+static uint32_t shGetProcessorCount(
+	void
+) {
+#ifdef _WIN32
+	SYSTEM_INFO system_info = { 0 };
+	GetSystemInfo(&system_info);
+	return (uint32_t)system_info.dwNumberOfProcessors;
+#else
+	long processor_count = sysconf(_SC_NPROCESSORS_ONLN);
+	return processor_count > 0 ? (uint32_t)processor_count : 1;
+#endif//_WIN32
+}
+
+static ShPixelConversionPool* shGetPixelConversionPool(
+	void
+) {
+	ShPixelConversionPool* p_pool = &sh_pixel_conversion_pool;
+
+	uint64_t state = 0;
+	if (SH_ATOMIC_CAS_U64(&sh_pixel_conversion_pool_state, state, 1)) {
+		shMutexInit(&p_pool->mutex);
+		shConditionInit(&p_pool->pushed);
+		shConditionInit(&p_pool->finished);
+
+		uint32_t worker_count = shGetProcessorCount() - 1;
+		worker_count = worker_count < SH_MAX_PIXEL_CONVERSION_THREAD_COUNT - 1 ? worker_count : SH_MAX_PIXEL_CONVERSION_THREAD_COUNT - 1;
+		for (uint32_t thread_idx = 0; thread_idx < worker_count; thread_idx++) {
+			if (!shThreadCreate(&p_pool->threads[p_pool->thread_count], shPixelConversionWorker, p_pool)) {
+				break;//the calling threads convert the jobs left
+			}
+			p_pool->thread_count++;
+		}
+
+		SH_ATOMIC_STORE_U64(&sh_pixel_conversion_pool_state, 2);
+	}
+
+	while (SH_ATOMIC_LOAD_U64(&sh_pixel_conversion_pool_state) != 2) {
+		//another thread is starting the workers
+	}
+
+	return p_pool;
+}
+
+//pushes the jobs to the workers and returns once all of them are finished
+static void shRunPixelJobs(
+	ShPixelJobFunction job_function,
+	const void*        p_jobs,
+	size_t             job_size,
+	uint32_t           job_count
+) {
+	ShPixelConversionPool* p_pool = shGetPixelConversionPool();
+
+	shMutexLock(&p_pool->mutex);
+	while (p_pool->in_use) {//one call at a time pushes jobs
+		shConditionWait(&p_pool->finished, &p_pool->mutex);
+	}
+	p_pool->in_use            = 1;
+	p_pool->job_function      = job_function;
+	p_pool->p_jobs            = (const uint8_t*)p_jobs;
+	p_pool->job_size          = job_size;
+	p_pool->job_count         = job_count;
+	p_pool->next_job_idx      = 0;
+	p_pool->pending_job_count = job_count;
+	shConditionBroadcast(&p_pool->pushed);
+
+	//the calling thread runs jobs as well, so every job completes even without workers
+	while (p_pool->next_job_idx < p_pool->job_count) {
+		const void* p_job = &p_pool->p_jobs[p_pool->job_size * p_pool->next_job_idx];
+		p_pool->next_job_idx++;
+
+		shMutexUnlock(&p_pool->mutex);
+		job_function(p_job);
+		shMutexLock(&p_pool->mutex);
+
+		p_pool->pending_job_count--;
+	}
+	while (p_pool->pending_job_count != 0) {
+		shConditionWait(&p_pool->finished, &p_pool->mutex);
+	}
+
+	p_pool->in_use       = 0;
+	p_pool->job_function = VK_NULL_HANDLE;
+	p_pool->p_jobs       = VK_NULL_HANDLE;
+	p_pool->job_count    = 0;
+	p_pool->next_job_idx = 0;
+	shConditionBroadcast(&p_pool->finished);//wakes the calls waiting for the pool
+	shMutexUnlock(&p_pool->mutex);
+}
+
+uint8_t shConvertPixels(
+	ShVkPixelConversion conversion,
+	uint32_t            width,
+	uint32_t            height,
+	const void*         p_src,
+	uint64_t            src_row_pitch,
+	void*               p_dst,
+	uint64_t            dst_row_pitch,
+	uint32_t            thread_count
+) {
+	shVkArgError(p_src == VK_NULL_HANDLE, "invalid source texels memory",      return 0);
+	shVkArgError(p_dst == VK_NULL_HANDLE, "invalid destination texels memory", return 0);
+
+	ShPixelRowFunction row_function = shGetPixelRowFunction(conversion, shGetPixelConversionIsa());
+	shVkError(row_function == VK_NULL_HANDLE, "invalid pixel conversion", return 0);
+
+	if (width == 0 || height == 0) {
+		return 1;
+	}
+
+	uint64_t src_row_size = (uint64_t)width * (conversion == SH_PIXEL_CONVERSION_RGBA32F_TO_RGBA8 ? 16 : 4);
+	uint64_t dst_row_size = (uint64_t)width * 4;
+
+	src_row_pitch = src_row_pitch ? src_row_pitch : src_row_size;
+	dst_row_pitch = dst_row_pitch ? dst_row_pitch : dst_row_size;
+
+	shVkError(src_row_pitch < src_row_size, "source row pitch smaller than a row",      return 0);
+	shVkError(dst_row_pitch < dst_row_size, "destination row pitch smaller than a row", return 0);
+
+	uint8_t in_place = (const void*)p_dst == p_src;
+	shVkError(
+		in_place && dst_row_pitch > src_row_pitch,
+		"in place conversion with a destination row pitch larger than the source one",
+		return 0
+	);
+
+	if (thread_count == 0) {
+		uint64_t pixel_count = (uint64_t)width * height;
+		thread_count = (uint32_t)(pixel_count / SH_PIXEL_CONVERSION_PIXELS_PER_THREAD) + 1;
+		uint32_t processor_count = shGetProcessorCount();
+		thread_count = thread_count < processor_count ? thread_count : processor_count;
+	}
+	thread_count = thread_count < SH_MAX_PIXEL_CONVERSION_THREAD_COUNT ? thread_count : SH_MAX_PIXEL_CONVERSION_THREAD_COUNT;
+	thread_count = thread_count < height ? thread_count : height;
+
+	//in place rows with different pitches overwrite source rows of other jobs, a single thread writes behind its reads
+	if (in_place && dst_row_pitch != src_row_pitch) {
+		thread_count = 1;
+	}
+
+	ShPixelConversionJob jobs[SH_MAX_PIXEL_CONVERSION_THREAD_COUNT] = { 0 };
+
+	uint32_t rows_per_job = height / thread_count;
+	uint32_t extra_rows   = height % thread_count;
+	uint32_t first_row    = 0;
+
+	for (uint32_t job_idx = 0; job_idx < thread_count; job_idx++) {
+		ShPixelConversionJob* p_job = &jobs[job_idx];
+		p_job->row_function  = row_function;
+		p_job->p_src         = (const uint8_t*)p_src;
+		p_job->p_dst         = (uint8_t*)p_dst;
+		p_job->src_row_pitch = src_row_pitch;
+		p_job->dst_row_pitch = dst_row_pitch;
+		p_job->width         = width;
+		p_job->first_row     = first_row;
+		p_job->row_count     = rows_per_job + (job_idx < extra_rows ? 1 : 0);
+		first_row += p_job->row_count;
+	}
+
+	if (thread_count == 1) {
+		shRunPixelConversionJob(&jobs[0]);
+		return 1;
+	}
+
+	shRunPixelJobs(shRunPixelConversionJob, jobs, sizeof(ShPixelConversionJob), thread_count);
+
+	return 1;
+}
+
+
+
+
+uint8_t shGetPackedImageSize(
+	ShVkPackFormat format,
+	uint32_t       width,
+	uint32_t       height,
+	VkDeviceSize*  p_size
+) {
+	shVkArgError(width == 0 || height == 0, "invalid image size",         return 0);
+	shVkArgError(p_size == VK_NULL_HANDLE,  "invalid packed size memory", return 0);
+
+	VkDeviceSize texel_count = (VkDeviceSize)width * (VkDeviceSize)height;
+
+	switch (format) {
+	case SH_PACK_FORMAT_RGBA8:
+		(*p_size) = texel_count * 4;
+		break;
+	case SH_PACK_FORMAT_RGB565:
+		shVkError(width % 2 != 0, "rgb565 packing needs an even width", return 0);
+		(*p_size) = texel_count * 2;
+		break;
+	case SH_PACK_FORMAT_YUV420:
+		shVkError(
+			width % 8 != 0 || height % 2 != 0,
+			"yuv420 packing needs a width multiple of 8 and an even height",
+			return 0
+		);
+		(*p_size) = texel_count + texel_count / 2;
+		break;
+	default:
+		shVkError(1, "invalid pack format", return 0);
+	}
+
+	return 1;
+}
+
+uint8_t shCmdPackImage(
+	VkDevice          device,
+	VkCommandBuffer   cmd_buffer,
+	VkImage           image,
+	VkImageLayout     image_layout,
+	uint32_t          width,
+	uint32_t          height,
+	uint8_t           swizzle_rb,
+	ShVkPackFormat    format,
+	VkBuffer          texel_buffer,
+	VkBuffer          packed_buffer,
+	uint32_t          first_descriptor_set_unit_idx,
+	ShVkPipelinePool* p_pipeline_pool,
+	ShVkPipeline*     p_pipeline
+) {
+	shVkArgError(device          == VK_NULL_HANDLE, "invalid device memory",         return 0);
+	shVkArgError(cmd_buffer      == VK_NULL_HANDLE, "invalid command buffer memory", return 0);
+	shVkArgError(image           == VK_NULL_HANDLE, "invalid image memory",          return 0);
+	shVkArgError(texel_buffer    == VK_NULL_HANDLE, "invalid texel buffer memory",   return 0);
+	shVkArgError(packed_buffer   == VK_NULL_HANDLE, "invalid packed buffer memory",  return 0);
+	shVkArgError(p_pipeline_pool == VK_NULL_HANDLE, "invalid pipeline pool memory",  return 0);
+	shVkArgError(p_pipeline      == VK_NULL_HANDLE, "invalid pipeline memory",       return 0);
+
+	VkDeviceSize packed_size = 0;
+	shVkError(shGetPackedImageSize(format, width, height, &packed_size) == 0, "invalid pack parameters", return 0);
+
+	//one texel, two texels or an 8x2 block per invocation
+	uint32_t invocation_count_x = format == SH_PACK_FORMAT_RGBA8  ? width     :
+	                              format == SH_PACK_FORMAT_RGB565 ? width / 2 : width / 8;
+	uint32_t invocation_count_y = format == SH_PACK_FORMAT_YUV420 ? height / 2 : height;
+
+	if (image_layout != VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL) {
+		shSetImageMemoryBarrier(
+			device, cmd_buffer, image, VK_IMAGE_ASPECT_COLOR_BIT,
+			VK_ACCESS_MEMORY_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+			image_layout, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+			VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED,
+			VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT
+		);
+	}
+
+	VkBufferImageCopy region = {
+		.bufferOffset      = 0,                      //bufferOffset;
+		.bufferRowLength   = 0,                      //bufferRowLength;
+		.bufferImageHeight = 0,                      //bufferImageHeight;
+		.imageSubresource  = {
+			.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
+			.mipLevel       = 0,
+			.baseArrayLayer = 0,
+			.layerCount     = 1
+		},                                           //imageSubresource;
+		.imageOffset       = { 0, 0, 0 },            //imageOffset;
+		.imageExtent       = { width, height, 1 }    //imageExtent;
+	};
+	vkCmdCopyImageToBuffer(
+		cmd_buffer,
+		image,
+		VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+		texel_buffer,
+		1,
+		&region
+	);
+
+	if (image_layout != VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL && image_layout != VK_IMAGE_LAYOUT_UNDEFINED) {
+		shSetImageMemoryBarrier(
+			device, cmd_buffer, image, VK_IMAGE_ASPECT_COLOR_BIT,
+			VK_ACCESS_TRANSFER_READ_BIT, VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT,
+			VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, image_layout,
+			VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED,
+			VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT
+		);
+	}
+
+	shSetBufferMemoryBarrier(
+		device, cmd_buffer, texel_buffer,
+		VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT,
+		VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED,
+		VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT
+	);
+
+	ShVkPackPushConstants push_constants = {
+		.width      = width,           //width;
+		.height     = height,          //height;
+		.format     = (uint32_t)format,//format;
+		.swizzle_rb = swizzle_rb       //swizzle_rb;
+	};
+
+	shBindPipeline(cmd_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, p_pipeline);
+
+	shPipelineBindDescriptorSetUnits(
+		cmd_buffer,                     //cmd_buffer
+		0,                              //first_descriptor_set
+		first_descriptor_set_unit_idx,  //first_descriptor_set_unit_idx
+		2,                              //descriptor_set_unit_count
+		VK_PIPELINE_BIND_POINT_COMPUTE, //bind_point
+		0,                              //dynamic_descriptors_count
+		VK_NULL_HANDLE,                 //p_dynamic_offsets
+		p_pipeline_pool,                //p_pipeline_pool
+		p_pipeline                      //p_pipeline
+	);
+
+	shPipelinePushConstants(cmd_buffer, &push_constants, p_pipeline);
+
+	shCmdDispatch(
+		cmd_buffer,
+		(invocation_count_x + SH_PACK_LOCAL_SIZE_X - 1) / SH_PACK_LOCAL_SIZE_X,
+		(invocation_count_y + SH_PACK_LOCAL_SIZE_Y - 1) / SH_PACK_LOCAL_SIZE_Y,
+		1
+	);
+
+	shSetBufferMemoryBarrier(
+		device, cmd_buffer, packed_buffer,
+		VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_HOST_READ_BIT,
+		VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED,
+		VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_HOST_BIT
+	);
+
+	return 1;
+}
+
+
+
+
+//
+//TILE HASH: 4 lanes of 64 bit accumulators fed with 32 byte stripes, each stripe mixed with its own key,
+//scrambled after every row so that moving stripes or rows changes the hash
+//
+#define SH_TILE_HASH_STRIPE_SIZE 32
+#define SH_TILE_HASH_KEY_STEP    0x9E3779B97F4A7C15ull
+#define SH_TILE_HASH_PRIME32     0x9E3779B1ull
+
+static const uint64_t sh_tile_hash_keys[4] = {
+	0xBE4BA423396CFEB8ull, 0x1CAD21F72C81017Cull, 0xDB979083E96DD4DEull, 0x1F67B3B7A4A44072ull
+};
+
+static const uint64_t sh_tile_hash_scramble_keys[4] = {
+	0x78E5C0CC4EE679CBull, 0x2172FFCC7DD05A82ull, 0x8E2443F7744608B8ull, 0x4C263A81E69035E0ull
+};
+
+static uint64_t shMix64(
+	uint64_t value
+) {
+	value ^= value >> 33;
+	value *= 0xFF51AFD7ED558CCDull;
+	value ^= value >> 33;
+	value *= 0xC4CEB9FE1A85EC53ull;
+	value ^= value >> 33;
+	return value;
+}
+
+static uint64_t shFoldTileHash(
+	const uint64_t acc[4]
+) {
+	return shMix64(acc[0] + shMix64(acc[1] + shMix64(acc[2] + shMix64(acc[3]))));
+}
+
+typedef uint64_t (*ShTileHashFunction)(const uint8_t* p_src, uint64_t row_pitch, uint32_t row_size, uint32_t row_count);
+
+static uint64_t shHashTileScalar(
+	const uint8_t* p_src,
+	uint64_t       row_pitch,
+	uint32_t       row_size,
+	uint32_t       row_count
+) {
+	uint64_t acc[4] = { 0 };
+	uint8_t  tail[SH_TILE_HASH_STRIPE_SIZE];
+
+	for (uint32_t row = 0; row < row_count; row++) {
+		const uint8_t* p_row  = &p_src[row_pitch * row];
+		uint64_t       key[4] = { sh_tile_hash_keys[0], sh_tile_hash_keys[1], sh_tile_hash_keys[2], sh_tile_hash_keys[3] };
+
+		for (uint32_t offset = 0; offset < row_size; offset += SH_TILE_HASH_STRIPE_SIZE) {
+			const uint8_t* p_stripe = &p_row[offset];
+			if (row_size - offset < SH_TILE_HASH_STRIPE_SIZE) {
+				memset(tail, 0, sizeof(tail));
+				memcpy(tail, p_stripe, row_size - offset);
+				p_stripe = tail;
+			}
+			uint64_t data[4];
+			memcpy(data, p_stripe, sizeof(data));
+			for (uint32_t lane = 0; lane < 4; lane++) {
+				uint64_t data_key = data[lane] ^ key[lane];
+				acc[lane]     += (data_key & 0xFFFFFFFFull) * (data_key >> 32);
+				acc[lane ^ 1] += data[lane];
+				key[lane]     += SH_TILE_HASH_KEY_STEP;
+			}
+		}
+
+		for (uint32_t lane = 0; lane < 4; lane++) {
+			acc[lane] = (acc[lane] ^ (acc[lane] >> 47) ^ sh_tile_hash_scramble_keys[lane]) * SH_TILE_HASH_PRIME32;
+		}
+	}
+
+	return shFoldTileHash(acc);
+}
+
+#ifdef SH_PIXEL_X86
+static __m128i shTileHashMulSse2(
+	__m128i value//64 bit lanes times SH_TILE_HASH_PRIME32
+) {
+	const __m128i prime = _mm_set1_epi64x((long long)SH_TILE_HASH_PRIME32);
+	__m128i lo = _mm_mul_epu32(value, prime);
+	__m128i hi = _mm_slli_epi64(_mm_mul_epu32(_mm_srli_epi64(value, 32), prime), 32);
+	return _mm_add_epi64(lo, hi);
+}
+
+static void shTileHashStripeSse2(
+	__m128i*      p_acc,
+	__m128i       data,
+	__m128i       key
+) {
+	__m128i data_key = _mm_xor_si128(data, key);
+	__m128i product  = _mm_mul_epu32(data_key, _mm_srli_epi64(data_key, 32));
+	(*p_acc) = _mm_add_epi64(*p_acc, _mm_add_epi64(product, _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2))));
+}
+
+static uint64_t shHashTileSse2(
+	const uint8_t* p_src,
+	uint64_t       row_pitch,
+	uint32_t       row_size,
+	uint32_t       row_count
+) {
+	const __m128i key_step = _mm_set1_epi64x((long long)SH_TILE_HASH_KEY_STEP);
+	const __m128i key_lo   = _mm_loadu_si128((const __m128i*)&sh_tile_hash_keys[0]);
+	const __m128i key_hi   = _mm_loadu_si128((const __m128i*)&sh_tile_hash_keys[2]);
+	const __m128i scr_lo   = _mm_loadu_si128((const __m128i*)&sh_tile_hash_scramble_keys[0]);
+	const __m128i scr_hi   = _mm_loadu_si128((const __m128i*)&sh_tile_hash_scramble_keys[2]);
+
+	__m128i acc_lo = _mm_setzero_si128();
+	__m128i acc_hi = _mm_setzero_si128();
+	uint8_t tail[SH_TILE_HASH_STRIPE_SIZE];
+
+	for (uint32_t row = 0; row < row_count; row++) {
+		const uint8_t* p_row = &p_src[row_pitch * row];
+		__m128i        k_lo  = key_lo;
+		__m128i        k_hi  = key_hi;
+
+		for (uint32_t offset = 0; offset < row_size; offset += SH_TILE_HASH_STRIPE_SIZE) {
+			const uint8_t* p_stripe = &p_row[offset];
+			if (row_size - offset < SH_TILE_HASH_STRIPE_SIZE) {
+				memset(tail, 0, sizeof(tail));
+				memcpy(tail, p_stripe, row_size - offset);
+				p_stripe = tail;
+			}
+			shTileHashStripeSse2(&acc_lo, _mm_loadu_si128((const __m128i*)&p_stripe[0]),  k_lo);
+			shTileHashStripeSse2(&acc_hi, _mm_loadu_si128((const __m128i*)&p_stripe[16]), k_hi);
+			k_lo = _mm_add_epi64(k_lo, key_step);
+			k_hi = _mm_add_epi64(k_hi, key_step);
+		}
+
+		acc_lo = shTileHashMulSse2(_mm_xor_si128(_mm_xor_si128(acc_lo, _mm_srli_epi64(acc_lo, 47)), scr_lo));
+		acc_hi = shTileHashMulSse2(_mm_xor_si128(_mm_xor_si128(acc_hi, _mm_srli_epi64(acc_hi, 47)), scr_hi));
+	}
+
+	uint64_t acc[4];
+	_mm_storeu_si128((__m128i*)&acc[0], acc_lo);
+	_mm_storeu_si128((__m128i*)&acc[2], acc_hi);
+	return shFoldTileHash(acc);
+}
+
+SH_TARGET_AVX2 static uint64_t shHashTileAvx2(
+	const uint8_t* p_src,
+	uint64_t       row_pitch,
+	uint32_t       row_size,
+	uint32_t       row_count
+) {
+	const __m256i key_step  = _mm256_set1_epi64x((long long)SH_TILE_HASH_KEY_STEP);
+	const __m256i prime     = _mm256_set1_epi64x((long long)SH_TILE_HASH_PRIME32);
+	const __m256i key_start = _mm256_loadu_si256((const __m256i*)sh_tile_hash_keys);
+	const __m256i scramble  = _mm256_loadu_si256((const __m256i*)sh_tile_hash_scramble_keys);
+
+	__m256i acc = _mm256_setzero_si256();
+	uint8_t tail[SH_TILE_HASH_STRIPE_SIZE];
+
+	for (uint32_t row = 0; row < row_count; row++) {
+		const uint8_t* p_row = &p_src[row_pitch * row];
+		__m256i        key   = key_start;
+
+		for (uint32_t offset = 0; offset < row_size; offset += SH_TILE_HASH_STRIPE_SIZE) {
+			const uint8_t* p_stripe = &p_row[offset];
+			if (row_size - offset < SH_TILE_HASH_STRIPE_SIZE) {
+				memset(tail, 0, sizeof(tail));
+				memcpy(tail, p_stripe, row_size - offset);
+				p_stripe = tail;
+			}
+			__m256i data     = _mm256_loadu_si256((const __m256i*)p_stripe);
+			__m256i data_key = _mm256_xor_si256(data, key);
+			__m256i product  = _mm256_mul_epu32(data_key, _mm256_srli_epi64(data_key, 32));
+			acc = _mm256_add_epi64(acc, _mm256_add_epi64(product, _mm256_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2))));
+			key = _mm256_add_epi64(key, key_step);
+		}
+
+		acc = _mm256_xor_si256(_mm256_xor_si256(acc, _mm256_srli_epi64(acc, 47)), scramble);
+		acc = _mm256_add_epi64(
+			_mm256_mul_epu32(acc, prime),
+			_mm256_slli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(acc, 32), prime), 32)
+		);
+	}
+
+	uint64_t lanes[4];
+	_mm256_storeu_si256((__m256i*)lanes, acc);
+	return shFoldTileHash(lanes);
+}
+#endif//SH_PIXEL_X86
+
+#ifdef SH_PIXEL_NEON
+static uint64x2_t shTileHashMulNeon(
+	uint64x2_t value//64 bit lanes times SH_TILE_HASH_PRIME32
+) {
+	const uint32x2_t prime = vdup_n_u32((uint32_t)SH_TILE_HASH_PRIME32);
+	uint64x2_t lo = vmull_u32(vmovn_u64(value), prime);
+	uint64x2_t hi = vshlq_n_u64(vmull_u32(vshrn_n_u64(value, 32), prime), 32);
+	return vaddq_u64(lo, hi);
+}
+
+static uint64x2_t shTileHashStripeNeon(
+	uint64x2_t acc,
+	uint64x2_t data,
+	uint64x2_t key
+) {
+	uint64x2_t data_key = veorq_u64(data, key);
+	uint64x2_t product  = vmull_u32(vmovn_u64(data_key), vshrn_n_u64(data_key, 32));
+	return vaddq_u64(acc, vaddq_u64(product, vextq_u64(data, data, 1)));
+}
+
+static uint64_t shHashTileNeon(
+	const uint8_t* p_src,
+	uint64_t       row_pitch,
+	uint32_t       row_size,
+	uint32_t       row_count
+) {
+	const uint64x2_t key_step = vdupq_n_u64(SH_TILE_HASH_KEY_STEP);
+	const uint64x2_t key_lo   = vld1q_u64(&sh_tile_hash_keys[0]);
+	const uint64x2_t key_hi   = vld1q_u64(&sh_tile_hash_keys[2]);
+	const uint64x2_t scr_lo   = vld1q_u64(&sh_tile_hash_scramble_keys[0]);
+	const uint64x2_t scr_hi   = vld1q_u64(&sh_tile_hash_scramble_keys[2]);
+
+	uint64x2_t acc_lo = vdupq_n_u64(0);
+	uint64x2_t acc_hi = vdupq_n_u64(0);
+	uint8_t    tail[SH_TILE_HASH_STRIPE_SIZE];
+
+	for (uint32_t row = 0; row < row_count; row++) {
+		const uint8_t* p_row = &p_src[row_pitch * row];
+		uint64x2_t     k_lo  = key_lo;
+		uint64x2_t     k_hi  = key_hi;
+
+		for (uint32_t offset = 0; offset < row_size; offset += SH_TILE_HASH_STRIPE_SIZE) {
+			const uint8_t* p_stripe = &p_row[offset];
+			if (row_size - offset < SH_TILE_HASH_STRIPE_SIZE) {
+				memset(tail, 0, sizeof(tail));
+				memcpy(tail, p_stripe, row_size - offset);
+				p_stripe = tail;
+			}
+			acc_lo = shTileHashStripeNeon(acc_lo, vreinterpretq_u64_u8(vld1q_u8(&p_stripe[0])),  k_lo);
+			acc_hi = shTileHashStripeNeon(acc_hi, vreinterpretq_u64_u8(vld1q_u8(&p_stripe[16])), k_hi);
+			k_lo = vaddq_u64(k_lo, key_step);
+			k_hi = vaddq_u64(k_hi, key_step);
+		}
+
+		acc_lo = shTileHashMulNeon(veorq_u64(veorq_u64(acc_lo, vshrq_n_u64(acc_lo, 47)), scr_lo));
+		acc_hi = shTileHashMulNeon(veorq_u64(veorq_u64(acc_hi, vshrq_n_u64(acc_hi, 47)), scr_hi));
+	}
+
+	uint64_t acc[4];
+	vst1q_u64(&acc[0], acc_lo);
+	vst1q_u64(&acc[2], acc_hi);
+	return shFoldTileHash(acc);
+}
+#endif//SH_PIXEL_NEON
+
+static ShTileHashFunction shGetTileHashFunction(
+	ShVkPixelIsa isa
+) {
+	switch (isa) {
+#ifdef SH_PIXEL_X86
+	case SH_PIXEL_ISA_SSE2:
+		return shHashTileSse2;
+	case SH_PIXEL_ISA_AVX2:
+		return shHashTileAvx2;
+#endif//SH_PIXEL_X86
+#ifdef SH_PIXEL_NEON
+	case SH_PIXEL_ISA_NEON:
+		return shHashTileNeon;
+#endif//SH_PIXEL_NEON
+	default:
+		return shHashTileScalar;
+	}
+}
+
+typedef struct ShTileHashJob {
+	ShTileHashFunction hash_function;
+	const uint8_t*     p_src;
+	uint64_t           src_row_pitch;
+	ShVkTileTracker*   p_tracker;
+	uint32_t           first_tile_row;
+	uint32_t           tile_row_count;
+} ShTileHashJob;
+
+static void shRunTileHashJob(
+	const void* p_arg
+) {
+	const ShTileHashJob* p_job     = (const ShTileHashJob*)p_arg;
+	ShVkTileTracker*     p_tracker = p_job->p_tracker;
+
+	for (uint32_t tile_y = p_job->first_tile_row; tile_y < p_job->first_tile_row + p_job->tile_row_count; tile_y++) {
+		uint32_t y          = tile_y * p_tracker->tile_size;
+		uint32_t row_count  = p_tracker->height - y < p_tracker->tile_size ? p_tracker->height - y : p_tracker->tile_size;
+
+		for (uint32_t tile_x = 0; tile_x < p_tracker->tile_count_x; tile_x++) {
+			uint32_t x        = tile_x * p_tracker->tile_size;
+			uint32_t columns  = p_tracker->width - x < p_tracker->tile_size ? p_tracker->width - x : p_tracker->tile_size;
+			uint32_t tile_idx = tile_y * p_tracker->tile_count_x + tile_x;
+
+			uint64_t hash = p_job->hash_function(
+				&p_job->p_src[p_job->src_row_pitch * y + (uint64_t)x * p_tracker->texel_size],
+				p_job->src_row_pitch,
+				columns * p_tracker->texel_size,
+				row_count
+			);
+
+			p_tracker->p_dirty[tile_idx]  = p_tracker->full_frame || hash != p_tracker->p_hashes[tile_idx];
+			p_tracker->p_hashes[tile_idx] = hash;
+		}
+	}
+}
+
+uint8_t shCreateTileTracker(
+	uint32_t         width,
+	uint32_t         height,
+	uint32_t         texel_size,
+	uint32_t         tile_size,
+	ShVkTileTracker* p_tracker
+) {
+	shVkArgError(width == 0 || height == 0,   "invalid frame size",          return 0);
+	shVkArgError(texel_size == 0,             "invalid texel size",          return 0);
+	shVkArgError(tile_size  == 0,             "invalid tile size",           return 0);
+	shVkArgError(p_tracker == VK_NULL_HANDLE, "invalid tile tracker memory", return 0);
+
+	p_tracker->width        = width;
+	p_tracker->height       = height;
+	p_tracker->texel_size   = texel_size;
+	p_tracker->tile_size    = tile_size;
+	p_tracker->tile_count_x = (width  + tile_size - 1) / tile_size;
+	p_tracker->tile_count_y = (height + tile_size - 1) / tile_size;
+	p_tracker->full_frame   = 1;
+
+	size_t tile_count = (size_t)p_tracker->tile_count_x * (size_t)p_tracker->tile_count_y;
+
+	p_tracker->p_hashes      = (uint64_t*)calloc(tile_count, sizeof(uint64_t));
+	p_tracker->p_dirty       = (uint8_t*)calloc(tile_count, sizeof(uint8_t));
+	p_tracker->p_dirty_rects = (ShVkTileRect*)calloc(tile_count, sizeof(ShVkTileRect));
+
+	shVkError(
+		p_tracker->p_hashes == VK_NULL_HANDLE || p_tracker->p_dirty == VK_NULL_HANDLE || p_tracker->p_dirty_rects == VK_NULL_HANDLE,
+		"failed allocating tile tracker memory",
+		shDestroyTileTracker(p_tracker); return 0
+	);
+
+	return 1;
+}
+
+uint8_t shTileTrackerUpdate(
+	const void*      p_src,
+	uint64_t         src_row_pitch,
+	uint32_t         thread_count,
+	ShVkTileTracker* p_tracker
+) {
+	shVkArgError(p_src     == VK_NULL_HANDLE,           "invalid frame texels memory", return 0);
+	shVkArgError(p_tracker == VK_NULL_HANDLE,           "invalid tile tracker memory", return 0);
+
+	shVkError(p_tracker->p_hashes == VK_NULL_HANDLE, "tile tracker is not created", return 0);
+
+	uint64_t row_size = (uint64_t)p_tracker->width * p_tracker->texel_size;
+	src_row_pitch = src_row_pitch ? src_row_pitch : row_size;
+	shVkError(src_row_pitch < row_size, "frame row pitch smaller than a row", return 0);
+
+	if (thread_count == 0) {
+		uint64_t pixel_count = (uint64_t)p_tracker->width * p_tracker->height;
+		thread_count = (uint32_t)(pixel_count / SH_PIXEL_CONVERSION_PIXELS_PER_THREAD) + 1;
+		uint32_t processor_count = shGetProcessorCount();
+		thread_count = thread_count < processor_count ? thread_count : processor_count;
+	}
+	thread_count = thread_count < SH_MAX_PIXEL_CONVERSION_THREAD_COUNT ? thread_count : SH_MAX_PIXEL_CONVERSION_THREAD_COUNT;
+	thread_count = thread_count < p_tracker->tile_count_y ? thread_count : p_tracker->tile_count_y;
+
+	ShTileHashJob jobs[SH_MAX_PIXEL_CONVERSION_THREAD_COUNT] = { 0 };
+
+	ShTileHashFunction hash_function = shGetTileHashFunction(shGetPixelConversionIsa());
+
+	uint32_t rows_per_job   = p_tracker->tile_count_y / thread_count;
+	uint32_t extra_rows     = p_tracker->tile_count_y % thread_count;
+	uint32_t first_tile_row = 0;
+
+	for (uint32_t job_idx = 0; job_idx < thread_count; job_idx++) {
+		ShTileHashJob* p_job = &jobs[job_idx];
+		p_job->hash_function  = hash_function;
+		p_job->p_src          = (const uint8_t*)p_src;
+		p_job->src_row_pitch  = src_row_pitch;
+		p_job->p_tracker      = p_tracker;
+		p_job->first_tile_row = first_tile_row;
+		p_job->tile_row_count = rows_per_job + (job_idx < extra_rows ? 1 : 0);
+		first_tile_row += p_job->tile_row_count;
+	}
+
+	//the workers of shConvertPixels hash the tiles, no thread is created per update
+	if (thread_count == 1) {
+		shRunTileHashJob(&jobs[0]);
+	}
+	else {
+		shRunPixelJobs(shRunTileHashJob, jobs, sizeof(ShTileHashJob), thread_count);
+	}
+
+	p_tracker->full_frame       = 0;
+	p_tracker->dirty_rect_count = 0;
+	p_tracker->dirty_tile_count = 0;
+	p_tracker->dirty_size       = 0;
+
+	//runs of dirty tiles on the same tile row become a single rectangle
+	for (uint32_t tile_y = 0; tile_y < p_tracker->tile_count_y; tile_y++) {
+		uint8_t* p_dirty = &p_tracker->p_dirty[tile_y * p_tracker->tile_count_x];
+		for (uint32_t tile_x = 0; tile_x < p_tracker->tile_count_x; tile_x++) {
+			if (!p_dirty[tile_x]) {
+				continue;
+			}
+			uint32_t run_start = tile_x;
+			while (tile_x + 1 < p_tracker->tile_count_x && p_dirty[tile_x + 1]) {
+				tile_x++;
+			}
+
+			uint32_t x = run_start * p_tracker->tile_size;
+			uint32_t y = tile_y    * p_tracker->tile_size;
+
+			ShVkTileRect* p_rect = &p_tracker->p_dirty_rects[p_tracker->dirty_rect_count];
+			p_rect->x      = x;
+			p_rect->y      = y;
+			p_rect->width  = (tile_x + 1) * p_tracker->tile_size;
+			p_rect->height = p_tracker->height - y < p_tracker->tile_size ? p_tracker->height - y : p_tracker->tile_size;
+			p_rect->width  = (p_rect->width < p_tracker->width ? p_rect->width : p_tracker->width) - x;
+
+			p_tracker->dirty_rect_count++;
+			p_tracker->dirty_tile_count += tile_x + 1 - run_start;
+			p_tracker->dirty_size       += (uint64_t)p_rect->width * p_rect->height * p_tracker->texel_size;
+		}
+	}
+
+	return 1;
+}
+
+uint8_t shTileTrackerGatherDirtyTexels(
+	const void*      p_src,
+	uint64_t         src_row_pitch,
+	void*            p_dst,
+	ShVkTileTracker* p_tracker
+) {
+	shVkArgError(p_src     == VK_NULL_HANDLE, "invalid frame texels memory", return 0);
+	shVkArgError(p_dst     == VK_NULL_HANDLE, "invalid dirty texels memory", return 0);
+	shVkArgError(p_tracker == VK_NULL_HANDLE, "invalid tile tracker memory", return 0);
+
+	src_row_pitch = src_row_pitch ? src_row_pitch : (uint64_t)p_tracker->width * p_tracker->texel_size;
+
+	const uint8_t* p_frame = (const uint8_t*)p_src;
+	uint8_t*       p_texel = (uint8_t*)p_dst;
+
+	for (uint32_t rect_idx = 0; rect_idx < p_tracker->dirty_rect_count; rect_idx++) {
+		ShVkTileRect rect     = p_tracker->p_dirty_rects[rect_idx];
+		size_t       row_size = (size_t)rect.width * p_tracker->texel_size;
+		for (uint32_t row = 0; row < rect.height; row++) {
+			memcpy(
+				p_texel,
+				&p_frame[src_row_pitch * (rect.y + row) + (uint64_t)rect.x * p_tracker->texel_size],
+				row_size
+			);
+			p_texel += row_size;
+		}
+	}
+
+	return 1;
+}
+
+uint8_t shTileTrackerInvalidate(
+	ShVkTileTracker* p_tracker
+) {
+	shVkArgError(p_tracker == VK_NULL_HANDLE, "invalid tile tracker memory", return 0);
+
+	p_tracker->full_frame = 1;
+
+	return 1;
+}
+
+uint8_t shDestroyTileTracker(
+	ShVkTileTracker* p_tracker
+) {
+	shVkArgError(p_tracker == VK_NULL_HANDLE, "invalid tile tracker memory", return 0);
+
+	free(p_tracker->p_hashes);
+	free(p_tracker->p_dirty);
+	free(p_tracker->p_dirty_rects);
+
+	p_tracker->p_hashes      = VK_NULL_HANDLE;
+	p_tracker->p_dirty       = VK_NULL_HANDLE;
+	p_tracker->p_dirty_rects = VK_NULL_HANDLE;
+
+	return 1;
+}
+
+
+
+
+uint8_t shGetMipLevelCount(
+	uint32_t  width,
+	uint32_t  height,
+	uint32_t* p_mip_levels
+) {
+	shVkArgError(width == 0 || height == 0,      "invalid image size",         return 0);
+	shVkArgError(p_mip_levels == VK_NULL_HANDLE, "invalid mip levels pointer", return 0);
+
+	uint32_t size        = width > height ? width : height;
+	uint32_t level_count = 1;
+	while (size > 1) {
+		size >>= 1;
+		level_count++;
+	}
+
+	(*p_mip_levels) = level_count;
+
+	return 1;
+}
+
+uint8_t shCheckMipBlitSupport(
+	VkPhysicalDevice physical_device,
+	VkFormat         format,
+	VkFilter         filter,
+	uint8_t*         p_blit_supported
+) {
+	shVkArgError(physical_device  == VK_NULL_HANDLE,      "invalid physical device memory", return 0);
+	shVkArgError(format           == VK_FORMAT_UNDEFINED, "invalid image format",           return 0);
+	shVkArgError(p_blit_supported == VK_NULL_HANDLE,      "invalid blit support pointer",   return 0);
+
+	VkFormatProperties format_properties = { 0 };
+	vkGetPhysicalDeviceFormatProperties(physical_device, format, &format_properties);
+
+	VkFormatFeatureFlags required_features = VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT;
+	if (filter == VK_FILTER_LINEAR) {
+		required_features |= VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+	}
+
+	(*p_blit_supported) = (format_properties.optimalTilingFeatures & required_features) == required_features;
+
+	return 1;
+}
+
+uint8_t shCheckMipComputeSupport(
+	VkPhysicalDevice physical_device,
+	VkFormat         format,
+	uint8_t*         p_compute_supported
+) {
+	shVkArgError(physical_device     == VK_NULL_HANDLE,      "invalid physical device memory",  return 0);
+	shVkArgError(format              == VK_FORMAT_UNDEFINED, "invalid image format",            return 0);
+	shVkArgError(p_compute_supported == VK_NULL_HANDLE,      "invalid compute support pointer", return 0);
+
+	VkFormatProperties format_properties = { 0 };
+	vkGetPhysicalDeviceFormatProperties(physical_device, format, &format_properties);
+
+	(*p_compute_supported) = (format_properties.optimalTilingFeatures & VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT) != 0;
+
+	return 1;
+}
+
+static void shCmdMipLevelBarrier(
+	VkDevice             device,
+	VkCommandBuffer      cmd_buffer,
+	VkImage              image,
+	VkImageAspectFlags   aspect_mask,
+	uint32_t             base_mip_level,
+	uint32_t             level_count,
+	uint32_t             layer_count,
+	VkAccessFlags        src_access_mask,
+	VkAccessFlags        dst_access_mask,
+	VkImageLayout        old_layout,
+	VkImageLayout        new_layout,
+	VkPipelineStageFlags src_stage,
+	VkPipelineStageFlags dst_stage
+) {
+	VkImageSubresourceRange subresource_range = {
+		.aspectMask     = aspect_mask,
+		.baseMipLevel   = base_mip_level,
+		.levelCount     = level_count,
+		.baseArrayLayer = 0,
+		.layerCount     = layer_count
+	};
+
+	shSetImageSubresourceMemoryBarrier(
+		device, cmd_buffer, image, subresource_range,
+		src_access_mask, dst_access_mask,
+		old_layout, new_layout,
+		VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED,
+		src_stage, dst_stage
+	);
+}
+
+uint8_t shCmdGenerateMipsBlit(
+	VkDevice             device,
+	VkPhysicalDevice     physical_device,
+	VkCommandBuffer      cmd_buffer,
+	VkImage              image,
+	VkFormat             format,
+	VkImageAspectFlags   aspect_mask,
+	uint32_t             width,
+	uint32_t             height,
+	uint32_t             mip_levels,
+	uint32_t             layer_count,
+	VkFilter             filter,
+	VkImageLayout        src_image_layout,
+	VkImageLayout        dst_image_layout,
+	VkAccessFlags        dst_access_mask,
+	VkPipelineStageFlags dst_stage
+) {
+	shVkArgError(device      == VK_NULL_HANDLE, "invalid device memory",         return 0);
+	shVkArgError(cmd_buffer  == VK_NULL_HANDLE, "invalid command buffer memory", return 0);
+	shVkArgError(image       == VK_NULL_HANDLE, "invalid image memory",          return 0);
+	shVkArgError(width == 0 || height == 0,     "invalid image size",            return 0);
+	shVkArgError(mip_levels  == 0,              "invalid mip level count",       return 0);
+	shVkArgError(layer_count == 0,              "invalid layer count",           return 0);
+
+	uint8_t blit_supported = 0;
+	shVkError(
+		shCheckMipBlitSupport(physical_device, format, filter, &blit_supported) == 0,
+		"failed checking mip blit support",
+		return 0
+	);
+	shVkError(blit_supported == 0, "image format does not support mip blits", return 0);
+
+	//level 0 becomes the first blit source, the other levels blit destinations
+	shCmdMipLevelBarrier(
+		device, cmd_buffer, image, aspect_mask, 0, 1, layer_count,
+		VK_ACCESS_MEMORY_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+		src_image_layout, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+		VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT
+	);
+	if (mip_levels > 1) {
+		shCmdMipLevelBarrier(
+			device, cmd_buffer, image, aspect_mask, 1, mip_levels - 1, layer_count,
+			0, VK_ACCESS_TRANSFER_WRITE_BIT,
+			VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+			VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT
+		);
+	}
+
+	int32_t src_width  = (int32_t)width;
+	int32_t src_height = (int32_t)height;
+
+	for (uint32_t level = 1; level < mip_levels; level++) {
+		int32_t dst_width  = src_width  > 1 ? src_width  / 2 : 1;
+		int32_t dst_height = src_height > 1 ? src_height / 2 : 1;
+
+		VkImageBlit blit = {
+			.srcSubresource = {
+				.aspectMask     = aspect_mask,
+				.mipLevel       = level - 1,
+				.baseArrayLayer = 0,
+				.layerCount     = layer_count
+			},//srcSubresource;
+			.srcOffsets     = { { 0, 0, 0 }, { src_width, src_height, 1 } },//srcOffsets[2];
+			.dstSubresource = {
+				.aspectMask     = aspect_mask,
+				.mipLevel       = level,
+				.baseArrayLayer = 0,
+				.layerCount     = layer_count
+			},//dstSubresource;
+			.dstOffsets     = { { 0, 0, 0 }, { dst_width, dst_height, 1 } }//dstOffsets[2];
+		};
+
+		vkCmdBlitImage(
+			cmd_buffer,//commandBuffer
+			image,//srcImage
+			VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,//srcImageLayout
+			image,//dstImage
+			VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,//dstImageLayout
+			1,//regionCount
+			&blit,//pRegions
+			filter//filter
+		);
+
+		//the new level is the source of the next blit
+		shCmdMipLevelBarrier(
+			device, cmd_buffer, image, aspect_mask, level, 1, layer_count,
+			VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+			VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+			VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT
+		);
+
+		src_width  = dst_width;
+		src_height = dst_height;
+	}
+
+	shCmdMipLevelBarrier(
+		device, cmd_buffer, image, aspect_mask, 0, mip_levels, layer_count,
+		VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT, dst_access_mask,
+		VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, dst_image_layout,
+		VK_PIPELINE_STAGE_TRANSFER_BIT, dst_stage
+	);
+
+	return 1;
+}
+
+uint8_t shCreateMipLevelImageViews(
+	VkDevice           device,
+	VkImage            image,
+	VkImageAspectFlags aspect_mask,
+	VkFormat           format,
+	uint32_t           mip_levels,
+	uint32_t           layer_count,
+	VkImageView*       p_image_views
 ) {
-	shVkError(p_pipeline_pool == VK_NULL_HANDLE, "invalid pipeline pool memory", return 0);
+	shVkArgError(device        == VK_NULL_HANDLE, "invalid device memory",      return 0);
+	shVkArgError(image         == VK_NULL_HANDLE, "invalid image memory",       return 0);
+	shVkArgError(mip_levels    == 0,              "invalid mip level count",    return 0);
+	shVkArgError(layer_count   == 0,              "invalid layer count",        return 0);
+	shVkArgError(p_image_views == VK_NULL_HANDLE, "invalid image views memory", return 0);
 
-	for (uint32_t set_layout_idx = first_set_layout; set_layout_idx < (first_set_layout + set_layout_count); set_layout_idx++) {
+	for (uint32_t level = 0; level < mip_levels; level++) {
 		shVkError(
-			shDestroyDescriptorSetLayout(
-				device,
-				p_pipeline_pool->descriptor_set_layouts[set_layout_idx]
+			shCreateLayeredImageView(
+				device, image, VK_IMAGE_VIEW_TYPE_2D_ARRAY, aspect_mask,
+				level, 1,
+				0, layer_count,
+				format, &p_image_views[level]
 			) == 0,
-			"failed destroying descriptor set layout",
+			"error creating mip level image view",
 			return 0
 		);
 	}
@@ -4287,62 +10370,667 @@ uint8_t shPipelinePoolDestroyDescriptorSetLayouts(
 	return 1;
 }
 
-uint8_t shPipelinePoolDestroyDescriptorPools(
-	VkDevice          device,
-	uint32_t          first_pool,
-	uint32_t          pool_count,
-	ShVkPipelinePool* p_pipeline_pool
+uint8_t shCmdGenerateMipsCompute(
+	VkDevice             device,
+	VkPhysicalDevice     physical_device,
+	VkCommandBuffer      cmd_buffer,
+	VkImage              image,
+	VkFormat             format,
+	VkImageAspectFlags   aspect_mask,
+	uint32_t             width,
+	uint32_t             height,
+	uint32_t             mip_levels,
+	uint32_t             layer_count,
+	VkImageLayout        src_image_layout,
+	VkImageLayout        dst_image_layout,
+	VkAccessFlags        dst_access_mask,
+	VkPipelineStageFlags dst_stage,
+	uint32_t             first_descriptor_set_unit_idx,
+	ShVkPipelinePool*    p_pipeline_pool,
+	ShVkPipeline*        p_pipeline
 ) {
-	shVkError(p_pipeline_pool == VK_NULL_HANDLE, "invalid pipeline memory", return 0);
-
+	shVkArgError(device          == VK_NULL_HANDLE, "invalid device memory",         return 0);
+	shVkArgError(cmd_buffer      == VK_NULL_HANDLE, "invalid command buffer memory", return 0);
+	shVkArgError(image           == VK_NULL_HANDLE, "invalid image memory",          return 0);
+	shVkArgError(width == 0 || height == 0,         "invalid image size",            return 0);
+	shVkArgError(mip_levels      == 0,              "invalid mip level count",       return 0);
+	shVkArgError(layer_count     == 0,              "invalid layer count",           return 0);
+	shVkArgError(p_pipeline_pool == VK_NULL_HANDLE, "invalid pipeline pool memory",  return 0);
+	shVkArgError(p_pipeline      == VK_NULL_HANDLE, "invalid pipeline memory",       return 0);
+
+	uint8_t compute_supported = 0;
 	shVkError(
-		first_pool + pool_count > p_pipeline_pool->descriptor_pool_count,
-		"invalid descriptor pool range",
+		shCheckMipComputeSupport(physical_device, format, &compute_supported) == 0,
+		"failed checking mip compute support",
+		return 0
+	);
+	shVkError(
+		compute_supported == 0,
+		"image format does not support VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT with optimal tiling, mip levels cannot be generated with a compute pipeline",
 		return 0
 	);
 
-	for (uint32_t pool_idx = first_pool; pool_idx < (first_pool + pool_count); pool_idx++) {
+	shCmdMipLevelBarrier(
+		device, cmd_buffer, image, aspect_mask, 0, 1, layer_count,
+		VK_ACCESS_MEMORY_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT,
+		src_image_layout, VK_IMAGE_LAYOUT_GENERAL,
+		VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT
+	);
+	if (mip_levels > 1) {
+		shCmdMipLevelBarrier(
+			device, cmd_buffer, image, aspect_mask, 1, mip_levels - 1, layer_count,
+			0, VK_ACCESS_SHADER_WRITE_BIT,
+			VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL,
+			VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT
+		);
+	}
+
+	shBindPipeline(cmd_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, p_pipeline);
+
+	uint32_t dst_width  = width;
+	uint32_t dst_height = height;
+
+	for (uint32_t level = 1; level < mip_levels; level++) {
+		dst_width  = dst_width  > 1 ? dst_width  / 2 : 1;
+		dst_height = dst_height > 1 ? dst_height / 2 : 1;
+
+		shPipelineBindDescriptorSetUnits(
+			cmd_buffer,                                 //cmd_buffer
+			0,                                          //first_descriptor_set
+			first_descriptor_set_unit_idx + level - 1,  //first_descriptor_set_unit_idx
+			2,                                          //descriptor_set_unit_count
+			VK_PIPELINE_BIND_POINT_COMPUTE,             //bind_point
+			0,                                          //dynamic_descriptors_count
+			VK_NULL_HANDLE,                             //p_dynamic_offsets
+			p_pipeline_pool,                            //p_pipeline_pool
+			p_pipeline                                  //p_pipeline
+		);
+
+		shCmdDispatch(
+			cmd_buffer,
+			(dst_width  + SH_MIP_LOCAL_SIZE_X - 1) / SH_MIP_LOCAL_SIZE_X,
+			(dst_height + SH_MIP_LOCAL_SIZE_Y - 1) / SH_MIP_LOCAL_SIZE_Y,
+			layer_count
+		);
+
+		//the new level is read by the next dispatch
+		shCmdMipLevelBarrier(
+			device, cmd_buffer, image, aspect_mask, level, 1, layer_count,
+			VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT,
+			VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_GENERAL,
+			VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT
+		);
+	}
+
+	shCmdMipLevelBarrier(
+		device, cmd_buffer, image, aspect_mask, 0, mip_levels, layer_count,
+		VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT, dst_access_mask,
+		VK_IMAGE_LAYOUT_GENERAL, dst_image_layout,
+		VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, dst_stage
+	);
+
+	return 1;
+}
+
+
+
+
+uint8_t shCreateTransientAttachmentPool(
+	VkDevice                     device,
+	VkPhysicalDevice             physical_device,
+	ShVkTransientAttachmentPool* p_pool
+) {
+	shVkArgError(device          == VK_NULL_HANDLE, "invalid device memory",                    return 0);
+	shVkArgError(physical_device == VK_NULL_HANDLE, "invalid physical device memory",           return 0);
+	shVkArgError(p_pool          == VK_NULL_HANDLE, "invalid transient attachment pool memory", return 0);
+
+	memset(p_pool, 0, sizeof(ShVkTransientAttachmentPool));
+	p_pool->device          = device;
+	p_pool->physical_device = physical_device;
+
+	return 1;
+}
+
+uint8_t shTransientAttachmentPoolBegin(
+	ShVkTransientAttachmentPool* p_pool
+) {
+	shVkArgError(p_pool == VK_NULL_HANDLE, "invalid transient attachment pool memory", return 0);
+
+	for (uint32_t attachment_idx = 0; attachment_idx < SH_MAX_TRANSIENT_ATTACHMENT_COUNT; attachment_idx++) {
+		p_pool->attachments[attachment_idx].acquired = 0;
+	}
+
+	return 1;
+}
+
+uint8_t shTransientAttachmentPoolAcquire(
+	VkFormat                     format,
+	uint32_t                     width,
+	uint32_t                     height,
+	VkSampleCountFlagBits        sample_count,
+	VkImageUsageFlags            usage,
+	VkImageAspectFlags           aspect_mask,
+	uint32_t                     first_pass,
+	uint32_t                     last_pass,
+	ShVkTransientAttachmentPool* p_pool,
+	uint32_t*                    p_attachment_idx
+) {
+	shVkArgError(width == 0 || height == 0,          "invalid attachment size",                  return 0);
+	shVkArgError(first_pass > last_pass,             "invalid attachment pass range",            return 0);
+	shVkArgError(p_pool           == VK_NULL_HANDLE, "invalid transient attachment pool memory", return 0);
+	shVkArgError(p_attachment_idx == VK_NULL_HANDLE, "invalid attachment index pointer",         return 0);
+
+	const VkImageUsageFlags attachment_usages =
+		VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT;
+	if ((usage & ~(attachment_usages | VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT)) == 0) {
+		usage |= VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+	}
+
+	uint32_t class_width  = (width  + SH_TRANSIENT_ATTACHMENT_SIZE_CLASS - 1) / SH_TRANSIENT_ATTACHMENT_SIZE_CLASS * SH_TRANSIENT_ATTACHMENT_SIZE_CLASS;
+	uint32_t class_height = (height + SH_TRANSIENT_ATTACHMENT_SIZE_CLASS - 1) / SH_TRANSIENT_ATTACHMENT_SIZE_CLASS * SH_TRANSIENT_ATTACHMENT_SIZE_CLASS;
+
+	uint32_t free_idx = UINT32_MAX;
+
+	for (uint32_t attachment_idx = 0; attachment_idx < SH_MAX_TRANSIENT_ATTACHMENT_COUNT; attachment_idx++) {
+		ShVkTransientAttachment* p_attachment = &p_pool->attachments[attachment_idx];
+		if (p_attachment->acquired) {
+			continue;
+		}
+		if (p_attachment->image == VK_NULL_HANDLE) {
+			free_idx = free_idx == UINT32_MAX ? attachment_idx : free_idx;
+			continue;
+		}
+		if (
+			p_attachment->format       == format       &&
+			p_attachment->width        == class_width  &&
+			p_attachment->height       == class_height &&
+			p_attachment->sample_count == sample_count &&
+			p_attachment->usage        == usage        &&
+			p_attachment->aspect_mask  == aspect_mask  &&
+			p_attachment->first_pass   == first_pass   &&
+			p_attachment->last_pass    == last_pass
+			) {
+			p_attachment->acquired = 1;
+			(*p_attachment_idx)    = attachment_idx;
+			return 1;
+		}
+	}
+
+	shVkError(free_idx == UINT32_MAX, "transient attachment pool is full", return 0);
+
+	ShVkTransientAttachment attachment = {
+		.format       = format,         //format;
+		.width        = class_width,    //width;
+		.height       = class_height,   //height;
+		.sample_count = sample_count,   //sample_count;
+		.usage        = usage,          //usage;
+		.aspect_mask  = aspect_mask,    //aspect_mask;
+		.first_pass   = first_pass,     //first_pass;
+		.last_pass    = last_pass,      //last_pass;
+		.image        = VK_NULL_HANDLE, //image;
+		.image_view   = VK_NULL_HANDLE, //image_view;
+		.memory_idx   = UINT32_MAX,     //memory_idx;
+		.acquired     = 1               //acquired;
+	};
+	p_pool->attachments[free_idx] = attachment;
+	(*p_attachment_idx)           = free_idx;
+
+	return 1;
+}
+
+static void shReleaseTransientAttachment(
+	uint32_t                     attachment_idx,
+	ShVkReleaseQueue*            p_release_queue,
+	ShVkTransientAttachmentPool* p_pool
+) {
+	ShVkTransientAttachment* p_attachment = &p_pool->attachments[attachment_idx];
+	uint32_t                 memory_idx   = p_attachment->memory_idx;
+
+	if (p_release_queue != VK_NULL_HANDLE) {
+		shDeferRelease(SH_RELEASE_TYPE_IMAGE_VIEW, (ShVkReleaseHandle) { .image_view = p_attachment->image_view }, p_release_queue);
+		shDeferRelease(SH_RELEASE_TYPE_IMAGE,      (ShVkReleaseHandle) { .image      = p_attachment->image },      p_release_queue);
+	}
+	else {
+		if (p_attachment->image_view != VK_NULL_HANDLE) {
+			vkDestroyImageView(p_pool->device, p_attachment->image_view, VK_NULL_HANDLE);
+		}
+		vkDestroyImage(p_pool->device, p_attachment->image, VK_NULL_HANDLE);
+	}
+	memset(p_attachment, 0, sizeof(ShVkTransientAttachment));
+
+	if (memory_idx == UINT32_MAX || --p_pool->memory_reference_counts[memory_idx] != 0) {
+		return;
+	}
+
+	if (p_release_queue != VK_NULL_HANDLE) {
+		shDeferRelease(SH_RELEASE_TYPE_DEVICE_MEMORY, (ShVkReleaseHandle) { .memory = p_pool->memories[memory_idx] }, p_release_queue);
+	}
+	else {
+		vkFreeMemory(p_pool->device, p_pool->memories[memory_idx], VK_NULL_HANDLE);
+	}
+
+	p_pool->allocated_size        -= p_pool->memory_sizes[memory_idx];
+	p_pool->lazily_allocated_size -= p_pool->memory_lazily_allocated[memory_idx] ? p_pool->memory_sizes[memory_idx] : 0;
+
+	p_pool->memories[memory_idx]                = VK_NULL_HANDLE;
+	p_pool->memory_sizes[memory_idx]            = 0;
+	p_pool->memory_lazily_allocated[memory_idx] = 0;
+}
+
+//destroys what a failed commit created, new attachments stay acquired without image so that the commit can be retried
+static void shRollbackTransientAttachmentPoolCommit(
+	const uint8_t*               p_created,
+	uint32_t                     new_memory_idx_count,
+	const uint32_t*              p_new_memory_indices,
+	ShVkTransientAttachmentPool* p_pool
+) {
+	for (uint32_t attachment_idx = 0; attachment_idx < SH_MAX_TRANSIENT_ATTACHMENT_COUNT; attachment_idx++) {
+		ShVkTransientAttachment* p_attachment = &p_pool->attachments[attachment_idx];
+		if (!p_created[attachment_idx]) {
+			continue;
+		}
+		if (p_attachment->image_view != VK_NULL_HANDLE) {
+			vkDestroyImageView(p_pool->device, p_attachment->image_view, VK_NULL_HANDLE);
+		}
+		if (p_attachment->image != VK_NULL_HANDLE) {
+			vkDestroyImage(p_pool->device, p_attachment->image, VK_NULL_HANDLE);
+		}
+		p_attachment->image      = VK_NULL_HANDLE;
+		p_attachment->image_view = VK_NULL_HANDLE;
+		p_attachment->memory_idx = UINT32_MAX;
+	}
+
+	//new attachments are only bound to memory blocks created by the same commit
+	for (uint32_t new_idx = 0; new_idx < new_memory_idx_count; new_idx++) {
+		uint32_t memory_idx = p_new_memory_indices[new_idx];
+		if (p_pool->memories[memory_idx] != VK_NULL_HANDLE) {
+			vkFreeMemory(p_pool->device, p_pool->memories[memory_idx], VK_NULL_HANDLE);
+			p_pool->allocated_size        -= p_pool->memory_sizes[memory_idx];
+			p_pool->lazily_allocated_size -= p_pool->memory_lazily_allocated[memory_idx] ? p_pool->memory_sizes[memory_idx] : 0;
+		}
+		p_pool->memories[memory_idx]                = VK_NULL_HANDLE;
+		p_pool->memory_sizes[memory_idx]            = 0;
+		p_pool->memory_lazily_allocated[memory_idx] = 0;
+		p_pool->memory_reference_counts[memory_idx] = 0;
+	}
+}
+
+uint8_t shTransientAttachmentPoolCommit(
+	ShVkReleaseQueue*            p_release_queue,
+	ShVkTransientAttachmentPool* p_pool
+) {
+	shVkArgError(p_pool == VK_NULL_HANDLE, "invalid transient attachment pool memory", return 0);
+
+	VkDevice device = p_pool->device;
+
+	for (uint32_t attachment_idx = 0; attachment_idx < SH_MAX_TRANSIENT_ATTACHMENT_COUNT; attachment_idx++) {
+		ShVkTransientAttachment* p_attachment = &p_pool->attachments[attachment_idx];
+		if (!p_attachment->acquired && p_attachment->image != VK_NULL_HANDLE) {
+			shReleaseTransientAttachment(attachment_idx, p_release_queue, p_pool);
+		}
+	}
+
+	VkPhysicalDeviceMemoryProperties memory_properties = { 0 };
+	vkGetPhysicalDeviceMemoryProperties(p_pool->physical_device, &memory_properties);
+
+	VkMemoryRequirements memory_requirements[SH_MAX_TRANSIENT_ATTACHMENT_COUNT] = { 0 };
+	uint8_t              lazily_allocated   [SH_MAX_TRANSIENT_ATTACHMENT_COUNT] = { 0 };
+	uint32_t             new_memory_idx_count                                    = 0;
+	uint32_t             new_memory_indices [SH_MAX_TRANSIENT_ATTACHMENT_COUNT] = { 0 };
+	uint32_t             memory_type_bits   [SH_MAX_TRANSIENT_ATTACHMENT_COUNT] = { 0 };
+	uint8_t              created            [SH_MAX_TRANSIENT_ATTACHMENT_COUNT] = { 0 };
+
+	for (uint32_t attachment_idx = 0; attachment_idx < SH_MAX_TRANSIENT_ATTACHMENT_COUNT; attachment_idx++) {
+		ShVkTransientAttachment* p_attachment = &p_pool->attachments[attachment_idx];
+		if (!p_attachment->acquired || p_attachment->image != VK_NULL_HANDLE) {
+			continue;
+		}
+		created[attachment_idx] = 1;
+
 		shVkError(
-			shDestroyDescriptorPool(
-				device,
-				p_pipeline_pool->descriptor_pools[pool_idx]
+			shCreateImage(
+				device, VK_IMAGE_TYPE_2D,
+				p_attachment->width, p_attachment->height, 1,
+				p_attachment->format, 1, p_attachment->sample_count,
+				VK_IMAGE_TILING_OPTIMAL, p_attachment->usage, VK_SHARING_MODE_EXCLUSIVE,
+				&p_attachment->image
 			) == 0,
-			"failed destroying descriptor pool",
-			return 0
+			"failed creating transient attachment image",
+			shRollbackTransientAttachmentPoolCommit(created, new_memory_idx_count, new_memory_indices, p_pool); return 0
 		);
+		vkGetImageMemoryRequirements(device, p_attachment->image, &memory_requirements[attachment_idx]);
+
+		if (p_attachment->usage & VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT) {
+			for (uint32_t type_idx = 0; type_idx < memory_properties.memoryTypeCount; type_idx++) {
+				if ((memory_requirements[attachment_idx].memoryTypeBits & (1 << type_idx)) &&
+					(memory_properties.memoryTypes[type_idx].propertyFlags & VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT)) {
+					lazily_allocated[attachment_idx] = 1;
+					break;
+				}
+			}
+		}
+
+		//alias a memory block created by this commit if its attachments are never used by the same passes
+		uint32_t memory_idx = UINT32_MAX;
+		for (uint32_t new_idx = 0; new_idx < new_memory_idx_count && memory_idx == UINT32_MAX; new_idx++) {
+			uint32_t candidate_idx = new_memory_indices[new_idx];
+			if (p_pool->memory_lazily_allocated[candidate_idx] != lazily_allocated[attachment_idx] ||
+				(memory_type_bits[candidate_idx] & memory_requirements[attachment_idx].memoryTypeBits) == 0) {
+				continue;
+			}
+			uint8_t overlap = 0;
+			for (uint32_t other_idx = 0; other_idx < attachment_idx && !overlap; other_idx++) {
+				ShVkTransientAttachment* p_other = &p_pool->attachments[other_idx];
+				overlap = p_other->acquired && p_other->memory_idx == candidate_idx &&
+					p_other->first_pass <= p_attachment->last_pass && p_attachment->first_pass <= p_other->last_pass;
+			}
+			if (!overlap) {
+				memory_idx = candidate_idx;
+			}
+		}
+
+		if (memory_idx == UINT32_MAX) {
+			for (uint32_t free_idx = 0; free_idx < SH_MAX_TRANSIENT_ATTACHMENT_COUNT; free_idx++) {
+				if (p_pool->memory_reference_counts[free_idx] == 0) {
+					memory_idx = free_idx;
+					break;
+				}
+			}
+			shVkError(
+				memory_idx == UINT32_MAX,
+				"no free transient attachment memory block",
+				shRollbackTransientAttachmentPoolCommit(created, new_memory_idx_count, new_memory_indices, p_pool); return 0
+			);
+
+			p_pool->memory_lazily_allocated[memory_idx] = lazily_allocated[attachment_idx];
+			memory_type_bits[memory_idx]                = memory_requirements[attachment_idx].memoryTypeBits;
+			new_memory_indices[new_memory_idx_count++]  = memory_idx;
+		}
+
+		//images are bound at offset 0, the block only needs the largest size and alignment
+		memory_type_bits[memory_idx]        &= memory_requirements[attachment_idx].memoryTypeBits;
+		p_pool->memory_sizes[memory_idx]     = p_pool->memory_sizes[memory_idx] > memory_requirements[attachment_idx].size ?
+		                                       p_pool->memory_sizes[memory_idx] : memory_requirements[attachment_idx].size;
+		p_pool->memory_reference_counts[memory_idx]++;
+		p_attachment->memory_idx = memory_idx;
 	}
 
-	p_pipeline_pool->descriptor_pool_count -= pool_count;
+	for (uint32_t new_idx = 0; new_idx < new_memory_idx_count; new_idx++) {
+		uint32_t memory_idx = new_memory_indices[new_idx];
+
+		VkMemoryPropertyFlags preferred_flags[2] = {
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | (p_pool->memory_lazily_allocated[memory_idx] ? VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT : 0),
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+		};
+		uint32_t memory_type_index = UINT32_MAX;
+		for (uint32_t flags_idx = 0; flags_idx < 2 && memory_type_index == UINT32_MAX; flags_idx++) {
+			for (uint32_t type_idx = 0; type_idx < memory_properties.memoryTypeCount; type_idx++) {
+				VkMemoryPropertyFlags type_flags = memory_properties.memoryTypes[type_idx].propertyFlags;
+				if ((memory_type_bits[memory_idx] & (1 << type_idx)) &&
+					(type_flags & preferred_flags[flags_idx]) == preferred_flags[flags_idx]) {
+					memory_type_index = type_idx;
+					break;
+				}
+			}
+		}
+		shVkError(
+			memory_type_index == UINT32_MAX,
+			"cannot find device local memory for transient attachments",
+			shRollbackTransientAttachmentPoolCommit(created, new_memory_idx_count, new_memory_indices, p_pool); return 0
+		);
+		p_pool->memory_lazily_allocated[memory_idx] =
+			(memory_properties.memoryTypes[memory_type_index].propertyFlags & VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT) != 0;
+
+		VkMemoryAllocateInfo memory_allocate_info = {
+			.sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO, //sType;
+			.pNext           = VK_NULL_HANDLE,                         //pNext;
+			.allocationSize  = p_pool->memory_sizes[memory_idx],       //allocationSize;
+			.memoryTypeIndex = memory_type_index                       //memoryTypeIndex;
+		};
+		VkDeviceMemory memory = VK_NULL_HANDLE;//the pool only holds successfully allocated blocks
+		shVkResultError(
+			vkAllocateMemory(device, &memory_allocate_info, VK_NULL_HANDLE, &memory),
+			"error allocating transient attachment memory",
+			shRollbackTransientAttachmentPoolCommit(created, new_memory_idx_count, new_memory_indices, p_pool); return 0
+		);
+		p_pool->memories[memory_idx] = memory;
+
+		p_pool->allocated_size        += p_pool->memory_sizes[memory_idx];
+		p_pool->lazily_allocated_size += p_pool->memory_lazily_allocated[memory_idx] ? p_pool->memory_sizes[memory_idx] : 0;
+	}
+
+	for (uint32_t attachment_idx = 0; attachment_idx < SH_MAX_TRANSIENT_ATTACHMENT_COUNT; attachment_idx++) {
+		ShVkTransientAttachment* p_attachment = &p_pool->attachments[attachment_idx];
+		if (!p_attachment->acquired || p_attachment->image_view != VK_NULL_HANDLE) {
+			continue;
+		}
+
+		shVkError(
+			shBindImageMemory(device, p_attachment->image, 0, p_pool->memories[p_attachment->memory_idx]) == 0,
+			"failed binding transient attachment memory",
+			shRollbackTransientAttachmentPoolCommit(created, new_memory_idx_count, new_memory_indices, p_pool); return 0
+		);
+		shVkError(
+			shCreateImageView(
+				device, p_attachment->image, VK_IMAGE_VIEW_TYPE_2D,
+				p_attachment->aspect_mask, 1, p_attachment->format,
+				&p_attachment->image_view
+			) == 0,
+			"failed creating transient attachment image view",
+			shRollbackTransientAttachmentPoolCommit(created, new_memory_idx_count, new_memory_indices, p_pool); return 0
+		);
+	}
 
 	return 1;
 }
 
-uint8_t shPipelinePoolUpdateDescriptorSetUnits(
-	VkDevice          device,
-	uint32_t          first_descriptor_set_unit,
-	uint32_t          descriptor_set_unit_count,
-	ShVkPipelinePool* p_pipeline_pool
+uint8_t shDestroyTransientAttachmentPool(
+	ShVkTransientAttachmentPool* p_pool
+) {
+	shVkArgError(p_pool == VK_NULL_HANDLE, "invalid transient attachment pool memory", return 0);
+
+	for (uint32_t attachment_idx = 0; attachment_idx < SH_MAX_TRANSIENT_ATTACHMENT_COUNT; attachment_idx++) {
+		if (p_pool->attachments[attachment_idx].image != VK_NULL_HANDLE) {
+			shReleaseTransientAttachment(attachment_idx, 0, VK_NULL_HANDLE, VK_NULL_HANDLE, p_pool);
+		}
+	}
+
+	return 1;
+}
+
+
+uint8_t shSetRenderingAttachment(
+	VkImageView                image_view,
+	VkImageLayout              image_layout,
+	VkResolveModeFlagBits      resolve_mode,
+	VkImageView                resolve_image_view,
+	VkImageLayout              resolve_image_layout,
+	VkAttachmentLoadOp         load_op,
+	VkAttachmentStoreOp        store_op,
+	VkClearValue*              p_clear_value,
+	VkRenderingAttachmentInfo* p_attachment
+) {
+	shVkArgError(p_attachment == VK_NULL_HANDLE, "invalid rendering attachment memory", return 0);
+
+	shVkArgError(
+		resolve_mode != VK_RESOLVE_MODE_NONE && resolve_image_view == VK_NULL_HANDLE,
+		"invalid resolve image view memory",
+		return 0
+	);
+
+	shVkArgError(
+		load_op == VK_ATTACHMENT_LOAD_OP_CLEAR && p_clear_value == VK_NULL_HANDLE,
+		"invalid attachment clear value memory",
+		return 0
+	);
+
+	VkClearValue clear_value = { 0 };
+	if (p_clear_value != VK_NULL_HANDLE) {
+		clear_value = (*p_clear_value);
+	}
+
+	VkRenderingAttachmentInfo attachment = {
+		.sType              = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO, //sType;
+		.pNext              = VK_NULL_HANDLE,                              //pNext;
+		.imageView          = image_view,                                  //imageView;
+		.imageLayout        = image_layout,                                //imageLayout;
+		.resolveMode        = resolve_mode,                                //resolveMode;
+		.resolveImageView   = resolve_image_view,                          //resolveImageView;
+		.resolveImageLayout = resolve_image_layout,                        //resolveImageLayout;
+		.loadOp             = load_op,                                     //loadOp;
+		.storeOp            = store_op,                                    //storeOp;
+		.clearValue         = clear_value                                  //clearValue;
+	};
+
+	(*p_attachment) = attachment;
+
+	return 1;
+}
+
+uint8_t shBeginRendering(
+	VkDevice                   device,
+	VkCommandBuffer            graphics_cmd_buffer,
+	int32_t                    render_offset_x,
+	int32_t                    render_offset_y,
+	uint32_t                   render_size_x,
+	uint32_t                   render_size_y,
+	uint32_t                   layer_count,
+	uint32_t                   color_attachment_count,
+	VkRenderingAttachmentInfo* p_color_attachments,
+	VkRenderingAttachmentInfo* p_depth_attachment,
+	VkRenderingAttachmentInfo* p_stencil_attachment
 ) {
-	shVkError(device == VK_NULL_HANDLE, "invalid device memory", return 0);
-	shVkError(p_pipeline_pool == VK_NULL_HANDLE, "invalid pipeline pool memory", return 0);
+	shVkArgError(device              == VK_NULL_HANDLE, "invalid device memory",         return 0);
+	shVkArgError(graphics_cmd_buffer == VK_NULL_HANDLE, "invalid command buffer memory", return 0);
+	shVkArgError(render_size_x       == 0,              "invalid render size x",         return 0);
+	shVkArgError(render_size_y       == 0,              "invalid render size y",         return 0);
+	shVkArgError(layer_count         == 0,              "invalid render layer count",    return 0);
+
+	shVkArgError(
+		color_attachment_count != 0 && p_color_attachments == VK_NULL_HANDLE,
+		"invalid color attachments memory",
+		return 0
+	);
+
+	VkRect2D render_area = {
+		.offset = { render_offset_x, render_offset_y },
+		.extent = { render_size_x,   render_size_y   }
+	};
+
+	VkRenderingInfo rendering_info = {
+		.sType                = VK_STRUCTURE_TYPE_RENDERING_INFO, //sType;
+		.pNext                = VK_NULL_HANDLE,                   //pNext;
+		.flags                = 0,                                //flags;
+		.renderArea           = render_area,                      //renderArea;
+		.layerCount           = layer_count,                      //layerCount;
+		.viewMask             = 0,                                //viewMask;
+		.colorAttachmentCount = color_attachment_count,           //colorAttachmentCount;
+		.pColorAttachments    = p_color_attachments,              //pColorAttachments;
+		.pDepthAttachment     = p_depth_attachment,               //pDepthAttachment;
+		.pStencilAttachment   = p_stencil_attachment              //pStencilAttachment;
+	};
+
+	//resolved when the device was registered, devices created outside of shvulkan are looked up on each call
+	ShVkDeviceSlot*         p_slot              = shGetDeviceSlot(device);
+	PFN_vkCmdBeginRendering cmd_begin_rendering = p_slot != VK_NULL_HANDLE ?
+		p_slot->vkCmdBeginRendering :
+		(PFN_vkCmdBeginRendering)shGetDynamicRenderingFunction(device, "vkCmdBeginRendering", "vkCmdBeginRenderingKHR");
 
 	shVkError(
-		(first_descriptor_set_unit + descriptor_set_unit_count) > p_pipeline_pool->descriptor_set_unit_count,
-		"invalid descriptors range",
+		cmd_begin_rendering == VK_NULL_HANDLE,
+		"device does not support dynamic rendering",
 		return 0
 	);
 
-	vkUpdateDescriptorSets(
-		device,
-		descriptor_set_unit_count,
-		&p_pipeline_pool->write_descriptor_sets[first_descriptor_set_unit],
-		0,
-		VK_NULL_HANDLE
+	cmd_begin_rendering(graphics_cmd_buffer, &rendering_info);
+
+	return 1;
+}
+
+uint8_t shEndRendering(
+	VkDevice        device,
+	VkCommandBuffer graphics_cmd_buffer
+) {
+	shVkArgError(device              == VK_NULL_HANDLE, "invalid device memory",         return 0);
+	shVkArgError(graphics_cmd_buffer == VK_NULL_HANDLE, "invalid command buffer memory", return 0);
+
+	ShVkDeviceSlot*       p_slot            = shGetDeviceSlot(device);
+	PFN_vkCmdEndRendering cmd_end_rendering = p_slot != VK_NULL_HANDLE ?
+		p_slot->vkCmdEndRendering :
+		(PFN_vkCmdEndRendering)shGetDynamicRenderingFunction(device, "vkCmdEndRendering", "vkCmdEndRenderingKHR");
+
+	shVkError(
+		cmd_end_rendering == VK_NULL_HANDLE,
+		"device does not support dynamic rendering",
+		return 0
 	);
 
+	cmd_end_rendering(graphics_cmd_buffer);
+
 	return 1;
 }
 
+uint8_t shSetupGraphicsPipelineRendering(
+	VkDevice      device,
+	uint32_t      color_attachment_count,
+	VkFormat*     p_color_attachment_formats,
+	VkFormat      depth_attachment_format,
+	VkFormat      stencil_attachment_format,
+	uint8_t       dynamic_viewport,
+	ShVkPipeline* p_pipeline
+) {
+	shVkArgError(device     == VK_NULL_HANDLE, "invalid device memory",            return 0);
+	shVkArgError(p_pipeline == VK_NULL_HANDLE, "invalid graphics pipeline memory", return 0);
+
+	shVkArgError(
+		color_attachment_count != 0 && p_color_attachment_formats == VK_NULL_HANDLE,
+		"invalid color attachment formats memory",
+		return 0
+	);
+
+	shVkError(
+		color_attachment_count != p_pipeline->color_blend_state.attachmentCount,
+		"color attachment count does not match the pipeline color blend settings",
+		return 0
+	);
+
+	VkPipelineRenderingCreateInfo rendering_info = {
+		.sType                   = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO, //sType;
+		.pNext                   = VK_NULL_HANDLE,                                   //pNext;
+		.viewMask                = 0,                                                //viewMask;
+		.colorAttachmentCount    = color_attachment_count,                           //colorAttachmentCount;
+		.pColorAttachmentFormats = p_color_attachment_formats,                       //pColorAttachmentFormats;
+		.depthAttachmentFormat   = depth_attachment_format,                          //depthAttachmentFormat;
+		.stencilAttachmentFormat = stencil_attachment_format                         //stencilAttachmentFormat;
+	};
+
+	VkDynamicState dynamic_states[2] = {
+		VK_DYNAMIC_STATE_VIEWPORT,
+		VK_DYNAMIC_STATE_SCISSOR
+	};
+
+	return shCreateGraphicsPipeline(
+		device,
+		VK_NULL_HANDLE,
+		&rendering_info,
+		dynamic_viewport ? 2 : 0,
+		dynamic_states,
+		p_pipeline
+	);
+}
+
+uint8_t shCmdSetPipelineViewport(
+	VkCommandBuffer cmd_buffer,
+	ShVkPipeline*   p_pipeline
+) {
+	shVkArgError(cmd_buffer == VK_NULL_HANDLE, "invalid command buffer memory", return 0);
+	shVkArgError(p_pipeline == VK_NULL_HANDLE, "invalid pipeline memory",       return 0);
+
+	vkCmdSetViewport(cmd_buffer, 0, 1, &p_pipeline->viewport);
+	vkCmdSetScissor(cmd_buffer, 0, 1, &p_pipeline->scissors);
+
+	return 1;
+}
 
 
 #ifdef __cplusplus